@@ -62,6 +62,11 @@ AtomicString::StringKind GetStringKind(const SharedNativeString* native_string)
     return AtomicString::StringKind::kIsMixed;
   }
 
+  if (native_string->Is8Bit()) {
+    std::string characters(reinterpret_cast<const char*>(native_string->characters8()), native_string->length());
+    return GetStringKind(characters, characters.size());
+  }
+
   AtomicString::StringKind predictKind = std::islower(native_string->string()[0])
                                              ? AtomicString::StringKind::kIsLowerCase
                                              : AtomicString::StringKind::kIsUpperCase;
@@ -77,6 +82,14 @@ AtomicString::StringKind GetStringKind(const SharedNativeString* native_string)
   return predictKind;
 }
 
+// Latin-1 bytes are not valid UTF-8, create the atom from a raw 8-bit string instead of JS_NewAtomLen.
+JSAtom NativeStringToAtom(JSContext* ctx, const SharedNativeString* native_string) {
+  JSValue value = nativeStringToJSValue(ctx, native_string);
+  JSAtom atom = JS_ValueToAtom(ctx, value);
+  JS_FreeValue(ctx, value);
+  return atom;
+}
+
 }  // namespace
 
 AtomicString::AtomicString(JSContext* ctx, const std::string& string)
@@ -101,7 +114,8 @@ AtomicString::AtomicString(JSContext* ctx, const uint16_t* str, size_t length) :
 
 AtomicString::AtomicString(JSContext* ctx, const std::unique_ptr<AutoFreeNativeString>& native_string)
     : runtime_(JS_GetRuntime(ctx)),
-      atom_(JS_NewUnicodeAtom(ctx, native_string->string(), native_string->length())),
+      atom_(native_string->Is8Bit() ? NativeStringToAtom(ctx, native_string.get())
+                                    : JS_NewUnicodeAtom(ctx, native_string->string(), native_string->length())),
       kind_(GetStringKind(native_string.get())),
       length_(native_string->length()){};
 
@@ -182,10 +196,9 @@ std::unique_ptr<SharedNativeString> AtomicString::ToNativeString(JSContext* ctx)
     return built_in_string::kempty_string.ToNativeString(ctx);
   }
   JSValue stringValue = JS_AtomToValue(ctx, atom_);
-  uint32_t length;
-  uint16_t* bytes = JS_ToUnicode(ctx, stringValue, &length);
+  std::unique_ptr<SharedNativeString> result = jsValueToNativeString(ctx, stringValue);
   JS_FreeValue(ctx, stringValue);
-  return std::make_unique<SharedNativeString>(bytes, length);
+  return result;
 }
 
 StringView AtomicString::ToStringView() const {
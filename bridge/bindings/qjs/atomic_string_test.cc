@@ -78,10 +78,11 @@ TEST(AtomicString, ToNativeString) {
   TestAtomicString([](JSContext* ctx) {
     AtomicString&& value = AtomicString(ctx, "helloworld");
     auto native_string = value.ToNativeString(ctx);
-    const uint16_t* p = native_string->string();
+    EXPECT_TRUE(native_string->Is8Bit());
+    const uint8_t* p = native_string->characters8();
     EXPECT_EQ(native_string->length(), 10);
 
-    uint16_t result[10] = {'h', 'e', 'l', 'l', 'o', 'w', 'o', 'r', 'l', 'd'};
+    uint8_t result[10] = {'h', 'e', 'l', 'l', 'o', 'w', 'o', 'r', 'l', 'd'};
     for (int i = 0; i < native_string->length(); i++) {
       EXPECT_EQ(result[i], p[i]);
     }
@@ -76,6 +76,7 @@
 #include "qjs_pop_state_event.h"
 #include "qjs_promise_rejection_event.h"
 #include "qjs_screen.h"
+#include "qjs_storage.h"
 #include "qjs_svg_circle_element.h"
 #include "qjs_svg_element.h"
 #include "qjs_svg_ellipse_element.h"
@@ -104,8 +105,8 @@
 namespace webf {
 
 void InstallBindings(ExecutingContext* context) {
-  // Must follow the inheritance order when install.
-  // Exp: Node extends EventTarget, EventTarget must be install first.
+  // Only the global functions are installed here. The constructors are lazy properties of the global object, their
+  // classes and prototype chains are created on first use, parent classes first.
   QJSWindowOrWorkerGlobalScope::Install(context);
   QJSLocation::Install(context);
   QJSModuleManager::Install(context);
@@ -174,6 +175,7 @@ void InstallBindings(ExecutingContext* context) {
   QJSTouch::Install(context);
   QJSTouchList::Install(context);
   QJSDOMStringMap::Install(context);
+  QJSStorage::Install(context);
   QJSMutationObserver::Install(context);
   QJSMutationRecord::Install(context);
   QJSMutationObserverRegistration::Install(context);
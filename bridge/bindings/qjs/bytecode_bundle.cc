@@ -0,0 +1,343 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "bytecode_bundle.h"
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#if WIN32
+#include <cstdio>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "bytecode_cache.h"
+#include "foundation/crc32.h"
+
+#ifndef WEBF_QUICKJS_REVISION
+#define WEBF_QUICKJS_REVISION "unknown"
+#endif
+
+namespace webf {
+
+static constexpr char kMagic[8] = {'W', 'E', 'B', 'F', 'B', 'N', 'D', '1'};
+static constexpr uint32_t kVersion = 2;
+
+namespace {
+
+// The bytecode format version and the digest of the QuickJS sources, like the keys of the BytecodeCache.
+uint32_t EngineVersion() {
+  static const uint32_t version = [] {
+    std::string engine = std::to_string(JS_GetBytecodeVersion()) + '\0' + WEBF_QUICKJS_REVISION;
+    return Crc32(reinterpret_cast<const uint8_t*>(engine.data()), engine.size());
+  }();
+  return version;
+}
+
+template <typename T>
+T ReadAt(const uint8_t* data, size_t offset) {
+  T value;
+  memcpy(&value, data + offset, sizeof(T));
+  return value;
+}
+
+template <typename T>
+void WriteAt(std::string& buffer, size_t offset, T value) {
+  memcpy(&buffer[offset], &value, sizeof(T));
+}
+
+// Bundles are identified by their content, the pages evaluating the same bundle share it.
+std::mutex open_bundles_mutex;
+std::unordered_map<uint64_t, std::weak_ptr<BytecodeBundle>> open_bundles;
+
+std::shared_ptr<BytecodeBundle> FindOpenBundle(uint64_t id) {
+  std::lock_guard<std::mutex> lock(open_bundles_mutex);
+  auto it = open_bundles.find(id);
+  return it == open_bundles.end() ? nullptr : it->second.lock();
+}
+
+// Returns the bundle already open with the id of |bundle| if any. |bundle| is released out of the lock, its destructor
+// takes it.
+std::shared_ptr<BytecodeBundle> RegisterBundle(std::shared_ptr<BytecodeBundle> bundle) {
+  std::shared_ptr<BytecodeBundle> open_bundle;
+  {
+    std::lock_guard<std::mutex> lock(open_bundles_mutex);
+    auto it = open_bundles.find(bundle->id());
+    if (it != open_bundles.end()) {
+      open_bundle = it->second.lock();
+    }
+    if (open_bundle == nullptr) {
+      open_bundles[bundle->id()] = bundle;
+      return bundle;
+    }
+  }
+  return open_bundle;
+}
+
+struct RuntimeBundle {
+  std::shared_ptr<BytecodeBundle> bundle;
+  JSBundleReader* reader;
+};
+
+// The bundles read by the runtime of this thread, they stay alive until the runtime is freed because their modules
+// may be imported at any time.
+thread_local JSRuntime* bundle_runtime{nullptr};
+thread_local std::vector<RuntimeBundle> runtime_bundles;
+
+JSModuleDef* LoadModule(JSContext* ctx, const char* module_name, void* opaque) {
+  for (auto& entry : runtime_bundles) {
+    const BytecodeBundle::Module* module = entry.bundle->Find(module_name);
+    if (module == nullptr || !(module->flags & BytecodeBundle::kModule))
+      continue;
+    JSValue value = entry.bundle->Read(ctx, *module);
+    if (JS_IsException(value))
+      return nullptr;
+    // The module is referenced by the context.
+    auto* def = static_cast<JSModuleDef*>(JS_VALUE_GET_PTR(value));
+    JS_FreeValue(ctx, value);
+    return def;
+  }
+  JS_ThrowReferenceError(ctx, "could not load module '%s'", module_name);
+  return nullptr;
+}
+
+}  // namespace
+
+bool BytecodeBundle::IsBundle(const uint8_t* bytes, size_t length) {
+  return length >= kHeaderSize && memcmp(bytes, kMagic, sizeof(kMagic)) == 0;
+}
+
+std::shared_ptr<BytecodeBundle> BytecodeBundle::Open(const std::string& path) {
+  const uint8_t* data = nullptr;
+  size_t size = 0;
+  bool mapped = false;
+#if WIN32
+  FILE* file = fopen(path.c_str(), "rb");
+  if (file != nullptr) {
+    fseek(file, 0, SEEK_END);
+    long file_size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (file_size > static_cast<long>(kHeaderSize)) {
+      size = static_cast<size_t>(file_size);
+      auto* buffer = new uint8_t[size];
+      if (fread(buffer, 1, size, file) == size) {
+        data = buffer;
+      } else {
+        delete[] buffer;
+      }
+    }
+    fclose(file);
+  }
+#else
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd >= 0) {
+    struct stat file_stat {};
+    if (fstat(fd, &file_stat) == 0 && static_cast<size_t>(file_stat.st_size) > kHeaderSize) {
+      size = static_cast<size_t>(file_stat.st_size);
+      void* address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (address != MAP_FAILED) {
+        data = static_cast<const uint8_t*>(address);
+        mapped = true;
+      }
+    }
+    close(fd);
+  }
+#endif
+  if (data == nullptr)
+    return nullptr;
+
+  auto bundle = std::shared_ptr<BytecodeBundle>(new BytecodeBundle(data, size, mapped));
+  if (!bundle->Parse())
+    return nullptr;
+  return RegisterBundle(std::move(bundle));
+}
+
+std::shared_ptr<BytecodeBundle> BytecodeBundle::FromBytes(const uint8_t* bytes, size_t length) {
+  if (!IsBundle(bytes, length))
+    return nullptr;
+
+  if (auto open_bundle = FindOpenBundle(ReadAt<uint64_t>(bytes, 24)))
+    return open_bundle;
+
+  auto* data = new uint8_t[length];
+  memcpy(data, bytes, length);
+  auto bundle = std::shared_ptr<BytecodeBundle>(new BytecodeBundle(data, length, false));
+  if (!bundle->Parse())
+    return nullptr;
+  return RegisterBundle(std::move(bundle));
+}
+
+void BytecodeBundle::Dispose() {
+  for (auto& entry : runtime_bundles) {
+    JS_FreeBundleReader(bundle_runtime, entry.reader);
+  }
+  runtime_bundles.clear();
+  bundle_runtime = nullptr;
+}
+
+BytecodeBundle::~BytecodeBundle() {
+  {
+    std::lock_guard<std::mutex> lock(open_bundles_mutex);
+    auto it = open_bundles.find(id_);
+    if (it != open_bundles.end() && it->second.expired()) {
+      open_bundles.erase(it);
+    }
+  }
+#if !WIN32
+  if (mapped_) {
+    munmap(const_cast<uint8_t*>(data_), size_);
+    return;
+  }
+#endif
+  delete[] data_;
+}
+
+bool BytecodeBundle::Parse() {
+  if (!IsBundle(data_, size_) || ReadAt<uint32_t>(data_, 8) != kVersion || ReadAt<uint32_t>(data_, 16) != EngineVersion())
+    return false;
+
+  uint32_t module_count = ReadAt<uint32_t>(data_, 12);
+  id_ = ReadAt<uint64_t>(data_, 24);
+  uint64_t tables_offset = ReadAt<uint64_t>(data_, 32);
+  tables_length_ = ReadAt<uint64_t>(data_, 40);
+  if (module_count > (size_ - kHeaderSize) / kModuleEntrySize || tables_offset > size_ ||
+      tables_length_ > size_ - tables_offset)
+    return false;
+  tables_ = data_ + tables_offset;
+  if (Crc32(tables_, tables_length_) != ReadAt<uint32_t>(data_, 20))
+    return false;
+
+  modules_.reserve(module_count);
+  verified_ = std::make_unique<std::atomic<bool>[]>(module_count);
+  for (uint32_t i = 0; i < module_count; i++) {
+    size_t entry = kHeaderSize + i * kModuleEntrySize;
+    uint32_t name_length = ReadAt<uint32_t>(data_, entry + 4);
+    uint64_t name_offset = ReadAt<uint64_t>(data_, entry + 8);
+    uint64_t bytecode_offset = ReadAt<uint64_t>(data_, entry + 16);
+    uint32_t bytecode_length = ReadAt<uint32_t>(data_, entry + 24);
+    if (name_offset > size_ || name_length > size_ - name_offset || bytecode_offset > size_ ||
+        bytecode_length > size_ - bytecode_offset)
+      return false;
+    modules_.push_back(Module{std::string(reinterpret_cast<const char*>(data_ + name_offset), name_length),
+                              ReadAt<uint32_t>(data_, entry), data_ + bytecode_offset, bytecode_length,
+                              ReadAt<uint32_t>(data_, entry + 28)});
+  }
+  return true;
+}
+
+const BytecodeBundle::Module* BytecodeBundle::Find(const std::string& name) const {
+  for (auto& module : modules_) {
+    if (module.name == name)
+      return &module;
+  }
+  return nullptr;
+}
+
+JSValue BytecodeBundle::Read(JSContext* ctx, const Module& module, int flags) {
+  JSRuntime* runtime = JS_GetRuntime(ctx);
+  JSBundleReader* reader = nullptr;
+  for (auto& entry : runtime_bundles) {
+    if (entry.bundle.get() == this) {
+      reader = entry.reader;
+      break;
+    }
+  }
+  if (reader == nullptr) {
+    reader = JS_NewBundleReader(ctx, tables_, tables_length_);
+    if (reader == nullptr)
+      return JS_EXCEPTION;
+    if (runtime_bundles.empty()) {
+      bundle_runtime = runtime;
+      JS_SetModuleLoaderFunc(runtime, nullptr, LoadModule, nullptr);
+    }
+    runtime_bundles.push_back(RuntimeBundle{shared_from_this(), reader});
+  }
+
+  // Checked by the first runtime which reads the module.
+  std::atomic<bool>& verified = verified_[&module - modules_.data()];
+  if (!verified.load(std::memory_order_acquire)) {
+    if (Crc32(module.bytecode, module.length) != module.crc) {
+      return JS_ThrowSyntaxError(ctx, "the bytecode of '%s' is corrupted", module.name.c_str());
+    }
+    verified.store(true, std::memory_order_release);
+  }
+  return JS_ReadBundleObject(ctx, reader, module.bytecode, module.length, flags);
+}
+
+BytecodeBundleWriter::BytecodeBundleWriter(JSContext* ctx) : ctx_(ctx), writer_(JS_NewBundleWriter(ctx)) {}
+
+BytecodeBundleWriter::~BytecodeBundleWriter() {
+  if (writer_ != nullptr) {
+    JS_FreeBundleWriter(writer_);
+  }
+}
+
+bool BytecodeBundleWriter::Add(const std::string& name, uint32_t flags, JSValueConst object) {
+  if (writer_ == nullptr)
+    return false;
+  size_t length;
+  uint8_t* bytes = JS_WriteBundleObject(writer_, &length, object);
+  if (bytes == nullptr)
+    return false;
+  modules_.push_back(PendingModule{name, flags, std::string(reinterpret_cast<char*>(bytes), length)});
+  js_free(ctx_, bytes);
+  return true;
+}
+
+std::string BytecodeBundleWriter::Finish() {
+  if (writer_ == nullptr)
+    return "";
+  size_t tables_length;
+  uint8_t* tables = JS_WriteBundleTables(writer_, &tables_length);
+  if (tables == nullptr)
+    return "";
+
+  size_t size = BytecodeBundle::kHeaderSize + modules_.size() * BytecodeBundle::kModuleEntrySize;
+  for (auto& module : modules_) {
+    size += module.name.size();
+  }
+  size_t tables_offset = size;
+  size += tables_length;
+  for (auto& module : modules_) {
+    size += module.bytecode.size();
+  }
+
+  std::string buffer(size, '\0');
+  size_t name_offset = BytecodeBundle::kHeaderSize + modules_.size() * BytecodeBundle::kModuleEntrySize;
+  size_t bytecode_offset = tables_offset + tables_length;
+  for (size_t i = 0; i < modules_.size(); i++) {
+    const PendingModule& module = modules_[i];
+    size_t entry = BytecodeBundle::kHeaderSize + i * BytecodeBundle::kModuleEntrySize;
+    WriteAt<uint32_t>(buffer, entry, module.flags);
+    WriteAt<uint32_t>(buffer, entry + 4, module.name.size());
+    WriteAt<uint64_t>(buffer, entry + 8, name_offset);
+    WriteAt<uint64_t>(buffer, entry + 16, bytecode_offset);
+    WriteAt<uint32_t>(buffer, entry + 24, module.bytecode.size());
+    WriteAt<uint32_t>(buffer, entry + 28,
+                      Crc32(reinterpret_cast<const uint8_t*>(module.bytecode.data()), module.bytecode.size()));
+    memcpy(&buffer[name_offset], module.name.data(), module.name.size());
+    memcpy(&buffer[bytecode_offset], module.bytecode.data(), module.bytecode.size());
+    name_offset += module.name.size();
+    bytecode_offset += module.bytecode.size();
+  }
+  memcpy(&buffer[tables_offset], tables, tables_length);
+
+  memcpy(&buffer[0], kMagic, sizeof(kMagic));
+  WriteAt<uint32_t>(buffer, 8, kVersion);
+  WriteAt<uint32_t>(buffer, 12, modules_.size());
+  WriteAt<uint32_t>(buffer, 16, EngineVersion());
+  WriteAt<uint32_t>(buffer, 20, Crc32(tables, tables_length));
+  WriteAt<uint64_t>(buffer, 32, tables_offset);
+  WriteAt<uint64_t>(buffer, 40, tables_length);
+  js_free(ctx_, tables);
+  // The id covers everything but the header.
+  auto key = BytecodeCache::ComputeKey(buffer.data() + BytecodeBundle::kHeaderSize,
+                                       buffer.size() - BytecodeBundle::kHeaderSize, "bundle");
+  WriteAt<uint64_t>(buffer, 24, key.high);
+  return buffer;
+}
+
+}  // namespace webf
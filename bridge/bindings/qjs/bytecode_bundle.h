@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef BRIDGE_BINDINGS_QJS_BYTECODE_BUNDLE_H_
+#define BRIDGE_BINDINGS_QJS_BYTECODE_BUNDLE_H_
+
+#include <quickjs/quickjs.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace webf {
+
+// Scripts and modules compiled ahead of time by webf_bytecode_compiler, in one file which is mapped into memory:
+//   header:  "WEBFBND1" uint32(version) uint32(module count) uint32(engine) uint32(crc of the tables)
+//            uint64(id) uint64(tables offset) uint64(tables length)
+//   modules: uint32(flags) uint32(name length) uint64(name offset) uint64(bytecode offset) uint32(bytecode length)
+//            uint32(crc of the bytecode), for every module
+//   the names, the atom and string tables shared by all the modules, the bytecode of every module.
+// The bytecode of a module is only read, and checked against its checksum, when the module is evaluated or imported.
+// The bodies of its functions stay in the mapped file until they are first called.
+class BytecodeBundle : public std::enable_shared_from_this<BytecodeBundle> {
+ public:
+  static constexpr size_t kHeaderSize = 48;
+  static constexpr size_t kModuleEntrySize = 32;
+
+  enum ModuleFlags : uint32_t {
+    // An ES module, a script otherwise.
+    kModule = 1 << 0,
+    // Evaluated with the bundle. The other modules are read when they are imported.
+    kEntry = 1 << 1,
+  };
+
+  struct Module {
+    std::string name;
+    uint32_t flags;
+    const uint8_t* bytecode;
+    size_t length;
+    uint32_t crc;
+  };
+
+  static bool IsBundle(const uint8_t* bytes, size_t length);
+  // Returns nullptr when |path| is not a valid bundle.
+  static std::shared_ptr<BytecodeBundle> Open(const std::string& path);
+  // Returns the open bundle with the id of |bytes|, or a copy of |bytes| when there is none.
+  static std::shared_ptr<BytecodeBundle> FromBytes(const uint8_t* bytes, size_t length);
+  // Releases the bundles read by the runtime of the current thread, must be called before the runtime is freed.
+  static void Dispose();
+
+  ~BytecodeBundle();
+
+  uint64_t id() const { return id_; }
+  const std::vector<Module>& modules() const { return modules_; }
+  const Module* Find(const std::string& name) const;
+
+  // |module| is one of modules(). Returns the script function or the module in the realm of |ctx|, to be evaluated
+  // by JS_EvalFunction(). The imports of the modules are resolved from the bundles read by the same runtime. Without
+  // JS_READ_OBJ_LAZY in |flags|, the functions are read up front.
+  JSValue Read(JSContext* ctx, const Module& module, int flags = JS_READ_OBJ_LAZY);
+
+ private:
+  BytecodeBundle(const uint8_t* data, size_t size, bool mapped) : data_(data), size_(size), mapped_(mapped) {}
+  bool Parse();
+
+  const uint8_t* data_;
+  size_t size_;
+  bool mapped_;
+  uint64_t id_{0};
+  const uint8_t* tables_{nullptr};
+  size_t tables_length_{0};
+  std::vector<Module> modules_;
+  std::unique_ptr<std::atomic<bool>[]> verified_;
+};
+
+// Writes the scripts and modules of a bundle, their atoms and constant strings are written once.
+class BytecodeBundleWriter {
+ public:
+  explicit BytecodeBundleWriter(JSContext* ctx);
+  ~BytecodeBundleWriter();
+
+  // |object| is a function or a module compiled with JS_EVAL_FLAG_COMPILE_ONLY, or read back by JS_ReadObject().
+  bool Add(const std::string& name, uint32_t flags, JSValueConst object);
+  // Returns an empty string on failure, the exception is left in the context.
+  std::string Finish();
+
+ private:
+  struct PendingModule {
+    std::string name;
+    uint32_t flags;
+    std::string bytecode;
+  };
+
+  JSContext* ctx_;
+  JSBundleWriter* writer_;
+  std::vector<PendingModule> modules_;
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_BINDINGS_QJS_BYTECODE_BUNDLE_H_
@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "bytecode_bundle.h"
+#include <cstdio>
+#include <string>
+#include "gtest/gtest.h"
+
+using namespace webf;
+
+namespace {
+
+struct Source {
+  const char* name;
+  uint32_t flags;
+  const char* code;
+};
+
+std::string WriteBundle(const std::vector<Source>& sources, bool strip = false) {
+  JSRuntime* runtime = JS_NewRuntime();
+  JSContext* ctx = JS_NewContext(runtime);
+  std::string bundle;
+  {
+    BytecodeBundleWriter writer(ctx);
+    for (auto& source : sources) {
+      int flags = (source.flags & BytecodeBundle::kModule ? JS_EVAL_TYPE_MODULE : JS_EVAL_TYPE_GLOBAL) |
+                  JS_EVAL_FLAG_COMPILE_ONLY | (strip ? JS_EVAL_FLAG_STRIP : 0);
+      JSValue function = JS_Eval(ctx, source.code, strlen(source.code), source.name, flags);
+      EXPECT_FALSE(JS_IsException(function));
+      EXPECT_TRUE(writer.Add(source.name, source.flags, function));
+      JS_FreeValue(ctx, function);
+    }
+    bundle = writer.Finish();
+  }
+  JS_FreeContext(ctx);
+  JS_FreeRuntime(runtime);
+  return bundle;
+}
+
+bool EvaluateEntries(JSContext* ctx, BytecodeBundle* bundle, int flags = JS_READ_OBJ_LAZY) {
+  for (auto& module : bundle->modules()) {
+    if (!(module.flags & BytecodeBundle::kEntry))
+      continue;
+    JSValue function = bundle->Read(ctx, module, flags);
+    if (JS_IsException(function))
+      return false;
+    if ((module.flags & BytecodeBundle::kModule) && JS_ResolveModule(ctx, function) < 0) {
+      JS_FreeValue(ctx, function);
+      return false;
+    }
+    JSValue result = JS_EvalFunction(ctx, function);
+    bool success = !JS_IsException(result);
+    JS_FreeValue(ctx, result);
+    if (!success)
+      return false;
+  }
+  return true;
+}
+
+std::string EvalToString(JSContext* ctx, const char* code) {
+  JSValue value = JS_Eval(ctx, code, strlen(code), "vm://test.js", JS_EVAL_TYPE_GLOBAL);
+  const char* string = JS_ToCString(ctx, value);
+  std::string result = string != nullptr ? string : "";
+  JS_FreeCString(ctx, string);
+  JS_FreeValue(ctx, value);
+  return result;
+}
+
+}  // namespace
+
+TEST(BytecodeBundle, scriptsShareAtomsAndStrings) {
+  std::vector<Source> sources = {
+      {"first.js", BytecodeBundle::kEntry,
+       "var message = 'a constant string which both scripts use';"
+       "function describe(item) { return item.title + ':' + item.subtitle; }"},
+      {"second.js", BytecodeBundle::kEntry,
+       "globalThis.result = describe({title: 'a constant string which both scripts use', subtitle: message.length});"},
+  };
+
+  size_t separate_size = 0;
+  {
+    JSRuntime* runtime = JS_NewRuntime();
+    JSContext* ctx = JS_NewContext(runtime);
+    for (auto& source : sources) {
+      JSValue function = JS_Eval(ctx, source.code, strlen(source.code), source.name, JS_EVAL_FLAG_COMPILE_ONLY);
+      size_t length;
+      uint8_t* bytes = JS_WriteObject(ctx, &length, function, JS_WRITE_OBJ_BYTECODE);
+      separate_size += length;
+      js_free(ctx, bytes);
+      JS_FreeValue(ctx, function);
+    }
+    JS_FreeContext(ctx);
+    JS_FreeRuntime(runtime);
+  }
+  std::string bytes = WriteBundle(sources);
+  size_t bundle_size = bytes.size() - BytecodeBundle::kHeaderSize - 2 * BytecodeBundle::kModuleEntrySize;
+  EXPECT_LT(bundle_size, separate_size);
+
+  JSRuntime* runtime = JS_NewRuntime();
+  JSContext* ctx = JS_NewContext(runtime);
+  auto bundle = BytecodeBundle::FromBytes(reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size());
+  ASSERT_NE(bundle, nullptr);
+  EXPECT_EQ(bundle, BytecodeBundle::FromBytes(reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size()));
+  ASSERT_EQ(bundle->modules().size(), 2);
+  EXPECT_EQ(bundle->modules()[1].name, "second.js");
+  EXPECT_TRUE(EvaluateEntries(ctx, bundle.get()));
+  EXPECT_EQ(EvalToString(ctx, "result"), "a constant string which both scripts use:40");
+
+  BytecodeBundle::Dispose();
+  JS_FreeContext(ctx);
+  JS_FreeRuntime(runtime);
+}
+
+TEST(BytecodeBundle, modulesAreReadWhenImported) {
+  std::string bytes = WriteBundle(
+      {
+          {"lib/prefix.js", BytecodeBundle::kModule, "export const prefix = 'Hello';"},
+          {"lib/greet.js", BytecodeBundle::kModule,
+           "import { prefix } from './prefix.js'; export function greet(name) { return `${prefix}, ${name}!`; }"},
+          {"lib/unused.js", BytecodeBundle::kModule, "globalThis.unusedEvaluated = true;"},
+          {"main.js", BytecodeBundle::kModule | BytecodeBundle::kEntry,
+           "import { greet } from './lib/greet.js'; globalThis.result = greet('bundle');"},
+      },
+      true);
+  std::string path = testing::TempDir() + "modules.wbn";
+  FILE* file = fopen(path.c_str(), "wb");
+  ASSERT_NE(file, nullptr);
+  fwrite(bytes.data(), 1, bytes.size(), file);
+  fclose(file);
+
+  JSRuntime* runtime = JS_NewRuntime();
+  JSContext* ctx = JS_NewContext(runtime);
+  auto bundle = BytecodeBundle::Open(path);
+  ASSERT_NE(bundle, nullptr);
+  EXPECT_NE(bundle->Find("lib/greet.js"), nullptr);
+  EXPECT_TRUE(EvaluateEntries(ctx, bundle.get()));
+  EXPECT_EQ(EvalToString(ctx, "result"), "Hello, bundle!");
+  EXPECT_EQ(EvalToString(ctx, "typeof unusedEvaluated"), "undefined");
+
+  BytecodeBundle::Dispose();
+  JS_FreeContext(ctx);
+  JS_FreeRuntime(runtime);
+  remove(path.c_str());
+}
+
+TEST(BytecodeBundle, functionBodiesAreReadOnFirstCall) {
+  std::string bytes = WriteBundle({{"script.js", BytecodeBundle::kEntry,
+                                    "function add(a, b) { return a + b; }\n"
+                                    "function counter() { let n = 0; return () => ++n; }\n"
+                                    "function* range(n) { for (let i = 0; i < n; i++) yield i; }\n"
+                                    "async function later(v) { return await Promise.resolve(v); }\n"
+                                    "class Point { constructor(x, y) { this.x = x; this.y = y; } norm() { return "
+                                    "Math.hypot(this.x, this.y); } }\n"
+                                    "function fail() { throw new Error('failed'); }\n"
+                                    "function unused() { return `never ${'called'}`.repeat(100); }\n"
+                                    "globalThis.sum = add(1, 2);\n"}});
+  auto bundle = BytecodeBundle::FromBytes(reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size());
+  ASSERT_NE(bundle, nullptr);
+
+  int64_t code_size[2];
+  for (int lazy = 0; lazy < 2; lazy++) {
+    JSRuntime* runtime = JS_NewRuntime();
+    JSContext* ctx = JS_NewContext(runtime);
+    EXPECT_TRUE(EvaluateEntries(ctx, bundle.get(), lazy ? JS_READ_OBJ_LAZY : 0));
+    JSMemoryUsage usage;
+    JS_ComputeMemoryUsage(runtime, &usage);
+    code_size[lazy] = usage.js_func_code_size;
+
+    EXPECT_EQ(EvalToString(ctx,
+                           "const c = counter(); c();"
+                           "[sum, c(), [...range(3)].join(), new Point(3, 4).norm(),"
+                           " (() => { try { fail(); } catch (e) { return e.stack.includes('script.js:6'); } })()].join(';')"),
+              "3;2;0,1,2;5;true");
+    EvalToString(ctx, "later(7).then(v => globalThis.asyncResult = v)");
+    JSContext* job_ctx;
+    while (JS_ExecutePendingJob(runtime, &job_ctx) > 0) {
+    }
+    EXPECT_EQ(EvalToString(ctx, "asyncResult"), "7");
+
+    BytecodeBundle::Dispose();
+    JS_FreeContext(ctx);
+    JS_FreeRuntime(runtime);
+  }
+  EXPECT_LT(code_size[1], code_size[0]);
+}
+
+TEST(BytecodeBundle, corruptedModulesAreNotRead) {
+  std::string bytes = WriteBundle({{"script.js", BytecodeBundle::kEntry, "globalThis.value = 42;"}});
+  bytes[bytes.size() - 2] ^= 0xFF;
+
+  JSRuntime* runtime = JS_NewRuntime();
+  JSContext* ctx = JS_NewContext(runtime);
+  auto bundle = BytecodeBundle::FromBytes(reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size());
+  ASSERT_NE(bundle, nullptr);
+  JSValue function = bundle->Read(ctx, bundle->modules()[0]);
+  EXPECT_TRUE(JS_IsException(function));
+  JS_FreeValue(ctx, JS_GetException(ctx));
+
+  bytes[20] ^= 0xFF;
+  EXPECT_EQ(BytecodeBundle::FromBytes(reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size()), bundle);
+  bundle = nullptr;
+  BytecodeBundle::Dispose();
+  EXPECT_EQ(BytecodeBundle::FromBytes(reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size()), nullptr);
+
+  JS_FreeContext(ctx);
+  JS_FreeRuntime(runtime);
+}
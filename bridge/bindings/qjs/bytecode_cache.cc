@@ -0,0 +1,390 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "bytecode_cache.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#if WIN32
+#include <direct.h>
+#include <sys/utime.h>
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
+#endif
+#include <quickjs/quickjs.h>
+#include "foundation/crc32.h"
+
+#ifndef WEBF_QUICKJS_REVISION
+#define WEBF_QUICKJS_REVISION "unknown"
+#endif
+
+namespace webf {
+
+static constexpr char kMagic[8] = {'W', 'E', 'B', 'F', 'Q', 'B', 'C', '1'};
+static constexpr uint32_t kVersion = 1;
+static constexpr const char* kEntrySuffix = ".qbc";
+static constexpr const char* kTemporarySuffix = ".tmp";
+
+static uint64_t Mix(uint64_t h) {
+  h ^= h >> 33;
+  h *= 0xFF51AFD7ED558CCDull;
+  h ^= h >> 33;
+  h *= 0xC4CEB9FE1A85EC53ull;
+  h ^= h >> 33;
+  return h;
+}
+
+static uint64_t HashBytes(const void* data, size_t length, uint64_t seed) {
+  constexpr uint64_t kMultiplier = 0x9E3779B97F4A7C15ull;
+  auto* bytes = static_cast<const uint8_t*>(data);
+  uint64_t h = seed ^ (length * kMultiplier);
+  size_t i = 0;
+  for (; i + 8 <= length; i += 8) {
+    uint64_t word;
+    memcpy(&word, bytes + i, sizeof(uint64_t));
+    h = (h ^ Mix(word)) * kMultiplier;
+  }
+  uint64_t tail = 0;
+  memcpy(&tail, bytes + i, length - i);
+  return Mix(h ^ Mix(tail ^ length));
+}
+
+static bool EndsWith(const std::string& string, const char* suffix) {
+  size_t length = strlen(suffix);
+  return string.size() >= length && string.compare(string.size() - length, length, suffix) == 0;
+}
+
+static bool WriteFile(const std::string& path, const std::string& header, const std::string& body) {
+  FILE* file = fopen(path.c_str(), "wb");
+  if (file == nullptr)
+    return false;
+  bool success = fwrite(header.data(), 1, header.size(), file) == header.size() &&
+                 fwrite(body.data(), 1, body.size(), file) == body.size();
+  return fclose(file) == 0 && success;
+}
+
+static bool ReplaceFile(const std::string& from, const std::string& to) {
+#if WIN32
+  return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+  return rename(from.c_str(), to.c_str()) == 0;
+#endif
+}
+
+static void MakeDirectory(const std::string& directory) {
+#if WIN32
+  _mkdir(directory.c_str());
+#else
+  mkdir(directory.c_str(), 0755);
+#endif
+}
+
+std::string BytecodeCache::Key::FileName() const {
+  char name[40];
+  snprintf(name, sizeof(name), "%016llx%016llx", static_cast<unsigned long long>(high),
+           static_cast<unsigned long long>(low));
+  return std::string(name) + kEntrySuffix;
+}
+
+BytecodeCache::Entry::~Entry() {
+#if WIN32
+  free(data_);
+#else
+  if (mapped_) {
+    munmap(data_, size_);
+  } else {
+    free(data_);
+  }
+#endif
+}
+
+static std::mutex& CurrentCacheMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+static std::shared_ptr<BytecodeCache>& CurrentCache() {
+  static std::shared_ptr<BytecodeCache> cache;
+  return cache;
+}
+
+void BytecodeCache::Configure(const std::string& directory, size_t max_bytes) {
+  std::shared_ptr<BytecodeCache> cache;
+  if (!directory.empty()) {
+    cache = std::make_shared<BytecodeCache>(directory, max_bytes);
+  }
+
+  std::lock_guard<std::mutex> lock(CurrentCacheMutex());
+  // The former cache finishes its writes when the last page using it releases it.
+  CurrentCache() = std::move(cache);
+}
+
+std::shared_ptr<BytecodeCache> BytecodeCache::Current() {
+  std::lock_guard<std::mutex> lock(CurrentCacheMutex());
+  return CurrentCache();
+}
+
+BytecodeCache::Key BytecodeCache::ComputeKey(const char* source, size_t length, const char* url) {
+  // BC_VERSION stays the one of qjsc, so that the .kbc1 files stay readable. The revision catches the format changes of
+  // this tree.
+  std::string salt = std::string(url != nullptr ? url : "") + '\0' + std::to_string(JS_GetBytecodeVersion()) + '\0' +
+                     WEBF_QUICKJS_REVISION + '\0' + std::to_string(sizeof(void*)) + '\0' + std::to_string(kVersion);
+  uint64_t high = HashBytes(source, length, 0x6A09E667F3BCC908ull);
+  uint64_t low = HashBytes(source, length, 0xBB67AE8584CAA73Bull);
+  return Key{HashBytes(salt.data(), salt.size(), high), HashBytes(salt.data(), salt.size(), low)};
+}
+
+BytecodeCache::BytecodeCache(std::string directory, size_t max_bytes)
+    : directory_(std::move(directory)), max_bytes_(max_bytes) {
+  worker_ = std::thread([this]() { RunTasks(); });
+  PostTask([this]() { LoadIndex(); });
+}
+
+BytecodeCache::~BytecodeCache() {
+  {
+    std::lock_guard<std::mutex> lock(tasks_mutex_);
+    stopping_ = true;
+  }
+  tasks_changed_.notify_all();
+  worker_.join();
+}
+
+// Lookup runs on the JS thread, which can't go on before it has the bytecode anyway. Opening and mapping an entry
+// takes less than 0.2ms for 1MB of bytecode, most of the time goes to the checksum (~3.5ms/MB). Reading the bytecode
+// takes twice as long and compiling the source about 25 times longer (test/benchmark/bytecode_cache.cc).
+std::unique_ptr<BytecodeCache::Entry> BytecodeCache::Lookup(const Key& key) {
+  std::string name = key.FileName();
+  std::string path = PathOf(name);
+
+  uint8_t* data = nullptr;
+  size_t size = 0;
+  bool mapped = false;
+#if WIN32
+  FILE* file = fopen(path.c_str(), "rb");
+  if (file != nullptr) {
+    fseek(file, 0, SEEK_END);
+    long file_size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (file_size > static_cast<long>(kHeaderSize)) {
+      size = static_cast<size_t>(file_size);
+      data = static_cast<uint8_t*>(malloc(size));
+      if (fread(data, 1, size, file) != size) {
+        free(data);
+        data = nullptr;
+      }
+    }
+    fclose(file);
+  }
+#else
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd >= 0) {
+    struct stat file_stat {};
+    if (fstat(fd, &file_stat) == 0 && static_cast<size_t>(file_stat.st_size) > kHeaderSize) {
+      size = static_cast<size_t>(file_stat.st_size);
+      void* address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (address != MAP_FAILED) {
+        data = static_cast<uint8_t*>(address);
+        mapped = true;
+      }
+    }
+    close(fd);
+  }
+#endif
+
+  if (data == nullptr) {
+    misses_++;
+    return nullptr;
+  }
+
+  auto entry = std::unique_ptr<Entry>(new Entry(data, size, mapped));
+  uint32_t version;
+  uint32_t crc;
+  uint64_t length;
+  Key stored_key{};
+  memcpy(&version, data + 8, sizeof(uint32_t));
+  memcpy(&crc, data + 12, sizeof(uint32_t));
+  memcpy(&length, data + 16, sizeof(uint64_t));
+  memcpy(&stored_key.high, data + 24, sizeof(uint64_t));
+  memcpy(&stored_key.low, data + 32, sizeof(uint64_t));
+  if (memcmp(data, kMagic, sizeof(kMagic)) != 0 || version != kVersion || length != entry->size() ||
+      !(stored_key == key) || Crc32(entry->data(), entry->size()) != crc) {
+    misses_++;
+    Remove(key);
+    return nullptr;
+  }
+
+  hits_++;
+  PostTask([this, name]() { Touch(name); });
+  return entry;
+}
+
+void BytecodeCache::Store(const Key& key, const uint8_t* bytecode, size_t length) {
+  auto body = std::make_shared<std::string>(reinterpret_cast<const char*>(bytecode), length);
+  PostTask([this, key, body]() { Write(key.FileName(), key, *body); });
+}
+
+void BytecodeCache::Remove(const Key& key) {
+  std::string name = key.FileName();
+  PostTask([this, name]() { Erase(name); });
+}
+
+void BytecodeCache::Flush() {
+  std::unique_lock<std::mutex> lock(tasks_mutex_);
+  tasks_changed_.wait(lock, [this]() { return tasks_.empty() && !running_task_; });
+}
+
+size_t BytecodeCache::TotalBytes() {
+  Flush();
+  return total_bytes_;
+}
+
+void BytecodeCache::PostTask(std::function<void()>&& task) {
+  {
+    std::lock_guard<std::mutex> lock(tasks_mutex_);
+    tasks_.emplace_back(std::move(task));
+  }
+  tasks_changed_.notify_all();
+}
+
+void BytecodeCache::RunTasks() {
+  std::unique_lock<std::mutex> lock(tasks_mutex_);
+  while (true) {
+    tasks_changed_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+    // Pending writes are finished before stopping.
+    if (tasks_.empty())
+      return;
+
+    std::function<void()> task = std::move(tasks_.front());
+    tasks_.pop_front();
+    running_task_ = true;
+    lock.unlock();
+    task();
+    lock.lock();
+    running_task_ = false;
+    tasks_changed_.notify_all();
+  }
+}
+
+void BytecodeCache::LoadIndex() {
+  MakeDirectory(directory_);
+
+  struct FileInfo {
+    std::string name;
+    size_t size;
+    int64_t modified_time;
+  };
+  std::vector<FileInfo> files;
+
+#if WIN32
+  WIN32_FIND_DATAA find_data;
+  HANDLE handle = FindFirstFileA((directory_ + "\\*").c_str(), &find_data);
+  if (handle != INVALID_HANDLE_VALUE) {
+    do {
+      std::string name = find_data.cFileName;
+      if (EndsWith(name, kTemporarySuffix)) {
+        remove(PathOf(name).c_str());
+      } else if (EndsWith(name, kEntrySuffix)) {
+        int64_t modified_time =
+            (static_cast<int64_t>(find_data.ftLastWriteTime.dwHighDateTime) << 32) | find_data.ftLastWriteTime.dwLowDateTime;
+        size_t size = (static_cast<size_t>(find_data.nFileSizeHigh) << 32) | find_data.nFileSizeLow;
+        files.push_back({name, size, modified_time});
+      }
+    } while (FindNextFileA(handle, &find_data));
+    FindClose(handle);
+  }
+#else
+  DIR* dir = opendir(directory_.c_str());
+  if (dir != nullptr) {
+    while (struct dirent* item = readdir(dir)) {
+      std::string name = item->d_name;
+      if (EndsWith(name, kTemporarySuffix)) {
+        // Left by a process which was killed while writing.
+        unlink(PathOf(name).c_str());
+      } else if (EndsWith(name, kEntrySuffix)) {
+        struct stat file_stat {};
+        if (stat(PathOf(name).c_str(), &file_stat) == 0) {
+          files.push_back({name, static_cast<size_t>(file_stat.st_size), static_cast<int64_t>(file_stat.st_mtime)});
+        }
+      }
+    }
+    closedir(dir);
+  }
+#endif
+
+  // Most recently used first.
+  std::sort(files.begin(), files.end(),
+            [](const FileInfo& a, const FileInfo& b) { return a.modified_time > b.modified_time; });
+  for (auto& file : files) {
+    lru_.push_back({file.name, file.size});
+    index_[file.name] = std::prev(lru_.end());
+    total_bytes_ += file.size;
+  }
+  Evict();
+}
+
+void BytecodeCache::Touch(const std::string& name) {
+  auto it = index_.find(name);
+  if (it == index_.end())
+    return;
+  lru_.splice(lru_.begin(), lru_, it->second);
+  // The modification time keeps the order for the next launch.
+  utime(PathOf(name).c_str(), nullptr);
+}
+
+void BytecodeCache::Write(const std::string& name, const Key& key, const std::string& bytecode) {
+  std::string header(kHeaderSize, '\0');
+  uint32_t version = kVersion;
+  uint32_t crc = Crc32(reinterpret_cast<const uint8_t*>(bytecode.data()), bytecode.size());
+  uint64_t length = bytecode.size();
+  memcpy(&header[0], kMagic, sizeof(kMagic));
+  memcpy(&header[8], &version, sizeof(uint32_t));
+  memcpy(&header[12], &crc, sizeof(uint32_t));
+  memcpy(&header[16], &length, sizeof(uint64_t));
+  memcpy(&header[24], &key.high, sizeof(uint64_t));
+  memcpy(&header[32], &key.low, sizeof(uint64_t));
+
+  std::string temporary_path = PathOf(name + kTemporarySuffix);
+  if (!WriteFile(temporary_path, header, bytecode) || !ReplaceFile(temporary_path, PathOf(name))) {
+    remove(temporary_path.c_str());
+    return;
+  }
+
+  auto it = index_.find(name);
+  if (it != index_.end()) {
+    total_bytes_ -= it->second->size;
+    lru_.erase(it->second);
+  }
+  lru_.push_front({name, header.size() + bytecode.size()});
+  index_[name] = lru_.begin();
+  total_bytes_ += header.size() + bytecode.size();
+  Evict();
+}
+
+void BytecodeCache::Erase(const std::string& name) {
+  remove(PathOf(name).c_str());
+  auto it = index_.find(name);
+  if (it == index_.end())
+    return;
+  total_bytes_ -= it->second->size;
+  lru_.erase(it->second);
+  index_.erase(it);
+}
+
+void BytecodeCache::Evict() {
+  // Keep the newest entry even when it is larger than the limit on its own.
+  while (total_bytes_ > max_bytes_ && lru_.size() > 1) {
+    std::string name = lru_.back().name;
+    Erase(name);
+  }
+}
+
+}  // namespace webf
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef BRIDGE_BINDINGS_QJS_BYTECODE_CACHE_H_
+#define BRIDGE_BINDINGS_QJS_BYTECODE_CACHE_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace webf {
+
+// A content-addressed cache of compiled scripts on disk, shared by all the pages of the process.
+//
+// Entries are keyed by a 128-bit hash of the source, the source url, the bytecode version (BC_VERSION) and the engine
+// revision, one file per entry:
+//   header: "WEBFQBC1" uint32(version) uint32(crc of the bytecode) uint64(bytecode length) uint64[2](key)
+//   body:   the bytecode written by JS_WriteObject
+// Hits are mapped into memory and verified against the checksum. Entries are written to a temporary file and renamed
+// on a background thread. The least recently used entries are removed once the directory grows past max_bytes.
+class BytecodeCache {
+ public:
+  static constexpr size_t kDefaultMaxBytes = 64 * 1024 * 1024;
+  // Smaller scripts compile faster than their cache entries are read.
+  static constexpr size_t kMinSourceLength = 10 * 1024;
+  static constexpr size_t kHeaderSize = 40;
+
+  struct Key {
+    uint64_t high;
+    uint64_t low;
+
+    bool operator==(const Key& other) const { return high == other.high && low == other.low; }
+    std::string FileName() const;
+  };
+
+  // The bytecode of a hit, stays valid until the entry is destroyed.
+  class Entry {
+   public:
+    ~Entry();
+    const uint8_t* data() const { return data_ + kHeaderSize; }
+    size_t size() const { return size_ - kHeaderSize; }
+
+   private:
+    friend class BytecodeCache;
+    Entry(uint8_t* data, size_t size, bool mapped) : data_(data), size_(size), mapped_(mapped) {}
+    uint8_t* data_;
+    size_t size_;
+    bool mapped_;
+  };
+
+  // Sets the cache used by the whole process. An empty |directory| turns the cache off.
+  static void Configure(const std::string& directory, size_t max_bytes = kDefaultMaxBytes);
+  // Returns nullptr when the cache is off.
+  static std::shared_ptr<BytecodeCache> Current();
+
+  static Key ComputeKey(const char* source, size_t length, const char* url);
+
+  BytecodeCache(std::string directory, size_t max_bytes);
+  ~BytecodeCache();
+
+  // Returns nullptr on a miss, or when the entry is truncated or corrupted.
+  std::unique_ptr<Entry> Lookup(const Key& key);
+  // Copies |bytecode| and writes the entry in the background.
+  void Store(const Key& key, const uint8_t* bytecode, size_t length);
+  void Remove(const Key& key);
+  // Blocks until the pending writes reached the disk.
+  void Flush();
+
+  size_t TotalBytes();
+  const std::string& directory() const { return directory_; }
+  uint64_t hits() const { return hits_; }
+  uint64_t misses() const { return misses_; }
+
+ private:
+  struct IndexEntry {
+    std::string name;
+    size_t size;
+  };
+
+  std::string PathOf(const std::string& name) const { return directory_ + "/" + name; }
+  void PostTask(std::function<void()>&& task);
+  void RunTasks();
+
+  // The index is only used by the tasks, which run one after another on the worker thread.
+  void LoadIndex();
+  void Touch(const std::string& name);
+  void Write(const std::string& name, const Key& key, const std::string& bytecode);
+  void Erase(const std::string& name);
+  void Evict();
+
+  std::string directory_;
+  size_t max_bytes_;
+  std::atomic<uint64_t> hits_{0};
+  std::atomic<uint64_t> misses_{0};
+
+  // The least recently used entry at the back.
+  std::list<IndexEntry> lru_;
+  std::unordered_map<std::string, std::list<IndexEntry>::iterator> index_;
+  std::atomic<size_t> total_bytes_{0};
+
+  std::mutex tasks_mutex_;
+  std::condition_variable tasks_changed_;
+  std::deque<std::function<void()>> tasks_;
+  bool running_task_{false};
+  bool stopping_{false};
+  std::thread worker_;
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_BINDINGS_QJS_BYTECODE_CACHE_H_
@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "bytecode_cache.h"
+#include <filesystem>
+#include <fstream>
+#include "gtest/gtest.h"
+#include "page.h"
+#include "webf_test_env.h"
+
+using namespace webf;
+
+namespace {
+
+std::filesystem::path FreshDirectory(const char* name) {
+  auto directory = std::filesystem::temp_directory_path() / name;
+  std::filesystem::remove_all(directory);
+  std::filesystem::create_directories(directory);
+  return directory;
+}
+
+std::string LargeScript(const char* name) {
+  std::string code = "var " + std::string(name) + " = 0;\n";
+  while (code.size() < BytecodeCache::kMinSourceLength) {
+    code += std::string(name) + " += 1;\n";
+  }
+  return code;
+}
+
+}  // namespace
+
+TEST(BytecodeCache, storeAndLookup) {
+  auto directory = FreshDirectory("webf_bytecode_cache_store");
+  std::string source = "function foo() { return 1; }";
+  auto key = BytecodeCache::ComputeKey(source.data(), source.size(), "https://example.com/a.js");
+  EXPECT_FALSE(key == BytecodeCache::ComputeKey(source.data(), source.size(), "https://example.com/b.js"));
+
+  std::string bytecode(1000, 'x');
+  {
+    BytecodeCache cache(directory.string(), BytecodeCache::kDefaultMaxBytes);
+    EXPECT_EQ(cache.Lookup(key), nullptr);
+    cache.Store(key, reinterpret_cast<const uint8_t*>(bytecode.data()), bytecode.size());
+    cache.Flush();
+    EXPECT_EQ(cache.TotalBytes(), bytecode.size() + BytecodeCache::kHeaderSize);
+  }
+
+  // Entries outlive the cache object.
+  BytecodeCache cache(directory.string(), BytecodeCache::kDefaultMaxBytes);
+  auto entry = cache.Lookup(key);
+  ASSERT_NE(entry, nullptr);
+  EXPECT_EQ(std::string(reinterpret_cast<const char*>(entry->data()), entry->size()), bytecode);
+  EXPECT_EQ(cache.hits(), 1);
+  EXPECT_EQ(cache.misses(), 0);
+
+  cache.Remove(key);
+  cache.Flush();
+  EXPECT_EQ(cache.Lookup(key), nullptr);
+  EXPECT_EQ(cache.TotalBytes(), 0);
+}
+
+TEST(BytecodeCache, rejectCorruptedEntry) {
+  auto directory = FreshDirectory("webf_bytecode_cache_corrupted");
+  std::string source = "function foo() { return 1; }";
+  auto key = BytecodeCache::ComputeKey(source.data(), source.size(), "");
+  std::string bytecode(1000, 'x');
+
+  BytecodeCache cache(directory.string(), BytecodeCache::kDefaultMaxBytes);
+  cache.Store(key, reinterpret_cast<const uint8_t*>(bytecode.data()), bytecode.size());
+  cache.Flush();
+
+  {
+    std::fstream file(directory / key.FileName(), std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(BytecodeCache::kHeaderSize + 10);
+    file.put('y');
+  }
+  EXPECT_EQ(cache.Lookup(key), nullptr);
+
+  std::filesystem::resize_file(directory / key.FileName(), BytecodeCache::kHeaderSize + 10);
+  EXPECT_EQ(cache.Lookup(key), nullptr);
+  EXPECT_EQ(cache.misses(), 2);
+}
+
+TEST(BytecodeCache, evictLeastRecentlyUsed) {
+  auto directory = FreshDirectory("webf_bytecode_cache_evict");
+  std::string bytecode(1000, 'x');
+  size_t entry_size = bytecode.size() + BytecodeCache::kHeaderSize;
+
+  BytecodeCache cache(directory.string(), entry_size * 3);
+  std::vector<BytecodeCache::Key> keys;
+  for (int i = 0; i < 4; i++) {
+    std::string source = "script " + std::to_string(i);
+    keys.push_back(BytecodeCache::ComputeKey(source.data(), source.size(), ""));
+    cache.Store(keys.back(), reinterpret_cast<const uint8_t*>(bytecode.data()), bytecode.size());
+    cache.Flush();
+    if (i == 2) {
+      // Used recently, the second entry is evicted instead.
+      EXPECT_NE(cache.Lookup(keys[0]), nullptr);
+      cache.Flush();
+    }
+  }
+
+  EXPECT_EQ(cache.TotalBytes(), entry_size * 3);
+  EXPECT_NE(cache.Lookup(keys[0]), nullptr);
+  EXPECT_EQ(cache.Lookup(keys[1]), nullptr);
+  EXPECT_NE(cache.Lookup(keys[2]), nullptr);
+  EXPECT_NE(cache.Lookup(keys[3]), nullptr);
+}
+
+TEST(BytecodeCache, evaluateLargeScripts) {
+  auto directory = FreshDirectory("webf_bytecode_cache_evaluate");
+  BytecodeCache::Configure(directory.string());
+  auto cache = BytecodeCache::Current();
+  ASSERT_NE(cache, nullptr);
+
+  std::string code = LargeScript("counter") + "console.log(counter);";
+  std::string small = "console.log('small');";
+  for (int i = 0; i < 2; i++) {
+    auto env = TEST_init();
+    env->page()->evaluateScript(code.c_str(), code.size(), "https://example.com/app.js", 0);
+    env->page()->evaluateScript(small.c_str(), small.size(), "https://example.com/small.js", 0);
+    cache->Flush();
+  }
+
+  // Small scripts don't go through the cache.
+  EXPECT_EQ(cache->misses(), 1);
+  EXPECT_EQ(cache->hits(), 1);
+
+  BytecodeCache::Configure("");
+  EXPECT_EQ(BytecodeCache::Current(), nullptr);
+}
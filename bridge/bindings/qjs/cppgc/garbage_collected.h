@@ -7,11 +7,13 @@
 
 #include <quickjs/quickjs.h>
 #include <memory>
+#include <new>
 
 #include "bindings/qjs/qjs_engine_patch.h"
 #include "foundation/casting.h"
 #include "foundation/macros.h"
 #include "local_handle.h"
+#include "object_heap.h"
 
 namespace webf {
 
@@ -39,6 +41,8 @@ class GarbageCollected {
   // Must use MakeGarbageCollected.
   void* operator new(size_t) = delete;
   void* operator new[](size_t) = delete;
+  // The memory comes from the ObjectHeap, |size| is the size of the most derived type.
+  void operator delete(void* ptr, size_t size) { ObjectHeap::Free(ptr, size); }
 
   /**
    * This Trace method must be override by objects inheriting from
@@ -48,10 +52,16 @@ class GarbageCollected {
 
   virtual void InitializeQuickJSObject(){};
 
+  uint32_t allocation_size() const { return allocation_size_; }
+
  protected:
   GarbageCollected(){};
   ~GarbageCollected() = default;
-  friend class MakeGarbageCollectedTrait<T>;
+
+  // The size of the most derived type, set by MakeGarbageCollected.
+  uint32_t allocation_size_{0};
+  template <typename>
+  friend class MakeGarbageCollectedTrait;
 };
 
 template <typename T>
@@ -59,7 +69,9 @@ class MakeGarbageCollectedTrait {
  public:
   template <typename... Args>
   static T* Allocate(Args&&... args) {
-    T* object = ::new T(std::forward<Args>(args)...);
+    void* memory = ObjectHeap::Allocate(sizeof(T));
+    T* object = ::new (memory) T(std::forward<Args>(args)...);
+    object->allocation_size_ = sizeof(T);
     object->InitializeQuickJSObject();
     return object;
   }
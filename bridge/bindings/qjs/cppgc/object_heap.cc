@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "object_heap.h"
+#include <new>
+#if ENABLE_MI_MALLOC
+#include "mimalloc.h"
+#endif
+
+namespace webf {
+
+#if ENABLE_MI_MALLOC
+static thread_local mi_heap_t* heap_{nullptr};
+#endif
+static thread_local int64_t live_objects_{0};
+static thread_local int64_t live_bytes_{0};
+
+void ObjectHeap::Initialize() {
+#if ENABLE_MI_MALLOC
+  if (heap_ == nullptr) {
+    heap_ = mi_heap_new();
+  }
+#endif
+}
+
+void ObjectHeap::Dispose() {
+#if ENABLE_MI_MALLOC
+  if (heap_ != nullptr) {
+    mi_heap_delete(heap_);
+    heap_ = nullptr;
+  }
+#endif
+}
+
+void* ObjectHeap::Allocate(size_t size) {
+  live_objects_++;
+  live_bytes_ += size;
+#if ENABLE_MI_MALLOC
+  void* ptr = heap_ != nullptr ? mi_heap_malloc(heap_, size) : mi_malloc(size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+#else
+  return ::operator new(size);
+#endif
+}
+
+void ObjectHeap::Free(void* ptr, size_t size) {
+  // Counted on the thread freeing the object, which is the JS thread of the object.
+  live_objects_--;
+  live_bytes_ -= size;
+#if ENABLE_MI_MALLOC
+  mi_free(ptr);
+#else
+  ::operator delete(ptr);
+#endif
+}
+
+ObjectHeap::Stats ObjectHeap::stats() {
+  Stats stats;
+  stats.live_objects = live_objects_;
+  stats.live_bytes = live_bytes_;
+#if ENABLE_MI_MALLOC
+  if (heap_ != nullptr) {
+    mi_heap_visit_blocks(
+        heap_, false,
+        [](const mi_heap_t* heap, const mi_heap_area_t* area, void* block, size_t block_size, void* arg) -> bool {
+          auto* stats = static_cast<Stats*>(arg);
+          stats->committed_bytes += area->committed;
+          stats->used_bytes += area->used * area->block_size;
+          return true;
+        },
+        &stats);
+  }
+#endif
+  return stats;
+}
+
+}  // namespace webf
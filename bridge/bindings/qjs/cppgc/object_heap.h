@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef BRIDGE_BINDINGS_QJS_CPPGC_OBJECT_HEAP_H_
+#define BRIDGE_BINDINGS_QJS_CPPGC_OBJECT_HEAP_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace webf {
+
+// The memory of the ScriptWrappables created by MakeGarbageCollected.
+//
+// With mimalloc every JS thread allocates them from its own heap, next to the heap QuickJS uses for the runtime of the
+// thread. mimalloc keeps the objects of a size class in the same pages, so the Elements, Texts and Events are packed
+// in their own slabs instead of interleaving with the JS engine memory, and the pages are given back together when
+// the runtime of the thread is freed. Without mimalloc it is the default allocator.
+class ObjectHeap {
+ public:
+  // Every field is for the current thread only, the counters are thread_local and not summed across the JS threads.
+  struct Stats {
+    // Counted by Allocate() and Free() on the current thread.
+    int64_t live_objects{0};
+    int64_t live_bytes{0};
+    // The memory committed by the pages of the heap, and the part held by live objects.
+    size_t committed_bytes{0};
+    size_t used_bytes{0};
+  };
+
+  // Creates the heap of the current thread, threads without a heap use the default heap of mimalloc.
+  static void Initialize();
+  // Deletes the heap of the current thread, the objects still alive move to the default heap.
+  static void Dispose();
+
+  static void* Allocate(size_t size);
+  // Objects may be freed from any thread, they are uncounted from the stats of the thread which frees them.
+  static void Free(void* ptr, size_t size);
+
+  // The stats of the current thread.
+  static Stats stats();
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_BINDINGS_QJS_CPPGC_OBJECT_HEAP_H_
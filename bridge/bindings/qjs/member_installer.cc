@@ -78,4 +78,19 @@ void MemberInstaller::InstallFunctions(ExecutingContext* context,
   }
 }
 
+static JSValue InitializeConstructor(JSContext* ctx, JSValueConst this_obj, JSAtom key, void* opaque) {
+  auto* wrapper_type_info = static_cast<const WrapperTypeInfo*>(opaque);
+  // The property takes over the reference held by the context data, as JS_DefinePropertyValue did.
+  return ExecutingContext::From(ctx)->contextData()->constructorForType(wrapper_type_info);
+}
+
+void MemberInstaller::InstallConstructors(ExecutingContext* context,
+                                          JSValue root,
+                                          std::initializer_list<ConstructorConfig> config) {
+  JSContext* ctx = context->ctx();
+  for (auto& c : config) {
+    JS_DefineLazyProperty(ctx, root, c.key, InitializeConstructor, (void*)c.wrapper_type_info, c.flag);
+  }
+}
+
 }  // namespace webf
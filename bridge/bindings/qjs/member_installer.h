@@ -12,6 +12,7 @@
 namespace webf {
 
 class ExecutingContext;
+class WrapperTypeInfo;
 
 // Flags for object properties.
 enum JSPropFlag {
@@ -37,6 +38,14 @@ class MemberInstaller {
     int flag{JS_PROP_C_W_E};  // Flags for object properties.
   };
 
+  // A constructor whose class and prototype chain are created when the property is first read.
+  struct ConstructorConfig {
+    ConstructorConfig& operator=(const ConstructorConfig&) = delete;
+    JSAtom key;
+    const WrapperTypeInfo* wrapper_type_info;
+    int flag{JS_PROP_C_W_E};  // Flags for object properties.
+  };
+
   struct FunctionConfig {
     FunctionConfig& operator=(const FunctionConfig&) = delete;
     const char* name;
@@ -47,6 +56,9 @@ class MemberInstaller {
 
   static void InstallAttributes(ExecutingContext* context, JSValue root, std::initializer_list<AttributeConfig> config);
   static void InstallFunctions(ExecutingContext* context, JSValue root, std::initializer_list<FunctionConfig> config);
+  static void InstallConstructors(ExecutingContext* context,
+                                  JSValue root,
+                                  std::initializer_list<ConstructorConfig> config);
 };
 
 }  // namespace webf
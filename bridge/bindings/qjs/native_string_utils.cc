@@ -4,8 +4,13 @@
  */
 
 #include "native_string_utils.h"
+#include <algorithm>
 #include "bindings/qjs/qjs_engine_patch.h"
 
+#if WIN32
+#include <Windows.h>
+#endif
+
 namespace webf {
 
 std::unique_ptr<SharedNativeString> jsValueToNativeString(JSContext* ctx, JSValue value) {
@@ -19,8 +24,14 @@ std::unique_ptr<SharedNativeString> jsValueToNativeString(JSContext* ctx, JSValu
   }
 
   uint32_t length;
-  uint16_t* buffer = JS_ToUnicode(ctx, value, &length);
-  std::unique_ptr<SharedNativeString> ptr = std::make_unique<SharedNativeString>(buffer, length);
+  std::unique_ptr<SharedNativeString> ptr;
+  // Latin-1 strings cross to dart as they are, without widening to UTF-16.
+  if (uint8_t* latin1 = JS_ToLatin1(ctx, value, &length)) {
+    ptr = std::make_unique<SharedNativeString>(latin1, length);
+  } else {
+    uint16_t* buffer = JS_ToUnicode(ctx, value, &length);
+    ptr = std::make_unique<SharedNativeString>(buffer, length);
+  }
 
   if (!isValueString) {
     JS_FreeValue(ctx, value);
@@ -28,17 +39,30 @@ std::unique_ptr<SharedNativeString> jsValueToNativeString(JSContext* ctx, JSValu
   return ptr;
 }
 
+JSValue nativeStringToJSValue(JSContext* ctx, const SharedNativeString* native_string) {
+  if (native_string->Is8Bit()) {
+    return JS_NewRawUTF8String(ctx, native_string->characters8(), native_string->length());
+  }
+  return JS_NewUnicodeString(ctx, native_string->string(), native_string->length());
+}
+
 std::unique_ptr<SharedNativeString> stringToNativeString(const std::string& string) {
-  std::u16string utf16;
-  fromUTF8(string, utf16);
-  SharedNativeString tmp{reinterpret_cast<const uint16_t*>(utf16.c_str()), static_cast<uint32_t>(utf16.size())};
-  return SharedNativeString::FromTemporaryString(tmp.string(), tmp.length());
+  // Every UTF-8 byte produces at most one UTF-16 code unit.
+  size_t capacity = std::max<size_t>(string.size(), 1) * sizeof(uint16_t);
+#if WIN32
+  auto* buffer = static_cast<uint16_t*>(CoTaskMemAlloc(capacity));
+#else
+  auto* buffer = static_cast<uint16_t*>(malloc(capacity));
+#endif
+  size_t length = UTF8ToUTF16(string.data(), string.size(), buffer);
+  return std::make_unique<SharedNativeString>(buffer, static_cast<uint32_t>(length));
 }
 
 std::string nativeStringToStdString(const SharedNativeString* native_string) {
-  std::u16string u16EventType =
-      std::u16string(reinterpret_cast<const char16_t*>(native_string->string()), native_string->length());
-  return toUTF8(u16EventType);
+  if (native_string->Is8Bit()) {
+    return Latin1ToUTF8String(native_string->characters8(), native_string->length());
+  }
+  return UTF16ToUTF8String(native_string->string(), native_string->length());
 }
 
 std::unique_ptr<SharedNativeString> atomToNativeString(JSContext* ctx, JSAtom atom) {
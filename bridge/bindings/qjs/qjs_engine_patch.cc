@@ -7,6 +7,7 @@
 #include <quickjs/cutils.h>
 #include <quickjs/list.h>
 #include <cstring>
+#include "foundation/transcoding.h"
 
 #if WIN32
 #include <Windows.h>
@@ -31,7 +32,9 @@ typedef enum {
 struct JSGCObjectHeader {
   int ref_count; /* must come first, 32-bit */
   JSGCObjectTypeEnum gc_obj_type : 4;
-  uint8_t mark : 4; /* used by the GC */
+  uint8_t mark : 1; /* used by the GC */
+  uint8_t old : 1;
+  uint8_t age : 2;
   uint8_t dummy1;   /* not used by the GC */
   uint16_t dummy2;  /* not used by the GC */
   struct list_head link;
@@ -252,37 +255,15 @@ uint16_t* JS_ToUnicode(JSContext* ctx, JSValueConst value, uint32_t* length) {
   uint16_t* buffer;
   JSString* string = JS_VALUE_GET_STRING(value);
 
-  if (!string->is_wide_char) {
-    uint8_t* p = string->u.str8;
+  *length = string->len;
 #if WIN32
-    int utf16_str_len = MultiByteToWideChar(CP_ACP, 0, reinterpret_cast<const char*>(p), -1, NULL, 0) - 1;
-    if (utf16_str_len == -1) {
-      return nullptr;
-    }
-    // Allocate memory for the UTF-16 string, including the null terminator
-    buffer = (uint16_t*)CoTaskMemAlloc((utf16_str_len + 1) * sizeof(WCHAR));
-    if (buffer == nullptr) {
-      return nullptr;
-    }
-
-    // Convert the ASCII string to UTF-16
-    MultiByteToWideChar(CP_ACP, 0, reinterpret_cast<const char*>(p), -1, (WCHAR*)buffer, utf16_str_len + 1);
-    *length = utf16_str_len;
+  buffer = (uint16_t*)CoTaskMemAlloc(sizeof(uint16_t) * string->len);
 #else
-    uint32_t len = *length = string->len;
-    buffer = (uint16_t*)malloc(sizeof(uint16_t) * len * 2);
-    for (size_t i = 0; i < len; i++) {
-      buffer[i] = p[i];
-      buffer[i + 1] = 0x00;
-    }
+  buffer = (uint16_t*)malloc(sizeof(uint16_t) * string->len);
 #endif
+  if (!string->is_wide_char) {
+    webf::Latin1ToUTF16(string->u.str8, string->len, buffer);
   } else {
-    *length = string->len;
-#if WIN32
-    buffer = (uint16_t*)CoTaskMemAlloc(sizeof(uint16_t) * string->len);
-#else
-    buffer = (uint16_t*)malloc(sizeof(uint16_t) * string->len);
-#endif
     memcpy(buffer, string->u.str16, sizeof(uint16_t) * string->len);
   }
 
@@ -290,6 +271,26 @@ uint16_t* JS_ToUnicode(JSContext* ctx, JSValueConst value, uint32_t* length) {
   return buffer;
 }
 
+uint8_t* JS_ToLatin1(JSContext* ctx, JSValueConst value, uint32_t* length) {
+  if (JS_VALUE_GET_TAG(value) != JS_TAG_STRING)
+    return nullptr;
+
+  JSString* string = JS_VALUE_GET_STRING(value);
+  if (string->is_wide_char)
+    return nullptr;
+
+  *length = string->len;
+  // Keep at least one byte, so an empty string still owns a buffer.
+#if WIN32
+  auto* buffer = (uint8_t*)CoTaskMemAlloc(string->len + 1);
+#else
+  auto* buffer = (uint8_t*)malloc(string->len + 1);
+#endif
+  memcpy(buffer, string->u.str8, string->len);
+  buffer[string->len] = 0;
+  return buffer;
+}
+
 static JSString* js_alloc_string_rt(JSRuntime* rt, int max_len, int is_wide_char) {
   JSString* str;
   str = static_cast<JSString*>(js_malloc_rt(rt, sizeof(JSString) + (max_len << is_wide_char) + 1 - is_wide_char));
@@ -362,6 +363,13 @@ bool JS_IsProxy(JSValue value) {
   return p->class_id == JS_CLASS_PROXY;
 }
 
+int JS_GetOwnPropertyCount(JSValueConst value) {
+  if (!JS_IsObject(value))
+    return 0;
+  JSObject* p = JS_VALUE_GET_OBJ(value);
+  return p->shape->prop_count - p->shape->deleted_prop_count;
+}
+
 bool JS_IsPromise(JSValue value) {
   if (!JS_IsObject(value))
     return false;
@@ -383,6 +391,25 @@ bool JS_IsArrayBufferView(JSValue value) {
   return p->class_id >= JS_CLASS_UINT8C_ARRAY && p->class_id <= JS_CLASS_DATAVIEW;
 }
 
+JSValue JS_GetArrayBufferViewBuffer(JSContext* ctx, JSValueConst value, size_t* byte_offset, size_t* byte_length) {
+  if (JSValueGetClassId(value) != JS_CLASS_DATAVIEW) {
+    size_t bytes_per_element;
+    return JS_GetTypedArrayBuffer(ctx, value, byte_offset, byte_length, &bytes_per_element);
+  }
+
+  int64_t offset, length;
+  JSValue offset_value = JS_GetPropertyStr(ctx, value, "byteOffset");
+  JSValue length_value = JS_GetPropertyStr(ctx, value, "byteLength");
+  int result = JS_ToInt64(ctx, &offset, offset_value) | JS_ToInt64(ctx, &length, length_value);
+  JS_FreeValue(ctx, offset_value);
+  JS_FreeValue(ctx, length_value);
+  if (result < 0)
+    return JS_EXCEPTION;
+  *byte_offset = offset;
+  *byte_length = length;
+  return JS_GetPropertyStr(ctx, value, "buffer");
+}
+
 bool JS_HasClassId(JSRuntime* runtime, JSClassID classId) {
   if (runtime->class_count <= classId)
     return false;
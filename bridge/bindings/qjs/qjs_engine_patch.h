@@ -115,6 +115,8 @@ static inline bool __JS_AtomIsConst(JSAtom v) {
 }
 
 uint16_t* JS_ToUnicode(JSContext* ctx, JSValueConst value, uint32_t* length);
+// Copy the characters of an 8-bit string into a new buffer, returns nullptr if the string contains 16-bit characters.
+uint8_t* JS_ToLatin1(JSContext* ctx, JSValueConst value, uint32_t* length);
 JSValue JS_NewUnicodeString(JSContext* ctx, const uint16_t* code, uint32_t length);
 JSValue JS_NewRawUTF8String(JSContext* ctx, const uint8_t* code, uint32_t length);
 JSAtom JS_NewUnicodeAtom(JSContext* ctx, const uint16_t* code, uint32_t length);
@@ -123,7 +125,11 @@ bool JS_IsProxy(JSValue value);
 bool JS_IsPromise(JSValue value);
 bool JS_IsArrayBuffer(JSValue value);
 bool JS_IsArrayBufferView(JSValue value);
+// Same as JS_GetTypedArrayBuffer() but also accepts DataView.
+JSValue JS_GetArrayBufferViewBuffer(JSContext* ctx, JSValueConst value, size_t* byte_offset, size_t* byte_length);
 bool JS_HasClassId(JSRuntime* runtime, JSClassID classId);
+// Count the own properties stored in the shape of the object without collecting their names.
+int JS_GetOwnPropertyCount(JSValueConst value);
 int JS_AtomIs8Bit(JSRuntime* runtime, JSAtom atom);
 const uint8_t* JS_AtomRawCharacter8(JSRuntime* runtime, JSAtom atom);
 const uint16_t* JS_AtomRawCharacter16(JSRuntime* runtime, JSAtom atom);
@@ -100,3 +100,320 @@ TEST(JS_NewUnicodeString, fromChieseCode) {
   JS_FreeContext(ctx);
   JS_FreeRuntime(runtime);
 }
+
+TEST(JS_DefineLazyProperty, initializeOnFirstAccess) {
+  JSRuntime* runtime = JS_NewRuntime();
+  JSContext* ctx = JS_NewContext(runtime);
+  static int init_count = 0;
+  auto init = [](JSContext* ctx, JSValueConst this_obj, JSAtom prop, void* opaque) -> JSValue {
+    init_count++;
+    return JS_NewInt32(ctx, *static_cast<int*>(opaque));
+  };
+  static int value = 42;
+  JSValue global = JS_GetGlobalObject(ctx);
+  JSAtom lazy = JS_NewAtom(ctx, "lazy");
+  JSAtom overwritten = JS_NewAtom(ctx, "overwritten");
+  JS_DefineLazyProperty(ctx, global, lazy, init, &value, JS_PROP_C_W_E);
+  JS_DefineLazyProperty(ctx, global, overwritten, init, &value, JS_PROP_C_W_E);
+
+  const char* code =
+      "var keys = Object.keys(globalThis).filter(k => k == 'lazy').length;"
+      "overwritten = 1;"
+      "[keys, 'lazy' in globalThis, lazy, lazy, overwritten].join(',')";
+  EXPECT_EQ(init_count, 0);
+  JSValue result = JS_Eval(ctx, code, strlen(code), "vm://", JS_EVAL_TYPE_GLOBAL);
+  const char* str = JS_ToCString(ctx, result);
+  EXPECT_STREQ(str, "1,true,42,42,1");
+  // Built once for 'lazy', and once for 'overwritten' as quickjs instantiates a property before writing it.
+  EXPECT_EQ(init_count, 2);
+
+  JS_FreeCString(ctx, str);
+  JS_FreeValue(ctx, result);
+  JS_FreeAtom(ctx, lazy);
+  JS_FreeAtom(ctx, overwritten);
+  JS_FreeValue(ctx, global);
+  JS_FreeContext(ctx);
+  JS_FreeRuntime(runtime);
+}
+
+TEST(JS_DefineLazyProperty, freedWithoutAccess) {
+  JSRuntime* runtime = JS_NewRuntime();
+  JSContext* ctx = JS_NewContext(runtime);
+  auto init = [](JSContext* ctx, JSValueConst this_obj, JSAtom prop, void* opaque) -> JSValue {
+    ADD_FAILURE();
+    return JS_UNDEFINED;
+  };
+  JSValue object = JS_NewObject(ctx);
+  JSAtom lazy = JS_NewAtom(ctx, "lazy");
+  JS_DefineLazyProperty(ctx, object, lazy, init, nullptr, JS_PROP_C_W_E);
+  JS_FreeAtom(ctx, lazy);
+  JS_FreeValue(ctx, object);
+  JS_FreeContext(ctx);
+  JS_FreeRuntime(runtime);
+}
+
+TEST(JS_ExternalAtoms, internedOnce) {
+  JSRuntime* runtime = JS_NewRuntime();
+  JSContext* ctx = JS_NewContext(runtime);
+  JSAtom click = JS_NewAtom(ctx, "click");
+  EXPECT_EQ(click, JS_ATOM_webf_click);
+  EXPECT_EQ(JS_NewAtom(ctx, "accept-charset"), JS_ATOM_webf_accept_charset);
+  // Static atoms are not reference counted.
+  JS_FreeAtom(ctx, click);
+  JS_FreeAtom(ctx, click);
+  const char* str = JS_AtomToCString(ctx, JS_ATOM_webf_click);
+  EXPECT_STREQ(str, "click");
+  JS_FreeCString(ctx, str);
+  JS_FreeContext(ctx);
+  JS_FreeRuntime(runtime);
+}
+
+TEST(JS_ExternalAtoms, bytecodeStoresThemByName) {
+  JSRuntime* runtime = JS_NewRuntime();
+  JSContext* ctx = JS_NewContext(runtime);
+  const char* code = "({click: 1, scrollBy: 2}).click + ({click: 1, scrollBy: 2}).scrollBy";
+  JSValue function = JS_Eval(ctx, code, strlen(code), "vm://", JS_EVAL_TYPE_GLOBAL | JS_EVAL_FLAG_COMPILE_ONLY);
+  size_t length;
+  uint8_t* bytes = JS_WriteObject(ctx, &length, function, JS_WRITE_OBJ_BYTECODE);
+  JS_FreeValue(ctx, function);
+
+  // The names are in the atom table of the bytecode, which keeps it readable when the external atoms change.
+  std::string bytecode(reinterpret_cast<char*>(bytes), length);
+  EXPECT_NE(bytecode.find("scrollBy"), std::string::npos);
+
+  function = JS_ReadObject(ctx, bytes, length, JS_READ_OBJ_BYTECODE);
+  JSValue result = JS_EvalFunction(ctx, function);
+  int32_t value;
+  JS_ToInt32(ctx, &value, result);
+  EXPECT_EQ(value, 3);
+
+  JS_FreeValue(ctx, result);
+  js_free(ctx, bytes);
+  JS_FreeContext(ctx);
+  JS_FreeRuntime(runtime);
+}
+
+TEST(JS_TerminateExecution, uncatchableAndPermanent) {
+  JSRuntime* runtime = JS_NewRuntime();
+  JSContext* ctx = JS_NewContext(runtime);
+  JSContext* other = JS_NewContext(runtime);
+  JS_TerminateExecution(ctx);
+  EXPECT_TRUE(JS_IsExecutionTerminated(ctx));
+
+  const char* code = "let caught = false; try { for (;;) {} } catch (e) { caught = true; } caught";
+  for (int i = 0; i < 2; i++) {
+    JSValue result = JS_Eval(ctx, code, strlen(code), "vm://", JS_EVAL_TYPE_GLOBAL);
+    EXPECT_TRUE(JS_IsException(result));
+    JS_FreeValue(ctx, JS_GetException(ctx));
+  }
+
+  // The other contexts of the runtime keep running.
+  JSValue result = JS_Eval(other, "1 + 1", 5, "vm://", JS_EVAL_TYPE_GLOBAL);
+  EXPECT_EQ(JS_VALUE_GET_INT(result), 2);
+
+  JS_FreeContext(other);
+  JS_FreeContext(ctx);
+  JS_FreeRuntime(runtime);
+}
+
+TEST(JS_ComputeContextMemoryUsage, attributesObjectsToTheirRealm) {
+  JSRuntime* runtime = JS_NewRuntime();
+  JSContext* contexts[2] = {JS_NewContext(runtime), JS_NewContext(runtime)};
+  int64_t before[2];
+  JS_ComputeContextMemoryUsage(runtime, contexts, before, 2);
+  EXPECT_GT(before[0], 0);
+  EXPECT_GT(before[1], 0);
+
+  const char* code = "globalThis.retained = new Array(10000).fill(0).map((_, i) => ({i}));";
+  JS_FreeValue(contexts[0], JS_Eval(contexts[0], code, strlen(code), "vm://", JS_EVAL_TYPE_GLOBAL));
+  int64_t after[2];
+  JS_ComputeContextMemoryUsage(runtime, contexts, after, 2);
+  EXPECT_GT(after[0], before[0] + 10000 * static_cast<int64_t>(sizeof(JSValue)));
+  EXPECT_EQ(after[1], before[1]);
+
+  JS_FreeContext(contexts[1]);
+  JS_FreeContext(contexts[0]);
+  JS_FreeRuntime(runtime);
+}
+
+static std::string EvalToString(JSContext* ctx, const char* code) {
+  JSValue result = JS_Eval(ctx, code, strlen(code), "vm://", JS_EVAL_TYPE_GLOBAL);
+  const char* str = JS_ToCString(ctx, result);
+  std::string value = str ? str : "<exception>";
+  JS_FreeCString(ctx, str);
+  JS_FreeValue(ctx, result);
+  return value;
+}
+
+TEST(InlineCache, accessorsOnPrototypeChain) {
+  JSRuntime* runtime = JS_NewRuntime();
+  JSContext* ctx = JS_NewContext(runtime);
+  const char* code =
+      "class A { get v() { return 'A'; } set v(x) { this._v = x; } }"
+      "class B extends A {}"
+      "class C extends B {}"
+      "function get(o) { return o.v; }"
+      "function set(o, x) { o.v = x; }"
+      "let c = new C(); let out = [get(c), get(c)];"
+      "set(c, 1); set(c, 2); out.push(c._v);"
+      // Redefining the accessor, shadowing it on an intermediate prototype or on the object.
+      "Object.defineProperty(A.prototype, 'v', { get() { return 'A2'; }, configurable: true }); out.push(get(c));"
+      "Object.defineProperty(B.prototype, 'v', { value: 'B', configurable: true }); out.push(get(c));"
+      "delete B.prototype.v; out.push(get(c));"
+      "Object.setPrototypeOf(C.prototype, { get v() { return 'D'; } }); out.push(get(c));"
+      "Object.defineProperty(c, 'v', { value: 'own', writable: false }); out.push(get(c));"
+      "out.join()";
+  EXPECT_EQ(EvalToString(ctx, code), "A,A,2,A2,B,A2,D,own");
+  JS_FreeContext(ctx);
+  JS_FreeRuntime(runtime);
+}
+
+TEST(InlineCache, megamorphicSites) {
+  JSRuntime* runtime = JS_NewRuntime();
+  JSContext* ctx = JS_NewContext(runtime);
+  // 30 shapes overflow the ring of each site.
+  const char* code =
+      "class N { get parentNode() { return 1; } }"
+      "let objects = [];"
+      "for (let i = 0; i < 30; i++) { let o = new N(); o['k' + i] = i; o.x = i; objects.push(o); }"
+      "function sum() { let s = 0; for (const o of objects) { s += o.x + o.parentNode; o.x = o.x + 1; } return s; }"
+      "let result = [sum(), sum()];"
+      "Object.defineProperty(N.prototype, 'parentNode', { value: 2 });"
+      "result.push(sum()); result.join()";
+  EXPECT_EQ(EvalToString(ctx, code), "465,495,555");
+  JS_FreeContext(ctx);
+  JS_FreeRuntime(runtime);
+}
+
+static int own_property_lookups = 0;
+
+TEST(InlineCache, skipsOwnPropertiesFromPrototype) {
+  JSRuntime* runtime = JS_NewRuntime();
+  JSContext* ctx = JS_NewContext(runtime);
+  JSClassID class_id = 0;
+  JS_NewClassID(&class_id);
+  JSClassExoticMethods exotic{};
+  exotic.get_own_property = [](JSContext* ctx, JSPropertyDescriptor* desc, JSValueConst obj, JSAtom prop) -> int {
+    own_property_lookups++;
+    return false;
+  };
+  exotic.own_properties_from_prototype = true;
+  JSClassDef def{};
+  def.class_name = "Wrapper";
+  def.exotic = &exotic;
+  JS_NewClass(runtime, class_id, &def);
+
+  const char* code = "globalThis.Base = class { get style() { return 'style'; } };";
+  JS_FreeValue(ctx, JS_Eval(ctx, code, strlen(code), "vm://", JS_EVAL_TYPE_GLOBAL));
+  JSValue global = JS_GetGlobalObject(ctx);
+  JSValue object = JS_NewObjectClass(ctx, class_id);
+  JSValue base = JS_GetPropertyStr(ctx, global, "Base");
+  JSValue prototype = JS_GetPropertyStr(ctx, base, "prototype");
+  JS_SetPrototype(ctx, object, prototype);
+  JS_SetPropertyStr(ctx, global, "wrapper", object);
+
+  EXPECT_EQ(EvalToString(ctx, "let s = ''; for (let i = 0; i < 3; i++) s += wrapper.style; s"), "stylestylestyle");
+  EXPECT_EQ(own_property_lookups, 0);
+
+  JS_FreeValue(ctx, prototype);
+  JS_FreeValue(ctx, base);
+  JS_FreeValue(ctx, global);
+  JS_FreeContext(ctx);
+  JS_FreeRuntime(runtime);
+}
+
+static int64_t ObjectCount(JSRuntime* runtime) {
+  JSMemoryUsage usage;
+  JS_ComputeMemoryUsage(runtime, &usage);
+  return usage.obj_count;
+}
+
+TEST(JS_RunMinorGC, freesYoungCycles) {
+  JSRuntime* runtime = JS_NewRuntime();
+  JSContext* ctx = JS_NewContext(runtime);
+  JS_RunGC(runtime);
+  int64_t count = ObjectCount(runtime);
+
+  const char* code = "for (let i = 0; i < 1000; i++) { let a = {}; a.self = a; }";
+  JS_FreeValue(ctx, JS_Eval(ctx, code, strlen(code), "vm://", JS_EVAL_TYPE_GLOBAL));
+  EXPECT_GE(ObjectCount(runtime), count + 1000);
+  JS_RunMinorGC(runtime);
+  EXPECT_LE(ObjectCount(runtime), count + 10);
+
+  JS_FreeContext(ctx);
+  JS_FreeRuntime(runtime);
+}
+
+TEST(JS_RunMinorGC, keepsYoungObjectsOfOldOnes) {
+  JSRuntime* runtime = JS_NewRuntime();
+  JSContext* ctx = JS_NewContext(runtime);
+  const char* code = "globalThis.old = {}";
+  JS_FreeValue(ctx, JS_Eval(ctx, code, strlen(code), "vm://", JS_EVAL_TYPE_GLOBAL));
+  JS_RunGC(runtime);
+
+  code = "old.child = { parent: old }; old.child.self = old.child;";
+  JS_FreeValue(ctx, JS_Eval(ctx, code, strlen(code), "vm://", JS_EVAL_TYPE_GLOBAL));
+  // Promoted after the second one.
+  for (int i = 0; i < 3; i++) {
+    JS_RunMinorGC(runtime);
+  }
+  EXPECT_EQ(EvalToString(ctx, "old.child.self === old.child && old.child.parent === old"), "true");
+
+  // Unreachable cycles through old objects wait for a full collection.
+  int64_t count = ObjectCount(runtime);
+  JS_FreeValue(ctx, JS_Eval(ctx, "delete globalThis.old", 21, "vm://", JS_EVAL_TYPE_GLOBAL));
+  JS_RunMinorGC(runtime);
+  EXPECT_EQ(ObjectCount(runtime), count);
+  JS_RunGC(runtime);
+  EXPECT_EQ(ObjectCount(runtime), count - 2);
+
+  JS_FreeContext(ctx);
+  JS_FreeRuntime(runtime);
+}
+
+TEST(JS_RunMinorGC, freesOldObjectsOfYoungCycles) {
+  JSRuntime* runtime = JS_NewRuntime();
+  JSContext* ctx = JS_NewContext(runtime);
+  const char* code = "globalThis.old = {}";
+  JS_FreeValue(ctx, JS_Eval(ctx, code, strlen(code), "vm://", JS_EVAL_TYPE_GLOBAL));
+  JS_RunGC(runtime);
+  int64_t count = ObjectCount(runtime);
+
+  // |old| and its young child are only referenced by the young cycle.
+  code = "old.child = {}; { let a = { old }; a.self = a; } delete globalThis.old;";
+  JS_FreeValue(ctx, JS_Eval(ctx, code, strlen(code), "vm://", JS_EVAL_TYPE_GLOBAL));
+  JS_RunMinorGC(runtime);
+  EXPECT_EQ(ObjectCount(runtime), count - 1);
+
+  JS_FreeContext(ctx);
+  JS_FreeRuntime(runtime);
+}
+
+TEST(JS_DefineLazyProperty, initializerDefinesProperties) {
+  JSRuntime* runtime = JS_NewRuntime();
+  JSContext* ctx = JS_NewContext(runtime);
+  // Grows the shape of the object that owns the lazy property, as creating a binding class may do.
+  auto init = [](JSContext* ctx, JSValueConst this_obj, JSAtom prop, void* opaque) -> JSValue {
+    char name[16];
+    for (int i = 0; i < 64; i++) {
+      snprintf(name, sizeof(name), "p%d", i);
+      JS_SetPropertyStr(ctx, this_obj, name, JS_NewInt32(ctx, i));
+    }
+    return JS_NewInt32(ctx, 42);
+  };
+  JSValue object = JS_NewObject(ctx);
+  JSAtom lazy = JS_NewAtom(ctx, "lazy");
+  JS_DefineLazyProperty(ctx, object, lazy, init, nullptr, JS_PROP_C_W_E);
+
+  JSValue value = JS_GetProperty(ctx, object, lazy);
+  EXPECT_EQ(JS_VALUE_GET_INT(value), 42);
+  JSValue last = JS_GetPropertyStr(ctx, object, "p63");
+  EXPECT_EQ(JS_VALUE_GET_INT(last), 63);
+
+  JS_FreeValue(ctx, last);
+  JS_FreeValue(ctx, value);
+  JS_FreeAtom(ctx, lazy);
+  JS_FreeValue(ctx, object);
+  JS_FreeContext(ctx);
+  JS_FreeRuntime(runtime);
+}
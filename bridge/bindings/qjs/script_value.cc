@@ -14,6 +14,7 @@
 #include "qjs_bounding_client_rect.h"
 #include "qjs_engine_patch.h"
 #include "qjs_event_target.h"
+#include "structured_serializer.h"
 
 #if WIN32
 #include <Windows.h>
@@ -30,13 +31,13 @@ static JSValue FromNativeValue(ExecutingContext* context,
         auto* string = static_cast<SharedNativeString*>(native_value.u.ptr);
         if (string == nullptr)
           return JS_NULL;
-        JSValue returnedValue = JS_NewUnicodeString(context->ctx(), string->string(), string->length());
+        JSValue returnedValue = nativeStringToJSValue(context->ctx(), string);
         return returnedValue;
       } else {
         std::unique_ptr<AutoFreeNativeString> string{static_cast<AutoFreeNativeString*>(native_value.u.ptr)};
         if (string == nullptr)
           return JS_NULL;
-        JSValue returnedValue = JS_NewUnicodeString(context->ctx(), string->string(), string->length());
+        JSValue returnedValue = nativeStringToJSValue(context->ctx(), string.get());
         return returnedValue;
       }
     }
@@ -64,6 +65,21 @@ static JSValue FromNativeValue(ExecutingContext* context,
       return JS_NewArrayBuffer(context->ctx(), (uint8_t*)native_value.u.ptr, native_value.uint32, free_func, nullptr,
                                0);
     }
+    case NativeTag::TAG_ARRAY_BUFFER: {
+      auto* buffer = static_cast<NativeByteBuffer*>(native_value.u.ptr);
+      // Adopt the bytes without copying, the NativeByteBuffer is released together with the ArrayBuffer.
+      auto free_func = [](JSRuntime* rt, void* opaque, void* ptr) {
+        FreeNativeByteBuffer(static_cast<NativeByteBuffer*>(opaque));
+      };
+      return JS_NewArrayBuffer(context->ctx(), buffer->data + buffer->offset, buffer->length, free_func, buffer, 0);
+    }
+    case NativeTag::TAG_STRUCTURED: {
+      auto* bytes = static_cast<uint8_t*>(native_value.u.ptr);
+      StructuredDeserializer deserializer(context->ctx(), bytes, native_value.uint32);
+      JSValue returnedValue = deserializer.Deserialize();
+      dart_free(bytes);
+      return returnedValue;
+    }
     case NativeTag::TAG_LIST: {
       size_t length = native_value.uint32;
       auto* arr = static_cast<NativeValue*>(native_value.u.ptr);
@@ -193,7 +209,38 @@ std::unique_ptr<SharedNativeString> ScriptValue::ToNativeString(JSContext* ctx)
   return ToString(ctx).ToNativeString(ctx);
 }
 
-NativeValue ScriptValue::ToNative(JSContext* ctx, ExceptionState& exception_state, bool shared_js_value) const {
+static NativeValue ArrayBufferToNative(JSContext* ctx, JSValueConst value, ExceptionState& exception_state) {
+  size_t length;
+  uint8_t* bytes;
+  if (JS_IsArrayBufferView(value)) {
+    size_t byte_offset;
+    size_t byte_length;
+    JSValue array_buffer = JS_GetArrayBufferViewBuffer(ctx, value, &byte_offset, &byte_length);
+    if (JS_IsException(array_buffer)) {
+      exception_state.ThrowException(ctx, array_buffer);
+      return Native_NewNull();
+    }
+    bytes = JS_GetArrayBuffer(ctx, &length, array_buffer);
+    JS_FreeValue(ctx, array_buffer);
+    if (bytes == nullptr) {
+      exception_state.ThrowException(ctx, JS_EXCEPTION);
+      return Native_NewNull();
+    }
+    return Native_NewArrayBufferCopy(bytes + byte_offset, byte_length);
+  }
+
+  bytes = JS_GetArrayBuffer(ctx, &length, value);
+  if (bytes == nullptr) {
+    exception_state.ThrowException(ctx, JS_EXCEPTION);
+    return Native_NewNull();
+  }
+  return Native_NewArrayBufferCopy(bytes, length);
+}
+
+NativeValue ScriptValue::ToNative(JSContext* ctx,
+                                  ExceptionState& exception_state,
+                                  bool shared_js_value,
+                                  bool reject_cycles) const {
   int8_t tag = JS_VALUE_GET_TAG(value_);
 
   switch (tag) {
@@ -220,9 +267,12 @@ NativeValue ScriptValue::ToNative(JSContext* ctx, ExceptionState& exception_stat
         std::vector<ScriptValue> values = Converter<IDLSequence<IDLAny>>::FromValue(ctx, value_, ASSERT_NO_EXCEPTION());
         auto* result = new NativeValue[values.size()];
         for (int i = 0; i < values.size(); i++) {
-          result[i] = values[i].ToNative(ctx, exception_state, shared_js_value);
+          result[i] = values[i].ToNative(ctx, exception_state, shared_js_value, reject_cycles);
         }
         return Native_NewList(values.size(), result);
+      } else if (JS_IsArrayBuffer(value_) || JS_IsArrayBufferView(value_)) {
+        // Binary data goes to dart as raw bytes instead of JSON.
+        return ArrayBufferToNative(ctx, value_, exception_state);
       } else if (JS_IsObject(value_)) {
         if (QJSEventTarget::HasInstance(ExecutingContext::From(ctx), value_)) {
           auto* event_target = toScriptWrappable<EventTarget>(value_);
@@ -233,7 +283,7 @@ NativeValue ScriptValue::ToNative(JSContext* ctx, ExceptionState& exception_stat
           return Native_NewPtr(JSPointerType::Others, JS_VALUE_GET_PTR(value_));
         }
 
-        return NativeValueConverter<NativeTypeJSON>::ToNativeValue(ctx, *this, exception_state);
+        return NativeValueConverter<NativeTypeStructured>::ToNativeValue(ctx, *this, exception_state, reject_cycles);
       }
     }
     default:
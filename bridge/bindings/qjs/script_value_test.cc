@@ -78,3 +78,52 @@ TEST(ScriptValue, MoveAssignment) {
     EXPECT_STREQ(other.ToJSONStringify(ctx, nullptr).ToString(ctx).ToStdString(ctx).c_str(), "{\"name\":1}");
   });
 }
+
+TEST(ScriptValue, ArrayBufferToNative) {
+  TestScriptValue([](JSContext* ctx) {
+    uint8_t bytes[] = {1, 2, 3, 4};
+    JSValue array_buffer = JS_NewArrayBufferCopy(ctx, bytes, sizeof(bytes));
+    ScriptValue value = ScriptValue(ctx, array_buffer);
+    ExceptionState exception_state;
+    NativeValue native_value = value.ToNative(ctx, exception_state);
+    EXPECT_EQ(native_value.tag, NativeTag::TAG_ARRAY_BUFFER);
+    auto* buffer = static_cast<NativeByteBuffer*>(native_value.u.ptr);
+    EXPECT_EQ(buffer->length, 4);
+    EXPECT_EQ(memcmp(buffer->data + buffer->offset, bytes, sizeof(bytes)), 0);
+    FreeNativeByteBuffer(buffer);
+
+    // The copy mode keeps the ArrayBuffer alive.
+    size_t length;
+    JS_GetArrayBuffer(ctx, &length, array_buffer);
+    EXPECT_EQ(length, 4);
+    JS_FreeValue(ctx, array_buffer);
+  });
+}
+
+TEST(ScriptValue, DataViewToNative) {
+  TestScriptValue([](JSContext* ctx) {
+    std::string code = "new DataView(new Uint8Array([1, 2, 3, 4]).buffer, 1, 2)";
+    JSValue view = JS_Eval(ctx, code.c_str(), code.size(), "", JS_EVAL_TYPE_GLOBAL);
+    ScriptValue value = ScriptValue(ctx, view);
+    ExceptionState exception_state;
+    NativeValue native_value = value.ToNative(ctx, exception_state);
+    EXPECT_EQ(exception_state.HasException(), false);
+    EXPECT_EQ(native_value.tag, NativeTag::TAG_ARRAY_BUFFER);
+    auto* buffer = static_cast<NativeByteBuffer*>(native_value.u.ptr);
+    EXPECT_EQ(buffer->length, 2);
+    EXPECT_EQ(buffer->data[buffer->offset], 2);
+
+    // Wrap back without copying.
+    uint8_t* data = buffer->data + buffer->offset;
+    JSValue array_buffer = JS_NewArrayBuffer(
+        ctx, data, buffer->length,
+        [](JSRuntime* rt, void* opaque, void* ptr) { FreeNativeByteBuffer(static_cast<NativeByteBuffer*>(opaque)); },
+        buffer, 0);
+    size_t byte_length;
+    EXPECT_EQ(JS_GetArrayBuffer(ctx, &byte_length, array_buffer), data);
+    EXPECT_EQ(byte_length, 2);
+
+    JS_FreeValue(ctx, array_buffer);
+    JS_FreeValue(ctx, view);
+  });
+}
@@ -18,6 +18,12 @@ ScriptWrappable::ScriptWrappable(JSContext* ctx)
       context_(ExecutingContext::From(ctx)),
       context_id_(context_->contextId()) {}
 
+ScriptWrappable::~ScriptWrappable() {
+  if (allocation_size_ > 0 && isContextValid(context_id_)) {
+    context_->pageMemory()->Freed(PageMemory::kDOMWrappers, allocation_size_);
+  }
+}
+
 JSValue ScriptWrappable::ToQuickJS() const {
   return JS_DupValue(ctx_, jsObject_);
 }
@@ -271,6 +277,9 @@ void ScriptWrappable::InitializeQuickJSObject() {
       // Support iterate script wrappable defined properties.
       exotic_methods->get_own_property_names = HandleJSGetOwnPropertyNames;
       exotic_methods->get_own_property = HandleJSGetOwnProperty;
+      // Lets the inline caches keep the accessors of the prototypes, such as `el.style` or `node.parentNode`.
+      exotic_methods->own_properties_from_prototype =
+          exotic_methods->get_property == nullptr && exotic_methods->set_property == nullptr;
     }
 
     if (UNLIKELY(wrapper_type_info->property_delete_handler_ != nullptr)) {
@@ -293,6 +302,8 @@ void ScriptWrappable::InitializeQuickJSObject() {
   // Let our instance into inherit prototype methods.
   JSValue prototype = GetExecutingContext()->contextData()->prototypeForType(wrapper_type_info);
   JS_SetPrototype(ctx_, jsObject_, prototype);
+
+  context_->pageMemory()->Allocated(PageMemory::kDOMWrappers, allocation_size_);
 }
 
 void ScriptWrappable::KeepAlive() {
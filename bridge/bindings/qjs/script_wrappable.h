@@ -41,7 +41,7 @@ class ScriptWrappable : public GarbageCollected<ScriptWrappable> {
   ScriptWrappable() = delete;
 
   explicit ScriptWrappable(JSContext* ctx);
-  virtual ~ScriptWrappable() = default;
+  virtual ~ScriptWrappable();
 
   // Returns the WrapperTypeInfo of the instance.
   virtual const WrapperTypeInfo* GetWrapperTypeInfo() const = 0;
@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "shared_bytecode.h"
+#include <unordered_map>
+
+namespace webf {
+
+namespace {
+
+struct Template {
+  size_t length;
+  // JS_UNDEFINED when the bytecode can't be shared across realms.
+  JSValue function;
+};
+
+// The templates are read in a context without any script, to not keep the realm of a page alive.
+thread_local JSContext* template_context{nullptr};
+thread_local std::unordered_map<const uint8_t*, Template> templates;
+
+}  // namespace
+
+JSValue SharedByteCode::Instantiate(JSContext* ctx, const uint8_t* bytes, size_t length) {
+  auto it = templates.find(bytes);
+  if (it == templates.end() || it->second.length != length) {
+    if (template_context == nullptr) {
+      template_context = JS_NewContextRaw(JS_GetRuntime(ctx));
+    }
+
+    JSValue function = JS_ReadObject(template_context, bytes, length, JS_READ_OBJ_BYTECODE);
+    if (JS_IsException(function)) {
+      // Read it again to report the error in |ctx|.
+      JS_FreeValue(template_context, JS_GetException(template_context));
+      return JS_ReadObject(ctx, bytes, length, JS_READ_OBJ_BYTECODE);
+    }
+
+    if (it != templates.end()) {
+      JS_FreeValue(template_context, it->second.function);
+    }
+    it = templates.insert_or_assign(bytes, Template{length, function}).first;
+  }
+
+  JSValue function = JS_CloneFunctionBytecode(ctx, it->second.function);
+  if (JS_IsUndefined(function)) {
+    // Objects in the constant pool, e.g. tagged template strings, belong to a realm.
+    JS_FreeValue(template_context, it->second.function);
+    it->second.function = JS_UNDEFINED;
+    return JS_ReadObject(ctx, bytes, length, JS_READ_OBJ_BYTECODE);
+  }
+  return function;
+}
+
+void SharedByteCode::Dispose() {
+  for (auto& entry : templates) {
+    JS_FreeValue(template_context, entry.second.function);
+  }
+  templates.clear();
+  if (template_context != nullptr) {
+    JS_FreeContext(template_context);
+    template_context = nullptr;
+  }
+}
+
+}  // namespace webf
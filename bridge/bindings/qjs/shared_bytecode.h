@@ -0,0 +1,27 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef BRIDGE_BINDINGS_QJS_SHARED_BYTECODE_H_
+#define BRIDGE_BINDINGS_QJS_SHARED_BYTECODE_H_
+
+#include <quickjs/quickjs.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace webf {
+
+// Bytecode which stays alive as long as the process, the polyfill and the plugins, is deserialized once per JSRuntime.
+// Each context evaluates a copy of the deserialized functions bound to its own realm.
+class SharedByteCode {
+ public:
+  // Returns a function bytecode object in the realm of |ctx|, to be evaluated by JS_EvalFunction().
+  // |bytes| is used as the key, it must not be modified or released while the runtime is alive.
+  static JSValue Instantiate(JSContext* ctx, const uint8_t* bytes, size_t length);
+  // Releases the deserialized functions, must be called before the runtime is freed.
+  static void Dispose();
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_BINDINGS_QJS_SHARED_BYTECODE_H_
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "shared_bytecode.h"
+#include <string>
+#include "gtest/gtest.h"
+
+using namespace webf;
+
+namespace {
+
+std::string Compile(JSContext* ctx, const std::string& code) {
+  JSValue function = JS_Eval(ctx, code.c_str(), code.size(), "vm://shared.js", JS_EVAL_FLAG_COMPILE_ONLY);
+  size_t length;
+  uint8_t* bytes = JS_WriteObject(ctx, &length, function, JS_WRITE_OBJ_BYTECODE);
+  std::string result(reinterpret_cast<char*>(bytes), length);
+  js_free(ctx, bytes);
+  JS_FreeValue(ctx, function);
+  return result;
+}
+
+std::string EvalToString(JSContext* ctx, const char* code) {
+  JSValue value = JS_Eval(ctx, code, strlen(code), "vm://test.js", JS_EVAL_TYPE_GLOBAL);
+  const char* string = JS_ToCString(ctx, value);
+  std::string result = string;
+  JS_FreeCString(ctx, string);
+  JS_FreeValue(ctx, value);
+  return result;
+}
+
+}  // namespace
+
+TEST(SharedByteCode, realmsAreSeparated) {
+  JSRuntime* runtime = JS_NewRuntime();
+  JSContext* compiler = JS_NewContext(runtime);
+  std::string bytecode = Compile(compiler,
+                                 "var counter = 0;"
+                                 "class Counter { add(o) { counter += o.step; return this; } get value() { return counter; } }"
+                                 "globalThis.count = function(n) { let c = new Counter(); for (let i = 0; i < n; i++) "
+                                 "c.add({step: 1}); return `${c.value}:${globalThis.name}`; };");
+  auto* bytes = reinterpret_cast<const uint8_t*>(bytecode.data());
+
+  JSContext* contexts[2];
+  for (int i = 0; i < 2; i++) {
+    contexts[i] = JS_NewContext(runtime);
+    JSValue global = JS_GetGlobalObject(contexts[i]);
+    JS_SetPropertyStr(contexts[i], global, "name", JS_NewString(contexts[i], i == 0 ? "first" : "second"));
+    JS_FreeValue(contexts[i], global);
+
+    JSValue function = SharedByteCode::Instantiate(contexts[i], bytes, bytecode.size());
+    ASSERT_FALSE(JS_IsException(function));
+    JSValue result = JS_EvalFunction(contexts[i], function);
+    EXPECT_FALSE(JS_IsException(result));
+    JS_FreeValue(contexts[i], result);
+  }
+
+  EXPECT_EQ(EvalToString(contexts[0], "count(10)"), "10:first");
+  EXPECT_EQ(EvalToString(contexts[0], "count(10)"), "20:first");
+  EXPECT_EQ(EvalToString(contexts[1], "count(5)"), "5:second");
+
+  // The copies outlive each other.
+  JS_FreeContext(contexts[0]);
+  EXPECT_EQ(EvalToString(contexts[1], "count(5)"), "10:second");
+  JS_FreeContext(contexts[1]);
+
+  SharedByteCode::Dispose();
+  JS_FreeContext(compiler);
+  JS_FreeRuntime(runtime);
+}
+
+TEST(SharedByteCode, fallbackForRealmObjects) {
+  JSRuntime* runtime = JS_NewRuntime();
+  JSContext* ctx = JS_NewContext(runtime);
+  // The strings array of a tagged template is created when the bytecode is read.
+  std::string bytecode = Compile(ctx, "var raw = (strings => strings.raw[0])`a\\\\nb`; raw instanceof Object;");
+  auto* bytes = reinterpret_cast<const uint8_t*>(bytecode.data());
+
+  for (int i = 0; i < 2; i++) {
+    JSValue function = SharedByteCode::Instantiate(ctx, bytes, bytecode.size());
+    ASSERT_FALSE(JS_IsException(function));
+    JSValue result = JS_EvalFunction(ctx, function);
+    EXPECT_FALSE(JS_IsException(result));
+    JS_FreeValue(ctx, result);
+    EXPECT_EQ(EvalToString(ctx, "raw"), "a\\\\nb");
+  }
+
+  SharedByteCode::Dispose();
+  JS_FreeContext(ctx);
+  JS_FreeRuntime(runtime);
+}
@@ -0,0 +1,708 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "structured_serializer.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include "core/binding_object.h"
+#include "core/executing_context.h"
+#include "foundation/dart_readable.h"
+#include "qjs_engine_patch.h"
+#include "qjs_event_target.h"
+
+namespace webf {
+
+// Deeper values are rejected to keep the recursive encoder and decoder away from the native stack limit.
+constexpr int kMaxStructuredDepth = 1000;
+// Integral doubles in this range are sent as kInt, which matches how dart decoded the numbers from JSON.
+constexpr double kMaxSafeInteger = 9007199254740991.0;
+
+static const char* kTypedArrayConstructorNames[] = {
+    "Int8Array",  "Uint8Array",  "Uint8ClampedArray", "Int16Array",   "Uint16Array",
+    "Int32Array", "Uint32Array", "Float32Array",      "Float64Array", "DataView",
+};
+
+static bool GetTypedArrayKind(JSValueConst value, StructuredTypedArrayKind* kind) {
+  switch (JSValueGetClassId(value)) {
+    case JS_CLASS_INT8_ARRAY:
+      *kind = StructuredTypedArrayKind::kInt8;
+      return true;
+    case JS_CLASS_UINT8_ARRAY:
+      *kind = StructuredTypedArrayKind::kUint8;
+      return true;
+    case JS_CLASS_UINT8C_ARRAY:
+      *kind = StructuredTypedArrayKind::kUint8Clamped;
+      return true;
+    case JS_CLASS_INT16_ARRAY:
+      *kind = StructuredTypedArrayKind::kInt16;
+      return true;
+    case JS_CLASS_UINT16_ARRAY:
+      *kind = StructuredTypedArrayKind::kUint16;
+      return true;
+    case JS_CLASS_INT32_ARRAY:
+      *kind = StructuredTypedArrayKind::kInt32;
+      return true;
+    case JS_CLASS_UINT32_ARRAY:
+      *kind = StructuredTypedArrayKind::kUint32;
+      return true;
+    case JS_CLASS_FLOAT32_ARRAY:
+      *kind = StructuredTypedArrayKind::kFloat32;
+      return true;
+    case JS_CLASS_FLOAT64_ARRAY:
+      *kind = StructuredTypedArrayKind::kFloat64;
+      return true;
+    case JS_CLASS_DATAVIEW:
+      *kind = StructuredTypedArrayKind::kDataView;
+      return true;
+    default:
+      return false;
+  }
+}
+
+StructuredSerializer::StructuredSerializer(JSContext* ctx, bool reject_cycles)
+    : ctx_(ctx), reject_cycles_(reject_cycles) {}
+
+StructuredSerializer::~StructuredSerializer() {
+  for (JSValue value : registered_) {
+    JS_FreeValue(ctx_, value);
+  }
+  if (buffer_ != nullptr) {
+    dart_free(buffer_);
+  }
+}
+
+bool StructuredSerializer::Serialize(JSValueConst value, ExceptionState& exception_state) {
+  WriteTag(StructuredTag::kVersionTag);
+  WriteByte(kStructuredFormatVersion);
+  JSValue json = ApplyToJSON(JS_DupValue(ctx_, value), JS_ATOM_empty_string);
+  if (JS_IsException(json)) {
+    exception_state.ThrowException(ctx_, JS_EXCEPTION);
+    return false;
+  }
+  bool success = WriteValue(json, 0, exception_state);
+  JS_FreeValue(ctx_, json);
+  return success;
+}
+
+uint8_t* StructuredSerializer::Release(uint32_t* length) {
+  uint8_t* buffer = buffer_;
+  *length = static_cast<uint32_t>(size_);
+  buffer_ = nullptr;
+  size_ = capacity_ = 0;
+  return buffer;
+}
+
+bool StructuredSerializer::WriteValue(JSValueConst value, int depth, ExceptionState& exception_state) {
+  switch (JS_VALUE_GET_TAG(value)) {
+    case JS_TAG_NULL:
+      WriteTag(StructuredTag::kNull);
+      return true;
+    case JS_TAG_BOOL:
+      WriteTag(JS_VALUE_GET_BOOL(value) ? StructuredTag::kTrue : StructuredTag::kFalse);
+      return true;
+    case JS_TAG_INT: {
+      int64_t v = JS_VALUE_GET_INT(value);
+      WriteTag(StructuredTag::kInt);
+      WriteVarint((static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63));
+      return true;
+    }
+    case JS_TAG_FLOAT64:
+      WriteNumber(JS_VALUE_GET_FLOAT64(value));
+      return true;
+    case JS_TAG_STRING:
+      WriteString(value);
+      return true;
+    case JS_TAG_OBJECT: {
+      if (depth >= kMaxStructuredDepth) {
+        exception_state.ThrowException(ctx_, ErrorType::RangeError, "Failed to serialize value: nesting is too deep.");
+        return false;
+      }
+      if (JS_IsFunction(ctx_, value)) {
+        WriteTag(StructuredTag::kUndefined);
+        return true;
+      }
+      if (QJSEventTarget::HasInstance(ExecutingContext::From(ctx_), value)) {
+        auto* event_target = toScriptWrappable<EventTarget>(value);
+        auto address = reinterpret_cast<uint64_t>(event_target->bindingObject());
+        WriteTag(StructuredTag::kBindingObject);
+        WriteRaw(&address, sizeof(uint64_t));
+        return true;
+      }
+      if (JS_IsArrayBuffer(value) || JS_IsArrayBufferView(value)) {
+        return WriteBinary(value, exception_state);
+      }
+
+      void* ptr = JS_VALUE_GET_PTR(value);
+      if (reject_cycles_ && !ancestors_.insert(ptr).second) {
+        exception_state.ThrowException(ctx_, ErrorType::TypeError, "circular reference");
+        return false;
+      }
+      bool success;
+      if (JS_IsArray(ctx_, value)) {
+        success = WriteArray(value, depth, exception_state);
+      } else if (JSValueGetClassId(value) == JS_CLASS_MAP) {
+        success = WriteMap(value, depth, exception_state);
+      } else {
+        success = WriteObject(value, depth, exception_state);
+      }
+      if (reject_cycles_)
+        ancestors_.erase(ptr);
+      return success;
+    }
+    case JS_TAG_BIG_INT:
+      exception_state.ThrowException(ctx_, ErrorType::TypeError, "Failed to serialize value: BigInt is not supported.");
+      return false;
+    default:
+      WriteTag(StructuredTag::kUndefined);
+      return true;
+  }
+}
+
+JSValue StructuredSerializer::ApplyToJSON(JSValue value, JSAtom key) {
+  if (!JS_IsObject(value))
+    return value;
+  JSValue to_json = JS_GetProperty(ctx_, value, JS_ATOM_toJSON);
+  if (JS_IsException(to_json)) {
+    JS_FreeValue(ctx_, value);
+    return JS_EXCEPTION;
+  }
+  if (!JS_IsFunction(ctx_, to_json)) {
+    JS_FreeValue(ctx_, to_json);
+    return value;
+  }
+  JSValue key_string = JS_AtomToString(ctx_, key);
+  JSValue result = JS_Call(ctx_, to_json, value, 1, &key_string);
+  JS_FreeValue(ctx_, key_string);
+  JS_FreeValue(ctx_, to_json);
+  JS_FreeValue(ctx_, value);
+  return result;
+}
+
+bool StructuredSerializer::WriteObject(JSValueConst value, int depth, ExceptionState& exception_state) {
+  if (WriteReferenceOrRegister(value))
+    return true;
+
+  JSPropertyEnum* tab;
+  uint32_t length;
+  if (JS_GetOwnPropertyNames(ctx_, &tab, &length, value, JS_GPN_STRING_MASK | JS_GPN_ENUM_ONLY) < 0) {
+    exception_state.ThrowException(ctx_, JS_EXCEPTION);
+    return false;
+  }
+
+  WriteTag(StructuredTag::kObject);
+  bool success = true;
+  uint32_t i = 0;
+  for (; i < length; i++) {
+    JSValue property = ApplyToJSON(JS_GetProperty(ctx_, value, tab[i].atom), tab[i].atom);
+    if (JS_IsException(property)) {
+      exception_state.ThrowException(ctx_, JS_EXCEPTION);
+      success = false;
+      break;
+    }
+    // Same as JSON, properties which have no JSON representation are skipped.
+    if (JS_IsUndefined(property) || JS_IsFunction(ctx_, property) || JS_VALUE_GET_TAG(property) == JS_TAG_SYMBOL) {
+      JS_FreeValue(ctx_, property);
+      continue;
+    }
+    WriteAtom(tab[i].atom);
+    success = WriteValue(property, depth + 1, exception_state);
+    JS_FreeValue(ctx_, property);
+    if (!success)
+      break;
+  }
+  WriteTag(StructuredTag::kEnd);
+
+  for (i = 0; i < length; i++) {
+    JS_FreeAtom(ctx_, tab[i].atom);
+  }
+  js_free(ctx_, tab);
+  return success;
+}
+
+bool StructuredSerializer::WriteArray(JSValueConst value, int depth, ExceptionState& exception_state) {
+  if (WriteReferenceOrRegister(value))
+    return true;
+
+  int64_t length;
+  JSValue length_value = JS_GetProperty(ctx_, value, JS_ATOM_length);
+  if (JS_IsException(length_value) || JS_ToInt64(ctx_, &length, length_value) < 0) {
+    JS_FreeValue(ctx_, length_value);
+    exception_state.ThrowException(ctx_, JS_EXCEPTION);
+    return false;
+  }
+  JS_FreeValue(ctx_, length_value);
+
+  WriteTag(StructuredTag::kArray);
+  WriteVarint(static_cast<uint64_t>(length));
+  for (uint32_t i = 0; i < length; i++) {
+    JSAtom index = JS_NewAtomUInt32(ctx_, i);
+    JSValue element = ApplyToJSON(JS_GetPropertyUint32(ctx_, value, i), index);
+    JS_FreeAtom(ctx_, index);
+    if (JS_IsException(element)) {
+      exception_state.ThrowException(ctx_, JS_EXCEPTION);
+      return false;
+    }
+    bool success;
+    // Same as JSON, elements which have no JSON representation become null.
+    if (JS_IsUndefined(element) || JS_IsFunction(ctx_, element) || JS_VALUE_GET_TAG(element) == JS_TAG_SYMBOL) {
+      WriteTag(StructuredTag::kNull);
+      success = true;
+    } else {
+      success = WriteValue(element, depth + 1, exception_state);
+    }
+    JS_FreeValue(ctx_, element);
+    if (!success)
+      return false;
+  }
+  return true;
+}
+
+bool StructuredSerializer::WriteMap(JSValueConst value, int depth, ExceptionState& exception_state) {
+  if (WriteReferenceOrRegister(value))
+    return true;
+
+  JSValue entries = JS_GetPropertyStr(ctx_, value, "entries");
+  JSValue iterator = JS_IsException(entries) ? JS_EXCEPTION : JS_Call(ctx_, entries, value, 0, nullptr);
+  JS_FreeValue(ctx_, entries);
+  if (JS_IsException(iterator)) {
+    exception_state.ThrowException(ctx_, JS_EXCEPTION);
+    return false;
+  }
+
+  WriteTag(StructuredTag::kMap);
+  bool success = true;
+  while (success) {
+    JSValue result = JS_Invoke(ctx_, iterator, JS_ATOM_next, 0, nullptr);
+    if (JS_IsException(result)) {
+      exception_state.ThrowException(ctx_, JS_EXCEPTION);
+      success = false;
+      break;
+    }
+    JSValue done = JS_GetProperty(ctx_, result, JS_ATOM_done);
+    bool finished = JS_ToBool(ctx_, done);
+    JS_FreeValue(ctx_, done);
+    if (finished) {
+      JS_FreeValue(ctx_, result);
+      break;
+    }
+
+    JSValue entry = JS_GetProperty(ctx_, result, JS_ATOM_value);
+    JSValue entry_key = JS_GetPropertyUint32(ctx_, entry, 0);
+    JSValue entry_value = JS_GetPropertyUint32(ctx_, entry, 1);
+    success = WriteValue(entry_key, depth + 1, exception_state) && WriteValue(entry_value, depth + 1, exception_state);
+    JS_FreeValue(ctx_, entry_value);
+    JS_FreeValue(ctx_, entry_key);
+    JS_FreeValue(ctx_, entry);
+    JS_FreeValue(ctx_, result);
+  }
+  WriteTag(StructuredTag::kEnd);
+  JS_FreeValue(ctx_, iterator);
+  return success;
+}
+
+bool StructuredSerializer::WriteBinary(JSValueConst value, ExceptionState& exception_state) {
+  if (WriteReferenceOrRegister(value))
+    return true;
+
+  size_t byte_offset = 0;
+  size_t byte_length = 0;
+  StructuredTypedArrayKind kind;
+  bool is_view = JS_IsArrayBufferView(value);
+  JSValue array_buffer;
+  if (is_view) {
+    array_buffer = JS_GetArrayBufferViewBuffer(ctx_, value, &byte_offset, &byte_length);
+    if (JS_IsException(array_buffer)) {
+      exception_state.ThrowException(ctx_, JS_EXCEPTION);
+      return false;
+    }
+  } else {
+    array_buffer = JS_DupValue(ctx_, value);
+  }
+
+  size_t length;
+  uint8_t* bytes = JS_GetArrayBuffer(ctx_, &length, array_buffer);
+  JS_FreeValue(ctx_, array_buffer);
+  if (bytes == nullptr) {
+    exception_state.ThrowException(ctx_, JS_EXCEPTION);
+    return false;
+  }
+
+  if (!is_view) {
+    WriteTag(StructuredTag::kArrayBuffer);
+    WriteVarint(length);
+    WriteRaw(bytes, length);
+    return true;
+  }
+
+  // Views which dart has no counterpart for (BigInt arrays) are sent as a plain ArrayBuffer of the viewed bytes.
+  if (GetTypedArrayKind(value, &kind)) {
+    WriteTag(StructuredTag::kTypedArray);
+    WriteByte(static_cast<uint8_t>(kind));
+  } else {
+    WriteTag(StructuredTag::kArrayBuffer);
+  }
+  WriteVarint(byte_length);
+  WriteRaw(bytes + byte_offset, byte_length);
+  return true;
+}
+
+void StructuredSerializer::WriteNumber(double value) {
+  if (std::fabs(value) <= kMaxSafeInteger && value == std::trunc(value) && !(value == 0 && std::signbit(value))) {
+    auto v = static_cast<int64_t>(value);
+    WriteTag(StructuredTag::kInt);
+    WriteVarint((static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63));
+    return;
+  }
+  WriteTag(StructuredTag::kDouble);
+  WriteRaw(&value, sizeof(double));
+}
+
+void StructuredSerializer::WriteString(JSValueConst value) {
+  auto* string = static_cast<JSString*>(JS_VALUE_GET_PTR(value));
+  if (string->is_wide_char) {
+    WriteTag(StructuredTag::kTwoByteString);
+    WriteVarint(string->len);
+    WriteRaw(string->u.str16, string->len * sizeof(uint16_t));
+  } else {
+    WriteTag(StructuredTag::kOneByteString);
+    WriteVarint(string->len);
+    WriteRaw(string->u.str8, string->len);
+  }
+}
+
+void StructuredSerializer::WriteAtom(JSAtom atom) {
+  if (JS_AtomIsTaggedInt(atom)) {
+    char index[16];
+    int length = snprintf(index, sizeof(index), "%u", JS_AtomToUInt32(atom));
+    WriteTag(StructuredTag::kOneByteString);
+    WriteVarint(length);
+    WriteRaw(index, length);
+    return;
+  }
+
+  StringView view = JSAtomToStringView(JS_GetRuntime(ctx_), atom);
+  if (view.Is8Bit()) {
+    WriteTag(StructuredTag::kOneByteString);
+    WriteVarint(view.length());
+    WriteRaw(view.Characters8(), view.length());
+  } else {
+    WriteTag(StructuredTag::kTwoByteString);
+    WriteVarint(view.length());
+    WriteRaw(view.Characters16(), view.length() * sizeof(uint16_t));
+  }
+}
+
+bool StructuredSerializer::WriteReferenceOrRegister(JSValueConst value) {
+  void* ptr = JS_VALUE_GET_PTR(value);
+  auto it = references_.find(ptr);
+  if (it != references_.end()) {
+    WriteTag(StructuredTag::kReference);
+    WriteVarint(it->second);
+    return true;
+  }
+  references_.emplace(ptr, static_cast<uint32_t>(references_.size()));
+  registered_.push_back(JS_DupValue(ctx_, value));
+  return false;
+}
+
+void StructuredSerializer::WriteByte(uint8_t byte) {
+  Reserve(1);
+  buffer_[size_++] = byte;
+}
+
+void StructuredSerializer::WriteVarint(uint64_t value) {
+  Reserve(10);
+  do {
+    uint8_t byte = value & 0x7F;
+    value >>= 7;
+    buffer_[size_++] = value != 0 ? (byte | 0x80) : byte;
+  } while (value != 0);
+}
+
+void StructuredSerializer::WriteRaw(const void* bytes, size_t length) {
+  Reserve(length);
+  memcpy(buffer_ + size_, bytes, length);
+  size_ += length;
+}
+
+void StructuredSerializer::Reserve(size_t length) {
+  if (size_ + length <= capacity_)
+    return;
+  size_t capacity = capacity_ > 0 ? capacity_ : 64;
+  while (capacity < size_ + length) {
+    capacity *= 2;
+  }
+  auto* buffer = static_cast<uint8_t*>(dart_malloc(capacity));
+  if (buffer_ != nullptr) {
+    memcpy(buffer, buffer_, size_);
+    dart_free(buffer_);
+  }
+  buffer_ = buffer;
+  capacity_ = capacity;
+}
+
+StructuredDeserializer::StructuredDeserializer(JSContext* ctx, const uint8_t* bytes, size_t length)
+    : ctx_(ctx), position_(bytes), end_(bytes + length) {}
+
+StructuredDeserializer::~StructuredDeserializer() = default;
+
+JSValue StructuredDeserializer::Deserialize() {
+  uint8_t tag;
+  uint8_t version;
+  if (!ReadByte(&tag) || tag != static_cast<uint8_t>(StructuredTag::kVersionTag) || !ReadByte(&version) ||
+      version > kStructuredFormatVersion) {
+    return ThrowDataError();
+  }
+
+  JSValue result = ReadValue(0);
+  if (JS_IsException(result))
+    return result;
+  if (position_ != end_) {
+    JS_FreeValue(ctx_, result);
+    return ThrowDataError();
+  }
+  return result;
+}
+
+JSValue StructuredDeserializer::ReadValue(int depth) {
+  uint8_t tag;
+  if (depth >= kMaxStructuredDepth || !ReadByte(&tag))
+    return ThrowDataError();
+
+  switch (static_cast<StructuredTag>(tag)) {
+    case StructuredTag::kUndefined:
+      return JS_UNDEFINED;
+    case StructuredTag::kNull:
+      return JS_NULL;
+    case StructuredTag::kFalse:
+      return JS_FALSE;
+    case StructuredTag::kTrue:
+      return JS_TRUE;
+    case StructuredTag::kInt: {
+      uint64_t zigzag;
+      if (!ReadVarint(&zigzag))
+        return ThrowDataError();
+      return JS_NewInt64(ctx_, static_cast<int64_t>((zigzag >> 1) ^ -(zigzag & 1)));
+    }
+    case StructuredTag::kDouble: {
+      const uint8_t* bytes;
+      double value;
+      if (!ReadRaw(sizeof(double), &bytes))
+        return ThrowDataError();
+      memcpy(&value, bytes, sizeof(double));
+      return JS_NewFloat64(ctx_, value);
+    }
+    case StructuredTag::kOneByteString:
+      return ReadString(false);
+    case StructuredTag::kTwoByteString:
+      return ReadString(true);
+    case StructuredTag::kArray:
+      return ReadArray(depth);
+    case StructuredTag::kObject:
+      return ReadObject(depth);
+    case StructuredTag::kMap:
+      return ReadMap(depth);
+    case StructuredTag::kArrayBuffer:
+      return ReadArrayBuffer();
+    case StructuredTag::kTypedArray:
+      return ReadTypedArray();
+    case StructuredTag::kReference: {
+      uint64_t index;
+      if (!ReadVarint(&index) || index >= references_.size())
+        return ThrowDataError();
+      return JS_DupValue(ctx_, references_[index]);
+    }
+    case StructuredTag::kBindingObject:
+      return ReadBindingObject();
+    default:
+      return ThrowDataError();
+  }
+}
+
+JSValue StructuredDeserializer::ReadString(bool is_wide_char) {
+  uint64_t length;
+  const uint8_t* bytes;
+  if (!ReadVarint(&length) || !ReadRaw(is_wide_char ? length * sizeof(uint16_t) : length, &bytes))
+    return ThrowDataError();
+  if (is_wide_char) {
+    return JS_NewUnicodeString(ctx_, reinterpret_cast<const uint16_t*>(bytes), length);
+  }
+  return JS_NewRawUTF8String(ctx_, bytes, length);
+}
+
+JSValue StructuredDeserializer::ReadObject(int depth) {
+  JSValue object = JS_NewObject(ctx_);
+  references_.emplace_back(object);
+
+  while (true) {
+    if (position_ < end_ && *position_ == static_cast<uint8_t>(StructuredTag::kEnd)) {
+      position_++;
+      return object;
+    }
+
+    JSValue key = ReadValue(depth + 1);
+    if (JS_IsException(key))
+      break;
+    JSAtom atom = JS_ValueToAtom(ctx_, key);
+    JS_FreeValue(ctx_, key);
+    if (atom == JS_ATOM_NULL)
+      break;
+
+    JSValue value = ReadValue(depth + 1);
+    if (JS_IsException(value)) {
+      JS_FreeAtom(ctx_, atom);
+      break;
+    }
+    int result = JS_DefinePropertyValue(ctx_, object, atom, value, JS_PROP_C_W_E);
+    JS_FreeAtom(ctx_, atom);
+    if (result < 0)
+      break;
+  }
+
+  JS_FreeValue(ctx_, object);
+  return JS_EXCEPTION;
+}
+
+JSValue StructuredDeserializer::ReadArray(int depth) {
+  uint64_t length;
+  if (!ReadVarint(&length) || length > static_cast<uint64_t>(end_ - position_))
+    return ThrowDataError();
+
+  JSValue array = JS_NewArray(ctx_);
+  references_.emplace_back(array);
+  for (uint32_t i = 0; i < length; i++) {
+    JSValue value = ReadValue(depth + 1);
+    if (JS_IsException(value) || JS_DefinePropertyValueUint32(ctx_, array, i, value, JS_PROP_C_W_E) < 0) {
+      JS_FreeValue(ctx_, array);
+      return JS_EXCEPTION;
+    }
+  }
+  return array;
+}
+
+JSValue StructuredDeserializer::ReadMap(int depth) {
+  JSValue global = JS_GetGlobalObject(ctx_);
+  JSValue constructor = JS_GetProperty(ctx_, global, JS_ATOM_Map);
+  JSValue map = JS_CallConstructor(ctx_, constructor, 0, nullptr);
+  JS_FreeValue(ctx_, constructor);
+  JS_FreeValue(ctx_, global);
+  if (JS_IsException(map))
+    return map;
+  references_.emplace_back(map);
+
+  while (true) {
+    if (position_ < end_ && *position_ == static_cast<uint8_t>(StructuredTag::kEnd)) {
+      position_++;
+      return map;
+    }
+
+    JSValue arguments[2];
+    arguments[0] = ReadValue(depth + 1);
+    if (JS_IsException(arguments[0]))
+      break;
+    arguments[1] = ReadValue(depth + 1);
+    if (JS_IsException(arguments[1])) {
+      JS_FreeValue(ctx_, arguments[0]);
+      break;
+    }
+    JSValue result = JS_Invoke(ctx_, map, JS_ATOM_set, 2, arguments);
+    JS_FreeValue(ctx_, arguments[0]);
+    JS_FreeValue(ctx_, arguments[1]);
+    if (JS_IsException(result))
+      break;
+    JS_FreeValue(ctx_, result);
+  }
+
+  JS_FreeValue(ctx_, map);
+  return JS_EXCEPTION;
+}
+
+JSValue StructuredDeserializer::ReadArrayBuffer() {
+  uint64_t length;
+  const uint8_t* bytes;
+  if (!ReadVarint(&length) || !ReadRaw(length, &bytes))
+    return ThrowDataError();
+  JSValue array_buffer = JS_NewArrayBufferCopy(ctx_, bytes, length);
+  if (!JS_IsException(array_buffer)) {
+    references_.emplace_back(array_buffer);
+  }
+  return array_buffer;
+}
+
+JSValue StructuredDeserializer::ReadTypedArray() {
+  uint8_t kind;
+  uint64_t length;
+  const uint8_t* bytes;
+  if (!ReadByte(&kind) || kind > static_cast<uint8_t>(StructuredTypedArrayKind::kDataView) || !ReadVarint(&length) ||
+      !ReadRaw(length, &bytes))
+    return ThrowDataError();
+
+  JSValue array_buffer = JS_NewArrayBufferCopy(ctx_, bytes, length);
+  if (JS_IsException(array_buffer))
+    return array_buffer;
+
+  JSValue global = JS_GetGlobalObject(ctx_);
+  JSValue constructor = JS_GetPropertyStr(ctx_, global, kTypedArrayConstructorNames[kind]);
+  JSValue typed_array = JS_CallConstructor(ctx_, constructor, 1, &array_buffer);
+  JS_FreeValue(ctx_, constructor);
+  JS_FreeValue(ctx_, global);
+  JS_FreeValue(ctx_, array_buffer);
+  if (!JS_IsException(typed_array)) {
+    references_.emplace_back(typed_array);
+  }
+  return typed_array;
+}
+
+JSValue StructuredDeserializer::ReadBindingObject() {
+  const uint8_t* bytes;
+  uint64_t address;
+  if (!ReadRaw(sizeof(uint64_t), &bytes))
+    return ThrowDataError();
+  memcpy(&address, bytes, sizeof(uint64_t));
+
+  auto* binding_object = BindingObject::From(reinterpret_cast<NativeBindingObject*>(address));
+  // Only eventTarget can be converted from nativeValue to JSValue.
+  auto* event_target = DynamicTo<EventTarget>(binding_object);
+  if (event_target) {
+    return event_target->ToQuickJS();
+  }
+  return JS_NULL;
+}
+
+JSValue StructuredDeserializer::ThrowDataError() {
+  return JS_ThrowTypeError(ctx_, "Failed to deserialize value: the data is malformed.");
+}
+
+bool StructuredDeserializer::ReadByte(uint8_t* byte) {
+  if (position_ >= end_)
+    return false;
+  *byte = *position_++;
+  return true;
+}
+
+bool StructuredDeserializer::ReadVarint(uint64_t* value) {
+  uint64_t result = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    if (position_ >= end_)
+      return false;
+    uint8_t byte = *position_++;
+    result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if (!(byte & 0x80)) {
+      *value = result;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool StructuredDeserializer::ReadRaw(size_t length, const uint8_t** bytes) {
+  if (length > static_cast<size_t>(end_ - position_))
+    return false;
+  *bytes = position_;
+  position_ += length;
+  return true;
+}
+
+}  // namespace webf
@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef BRIDGE_BINDINGS_QJS_STRUCTURED_SERIALIZER_H_
+#define BRIDGE_BINDINGS_QJS_STRUCTURED_SERIALIZER_H_
+
+#include <quickjs/quickjs.h>
+#include <cinttypes>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "exception_state.h"
+
+namespace webf {
+
+// A compact binary format to pass structured values between C++ and dart, which replaced the JSON string of
+// TAG_JSON. The dart implementation lives in webf/lib/src/bridge/structured_value.dart, both sides should be kept in
+// sync with the conformance corpus in bridge/test/fixtures/structured_value_corpus.json.
+//
+// All multi-byte numbers are little-endian, varint is an unsigned LEB128.
+//
+//   buffer     := kVersionTag version:uint8 value
+//   value      := kUndefined | kNull | kFalse | kTrue
+//               | kInt zigzag:varint
+//               | kDouble float64
+//               | kOneByteString length:varint latin1-chars
+//               | kTwoByteString length:varint utf16-code-units
+//               | kArray length:varint value{length}
+//               | kObject (string value)* kEnd
+//               | kMap (value value)* kEnd
+//               | kArrayBuffer byteLength:varint bytes
+//               | kTypedArray kind:uint8 byteLength:varint bytes
+//               | kReference index:varint
+//               | kBindingObject address:uint64
+//
+// Arrays, objects, maps, array buffers and typed arrays are numbered by the order they first appear in the stream.
+// The number is assigned before the children are written so kReference can point to a shared or cyclic parent.
+//
+// Same as JSON.stringify(), an object with a toJSON() method is written as the value returned by the method. The
+// serializer can reject the cycles like JSON.stringify() too, for the receivers which walk the result recursively.
+enum class StructuredTag : uint8_t {
+  kUndefined = 0x00,
+  kNull = 0x01,
+  kFalse = 0x02,
+  kTrue = 0x03,
+  kInt = 0x04,
+  kDouble = 0x05,
+  kOneByteString = 0x06,
+  kTwoByteString = 0x07,
+  kArray = 0x08,
+  kObject = 0x09,
+  kMap = 0x0A,
+  kArrayBuffer = 0x0B,
+  kTypedArray = 0x0C,
+  kReference = 0x0D,
+  kBindingObject = 0x0E,
+  kEnd = 0x0F,
+  kVersionTag = 0xFF,
+};
+
+enum class StructuredTypedArrayKind : uint8_t {
+  kInt8 = 0,
+  kUint8 = 1,
+  kUint8Clamped = 2,
+  kInt16 = 3,
+  kUint16 = 4,
+  kInt32 = 5,
+  kUint32 = 6,
+  kFloat32 = 7,
+  kFloat64 = 8,
+  kDataView = 9,
+};
+
+constexpr uint8_t kStructuredFormatVersion = 1;
+
+class StructuredSerializer {
+ public:
+  explicit StructuredSerializer(JSContext* ctx, bool reject_cycles = false);
+  ~StructuredSerializer();
+
+  // Serialize value into the buffer, returns false with an exception if the value can not be serialized.
+  bool Serialize(JSValueConst value, ExceptionState& exception_state);
+
+  // Hand the buffer allocated by dart_malloc() to the caller.
+  uint8_t* Release(uint32_t* length);
+
+ private:
+  bool WriteValue(JSValueConst value, int depth, ExceptionState& exception_state);
+  // Takes the ownership of value and returns the result of its toJSON() method, or value if it has none.
+  JSValue ApplyToJSON(JSValue value, JSAtom key);
+  bool WriteObject(JSValueConst value, int depth, ExceptionState& exception_state);
+  bool WriteArray(JSValueConst value, int depth, ExceptionState& exception_state);
+  bool WriteMap(JSValueConst value, int depth, ExceptionState& exception_state);
+  bool WriteBinary(JSValueConst value, ExceptionState& exception_state);
+  void WriteNumber(double value);
+  void WriteString(JSValueConst value);
+  void WriteAtom(JSAtom atom);
+  // Returns true when the object was seen before and a reference has been written.
+  bool WriteReferenceOrRegister(JSValueConst value);
+
+  void WriteTag(StructuredTag tag) { WriteByte(static_cast<uint8_t>(tag)); }
+  void WriteByte(uint8_t byte);
+  void WriteVarint(uint64_t value);
+  void WriteRaw(const void* bytes, size_t length);
+  void Reserve(size_t length);
+
+  JSContext* ctx_;
+  uint8_t* buffer_{nullptr};
+  size_t size_{0};
+  size_t capacity_{0};
+  std::unordered_map<void*, uint32_t> references_;
+  bool reject_cycles_;
+  // The arrays, objects and maps being written, tracked when the cycles are rejected.
+  std::unordered_set<void*> ancestors_;
+  // The registered objects are kept alive until the serializer is destroyed. A value returned by a getter or by
+  // toJSON() is freed once it was written, its address must not be reused by a later object of the stream.
+  std::vector<JSValue> registered_;
+};
+
+class StructuredDeserializer {
+ public:
+  StructuredDeserializer(JSContext* ctx, const uint8_t* bytes, size_t length);
+  ~StructuredDeserializer();
+
+  // Returns JS_EXCEPTION with a pending exception if the bytes are malformed.
+  JSValue Deserialize();
+
+ private:
+  JSValue ReadValue(int depth);
+  JSValue ReadString(bool is_wide_char);
+  JSValue ReadObject(int depth);
+  JSValue ReadArray(int depth);
+  JSValue ReadMap(int depth);
+  JSValue ReadArrayBuffer();
+  JSValue ReadTypedArray();
+  JSValue ReadBindingObject();
+  JSValue ThrowDataError();
+
+  bool ReadByte(uint8_t* byte);
+  bool ReadVarint(uint64_t* value);
+  bool ReadRaw(size_t length, const uint8_t** bytes);
+
+  JSContext* ctx_;
+  const uint8_t* position_;
+  const uint8_t* end_;
+  // Borrowed, the values are owned by their parents in the result tree.
+  std::vector<JSValue> references_;
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_BINDINGS_QJS_STRUCTURED_SERIALIZER_H_
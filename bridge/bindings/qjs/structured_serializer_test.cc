@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "structured_serializer.h"
+#include <fstream>
+#include <sstream>
+#include "foundation/dart_readable.h"
+#include "gtest/gtest.h"
+#include "webf_test_env.h"
+
+using namespace webf;
+
+static std::string ToHex(const uint8_t* bytes, size_t length) {
+  static const char* digits = "0123456789abcdef";
+  std::string hex;
+  for (size_t i = 0; i < length; i++) {
+    hex.push_back(digits[bytes[i] >> 4]);
+    hex.push_back(digits[bytes[i] & 0xF]);
+  }
+  return hex;
+}
+
+static std::vector<uint8_t> FromHex(const std::string& hex) {
+  std::vector<uint8_t> bytes;
+  for (size_t i = 0; i + 1 < hex.size(); i += 2) {
+    bytes.push_back(static_cast<uint8_t>(std::stoi(hex.substr(i, 2), nullptr, 16)));
+  }
+  return bytes;
+}
+
+static std::string SerializeToHex(JSContext* ctx, JSValueConst value) {
+  ExceptionState exception_state;
+  StructuredSerializer serializer(ctx);
+  EXPECT_EQ(serializer.Serialize(value, exception_state), true);
+  uint32_t length;
+  uint8_t* bytes = serializer.Release(&length);
+  std::string hex = ToHex(bytes, length);
+  dart_free(bytes);
+  return hex;
+}
+
+static std::string GetString(JSContext* ctx, JSValueConst object, const char* name) {
+  JSValue value = JS_GetPropertyStr(ctx, object, name);
+  const char* string = JS_ToCString(ctx, value);
+  std::string result = string;
+  JS_FreeCString(ctx, string);
+  JS_FreeValue(ctx, value);
+  return result;
+}
+
+// The corpus is shared with the dart implementation in webf/lib/src/bridge/structured_value.dart.
+TEST(StructuredSerializer, conformanceCorpus) {
+  auto env = TEST_init();
+  JSContext* ctx = env->page()->executingContext()->ctx();
+
+  std::ifstream file(std::string(SPEC_FILE_PATH) + "/test/fixtures/structured_value_corpus.json");
+  ASSERT_EQ(file.is_open(), true);
+  std::stringstream stream;
+  stream << file.rdbuf();
+  std::string source = stream.str();
+
+  JSValue corpus = JS_ParseJSON(ctx, source.c_str(), source.size(), "");
+  ASSERT_EQ(JS_IsArray(ctx, corpus), true);
+  JSValue length_value = JS_GetPropertyStr(ctx, corpus, "length");
+  uint32_t length = JS_VALUE_GET_INT(length_value);
+  EXPECT_GT(length, 0);
+
+  for (uint32_t i = 0; i < length; i++) {
+    JSValue entry = JS_GetPropertyUint32(ctx, corpus, i);
+    std::string name = GetString(ctx, entry, "name");
+    std::string script = "(" + GetString(ctx, entry, "script") + ")";
+    std::string expected = GetString(ctx, entry, "bytes");
+
+    JSValue value = JS_Eval(ctx, script.c_str(), script.size(), "vm://", JS_EVAL_TYPE_GLOBAL);
+    ASSERT_EQ(JS_IsException(value), false) << name;
+    EXPECT_EQ(SerializeToHex(ctx, value), expected) << name;
+
+    // Decoding and encoding again should produce the same bytes.
+    std::vector<uint8_t> bytes = FromHex(expected);
+    StructuredDeserializer deserializer(ctx, bytes.data(), bytes.size());
+    JSValue decoded = deserializer.Deserialize();
+    ASSERT_EQ(JS_IsException(decoded), false) << name;
+    EXPECT_EQ(SerializeToHex(ctx, decoded), expected) << name;
+
+    JS_FreeValue(ctx, decoded);
+    JS_FreeValue(ctx, value);
+    JS_FreeValue(ctx, entry);
+  }
+
+  JS_FreeValue(ctx, corpus);
+}
+
+TEST(StructuredSerializer, nativeValueRoundTrip) {
+  auto env = TEST_init();
+  JSContext* ctx = env->page()->executingContext()->ctx();
+
+  std::string code = "({name: 'webf', list: [1, 2.5, {deep: true}], bytes: new Uint8Array([1, 2])})";
+  JSValue object = JS_Eval(ctx, code.c_str(), code.size(), "vm://", JS_EVAL_TYPE_GLOBAL);
+  ExceptionState exception_state;
+  NativeValue native_value = ScriptValue(ctx, object).ToNative(ctx, exception_state);
+  EXPECT_EQ(exception_state.HasException(), false);
+  EXPECT_EQ(native_value.tag, NativeTag::TAG_STRUCTURED);
+
+  ScriptValue result = ScriptValue(ctx, native_value);
+  EXPECT_STREQ(result.ToJSONStringify(ctx, &exception_state).ToString(ctx).ToStdString(ctx).c_str(),
+               "{\"name\":\"webf\",\"list\":[1,2.5,{\"deep\":true}],\"bytes\":{\"0\":1,\"1\":2}}");
+  JS_FreeValue(ctx, object);
+}
+
+// The getters return a new object each time, which is freed once written. Their addresses must not be taken for
+// references to the objects written before.
+TEST(StructuredSerializer, temporaryObjectsAreNotReferences) {
+  auto env = TEST_init();
+  JSContext* ctx = env->page()->executingContext()->ctx();
+
+  std::string code = R"(
+const o = {};
+for (let i = 0; i < 100; i++) Object.defineProperty(o, 'k' + i, {get() { return {i}; }, enumerable: true});
+o)";
+  JSValue object = JS_Eval(ctx, code.c_str(), code.size(), "vm://", JS_EVAL_TYPE_GLOBAL);
+  ExceptionState exception_state;
+  StructuredSerializer serializer(ctx);
+  EXPECT_EQ(serializer.Serialize(object, exception_state), true);
+  uint32_t length;
+  uint8_t* bytes = serializer.Release(&length);
+  StructuredDeserializer deserializer(ctx, bytes, length);
+  JSValue decoded = deserializer.Deserialize();
+  dart_free(bytes);
+
+  for (int i = 0; i < 100; i++) {
+    JSValue property = JS_GetPropertyStr(ctx, decoded, ("k" + std::to_string(i)).c_str());
+    JSValue index = JS_GetPropertyStr(ctx, property, "i");
+    EXPECT_EQ(JS_VALUE_GET_INT(index), i);
+    JS_FreeValue(ctx, property);
+  }
+  JS_FreeValue(ctx, decoded);
+  JS_FreeValue(ctx, object);
+}
+
+TEST(StructuredSerializer, malformedData) {
+  auto env = TEST_init();
+  JSContext* ctx = env->page()->executingContext()->ctx();
+
+  std::vector<std::string> samples = {"", "ff02", "ff0108", "ff010803", "ff010d00", "ff0109", "ff010101"};
+  for (auto& sample : samples) {
+    std::vector<uint8_t> bytes = FromHex(sample);
+    StructuredDeserializer deserializer(ctx, bytes.data(), bytes.size());
+    JSValue result = deserializer.Deserialize();
+    EXPECT_EQ(JS_IsException(result), true) << sample;
+    JSValue exception = JS_GetException(ctx);
+    JS_FreeValue(ctx, exception);
+  }
+}
+
+TEST(StructuredSerializer, tooDeep) {
+  auto env = TEST_init();
+  JSContext* ctx = env->page()->executingContext()->ctx();
+
+  std::string code = "let a = []; for (let i = 0; i < 2000; i++) a = [a]; a";
+  JSValue value = JS_Eval(ctx, code.c_str(), code.size(), "vm://", JS_EVAL_TYPE_GLOBAL);
+  ExceptionState exception_state;
+  StructuredSerializer serializer(ctx);
+  EXPECT_EQ(serializer.Serialize(value, exception_state), false);
+  EXPECT_EQ(exception_state.HasException(), true);
+  JSValue exception = JS_GetException(ctx);
+  JS_FreeValue(ctx, exception);
+  JS_FreeValue(ctx, value);
+}
+
+TEST(StructuredSerializer, rejectCycles) {
+  auto env = TEST_init();
+  JSContext* ctx = env->page()->executingContext()->ctx();
+
+  std::string code = "const shared = {}; [{a: shared, b: [shared]}, new Map([[1, shared]])]";
+  JSValue shared = JS_Eval(ctx, code.c_str(), code.size(), "vm://", JS_EVAL_TYPE_GLOBAL);
+  ExceptionState exception_state;
+  StructuredSerializer shared_serializer(ctx, true);
+  EXPECT_EQ(shared_serializer.Serialize(shared, exception_state), true);
+  JS_FreeValue(ctx, shared);
+
+  code = "const o = {m: new Map()}; o.m.set(1, [o]); o";
+  JSValue cyclic = JS_Eval(ctx, code.c_str(), code.size(), "vm://", JS_EVAL_TYPE_GLOBAL);
+  StructuredSerializer cyclic_serializer(ctx, true);
+  EXPECT_EQ(cyclic_serializer.Serialize(cyclic, exception_state), false);
+  EXPECT_EQ(exception_state.HasException(), true);
+  JSValue exception = JS_GetException(ctx);
+  JS_FreeValue(ctx, exception);
+  JS_FreeValue(ctx, cyclic);
+}
@@ -13,6 +13,7 @@ namespace webf {
 
 class EventTarget;
 class TouchList;
+class ExecutingContext;
 
 // Define all built-in wrapper class id.
 enum {
@@ -94,6 +95,7 @@ enum {
 
   JS_CLASS_DOM_TOKEN_LIST,
   JS_CLASS_DOM_STRING_MAP,
+  JS_CLASS_STORAGE,
 
   // SVG
   JS_CLASS_SVG_ELEMENT,
@@ -152,6 +154,9 @@ using PropertyCheckerHandler = bool (*)(JSContext* ctx, JSValueConst obj, JSAtom
 // exp: Object.keys(obj);
 using PropertyEnumerateHandler = int (*)(JSContext* ctx, JSPropertyEnum** ptab, uint32_t* plen, JSValueConst obj);
 
+// Callback when the prototype of the class is created in a context, installs the methods and attributes on it.
+using InstallMembersHandler = void (*)(ExecutingContext* context);
+
 // This struct provides a way to store a bunch of information that is helpful
 // when creating quickjs objects. Each quickjs bindings class has exactly one static
 // WrapperTypeInfo member, so comparing pointers is a safe way to determine if
@@ -179,6 +184,7 @@ class WrapperTypeInfo final {
   PropertyCheckerHandler property_checker_handler_{nullptr};
   PropertyEnumerateHandler property_enumerate_handler_{nullptr};
   StringPropertyDeleteHandler property_delete_handler_{nullptr};
+  InstallMembersHandler install_members_handler_{nullptr};
 };
 
 }  // namespace webf
@@ -68,6 +68,24 @@ void evaluateQuickjsByteCodeInternal(void* page_,
                                                        persistent_handle, result_callback, is_success);
 }
 
+void evaluateQuickjsByteCodeFileInternal(void* page_,
+                                         const char* path,
+                                         int64_t profile_id,
+                                         Dart_PersistentHandle persistent_handle,
+                                         EvaluateQuickjsByteCodeCallback result_callback) {
+  auto page = reinterpret_cast<webf::WebFPage*>(page_);
+  assert(std::this_thread::get_id() == page->currentThread());
+
+  page->dartIsolateContext()->profiler()->StartTrackEvaluation(profile_id);
+
+  bool is_success = page->evaluateByteCodeFile(path);
+
+  page->dartIsolateContext()->profiler()->FinishTrackEvaluation(profile_id);
+
+  page->dartIsolateContext()->dispatcher()->PostToDart(page->isDedicated(), ReturnEvaluateQuickjsByteCodeResultToDart,
+                                                       persistent_handle, result_callback, is_success);
+}
+
 static void ReturnParseHTMLToDart(Dart_PersistentHandle persistent_handle, ParseHTMLCallback result_callback) {
   Dart_Handle handle = Dart_HandleFromPersistent_DL(persistent_handle);
   result_callback(handle);
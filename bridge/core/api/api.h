@@ -27,6 +27,11 @@ void evaluateQuickjsByteCodeInternal(void* page_,
                                      int64_t profile_id,
                                      Dart_PersistentHandle persistent_handle,
                                      EvaluateQuickjsByteCodeCallback result_callback);
+void evaluateQuickjsByteCodeFileInternal(void* page_,
+                                         const char* path,
+                                         int64_t profile_id,
+                                         Dart_PersistentHandle persistent_handle,
+                                         EvaluateQuickjsByteCodeCallback result_callback);
 void parseHTMLInternal(void* page_,
                        char* code,
                        int32_t length,
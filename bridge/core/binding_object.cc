@@ -93,6 +93,7 @@ BindingObject::~BindingObject() {
 BindingObject::BindingObject(JSContext* ctx, NativeBindingObject* native_binding_object) : ScriptWrappable(ctx) {
   native_binding_object->binding_target_ = this;
   native_binding_object->invoke_binding_methods_from_dart = HandleCallFromDartSideWrapper;
+  native_binding_object->event_listener_bits = NativeEventListenerBits();
   binding_object_ = native_binding_object;
 }
 
@@ -42,6 +42,20 @@ using InvokeBindingMethodsFromDart = void (*)(NativeBindingObject* binding_objec
                                               Dart_Handle dart_object,
                                               DartInvokeResultCallback result_callback);
 
+// Bitmaps of the event types listened at a binding object, indexed by ListenedEventType. EventTarget updates them when
+// listeners are added or removed, dart reads them from the shared NativeBindingObject to drop the events nobody
+// listens to without waiting for kAddEvent and kRemoveEvent commands.
+struct NativeEventListenerBits {
+  // Types with non-capture listeners.
+  uint32_t listeners{0};
+  // Types with capture listeners.
+  uint32_t capture_listeners{0};
+  // Types of which all listeners are passive.
+  uint32_t passive{0};
+  // Types with at least one once listener.
+  uint32_t once{0};
+};
+
 struct NativeBindingObject : public DartReadable {
   NativeBindingObject() = delete;
   explicit NativeBindingObject(BindingObject* target);
@@ -60,6 +74,7 @@ struct NativeBindingObject : public DartReadable {
   InvokeBindingMethodsFromDart invoke_binding_methods_from_dart{nullptr};
   InvokeBindingsMethodsFromNative invoke_bindings_methods_from_native{nullptr};
   void* extra{nullptr};
+  NativeEventListenerBits event_listener_bits;
 };
 
 enum BindingMethodCallOperations {
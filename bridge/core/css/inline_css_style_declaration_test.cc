@@ -58,9 +58,9 @@ document.body.style.setProperty('--main-color', 'lightblue'); console.assert(doc
   UICommandItem& last = buffer[commandSize - 2];
 
   EXPECT_EQ(last.type, (int32_t)UICommand::kSetStyle);
-  uint16_t* last_key = (uint16_t*)last.string_01;
-
-  auto native_str = new webf::SharedNativeString(last_key, last.args_01_length);
+  EXPECT_NE(last.args_01_length & UICommandItem::kArgs01Latin1Flag, 0);
+  uint32_t last_key_length = last.args_01_length & ~UICommandItem::kArgs01Latin1Flag;
+  auto native_str = new webf::SharedNativeString((const uint8_t*)last.string_01, last_key_length);
   EXPECT_STREQ(AtomicString(context->ctx(),
                             std::unique_ptr<AutoFreeNativeString>(static_cast<AutoFreeNativeString*>(native_str)))
                    .ToStdString(context->ctx())
@@ -6,22 +6,20 @@
 
 namespace webf {
 
-const WidgetElementShape* DartContextData::GetWidgetElementShape(const std::string& key) {
-  if (widget_element_shapes_.count(key) == 0)
+std::shared_ptr<const WidgetElementShape> DartContextData::GetWidgetElementShape(const std::string& tag_name) const {
+  std::shared_ptr<const WidgetElementShapes> shapes = std::atomic_load(&widget_element_shapes_);
+  auto it = shapes->find(tag_name);
+  if (it == shapes->end())
     return nullptr;
-  assert(widget_element_shapes_.count(key) > 0);
-  std::unique_lock<std::mutex> lock(context_data_mutex_);
-  return widget_element_shapes_[key].get();
-}
-
-bool DartContextData::HasWidgetElementShape(const std::string& key) {
-  std::unique_lock<std::mutex> lock(context_data_mutex_);
-  return widget_element_shapes_.count(key) > 0;
+  return it->second;
 }
 
-void DartContextData::SetWidgetElementShape(const std::string& key, const std::shared_ptr<WidgetElementShape>& shape) {
+void DartContextData::SetWidgetElementShape(const std::string& tag_name,
+                                            std::shared_ptr<const WidgetElementShape> shape) {
   std::unique_lock<std::mutex> lock(context_data_mutex_);
-  widget_element_shapes_[key] = shape;
+  auto shapes = std::make_shared<WidgetElementShapes>(*widget_element_shapes_);
+  (*shapes)[tag_name] = std::move(shape);
+  std::atomic_store(&widget_element_shapes_, std::shared_ptr<const WidgetElementShapes>(std::move(shapes)));
 }
 
-}  // namespace webf
\ No newline at end of file
+}  // namespace webf
@@ -6,32 +6,40 @@
 #define WEBF_CORE_DART_CONTEXT_DATA_H_
 
 #include <condition_variable>
+#include <memory>
 #include <mutex>
+#include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 #include "bindings/qjs/atomic_string.h"
 
 namespace webf {
 
+// The properties and methods of a kind of WidgetElement. A shape is immutable once published, the slot of a member is
+// its position in properties, then methods, then async_methods.
 struct WidgetElementShape {
-  std::unordered_set<std::string> built_in_properties_;
-  std::unordered_set<std::string> built_in_methods_;
-  std::unordered_set<std::string> built_in_async_methods_;
+  std::vector<std::string> properties;
+  std::vector<std::string> methods;
+  std::vector<std::string> async_methods;
 };
 
 class DartContextData {
  public:
-  const WidgetElementShape* GetWidgetElementShape(const std::string& key);
-  bool HasWidgetElementShape(const std::string& key);
-  void SetWidgetElementShape(const std::string& key, const std::shared_ptr<WidgetElementShape>& shape);
+  // Returns nullptr when dart has not reported the shape of |tag_name| yet. Doesn't take any lock.
+  std::shared_ptr<const WidgetElementShape> GetWidgetElementShape(const std::string& tag_name) const;
+  void SetWidgetElementShape(const std::string& tag_name, std::shared_ptr<const WidgetElementShape> shape);
 
  private:
+  using WidgetElementShapes = std::unordered_map<std::string, std::shared_ptr<const WidgetElementShape>>;
+
+  // Serializes the writers, readers load the current snapshot of the shapes.
   std::mutex context_data_mutex_;
   // WidgetElements' properties and methods are defined in the dart Side.
   // When a new kind of WidgetElement first created, Dart code will sync properties and methods to C++ code to generate
   // prop getter and setter and functions for JS code. This map store the properties and methods of WidgetElement which
-  // already created.
-  std::unordered_map<std::string, std::shared_ptr<WidgetElementShape>> widget_element_shapes_;
+  // already created. It is shared by the JS threads of the isolate and replaced as a whole when a shape is added.
+  std::shared_ptr<const WidgetElementShapes> widget_element_shapes_{std::make_shared<WidgetElementShapes>()};
 };
 
 }  // namespace webf
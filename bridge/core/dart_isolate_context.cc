@@ -4,6 +4,9 @@
 
 #include "dart_isolate_context.h"
 #include <unordered_set>
+#include "bindings/qjs/bytecode_bundle.h"
+#include "bindings/qjs/cppgc/object_heap.h"
+#include "bindings/qjs/shared_bytecode.h"
 #include "defined_properties_initializer.h"
 #include "event_factory.h"
 #include "html_element_factory.h"
@@ -61,6 +64,9 @@ const std::unique_ptr<DartContextData>& DartIsolateContext::EnsureData() const {
 }
 
 thread_local JSRuntime* runtime_{nullptr};
+thread_local std::unique_ptr<GCScheduler> gc_scheduler_{nullptr};
+thread_local std::unique_ptr<SamplingProfiler> sampling_profiler_{nullptr};
+thread_local std::unique_ptr<MicrotaskQueue> microtask_queue_{nullptr};
 thread_local uint32_t running_dart_isolates = 0;
 thread_local bool is_name_installed_ = false;
 
@@ -75,8 +81,12 @@ void DartIsolateContext::InitializeJSRuntime() {
   if (runtime_ != nullptr)
     return;
   runtime_ = JS_NewRuntime();
+  ObjectHeap::Initialize();
   // Avoid stack overflow when running in multiple threads.
   JS_UpdateStackTop(runtime_);
+  gc_scheduler_ = std::make_unique<GCScheduler>(runtime_);
+  sampling_profiler_ = std::make_unique<SamplingProfiler>(runtime_);
+  microtask_queue_ = std::make_unique<MicrotaskQueue>(runtime_);
   // Bump up the built-in classId. To make sure the created classId are larger than JS_CLASS_CUSTOM_CLASS_INIT_COUNT.
   for (int i = 0; i < JS_CLASS_CUSTOM_CLASS_INIT_COUNT - JS_CLASS_GC_TRACKER + 2; i++) {
     JSClassID id{0};
@@ -95,9 +105,16 @@ void DartIsolateContext::FinalizeJSRuntime() {
   HTMLElementFactory::Dispose();
   SVGElementFactory::Dispose();
   EventFactory::Dispose();
+  SharedByteCode::Dispose();
+  BytecodeBundle::Dispose();
   ClearUpWires(runtime_);
+  gc_scheduler_.reset();
+  // Holds atoms of the runtime.
+  sampling_profiler_.reset();
+  microtask_queue_.reset();
   JS_TurnOnGC(runtime_);
   JS_FreeRuntime(runtime_);
+  ObjectHeap::Dispose();
   runtime_ = nullptr;
   is_name_installed_ = false;
 }
@@ -116,13 +133,33 @@ JSRuntime* DartIsolateContext::runtime() {
   return runtime_;
 }
 
+GCScheduler* DartIsolateContext::gcScheduler() {
+  assert_m(gc_scheduler_ != nullptr, "nullptr is unsafe");
+  return gc_scheduler_.get();
+}
+
+SamplingProfiler* DartIsolateContext::samplingProfiler() {
+  assert_m(sampling_profiler_ != nullptr, "nullptr is unsafe");
+  return sampling_profiler_.get();
+}
+
+MicrotaskQueue* DartIsolateContext::microtaskQueue() {
+  assert_m(microtask_queue_ != nullptr, "nullptr is unsafe");
+  return microtask_queue_.get();
+}
+
 DartIsolateContext::~DartIsolateContext() {}
 
 void DartIsolateContext::Dispose(multi_threading::Callback callback) {
   dispatcher_->Dispose([this, &callback]() {
     is_valid_ = false;
     data_.reset();
+    prewarmed_pages_.clear();
     pages_in_ui_thread_.clear();
+    // The runtime of this thread may outlive this isolate.
+    if (gc_scheduler_ != nullptr) {
+      gc_scheduler_->ClearProfiler(profiler_.get());
+    }
     running_dart_isolates--;
     FinalizeJSRuntime();
     callback();
@@ -170,22 +207,116 @@ void* DartIsolateContext::AddNewPage(double thread_identity,
   bool is_in_flutter_ui_thread = thread_identity < 0;
   assert(is_in_flutter_ui_thread == false);
 
+  if (WebFPage* page = ClaimPrewarmedPage(thread_identity)) {
+    Dart_Handle handle = Dart_HandleFromPersistent_DL(dart_handle);
+    result_callback(handle, page);
+    Dart_DeletePersistentHandle_DL(dart_handle);
+    return page;
+  }
+
   int thread_group_id = static_cast<int>(thread_identity);
+  PageGroup* page_group = EnsurePageGroup(thread_group_id);
 
-  PageGroup* page_group;
-  if (!dispatcher_->IsThreadGroupExist(thread_group_id)) {
-    dispatcher_->AllocateNewJSThread(thread_group_id);
-    page_group = new PageGroup();
-    dispatcher_->SetOpaqueForJSThread(thread_group_id, page_group, [](void* p) {
-      delete static_cast<PageGroup*>(p);
-      DartIsolateContext::FinalizeJSRuntime();
-    });
-  } else {
-    page_group = static_cast<PageGroup*>(dispatcher_->GetOpaque(thread_group_id));
+  dispatcher_->PostToJs(true, thread_group_id, InitializeNewPageInJSThread, page_group, this, thread_identity,
+                        sync_buffer_size, dart_handle, result_callback);
+  return nullptr;
+}
+
+PageGroup* DartIsolateContext::EnsurePageGroup(int thread_group_id) {
+  if (dispatcher_->IsThreadGroupExist(thread_group_id)) {
+    return static_cast<PageGroup*>(dispatcher_->GetOpaque(thread_group_id));
   }
 
-  dispatcher_->PostToJs(true, thread_group_id, InitializeNewPageInJSThread, page_group, this, thread_identity,
+  dispatcher_->AllocateNewJSThread(thread_group_id);
+  auto* page_group = new PageGroup();
+  dispatcher_->SetOpaqueForJSThread(thread_group_id, page_group, [](void* p) {
+    delete static_cast<PageGroup*>(p);
+    DartIsolateContext::FinalizeJSRuntime();
+  });
+  return page_group;
+}
+
+void DartIsolateContext::PrewarmPage(double thread_identity,
+                                     int32_t sync_buffer_size,
+                                     Dart_Handle dart_handle,
+                                     AllocateNewPageCallback result_callback) {
+  bool is_in_flutter_ui_thread = thread_identity < 0;
+  assert(is_in_flutter_ui_thread == false);
+
+  int thread_group_id = static_cast<int>(thread_identity);
+  PageGroup* page_group = EnsurePageGroup(thread_group_id);
+
+  dispatcher_->PostToJs(true, thread_group_id, PrewarmPageInJSThread, page_group, this, thread_identity,
                         sync_buffer_size, dart_handle, result_callback);
+}
+
+void DartIsolateContext::PrewarmPageInJSThread(PageGroup* page_group,
+                                               DartIsolateContext* dart_isolate_context,
+                                               double page_context_id,
+                                               int32_t sync_buffer_size,
+                                               Dart_Handle dart_handle,
+                                               AllocateNewPageCallback result_callback) {
+  dart_isolate_context->profiler()->StartTrackInitialize();
+  DartIsolateContext::InitializeJSRuntime();
+  auto* page = new WebFPage(dart_isolate_context, true, sync_buffer_size, page_context_id, nullptr);
+  dart_isolate_context->profiler()->FinishTrackInitialize();
+
+  dart_isolate_context->dispatcher_->PostToDart(true, HandlePrewarmPageResult, page_group, dart_isolate_context,
+                                                page_context_id, dart_handle, result_callback, page);
+}
+
+void DartIsolateContext::HandlePrewarmPageResult(PageGroup* page_group,
+                                                 DartIsolateContext* dart_isolate_context,
+                                                 double page_context_id,
+                                                 Dart_Handle persistent_handle,
+                                                 AllocateNewPageCallback result_callback,
+                                                 WebFPage* new_page) {
+  dart_isolate_context->prewarmed_pages_[page_context_id] = new_page;
+  HandleNewPageResult(page_group, persistent_handle, result_callback, new_page);
+}
+
+void* DartIsolateContext::PrewarmPageSync(double thread_identity) {
+  void* page = AddNewPageSync(thread_identity);
+  prewarmed_pages_[thread_identity] = static_cast<WebFPage*>(page);
+  return page;
+}
+
+void DartIsolateContext::DisposeStalePageInJSThread(WebFPage* page) {
+  delete page;
+}
+
+void DartIsolateContext::ClaimPageInJSThread(WebFPage* page) {
+  // performance.timeOrigin is the time the page was claimed, not when it was prewarmed.
+  page->executingContext()->ResetTimeOrigin();
+}
+
+WebFPage* DartIsolateContext::ClaimPrewarmedPage(double thread_identity) {
+  auto it = prewarmed_pages_.find(thread_identity);
+  if (it == prewarmed_pages_.end())
+    return nullptr;
+
+  WebFPage* page = it->second;
+  prewarmed_pages_.erase(it);
+  if (page->executingContext()->pluginGeneration() == ExecutingContext::plugin_generation) {
+    // Runs before the tasks dart posts to the claimed page.
+    dispatcher_->PostToJs(thread_identity >= 0, static_cast<int>(thread_identity), ClaimPageInJSThread, page);
+    return page;
+  }
+
+  // Built before some plugins were registered, the caller builds a new page with the same id in its place.
+  if (thread_identity < 0) {
+    for (auto ui_page = pages_in_ui_thread_.begin(); ui_page != pages_in_ui_thread_.end(); ++ui_page) {
+      if (ui_page->get() == page) {
+        pages_in_ui_thread_.erase(ui_page);
+        break;
+      }
+    }
+  } else {
+    // Keeps the JS thread alive, the new page is built there right after this one is gone.
+    int thread_group_id = static_cast<int>(thread_identity);
+    static_cast<PageGroup*>(dispatcher_->GetOpaque(thread_group_id))->RemovePage(page);
+    dispatcher_->PostToJs(true, thread_group_id, DisposeStalePageInJSThread, page);
+  }
   return nullptr;
 }
 
@@ -201,6 +332,9 @@ std::unique_ptr<WebFPage> DartIsolateContext::InitializeNewPageSync(DartIsolateC
 }
 
 void* DartIsolateContext::AddNewPageSync(double thread_identity) {
+  if (WebFPage* page = ClaimPrewarmedPage(thread_identity))
+    return page;
+
   auto page = InitializeNewPageSync(this, 0, thread_identity);
 
   void* p = page.get();
@@ -242,6 +376,8 @@ void DartIsolateContext::RemovePage(double thread_identity,
   bool is_in_flutter_ui_thread = thread_identity < 0;
   assert(is_in_flutter_ui_thread == false);
 
+  prewarmed_pages_.erase(page->contextId());
+
   int thread_group_id = static_cast<int>(page->contextId());
   auto page_group = static_cast<PageGroup*>(dispatcher_->GetOpaque(thread_group_id));
 
@@ -257,6 +393,8 @@ void DartIsolateContext::RemovePage(double thread_identity,
 }
 
 void DartIsolateContext::RemovePageSync(double thread_identity, WebFPage* page) {
+  prewarmed_pages_.erase(page->contextId());
+
   for (auto it = pages_in_ui_thread_.begin(); it != pages_in_ui_thread_.end(); ++it) {
     if (it->get() == page) {
       pages_in_ui_thread_.erase(it);
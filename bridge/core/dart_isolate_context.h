@@ -6,11 +6,15 @@
 #define WEBF_DART_CONTEXT_H_
 
 #include <set>
+#include <unordered_map>
 #include "bindings/qjs/script_value.h"
 #include "dart_context_data.h"
 #include "dart_methods.h"
 #include "foundation/profiler.h"
+#include "gc_scheduler.h"
+#include "microtask_queue.h"
 #include "multiple_threading/dispatcher.h"
+#include "sampling_profiler.h"
 
 namespace webf {
 
@@ -50,6 +54,12 @@ class DartIsolateContext {
   explicit DartIsolateContext(const uint64_t* dart_methods, int32_t dart_methods_length, bool profile_enabled);
 
   JSRuntime* runtime();
+  // The GC scheduler of the JSRuntime of the current thread.
+  GCScheduler* gcScheduler();
+  // The JS sampling profiler of the JSRuntime of the current thread.
+  SamplingProfiler* samplingProfiler();
+  // The native microtasks of the JSRuntime of the current thread.
+  MicrotaskQueue* microtaskQueue();
   FORCE_INLINE bool valid() { return is_valid_; }
   FORCE_INLINE DartMethodPointer* dartMethodPtr() const { return dart_method_ptr_.get(); }
   FORCE_INLINE const std::unique_ptr<multi_threading::Dispatcher>& dispatcher() const { return dispatcher_; }
@@ -65,6 +75,14 @@ class DartIsolateContext {
                    Dart_Handle dart_handle,
                    AllocateNewPageCallback result_callback);
   void* AddNewPageSync(double thread_identity);
+  // Builds a page ahead of time for the page id |thread_identity|, the next AddNewPage or AddNewPageSync with the same
+  // id claims it instead of building a new one. Prewarmed pages only ran the polyfill and the plugins, and are never
+  // handed out twice.
+  void PrewarmPage(double thread_identity,
+                   int32_t sync_buffer_size,
+                   Dart_Handle dart_handle,
+                   AllocateNewPageCallback result_callback);
+  void* PrewarmPageSync(double thread_identity);
   void RemovePage(double thread_identity, WebFPage* page, Dart_Handle dart_handle, DisposePageCallback result_callback);
   void RemovePageSync(double thread_identity, WebFPage* page);
 
@@ -96,6 +114,24 @@ class DartIsolateContext {
                                   Dart_Handle persistent_handle,
                                   AllocateNewPageCallback result_callback,
                                   WebFPage* new_page);
+  static void PrewarmPageInJSThread(PageGroup* page_group,
+                                    DartIsolateContext* dart_isolate_context,
+                                    double page_context_id,
+                                    int32_t sync_buffer_size,
+                                    Dart_Handle dart_handle,
+                                    AllocateNewPageCallback result_callback);
+  static void HandlePrewarmPageResult(PageGroup* page_group,
+                                      DartIsolateContext* dart_isolate_context,
+                                      double page_context_id,
+                                      Dart_Handle persistent_handle,
+                                      AllocateNewPageCallback result_callback,
+                                      WebFPage* new_page);
+  static void DisposeStalePageInJSThread(WebFPage* page);
+  static void ClaimPageInJSThread(WebFPage* page);
+  PageGroup* EnsurePageGroup(int thread_group_id);
+  // Takes the prewarmed page of |thread_identity| out of the pool, returns nullptr when there is none or when it
+  // misses plugins registered after it was built.
+  WebFPage* ClaimPrewarmedPage(double thread_identity);
   static void HandleDisposePage(Dart_Handle persistent_handle, DisposePageCallback result_callback);
   static void HandleDisposePageAndKillJSThread(DartIsolateContext* dart_isolate_context,
                                                int thread_group_id,
@@ -107,6 +143,8 @@ class DartIsolateContext {
   std::thread::id running_thread_;
   mutable std::unique_ptr<DartContextData> data_;
   std::unordered_set<std::unique_ptr<WebFPage>> pages_in_ui_thread_;
+  // The prewarmed pages waiting to be claimed, they are owned by their page group or by pages_in_ui_thread_.
+  std::unordered_map<double, WebFPage*> prewarmed_pages_;
   std::unique_ptr<multi_threading::Dispatcher> dispatcher_ = nullptr;
   // Dart methods ptr should keep alive when ExecutingContext is disposing.
   const std::unique_ptr<DartMethodPointer> dart_method_ptr_ = nullptr;
@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "dart_isolate_context.h"
+#include <thread>
+#include "gtest/gtest.h"
+#include "include/webf_bridge.h"
+#include "page.h"
+#include "webf_test_env.h"
+
+using namespace webf;
+
+namespace {
+
+bool GlobalIsTrue(void* page, const char* name) {
+  JSContext* ctx = static_cast<WebFPage*>(page)->executingContext()->ctx();
+  JSValue global = JS_GetGlobalObject(ctx);
+  JSValue value = JS_GetPropertyStr(ctx, global, name);
+  bool result = JS_ToBool(ctx, value);
+  JS_FreeValue(ctx, value);
+  JS_FreeValue(ctx, global);
+  return result;
+}
+
+}  // namespace
+
+TEST(DartIsolateContext, claimPrewarmedPage) {
+  auto mocked_dart_methods = TEST_getMockDartMethods(nullptr);
+  auto* dart_isolate_context = static_cast<DartIsolateContext*>(
+      initDartIsolateContextSync(0, mocked_dart_methods.data(), mocked_dart_methods.size(), true));
+
+  void* prewarmed = prewarmPageSync(-1000, dart_isolate_context);
+  auto prewarmed_at = static_cast<WebFPage*>(prewarmed)->executingContext()->timeOrigin();
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  EXPECT_EQ(allocateNewPageSync(-1000, dart_isolate_context), prewarmed);
+  // The time origin is when the page was claimed.
+  EXPECT_GT(static_cast<WebFPage*>(prewarmed)->executingContext()->timeOrigin(), prewarmed_at);
+
+  // Every prewarmed page is handed out once.
+  void* page = allocateNewPageSync(-1001, dart_isolate_context);
+  EXPECT_NE(page, prewarmed);
+
+  disposePageSync(-1000, dart_isolate_context, prewarmed);
+  disposePageSync(-1001, dart_isolate_context, page);
+  delete dart_isolate_context;
+}
+
+TEST(DartIsolateContext, discardPrewarmedPageMissingPlugins) {
+  auto mocked_dart_methods = TEST_getMockDartMethods(nullptr);
+  auto* dart_isolate_context = static_cast<DartIsolateContext*>(
+      initDartIsolateContextSync(0, mocked_dart_methods.data(), mocked_dart_methods.size(), true));
+
+  void* prewarmed = prewarmPageSync(-1002, dart_isolate_context);
+  EXPECT_FALSE(GlobalIsTrue(prewarmed, "prewarmTestPlugin"));
+
+  std::string plugin = "globalThis.prewarmTestPlugin = true;";
+  registerPluginCode(plugin.c_str(), plugin.size(), "prewarm_test");
+  void* page = allocateNewPageSync(-1002, dart_isolate_context);
+  EXPECT_TRUE(GlobalIsTrue(page, "prewarmTestPlugin"));
+  ExecutingContext::plugin_string_code.erase("prewarm_test");
+
+  disposePageSync(-1002, dart_isolate_context, page);
+  delete dart_isolate_context;
+}
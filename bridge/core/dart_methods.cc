@@ -67,6 +67,16 @@ NativeValue* DartMethodPointer::invokeModule(bool is_dedicated,
   return result;
 }
 
+NativeValue* DartMethodPointer::invokeModuleOnDartThread(void* callback_context,
+                                                         double context_id,
+                                                         int64_t profile_link_id,
+                                                         SharedNativeString* moduleName,
+                                                         SharedNativeString* method,
+                                                         NativeValue* params,
+                                                         AsyncModuleCallback callback) {
+  return invoke_module_(callback_context, context_id, profile_link_id, moduleName, method, params, callback);
+}
+
 void DartMethodPointer::requestBatchUpdate(bool is_dedicated, double context_id) {
 #if ENABLE_LOG
   WEBF_LOG(INFO) << "[Dispatcher] DartMethodPointer::requestBatchUpdate Call";
@@ -147,6 +147,14 @@ class DartMethodPointer {
                             SharedNativeString* method,
                             NativeValue* params,
                             AsyncModuleCallback callback);
+  // Calls invokeModule of dart without going through the dispatcher, the caller should be on the dart thread.
+  NativeValue* invokeModuleOnDartThread(void* callback_context,
+                                        double context_id,
+                                        int64_t profile_link_id,
+                                        SharedNativeString* moduleName,
+                                        SharedNativeString* method,
+                                        NativeValue* params,
+                                        AsyncModuleCallback callback);
 
   void requestBatchUpdate(bool is_dedicated, double context_id);
   void reloadApp(bool is_dedicated, double context_id);
@@ -83,6 +83,33 @@ Event::Event(ExecutingContext* context, const AtomicString& event_type, NativeEv
 }
 #endif
 
+void Event::ResetWithNativeEvent(NativeEvent* native_event) {
+  assert(customized_event_props_.empty());
+  raw_event_ = native_event;
+  bubbles_ = native_event->bubbles;
+  composed_ = native_event->composed;
+  cancelable_ = native_event->cancelable;
+  time_stamp_ = native_event->timeStamp;
+  default_prevented_ = native_event->defaultPrevented;
+  propagation_stopped_ = false;
+  immediate_propagation_stopped_ = false;
+  default_handled_ = false;
+  is_trusted_ = false;
+  handling_passive_ = PassiveMode::kNotPassiveDefault;
+  prevent_default_called_on_uncancelable_event_ = false;
+  fire_only_capture_listeners_at_target_ = false;
+  fire_only_non_capture_listeners_at_target_ = false;
+  event_phase_ = 0;
+#if ANDROID_32_BIT
+  target_ = DynamicTo<EventTarget>(BindingObject::From(reinterpret_cast<NativeBindingObject*>(native_event->target)));
+  current_target_ =
+      DynamicTo<EventTarget>(BindingObject::From(reinterpret_cast<NativeBindingObject*>(native_event->currentTarget)));
+#else
+  target_ = DynamicTo<EventTarget>(BindingObject::From(native_event->target));
+  current_target_ = DynamicTo<EventTarget>(BindingObject::From(native_event->currentTarget));
+#endif
+}
+
 void Event::SetType(const AtomicString& type) {
   type_ = type;
 }
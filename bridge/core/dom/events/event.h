@@ -234,6 +234,14 @@ class Event : public ScriptWrappable {
   bool FireOnlyCaptureListenersAtTarget() const { return fire_only_capture_listeners_at_target_; }
   bool FireOnlyNonCaptureListenersAtTarget() const { return fire_only_non_capture_listeners_at_target_; }
 
+  // Reinitialize a recycled event with the next native event of the same type dispatched from dart, see EventPool.
+  virtual void ResetWithNativeEvent(NativeEvent* native_event);
+  // Customized props are shared with dart by the raw event, the event must be kept alive until dart releases them.
+  bool HasCustomizedProps() const { return !customized_event_props_.empty(); }
+  // For the events which outlive the raw event of dart. The fields were copied when the event was created, the props
+  // of the raw event are no longer reachable.
+  void DetachNativeEvent() { raw_event_ = nullptr; }
+
   void Trace(GCVisitor* visitor) const override;
 
  protected:
@@ -3,6 +3,7 @@
  * Copyright (C) 2022-present The WebF authors. All rights reserved.
  */
 #include "event_listener_map.h"
+#include "foundation/string_view.h"
 
 namespace webf {
 
@@ -59,6 +60,15 @@ bool EventListenerMap::Contains(const AtomicString& event_type) const {
   return false;
 }
 
+bool EventListenerMap::Contains(const SharedNativeString* event_type) const {
+  StringView event_type_view = StringView(event_type);
+  for (const auto& entry : entries_) {
+    if (EqualStringView(entry.first.ToStringView(), event_type_view))
+      return true;
+  }
+  return false;
+}
+
 bool EventListenerMap::ContainsCapturing(const AtomicString& event_type) const {
   for (const auto& entry : entries_) {
     if (entry.first == event_type) {
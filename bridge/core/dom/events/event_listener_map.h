@@ -31,6 +31,8 @@ class EventListenerMap final {
 
   bool IsEmpty() const { return entries_.empty(); }
   bool Contains(const AtomicString& event_type) const;
+  // Match the event type by characters, so the string passed from dart doesn't need to be an atom.
+  bool Contains(const SharedNativeString* event_type) const;
   bool ContainsCapturing(const AtomicString& event_type) const;
   void Clear();
   bool Add(const AtomicString& event_type,
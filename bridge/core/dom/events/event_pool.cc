@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "event_pool.h"
+#include "bindings/qjs/qjs_engine_patch.h"
+#include "core/executing_context.h"
+#include "event.h"
+#include "event_factory.h"
+#include "event_type_names.h"
+
+namespace webf {
+
+static int IndexOfPooledEventType(const AtomicString& type) {
+  if (type == event_type_names::kscroll)
+    return 0;
+  if (type == event_type_names::ktouchmove)
+    return 1;
+  if (type == event_type_names::kpointermove)
+    return 2;
+  return -1;
+}
+
+EventPool::EventPool(ExecutingContext* context) : context_(context) {}
+
+EventPool::~EventPool() {
+  for (auto& entry : entries_) {
+    Release(entry);
+  }
+}
+
+bool EventPool::IsPooledEventType(const AtomicString& type) {
+  return IndexOfPooledEventType(type) >= 0;
+}
+
+Event* EventPool::Acquire(const AtomicString& type, RawEvent* raw_event) {
+  int index = IndexOfPooledEventType(type);
+  if (index < 0 || raw_event == nullptr || raw_event->is_custom_event) {
+    return EventFactory::Create(context_, type, raw_event);
+  }
+
+  Entry& entry = entries_[index];
+  if (IsReusable(entry, raw_event)) {
+    entry.event->ResetWithNativeEvent(toNativeEvent<NativeEvent>(raw_event));
+    return entry.event;
+  }
+
+  Release(entry);
+  entry.event = EventFactory::Create(context_, type, raw_event);
+  entry.value = entry.event->ToQuickJS();
+  entry.length = raw_event->length;
+  return entry.event;
+}
+
+bool EventPool::IsReusable(const Entry& entry, RawEvent* raw_event) const {
+  if (entry.event == nullptr)
+    return false;
+  // The event class is decided by the size of raw event, see EventFactory.
+  if (entry.length != raw_event->length)
+    return false;
+  // The pool holds the only reference.
+  if (reinterpret_cast<JSRefCountHeader*>(JS_VALUE_GET_PTR(entry.value))->ref_count != 1)
+    return false;
+  return JS_GetOwnPropertyCount(entry.value) == 0 && !entry.event->HasCustomizedProps();
+}
+
+void EventPool::Release(Entry& entry) {
+  if (entry.event == nullptr)
+    return;
+  JS_FreeValue(context_->ctx(), entry.value);
+  entry.event = nullptr;
+  entry.value = JS_NULL;
+  entry.length = 0;
+}
+
+}  // namespace webf
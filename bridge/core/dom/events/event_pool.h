@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef BRIDGE_CORE_DOM_EVENTS_EVENT_POOL_H_
+#define BRIDGE_CORE_DOM_EVENTS_EVENT_POOL_H_
+
+#include <quickjs/quickjs.h>
+#include "bindings/qjs/atomic_string.h"
+
+namespace webf {
+
+class Event;
+class ExecutingContext;
+struct RawEvent;
+
+// Scroll, touchmove and pointermove are dispatched from dart on every frame. Instead of creating a new Event object
+// and JS object for each of them, the last event of these types is kept and reinitialized for the next dispatch.
+// A pooled event is only reused when nothing else can observe it: no script holds a reference to it, no own property
+// was defined on it and no customized props were shared with dart.
+class EventPool final {
+ public:
+  explicit EventPool(ExecutingContext* context);
+  EventPool(const EventPool&) = delete;
+  EventPool& operator=(const EventPool&) = delete;
+  ~EventPool();
+
+  static bool IsPooledEventType(const AtomicString& type);
+
+  // Returns an event initialized with the raw event, events of the other types are created by EventFactory.
+  Event* Acquire(const AtomicString& type, RawEvent* raw_event);
+
+ private:
+  struct Entry {
+    Event* event{nullptr};
+    JSValue value{JS_NULL};
+    int64_t length{0};
+  };
+
+  bool IsReusable(const Entry& entry, RawEvent* raw_event) const;
+  void Release(Entry& entry);
+
+  ExecutingContext* context_;
+  Entry entries_[3];
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_CORE_DOM_EVENTS_EVENT_POOL_H_
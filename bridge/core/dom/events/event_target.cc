@@ -6,6 +6,7 @@
 #include <cstdint>
 #include "binding_call_methods.h"
 #include "bindings/qjs/converter_impl.h"
+#include "core/events/touch_event.h"
 #include "event_factory.h"
 #include "include/dart_api.h"
 #include "native_value_converter.h"
@@ -268,6 +269,10 @@ bool EventTarget::AddEventListenerInternal(const AtomicString& event_type,
     added = EnsureEventTargetData().event_listener_map.Add(event_type, listener, options, &registered_listener,
                                                            &listener_count);
 
+  if (added) {
+    UpdateEventListenerBits(event_type);
+  }
+
   if (added && listener_count == 1) {
     auto* listener_options = new DartAddEventListenerOptions{};
     if (options->hasOnce()) {
@@ -301,10 +306,14 @@ bool EventTarget::RemoveEventListenerInternal(const AtomicString& event_type,
   RegisteredEventListener registered_listener;
 
   uint32_t listener_count = UINT32_MAX;
-  if (!d->event_listener_map.Remove(event_type, listener, options, &index_of_removed_listener, &registered_listener,
-                                    &listener_count))
+  bool has_capture = options->hasCapture() && options->capture();
+  EventListenerMap& listener_map = has_capture ? d->event_capture_listener_map : d->event_listener_map;
+  if (!listener_map.Remove(event_type, listener, options, &index_of_removed_listener, &registered_listener,
+                           &listener_count))
     return false;
 
+  UpdateEventListenerBits(event_type);
+
   // Notify firing events planning to invoke the listener at 'index' that
   // they have one less listener to invoke.
   if (d->firing_event_iterators) {
@@ -326,8 +335,6 @@ bool EventTarget::RemoveEventListenerInternal(const AtomicString& event_type,
   }
 
   if (listener_count == 0) {
-    bool has_capture = options->hasCapture() && options->capture();
-
     GetExecutingContext()->uiCommandBuffer()->AddCommand(UICommand::kRemoveEvent,
                                                          std::move(event_type.ToNativeString(ctx())), bindingObject(),
                                                          has_capture ? (void*)0x01 : nullptr);
@@ -336,6 +343,56 @@ bool EventTarget::RemoveEventListenerInternal(const AtomicString& event_type,
   return true;
 }
 
+static int ListenedEventTypeIndex(const AtomicString& event_type) {
+  const std::pair<ListenedEventType, const AtomicString*> types[] = {
+      {ListenedEventType::kScroll, &event_type_names::kscroll},
+      {ListenedEventType::kResize, &event_type_names::kresize},
+      {ListenedEventType::kTouchStart, &event_type_names::ktouchstart},
+      {ListenedEventType::kTouchMove, &event_type_names::ktouchmove},
+      {ListenedEventType::kTouchEnd, &event_type_names::ktouchend},
+      {ListenedEventType::kTouchCancel, &event_type_names::ktouchcancel},
+      {ListenedEventType::kPointerDown, &event_type_names::kpointerdown},
+      {ListenedEventType::kPointerMove, &event_type_names::kpointermove},
+      {ListenedEventType::kPointerUp, &event_type_names::kpointerup},
+      {ListenedEventType::kPointerCancel, &event_type_names::kpointercancel},
+      {ListenedEventType::kClick, &event_type_names::kclick},
+  };
+  for (const auto& type : types) {
+    if (*type.second == event_type)
+      return static_cast<int>(type.first);
+  }
+  return -1;
+}
+
+void EventTarget::UpdateEventListenerBits(const AtomicString& event_type) {
+  int index = ListenedEventTypeIndex(event_type);
+  if (index < 0)
+    return;
+
+  EventTargetData* d = GetEventTargetData();
+  EventListenerVector* listeners = d->event_listener_map.Find(event_type);
+  EventListenerVector* capture_listeners = d->event_capture_listener_map.Find(event_type);
+
+  bool passive = listeners != nullptr || capture_listeners != nullptr;
+  bool once = false;
+  for (auto* vector : {listeners, capture_listeners}) {
+    if (vector == nullptr)
+      continue;
+    for (const auto& registered_listener : *vector) {
+      passive = passive && registered_listener.Passive();
+      once = once || registered_listener.Once();
+    }
+  }
+
+  uint32_t bit = 1u << index;
+  auto update = [bit](uint32_t& bits, bool value) { bits = value ? bits | bit : bits & ~bit; };
+  NativeEventListenerBits& bits = bindingObject()->event_listener_bits;
+  update(bits.listeners, listeners != nullptr);
+  update(bits.capture_listeners, capture_listeners != nullptr);
+  update(bits.passive, passive);
+  update(bits.once, once);
+}
+
 DispatchEventResult EventTarget::DispatchEventInternal(Event& event, ExceptionState& exception_state) {
   event.SetTarget(this);
   event.SetCurrentTarget(this);
@@ -361,20 +418,51 @@ NativeValue EventTarget::HandleCallFromDartSide(const AtomicString& method,
 }
 
 NativeValue EventTarget::HandleDispatchEventFromDart(int32_t argc, const NativeValue* argv, Dart_Handle dart_object) {
-  GetExecutingContext()->dartIsolateContext()->profiler()->StartTrackSteps("EventTarget::HandleDispatchEventFromDart");
-
   assert(argc >= 2);
   NativeValue native_event_type = argv[0];
   NativeValue native_is_capture = argv[2];
   bool isCapture = NativeValueConverter<NativeTypeBool>::FromNativeValue(native_is_capture);
+
+  // Most of the events from dart have no listeners at the current target. Find it out with the characters of the
+  // event type before creating the atom and the event, a null result tells dart nothing was changed by JavaScript.
+  if (native_event_type.tag == NativeTag::TAG_STRING) {
+    auto* event_type_string = static_cast<SharedNativeString*>(native_event_type.u.ptr);
+    if (!HasEventListenersForDartEvent(event_type_string, isCapture)) {
+      delete static_cast<AutoFreeNativeString*>(event_type_string);
+      return Native_NewNull();
+    }
+  }
+
+  GetExecutingContext()->dartIsolateContext()->profiler()->StartTrackSteps("EventTarget::HandleDispatchEventFromDart");
+
   AtomicString event_type =
       NativeValueConverter<NativeTypeString>::FromNativeValue(ctx(), std::move(native_event_type));
   RawEvent* raw_event = NativeValueConverter<NativeTypePointer<RawEvent>>::FromNativeValue(argv[1]);
 
-  Event* event = EventFactory::Create(GetExecutingContext(), event_type, raw_event);
+  Event* event = GetExecutingContext()->Events()->Acquire(event_type, raw_event);
   assert(event->target() != nullptr);
   assert(event->currentTarget() != nullptr);
 
+  // Touchmove samples merged by dart in the same frame, exposed through getCoalescedEvents().
+  if (argc > 3 && argv[3].tag == NativeTag::TAG_LIST) {
+    if (auto* touch_event = DynamicTo<TouchEvent>(event)) {
+      auto* coalesced_raw_events = static_cast<NativeValue*>(argv[3].u.ptr);
+      std::vector<Member<TouchEvent>> coalesced_events;
+      coalesced_events.reserve(argv[3].uint32);
+      for (uint32_t i = 0; i < argv[3].uint32; i++) {
+        RawEvent* coalesced_raw_event =
+            NativeValueConverter<NativeTypePointer<RawEvent>>::FromNativeValue(coalesced_raw_events[i]);
+        if (auto* coalesced_event = DynamicTo<TouchEvent>(EventFactory::Create(GetExecutingContext(), event_type,
+                                                                               coalesced_raw_event))) {
+          // Dart frees the coalesced raw events once the dispatch returns, but scripts can keep the coalesced events.
+          coalesced_event->DetachNativeEvent();
+          coalesced_events.emplace_back(coalesced_event);
+        }
+      }
+      touch_event->SetCoalescedEvents(std::move(coalesced_events));
+    }
+  }
+
   auto* window = DynamicTo<Window>(event->target());
   if (window != nullptr && (event->type() == event_type_names::kload || event->type() == event_type_names::kgcopen)) {
     window->OnLoadEventFired();
@@ -386,37 +474,41 @@ NativeValue EventTarget::HandleDispatchEventFromDart(int32_t argc, const NativeV
   DispatchEventResult dispatch_result = FireEventListeners(*event, isCapture, exception_state);
   event->SetEventPhase(0);
 
-  auto* wire = new DartWireContext();
-  wire->jsObject = event->ToValue();
-  wire->is_dedicated = GetExecutingContext()->isDedicated();
-  wire->context_id = GetExecutingContext()->contextId();
-  wire->dispatcher = GetDispatcher();
-  wire->disposed = false;
-
-  auto dart_object_finalize_callback = [](void* isolate_callback_data, void* peer) {
-    auto* wire = (DartWireContext*)(peer);
-
-    if (wire->disposed)
-      return;
-
-    wire->dispatcher->PostToJs(
-        wire->is_dedicated, wire->context_id,
-        [](DartWireContext* wire) -> void {
-          if (IsDartWireAlive(wire)) {
-            DeleteDartWire(wire);
-          }
+  // Dart reads the customized props from the raw event after dispatch, keep the event alive until the dart event
+  // is finalized. Other events are fire-and-forget and don't need the wire.
+  if (event->HasCustomizedProps()) {
+    auto* wire = new DartWireContext();
+    wire->jsObject = event->ToValue();
+    wire->is_dedicated = GetExecutingContext()->isDedicated();
+    wire->context_id = GetExecutingContext()->contextId();
+    wire->dispatcher = GetDispatcher();
+    wire->disposed = false;
+
+    auto dart_object_finalize_callback = [](void* isolate_callback_data, void* peer) {
+      auto* wire = (DartWireContext*)(peer);
+
+      if (wire->disposed)
+        return;
+
+      wire->dispatcher->PostToJs(
+          wire->is_dedicated, wire->context_id,
+          [](DartWireContext* wire) -> void {
+            if (IsDartWireAlive(wire)) {
+              DeleteDartWire(wire);
+            }
+          },
+          wire);
+    };
+
+    WatchDartWire(wire);
+
+    GetDispatcher()->PostToDart(
+        GetExecutingContext()->isDedicated(),
+        [](Dart_Handle object, void* peer, intptr_t external_allocation_size, Dart_HandleFinalizer callback) {
+          Dart_NewFinalizableHandle_DL(object, peer, external_allocation_size, callback);
         },
-        wire);
-  };
-
-  WatchDartWire(wire);
-
-  GetDispatcher()->PostToDart(
-      GetExecutingContext()->isDedicated(),
-      [](Dart_Handle object, void* peer, intptr_t external_allocation_size, Dart_HandleFinalizer callback) {
-        Dart_NewFinalizableHandle_DL(object, peer, external_allocation_size, callback);
-      },
-      dart_object, reinterpret_cast<void*>(wire), sizeof(DartWireContext), dart_object_finalize_callback);
+        dart_object, reinterpret_cast<void*>(wire), sizeof(DartWireContext), dart_object_finalize_callback);
+  }
 
   if (exception_state.HasException()) {
     JSValue error = JS_GetException(ctx());
@@ -431,6 +523,19 @@ NativeValue EventTarget::HandleDispatchEventFromDart(int32_t argc, const NativeV
   return NativeValueConverter<NativeTypePointer<EventDispatchResult>>::ToNativeValue(result);
 }
 
+bool EventTarget::HasEventListenersForDartEvent(const SharedNativeString* event_type, bool is_capture) {
+  if (HandlesDartEventWithoutListeners(StringView(event_type)))
+    return true;
+
+  EventTargetData* d = GetEventTargetData();
+  if (!d)
+    return false;
+
+  if (is_capture)
+    return d->event_capture_listener_map.Contains(event_type);
+  return d->event_listener_map.Contains(event_type);
+}
+
 RegisteredEventListener* EventTarget::GetAttributeRegisteredEventListener(const AtomicString& event_type) {
   EventListenerVector* listener_vector = GetEventListeners(event_type);
   if (!listener_vector)
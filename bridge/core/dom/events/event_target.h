@@ -59,6 +59,22 @@ struct FiringEventIterator {
 
 using FiringEventIteratorVector = std::vector<FiringEventIterator>;
 
+// Event types tracked by NativeEventListenerBits. Keep in sync with kListenedEventTypes in
+// webf/lib/src/bridge/binding.dart.
+enum class ListenedEventType : uint8_t {
+  kScroll = 0,
+  kResize,
+  kTouchStart,
+  kTouchMove,
+  kTouchEnd,
+  kTouchCancel,
+  kPointerDown,
+  kPointerMove,
+  kPointerUp,
+  kPointerCancel,
+  kClick,
+};
+
 class EventTargetData final {
   WEBF_DISALLOW_NEW();
 
@@ -132,6 +148,9 @@ class EventTarget : public BindingObject {
   EventListenerVector* GetEventListeners(const AtomicString& event_type);
 
   virtual bool IsWindowOrWorkerGlobalScope() const { return false; }
+  // Events from dart are dropped before they are created if no listeners are registered at this target, override
+  // this when the target reacts to the event by itself.
+  virtual bool HandlesDartEventWithoutListeners(const StringView& event_type) const { return false; }
   virtual bool IsNode() const { return false; }
   bool IsEventTarget() const override;
 
@@ -163,6 +182,8 @@ class EventTarget : public BindingObject {
   RegisteredEventListener* GetAttributeRegisteredEventListener(const AtomicString& event_type);
 
   bool FireEventListeners(Event&, EventTargetData*, EventListenerVector&, ExceptionState&);
+  bool HasEventListenersForDartEvent(const SharedNativeString* event_type, bool is_capture);
+  void UpdateEventListenerBits(const AtomicString& event_type);
 };
 
 template <>
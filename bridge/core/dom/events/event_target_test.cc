@@ -5,8 +5,10 @@
 #include "event_target.h"
 #include "core/dom/container_node.h"
 #include "core/dom/events/event.h"
+#include "core/events/pointer_event.h"
 #include "event_type_names.h"
 #include "gtest/gtest.h"
+#include "qjs_pointer_event.h"
 #include "webf_test_env.h"
 
 using namespace webf;
@@ -276,4 +278,74 @@ proxy.dispatchEvent(new Event('click'));
 
   JS_RunGC(JS_GetRuntime(env->page()->executingContext()->ctx()));
   EXPECT_EQ(logCalled, true);
-}
\ No newline at end of file
+}
+
+TEST(EventTarget, eventListenerBits) {
+  auto env = TEST_init();
+  auto context = env->page()->executingContext();
+  std::string code = R"(
+var target = document.createElement('div');
+function onScroll() {}
+function onTouchMove() {}
+target.addEventListener('scroll', onScroll, {passive: true});
+target.addEventListener('touchmove', onTouchMove, {capture: true, once: true});
+target.addEventListener('customevent', onScroll);
+)";
+  env->page()->evaluateScript(code.c_str(), code.size(), "internal://", 0);
+
+  JSValue value = JS_GetPropertyStr(context->ctx(), context->Global(), "target");
+  auto* target = toScriptWrappable<EventTarget>(value);
+  JS_FreeValue(context->ctx(), value);
+  const NativeEventListenerBits& bits = target->bindingObject()->event_listener_bits;
+  uint32_t scroll = 1u << static_cast<int>(ListenedEventType::kScroll);
+  uint32_t touch_move = 1u << static_cast<int>(ListenedEventType::kTouchMove);
+
+  EXPECT_EQ(bits.listeners, scroll);
+  EXPECT_EQ(bits.capture_listeners, touch_move);
+  EXPECT_EQ(bits.passive, scroll);
+  EXPECT_EQ(bits.once, touch_move);
+
+  std::string code2 = R"(
+target.addEventListener('scroll', function() {});
+target.removeEventListener('touchmove', onTouchMove, true);
+)";
+  env->page()->evaluateScript(code2.c_str(), code2.size(), "internal://", 0);
+
+  EXPECT_EQ(bits.listeners, scroll);
+  EXPECT_EQ(bits.capture_listeners, 0u);
+  EXPECT_EQ(bits.passive, 0u);
+  EXPECT_EQ(bits.once, 0u);
+}
+
+// Pointermove events are pooled, a reused event must not keep the fields of the previous pointermove.
+TEST(EventTarget, pooledPointerEventIsReinitialized) {
+  auto env = TEST_init();
+  auto context = env->page()->executingContext();
+  JSContext* ctx = context->ctx();
+
+  NativePointerEvent first{};
+  first.native_event.clientX = 10;
+  first.native_event.clientY = 20;
+  first.pointerId = 1;
+  first.pointerType = AtomicString(ctx, "touch").ToNativeString(ctx).release();
+  first.pressure = 0.5;
+  first.tiltX = 30;
+  auto* event = MakeGarbageCollected<PointerEvent>(context, event_type_names::kpointermove, &first);
+
+  NativePointerEvent second{};
+  second.native_event.clientX = 11;
+  second.native_event.clientY = 21;
+  second.pointerId = 2;
+  second.pointerType = AtomicString(ctx, "pen").ToNativeString(ctx).release();
+  second.pressure = 1;
+  event->ResetWithNativeEvent(reinterpret_cast<NativeEvent*>(&second));
+
+  EXPECT_EQ(event->clientX(), 11);
+  EXPECT_EQ(event->clientY(), 21);
+  EXPECT_EQ(event->pointerId(), 2);
+  EXPECT_EQ(event->pointerType(), AtomicString(ctx, "pen"));
+  EXPECT_EQ(event->pressure(), 1);
+  EXPECT_EQ(event->tiltX(), 0);
+
+  JS_FreeValue(ctx, event->ToQuickJSUnsafe());
+}
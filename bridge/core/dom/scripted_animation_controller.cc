@@ -35,8 +35,10 @@ static void handleRAFTransientCallback(void* ptr, double contextId, double highR
 
   frame_callback->SetStatus(FrameCallback::FrameStatus::kExecuting);
 
-  // Trigger callbacks.
+  // Trigger callbacks, the collections the frame would run are put off to the next idle time.
+  context->dartIsolateContext()->gcScheduler()->WillRunFrame();
   frame_callback->Fire(highResTimeStamp);
+  context->dartIsolateContext()->gcScheduler()->DidRunFrame();
 
   frame_callback->SetStatus(FrameCallback::FrameStatus::kFinished);
 
@@ -125,6 +125,15 @@ bool MouseEvent::IsMouseEvent() const {
   return true;
 }
 
+void MouseEvent::ResetWithNativeEvent(NativeEvent* native_event) {
+  UIEvent::ResetWithNativeEvent(native_event);
+  auto* native_mouse_event = reinterpret_cast<NativeMouseEvent*>(native_event);
+  client_x_ = native_mouse_event->clientX;
+  client_y_ = native_mouse_event->clientY;
+  offset_x_ = native_mouse_event->offsetX;
+  offset_y_ = native_mouse_event->offsetY;
+}
+
 void MouseEvent::Trace(GCVisitor* visitor) const {
   visitor->TraceMember(related_target_);
   UIEvent::Trace(visitor);
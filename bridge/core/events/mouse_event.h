@@ -57,6 +57,7 @@ class MouseEvent : public UIEvent {
   void Trace(GCVisitor* visitor) const override;
 
   bool IsMouseEvent() const override;
+  void ResetWithNativeEvent(NativeEvent* native_event) override;
 
  private:
   bool alt_key_;
@@ -98,4 +98,22 @@ bool PointerEvent::IsPointerEvent() const {
   return true;
 }
 
+void PointerEvent::ResetWithNativeEvent(NativeEvent* native_event) {
+  MouseEvent::ResetWithNativeEvent(native_event);
+  auto* native_pointer_event = reinterpret_cast<NativePointerEvent*>(native_event);
+  height_ = native_pointer_event->height;
+  is_primary = native_pointer_event->isPrimary;
+  pointer_id_ = native_pointer_event->pointerId;
+  // The AtomicString takes the ownership of the native string and frees it, as the constructor does.
+  pointer_type_ =
+      AtomicString(ctx(), std::unique_ptr<AutoFreeNativeString>(
+                              reinterpret_cast<AutoFreeNativeString*>(native_pointer_event->pointerType)));
+  pressure_ = native_pointer_event->pressure;
+  tangential_pressure_ = native_pointer_event->tangentialPressure;
+  tilt_x_ = native_pointer_event->tiltX;
+  tilt_y_ = native_pointer_event->tiltY;
+  twist_ = native_pointer_event->twist;
+  width_ = native_pointer_event->width;
+}
+
 }  // namespace webf
\ No newline at end of file
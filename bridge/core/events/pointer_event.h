@@ -46,6 +46,7 @@ class PointerEvent : public MouseEvent {
   double width() const;
 
   bool IsPointerEvent() const override;
+  void ResetWithNativeEvent(NativeEvent* native_event) override;
 
  private:
   double height_;
@@ -87,10 +87,29 @@ TouchList* TouchEvent::targetTouches() const {
   return target_touches_;
 }
 
+std::vector<TouchEvent*> TouchEvent::getCoalescedEvents(ExceptionState& exception_state) {
+  // https://w3c.github.io/pointerevents/#dom-pointerevent-getcoalescedevents
+  // The list ends with the sample of this event.
+  std::vector<TouchEvent*> result;
+  result.reserve(coalesced_events_.size() + 1);
+  for (auto& event : coalesced_events_) {
+    result.emplace_back(event.Get());
+  }
+  result.emplace_back(this);
+  return result;
+}
+
+void TouchEvent::SetCoalescedEvents(std::vector<Member<TouchEvent>>&& coalesced_events) {
+  coalesced_events_ = std::move(coalesced_events);
+}
+
 void TouchEvent::Trace(GCVisitor* visitor) const {
   visitor->TraceMember(touches_);
   visitor->TraceMember(changed_touches_);
   visitor->TraceMember(target_touches_);
+  for (auto& event : coalesced_events_) {
+    visitor->TraceMember(event);
+  }
   UIEvent::Trace(visitor);
 }
 
@@ -102,4 +121,28 @@ bool TouchEvent::IsTouchEvent() const {
   return true;
 }
 
+void TouchEvent::ResetWithNativeEvent(NativeEvent* native_event) {
+  UIEvent::ResetWithNativeEvent(native_event);
+  auto* native_touch_event = reinterpret_cast<NativeTouchEvent*>(native_event);
+  ExecutingContext* context = GetExecutingContext();
+  alt_key_ = native_touch_event->altKey;
+  ctrl_key_ = native_touch_event->ctrlKey;
+  meta_key_ = native_touch_event->metaKey;
+  shift_key_ = native_touch_event->shiftKey;
+  coalesced_events_.clear();
+#if ANDROID_32_BIT
+  changed_touches_ =
+      MakeGarbageCollected<TouchList>(context, reinterpret_cast<NativeTouchList*>(native_touch_event->changedTouches));
+  target_touches_ =
+      MakeGarbageCollected<TouchList>(context, reinterpret_cast<NativeTouchList*>(native_touch_event->targetTouches));
+  touches_ = MakeGarbageCollected<TouchList>(context, reinterpret_cast<NativeTouchList*>(native_touch_event->touches));
+#else
+  changed_touches_ =
+      MakeGarbageCollected<TouchList>(context, static_cast<NativeTouchList*>(native_touch_event->changedTouches));
+  target_touches_ =
+      MakeGarbageCollected<TouchList>(context, static_cast<NativeTouchList*>(native_touch_event->targetTouches));
+  touches_ = MakeGarbageCollected<TouchList>(context, static_cast<NativeTouchList*>(native_touch_event->touches));
+#endif
+}
+
 }  // namespace webf
@@ -12,6 +12,7 @@ interface TouchEvent extends UIEvent {
     readonly metaKey: boolean;
     readonly ctrlKey: boolean;
     readonly shiftKey: boolean;
+    getCoalescedEvents(): TouchEvent[];
     [key: string]: any;
     new(type: string, init?: TouchEventInit): TouchEvent;
 }
\ No newline at end of file
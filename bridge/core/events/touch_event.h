@@ -42,10 +42,15 @@ class TouchEvent : public UIEvent {
   TouchList* changedTouches() const;
   TouchList* targetTouches() const;
   TouchList* touches() const;
+  std::vector<TouchEvent*> getCoalescedEvents(ExceptionState& exception_state);
+
+  // The move samples dart merged into this event, in the order they were produced.
+  void SetCoalescedEvents(std::vector<Member<TouchEvent>>&& coalesced_events);
 
   void Trace(GCVisitor* visitor) const override;
 
   bool IsTouchEvent() const override;
+  void ResetWithNativeEvent(NativeEvent* native_event) override;
 
  private:
   bool alt_key_;
@@ -55,6 +60,12 @@ class TouchEvent : public UIEvent {
   Member<TouchList> changed_touches_;
   Member<TouchList> target_touches_;
   Member<TouchList> touches_;
+  std::vector<Member<TouchEvent>> coalesced_events_;
+};
+
+template <>
+struct DowncastTraits<TouchEvent> {
+  static bool AllowFrom(const Event& event) { return event.IsTouchEvent(); }
 };
 
 }  // namespace webf
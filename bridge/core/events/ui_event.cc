@@ -77,6 +77,18 @@ bool UIEvent::IsUiEvent() const {
   return true;
 }
 
+void UIEvent::ResetWithNativeEvent(NativeEvent* native_event) {
+  Event::ResetWithNativeEvent(native_event);
+  auto* native_ui_event = reinterpret_cast<NativeUIEvent*>(native_event);
+  detail_ = native_ui_event->detail;
+#if ANDROID_32_BIT
+  view_ = DynamicTo<Window>(BindingObject::From(reinterpret_cast<NativeBindingObject*>(native_ui_event->view)));
+#else
+  view_ = DynamicTo<Window>(BindingObject::From(static_cast<NativeBindingObject*>(native_ui_event->view)));
+#endif
+  which_ = native_ui_event->which;
+}
+
 void UIEvent::Trace(GCVisitor* visitor) const {
   visitor->TraceMember(view_);
   Event::Trace(visitor);
@@ -56,6 +56,7 @@ class UIEvent : public Event {
   double which() const;
 
   bool IsUiEvent() const override;
+  void ResetWithNativeEvent(NativeEvent* native_event) override;
 
   void Trace(GCVisitor* visitor) const override;
 
@@ -4,13 +4,18 @@
  */
 #include "executing_context.h"
 
+#include <fstream>
+#include <iterator>
 #include <utility>
+#include "bindings/qjs/bytecode_bundle.h"
 #include "bindings/qjs/converter_impl.h"
+#include "bindings/qjs/shared_bytecode.h"
 #include "built_in_string.h"
 #include "core/dom/document.h"
 #include "core/dom/mutation_observer.h"
 #include "core/events/error_event.h"
 #include "core/events/promise_rejection_event.h"
+#include "core/storage/storage_area.h"
 #include "event_type_names.h"
 #include "foundation/logging.h"
 #include "polyfill.h"
@@ -60,6 +65,8 @@ ExecutingContext::ExecutingContext(DartIsolateContext* dart_isolate_context,
   // Turn off quickjs GC to avoid performance issue at loading status.
   // When the `load` event fired in window, the GC will turn on.
   JS_TurnOffGC(script_state_.runtime());
+  dart_isolate_context->gcScheduler()->SetProfiler(dart_isolate_context->profiler());
+  dart_isolate_context->gcScheduler()->AddPage(&page_memory_);
   JS_SetContextOpaque(ctx, this);
   JS_SetHostPromiseRejectionTracker(script_state_.runtime(), promiseRejectTracker, nullptr);
 
@@ -94,8 +101,9 @@ ExecutingContext::ExecutingContext(DartIsolateContext* dart_isolate_context,
   dart_isolate_context->profiler()->FinishTrackSteps();
   dart_isolate_context->profiler()->StartTrackSteps("ExecutingContext::InitializePlugin");
 
+  plugin_generation_ = plugin_generation;
   for (auto& p : plugin_byte_code) {
-    EvaluateByteCode(p.second.bytes, p.second.length);
+    EvaluateSharedByteCode(p.second.bytes, p.second.length);
   }
 
   for (auto& p : plugin_string_code) {
@@ -110,6 +118,9 @@ ExecutingContext::ExecutingContext(DartIsolateContext* dart_isolate_context,
 ExecutingContext::~ExecutingContext() {
   is_context_valid_ = false;
   valid_contexts[context_id_] = false;
+  dart_isolate_context_->gcScheduler()->SetPageMemoryBudget(context_id_, 0);
+  dart_isolate_context_->gcScheduler()->RemovePage(&page_memory_);
+  dart_isolate_context_->microtaskQueue()->RemoveTasks(this);
 
   // Check if current context have unhandled exceptions.
   JSValue exception = JS_GetException(script_state_.ctx());
@@ -143,7 +154,11 @@ bool ExecutingContext::EvaluateJavaScript(const char* code,
   dart_isolate_context_->profiler()->StartTrackSteps("ExecutingContext::EvaluateJavaScript");
 
   JSValue result;
-  if (parsed_bytecodes == nullptr) {
+  std::shared_ptr<BytecodeCache> bytecode_cache =
+      code_len >= BytecodeCache::kMinSourceLength ? BytecodeCache::Current() : nullptr;
+  if (parsed_bytecodes == nullptr && bytecode_cache != nullptr) {
+    result = EvaluateWithBytecodeCache(bytecode_cache.get(), code, code_len, sourceURL);
+  } else if (parsed_bytecodes == nullptr) {
     dart_isolate_context_->profiler()->StartTrackSteps("JS_Eval");
 
     result = JS_Eval(script_state_.ctx(), code, code_len, sourceURL, JS_EVAL_TYPE_GLOBAL);
@@ -185,8 +200,56 @@ bool ExecutingContext::EvaluateJavaScript(const char* code,
   return success;
 }
 
+JSValue ExecutingContext::EvaluateWithBytecodeCache(BytecodeCache* cache,
+                                                    const char* code,
+                                                    size_t code_len,
+                                                    const char* sourceURL) {
+  BytecodeCache::Key key = BytecodeCache::ComputeKey(code, code_len, sourceURL);
+
+  dart_isolate_context_->profiler()->StartTrackSteps("BytecodeCache::Lookup");
+  std::unique_ptr<BytecodeCache::Entry> entry = cache->Lookup(key);
+  dart_isolate_context_->profiler()->FinishTrackSteps();
+
+  if (entry != nullptr) {
+    dart_isolate_context_->profiler()->StartTrackSteps("JS_ReadObject");
+    JSValue function = JS_ReadObject(script_state_.ctx(), entry->data(), entry->size(), JS_READ_OBJ_BYTECODE);
+    dart_isolate_context_->profiler()->FinishTrackSteps();
+
+    if (!JS_IsException(function)) {
+      dart_isolate_context_->profiler()->StartTrackSteps("JS_EvalFunction");
+      JSValue result = JS_EvalFunction(script_state_.ctx(), function);
+      dart_isolate_context_->profiler()->FinishTrackSteps();
+      return result;
+    }
+
+    // The bytecode can't be loaded by this engine, compile the source again.
+    JS_FreeValue(script_state_.ctx(), JS_GetException(script_state_.ctx()));
+    cache->Remove(key);
+  }
+
+  dart_isolate_context_->profiler()->StartTrackSteps("JS_Eval");
+  JSValue function =
+      JS_Eval(script_state_.ctx(), code, code_len, sourceURL, JS_EVAL_TYPE_GLOBAL | JS_EVAL_FLAG_COMPILE_ONLY);
+  dart_isolate_context_->profiler()->FinishTrackSteps();
+
+  if (JS_IsException(function))
+    return function;
+
+  size_t bytecode_len;
+  uint8_t* bytecode = JS_WriteObject(script_state_.ctx(), &bytecode_len, function, JS_WRITE_OBJ_BYTECODE);
+  if (bytecode != nullptr) {
+    cache->Store(key, bytecode, bytecode_len);
+    js_free(script_state_.ctx(), bytecode);
+  }
+
+  dart_isolate_context_->profiler()->StartTrackSteps("JS_EvalFunction");
+  JSValue result = JS_EvalFunction(script_state_.ctx(), function);
+  dart_isolate_context_->profiler()->FinishTrackSteps();
+  return result;
+}
+
 bool ExecutingContext::EvaluateJavaScript(const char16_t* code, size_t length, const char* sourceURL, int startLine) {
-  std::string utf8Code = toUTF8(std::u16string(reinterpret_cast<const char16_t*>(code), length));
+  std::string utf8Code = UTF16ToUTF8String(reinterpret_cast<const uint16_t*>(code), length);
   JSValue result = JS_Eval(script_state_.ctx(), utf8Code.c_str(), utf8Code.size(), sourceURL, JS_EVAL_TYPE_GLOBAL);
   DrainMicrotasks();
   bool success = HandleException(&result);
@@ -203,34 +266,97 @@ bool ExecutingContext::EvaluateJavaScript(const char* code, size_t codeLength, c
 }
 
 bool ExecutingContext::EvaluateByteCode(uint8_t* bytes, size_t byteLength) {
+  if (BytecodeBundle::IsBundle(bytes, byteLength)) {
+    return EvaluateByteCodeBundle(BytecodeBundle::FromBytes(bytes, byteLength));
+  }
+
   dart_isolate_context_->profiler()->StartTrackSteps("ExecutingContext::EvaluateByteCode");
 
-  JSValue obj, val;
+  dart_isolate_context_->profiler()->StartTrackSteps("JS_ReadObject");
 
-  dart_isolate_context_->profiler()->StartTrackSteps("JS_EvalFunction");
+  JSValue obj = JS_ReadObject(script_state_.ctx(), bytes, byteLength, JS_READ_OBJ_BYTECODE);
 
-  obj = JS_ReadObject(script_state_.ctx(), bytes, byteLength, JS_READ_OBJ_BYTECODE);
+  dart_isolate_context_->profiler()->FinishTrackSteps();
 
+  bool success = EvaluateFunctionObject(obj);
   dart_isolate_context_->profiler()->FinishTrackSteps();
+  return success;
+}
+
+bool ExecutingContext::EvaluateByteCodeFile(const std::string& path) {
+  if (auto bundle = BytecodeBundle::Open(path))
+    return EvaluateByteCodeBundle(bundle);
+
+  // The bytecode of a single script is read at once.
+  std::ifstream file(path, std::ios::binary);
+  std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  return EvaluateByteCode(bytes.data(), bytes.size());
+}
+
+bool ExecutingContext::EvaluateSharedByteCode(const uint8_t* bytes, size_t byteLength) {
+  dart_isolate_context_->profiler()->StartTrackSteps("ExecutingContext::EvaluateSharedByteCode");
+
+  dart_isolate_context_->profiler()->StartTrackSteps("SharedByteCode::Instantiate");
+
+  JSValue obj = SharedByteCode::Instantiate(script_state_.ctx(), bytes, byteLength);
+
+  dart_isolate_context_->profiler()->FinishTrackSteps();
+
+  bool success = EvaluateFunctionObject(obj);
+  dart_isolate_context_->profiler()->FinishTrackSteps();
+  return success;
+}
+
+bool ExecutingContext::EvaluateByteCodeBundle(const std::shared_ptr<BytecodeBundle>& bundle) {
+  JSContext* ctx = script_state_.ctx();
+  if (bundle == nullptr) {
+    JSValue exception = JS_ThrowTypeError(ctx, "invalid bytecode bundle");
+    return EvaluateFunctionObject(exception);
+  }
+
+  dart_isolate_context_->profiler()->StartTrackSteps("ExecutingContext::EvaluateByteCodeBundle");
+
+  bool success = true;
+  for (auto& module : bundle->modules()) {
+    if (!(module.flags & BytecodeBundle::kEntry))
+      continue;
+
+    dart_isolate_context_->profiler()->StartTrackSteps("BytecodeBundle::Read");
+
+    JSValue obj = bundle->Read(ctx, module);
+    if ((module.flags & BytecodeBundle::kModule) && !JS_IsException(obj) && JS_ResolveModule(ctx, obj) < 0) {
+      JS_FreeValue(ctx, obj);
+      obj = JS_EXCEPTION;
+    }
 
-  if (!HandleException(&obj)) {
     dart_isolate_context_->profiler()->FinishTrackSteps();
+
+    if (!EvaluateFunctionObject(obj)) {
+      success = false;
+      break;
+    }
+  }
+
+  dart_isolate_context_->profiler()->FinishTrackSteps();
+  return success;
+}
+
+bool ExecutingContext::EvaluateFunctionObject(JSValue obj) {
+  if (!HandleException(&obj)) {
     return false;
   }
 
   dart_isolate_context_->profiler()->StartTrackSteps("JS_EvalFunction");
 
-  val = JS_EvalFunction(script_state_.ctx(), obj);
+  JSValue val = JS_EvalFunction(script_state_.ctx(), obj);
 
   dart_isolate_context_->profiler()->FinishTrackSteps();
 
   DrainMicrotasks();
   if (!HandleException(&val)) {
-    dart_isolate_context_->profiler()->FinishTrackSteps();
     return false;
   }
   JS_FreeValue(script_state_.ctx(), val);
-  dart_isolate_context_->profiler()->FinishTrackSteps();
   return true;
 }
 
@@ -253,6 +379,11 @@ void* ExecutingContext::owner() {
 bool ExecutingContext::HandleException(JSValue* exc) {
   if (JS_IsException(*exc)) {
     JSValue error = JS_GetException(script_state_.ctx());
+    // The scripts of the page were terminated, no error handler may run.
+    if (page_memory_.terminated()) {
+      JS_FreeValue(script_state_.ctx(), error);
+      return false;
+    }
     MemberMutationScope scope{this};
     DispatchGlobalErrorEvent(this, error);
     JS_FreeValue(script_state_.ctx(), error);
@@ -270,7 +401,9 @@ bool ExecutingContext::HandleException(ScriptValue* exc) {
 bool ExecutingContext::HandleException(ExceptionState& exception_state) {
   if (exception_state.HasException()) {
     JSValue error = JS_GetException(ctx());
-    ReportError(error);
+    if (!page_memory_.terminated()) {
+      ReportError(error);
+    }
     JS_FreeValue(ctx(), error);
     return false;
   }
@@ -325,62 +458,41 @@ void ExecutingContext::ReportError(JSValueConst error) {
 void ExecutingContext::DrainMicrotasks() {
   dart_isolate_context_->profiler()->StartTrackSteps("ExecutingContext::DrainMicrotasks");
 
+  page_memory_.DispatchPendingEvents();
   DrainPendingPromiseJobs();
+  // Callbacks invoked synchronously by the batched module calls may queue new jobs and module calls.
+  while (module_calls_.Flush()) {
+    DrainPendingPromiseJobs();
+  }
 
   dart_isolate_context_->profiler()->FinishTrackSteps();
 
   ui_command_buffer_.AddCommand(UICommand::kFinishRecordingCommand, nullptr, nullptr, nullptr);
 }
 
-namespace {
-
-struct MicroTaskDeliver {
-  MicrotaskCallback callback;
-  void* data;
-};
-
-}  // namespace
-
 void ExecutingContext::EnqueueMicrotask(MicrotaskCallback callback, void* data) {
-  JSValue proxy_data = JS_NewObject(ctx());
-
-  auto* deliver = new MicroTaskDeliver();
-  deliver->data = data;
-  deliver->callback = callback;
-
-  JS_SetOpaque(proxy_data, deliver);
-
-  JS_EnqueueJob(
-      ctx(),
-      [](JSContext* ctx, int argc, JSValueConst* argv) -> JSValue {
-        auto* deliver = static_cast<MicroTaskDeliver*>(JS_GetOpaque(argv[0], JS_CLASS_OBJECT));
-        deliver->callback(deliver->data);
-
-        delete deliver;
-        return JS_NULL;
-      },
-      1, &proxy_data);
-
-  JS_FreeValue(ctx(), proxy_data);
+  dart_isolate_context_->microtaskQueue()->Enqueue(this, callback, data);
 }
 
 void ExecutingContext::DrainPendingPromiseJobs() {
   // should executing pending promise jobs.
   JSContext* pctx;
+  MicrotaskQueue* microtasks = dart_isolate_context_->microtaskQueue();
 
-  dart_isolate_context_->profiler()->StartTrackSteps("JS_ExecutePendingJob");
+  while (true) {
+    // Native microtasks run in between the jobs of QuickJS, in the order they were enqueued.
+    microtasks->RunDueTasks();
 
-  int finished = JS_ExecutePendingJob(script_state_.runtime(), &pctx);
-
-  dart_isolate_context_->profiler()->FinishTrackSteps();
-
-  while (finished != 0) {
     dart_isolate_context_->profiler()->StartTrackSteps("JS_ExecutePendingJob");
-    finished = JS_ExecutePendingJob(script_state_.runtime(), &pctx);
+    int finished = JS_ExecutePendingJob(script_state_.runtime(), &pctx);
     dart_isolate_context_->profiler()->FinishTrackSteps();
+
     if (finished == -1) {
       break;
     }
+    if (finished == 0 && microtasks->empty()) {
+      break;
+    }
   }
 
   // Throw error when promise are not handled.
@@ -489,6 +601,19 @@ void ExecutingContext::FlushUICommand(const webf::BindingObject* self,
 
     dartMethodPtr()->flushUICommand(is_dedicated_, context_id_, self->bindingObject());
   }
+
+  // Dart receives the queued module calls after the UI commands recorded before them.
+  module_calls_.Flush();
+}
+
+void ExecutingContext::SetLocalStorageDirectory(
+    const std::string& directory,
+    const std::vector<std::pair<std::string, std::string>>& legacy_entries) {
+  local_storage_directory_ = directory;
+  if (!legacy_entries.empty()) {
+    StorageArea::Open(directory)->Merge(legacy_entries, false);
+  }
+  window_->DidSetLocalStorageDirectory(directory);
 }
 
 void ExecutingContext::TurnOnJavaScriptGC() {
@@ -540,6 +665,7 @@ void ExecutingContext::DispatchGlobalRejectionHandledEvent(ExecutingContext* con
 
 std::unordered_map<std::string, NativeByteCode> ExecutingContext::plugin_byte_code{};
 std::unordered_map<std::string, std::string> ExecutingContext::plugin_string_code{};
+std::atomic<uint32_t> ExecutingContext::plugin_generation{0};
 
 void ExecutingContext::promiseRejectTracker(JSContext* ctx,
                                             JSValue promise,
@@ -570,6 +696,18 @@ ModuleContextCoordinator* ExecutingContext::ModuleContexts() {
   return &module_contexts_;
 }
 
+ModuleCallBatch* ExecutingContext::ModuleCalls() {
+  return &module_calls_;
+}
+
+WidgetElementShapeCache* ExecutingContext::WidgetElementShapes() {
+  return &widget_element_shapes_;
+}
+
+EventPool* ExecutingContext::Events() {
+  return &event_pool_;
+}
+
 void ExecutingContext::SetMutationScope(MemberMutationScope& mutation_scope) {
   // MemberMutationScope may be called by other MemberMutationScope in the call stack.
   // Should save the tree corresponding to the call stack.
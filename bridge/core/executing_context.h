@@ -18,6 +18,7 @@
 #include <unordered_map>
 #include <vector>
 #include "bindings/qjs/binding_initializer.h"
+#include "bindings/qjs/bytecode_cache.h"
 #include "bindings/qjs/rejected_promises.h"
 #include "bindings/qjs/script_value.h"
 #include "foundation/macros.h"
@@ -25,10 +26,14 @@
 
 #include "dart_isolate_context.h"
 #include "dart_methods.h"
+#include "dom/events/event_pool.h"
 #include "executing_context_data.h"
 #include "frame/dom_timer_coordinator.h"
+#include "frame/module_call_batch.h"
 #include "frame/module_context_coordinator.h"
 #include "frame/module_listener_container.h"
+#include "html/custom/widget_element_shape.h"
+#include "page_memory.h"
 #include "script_state.h"
 
 #include "shared_ui_command.h"
@@ -49,11 +54,11 @@ class ErrorEvent;
 class DartContext;
 class MutationObserver;
 class BindingObject;
+class BytecodeBundle;
 struct NativeBindingObject;
 class ScriptWrappable;
 
 using JSExceptionHandler = std::function<void(ExecutingContext* context, const char* message)>;
-using MicrotaskCallback = void (*)(void* data);
 
 bool isContextValid(double contextId);
 
@@ -81,7 +86,15 @@ class ExecutingContext {
                           int startLine);
   bool EvaluateJavaScript(const char16_t* code, size_t length, const char* sourceURL, int startLine);
   bool EvaluateJavaScript(const char* code, size_t codeLength, const char* sourceURL, int startLine);
+  // |bytes| is the bytecode of a script or a bundle written by webf_bytecode_compiler.
   bool EvaluateByteCode(uint8_t* bytes, size_t byteLength);
+  // Same as EvaluateByteCode() for the bytecode in the file at |path|. A bundle is mapped into memory instead of being
+  // copied, so that the functions read later on are read from the file.
+  bool EvaluateByteCodeFile(const std::string& path);
+  // For the bytecode of the polyfill and plugins, which is deserialized once and shared by all the contexts.
+  bool EvaluateSharedByteCode(const uint8_t* bytes, size_t byteLength);
+  // Evaluates the script with the bytecode cached for it, the source is compiled and cached on a miss.
+  JSValue EvaluateWithBytecodeCache(BytecodeCache* cache, const char* code, size_t code_len, const char* sourceURL);
   bool IsContextValid() const;
   void SetContextInValid();
   bool IsCtxValid() const;
@@ -119,6 +132,15 @@ class ExecutingContext {
   // Gets the ModuleCallbacks which from the 4th parameter of `webf.invokeModule` function.
   ModuleContextCoordinator* ModuleContexts();
 
+  // Gets the module calls which are waiting to be sent to dart at the end of current task.
+  ModuleCallBatch* ModuleCalls();
+
+  // Gets the shapes of the WidgetElements created in this context.
+  WidgetElementShapeCache* WidgetElementShapes();
+
+  // Gets the EventPool which recycles the high frequency events dispatched from dart.
+  EventPool* Events();
+
   // Get current script state.
   ScriptState* GetScriptState() { return &script_state_; }
 
@@ -132,12 +154,21 @@ class ExecutingContext {
   FORCE_INLINE DartIsolateContext* dartIsolateContext() const { return dart_isolate_context_; };
   FORCE_INLINE Performance* performance() const { return performance_; }
   FORCE_INLINE SharedUICommand* uiCommandBuffer() { return &ui_command_buffer_; };
+  FORCE_INLINE PageMemory* pageMemory() { return &page_memory_; };
   FORCE_INLINE DartMethodPointer* dartMethodPtr() const {
     assert(dart_isolate_context_->valid());
     return dart_isolate_context_->dartMethodPtr();
   }
   FORCE_INLINE bool isDedicated() { return is_dedicated_; }
   FORCE_INLINE std::chrono::time_point<std::chrono::system_clock> timeOrigin() const { return time_origin_; }
+  void ResetTimeOrigin() { time_origin_ = std::chrono::system_clock::now(); }
+
+  // The directory keeping localStorage of the page's origin, provided by dart once the storage module is ready.
+  // |legacy_entries| are the items saved by the dart implementation of localStorage, they are merged into the native
+  // storage the first time the directory is used.
+  void SetLocalStorageDirectory(const std::string& directory,
+                                const std::vector<std::pair<std::string, std::string>>& legacy_entries);
+  const std::string& LocalStorageDirectory() const { return local_storage_directory_; }
 
   // Force dart side to execute the pending ui commands.
   void FlushUICommand(const BindingObject* self, uint32_t reason);
@@ -160,13 +191,21 @@ class ExecutingContext {
   static std::unordered_map<std::string, NativeByteCode> plugin_byte_code;
   // Raw string codes which registered by webf plugins.
   static std::unordered_map<std::string, std::string> plugin_string_code;
+  // Bumped by every plugin registration, a context with an older generation misses some plugins.
+  static std::atomic<uint32_t> plugin_generation;
+  FORCE_INLINE uint32_t pluginGeneration() const { return plugin_generation_; }
 
  private:
   std::chrono::time_point<std::chrono::system_clock> time_origin_;
   int32_t unique_id_;
+  std::string local_storage_directory_;
 
   void InstallDocument();
   void InstallPerformance();
+  // Evaluates the entry modules of |bundle|, the other modules are read when they are imported.
+  bool EvaluateByteCodeBundle(const std::shared_ptr<BytecodeBundle>& bundle);
+  // Evaluates a function bytecode object returned by JS_ReadObject, consumes |obj|.
+  bool EvaluateFunctionObject(JSValue obj);
 
   void DrainPendingPromiseJobs();
   void EnsureEnqueueMicrotask();
@@ -181,6 +220,8 @@ class ExecutingContext {
   // Members first initialized and destructed at the last.
   // Keep uiCommandBuffer below dartMethod ptr to make sure we can flush all disposeEventTarget when UICommandBuffer
   // release.
+  // Keep pageMemory above uiCommandBuffer, the command buffers report their memory to it until they are freed.
+  PageMemory page_memory_{this};
   SharedUICommand ui_command_buffer_{this};
   DartIsolateContext* dart_isolate_context_{nullptr};
   // Keep uiCommandBuffer above ScriptState to make sure we can collect all disposedEventTarget command when free
@@ -204,12 +245,16 @@ class ExecutingContext {
   DOMTimerCoordinator timers_;
   ModuleListenerContainer module_listener_container_;
   ModuleContextCoordinator module_contexts_;
+  ModuleCallBatch module_calls_{this};
+  WidgetElementShapeCache widget_element_shapes_;
   ExecutionContextData context_data_{this};
+  EventPool event_pool_{this};
   bool in_dispatch_error_event_{false};
   RejectedPromises rejected_promises_;
   MemberMutationScope* active_mutation_scope{nullptr};
   std::unordered_set<ScriptWrappable*> active_wrappers_;
   bool is_dedicated_;
+  uint32_t plugin_generation_{0};
 };
 
 class ObjectProperty {
@@ -61,10 +61,9 @@ JSValue ExecutionContextData::constructorForIdSlowCase(const WrapperTypeInfo* ty
   JS_DefinePropertyValue(ctx, prototypeObject, JS_ATOM_Symbol_toStringTag, JS_NewString(ctx, type->className),
                          JS_PROP_NORMAL);
 
-  // Inherit to parentClass.
+  // Inherit to parentClass, which is created first when it's not used yet.
   if (type->parent_class != nullptr) {
-    assert(prototype_map_.count(type->parent_class) > 0);
-    JS_SetPrototype(m_context->ctx(), prototypeObject, prototype_map_[type->parent_class]);
+    JS_SetPrototype(m_context->ctx(), prototypeObject, prototypeForType(type->parent_class));
   }
 
   // Configure to be called as a constructor.
@@ -73,6 +72,11 @@ JSValue ExecutionContextData::constructorForIdSlowCase(const WrapperTypeInfo* ty
   // Store WrapperTypeInfo as private data.
   JS_SetOpaque(classObject, (void*)type);
 
+  // Classes are created on first use, so are their methods and attributes.
+  if (type->install_members_handler_ != nullptr) {
+    type->install_members_handler_(m_context);
+  }
+
   return classObject;
 }
 
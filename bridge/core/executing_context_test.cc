@@ -3,6 +3,8 @@
  * Copyright (C) 2022-present The WebF authors. All rights reserved.
  */
 
+#include <cstdio>
+#include "bindings/qjs/bytecode_bundle.h"
 #include "gtest/gtest.h"
 #include "include/webf_bridge.h"
 #include "page.h"
@@ -343,15 +345,138 @@ TEST(Context, evaluateByteCode) {
   EXPECT_EQ(logCalled, true);
 }
 
+TEST(Context, evaluateByteCodeFile) {
+  static bool errorHandlerExecuted = false;
+  static bool logCalled = false;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logCalled = true;
+    EXPECT_STREQ(message.c_str(), "from the bundle file");
+  };
+
+  auto errorHandler = [](double contextId, const char* errmsg) { errorHandlerExecuted = true; };
+  auto env = TEST_init(errorHandler);
+  JSContext* ctx = env->page()->executingContext()->ctx();
+  const char* code = "console.log('from the bundle file');";
+  JSValue function = JS_Eval(ctx, code, strlen(code), "main.js", JS_EVAL_TYPE_GLOBAL | JS_EVAL_FLAG_COMPILE_ONLY);
+  std::string bundle;
+  {
+    BytecodeBundleWriter writer(ctx);
+    writer.Add("main.js", BytecodeBundle::kEntry, function);
+    bundle = writer.Finish();
+  }
+  JS_FreeValue(ctx, function);
+  std::string path = testing::TempDir() + "evaluate_byte_code_file.wbn";
+  FILE* file = fopen(path.c_str(), "wb");
+  ASSERT_NE(file, nullptr);
+  fwrite(bundle.data(), 1, bundle.size(), file);
+  fclose(file);
+
+  EXPECT_TRUE(env->page()->evaluateByteCodeFile(path.c_str()));
+  EXPECT_EQ(errorHandlerExecuted, false);
+  EXPECT_EQ(logCalled, true);
+  remove(path.c_str());
+}
+
 TEST(jsValueToNativeString, utf8String) {
   auto env = TEST_init([](double contextId, const char* errmsg) {});
   JSValue str = JS_NewString(env->page()->executingContext()->ctx(), "helloworld");
   std::unique_ptr<webf::SharedNativeString> nativeString =
       webf::jsValueToNativeString(env->page()->executingContext()->ctx(), str);
   EXPECT_EQ(nativeString->length(), 10);
+  EXPECT_TRUE(nativeString->Is8Bit());
   uint8_t expectedString[10] = {104, 101, 108, 108, 111, 119, 111, 114, 108, 100};
   for (int i = 0; i < 10; i++) {
-    EXPECT_EQ(expectedString[i], *(nativeString->string() + i));
+    EXPECT_EQ(expectedString[i], *(nativeString->characters8() + i));
   }
   JS_FreeValue(env->page()->executingContext()->ctx(), str);
 }
+
+TEST(jsValueToNativeString, wideString) {
+  auto env = TEST_init([](double contextId, const char* errmsg) {});
+  JSContext* ctx = env->page()->executingContext()->ctx();
+  uint16_t source[3] = {0x4f60, 0x597d, 'a'};
+  JSValue str = JS_NewUnicodeString(ctx, source, 3);
+  std::unique_ptr<webf::SharedNativeString> nativeString = webf::jsValueToNativeString(ctx, str);
+  EXPECT_EQ(nativeString->length(), 3);
+  EXPECT_FALSE(nativeString->Is8Bit());
+  for (int i = 0; i < 3; i++) {
+    EXPECT_EQ(source[i], *(nativeString->string() + i));
+  }
+  JS_FreeValue(ctx, str);
+}
+
+TEST(nativeStringToJSValue, latin1RoundTrip) {
+  auto env = TEST_init([](double contextId, const char* errmsg) {});
+  JSContext* ctx = env->page()->executingContext()->ctx();
+  // "café" in Latin-1.
+  JSValue str = JS_NewString(ctx, "caf\xc3\xa9");
+  std::unique_ptr<webf::SharedNativeString> nativeString = webf::jsValueToNativeString(ctx, str);
+  EXPECT_TRUE(nativeString->Is8Bit());
+  EXPECT_EQ(nativeString->length(), 4);
+  EXPECT_EQ(webf::nativeStringToStdString(nativeString.get()), "caf\xc3\xa9");
+  JSValue result = webf::nativeStringToJSValue(ctx, nativeString.get());
+  const char* buffer = JS_ToCString(ctx, result);
+  EXPECT_STREQ(buffer, "caf\xc3\xa9");
+  JS_FreeCString(ctx, buffer);
+  JS_FreeValue(ctx, result);
+  JS_FreeValue(ctx, str);
+}
+
+TEST(Context, lazyConstructors) {
+  static bool errorHandlerExecuted = false;
+  static bool logCalled = false;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logCalled = true;
+    EXPECT_STREQ(message.c_str(), "true true true function true");
+  };
+
+  auto errorHandler = [](double contextId, const char* errmsg) {
+    errorHandlerExecuted = true;
+    WEBF_LOG(VERBOSE) << errmsg;
+  };
+  auto env = TEST_init(errorHandler);
+  // The prototype of the element is created before the constructor is read.
+  const char* code =
+      "const div = document.createElement('div');"
+      "console.log(Object.getPrototypeOf(div) === HTMLDivElement.prototype, div instanceof HTMLElement, "
+      "'SVGElement' in window, typeof Image, typeof HTMLCanvasElement.prototype.getContext === 'function')";
+  env->page()->evaluateScript(code, strlen(code), "file://", 0);
+  EXPECT_EQ(errorHandlerExecuted, false);
+  EXPECT_EQ(logCalled, true);
+}
+
+TEST(Context, microtaskOrdering) {
+  auto env = TEST_init();
+  auto* context = env->page()->executingContext();
+  auto eval = [](ExecutingContext* context, const char* code) {
+    JSValue result = JS_Eval(context->ctx(), code, strlen(code), "vm://", JS_EVAL_TYPE_GLOBAL);
+    EXPECT_FALSE(JS_IsException(result));
+    return result;
+  };
+
+  // Promise jobs and native microtasks share a single FIFO queue, including the ones they enqueue themselves.
+  JS_FreeValue(context->ctx(), eval(context, "globalThis.order = []; Promise.resolve().then(() => order.push('p1'));"));
+  context->EnqueueMicrotask(
+      [](void* data) {
+        auto* context = static_cast<ExecutingContext*>(data);
+        const char* code = "order.push('n1'); Promise.resolve().then(() => order.push('p2'));";
+        JS_FreeValue(context->ctx(), JS_Eval(context->ctx(), code, strlen(code), "vm://", JS_EVAL_TYPE_GLOBAL));
+        context->EnqueueMicrotask(
+            [](void* data) {
+              auto* context = static_cast<ExecutingContext*>(data);
+              const char* code = "order.push('n2');";
+              JS_FreeValue(context->ctx(), JS_Eval(context->ctx(), code, strlen(code), "vm://", JS_EVAL_TYPE_GLOBAL));
+            },
+            context);
+      },
+      context);
+  JS_FreeValue(context->ctx(), eval(context, "Promise.resolve().then(() => order.push('p3'));"));
+  context->DrainMicrotasks();
+
+  JSValue order = eval(context, "order.join(',')");
+  const char* chars = JS_ToCString(context->ctx(), order);
+  EXPECT_STREQ(chars, "p1,n1,p3,p2,n2");
+  JS_FreeCString(context->ctx(), chars);
+  JS_FreeValue(context->ctx(), order);
+  EXPECT_TRUE(context->dartIsolateContext()->microtaskQueue()->empty());
+}
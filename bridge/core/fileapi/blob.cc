@@ -69,6 +69,12 @@ Blob* Blob::Create(ExecutingContext* context,
   return MakeGarbageCollected<Blob>(context->ctx(), data, property);
 }
 
+Blob::~Blob() {
+  if (isContextValid(contextId())) {
+    GetExecutingContext()->pageMemory()->Freed(PageMemory::kBlobs, accounted_bytes_);
+  }
+}
+
 int32_t Blob::size() {
   return _data.size();
 }
@@ -94,6 +100,7 @@ Blob* Blob::slice(int64_t start, int64_t end, const AtomicString& content_type,
   newData.reserve(_data.size() - (end - start));
   newData.insert(newData.begin(), _data.begin() + start, _data.end() - (_data.size() - end));
   newBlob->_data = newData;
+  newBlob->DidChangeData();
   newBlob->mime_type_ = content_type != built_in_string::kempty_string ? content_type.ToStdString(ctx()) : mime_type_;
   return newBlob;
 }
@@ -170,6 +177,7 @@ void Blob::AppendText(const std::string& string) {
   std::vector<uint8_t> strArr(string.begin(), string.end());
   _data.reserve(_data.size() + strArr.size());
   _data.insert(_data.end(), strArr.begin(), strArr.end());
+  DidChangeData();
 }
 
 void Blob::AppendBytes(uint8_t* buffer, uint32_t length) {
@@ -177,6 +185,17 @@ void Blob::AppendBytes(uint8_t* buffer, uint32_t length) {
   for (size_t i = 0; i < length; i++) {
     _data.emplace_back(buffer[i]);
   }
+  DidChangeData();
+}
+
+void Blob::DidChangeData() {
+  size_t capacity = _data.capacity();
+  if (capacity > accounted_bytes_) {
+    GetExecutingContext()->pageMemory()->Allocated(PageMemory::kBlobs, capacity - accounted_bytes_);
+  } else if (capacity < accounted_bytes_) {
+    GetExecutingContext()->pageMemory()->Freed(PageMemory::kBlobs, accounted_bytes_ - capacity);
+  }
+  accounted_bytes_ = capacity;
 }
 
 }  // namespace webf
@@ -42,6 +42,7 @@ class Blob : public ScriptWrappable {
       : mime_type_(property->type()), ScriptWrappable(ctx) {
     PopulateBlobData(data);
   };
+  ~Blob() override;
 
   void AppendText(const std::string& string);
   void AppendBytes(uint8_t* buffer, uint32_t length);
@@ -72,8 +73,12 @@ class Blob : public ScriptWrappable {
   void PopulateBlobData(const std::vector<std::shared_ptr<BlobPart>>& data);
 
  private:
+  // Reports the growth of _data to the page.
+  void DidChangeData();
+
   std::string mime_type_;
   std::vector<uint8_t> _data;
+  size_t accounted_bytes_{0};
 };
 
 }  // namespace webf
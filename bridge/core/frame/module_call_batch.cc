@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+#include "module_call_batch.h"
+#include "core/executing_context.h"
+#include "foundation/dart_readable.h"
+#include "foundation/logging.h"
+
+namespace webf {
+
+// Releases the payload of a NativeValue created by ScriptValue::ToNative(), for the params which never reached dart.
+static void ReleaseNativeValue(NativeValue& value) {
+  switch (value.tag) {
+    case NativeTag::TAG_STRING:
+      delete static_cast<AutoFreeNativeString*>(value.u.ptr);
+      break;
+    case NativeTag::TAG_LIST: {
+      auto* values = static_cast<NativeValue*>(value.u.ptr);
+      for (uint32_t i = 0; i < value.uint32; i++) {
+        ReleaseNativeValue(values[i]);
+      }
+      delete[] values;
+      break;
+    }
+    case NativeTag::TAG_STRUCTURED:
+      dart_free(value.u.ptr);
+      break;
+    case NativeTag::TAG_ARRAY_BUFFER:
+      FreeNativeByteBuffer(static_cast<NativeByteBuffer*>(value.u.ptr));
+      break;
+    default:
+      break;
+  }
+}
+
+// Nobody reads the return value of a batched call. Modules return strings or null in most cases.
+static void DiscardResult(NativeValue* result) {
+  if (result == nullptr)
+    return;
+  if (result->tag == NativeTag::TAG_STRING) {
+    delete static_cast<AutoFreeNativeString*>(result->u.ptr);
+  }
+  dart_free(result);
+}
+
+ModuleCallBatch::ModuleCallBatch(ExecutingContext* context) : context_(context), state_(std::make_shared<State>()) {}
+
+ModuleCallBatch::~ModuleCallBatch() {
+  // The tasks already posted to dart check the flag and drop their calls.
+  state_->disposed = true;
+#if ENABLE_LOG
+  if (OutstandingCalls() > 0) {
+    WEBF_LOG(VERBOSE) << "[ModuleCallBatch] " << OutstandingCalls() << " module calls are dropped with the page"
+                      << std::endl;
+  }
+#endif
+  for (auto& call : pending_calls_) {
+    ReleaseCall(call, true);
+  }
+  state_->outstanding_calls -= static_cast<int32_t>(pending_calls_.size());
+}
+
+void ModuleCallBatch::Enqueue(void* callback_context,
+                              int64_t profile_link_id,
+                              std::unique_ptr<SharedNativeString> module_name,
+                              std::unique_ptr<SharedNativeString> method,
+                              NativeValue params,
+                              AsyncModuleCallback callback) {
+  pending_calls_.push_back(
+      {callback_context, profile_link_id, module_name.release(), method.release(), params, callback});
+  state_->outstanding_calls++;
+}
+
+bool ModuleCallBatch::Flush() {
+  if (pending_calls_.empty())
+    return false;
+
+  auto calls = std::make_shared<std::vector<PendingCall>>();
+  calls->swap(pending_calls_);
+  context_->dartIsolateContext()->dispatcher()->PostToDart(context_->isDedicated(), InvokeOnDartThread,
+                                                           context_->dartMethodPtr(), context_->contextId(), state_,
+                                                           calls);
+  return true;
+}
+
+void ModuleCallBatch::InvokeOnDartThread(DartMethodPointer* dart_method_ptr,
+                                         double context_id,
+                                         const std::shared_ptr<State>& state,
+                                         const std::shared_ptr<std::vector<PendingCall>>& calls) {
+  for (auto& call : *calls) {
+    bool disposed = state->disposed;
+    if (!disposed) {
+      NativeValue* result =
+          dart_method_ptr->invokeModuleOnDartThread(call.callback_context, context_id, call.profile_link_id,
+                                                    call.module_name, call.method, &call.params, call.callback);
+      DiscardResult(result);
+    }
+    // Dart takes the params once they are delivered.
+    ReleaseCall(call, disposed);
+    state->outstanding_calls--;
+  }
+}
+
+void ModuleCallBatch::ReleaseCall(PendingCall& call, bool release_params) {
+  delete call.module_name;
+  delete call.method;
+  if (release_params) {
+    ReleaseNativeValue(call.params);
+  }
+}
+
+}  // namespace webf
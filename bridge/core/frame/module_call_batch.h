@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+#ifndef BRIDGE_MODULE_CALL_BATCH_H
+#define BRIDGE_MODULE_CALL_BATCH_H
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "core/dart_methods.h"
+#include "foundation/native_string.h"
+#include "foundation/native_value.h"
+
+namespace webf {
+
+class ExecutingContext;
+
+// ModuleCallBatch queues the calls from `webf.invokeModuleAsync`, which don't return a value. Queued calls are sent to
+// dart in one task when the current task ends, when the UI commands are flushed or before a synchronous
+// `webf.invokeModule` call, instead of blocking the JS thread for every call. Callbacks still receive their results
+// through handleInvokeModuleTransientCallback.
+class ModuleCallBatch {
+ public:
+  explicit ModuleCallBatch(ExecutingContext* context);
+  ~ModuleCallBatch();
+
+  void Enqueue(void* callback_context,
+               int64_t profile_link_id,
+               std::unique_ptr<SharedNativeString> module_name,
+               std::unique_ptr<SharedNativeString> method,
+               NativeValue params,
+               AsyncModuleCallback callback);
+
+  // Sends all the queued calls to dart, returns false when there was nothing to send.
+  bool Flush();
+
+  // Calls which are queued or sent but not yet invoked on the dart side. The calls still outstanding when the page is
+  // disposed are dropped.
+  int32_t OutstandingCalls() const { return state_->outstanding_calls; }
+
+ private:
+  struct PendingCall {
+    void* callback_context;
+    int64_t profile_link_id;
+    SharedNativeString* module_name;
+    SharedNativeString* method;
+    NativeValue params;
+    AsyncModuleCallback callback;
+  };
+
+  // Shared with the tasks posted to dart, which may run after the context is disposed.
+  struct State {
+    std::atomic<bool> disposed{false};
+    std::atomic<int32_t> outstanding_calls{0};
+  };
+
+  static void InvokeOnDartThread(DartMethodPointer* dart_method_ptr,
+                                 double context_id,
+                                 const std::shared_ptr<State>& state,
+                                 const std::shared_ptr<std::vector<PendingCall>>& calls);
+  static void ReleaseCall(PendingCall& call, bool release_params);
+
+  ExecutingContext* context_;
+  std::vector<PendingCall> pending_calls_;
+  std::shared_ptr<State> state_;
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_MODULE_CALL_BATCH_H
@@ -136,16 +136,21 @@ ScriptValue ModuleManager::__webf_invoke_module__(ExecutingContext* context,
                                                   ScriptValue& params_value,
                                                   const std::shared_ptr<QJSFunction>& callback,
                                                   ExceptionState& exception) {
-  NativeValue params = params_value.ToNative(context->ctx(), exception);
+  // The module handlers of dart may encode their params with jsonEncode, which overflows the stack on a cycle.
+  NativeValue params = params_value.ToNative(context->ctx(), exception, false, true);
 
   if (exception.HasException()) {
     return ScriptValue::Empty(context->ctx());
   }
 
-  NativeValue* result;
   auto module_name_string = module_name.ToNativeString(context->ctx());
   auto method_name_string = method.ToNativeString(context->ctx());
 
+  // The calls queued by invokeModuleAsync happened earlier, they must reach dart before this one.
+  context->ModuleCalls()->Flush();
+
+  NativeValue* result;
+
   context->dartIsolateContext()->profiler()->StartTrackLinkSteps("Call To Dart");
 
   if (callback != nullptr) {
@@ -173,6 +178,50 @@ ScriptValue ModuleManager::__webf_invoke_module__(ExecutingContext* context,
   return return_value;
 }
 
+void ModuleManager::__webf_invoke_module_async__(ExecutingContext* context,
+                                                 const AtomicString& module_name,
+                                                 const AtomicString& method,
+                                                 ExceptionState& exception) {
+  ScriptValue empty = ScriptValue::Empty(context->ctx());
+  __webf_invoke_module_async__(context, module_name, method, empty, nullptr, exception);
+}
+
+void ModuleManager::__webf_invoke_module_async__(ExecutingContext* context,
+                                                 const AtomicString& module_name,
+                                                 const AtomicString& method,
+                                                 ScriptValue& params_value,
+                                                 ExceptionState& exception) {
+  __webf_invoke_module_async__(context, module_name, method, params_value, nullptr, exception);
+}
+
+void ModuleManager::__webf_invoke_module_async__(ExecutingContext* context,
+                                                 const AtomicString& module_name,
+                                                 const AtomicString& method,
+                                                 ScriptValue& params_value,
+                                                 const std::shared_ptr<QJSFunction>& callback,
+                                                 ExceptionState& exception) {
+  // Cycles are rejected as in __webf_invoke_module__.
+  NativeValue params = params_value.ToNative(context->ctx(), exception, false, true);
+
+  if (exception.HasException()) {
+    return;
+  }
+
+  // Nobody reads the return value, the call waits in the batch and the result is delivered to the callback.
+  void* callback_context = nullptr;
+  AsyncModuleCallback module_callback = handleInvokeModuleUnexpectedCallback;
+  if (callback != nullptr) {
+    auto module_context = std::make_shared<ModuleContext>(context, ModuleCallback::Create(callback));
+    context->ModuleContexts()->AddModuleContext(module_context);
+    callback_context = module_context.get();
+    module_callback = handleInvokeModuleTransientCallbackWrapper;
+  }
+
+  context->ModuleCalls()->Enqueue(callback_context, context->dartIsolateContext()->profiler()->link_id(),
+                                  module_name.ToNativeString(context->ctx()), method.ToNativeString(context->ctx()),
+                                  params, module_callback);
+}
+
 void ModuleManager::__webf_add_module_listener__(ExecutingContext* context,
                                                  const AtomicString& module_name,
                                                  const std::shared_ptr<QJSFunction>& handler,
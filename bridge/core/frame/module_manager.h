@@ -36,6 +36,21 @@ class ModuleManager {
                                             ScriptValue& params_value,
                                             const std::shared_ptr<QJSFunction>& callback,
                                             ExceptionState& exception);
+  static void __webf_invoke_module_async__(ExecutingContext* context,
+                                           const AtomicString& module_name,
+                                           const AtomicString& method,
+                                           ExceptionState& exception);
+  static void __webf_invoke_module_async__(ExecutingContext* context,
+                                           const AtomicString& module_name,
+                                           const AtomicString& method,
+                                           ScriptValue& params_value,
+                                           ExceptionState& exception);
+  static void __webf_invoke_module_async__(ExecutingContext* context,
+                                           const AtomicString& module_name,
+                                           const AtomicString& method,
+                                           ScriptValue& params_value,
+                                           const std::shared_ptr<QJSFunction>& callback,
+                                           ExceptionState& exception);
   static void __webf_add_module_listener__(ExecutingContext* context,
                                            const AtomicString& module_name,
                                            const std::shared_ptr<QJSFunction>& handler,
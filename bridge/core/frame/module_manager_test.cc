@@ -94,4 +94,31 @@ f();
   EXPECT_EQ(logCalled, true);
 }
 
+TEST(ModuleManager, callsWithCallbackAreSentAtTaskEnd) {
+  bool static logCalled = false;
+  auto env = TEST_init([](double contextId, const char* errmsg) {});
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logCalled = true;
+    EXPECT_STREQ(message.c_str(), "undefined sync,microtask,callback");
+  };
+
+  auto context = env->page()->executingContext();
+
+  std::string code = std::string(R"(
+let order = [];
+let result = webf.invokeModuleAsync('MethodChannel', 'invokeMethod', ['fn', []], (e, data) => {
+  order.push('callback');
+  console.log(result, order.join(','));
+});
+webf.invokeModuleAsync('Navigation', 'goTo', 'about:blank');
+order.push('sync');
+Promise.resolve().then(() => order.push('microtask'));
+)");
+  context->EvaluateJavaScript(code.c_str(), code.size(), "vm://", 0);
+
+  EXPECT_EQ(logCalled, true);
+  EXPECT_EQ(context->ModuleCalls()->Flush(), false);
+  EXPECT_EQ(context->ModuleCalls()->OutstandingCalls(), 0);
+}
+
 }  // namespace webf
@@ -138,6 +138,32 @@ Screen* Window::screen() {
   return screen_;
 }
 
+Storage* Window::localStorage() {
+  if (local_storage_ == nullptr) {
+    // Scripts may run before dart provides the directory, the items are kept in memory until it arrives.
+    const std::string& directory = GetExecutingContext()->LocalStorageDirectory();
+    local_storage_ = MakeGarbageCollected<Storage>(
+        GetExecutingContext(), directory.empty() ? StorageArea::CreateInMemory() : StorageArea::Open(directory));
+  }
+  return local_storage_;
+}
+
+void Window::DidSetLocalStorageDirectory(const std::string& directory) {
+  if (local_storage_ == nullptr || local_storage_->area()->IsPersistent())
+    return;
+  // The items set before take precedence over the persisted ones, items removed before are not tracked.
+  std::shared_ptr<StorageArea> area = StorageArea::Open(directory);
+  area->Merge(local_storage_->area()->Entries(), true);
+  local_storage_->SetArea(std::move(area));
+}
+
+Storage* Window::sessionStorage() {
+  if (session_storage_ == nullptr) {
+    session_storage_ = MakeGarbageCollected<Storage>(GetExecutingContext(), StorageArea::CreateInMemory());
+  }
+  return session_storage_;
+}
+
 void Window::scroll(ExceptionState& exception_state) {
   return scroll(0, 0, exception_state);
 }
@@ -265,8 +291,15 @@ bool Window::IsWindowOrWorkerGlobalScope() const {
   return true;
 }
 
+bool Window::HandlesDartEventWithoutListeners(const StringView& event_type) const {
+  return EqualStringView(event_type, event_type_names::kload.ToStringView()) ||
+         EqualStringView(event_type, event_type_names::kgcopen.ToStringView());
+}
+
 void Window::Trace(GCVisitor* visitor) const {
   visitor->TraceMember(screen_);
+  visitor->TraceMember(local_storage_);
+  visitor->TraceMember(session_storage_);
   EventTargetWithInlineData::Trace(visitor);
 }
 
@@ -2,6 +2,7 @@ import {EventTarget} from "../dom/events/event_target";
 import {ScrollOptions} from "../dom/scroll_options";
 import {ScrollToOptions} from "../dom/scroll_to_options";
 import {Screen} from "./screen";
+import {Storage} from "../storage/storage";
 import {WindowEventHandlers} from "./window_event_handlers";
 import {GlobalEventHandlers} from "../dom/global_event_handlers";
 import {ComputedCssStyleDeclaration} from "../css/computed_css_style_declaration";
@@ -31,6 +32,8 @@ interface Window extends EventTarget, WindowEventHandlers, GlobalEventHandlers {
   readonly parent: Window;
   readonly self: Window;
   readonly screen: Screen;
+  readonly localStorage: Storage;
+  readonly sessionStorage: Storage;
 
   readonly scrollX: DartImpl<DependentsOnLayout<double>>;
   readonly scrollY: DartImpl<DependentsOnLayout<double>>;
@@ -9,6 +9,7 @@
 #include "bindings/qjs/wrapper_type_info.h"
 #include "core/css/computed_css_style_declaration.h"
 #include "core/dom/events/event_target.h"
+#include "core/storage/storage.h"
 #include "qjs_scroll_to_options.h"
 #include "screen.h"
 
@@ -27,6 +28,10 @@ class Window : public EventTargetWithInlineData {
   Window* open(const AtomicString& url, ExceptionState& exception_state);
 
   Screen* screen();
+  Storage* localStorage();
+  Storage* sessionStorage();
+  // Moves localStorage used before the directory was known onto the persisted area.
+  void DidSetLocalStorageDirectory(const std::string& directory);
 
   [[nodiscard]] const Window* window() const { return this; }
   [[nodiscard]] const Window* self() const { return this; }
@@ -58,6 +63,7 @@ class Window : public EventTargetWithInlineData {
 
   void OnLoadEventFired();
   bool IsWindowOrWorkerGlobalScope() const override;
+  bool HandlesDartEventWithoutListeners(const StringView& event_type) const override;
 
   void Trace(GCVisitor* visitor) const override;
 
@@ -66,6 +72,8 @@ class Window : public EventTargetWithInlineData {
 
  private:
   Member<Screen> screen_;
+  Member<Storage> local_storage_;
+  Member<Storage> session_storage_;
 };
 
 template <>
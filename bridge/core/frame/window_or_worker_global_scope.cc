@@ -178,12 +178,16 @@ ScriptValue WindowOrWorkerGlobalScope::__memory_usage__(ExecutingContext* contex
   JSRuntime* runtime = context->GetScriptState()->runtime();
   JSMemoryUsage memory_usage;
   JS_ComputeMemoryUsage(runtime, &memory_usage);
+  context->dartIsolateContext()->gcScheduler()->MeasurePages();
+  PageMemory::Usage page_usage = context->pageMemory()->usage();
 
   char buff[2048];
   snprintf(buff, 2048,
-           R"({"malloc_size": %lld, "malloc_limit": %lld, "memory_used_size": %lld, "memory_used_count": %lld})",
+           R"({"malloc_size": %lld, "malloc_limit": %lld, "memory_used_size": %lld, "memory_used_count": %lld, )"
+           R"("page": {"js_heap": %lld, "dom_wrappers": %lld, "ui_commands": %lld, "blobs": %lld}})",
            memory_usage.malloc_size, memory_usage.malloc_limit, memory_usage.memory_used_size,
-           memory_usage.memory_used_count);
+           memory_usage.memory_used_count, (long long)page_usage.js_heap, (long long)page_usage.dom_wrappers,
+           (long long)page_usage.ui_commands, (long long)page_usage.blobs);
 
   return ScriptValue::CreateJsonObject(context->ctx(), buff, strlen(buff));
 }
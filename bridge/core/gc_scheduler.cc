@@ -0,0 +1,219 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "gc_scheduler.h"
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include "page_memory.h"
+#include "foundation/profiler.h"
+
+namespace webf {
+
+static const char* kThresholdCollection = "GC";
+static const char* kMinorCollection = "GC (minor)";
+static const char* kIdleCollection = "GC (idle)";
+static const char* kMemoryPressureCollection = "GC (memory pressure)";
+
+GCScheduler::GCScheduler(JSRuntime* runtime) : runtime_(runtime) {
+  JS_SetGCObserver(runtime_, OnCollection, this);
+}
+
+GCScheduler::~GCScheduler() {
+  JS_SetGCObserver(runtime_, nullptr, nullptr);
+}
+
+void GCScheduler::PauseHistogram::Add(int64_t pause_us) {
+  size_t bucket = 0;
+  while (bucket < kBucketCount - 1 && pause_us >= kBucketLimitsUs[bucket])
+    bucket++;
+  counts[bucket]++;
+}
+
+void GCScheduler::ClearProfiler(WebFProfiler* profiler) {
+  if (profiler_ == profiler) {
+    profiler_ = nullptr;
+  }
+}
+
+void GCScheduler::WillRunFrame() {
+  if (frame_depth_++ > 0)
+    return;
+
+  collected_in_frame_ = false;
+  threshold_before_frame_ = JS_GetGCThreshold(runtime_);
+  if (memory_pressure_ == MemoryPressureLevel::kCritical)
+    return;
+
+  size_t frame_threshold = std::min(HeapSize() + kFrameHeadroom, HeapBudget());
+  if (frame_threshold > threshold_before_frame_) {
+    JS_SetGCThreshold(runtime_, frame_threshold);
+  }
+}
+
+void GCScheduler::DidRunFrame() {
+  assert(frame_depth_ > 0);
+  if (--frame_depth_ > 0)
+    return;
+
+  // A collection in the frame already set a threshold from the heap it left.
+  if (collected_in_frame_)
+    return;
+
+  if (HeapSize() > threshold_before_frame_) {
+    // The frame held back a collection, keep the raised threshold until the next idle time.
+    collection_pending_ = true;
+    return;
+  }
+  JS_SetGCThreshold(runtime_, threshold_before_frame_);
+}
+
+bool GCScheduler::NotifyIdle(int64_t idle_time_us) {
+  if (frame_depth_ > 0)
+    return false;
+
+  size_t heap_size = HeapSize();
+  bool over_budget = heap_size > HeapBudget();
+  if (!over_budget && !collection_pending_ && heap_size < heap_size_after_collection_ + kIdleCollectionMinGrowth)
+    return false;
+
+  // The pause of a full collection grows with the heap, the last one is the best guess for the next.
+  if (!over_budget && stats_.last_full_pause_us > idle_time_us)
+    return false;
+
+  return Collect(kIdleCollection);
+}
+
+void GCScheduler::NotifyMemoryPressure(MemoryPressureLevel level) {
+  memory_pressure_ = level;
+  if (level == MemoryPressureLevel::kNone)
+    return;
+
+  Collect(kMemoryPressureCollection);
+}
+
+void GCScheduler::SetPageMemoryBudget(double context_id, int64_t bytes) {
+  if (bytes <= 0) {
+    page_budgets_.erase(context_id);
+    return;
+  }
+  page_budgets_[context_id] = bytes;
+}
+
+void GCScheduler::AddPage(PageMemory* page) {
+  pages_.push_back(page);
+}
+
+void GCScheduler::RemovePage(PageMemory* page) {
+  pages_.erase(std::remove(pages_.begin(), pages_.end(), page), pages_.end());
+}
+
+void GCScheduler::MeasurePages() {
+  std::vector<JSContext*> contexts;
+  contexts.reserve(pages_.size());
+  for (auto* page : pages_) {
+    contexts.push_back(page->ctx());
+  }
+  std::vector<int64_t> sizes(pages_.size());
+  JS_ComputeContextMemoryUsage(runtime_, contexts.data(), sizes.data(), static_cast<int>(contexts.size()));
+  for (size_t i = 0; i < pages_.size(); i++) {
+    pages_[i]->UpdateJSHeapSize(sizes[i]);
+  }
+}
+
+void GCScheduler::OnCollection(JSRuntime* runtime, JS_BOOL done, void* opaque) {
+  auto* scheduler = static_cast<GCScheduler*>(opaque);
+  bool minor = JS_IsMinorGC(runtime);
+  const char* reason = scheduler->collection_reason_;
+  if (reason == nullptr) {
+    reason = minor ? kMinorCollection : kThresholdCollection;
+  }
+
+  if (!done) {
+    if (scheduler->profiler_ != nullptr) {
+      scheduler->profiler_->StartTrackAsyncEvaluation();
+      scheduler->profiler_->StartTrackSteps(reason);
+    }
+    scheduler->collection_start_ = std::chrono::steady_clock::now();
+    return;
+  }
+
+  int64_t pause_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() -
+                                                                           scheduler->collection_start_)
+                         .count();
+  if (scheduler->profiler_ != nullptr) {
+    scheduler->profiler_->FinishTrackSteps();
+    scheduler->profiler_->FinishTrackAsyncEvaluation();
+  }
+
+  Stats& stats = scheduler->stats_;
+  stats.collections++;
+  if (reason == kIdleCollection) {
+    stats.idle_collections++;
+  }
+  stats.last_pause_us = pause_us;
+  stats.max_pause_us = std::max(stats.max_pause_us, pause_us);
+  stats.total_pause_us += pause_us;
+  if (minor) {
+    stats.minor_collections++;
+    stats.minor_pauses.Add(pause_us);
+  } else {
+    stats.last_full_pause_us = pause_us;
+    stats.full_pauses.Add(pause_us);
+    // The minor collections leave the cycles through old objects, only a full one resets the growth and takes the
+    // collection held back by a frame.
+    scheduler->heap_size_after_collection_ = scheduler->HeapSize();
+    scheduler->collection_pending_ = false;
+  }
+  if (scheduler->frame_depth_ > 0) {
+    scheduler->collected_in_frame_ = true;
+  }
+
+  // Right after a full collection only live objects are left to attribute. The walk covers the whole heap, so the
+  // minor collections, which only scan the young objects, leave it to the next full one.
+  if (!minor && std::any_of(scheduler->pages_.begin(), scheduler->pages_.end(),
+                            [](PageMemory* page) { return page->NeedsMeasurement(); })) {
+    scheduler->MeasurePages();
+  }
+}
+
+bool GCScheduler::Collect(const char* reason) {
+  uint32_t collections = stats_.collections;
+  collection_reason_ = reason;
+  JS_RunGC(runtime_);
+  collection_reason_ = nullptr;
+
+  // JS_RunGC does nothing while the collector is turned off by JS_TurnOffGC.
+  if (stats_.collections == collections) {
+    stats_.skipped_collections++;
+    return false;
+  }
+
+  // The same growth QuickJS allows after a collection, but never past the budgets.
+  size_t heap_size = HeapSize();
+  size_t threshold = heap_size + (heap_size >> 1);
+  size_t budget = HeapBudget();
+  if (budget > heap_size) {
+    threshold = std::min(threshold, budget);
+  }
+  JS_SetGCThreshold(runtime_, threshold);
+  return true;
+}
+
+size_t GCScheduler::HeapSize() const {
+  return JS_GetMallocSize(runtime_);
+}
+
+size_t GCScheduler::HeapBudget() const {
+  if (page_budgets_.empty())
+    return std::numeric_limits<size_t>::max();
+
+  size_t budget = 0;
+  for (auto& [context_id, bytes] : page_budgets_) {
+    budget += static_cast<size_t>(bytes);
+  }
+  return budget;
+}
+
+}  // namespace webf
@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef WEBF_CORE_GC_SCHEDULER_H_
+#define WEBF_CORE_GC_SCHEDULER_H_
+
+#include <quickjs/quickjs.h>
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace webf {
+
+class PageMemory;
+class WebFProfiler;
+
+enum class MemoryPressureLevel : int32_t {
+  kNone = 0,
+  // Collect now.
+  kModerate = 1,
+  // Collect now, and stop delaying the collections of frames until the pressure goes back to kNone.
+  kCritical = 2,
+};
+
+// Decides when the JSRuntime of the current thread runs its cycle collector. QuickJS collects whenever the heap
+// outgrows a threshold, which easily lands in the middle of an animation frame. GCScheduler raises the threshold while
+// frame callbacks run and makes up the delayed collections in the idle time reported by the host, it also collects on
+// memory pressure and keeps the heap under the sum of the page budgets.
+class GCScheduler {
+ public:
+  // Counts the pauses by duration: counts[i] holds the pauses shorter than kBucketLimitsUs[i], the last bucket the
+  // longer ones.
+  struct PauseHistogram {
+    static constexpr int64_t kBucketLimitsUs[] = {100, 250, 500, 1000, 2000, 4000, 8000, 16000, 32000};
+    static constexpr size_t kBucketCount = sizeof(kBucketLimitsUs) / sizeof(kBucketLimitsUs[0]) + 1;
+
+    void Add(int64_t pause_us);
+    uint32_t counts[kBucketCount]{};
+  };
+
+  struct Stats {
+    uint32_t collections{0};
+    uint32_t idle_collections{0};
+    // The collections triggered by the allocations which only scanned the young objects, see JS_RunMinorGC.
+    uint32_t minor_collections{0};
+    // The collections asked for while the collector was turned off, see JS_TurnOffGC.
+    uint32_t skipped_collections{0};
+    int64_t last_pause_us{0};
+    int64_t last_full_pause_us{0};
+    int64_t max_pause_us{0};
+    int64_t total_pause_us{0};
+    PauseHistogram full_pauses;
+    PauseHistogram minor_pauses;
+  };
+
+  // The room given to the heap while a frame runs.
+  static constexpr size_t kFrameHeadroom = 8 * 1024 * 1024;
+  // Idle collections are skipped until the heap grew by this much since the last collection.
+  static constexpr size_t kIdleCollectionMinGrowth = 1024 * 1024;
+
+  explicit GCScheduler(JSRuntime* runtime);
+  ~GCScheduler();
+
+  // Collections are recorded as their own operation in |profiler|, nullptr stops recording.
+  void SetProfiler(WebFProfiler* profiler) { profiler_ = profiler; }
+  void ClearProfiler(WebFProfiler* profiler);
+
+  void WillRunFrame();
+  void DidRunFrame();
+  // Runs a full collection when one is worthwhile and expected to fit in |idle_time_us|. Returns true when it
+  // collected, false when it was not worthwhile or the collector is turned off.
+  bool NotifyIdle(int64_t idle_time_us);
+  void NotifyMemoryPressure(MemoryPressureLevel level);
+  // The JS heap of the page |context_id| should stay under |bytes|, 0 removes the budget.
+  void SetPageMemoryBudget(double context_id, int64_t bytes);
+
+  // The JS heap of the pages is measured after the full collections, while one of them has limits or was asked for
+  // its usage.
+  void AddPage(PageMemory* page);
+  void RemovePage(PageMemory* page);
+  void MeasurePages();
+
+  MemoryPressureLevel memory_pressure() const { return memory_pressure_; }
+  const Stats& stats() const { return stats_; }
+
+ private:
+  static void OnCollection(JSRuntime* runtime, JS_BOOL done, void* opaque);
+  // Returns false when the collector is turned off, the collection is counted in Stats::skipped_collections.
+  bool Collect(const char* reason);
+  size_t HeapSize() const;
+  // The sum of the page budgets, or SIZE_MAX without budgets.
+  size_t HeapBudget() const;
+
+  JSRuntime* runtime_;
+  WebFProfiler* profiler_{nullptr};
+  const char* collection_reason_{nullptr};
+  std::chrono::steady_clock::time_point collection_start_;
+  int frame_depth_{0};
+  size_t threshold_before_frame_{0};
+  bool collected_in_frame_{false};
+  bool collection_pending_{false};
+  size_t heap_size_after_collection_{0};
+  MemoryPressureLevel memory_pressure_{MemoryPressureLevel::kNone};
+  std::unordered_map<double, int64_t> page_budgets_;
+  std::vector<PageMemory*> pages_;
+  Stats stats_;
+};
+
+}  // namespace webf
+
+#endif  // WEBF_CORE_GC_SCHEDULER_H_
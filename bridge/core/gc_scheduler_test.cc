@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "gc_scheduler.h"
+#include "gtest/gtest.h"
+
+using namespace webf;
+
+namespace {
+
+// Grows the heap by about |count| KB of garbage in cycles, only the cycle collector frees them.
+void AllocateCycles(JSContext* ctx, int count) {
+  std::string code = "for (let i = 0; i < " + std::to_string(count) +
+                     "; i++) { let a = {}; let b = {a, data: new Array(128).fill(i)}; a.b = b; }";
+  JSValue result = JS_Eval(ctx, code.c_str(), code.size(), "vm://", JS_EVAL_TYPE_GLOBAL);
+  JS_FreeValue(ctx, result);
+}
+
+}  // namespace
+
+TEST(GCScheduler, frameRaisesThreshold) {
+  JSRuntime* runtime = JS_NewRuntime();
+  {
+    GCScheduler scheduler(runtime);
+    size_t threshold = JS_GetGCThreshold(runtime);
+
+    scheduler.WillRunFrame();
+    EXPECT_GE(JS_GetGCThreshold(runtime), JS_GetMallocSize(runtime) + GCScheduler::kFrameHeadroom);
+    scheduler.DidRunFrame();
+    EXPECT_EQ(JS_GetGCThreshold(runtime), threshold);
+  }
+  JS_FreeRuntime(runtime);
+}
+
+TEST(GCScheduler, heldBackCollectionRunsInIdleTime) {
+  JSRuntime* runtime = JS_NewRuntime();
+  JSContext* ctx = JS_NewContext(runtime);
+  {
+    GCScheduler scheduler(runtime);
+    JS_SetGCThreshold(runtime, JS_GetMallocSize(runtime) + 256 * 1024);
+
+    scheduler.WillRunFrame();
+    AllocateCycles(ctx, 1024);
+    scheduler.DidRunFrame();
+    EXPECT_EQ(scheduler.stats().collections, 0);
+
+    size_t heap_size = JS_GetMallocSize(runtime);
+    EXPECT_TRUE(scheduler.NotifyIdle(50 * 1000));
+    EXPECT_EQ(scheduler.stats().collections, 1);
+    EXPECT_EQ(scheduler.stats().idle_collections, 1);
+    EXPECT_LT(JS_GetMallocSize(runtime), heap_size);
+
+    // Nothing left to collect.
+    EXPECT_FALSE(scheduler.NotifyIdle(50 * 1000));
+  }
+  JS_FreeContext(ctx);
+  JS_FreeRuntime(runtime);
+}
+
+TEST(GCScheduler, criticalMemoryPressure) {
+  JSRuntime* runtime = JS_NewRuntime();
+  {
+    GCScheduler scheduler(runtime);
+
+    scheduler.NotifyMemoryPressure(MemoryPressureLevel::kCritical);
+    EXPECT_EQ(scheduler.stats().collections, 1);
+
+    size_t threshold = JS_GetGCThreshold(runtime);
+    scheduler.WillRunFrame();
+    EXPECT_EQ(JS_GetGCThreshold(runtime), threshold);
+    scheduler.DidRunFrame();
+
+    scheduler.NotifyMemoryPressure(MemoryPressureLevel::kNone);
+    scheduler.WillRunFrame();
+    EXPECT_GT(JS_GetGCThreshold(runtime), threshold);
+    scheduler.DidRunFrame();
+  }
+  JS_FreeRuntime(runtime);
+}
+
+TEST(GCScheduler, pageBudgetsCapFrameThreshold) {
+  JSRuntime* runtime = JS_NewRuntime();
+  JSContext* ctx = JS_NewContext(runtime);
+  {
+    GCScheduler scheduler(runtime);
+    size_t budget = JS_GetMallocSize(runtime) + 1024 * 1024;
+    scheduler.SetPageMemoryBudget(1, budget / 2);
+    scheduler.SetPageMemoryBudget(2, budget - budget / 2);
+    JS_SetGCThreshold(runtime, JS_GetMallocSize(runtime) + 256 * 1024);
+
+    scheduler.WillRunFrame();
+    EXPECT_EQ(JS_GetGCThreshold(runtime), budget);
+    scheduler.DidRunFrame();
+
+    // Past the budgets the idle time is taken whatever the pause.
+    JS_SetGCThreshold(runtime, -1);
+    AllocateCycles(ctx, 2048);
+    ASSERT_GT(JS_GetMallocSize(runtime), budget);
+    EXPECT_TRUE(scheduler.NotifyIdle(0));
+  }
+  JS_FreeContext(ctx);
+  JS_FreeRuntime(runtime);
+}
+
+TEST(GCScheduler, thresholdCollectionsAreMinor) {
+  JSRuntime* runtime = JS_NewRuntime();
+  JSContext* ctx = JS_NewContext(runtime);
+  {
+    GCScheduler scheduler(runtime);
+    JS_SetGCThreshold(runtime, JS_GetMallocSize(runtime) + 256 * 1024);
+    AllocateCycles(ctx, 1024);
+
+    const GCScheduler::Stats& stats = scheduler.stats();
+    EXPECT_GT(stats.minor_collections, 0);
+    EXPECT_EQ(stats.collections, stats.minor_collections);
+    uint32_t minor_pauses = 0;
+    for (uint32_t count : stats.minor_pauses.counts) {
+      minor_pauses += count;
+    }
+    EXPECT_EQ(minor_pauses, stats.minor_collections);
+
+    scheduler.NotifyMemoryPressure(MemoryPressureLevel::kModerate);
+    EXPECT_EQ(stats.collections, stats.minor_collections + 1);
+    EXPECT_EQ(stats.last_full_pause_us, stats.last_pause_us);
+  }
+  JS_FreeContext(ctx);
+  JS_FreeRuntime(runtime);
+}
+
+TEST(GCScheduler, collectionsSkippedWhileGCIsOff) {
+  JSRuntime* runtime = JS_NewRuntime();
+  JSContext* ctx = JS_NewContext(runtime);
+  {
+    GCScheduler scheduler(runtime);
+    JS_TurnOffGC(runtime);
+    JS_SetGCThreshold(runtime, -1);
+    AllocateCycles(ctx, 2048);
+
+    EXPECT_FALSE(scheduler.NotifyIdle(50 * 1000));
+    scheduler.NotifyMemoryPressure(MemoryPressureLevel::kModerate);
+    EXPECT_EQ(scheduler.stats().collections, 0);
+    EXPECT_EQ(scheduler.stats().skipped_collections, 2);
+
+    JS_TurnOnGC(runtime);
+    EXPECT_TRUE(scheduler.NotifyIdle(50 * 1000));
+    EXPECT_EQ(scheduler.stats().collections, 1);
+  }
+  JS_FreeContext(ctx);
+  JS_FreeRuntime(runtime);
+}
+
+TEST(GCScheduler, minorCollectionsKeepHeldBackCollection) {
+  JSRuntime* runtime = JS_NewRuntime();
+  JSContext* ctx = JS_NewContext(runtime);
+  {
+    GCScheduler scheduler(runtime);
+    JS_RunGC(runtime);
+    JS_SetGCThreshold(runtime, JS_GetMallocSize(runtime) + 256 * 1024);
+
+    scheduler.WillRunFrame();
+    AllocateCycles(ctx, 1024);
+    scheduler.DidRunFrame();
+
+    // Frees the young cycles, the heap is back under the growth that makes an idle collection worthwhile.
+    JS_RunMinorGC(runtime);
+    EXPECT_EQ(scheduler.stats().minor_collections, 1);
+    // The collection held back by the frame still runs in idle time.
+    EXPECT_TRUE(scheduler.NotifyIdle(50 * 1000));
+    EXPECT_EQ(scheduler.stats().idle_collections, 1);
+  }
+  JS_FreeContext(ctx);
+  JS_FreeRuntime(runtime);
+}
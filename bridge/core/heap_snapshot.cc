@@ -0,0 +1,32 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "heap_snapshot.h"
+#include "bindings/qjs/script_wrappable.h"
+
+namespace webf {
+
+size_t HeapSnapshot::ScriptWrappableSize(JSRuntime* runtime, JSValueConst object) {
+  JSClassID class_id = JSValueGetClassId(object);
+  // Only the classes of the WrapperTypeInfo hold a ScriptWrappable. The constructors of the wrapper classes have custom
+  // classes too, allocated after them, without opaque.
+  if (class_id <= JS_CLASS_GC_TRACKER || class_id >= JS_CLASS_CUSTOM_CLASS_INIT_COUNT)
+    return 0;
+  auto* wrappable = static_cast<ScriptWrappable*>(JS_GetOpaque(object, class_id));
+  return wrappable != nullptr ? wrappable->allocation_size() : 0;
+}
+
+std::string HeapSnapshot::Take(JSRuntime* runtime, JSNativeObjectSize* native_size) {
+  JS_RunGC(runtime);
+
+  size_t size;
+  char* snapshot = JS_WriteHeapSnapshot(runtime, native_size, &size);
+  if (snapshot == nullptr)
+    return "";
+  std::string result(snapshot, size);
+  js_free_rt(runtime, snapshot);
+  return result;
+}
+
+}  // namespace webf
@@ -0,0 +1,32 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef WEBF_CORE_HEAP_SNAPSHOT_H_
+#define WEBF_CORE_HEAP_SNAPSHOT_H_
+
+#include <quickjs/quickjs.h>
+#include <string>
+
+namespace webf {
+
+// Writes the heap of a JSRuntime as a Chrome DevTools heap snapshot, which DevTools opens in its Memory panel:
+// the JS objects with their properties and closure variables, the strings they hold, and a native node for every
+// ScriptWrappable, sized by its C++ object, whose edges are the Member<> and the values it traces.
+//
+// The objects kept between two snapshots of the same runtime have the same id, the ids of the freed objects are not
+// reused. Only the strings, which are not GC objects, are identified by their address, which a new string can reuse.
+// tools/webf_heap_snapshot_diff prints the classes which grow between two snapshots.
+class HeapSnapshot {
+ public:
+  // The size of the ScriptWrappable of |object|, 0 if it is not a wrapper.
+  static size_t ScriptWrappableSize(JSRuntime* runtime, JSValueConst object);
+
+  // Collects the garbage first, so that only the reachable objects are written. Returns an empty string when out of
+  // memory.
+  static std::string Take(JSRuntime* runtime, JSNativeObjectSize* native_size = ScriptWrappableSize);
+};
+
+}  // namespace webf
+
+#endif  // WEBF_CORE_HEAP_SNAPSHOT_H_
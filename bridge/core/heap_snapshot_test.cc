@@ -0,0 +1,270 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "heap_snapshot.h"
+#include <vector>
+#include "gtest/gtest.h"
+#include "page.h"
+#include "webf_test_env.h"
+
+using namespace webf;
+
+namespace {
+
+constexpr int kNodeFieldCount = 7;
+constexpr int kEdgeFieldCount = 3;
+
+// The arrays of a snapshot, the nodes are [type, name, id, self_size, edge_count, trace_node_id, detachedness] and the
+// edges [type, name_or_index, to_node].
+struct ParsedSnapshot {
+  std::vector<uint64_t> nodes;
+  std::vector<uint64_t> edges;
+  std::vector<std::string> strings;
+
+  size_t node_count() const { return nodes.size() / kNodeFieldCount; }
+  const std::string& name(size_t node) const { return strings[nodes[node * kNodeFieldCount + 1]]; }
+  uint64_t type(size_t node) const { return nodes[node * kNodeFieldCount]; }
+  uint64_t id(size_t node) const { return nodes[node * kNodeFieldCount + 2]; }
+  uint64_t self_size(size_t node) const { return nodes[node * kNodeFieldCount + 3]; }
+
+  std::vector<size_t> Find(const std::string& name, uint64_t type) const {
+    std::vector<size_t> result;
+    for (size_t i = 0; i < node_count(); i++) {
+      if (this->type(i) == type && this->name(i) == name)
+        result.push_back(i);
+    }
+    return result;
+  }
+
+  // Returns the node of the edge of |node| named |edge_name|, or -1.
+  int64_t Follow(size_t node, const std::string& edge_name) const {
+    size_t edge = 0;
+    for (size_t i = 0; i < node; i++)
+      edge += nodes[i * kNodeFieldCount + 4];
+    for (size_t i = 0; i < nodes[node * kNodeFieldCount + 4]; i++, edge++) {
+      const uint64_t* fields = &edges[edge * kEdgeFieldCount];
+      // The element and hidden edges are indexed.
+      if (fields[0] != 1 && fields[0] != 4 && strings[fields[1]] == edge_name)
+        return fields[2] / kNodeFieldCount;
+    }
+    return -1;
+  }
+};
+
+std::vector<uint64_t> ParseNumbers(const std::string& json, const std::string& key) {
+  std::vector<uint64_t> numbers;
+  size_t i = json.find("\"" + key + "\":[") + key.size() + 4;
+  while (json[i] != ']') {
+    if (json[i] >= '0' && json[i] <= '9') {
+      size_t end;
+      numbers.push_back(std::stoull(json.substr(i, 24), &end));
+      i += end;
+    } else {
+      i++;
+    }
+  }
+  return numbers;
+}
+
+ParsedSnapshot Parse(const std::string& json) {
+  ParsedSnapshot snapshot;
+  snapshot.nodes = ParseNumbers(json, "nodes");
+  snapshot.edges = ParseNumbers(json, "edges");
+  // The strings are ASCII, the other characters are escaped.
+  size_t i = json.find("\"strings\":[") + 11;
+  while (json[i] != ']') {
+    if (json[i] != '"') {
+      i++;
+      continue;
+    }
+    std::string string;
+    for (i++; json[i] != '"'; i++) {
+      if (json[i] == '\\')
+        i++;
+      string += json[i];
+    }
+    snapshot.strings.push_back(string);
+    i++;
+  }
+  return snapshot;
+}
+
+void Eval(JSContext* ctx, const char* code) {
+  JSValue result = JS_Eval(ctx, code, strlen(code), "vm://heap_snapshot.js", JS_EVAL_TYPE_GLOBAL);
+  EXPECT_FALSE(JS_IsException(result));
+  JS_FreeValue(ctx, result);
+}
+
+// A wrapper whose native object holds a JS value, as a ScriptWrappable holds its Member<>.
+struct NativeHolder {
+  JSValue held;
+  char padding[200];
+};
+
+JSClassID native_holder_class_id = 0;
+
+size_t NativeHolderSize(JSRuntime* runtime, JSValueConst object) {
+  return JS_GetOpaque(object, native_holder_class_id) != nullptr ? sizeof(NativeHolder) : 0;
+}
+
+void NewNativeHolderClass(JSRuntime* runtime) {
+  if (native_holder_class_id == 0)
+    JS_NewClassID(&native_holder_class_id);
+  JSClassDef def{};
+  def.class_name = "NativeHolder";
+  def.finalizer = [](JSRuntime* runtime, JSValue object) {
+    auto* holder = static_cast<NativeHolder*>(JS_GetOpaque(object, native_holder_class_id));
+    JS_FreeValueRT(runtime, holder->held);
+    delete holder;
+  };
+  def.gc_mark = [](JSRuntime* runtime, JSValueConst object, JS_MarkFunc* mark_func) {
+    auto* holder = static_cast<NativeHolder*>(JS_GetOpaque(object, native_holder_class_id));
+    JS_MarkValue(runtime, holder->held, mark_func);
+  };
+  JS_NewClass(runtime, native_holder_class_id, &def);
+}
+
+}  // namespace
+
+TEST(HeapSnapshot, objectsAndStrings) {
+  JSRuntime* runtime = JS_NewRuntime();
+  JSContext* ctx = JS_NewContext(runtime);
+  Eval(ctx, R"(
+class Leaky {
+  constructor(i) { this.payload = 'payload-' + i; }
+}
+globalThis.leaks = [];
+for (let i = 0; i < 100; i++) leaks.push(new Leaky(i));
+)");
+
+  ParsedSnapshot snapshot = Parse(HeapSnapshot::Take(runtime));
+  // The root, then "(external references)".
+  EXPECT_EQ(snapshot.type(0), 9);
+  EXPECT_EQ(snapshot.name(1), "(external references)");
+  std::vector<size_t> leaky = snapshot.Find("Leaky", 3);
+  EXPECT_EQ(leaky.size(), 100);
+  int64_t payload = snapshot.Follow(leaky[0], "payload");
+  ASSERT_GE(payload, 0);
+  EXPECT_EQ(snapshot.type(payload), 2);
+  EXPECT_EQ(snapshot.name(payload).substr(0, 8), "payload-");
+
+  JS_FreeContext(ctx);
+  JS_FreeRuntime(runtime);
+}
+
+TEST(HeapSnapshot, nativeObjectsHoldTheirReferences) {
+  JSRuntime* runtime = JS_NewRuntime();
+  JSContext* ctx = JS_NewContext(runtime);
+  NewNativeHolderClass(runtime);
+
+  JSValue wrapper = JS_NewObjectClass(ctx, native_holder_class_id);
+  auto* holder = new NativeHolder();
+  holder->held = JS_NewObject(ctx);
+  JS_SetOpaque(wrapper, holder);
+  JSValue global = JS_GetGlobalObject(ctx);
+  JS_SetPropertyStr(ctx, global, "wrapper", wrapper);
+  JS_FreeValue(ctx, global);
+
+  ParsedSnapshot snapshot = Parse(HeapSnapshot::Take(runtime, NativeHolderSize));
+  std::vector<size_t> wrappers = snapshot.Find("NativeHolder", 3);
+  ASSERT_EQ(wrappers.size(), 1);
+  int64_t native = snapshot.Follow(wrappers[0], "native");
+  ASSERT_GE(native, 0);
+  EXPECT_EQ(snapshot.type(native), 8);
+  EXPECT_EQ(snapshot.name(native), "NativeHolder");
+  EXPECT_EQ(snapshot.self_size(native), sizeof(NativeHolder));
+  EXPECT_NE(snapshot.id(native), snapshot.id(wrappers[0]));
+  int64_t held = snapshot.Follow(native, "member");
+  ASSERT_GE(held, 0);
+  EXPECT_EQ(snapshot.name(held), "Object");
+
+  JS_FreeContext(ctx);
+  JS_FreeRuntime(runtime);
+}
+
+TEST(HeapSnapshot, idsAreKeptBetweenSnapshots) {
+  JSRuntime* runtime = JS_NewRuntime();
+  JSContext* ctx = JS_NewContext(runtime);
+  Eval(ctx, "class Kept {}; globalThis.kept = new Kept();");
+  ParsedSnapshot before = Parse(HeapSnapshot::Take(runtime));
+  Eval(ctx, "globalThis.more = [new Kept(), new Kept()];");
+  ParsedSnapshot after = Parse(HeapSnapshot::Take(runtime));
+
+  std::vector<size_t> kept_before = before.Find("Kept", 3);
+  std::vector<size_t> kept_after = after.Find("Kept", 3);
+  ASSERT_EQ(kept_before.size(), 1);
+  EXPECT_EQ(kept_after.size(), 3);
+  int same_id = 0;
+  for (size_t node : kept_after)
+    same_id += after.id(node) == before.id(kept_before[0]);
+  EXPECT_EQ(same_id, 1);
+
+  JS_FreeContext(ctx);
+  JS_FreeRuntime(runtime);
+}
+
+TEST(HeapSnapshot, freedObjectsGetNewIds) {
+  JSRuntime* runtime = JS_NewRuntime();
+  JSContext* ctx = JS_NewContext(runtime);
+  Eval(ctx, "class Replaced {}; globalThis.replaced = Array.from({length: 100}, () => new Replaced());");
+  ParsedSnapshot before = Parse(HeapSnapshot::Take(runtime));
+  // The new objects are allocated where the freed ones were.
+  Eval(ctx, "replaced.length = 0; for (let i = 0; i < 100; i++) replaced.push(new Replaced());");
+  ParsedSnapshot after = Parse(HeapSnapshot::Take(runtime));
+
+  std::vector<size_t> replaced_before = before.Find("Replaced", 3);
+  std::vector<size_t> replaced_after = after.Find("Replaced", 3);
+  ASSERT_EQ(replaced_before.size(), 100);
+  ASSERT_EQ(replaced_after.size(), 100);
+  int same_id = 0;
+  for (size_t node : replaced_after) {
+    for (size_t old_node : replaced_before)
+      same_id += after.id(node) == before.id(old_node);
+  }
+  EXPECT_EQ(same_id, 0);
+
+  JS_FreeContext(ctx);
+  JS_FreeRuntime(runtime);
+}
+
+TEST(HeapSnapshot, movedShapesKeepTheirIds) {
+  JSRuntime* runtime = JS_NewRuntime();
+  JSContext* ctx = JS_NewContext(runtime);
+  // The deletion gives the object a shape of its own, which is reallocated when it grows or shrinks.
+  Eval(ctx, "class Grown {}; globalThis.grown = new Grown(); grown.p = 0; delete grown.p;");
+  ParsedSnapshot first = Parse(HeapSnapshot::Take(runtime));
+  Eval(ctx, "for (let i = 0; i < 100; i++) grown['p' + i] = i;");
+  ParsedSnapshot grown = Parse(HeapSnapshot::Take(runtime));
+  Eval(ctx, "for (let i = 0; i < 90; i++) delete grown['p' + i];");
+  ParsedSnapshot compacted = Parse(HeapSnapshot::Take(runtime));
+
+  auto shape_id = [](const ParsedSnapshot& snapshot) -> uint64_t {
+    std::vector<size_t> objects = snapshot.Find("Grown", 3);
+    if (objects.size() != 1)
+      return 0;
+    int64_t shape = snapshot.Follow(objects[0], "map");
+    return shape >= 0 ? snapshot.id(shape) : 0;
+  };
+  ASSERT_NE(shape_id(first), 0);
+  EXPECT_EQ(shape_id(grown), shape_id(first));
+  EXPECT_EQ(shape_id(compacted), shape_id(first));
+
+  JS_FreeContext(ctx);
+  JS_FreeRuntime(runtime);
+}
+
+TEST(HeapSnapshot, domObjectsHaveTheirNativeSize) {
+  auto env = TEST_init();
+  auto* context = env->page()->executingContext();
+  const char* code = "globalThis.div = document.createElement('div');";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+
+  ParsedSnapshot snapshot = Parse(HeapSnapshot::Take(context->dartIsolateContext()->runtime()));
+  std::vector<size_t> wrappers = snapshot.Find("HTMLDivElement", 3);
+  ASSERT_GE(wrappers.size(), 1);
+  int64_t native = snapshot.Follow(wrappers[0], "native");
+  ASSERT_GE(native, 0);
+  EXPECT_EQ(snapshot.type(native), 8);
+  EXPECT_GT(snapshot.self_size(native), 0);
+}
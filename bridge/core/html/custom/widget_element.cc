@@ -28,7 +28,8 @@ bool WidgetElement::IsValidName(const AtomicString& name) {
 }
 
 bool WidgetElement::NamedPropertyQuery(const AtomicString& key, ExceptionState& exception_state) {
-  return GetExecutingContext()->dartIsolateContext()->EnsureData()->HasWidgetElementShape(key.ToStdString(ctx()));
+  const WidgetElementShapeSlots* shape = EnsureShape();
+  return shape != nullptr && shape->Find(key) != nullptr;
 }
 
 void WidgetElement::NamedPropertyEnumerator(std::vector<AtomicString>& names, ExceptionState& exception_state) {
@@ -43,75 +44,37 @@ void WidgetElement::NamedPropertyEnumerator(std::vector<AtomicString>& names, Ex
 }
 
 ScriptValue WidgetElement::item(const AtomicString& key, ExceptionState& exception_state) {
-  if (unimplemented_properties_.count(key) > 0) {
-    return unimplemented_properties_[key];
-  }
-
-  std::string shape_key = tagName().ToStdString(ctx());
-  std::string property_key = key.ToStdString(ctx());
-  bool have_shape = true;
-
-  if (!GetExecutingContext()->dartIsolateContext()->EnsureData()->HasWidgetElementShape(shape_key)) {
-    GetExecutingContext()->FlushUICommand(this, FlushUICommandReason::kDependentsOnElement);
-    have_shape = false;
+  auto unimplemented = unimplemented_properties_.find(key);
+  if (unimplemented != unimplemented_properties_.end()) {
+    return unimplemented->second;
   }
 
   if (key == built_in_string::kSymbol_toStringTag) {
     return ScriptValue(ctx(), tagName().ToNativeString(ctx()).release());
   }
 
-  const WidgetElementShape* shape = nullptr;
-
-  if (have_shape) {
-    shape = GetExecutingContext()->dartIsolateContext()->EnsureData()->GetWidgetElementShape(shape_key);
-  } else {
-    NativeValue raw_shapes[3];
-    bool is_success = GetExecutingContext()->dartMethodPtr()->getWidgetElementShape(
-        GetExecutingContext()->isDedicated(), contextId(), bindingObject(),
-        reinterpret_cast<NativeValue*>(&raw_shapes));
-    if (is_success) {
-      shape = SaveWidgetElementsShapeData(raw_shapes);
-    }
+  const WidgetElementShapeSlots* shape = EnsureShape();
+  const WidgetElementSlot* slot = shape != nullptr ? shape->Find(key) : nullptr;
+  if (slot == nullptr) {
+    return ScriptValue::Undefined(ctx());
   }
 
-  if (shape != nullptr) {
-    if (shape->built_in_properties_.find(property_key) != shape->built_in_properties_.end()) {
-      return ScriptValue(ctx(), GetBindingProperty(key, FlushUICommandReason::kDependentsOnElement, exception_state));
-    }
-
-    if (shape->built_in_methods_.find(property_key) != shape->built_in_methods_.end()) {
-      if (cached_methods_.count(key) > 0) {
-        return cached_methods_[key];
-      }
-
-      auto func = CreateSyncMethodFunc(key);
-      cached_methods_[key] = func;
-      return func;
-    }
-
-    if (shape->built_in_async_methods_.find(property_key) != shape->built_in_async_methods_.end()) {
-      if (async_cached_methods_.count(key) > 0) {
-        return async_cached_methods_[key];
-      }
-
-      auto func = CreateAsyncMethodFunc(key);
-      async_cached_methods_[key] = CreateAsyncMethodFunc(key);
-      return func;
-    }
+  if (slot->type == WidgetElementMemberType::kProperty) {
+    return ScriptValue(ctx(), GetBindingProperty(key, FlushUICommandReason::kDependentsOnElement, exception_state));
   }
 
-  return ScriptValue::Undefined(ctx());
+  ScriptValue& func = cached_methods_[slot->index];
+  if (func.IsEmpty()) {
+    func = slot->type == WidgetElementMemberType::kMethod ? CreateSyncMethodFunc(key) : CreateAsyncMethodFunc(key);
+  }
+  return func;
 }
 
 bool WidgetElement::SetItem(const AtomicString& key, const ScriptValue& value, ExceptionState& exception_state) {
-  if (!GetExecutingContext()->dartIsolateContext()->EnsureData()->HasWidgetElementShape(tagName().ToStdString(ctx()))) {
-    GetExecutingContext()->FlushUICommand(this, FlushUICommandReason::kDependentsOnElement);
-  }
-
-  auto shape =
-      GetExecutingContext()->dartIsolateContext()->EnsureData()->GetWidgetElementShape(tagName().ToStdString(ctx()));
+  const WidgetElementShapeSlots* shape = EnsureShape();
+  const WidgetElementSlot* slot = shape != nullptr ? shape->Find(key) : nullptr;
   // This property is defined in the Dart side
-  if (shape != nullptr && shape->built_in_properties_.count(key.ToStdString(ctx())) > 0) {
+  if (slot != nullptr && slot->type == WidgetElementMemberType::kProperty) {
     NativeValue result = SetBindingProperty(key, value.ToNative(ctx(), exception_state), exception_state);
     return NativeValueConverter<NativeTypeBool>::FromNativeValue(result);
   }
@@ -142,12 +105,8 @@ void WidgetElement::Trace(GCVisitor* visitor) const {
     entry.second.Trace(visitor);
   }
 
-  for (auto& entry : cached_methods_) {
-    entry.second.Trace(visitor);
-  }
-
-  for (auto& entry : async_cached_methods_) {
-    entry.second.Trace(visitor);
+  for (auto& func : cached_methods_) {
+    func.Trace(visitor);
   }
 }
 
@@ -158,31 +117,53 @@ void WidgetElement::CloneNonAttributePropertiesFrom(const Element& other, CloneC
   }
 }
 
-const WidgetElementShape* WidgetElement::SaveWidgetElementsShapeData(const NativeValue* argv) {
-  AtomicString key = tagName();
-  assert(!GetExecutingContext()->dartIsolateContext()->EnsureData()->HasWidgetElementShape(key.ToStdString(ctx())));
+const WidgetElementShapeSlots* WidgetElement::EnsureShape() {
+  if (shape_ != nullptr)
+    return shape_;
 
+  ExecutingContext* context = GetExecutingContext();
+  shape_ = context->WidgetElementShapes()->Get(context, tagName());
+  if (shape_ == nullptr) {
+    // The first element of this tag, the dart element should be created before asking for its shape.
+    context->FlushUICommand(this, FlushUICommandReason::kDependentsOnElement);
+    NativeValue raw_shapes[3];
+    bool is_success = context->dartMethodPtr()->getWidgetElementShape(context->isDedicated(), contextId(),
+                                                                      bindingObject(), raw_shapes);
+    if (!is_success)
+      return nullptr;
+    SaveWidgetElementsShapeData(raw_shapes);
+    shape_ = context->WidgetElementShapes()->Get(context, tagName());
+  }
+
+  cached_methods_.resize(shape_->size(), ScriptValue::Empty(ctx()));
+  return shape_;
+}
+
+void WidgetElement::SaveWidgetElementsShapeData(const NativeValue* argv) {
   auto shape = std::make_shared<WidgetElementShape>();
 
   auto&& properties = NativeValueConverter<NativeTypeArray<NativeTypeString>>::FromNativeValue(ctx(), argv[0]);
   auto&& sync_methods = NativeValueConverter<NativeTypeArray<NativeTypeString>>::FromNativeValue(ctx(), argv[1]);
   auto&& async_methods = NativeValueConverter<NativeTypeArray<NativeTypeString>>::FromNativeValue(ctx(), argv[2]);
 
+  shape->properties.reserve(properties.size());
   for (auto& property : properties) {
-    shape->built_in_properties_.emplace(property.ToStdString(ctx()));
+    shape->properties.emplace_back(property.ToStdString(ctx()));
   }
 
+  shape->methods.reserve(sync_methods.size());
   for (auto& method : sync_methods) {
-    shape->built_in_methods_.emplace(method.ToStdString(ctx()));
+    shape->methods.emplace_back(method.ToStdString(ctx()));
   }
 
+  shape->async_methods.reserve(async_methods.size());
   for (auto& method : async_methods) {
-    shape->built_in_async_methods_.emplace(method.ToStdString(ctx()));
+    shape->async_methods.emplace_back(method.ToStdString(ctx()));
   }
 
-  GetExecutingContext()->dartIsolateContext()->EnsureData()->SetWidgetElementShape(key.ToStdString(ctx()), shape);
-
-  return shape.get();
+  // Another JS thread of the isolate may have saved the same shape in the meantime, the shapes are identical.
+  GetExecutingContext()->dartIsolateContext()->EnsureData()->SetWidgetElementShape(tagName().ToStdString(ctx()),
+                                                                                   std::move(shape));
 }
 
 ScriptValue WidgetElement::CreateSyncMethodFunc(const AtomicString& method_name) {
@@ -7,6 +7,7 @@
 
 #include <set>
 #include <unordered_map>
+#include "core/html/custom/widget_element_shape.h"
 #include "core/html/html_element.h"
 
 namespace webf {
@@ -40,9 +41,12 @@ class WidgetElement : public HTMLElement {
  private:
   ScriptValue CreateSyncMethodFunc(const AtomicString& method_name);
   ScriptValue CreateAsyncMethodFunc(const AtomicString& method_name);
-  const WidgetElementShape* SaveWidgetElementsShapeData(const NativeValue* argv);
-  std::unordered_map<AtomicString, ScriptValue, AtomicString::KeyHasher> cached_methods_;
-  std::unordered_map<AtomicString, ScriptValue, AtomicString::KeyHasher> async_cached_methods_;
+  // Returns the shape of this element, asks dart for it when this is the first element of the tag.
+  const WidgetElementShapeSlots* EnsureShape();
+  void SaveWidgetElementsShapeData(const NativeValue* argv);
+  const WidgetElementShapeSlots* shape_{nullptr};
+  // The functions of the methods in shape, indexed by the slots.
+  std::vector<ScriptValue> cached_methods_;
   std::unordered_map<AtomicString, ScriptValue, AtomicString::KeyHasher> unimplemented_properties_;
 };
 
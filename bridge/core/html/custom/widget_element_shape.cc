@@ -0,0 +1,42 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "widget_element_shape.h"
+#include "core/executing_context.h"
+
+namespace webf {
+
+WidgetElementShapeSlots::WidgetElementShapeSlots(JSContext* ctx, std::shared_ptr<const WidgetElementShape> shape)
+    : shape_(std::move(shape)) {
+  names_.reserve(shape_->properties.size() + shape_->methods.size() + shape_->async_methods.size());
+  auto add_members = [this, ctx](const std::vector<std::string>& members, WidgetElementMemberType type) {
+    for (auto& member : members) {
+      AtomicString name(ctx, member);
+      if (slots_.count(name) > 0)
+        continue;
+      slots_.emplace(name, WidgetElementSlot{type, static_cast<uint32_t>(names_.size())});
+      names_.emplace_back(std::move(name));
+    }
+  };
+  add_members(shape_->properties, WidgetElementMemberType::kProperty);
+  add_members(shape_->methods, WidgetElementMemberType::kMethod);
+  add_members(shape_->async_methods, WidgetElementMemberType::kAsyncMethod);
+}
+
+const WidgetElementShapeSlots* WidgetElementShapeCache::Get(ExecutingContext* context, const AtomicString& tag_name) {
+  auto it = shapes_.find(tag_name);
+  if (it != shapes_.end())
+    return it->second.get();
+
+  auto shape = context->dartIsolateContext()->EnsureData()->GetWidgetElementShape(tag_name.ToStdString(context->ctx()));
+  if (shape == nullptr)
+    return nullptr;
+
+  auto slots = std::make_unique<WidgetElementShapeSlots>(context->ctx(), std::move(shape));
+  const WidgetElementShapeSlots* result = slots.get();
+  shapes_.emplace(tag_name, std::move(slots));
+  return result;
+}
+
+}  // namespace webf
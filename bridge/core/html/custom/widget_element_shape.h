@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef WEBF_CORE_HTML_CUSTOM_WIDGET_ELEMENT_SHAPE_H_
+#define WEBF_CORE_HTML_CUSTOM_WIDGET_ELEMENT_SHAPE_H_
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "bindings/qjs/atomic_string.h"
+#include "core/dart_context_data.h"
+
+namespace webf {
+
+class ExecutingContext;
+
+enum class WidgetElementMemberType : uint8_t { kProperty, kMethod, kAsyncMethod };
+
+struct WidgetElementSlot {
+  WidgetElementMemberType type;
+  uint32_t index;
+};
+
+// The members of a WidgetElementShape keyed by the atoms of one JS context, so a property access costs one integer hash.
+class WidgetElementShapeSlots {
+ public:
+  WidgetElementShapeSlots(JSContext* ctx, std::shared_ptr<const WidgetElementShape> shape);
+
+  // Returns nullptr if |key| isn't a property or a method defined in dart.
+  const WidgetElementSlot* Find(const AtomicString& key) const {
+    auto it = slots_.find(key);
+    return it != slots_.end() ? &it->second : nullptr;
+  }
+
+  size_t size() const { return names_.size(); }
+  const std::vector<AtomicString>& names() const { return names_; }
+
+ private:
+  std::shared_ptr<const WidgetElementShape> shape_;
+  std::unordered_map<AtomicString, WidgetElementSlot, AtomicString::KeyHasher> slots_;
+  std::vector<AtomicString> names_;
+};
+
+// Caches the slots of every WidgetElement tag used in an ExecutingContext.
+class WidgetElementShapeCache {
+ public:
+  // Returns nullptr if dart has not reported the shape of |tag_name| yet.
+  const WidgetElementShapeSlots* Get(ExecutingContext* context, const AtomicString& tag_name);
+
+ private:
+  std::unordered_map<AtomicString, std::unique_ptr<WidgetElementShapeSlots>, AtomicString::KeyHasher> shapes_;
+};
+
+}  // namespace webf
+
+#endif  // WEBF_CORE_HTML_CUSTOM_WIDGET_ELEMENT_SHAPE_H_
@@ -49,3 +49,30 @@ TEST(WidgetElement, getPropertyWithSymbolToStringTag) {
 
   EXPECT_EQ(errorCalled, false);
 }
+
+TEST(WidgetElement, shapeSlots) {
+  auto env = TEST_init();
+  auto context = env->page()->executingContext();
+  auto shape = std::make_shared<WidgetElementShape>();
+  shape->properties = {"value", "checked"};
+  shape->methods = {"focus", "value"};
+  shape->async_methods = {"load"};
+  context->dartIsolateContext()->EnsureData()->SetWidgetElementShape("flutter-shape-test", shape);
+
+  auto* slots = context->WidgetElementShapes()->Get(context, AtomicString(context->ctx(), "flutter-shape-test"));
+  ASSERT_NE(slots, nullptr);
+  EXPECT_EQ(slots, context->WidgetElementShapes()->Get(context, AtomicString(context->ctx(), "flutter-shape-test")));
+  EXPECT_EQ(slots->size(), 4);
+
+  auto* value = slots->Find(AtomicString(context->ctx(), "value"));
+  ASSERT_NE(value, nullptr);
+  EXPECT_EQ(value->type, WidgetElementMemberType::kProperty);
+  EXPECT_EQ(value->index, 0);
+  auto* load = slots->Find(AtomicString(context->ctx(), "load"));
+  ASSERT_NE(load, nullptr);
+  EXPECT_EQ(load->type, WidgetElementMemberType::kAsyncMethod);
+  EXPECT_EQ(load->index, 3);
+  EXPECT_EQ(slots->Find(AtomicString(context->ctx(), "missing")), nullptr);
+
+  EXPECT_EQ(context->WidgetElementShapes()->Get(context, AtomicString(context->ctx(), "flutter-unknown")), nullptr);
+}
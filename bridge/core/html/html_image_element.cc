@@ -58,4 +58,9 @@ DispatchEventResult HTMLImageElement::FireEventListeners(webf::Event& event,
   return HTMLElement::FireEventListeners(event, isCapture, exception_state);
 }
 
+bool HTMLImageElement::HandlesDartEventWithoutListeners(const StringView& event_type) const {
+  return EqualStringView(event_type, event_type_names::kload.ToStringView()) ||
+         EqualStringView(event_type, event_type_names::kerror.ToStringView());
+}
+
 }  // namespace webf
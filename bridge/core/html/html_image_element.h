@@ -20,6 +20,7 @@ class HTMLImageElement : public HTMLElement {
 
   DispatchEventResult FireEventListeners(Event&, ExceptionState&) override;
   DispatchEventResult FireEventListeners(Event&, bool isCapture, ExceptionState&) override;
+  bool HandlesDartEventWithoutListeners(const StringView& event_type) const override;
 
   ScriptPromise decode(ExceptionState& exception_state) const;
 
@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "microtask_queue.h"
+
+namespace webf {
+
+MicrotaskQueue::MicrotaskQueue(JSRuntime* runtime) : runtime_(runtime), tasks_(kInitialCapacity) {}
+
+void MicrotaskQueue::Enqueue(ExecutingContext* context, MicrotaskCallback callback, void* data) {
+  if (size_ == tasks_.size()) {
+    Grow();
+  }
+  tasks_[(head_ + size_) % tasks_.size()] = {context, callback, data, JS_GetEnqueuedJobCount(runtime_)};
+  size_++;
+}
+
+size_t MicrotaskQueue::RunDueTasks() {
+  size_t count = 0;
+  while (size_ > 0 && tasks_[head_].sequence <= JS_GetExecutedJobCount(runtime_)) {
+    // Dequeue first, the callback may enqueue new tasks.
+    Task task = tasks_[head_];
+    head_ = (head_ + 1) % tasks_.size();
+    size_--;
+    task.callback(task.data);
+    count++;
+  }
+  return count;
+}
+
+void MicrotaskQueue::RemoveTasks(ExecutingContext* context) {
+  size_t kept = 0;
+  for (size_t i = 0; i < size_; i++) {
+    const Task& task = tasks_[(head_ + i) % tasks_.size()];
+    if (task.context != context) {
+      tasks_[(head_ + kept) % tasks_.size()] = task;
+      kept++;
+    }
+  }
+  size_ = kept;
+}
+
+void MicrotaskQueue::Grow() {
+  std::vector<Task> tasks(tasks_.size() * 2);
+  for (size_t i = 0; i < size_; i++) {
+    tasks[i] = tasks_[(head_ + i) % tasks_.size()];
+  }
+  tasks_.swap(tasks);
+  head_ = 0;
+}
+
+}  // namespace webf
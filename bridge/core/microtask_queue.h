@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef WEBF_CORE_MICROTASK_QUEUE_H_
+#define WEBF_CORE_MICROTASK_QUEUE_H_
+
+#include <quickjs/quickjs.h>
+#include <cstdint>
+#include <vector>
+
+namespace webf {
+
+class ExecutingContext;
+
+using MicrotaskCallback = void (*)(void* data);
+
+// The native microtasks of the JSRuntime of the current thread, kept in a ring buffer so that enqueuing one does not
+// allocate once the ring has grown to the working size.
+//
+// Native microtasks and the jobs of QuickJS form a single FIFO queue: every task records how many jobs had been
+// enqueued before it, and only runs once QuickJS has executed that many jobs.
+class MicrotaskQueue {
+ public:
+  static constexpr size_t kInitialCapacity = 64;
+
+  explicit MicrotaskQueue(JSRuntime* runtime);
+
+  void Enqueue(ExecutingContext* context, MicrotaskCallback callback, void* data);
+  // Runs the tasks due before the next pending job of QuickJS, including the tasks they enqueue themselves when no job
+  // was enqueued in between. Returns the number of tasks run.
+  size_t RunDueTasks();
+  // Drops the tasks of a context being destroyed, their data is owned by the context.
+  void RemoveTasks(ExecutingContext* context);
+
+  bool empty() const { return size_ == 0; }
+  size_t size() const { return size_; }
+
+ private:
+  struct Task {
+    ExecutingContext* context;
+    MicrotaskCallback callback;
+    void* data;
+    // JS_GetEnqueuedJobCount() when the task was enqueued.
+    uint64_t sequence;
+  };
+
+  void Grow();
+
+  JSRuntime* runtime_;
+  std::vector<Task> tasks_;
+  size_t head_{0};
+  size_t size_{0};
+};
+
+}  // namespace webf
+
+#endif  // WEBF_CORE_MICROTASK_QUEUE_H_
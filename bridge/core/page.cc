@@ -136,6 +136,12 @@ bool WebFPage::evaluateByteCode(uint8_t* bytes, size_t byteLength) {
   return context_->EvaluateByteCode(bytes, byteLength);
 }
 
+bool WebFPage::evaluateByteCodeFile(const char* path) {
+  if (!context_->IsContextValid())
+    return false;
+  return context_->EvaluateByteCodeFile(path);
+}
+
 std::thread::id WebFPage::currentThread() const {
   return ownerThreadId;
 }
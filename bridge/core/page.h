@@ -53,6 +53,7 @@ class WebFPage final {
   void evaluateScript(const char* script, size_t length, const char* url, int startLine);
   uint8_t* dumpByteCode(const char* script, size_t length, const char* url, uint64_t* byteLength);
   bool evaluateByteCode(uint8_t* bytes, size_t byteLength);
+  bool evaluateByteCodeFile(const char* path);
 
   std::thread::id currentThread() const;
 
@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "page_memory.h"
+#include <algorithm>
+#include "core/dom/events/event.h"
+#include "core/executing_context.h"
+#include "core/frame/window.h"
+#include "event_type_names.h"
+#include "foundation/logging.h"
+
+namespace webf {
+
+JSContext* PageMemory::ctx() const {
+  return context_->GetScriptState()->ctx();
+}
+
+void PageMemory::SetLimits(int64_t soft_limit, int64_t hard_limit) {
+  soft_limit_ = std::max<int64_t>(soft_limit, 0);
+  hard_limit_ = std::max<int64_t>(hard_limit, 0);
+  CheckLimits();
+}
+
+PageMemory::Usage PageMemory::usage() const {
+  Usage usage;
+  usage.js_heap = js_heap_bytes_;
+  usage.dom_wrappers = native_bytes_[kDOMWrappers];
+  usage.ui_commands = native_bytes_[kUICommands];
+  usage.blobs = native_bytes_[kBlobs];
+  return usage;
+}
+
+void PageMemory::UpdateJSHeapSize(int64_t bytes) {
+  js_heap_bytes_ = bytes;
+  measurement_requested_ = false;
+  CheckLimits();
+}
+
+void PageMemory::CheckLimits() {
+  if (terminated_)
+    return;
+
+  int64_t total = usage().total();
+
+  if (hard_limit_ > 0 && total > hard_limit_) {
+    // Only sets a flag, it is safe in the middle of an allocation or a collection.
+    JS_TerminateExecution(ctx());
+    terminated_ = true;
+    memory_pressure_pending_ = false;
+    WEBF_LOG(ERROR) << "The page " << context_->contextId() << " uses " << total << " bytes, over its limit of "
+                    << hard_limit_ << " bytes. Its scripts are terminated." << std::endl;
+    return;
+  }
+
+  bool over_soft_limit = soft_limit_ > 0 && total > soft_limit_;
+  if (over_soft_limit && !over_soft_limit_) {
+    memory_pressure_pending_ = true;
+  }
+  over_soft_limit_ = over_soft_limit;
+}
+
+void PageMemory::DispatchPendingEvents() {
+  if (!memory_pressure_pending_ || context_->window() == nullptr)
+    return;
+  memory_pressure_pending_ = false;
+
+  ExceptionState exception_state;
+  MemberMutationScope scope{context_};
+  auto* event = Event::Create(context_, event_type_names::kmemorypressure, exception_state);
+  context_->window()->dispatchEvent(event, exception_state);
+  context_->HandleException(exception_state);
+}
+
+}  // namespace webf
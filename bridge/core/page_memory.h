@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef WEBF_CORE_PAGE_MEMORY_H_
+#define WEBF_CORE_PAGE_MEMORY_H_
+
+#include <quickjs/quickjs.h>
+#include <atomic>
+#include <cstdint>
+
+namespace webf {
+
+class ExecutingContext;
+
+// The memory attributed to one page. The pages of a JS thread share one JSRuntime, so the JS heap of a page is
+// estimated from the objects of its realm, measured by the GCScheduler after the full collections. The native memory
+// kept for the page is counted as it is allocated.
+//
+// Past the soft limit the window receives a `memorypressure` event, past the hard limit the scripts of the page are
+// terminated: the running script unwinds with an uncatchable error and no script of the page runs afterwards.
+class PageMemory {
+ public:
+  enum Category { kDOMWrappers = 0, kUICommands, kBlobs, kCategoryCount };
+
+  struct Usage {
+    int64_t js_heap{0};
+    int64_t dom_wrappers{0};
+    int64_t ui_commands{0};
+    int64_t blobs{0};
+
+    int64_t total() const { return js_heap + dom_wrappers + ui_commands + blobs; }
+  };
+
+  explicit PageMemory(ExecutingContext* context) : context_(context) {}
+
+  JSContext* ctx() const;
+
+  void Allocated(Category category, int64_t bytes) {
+    native_bytes_[category] += bytes;
+    if (HasLimits()) {
+      CheckLimits();
+    }
+  }
+  void Freed(Category category, int64_t bytes) { native_bytes_[category] -= bytes; }
+
+  // 0 disables a limit.
+  void SetLimits(int64_t soft_limit, int64_t hard_limit);
+  bool HasLimits() const { return soft_limit_ > 0 || hard_limit_ > 0; }
+
+  // May be read from any thread, the JS heap is the one of the last measurement.
+  Usage usage() const;
+  // Measures the JS heap after the next collection.
+  void RequestMeasurement() { measurement_requested_ = true; }
+  bool NeedsMeasurement() const { return HasLimits() || measurement_requested_; }
+  void UpdateJSHeapSize(int64_t bytes);
+
+  // Fires the `memorypressure` event queued when the page went past the soft limit, outside of scripts.
+  void DispatchPendingEvents();
+  bool terminated() const { return terminated_; }
+
+ private:
+  void CheckLimits();
+
+  ExecutingContext* context_;
+  std::atomic<int64_t> js_heap_bytes_{0};
+  std::atomic<int64_t> native_bytes_[kCategoryCount]{};
+  std::atomic<bool> measurement_requested_{false};
+  int64_t soft_limit_{0};
+  int64_t hard_limit_{0};
+  // Set when the page goes past the soft limit, cleared when it is back under it.
+  bool over_soft_limit_{false};
+  bool memory_pressure_pending_{false};
+  bool terminated_{false};
+};
+
+}  // namespace webf
+
+#endif  // WEBF_CORE_PAGE_MEMORY_H_
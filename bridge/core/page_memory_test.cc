@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "page_memory.h"
+#include "gtest/gtest.h"
+#include "page.h"
+#include "webf_test_env.h"
+
+using namespace webf;
+
+TEST(PageMemory, attributesTheJSHeapToPages) {
+  auto env = TEST_init();
+  auto env2 = TEST_init();
+  auto* context = env->page()->executingContext();
+  auto* scheduler = context->dartIsolateContext()->gcScheduler();
+
+  scheduler->MeasurePages();
+  int64_t js_heap = context->pageMemory()->usage().js_heap;
+  int64_t js_heap2 = env2->page()->executingContext()->pageMemory()->usage().js_heap;
+  EXPECT_GT(js_heap, 0);
+
+  const char* code = "globalThis.retained = new Array(10000).fill(0).map((_, i) => ({i}));";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+  scheduler->MeasurePages();
+  EXPECT_GT(context->pageMemory()->usage().js_heap, js_heap + 10000 * 16);
+  EXPECT_LT(env2->page()->executingContext()->pageMemory()->usage().js_heap, js_heap2 + 10000);
+}
+
+TEST(PageMemory, measuredAfterFullCollections) {
+  auto env = TEST_init();
+  auto* context = env->page()->executingContext();
+  auto* page_memory = context->pageMemory();
+  JSRuntime* runtime = context->dartIsolateContext()->runtime();
+
+  page_memory->RequestMeasurement();
+  JS_RunMinorGC(runtime);
+  EXPECT_TRUE(page_memory->NeedsMeasurement());
+  JS_RunGC(runtime);
+  EXPECT_FALSE(page_memory->NeedsMeasurement());
+  EXPECT_GT(page_memory->usage().js_heap, 0);
+}
+
+TEST(PageMemory, countsNativeMemory) {
+  auto env = TEST_init();
+  auto* page_memory = env->page()->executingContext()->pageMemory();
+  PageMemory::Usage usage = page_memory->usage();
+  EXPECT_GT(usage.dom_wrappers, 0);
+  EXPECT_GT(usage.ui_commands, 0);
+
+  const char* code =
+      "globalThis.blob = new Blob(['a'.repeat(1024 * 1024)]);"
+      "globalThis.div = document.createElement('div');";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+  EXPECT_GE(page_memory->usage().blobs, usage.blobs + 1024 * 1024);
+  EXPECT_GT(page_memory->usage().dom_wrappers, usage.dom_wrappers);
+}
+
+TEST(PageMemory, softLimitDispatchesMemoryPressure) {
+  static bool errorHandlerExecuted = false;
+  auto errorHandler = [](double contextId, const char* errmsg) {
+    errorHandlerExecuted = true;
+    WEBF_LOG(VERBOSE) << errmsg;
+  };
+  auto env = TEST_init(errorHandler);
+  auto* page_memory = env->page()->executingContext()->pageMemory();
+  page_memory->SetLimits(page_memory->usage().total() + 512 * 1024, 0);
+
+  const char* code =
+      "globalThis.pressures = 0;"
+      "addEventListener('memorypressure', () => pressures++);"
+      "globalThis.blob = new Blob(['a'.repeat(1024 * 1024)]);";
+  env->page()->evaluateScript(code, strlen(code), "vm://", 0);
+
+  // Only once while the page stays over the limit.
+  const char* check = "globalThis.blob2 = new Blob(['a']); if (pressures !== 1) throw new Error(pressures);";
+  env->page()->evaluateScript(check, strlen(check), "vm://", 0);
+  EXPECT_EQ(errorHandlerExecuted, false);
+  EXPECT_EQ(page_memory->terminated(), false);
+}
+
+TEST(PageMemory, hardLimitTerminatesScripts) {
+  static bool errorHandlerExecuted = false;
+  auto errorHandler = [](double contextId, const char* errmsg) { errorHandlerExecuted = true; };
+  auto env = TEST_init(errorHandler);
+  auto* page_memory = env->page()->executingContext()->pageMemory();
+  page_memory->SetLimits(0, page_memory->usage().total() + 4 * 1024 * 1024);
+
+  const char* code =
+      "addEventListener('error', () => {});"
+      "let blobs = []; while (true) { try { blobs.push(new Blob(['a'.repeat(1024 * 1024)])); } catch (e) {} }";
+  EXPECT_FALSE(env->page()->evaluateScript(code, strlen(code), "vm://", 0));
+  EXPECT_EQ(page_memory->terminated(), true);
+
+  const char* next = "globalThis.ran = true;";
+  EXPECT_FALSE(env->page()->evaluateScript(next, strlen(next), "vm://", 0));
+  EXPECT_EQ(errorHandlerExecuted, false);
+}
@@ -0,0 +1,278 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "sampling_profiler.h"
+#include <algorithm>
+#include <map>
+#include <unordered_map>
+
+namespace webf {
+
+namespace {
+
+std::string AtomToString(JSContext* ctx, JSAtom atom) {
+  if (atom == JS_ATOM_NULL)
+    return "";
+  const char* chars = JS_AtomToCString(ctx, atom);
+  if (chars == nullptr)
+    return "";
+  std::string result = chars;
+  JS_FreeCString(ctx, chars);
+  return result;
+}
+
+// The pprof profile is small enough to be encoded by hand, see
+// https://github.com/google/pprof/blob/main/proto/profile.proto for the fields.
+class ProtoWriter {
+ public:
+  void WriteVarint(uint64_t value) {
+    while (value >= 0x80) {
+      buffer_.push_back(static_cast<char>(value | 0x80));
+      value >>= 7;
+    }
+    buffer_.push_back(static_cast<char>(value));
+  }
+  void WriteInt(uint32_t field, uint64_t value) {
+    WriteVarint(field << 3);
+    WriteVarint(value);
+  }
+  void WriteBytes(uint32_t field, const std::string& bytes) {
+    WriteVarint(field << 3 | 2);
+    WriteVarint(bytes.size());
+    buffer_.append(bytes);
+  }
+  void WritePacked(uint32_t field, const std::vector<uint64_t>& values) {
+    ProtoWriter packed;
+    for (uint64_t value : values)
+      packed.WriteVarint(value);
+    WriteBytes(field, packed.buffer());
+  }
+  const std::string& buffer() const { return buffer_; }
+
+ private:
+  std::string buffer_;
+};
+
+}  // namespace
+
+SamplingProfiler::SamplingProfiler(JSRuntime* runtime) : runtime_(runtime) {}
+
+SamplingProfiler::~SamplingProfiler() {
+  Stop();
+  Clear();
+}
+
+void SamplingProfiler::Start(int64_t interval_us, size_t capacity) {
+  Stop();
+  Clear();
+  interval_us_ = std::max<int64_t>(interval_us, 1);
+  capacity_ = std::max<size_t>(capacity, 1);
+  frames_.assign(capacity_ * kMaxStackDepth, JSStackFrameInfo{});
+  depths_.assign(capacity_, 0);
+  start_time_ = std::chrono::system_clock::now();
+  start_ = end_ = std::chrono::steady_clock::now();
+
+  stopping_ = false;
+  sample_requested_ = false;
+  JS_SetInterruptHandler(runtime_, HandleInterrupt, this);
+  timer_ = std::thread([this]() {
+    std::unique_lock<std::mutex> lock(timer_mutex_);
+    while (!timer_condition_.wait_for(lock, std::chrono::microseconds(interval_us_), [this] { return stopping_; })) {
+      sample_requested_.store(true, std::memory_order_relaxed);
+    }
+  });
+}
+
+void SamplingProfiler::Stop() {
+  if (!running())
+    return;
+  {
+    std::lock_guard<std::mutex> lock(timer_mutex_);
+    stopping_ = true;
+  }
+  timer_condition_.notify_one();
+  timer_.join();
+  JS_SetInterruptHandler(runtime_, nullptr, nullptr);
+  end_ = std::chrono::steady_clock::now();
+}
+
+void SamplingProfiler::Clear() {
+  size_t stored = std::min(sample_count_, capacity_);
+  for (size_t i = 0; i < stored; i++) {
+    JSStackFrameInfo* frames = &frames_[i * kMaxStackDepth];
+    for (int j = 0; j < depths_[i]; j++) {
+      JS_FreeAtomRT(runtime_, frames[j].function_name);
+      JS_FreeAtomRT(runtime_, frames[j].filename);
+    }
+  }
+  frames_.clear();
+  depths_.clear();
+  capacity_ = 0;
+  next_sample_ = 0;
+  sample_count_ = 0;
+}
+
+int SamplingProfiler::HandleInterrupt(JSRuntime* runtime, void* opaque) {
+  auto* profiler = static_cast<SamplingProfiler*>(opaque);
+  if (profiler->sample_requested_.exchange(false, std::memory_order_relaxed)) {
+    profiler->TakeSample();
+  }
+  return 0;
+}
+
+void SamplingProfiler::TakeSample() {
+  JSStackFrameInfo* frames = &frames_[next_sample_ * kMaxStackDepth];
+  // Release the oldest sample when the ring is full.
+  for (int i = 0; i < depths_[next_sample_]; i++) {
+    JS_FreeAtomRT(runtime_, frames[i].function_name);
+    JS_FreeAtomRT(runtime_, frames[i].filename);
+  }
+  depths_[next_sample_] = 0;
+
+  int depth = JS_GetStackFrames(runtime_, frames, kMaxStackDepth);
+  if (depth == 0)
+    return;
+  for (int i = 0; i < depth; i++) {
+    // JS_DupAtomRT leaves JS_ATOM_NULL and the static atoms alone.
+    JS_DupAtomRT(runtime_, frames[i].function_name);
+    JS_DupAtomRT(runtime_, frames[i].filename);
+  }
+  depths_[next_sample_] = static_cast<uint8_t>(depth);
+  next_sample_ = (next_sample_ + 1) % capacity_;
+  sample_count_++;
+}
+
+template <typename Visitor>
+void SamplingProfiler::ForEachSample(Visitor&& visitor) const {
+  size_t stored = std::min(sample_count_, capacity_);
+  size_t first = sample_count_ > capacity_ ? next_sample_ : 0;
+  for (size_t i = 0; i < stored; i++) {
+    size_t sample = (first + i) % capacity_;
+    visitor(&frames_[sample * kMaxStackDepth], depths_[sample]);
+  }
+}
+
+std::string SamplingProfiler::Export(JSContext* ctx, Format format) const {
+  switch (format) {
+    case Format::kPprof:
+      return ToPprof(ctx);
+    case Format::kCollapsedStacks:
+    default:
+      return ToCollapsedStacks(ctx);
+  }
+}
+
+std::string SamplingProfiler::ToCollapsedStacks(JSContext* ctx) const {
+  std::map<std::string, uint64_t> stacks;
+  ForEachSample([&](const JSStackFrameInfo* frames, int depth) {
+    std::string stack;
+    for (int i = depth - 1; i >= 0; i--) {
+      std::string name = AtomToString(ctx, frames[i].function_name);
+      stack += name.empty() ? "(anonymous)" : name;
+      if (frames[i].filename != JS_ATOM_NULL) {
+        stack += " (" + AtomToString(ctx, frames[i].filename) + ":" + std::to_string(frames[i].line_num) + ")";
+      } else {
+        stack += " (native)";
+      }
+      if (i > 0)
+        stack += ';';
+    }
+    stacks[stack]++;
+  });
+
+  std::string result;
+  for (auto& entry : stacks) {
+    result += entry.first + " " + std::to_string(entry.second) + "\n";
+  }
+  return result;
+}
+
+std::string SamplingProfiler::ToPprof(JSContext* ctx) const {
+  std::vector<std::string> strings{""};
+  std::unordered_map<std::string, uint64_t> string_ids{{"", 0}};
+  auto intern = [&](const std::string& string) -> uint64_t {
+    auto it = string_ids.find(string);
+    if (it != string_ids.end())
+      return it->second;
+    string_ids[string] = strings.size();
+    strings.push_back(string);
+    return strings.size() - 1;
+  };
+
+  ProtoWriter profile;
+  auto write_value_type = [&](uint32_t field, const char* type, const char* unit) {
+    ProtoWriter value_type;
+    value_type.WriteInt(1, intern(type));
+    value_type.WriteInt(2, intern(unit));
+    profile.WriteBytes(field, value_type.buffer());
+  };
+  write_value_type(1, "samples", "count");
+  write_value_type(1, "cpu", "nanoseconds");
+
+  // Functions are keyed by their name and file atoms, locations by their function and line.
+  std::map<std::pair<JSAtom, JSAtom>, uint64_t> function_ids;
+  std::map<std::pair<uint64_t, int>, uint64_t> location_ids;
+  std::map<std::vector<uint64_t>, uint64_t> samples;
+  ForEachSample([&](const JSStackFrameInfo* frames, int depth) {
+    std::vector<uint64_t> locations;
+    for (int i = 0; i < depth; i++) {
+      auto function_key = std::make_pair(frames[i].function_name, frames[i].filename);
+      auto function = function_ids.find(function_key);
+      if (function == function_ids.end()) {
+        uint64_t id = function_ids.size() + 1;
+        function = function_ids.emplace(function_key, id).first;
+        std::string name = AtomToString(ctx, frames[i].function_name);
+        uint64_t name_id = intern(name.empty() ? "(anonymous)" : name);
+        ProtoWriter message;
+        message.WriteInt(1, id);
+        message.WriteInt(2, name_id);
+        message.WriteInt(3, name_id);
+        message.WriteInt(4, intern(AtomToString(ctx, frames[i].filename)));
+        profile.WriteBytes(5, message.buffer());
+      }
+
+      auto location_key = std::make_pair(function->second, frames[i].line_num);
+      auto location = location_ids.find(location_key);
+      if (location == location_ids.end()) {
+        uint64_t id = location_ids.size() + 1;
+        location = location_ids.emplace(location_key, id).first;
+        ProtoWriter line;
+        line.WriteInt(1, function->second);
+        line.WriteInt(2, std::max(frames[i].line_num, 0));
+        ProtoWriter message;
+        message.WriteInt(1, id);
+        message.WriteBytes(4, line.buffer());
+        profile.WriteBytes(4, message.buffer());
+      }
+      locations.push_back(location->second);
+    }
+    samples[locations]++;
+  });
+
+  uint64_t period = interval_us_ * 1000;
+  for (auto& sample : samples) {
+    ProtoWriter message;
+    message.WritePacked(1, sample.first);
+    message.WritePacked(2, {sample.second, sample.second * period});
+    profile.WriteBytes(2, message.buffer());
+  }
+
+  auto end = running() ? std::chrono::steady_clock::now() : end_;
+  profile.WriteInt(9, std::chrono::duration_cast<std::chrono::nanoseconds>(start_time_.time_since_epoch()).count());
+  profile.WriteInt(10, std::chrono::duration_cast<std::chrono::nanoseconds>(end - start_).count());
+  {
+    ProtoWriter period_type;
+    period_type.WriteInt(1, intern("cpu"));
+    period_type.WriteInt(2, intern("nanoseconds"));
+    profile.WriteBytes(11, period_type.buffer());
+  }
+  profile.WriteInt(12, period);
+  // The string table goes last, every string is interned by now.
+  for (auto& string : strings) {
+    profile.WriteBytes(6, string);
+  }
+  return profile.buffer();
+}
+
+}  // namespace webf
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef WEBF_CORE_SAMPLING_PROFILER_H_
+#define WEBF_CORE_SAMPLING_PROFILER_H_
+
+#include <quickjs/quickjs.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace webf {
+
+// Samples the JS call stacks of the JSRuntime of the current thread. A timer thread raises a flag at every interval,
+// the interrupt handler of QuickJS sees it at its next poll and copies the running frames into a ring buffer allocated
+// when the profiler starts, so that taking a sample never allocates.
+//
+// The samples are exported as collapsed stacks, one `outer;inner count` line per stack, or as a pprof profile.
+class SamplingProfiler {
+ public:
+  enum class Format : int32_t {
+    kCollapsedStacks = 0,
+    kPprof = 1,
+  };
+
+  static constexpr int kMaxStackDepth = 32;
+  static constexpr size_t kDefaultCapacity = 8192;
+  static constexpr int64_t kDefaultIntervalUs = 1000;
+
+  explicit SamplingProfiler(JSRuntime* runtime);
+  ~SamplingProfiler();
+
+  // Starts a new profile, the samples of the previous one are dropped. Keeps the last |capacity| samples.
+  void Start(int64_t interval_us = kDefaultIntervalUs, size_t capacity = kDefaultCapacity);
+  void Stop();
+  bool running() const { return timer_.joinable(); }
+
+  size_t sample_count() const { return sample_count_; }
+  std::string Export(JSContext* ctx, Format format) const;
+
+ private:
+  static int HandleInterrupt(JSRuntime* runtime, void* opaque);
+  void TakeSample();
+  void Clear();
+  std::string ToCollapsedStacks(JSContext* ctx) const;
+  std::string ToPprof(JSContext* ctx) const;
+  // Calls |visitor| with the frames of each sample, the innermost first.
+  template <typename Visitor>
+  void ForEachSample(Visitor&& visitor) const;
+
+  JSRuntime* runtime_;
+  int64_t interval_us_{0};
+  std::chrono::system_clock::time_point start_time_;
+  std::chrono::steady_clock::time_point start_;
+  std::chrono::steady_clock::time_point end_;
+
+  // The frames of sample i are frames_[i * kMaxStackDepth, i * kMaxStackDepth + depths_[i]), their atoms are
+  // duplicated.
+  std::vector<JSStackFrameInfo> frames_;
+  std::vector<uint8_t> depths_;
+  size_t capacity_{0};
+  size_t next_sample_{0};
+  size_t sample_count_{0};
+
+  std::thread timer_;
+  std::mutex timer_mutex_;
+  std::condition_variable timer_condition_;
+  bool stopping_{false};
+  std::atomic<bool> sample_requested_{false};
+};
+
+}  // namespace webf
+
+#endif  // WEBF_CORE_SAMPLING_PROFILER_H_
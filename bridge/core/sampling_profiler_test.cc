@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "sampling_profiler.h"
+#include "gtest/gtest.h"
+
+using namespace webf;
+
+// Runs |hot| for about 50ms.
+static const char* kBusyLoop = R"(
+function hot() {
+  let n = 0;
+  for (let i = 0; i < 1000; i++) n += i;
+  return n;
+}
+function run() {
+  const end = Date.now() + 50;
+  while (Date.now() < end) hot();
+}
+run();
+)";
+
+static void RunBusyLoop(JSContext* ctx) {
+  JSValue result = JS_Eval(ctx, kBusyLoop, strlen(kBusyLoop), "vm://busy.js", JS_EVAL_TYPE_GLOBAL);
+  EXPECT_FALSE(JS_IsException(result));
+  JS_FreeValue(ctx, result);
+}
+
+TEST(SamplingProfiler, collapsedStacks) {
+  JSRuntime* runtime = JS_NewRuntime();
+  JSContext* ctx = JS_NewContext(runtime);
+  {
+    SamplingProfiler profiler(runtime);
+    profiler.Start(500);
+    RunBusyLoop(ctx);
+    profiler.Stop();
+    EXPECT_GT(profiler.sample_count(), 10);
+
+    std::string stacks = profiler.Export(ctx, SamplingProfiler::Format::kCollapsedStacks);
+    EXPECT_NE(stacks.find("<eval> (vm://busy.js:11);run (vm://busy.js:"), std::string::npos) << stacks;
+    EXPECT_NE(stacks.find(";hot (vm://busy.js:"), std::string::npos) << stacks;
+  }
+  JS_FreeContext(ctx);
+  JS_FreeRuntime(runtime);
+}
+
+TEST(SamplingProfiler, pprof) {
+  JSRuntime* runtime = JS_NewRuntime();
+  JSContext* ctx = JS_NewContext(runtime);
+  {
+    SamplingProfiler profiler(runtime);
+    profiler.Start(500);
+    RunBusyLoop(ctx);
+    profiler.Stop();
+
+    std::string profile = profiler.Export(ctx, SamplingProfiler::Format::kPprof);
+    // The first sample type, {type: "samples", unit: "count"} with the strings 1 and 2.
+    EXPECT_EQ(profile.substr(0, 6), std::string("\x0a\x04\x08\x01\x10\x02", 6));
+    EXPECT_NE(profile.find("\x32\x03hot"), std::string::npos);
+    EXPECT_NE(profile.find("\x32\x0cvm://busy.js"), std::string::npos);
+  }
+  JS_FreeContext(ctx);
+  JS_FreeRuntime(runtime);
+}
+
+TEST(SamplingProfiler, keepsTheLastSamples) {
+  JSRuntime* runtime = JS_NewRuntime();
+  JSContext* ctx = JS_NewContext(runtime);
+  {
+    SamplingProfiler profiler(runtime);
+    profiler.Start(200, 4);
+    RunBusyLoop(ctx);
+    profiler.Stop();
+    EXPECT_GT(profiler.sample_count(), 4);
+
+    std::string stacks = profiler.Export(ctx, SamplingProfiler::Format::kCollapsedStacks);
+    int total = 0;
+    for (size_t line = 0; line < stacks.size();) {
+      size_t end = stacks.find('\n', line);
+      total += std::stoi(stacks.substr(stacks.rfind(' ', end) + 1, end));
+      line = end + 1;
+    }
+    EXPECT_EQ(total, 4);
+  }
+  JS_FreeContext(ctx);
+  JS_FreeRuntime(runtime);
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "storage.h"
+#include "core/executing_context.h"
+
+namespace webf {
+
+Storage::Storage(ExecutingContext* context, std::shared_ptr<StorageArea> area)
+    : ScriptWrappable(context->ctx()), area_(std::move(area)) {}
+
+int64_t Storage::length() const {
+  return static_cast<int64_t>(area_->Length());
+}
+
+AtomicString Storage::key(int64_t index, ExceptionState& exception_state) {
+  std::string key;
+  if (index < 0 || !area_->Key(static_cast<size_t>(index), &key))
+    return AtomicString::Null();
+  return AtomicString(ctx(), key);
+}
+
+AtomicString Storage::getItem(const AtomicString& key, ExceptionState& exception_state) {
+  std::string value;
+  if (!area_->GetItem(key.ToStdString(ctx()), &value))
+    return AtomicString::Null();
+  return AtomicString(ctx(), value);
+}
+
+void Storage::setItem(const AtomicString& key, const AtomicString& value, ExceptionState& exception_state) {
+  if (!area_->SetItem(key.ToStdString(ctx()), value.ToStdString(ctx()))) {
+    exception_state.ThrowException(ctx(), ErrorType::InternalError, "Failed to write the item to the storage.");
+  }
+}
+
+void Storage::removeItem(const AtomicString& key, ExceptionState& exception_state) {
+  if (!area_->RemoveItem(key.ToStdString(ctx()))) {
+    exception_state.ThrowException(ctx(), ErrorType::InternalError, "Failed to remove the item from the storage.");
+  }
+}
+
+void Storage::clear(ExceptionState& exception_state) {
+  if (!area_->Clear()) {
+    exception_state.ThrowException(ctx(), ErrorType::InternalError, "Failed to clear the storage.");
+  }
+}
+
+void Storage::SetArea(std::shared_ptr<StorageArea> area) {
+  area_ = std::move(area);
+}
+
+bool Storage::NamedPropertyQuery(const AtomicString& key, ExceptionState& exception_state) {
+  std::string value;
+  return area_->GetItem(key.ToStdString(ctx()), &value);
+}
+
+void Storage::NamedPropertyEnumerator(std::vector<AtomicString>& names, ExceptionState& exception_state) {
+  for (auto& key : area_->Keys()) {
+    names.emplace_back(AtomicString(ctx(), key));
+  }
+}
+
+ScriptValue Storage::item(const AtomicString& key, ExceptionState& exception_state) {
+  // Storage has no [LegacyOverrideBuiltIns], the methods on the prototype take precedence over the stored keys.
+  if (IsPrototypeProperty(key))
+    return ScriptValue::Undefined(ctx());
+
+  std::string value;
+  if (!area_->GetItem(key.ToStdString(ctx()), &value))
+    return ScriptValue::Undefined(ctx());
+  return ScriptValue(ctx(), AtomicString(ctx(), value));
+}
+
+bool Storage::SetItem(const AtomicString& key, const ScriptValue& value, ExceptionState& exception_state) {
+  if (IsPrototypeProperty(key))
+    return false;
+  AtomicString string_value = value.ToString(ctx());
+  setItem(key, string_value, exception_state);
+  return true;
+}
+
+bool Storage::DeleteItem(const AtomicString& key, ExceptionState& exception_state) {
+  removeItem(key, exception_state);
+  return true;
+}
+
+bool Storage::IsPrototypeProperty(const AtomicString& key) {
+  JSValue key_value = JS_AtomToValue(ctx(), key.Impl());
+  bool is_symbol = JS_IsSymbol(key_value);
+  JS_FreeValue(ctx(), key_value);
+  if (is_symbol)
+    return true;
+  JSValue prototype = GetExecutingContext()->contextData()->prototypeForType(GetWrapperTypeInfo());
+  return JS_HasProperty(ctx(), prototype, key.Impl());
+}
+
+}  // namespace webf
@@ -0,0 +1,11 @@
+/** Provides access to a particular domain's session or local storage. */
+interface Storage {
+  readonly length: int64;
+  key(index: int64): string | null;
+  getItem(key: string): string | null;
+  setItem(key: string, value: string): void;
+  removeItem(key: string): void;
+  clear(): void;
+  [key: string]: any;
+  new(): void;
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef WEBF_CORE_STORAGE_STORAGE_H_
+#define WEBF_CORE_STORAGE_STORAGE_H_
+
+#include <memory>
+#include "bindings/qjs/atomic_string.h"
+#include "bindings/qjs/exception_state.h"
+#include "bindings/qjs/script_value.h"
+#include "bindings/qjs/script_wrappable.h"
+#include "storage_area.h"
+
+namespace webf {
+
+class ExecutingContext;
+
+// https://html.spec.whatwg.org/multipage/webstorage.html#the-storage-interface
+class Storage : public ScriptWrappable {
+  DEFINE_WRAPPERTYPEINFO();
+
+ public:
+  using ImplType = Storage*;
+
+  Storage() = delete;
+  explicit Storage(ExecutingContext* context, std::shared_ptr<StorageArea> area);
+
+  int64_t length() const;
+  AtomicString key(int64_t index, ExceptionState& exception_state);
+  AtomicString getItem(const AtomicString& key, ExceptionState& exception_state);
+  void setItem(const AtomicString& key, const AtomicString& value, ExceptionState& exception_state);
+  void removeItem(const AtomicString& key, ExceptionState& exception_state);
+  void clear(ExceptionState& exception_state);
+
+  // Named properties, e.g. `localStorage.foo = 'bar'`.
+  bool NamedPropertyQuery(const AtomicString& key, ExceptionState& exception_state);
+  void NamedPropertyEnumerator(std::vector<AtomicString>& names, ExceptionState& exception_state);
+  ScriptValue item(const AtomicString& key, ExceptionState& exception_state);
+  bool SetItem(const AtomicString& key, const ScriptValue& value, ExceptionState& exception_state);
+  bool DeleteItem(const AtomicString& key, ExceptionState& exception_state);
+
+  StorageArea* area() const { return area_.get(); }
+  void SetArea(std::shared_ptr<StorageArea> area);
+
+ private:
+  bool IsPrototypeProperty(const AtomicString& key);
+
+  std::shared_ptr<StorageArea> area_;
+};
+
+}  // namespace webf
+
+#endif  // WEBF_CORE_STORAGE_STORAGE_H_
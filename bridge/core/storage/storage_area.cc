@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "storage_area.h"
+
+namespace webf {
+
+// Don't bother rewriting small logs.
+static constexpr size_t kMinCompactionSize = 256 * 1024;
+
+std::shared_ptr<StorageArea> StorageArea::Open(const std::string& directory) {
+  static std::mutex areas_mutex;
+  static std::unordered_map<std::string, std::weak_ptr<StorageArea>> areas;
+
+  std::lock_guard<std::mutex> areas_lock(areas_mutex);
+  std::shared_ptr<StorageArea> area = areas[directory].lock();
+  if (area != nullptr)
+    return area;
+
+  area = std::make_shared<StorageArea>(nullptr);
+  std::string path = directory + "/" + kLogFileName;
+  area->log_ = StorageLog::Open(path, [&area](StorageLog::Op op, std::string&& key, std::string&& value) {
+    area->ApplyLocked(op, std::move(key), std::move(value));
+  });
+  if (area->log_ == nullptr) {
+    return CreateInMemory();
+  }
+
+  areas[directory] = area;
+  return area;
+}
+
+std::shared_ptr<StorageArea> StorageArea::CreateInMemory() {
+  return std::make_shared<StorageArea>(nullptr);
+}
+
+StorageArea::StorageArea(std::unique_ptr<StorageLog> log) : log_(std::move(log)) {}
+
+size_t StorageArea::Length() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.size();
+}
+
+bool StorageArea::Key(size_t index, std::string* key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (index >= entries_.size())
+    return false;
+  *key = entries_[index].first;
+  return true;
+}
+
+bool StorageArea::GetItem(const std::string& key, std::string* value) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = indexes_.find(key);
+  if (it == indexes_.end())
+    return false;
+  *value = entries_[it->second].second;
+  return true;
+}
+
+bool StorageArea::SetItem(const std::string& key, const std::string& value) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return SetItemLocked(key, value);
+}
+
+bool StorageArea::RemoveItem(const std::string& key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (indexes_.count(key) == 0)
+    return true;
+  if (log_ != nullptr && !log_->Append(StorageLog::Op::kRemove, key, ""))
+    return false;
+  ApplyLocked(StorageLog::Op::kRemove, std::string(key), "");
+  MaybeCompactLocked();
+  return true;
+}
+
+bool StorageArea::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (entries_.empty())
+    return true;
+  if (log_ != nullptr && !log_->Append(StorageLog::Op::kClear, "", ""))
+    return false;
+  ApplyLocked(StorageLog::Op::kClear, "", "");
+  MaybeCompactLocked();
+  return true;
+}
+
+std::vector<std::string> StorageArea::Keys() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<std::string> keys;
+  keys.reserve(entries_.size());
+  for (auto& entry : entries_) {
+    keys.emplace_back(entry.first);
+  }
+  return keys;
+}
+
+StorageLog::Entries StorageArea::Entries() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_;
+}
+
+void StorageArea::Merge(const StorageLog::Entries& entries, bool overwrite) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& entry : entries) {
+    if (!overwrite && indexes_.count(entry.first) > 0)
+      continue;
+    SetItemLocked(entry.first, entry.second);
+  }
+}
+
+size_t StorageArea::LogSize() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return log_ != nullptr ? log_->size() : 0;
+}
+
+bool StorageArea::SetItemLocked(const std::string& key, const std::string& value) {
+  auto it = indexes_.find(key);
+  if (it != indexes_.end() && entries_[it->second].second == value)
+    return true;
+  if (log_ != nullptr && !log_->Append(StorageLog::Op::kSet, key, value))
+    return false;
+  ApplyLocked(StorageLog::Op::kSet, std::string(key), std::string(value));
+  MaybeCompactLocked();
+  return true;
+}
+
+void StorageArea::ApplyLocked(StorageLog::Op op, std::string&& key, std::string&& value) {
+  switch (op) {
+    case StorageLog::Op::kSet: {
+      auto it = indexes_.find(key);
+      if (it != indexes_.end()) {
+        auto& entry = entries_[it->second];
+        live_bytes_ -= StorageLog::RecordSize(entry.first, entry.second);
+        live_bytes_ += StorageLog::RecordSize(entry.first, value);
+        entry.second = std::move(value);
+      } else {
+        live_bytes_ += StorageLog::RecordSize(key, value);
+        indexes_[key] = entries_.size();
+        entries_.emplace_back(std::move(key), std::move(value));
+      }
+      break;
+    }
+    case StorageLog::Op::kRemove: {
+      auto it = indexes_.find(key);
+      if (it == indexes_.end())
+        break;
+      size_t index = it->second;
+      live_bytes_ -= StorageLog::RecordSize(entries_[index].first, entries_[index].second);
+      indexes_.erase(it);
+      if (index != entries_.size() - 1) {
+        entries_[index] = std::move(entries_.back());
+        indexes_[entries_[index].first] = index;
+      }
+      entries_.pop_back();
+      break;
+    }
+    case StorageLog::Op::kClear:
+      entries_.clear();
+      indexes_.clear();
+      live_bytes_ = 0;
+      break;
+  }
+}
+
+void StorageArea::MaybeCompactLocked() {
+  if (log_ == nullptr || log_->size() < kMinCompactionSize)
+    return;
+  // Rewrite the log when more than half of it are stale records.
+  if (log_->size() - StorageLog::kHeaderSize > live_bytes_ * 2) {
+    // A failed compaction leaves the old log in use, it is retried on the next change.
+    log_->Compact(entries_);
+  }
+}
+
+}  // namespace webf
@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef WEBF_CORE_STORAGE_STORAGE_AREA_H_
+#define WEBF_CORE_STORAGE_STORAGE_AREA_H_
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "storage_log.h"
+
+namespace webf {
+
+// The key/value pairs behind a Storage object.
+//
+// Reads are served from memory. A persistent area appends every change to a StorageLog and rewrites the log once
+// most of it is made of overwritten records. Areas opened from the same directory are shared by all the pages in the
+// process, so the methods can be called from different JS threads.
+class StorageArea {
+ public:
+  static constexpr const char* kLogFileName = "local_storage.log";
+
+  // Opens the area persisted in |directory|, an in-memory area is returned when the log file can't be opened.
+  static std::shared_ptr<StorageArea> Open(const std::string& directory);
+  static std::shared_ptr<StorageArea> CreateInMemory();
+
+  explicit StorageArea(std::unique_ptr<StorageLog> log);
+
+  size_t Length();
+  bool Key(size_t index, std::string* key);
+  bool GetItem(const std::string& key, std::string* value);
+  // The mutations return false and leave the area unchanged when the change can't be written to the log.
+  bool SetItem(const std::string& key, const std::string& value);
+  bool RemoveItem(const std::string& key);
+  bool Clear();
+  std::vector<std::string> Keys();
+  StorageLog::Entries Entries();
+  // Stores each of |entries|, the existing keys are kept unless |overwrite| is set.
+  void Merge(const StorageLog::Entries& entries, bool overwrite);
+
+  bool IsPersistent() const { return log_ != nullptr; }
+  size_t LogSize();
+
+ private:
+  bool SetItemLocked(const std::string& key, const std::string& value);
+  void ApplyLocked(StorageLog::Op op, std::string&& key, std::string&& value);
+  void MaybeCompactLocked();
+
+  std::mutex mutex_;
+  // Entries are kept in a vector for key(index), removal moves the last entry into the hole.
+  std::vector<std::pair<std::string, std::string>> entries_;
+  std::unordered_map<std::string, size_t> indexes_;
+  size_t live_bytes_{0};
+  std::unique_ptr<StorageLog> log_;
+};
+
+}  // namespace webf
+
+#endif  // WEBF_CORE_STORAGE_STORAGE_AREA_H_
@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "storage_area.h"
+#include <cstdio>
+#include <filesystem>
+#include "core/frame/window.h"
+#include "gtest/gtest.h"
+#include "storage.h"
+#include "webf_test_env.h"
+
+using namespace webf;
+
+static std::string CreateStorageDirectory(const char* name) {
+  auto directory = std::filesystem::temp_directory_path() / "webf_storage_test" / name;
+  std::filesystem::remove_all(directory);
+  std::filesystem::create_directories(directory);
+  return directory.string();
+}
+
+static std::string GetItem(StorageArea* area, const std::string& key) {
+  std::string value;
+  return area->GetItem(key, &value) ? value : "<null>";
+}
+
+TEST(StorageArea, persistence) {
+  std::string directory = CreateStorageDirectory("persistence");
+  {
+    auto area = StorageArea::Open(directory);
+    EXPECT_EQ(area->IsPersistent(), true);
+    area->SetItem("a", "1");
+    area->SetItem("b", "2");
+    area->SetItem("a", "3");
+    area->RemoveItem("b");
+    area->SetItem("c", "中文");
+  }
+
+  auto area = StorageArea::Open(directory);
+  EXPECT_EQ(area->Length(), 2);
+  EXPECT_EQ(GetItem(area.get(), "a"), "3");
+  EXPECT_EQ(GetItem(area.get(), "b"), "<null>");
+  EXPECT_EQ(GetItem(area.get(), "c"), "中文");
+
+  area->Clear();
+  area.reset();
+  EXPECT_EQ(StorageArea::Open(directory)->Length(), 0);
+}
+
+TEST(StorageArea, sharedByDirectory) {
+  std::string directory = CreateStorageDirectory("shared");
+  auto a = StorageArea::Open(directory);
+  auto b = StorageArea::Open(directory);
+  EXPECT_EQ(a.get(), b.get());
+}
+
+TEST(StorageArea, recoverFromTornWrite) {
+  std::string directory = CreateStorageDirectory("torn");
+  std::string path = directory + "/" + StorageArea::kLogFileName;
+  size_t complete_size;
+  {
+    auto area = StorageArea::Open(directory);
+    area->SetItem("a", "1");
+    complete_size = area->LogSize();
+    area->SetItem("b", "2");
+  }
+
+  // Damage the last record, as if the process was killed in the middle of writing it.
+  FILE* file = fopen(path.c_str(), "r+b");
+  fseek(file, static_cast<long>(complete_size + StorageLog::kRecordHeaderSize), SEEK_SET);
+  fputc('x', file);
+  fclose(file);
+
+  auto area = StorageArea::Open(directory);
+  EXPECT_EQ(area->Length(), 1);
+  EXPECT_EQ(GetItem(area.get(), "a"), "1");
+  EXPECT_EQ(area->LogSize(), complete_size);
+
+  area->SetItem("c", "3");
+  area.reset();
+  area = StorageArea::Open(directory);
+  EXPECT_EQ(area->Length(), 2);
+  EXPECT_EQ(GetItem(area.get(), "c"), "3");
+}
+
+TEST(StorageArea, compaction) {
+  std::string directory = CreateStorageDirectory("compaction");
+  auto area = StorageArea::Open(directory);
+  std::string value(1024, 'v');
+  for (int i = 0; i < 1000; i++) {
+    area->SetItem("key", value + std::to_string(i));
+  }
+  // The log is rewritten once most of it are overwritten values.
+  EXPECT_LT(area->LogSize(), 256 * 1024 * 2);
+
+  area.reset();
+  area = StorageArea::Open(directory);
+  EXPECT_EQ(area->Length(), 1);
+  EXPECT_EQ(GetItem(area.get(), "key"), value + "999");
+}
+
+TEST(StorageArea, merge) {
+  std::string directory = CreateStorageDirectory("merge");
+  auto area = StorageArea::Open(directory);
+  area->SetItem("a", "1");
+  area->Merge({{"a", "2"}, {"b", "2"}}, false);
+  EXPECT_EQ(GetItem(area.get(), "a"), "1");
+  EXPECT_EQ(GetItem(area.get(), "b"), "2");
+  area->Merge({{"a", "3"}}, true);
+  EXPECT_EQ(GetItem(area.get(), "a"), "3");
+
+  area.reset();
+  area = StorageArea::Open(directory);
+  EXPECT_EQ(area->Length(), 2);
+  EXPECT_EQ(GetItem(area.get(), "a"), "3");
+}
+
+TEST(Storage, migrateLegacyEntries) {
+  auto env = TEST_init();
+  std::string directory = CreateStorageDirectory("legacy");
+  env->page()->executingContext()->SetLocalStorageDirectory(directory, {{"a", "1"}, {"b", "2"}});
+  auto area = StorageArea::Open(directory);
+  EXPECT_EQ(area->Length(), 2);
+  EXPECT_EQ(GetItem(area.get(), "b"), "2");
+}
+
+TEST(Storage, localStorageBeforeDirectory) {
+  bool static errorCalled = false;
+  auto env = TEST_init([](double contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  std::string directory = CreateStorageDirectory("before_directory");
+  StorageArea::Open(directory)->SetItem("persisted", "1");
+
+  std::string code = "localStorage.setItem('early', 'a');";
+  env->page()->evaluateScript(code.c_str(), code.size(), "vm://", 0);
+  env->page()->executingContext()->SetLocalStorageDirectory(directory, {});
+
+  auto* storage = env->page()->executingContext()->window()->localStorage();
+  EXPECT_EQ(storage->area()->IsPersistent(), true);
+  EXPECT_EQ(GetItem(storage->area(), "early"), "a");
+  EXPECT_EQ(GetItem(storage->area(), "persisted"), "1");
+  EXPECT_EQ(errorCalled, false);
+}
+
+TEST(Storage, localStorage) {
+  bool static errorCalled = false;
+  bool static logCalled = false;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logCalled = true;
+    EXPECT_STREQ(message.c_str(), "1 null 2 true b,a 2 function undefined 0");
+  };
+  auto env = TEST_init([](double contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  env->page()->executingContext()->SetLocalStorageDirectory(CreateStorageDirectory("local_storage"), {});
+  std::string code = R"(
+localStorage.setItem('a', 1);
+const a = localStorage.getItem('a');
+const missing = localStorage.getItem('missing');
+localStorage.b = 2;
+const b = localStorage.getItem('b');
+const hasB = 'b' in localStorage;
+const keys = Object.keys(localStorage).sort().reverse().join(',');
+const length = localStorage.length;
+const getItem = typeof localStorage.getItem;
+delete localStorage.a;
+const deleted = localStorage.a;
+localStorage.clear();
+console.log(a, missing, b, hasB, keys, length, getItem, deleted, localStorage.length);
+)";
+  env->page()->evaluateScript(code.c_str(), code.size(), "vm://", 0);
+
+  EXPECT_EQ(errorCalled, false);
+  EXPECT_EQ(logCalled, true);
+}
@@ -0,0 +1,313 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "storage_log.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#if WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "foundation/crc32.h"
+
+namespace webf {
+
+static constexpr char kMagic[8] = {'W', 'E', 'B', 'F', 'K', 'V', 'S', '1'};
+static constexpr uint32_t kVersion = 1;
+static constexpr size_t kInitialCapacity = 64 * 1024;
+
+static void WriteHeader(uint8_t* dst) {
+  memcpy(dst, kMagic, sizeof(kMagic));
+  uint32_t version = kVersion;
+  uint32_t reserved = 0;
+  memcpy(dst + 8, &version, sizeof(uint32_t));
+  memcpy(dst + 12, &reserved, sizeof(uint32_t));
+}
+
+static bool IsValidHeader(const uint8_t* src) {
+  uint32_t version;
+  memcpy(&version, src + 8, sizeof(uint32_t));
+  return memcmp(src, kMagic, sizeof(kMagic)) == 0 && version == kVersion;
+}
+
+static void WriteRecord(uint8_t* dst, StorageLog::Op op, const std::string& key, const std::string& value) {
+  auto key_length = static_cast<uint32_t>(key.size());
+  auto value_length = static_cast<uint32_t>(value.size());
+  uint8_t* body = dst + sizeof(uint32_t);
+  body[0] = static_cast<uint8_t>(op);
+  body[1] = body[2] = body[3] = 0;
+  memcpy(body + 4, &key_length, sizeof(uint32_t));
+  memcpy(body + 8, &value_length, sizeof(uint32_t));
+  memcpy(body + 12, key.data(), key_length);
+  memcpy(body + 12 + key_length, value.data(), value_length);
+  // The checksum is written last, an interrupted write leaves a record which fails the check.
+  uint32_t crc = Crc32(body, StorageLog::kRecordHeaderSize - sizeof(uint32_t) + key_length + value_length);
+  memcpy(dst, &crc, sizeof(uint32_t));
+}
+
+std::unique_ptr<StorageLog> StorageLog::Open(const std::string& path, const ReplayCallback& replay) {
+  auto log = std::unique_ptr<StorageLog>(new StorageLog(path));
+  size_t file_size;
+#if WIN32
+  log->file_ = fopen(path.c_str(), "r+b");
+  if (log->file_ == nullptr) {
+    log->file_ = fopen(path.c_str(), "w+b");
+  }
+  if (log->file_ == nullptr)
+    return nullptr;
+  fseek(log->file_, 0, SEEK_END);
+  file_size = static_cast<size_t>(ftell(log->file_));
+#else
+  log->fd_ = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+  if (log->fd_ < 0)
+    return nullptr;
+  struct stat st;
+  if (fstat(log->fd_, &st) != 0)
+    return nullptr;
+  file_size = static_cast<size_t>(st.st_size);
+#endif
+
+  if (!log->Map(std::max(file_size, kInitialCapacity)))
+    return nullptr;
+#if WIN32
+  fseek(log->file_, 0, SEEK_SET);
+  if (fread(log->data_, 1, file_size, log->file_) != file_size)
+    return nullptr;
+#endif
+
+  log->Replay(replay);
+  return log;
+}
+
+StorageLog::StorageLog(std::string path) : path_(std::move(path)) {}
+
+StorageLog::~StorageLog() {
+#if WIN32
+  Unmap();
+  if (file_ != nullptr) {
+    fclose(file_);
+  }
+#else
+  if (data_ != nullptr) {
+    msync(data_, size_, MS_SYNC);
+  }
+  Unmap();
+  if (fd_ >= 0) {
+    close(fd_);
+  }
+#endif
+}
+
+#if !WIN32
+// Grows the file to |capacity| and maps it, returns nullptr on failure.
+static uint8_t* MapFile(int fd, size_t capacity) {
+  // Grow the file first, the pages beyond the end of file can't be accessed.
+  struct stat st;
+  if (fstat(fd, &st) != 0)
+    return nullptr;
+  if (static_cast<size_t>(st.st_size) < capacity && ftruncate(fd, static_cast<off_t>(capacity)) != 0)
+    return nullptr;
+  void* data = mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (data == MAP_FAILED)
+    return nullptr;
+  return static_cast<uint8_t*>(data);
+}
+#endif
+
+// The current mapping is only released once the new one is in place, it stays valid when this fails.
+bool StorageLog::Map(size_t capacity) {
+#if WIN32
+  auto* data = static_cast<uint8_t*>(realloc(data_, capacity));
+  if (data == nullptr)
+    return false;
+  if (capacity > capacity_) {
+    memset(data + capacity_, 0, capacity - capacity_);
+  }
+  data_ = data;
+#else
+  uint8_t* data = MapFile(fd_, capacity);
+  if (data == nullptr)
+    return false;
+  Unmap();
+  data_ = data;
+#endif
+  capacity_ = capacity;
+  return true;
+}
+
+void StorageLog::Unmap() {
+  if (data_ == nullptr)
+    return;
+#if WIN32
+  free(data_);
+#else
+  munmap(data_, capacity_);
+#endif
+  data_ = nullptr;
+  capacity_ = 0;
+}
+
+bool StorageLog::Reserve(size_t size) {
+  if (size_ + size <= capacity_)
+    return true;
+  size_t capacity = std::max(capacity_, kInitialCapacity);
+  while (capacity < size_ + size) {
+    capacity *= 2;
+  }
+  return Map(capacity);
+}
+
+void StorageLog::Replay(const ReplayCallback& replay) {
+  if (!IsValidHeader(data_)) {
+    // A new file, or a file of an unknown format which can't be read.
+    memset(data_, 0, capacity_);
+    WriteHeader(data_);
+    size_ = kHeaderSize;
+#if WIN32
+    _chsize_s(_fileno(file_), 0);
+    fseek(file_, 0, SEEK_SET);
+    fwrite(data_, 1, kHeaderSize, file_);
+    fflush(file_);
+#endif
+    return;
+  }
+
+  size_t offset = kHeaderSize;
+  while (offset + kRecordHeaderSize <= capacity_) {
+    const uint8_t* record = data_ + offset;
+    uint32_t crc, key_length, value_length;
+    memcpy(&crc, record, sizeof(uint32_t));
+    uint8_t op = record[4];
+    memcpy(&key_length, record + 8, sizeof(uint32_t));
+    memcpy(&value_length, record + 12, sizeof(uint32_t));
+
+    if (op < static_cast<uint8_t>(Op::kSet) || op > static_cast<uint8_t>(Op::kClear))
+      break;
+    size_t available = capacity_ - offset - kRecordHeaderSize;
+    if (key_length > available || value_length > available - key_length)
+      break;
+    if (Crc32(record + sizeof(uint32_t), kRecordHeaderSize - sizeof(uint32_t) + key_length + value_length) != crc)
+      break;
+
+    const char* key = reinterpret_cast<const char*>(record + kRecordHeaderSize);
+    replay(static_cast<Op>(op), std::string(key, key_length), std::string(key + key_length, value_length));
+    offset += kRecordHeaderSize + key_length + value_length;
+  }
+  size_ = offset;
+
+  // Clear the broken tail, otherwise the rest of it could be read as records once new records are written over it.
+  uint8_t* end = data_ + capacity_;
+  if (std::any_of(data_ + size_, end, [](uint8_t byte) { return byte != 0; })) {
+    memset(data_ + size_, 0, capacity_ - size_);
+#if WIN32
+    _chsize_s(_fileno(file_), static_cast<long long>(size_));
+#endif
+  }
+}
+
+bool StorageLog::Append(Op op, const std::string& key, const std::string& value) {
+  if (data_ == nullptr)
+    return false;
+  size_t record_size = RecordSize(key, value);
+  if (!Reserve(record_size))
+    return false;
+  WriteRecord(data_ + size_, op, key, value);
+#if WIN32
+  fseek(file_, static_cast<long>(size_), SEEK_SET);
+  fwrite(data_ + size_, 1, record_size, file_);
+  fflush(file_);
+#endif
+  size_ += record_size;
+  return true;
+}
+
+bool StorageLog::Compact(const Entries& entries) {
+  size_t size = kHeaderSize;
+  for (auto& entry : entries) {
+    size += RecordSize(entry.first, entry.second);
+  }
+
+  std::vector<uint8_t> bytes(size);
+  WriteHeader(bytes.data());
+  size_t offset = kHeaderSize;
+  for (auto& entry : entries) {
+    WriteRecord(bytes.data() + offset, Op::kSet, entry.first, entry.second);
+    offset += RecordSize(entry.first, entry.second);
+  }
+
+  // Write the new log aside and move it over the old one, a crash leaves one of the two complete files.
+  std::string compact_path = path_ + ".compact";
+  FILE* file = fopen(compact_path.c_str(), "wb");
+  if (file == nullptr)
+    return false;
+  bool written = fwrite(bytes.data(), 1, size, file) == size && fflush(file) == 0;
+#if !WIN32
+  written = written && fsync(fileno(file)) == 0;
+#endif
+  fclose(file);
+  if (!written) {
+    remove(compact_path.c_str());
+    return false;
+  }
+
+  size_t capacity = std::max(size * 2, kInitialCapacity);
+#if WIN32
+  auto* data = static_cast<uint8_t*>(calloc(capacity, 1));
+  if (data == nullptr) {
+    remove(compact_path.c_str());
+    return false;
+  }
+  memcpy(data, bytes.data(), size);
+
+  // Windows can't replace a file which is still open.
+  fclose(file_);
+  bool moved = MoveFileExA(compact_path.c_str(), path_.c_str(), MOVEFILE_REPLACE_EXISTING);
+  file_ = fopen(path_.c_str(), "r+b");
+  if (!moved) {
+    // The old log is still in place and matches the records in memory.
+    free(data);
+    remove(compact_path.c_str());
+    return false;
+  }
+  Unmap();
+  if (file_ == nullptr) {
+    free(data);
+    return false;
+  }
+  data_ = data;
+  capacity_ = capacity;
+#else
+  // Map the new log before it replaces the old one, the old log stays in use when anything fails.
+  int fd = open(compact_path.c_str(), O_RDWR | O_CLOEXEC);
+  uint8_t* data = fd >= 0 ? MapFile(fd, capacity) : nullptr;
+  if (data == nullptr) {
+    if (fd >= 0) {
+      close(fd);
+    }
+    remove(compact_path.c_str());
+    return false;
+  }
+  if (rename(compact_path.c_str(), path_.c_str()) != 0) {
+    munmap(data, capacity);
+    close(fd);
+    remove(compact_path.c_str());
+    return false;
+  }
+  Unmap();
+  close(fd_);
+  fd_ = fd;
+  data_ = data;
+  capacity_ = capacity;
+#endif
+  size_ = size;
+  return true;
+}
+
+}  // namespace webf
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef WEBF_CORE_STORAGE_STORAGE_LOG_H_
+#define WEBF_CORE_STORAGE_STORAGE_LOG_H_
+
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace webf {
+
+// An append-only log of storage mutations backed by a memory-mapped file.
+//
+// Every record is prefixed with a CRC32 of its content. When the log is opened, records are replayed until the first
+// record which is incomplete or doesn't match its checksum, which is where a crash interrupted the last write. The
+// broken tail is discarded and new records are appended from there.
+//
+// File layout:
+//   header: "WEBFKVS1" uint32(version) uint32(0)
+//   record: uint32(crc) uint8(op) uint8[3](0) uint32(key_length) uint32(value_length) key value
+class StorageLog {
+ public:
+  enum class Op : uint8_t { kSet = 1, kRemove = 2, kClear = 3 };
+
+  using ReplayCallback = std::function<void(Op op, std::string&& key, std::string&& value)>;
+  using Entries = std::vector<std::pair<std::string, std::string>>;
+
+  static constexpr size_t kHeaderSize = 16;
+  static constexpr size_t kRecordHeaderSize = 16;
+
+  // Returns nullptr when the file can't be opened or mapped.
+  static std::unique_ptr<StorageLog> Open(const std::string& path, const ReplayCallback& replay);
+
+  static size_t RecordSize(const std::string& key, const std::string& value) {
+    return kRecordHeaderSize + key.size() + value.size();
+  }
+
+  ~StorageLog();
+
+  bool Append(Op op, const std::string& key, const std::string& value);
+  // Rewrites the log with a kSet record for each entry, the old file is replaced atomically.
+  bool Compact(const Entries& entries);
+
+  // Bytes used by the header and the records.
+  size_t size() const { return size_; }
+  const std::string& path() const { return path_; }
+
+ private:
+  explicit StorageLog(std::string path);
+
+  bool Map(size_t capacity);
+  void Unmap();
+  bool Reserve(size_t size);
+  void Replay(const ReplayCallback& replay);
+
+  std::string path_;
+#if WIN32
+  // Windows keeps the records in a heap buffer and writes them through to the file.
+  FILE* file_{nullptr};
+#else
+  int fd_{-1};
+#endif
+  uint8_t* data_{nullptr};
+  size_t capacity_{0};
+  size_t size_{0};
+};
+
+}  // namespace webf
+
+#endif  // WEBF_CORE_STORAGE_STORAGE_LOG_H_
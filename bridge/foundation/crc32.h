@@ -0,0 +1,36 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+#ifndef BRIDGE_FOUNDATION_CRC32_H_
+#define BRIDGE_FOUNDATION_CRC32_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace webf {
+
+// CRC-32 (IEEE 802.3), used to detect torn or corrupted files written by the bridge.
+inline uint32_t Crc32(const uint8_t* data, size_t length) {
+  static const std::array<uint32_t, 256> table = [] {
+    std::array<uint32_t, 256> result{};
+    for (uint32_t i = 0; i < 256; i++) {
+      uint32_t c = i;
+      for (int k = 0; k < 8; k++) {
+        c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+      }
+      result[i] = c;
+    }
+    return result;
+  }();
+
+  uint32_t crc = 0xFFFFFFFFu;
+  for (size_t i = 0; i < length; i++) {
+    crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+  }
+  return ~crc;
+}
+
+}  // namespace webf
+
+#endif  // BRIDGE_FOUNDATION_CRC32_H_
@@ -13,6 +13,9 @@ namespace webf {
 
 SharedNativeString::SharedNativeString(const uint16_t* string, uint32_t length) : length_(length), string_(string) {}
 
+SharedNativeString::SharedNativeString(const uint8_t* string, uint32_t length)
+    : length_(length), string_(reinterpret_cast<const uint16_t*>(string)), is_8bit_(1) {}
+
 std::unique_ptr<SharedNativeString> SharedNativeString::FromTemporaryString(const uint16_t* string, uint32_t length) {
 #if WIN32
   const auto* new_str = static_cast<const uint16_t*>(CoTaskMemAlloc(length * sizeof(uint16_t)));
@@ -15,14 +15,19 @@
 
 namespace webf {
 
-// SharedNativeString is a container class that accepts allocated UTF-16 strings,
+// SharedNativeString is a container class that accepts allocated UTF-16 or Latin-1 strings,
 // and users are responsible for freeing their strings
 struct SharedNativeString {
   SharedNativeString(const uint16_t* string, uint32_t length);
+  // A Latin-1 string, one byte per character.
+  SharedNativeString(const uint8_t* string, uint32_t length);
   static std::unique_ptr<SharedNativeString> FromTemporaryString(const uint16_t* string, uint32_t length);
 
+  // Only valid for UTF-16 strings, check Is8Bit() first.
   inline const uint16_t* string() const { return string_; }
+  inline const uint8_t* characters8() const { return reinterpret_cast<const uint8_t*>(string_); }
   inline uint32_t length() const { return length_; }
+  inline bool Is8Bit() const { return is_8bit_ != 0; }
 
   // Dart FFI use ole32 as it's allocator, we need to override the default allocator to compact with Dart FFI.
   static void* operator new(std::size_t size);
@@ -33,6 +38,8 @@ struct SharedNativeString {
   SharedNativeString() = default;
   const uint16_t* string_;
   uint32_t length_;
+  // Read by dart, keep it as a 32-bit field which fills the padding after length_.
+  uint32_t is_8bit_{0};
 };
 
 // NativeString is a container class that accepts allocated on Heap UTF-16 strings,
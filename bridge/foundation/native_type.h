@@ -40,6 +40,9 @@ struct NativeTypeDouble final : public NativeTypeBaseHelper<double> {};
 // JSON
 struct NativeTypeJSON final : public NativeTypeBaseHelper<ScriptValue> {};
 
+// Structured values, see bindings/qjs/structured_serializer.h
+struct NativeTypeStructured final : public NativeTypeBaseHelper<ScriptValue> {};
+
 // Array
 template <typename T>
 struct NativeTypeArray final : public NativeTypeBase {
@@ -5,6 +5,7 @@
 #include "native_value.h"
 #include "bindings/qjs/qjs_engine_patch.h"
 #include "bindings/qjs/script_value.h"
+#include "bindings/qjs/structured_serializer.h"
 #include "core/executing_context.h"
 
 namespace webf {
@@ -142,6 +143,69 @@ NativeValue Native_NewJSON(JSContext* ctx, const ScriptValue& value, ExceptionSt
 #endif
 }
 
+NativeValue Native_NewStructured(JSContext* ctx,
+                                 const ScriptValue& value,
+                                 ExceptionState& exception_state,
+                                 bool reject_cycles) {
+  StructuredSerializer serializer(ctx, reject_cycles);
+  if (!serializer.Serialize(value.QJSValue(), exception_state)) {
+    return Native_NewNull();
+  }
+
+  uint32_t length;
+  uint8_t* bytes = serializer.Release(&length);
+
+#if _MSC_VER
+  NativeValue v{};
+  v.u.ptr = static_cast<void*>(bytes);
+  v.uint32 = length;
+  v.tag = NativeTag::TAG_STRUCTURED;
+  return v;
+#else
+  return (NativeValue){
+      .u = {.ptr = static_cast<void*>(bytes)},
+      .uint32 = length,
+      .tag = NativeTag::TAG_STRUCTURED,
+  };
+#endif
+}
+
+NativeValue Native_NewArrayBuffer(NativeByteBuffer* buffer) {
+#if _MSC_VER
+  NativeValue v{};
+  v.u.ptr = static_cast<void*>(buffer);
+  v.uint32 = 0;
+  v.tag = NativeTag::TAG_ARRAY_BUFFER;
+  return v;
+#else
+  return (NativeValue){
+      .u = {.ptr = static_cast<void*>(buffer)},
+      .uint32 = 0,
+      .tag = NativeTag::TAG_ARRAY_BUFFER,
+  };
+#endif
+}
+
+NativeValue Native_NewArrayBufferCopy(const uint8_t* bytes, size_t length) {
+  auto* buffer = new NativeByteBuffer();
+  buffer->data = static_cast<uint8_t*>(dart_malloc(length > 0 ? length : 1));
+  memcpy(buffer->data, bytes, length);
+  buffer->offset = 0;
+  buffer->length = static_cast<int64_t>(length);
+  buffer->free_func = nullptr;
+  buffer->opaque = nullptr;
+  return Native_NewArrayBuffer(buffer);
+}
+
+void FreeNativeByteBuffer(NativeByteBuffer* buffer) {
+  if (buffer->free_func != nullptr) {
+    buffer->free_func(nullptr, buffer->opaque, buffer->data);
+  } else {
+    dart_free(buffer->data);
+  }
+  delete buffer;
+}
+
 JSPointerType GetPointerTypeOfNativePointer(NativeValue native_value) {
   assert(native_value.tag == NativeTag::TAG_POINTER);
   return static_cast<JSPointerType>(native_value.uint32);
@@ -27,6 +27,8 @@ enum NativeTag {
   TAG_FUNCTION = 8,
   TAG_ASYNC_FUNCTION = 9,
   TAG_UINT8_BYTES = 10,
+  TAG_ARRAY_BUFFER = 11,
+  TAG_STRUCTURED = 12,
 };
 
 enum class JSPointerType { NativeBindingObject = 0, Others = 1 };
@@ -46,6 +48,18 @@ struct NativeValue : public DartReadable {
   int32_t tag;
 };
 
+// The bytes of an ArrayBuffer passed across the binding boundary. JavaScript to dart copies the bytes once into a
+// dart_malloc() buffer, the ArrayBuffer of the script is not detached. Dart to JavaScript adopts the bytes without
+// copying. Whoever receives it owns the bytes and should release them by FreeNativeByteBuffer(). A null free_func means
+// the bytes were allocated by dart_malloc().
+struct NativeByteBuffer : public DartReadable {
+  uint8_t* data;
+  int64_t offset;
+  int64_t length;
+  JSFreeArrayBufferDataFunc* free_func;
+  void* opaque;
+};
+
 struct NativeFunctionContext;
 
 using CallNativeFunction = void (*)(NativeFunctionContext* functionContext,
@@ -77,6 +91,14 @@ NativeValue Native_NewInt64(int64_t value);
 NativeValue Native_NewList(uint32_t argc, NativeValue* argv);
 NativeValue Native_NewPtr(JSPointerType pointerType, void* ptr);
 NativeValue Native_NewJSON(JSContext* ctx, const ScriptValue& value, ExceptionState& exception_state);
+// Encode the value with the binary format of bindings/qjs/structured_serializer.h, the receiver owns the bytes.
+NativeValue Native_NewStructured(JSContext* ctx,
+                                 const ScriptValue& value,
+                                 ExceptionState& exception_state,
+                                 bool reject_cycles = false);
+NativeValue Native_NewArrayBuffer(NativeByteBuffer* buffer);
+NativeValue Native_NewArrayBufferCopy(const uint8_t* bytes, size_t length);
+void FreeNativeByteBuffer(NativeByteBuffer* buffer);
 
 JSPointerType GetPointerTypeOfNativePointer(NativeValue native_value);
 
@@ -115,6 +115,24 @@ struct NativeValueConverter<NativeTypeJSON> : public NativeValueConverterBase<Na
   }
 };
 
+template <>
+struct NativeValueConverter<NativeTypeStructured> : public NativeValueConverterBase<NativeTypeStructured> {
+  static NativeValue ToNativeValue(JSContext* ctx,
+                                   ImplType value,
+                                   ExceptionState& exception_state,
+                                   bool reject_cycles = false) {
+    return Native_NewStructured(ctx, value, exception_state, reject_cycles);
+  }
+  static ImplType FromNativeValue(JSContext* ctx, NativeValue value) {
+    if (value.tag == NativeTag::TAG_NULL) {
+      return ScriptValue::Empty(ctx);
+    }
+
+    assert(value.tag == NativeTag::TAG_STRUCTURED);
+    return ScriptValue(ctx, value);
+  }
+};
+
 class BindingObject;
 struct DartReadable;
 
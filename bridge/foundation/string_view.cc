@@ -3,14 +3,34 @@
  * Copyright (C) 2022-present The WebF authors. All rights reserved.
  */
 #include "string_view.h"
+#include <cstring>
 
 namespace webf {
 
 StringView::StringView(const std::string& string) : bytes_(string.data()), length_(string.length()), is_8bit_(true) {}
 
 StringView::StringView(const SharedNativeString* string)
-    : bytes_(string->string()), length_(string->length()), is_8bit_(false) {}
+    : bytes_(string->string()), length_(string->length()), is_8bit_(string->Is8Bit()) {}
 
 StringView::StringView(void* bytes, unsigned length, bool is_wide_char)
     : bytes_(bytes), length_(length), is_8bit_(!is_wide_char) {}
+
+bool EqualStringView(const StringView& a, const StringView& b) {
+  if (a.length() != b.length())
+    return false;
+
+  if (a.Is8Bit() && b.Is8Bit())
+    return memcmp(a.Characters8(), b.Characters8(), a.length()) == 0;
+  if (!a.Is8Bit() && !b.Is8Bit())
+    return memcmp(a.Characters16(), b.Characters16(), a.length() * sizeof(char16_t)) == 0;
+
+  const StringView& narrow = a.Is8Bit() ? a : b;
+  const StringView& wide = a.Is8Bit() ? b : a;
+  for (unsigned i = 0; i < narrow.length(); i++) {
+    if (static_cast<uint8_t>(narrow.Characters8()[i]) != wide.Characters16()[i])
+      return false;
+  }
+  return true;
+}
+
 }  // namespace webf
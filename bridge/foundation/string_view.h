@@ -41,6 +41,9 @@ class StringView final {
   unsigned is_8bit_ : 1;
 };
 
+// Compare the characters of two views, regardless of their character width.
+bool EqualStringView(const StringView& a, const StringView& b);
+
 }  // namespace webf
 
 #endif  // BRIDGE_FOUNDATION_STRING_VIEW_H_
@@ -0,0 +1,382 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+#include "transcoding.h"
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define WEBF_TRANSCODING_AVX2 1
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define WEBF_TRANSCODING_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define WEBF_TRANSCODING_NEON 1
+#endif
+
+#if WEBF_TRANSCODING_SSE2 || WEBF_TRANSCODING_NEON
+#define WEBF_TRANSCODING_SIMD 1
+#endif
+
+namespace webf {
+
+namespace {
+
+constexpr uint32_t kReplacementCharacter = 0xFFFD;
+
+// Decodes the code point at |source[*index]| and moves |*index| past it. A malformed sequence yields
+// kReplacementCharacter, clears |*valid| and consumes one byte.
+inline uint32_t DecodeUTF8(const uint8_t* source, size_t length, size_t* index, bool* valid) {
+  uint8_t lead = source[*index];
+  if (lead < 0x80) {
+    (*index)++;
+    return lead;
+  }
+
+  size_t trailing;
+  uint32_t code_point;
+  uint32_t minimum;
+  if ((lead & 0xE0) == 0xC0) {
+    trailing = 1;
+    code_point = lead & 0x1F;
+    minimum = 0x80;
+  } else if ((lead & 0xF0) == 0xE0) {
+    trailing = 2;
+    code_point = lead & 0x0F;
+    minimum = 0x800;
+  } else if ((lead & 0xF8) == 0xF0) {
+    trailing = 3;
+    code_point = lead & 0x07;
+    minimum = 0x10000;
+  } else {
+    goto invalid;
+  }
+
+  if (length - *index <= trailing)
+    goto invalid;
+  for (size_t i = 1; i <= trailing; i++) {
+    uint8_t byte = source[*index + i];
+    if ((byte & 0xC0) != 0x80)
+      goto invalid;
+    code_point = (code_point << 6) | (byte & 0x3F);
+  }
+  // Overlong forms, surrogates and code points beyond the unicode range.
+  if (code_point < minimum || code_point > 0x10FFFF || (code_point >= 0xD800 && code_point <= 0xDFFF))
+    goto invalid;
+
+  *index += trailing + 1;
+  return code_point;
+
+invalid:
+  (*index)++;
+  *valid = false;
+  return kReplacementCharacter;
+}
+
+inline size_t EncodeUTF8(uint32_t code_point, char* destination) {
+  auto* d = reinterpret_cast<uint8_t*>(destination);
+  if (code_point < 0x80) {
+    d[0] = code_point;
+    return 1;
+  }
+  if (code_point < 0x800) {
+    d[0] = 0xC0 | (code_point >> 6);
+    d[1] = 0x80 | (code_point & 0x3F);
+    return 2;
+  }
+  if (code_point < 0x10000) {
+    d[0] = 0xE0 | (code_point >> 12);
+    d[1] = 0x80 | ((code_point >> 6) & 0x3F);
+    d[2] = 0x80 | (code_point & 0x3F);
+    return 3;
+  }
+  d[0] = 0xF0 | (code_point >> 18);
+  d[1] = 0x80 | ((code_point >> 12) & 0x3F);
+  d[2] = 0x80 | ((code_point >> 6) & 0x3F);
+  d[3] = 0x80 | (code_point & 0x3F);
+  return 4;
+}
+
+inline size_t EncodeUTF16(uint32_t code_point, uint16_t* destination) {
+  if (code_point < 0x10000) {
+    destination[0] = code_point;
+    return 1;
+  }
+  code_point -= 0x10000;
+  destination[0] = 0xD800 | (code_point >> 10);
+  destination[1] = 0xDC00 | (code_point & 0x3FF);
+  return 2;
+}
+
+// Reads the code point at |source[*index]|, joining a surrogate pair, and moves |*index| past it.
+inline uint32_t DecodeUTF16(const uint16_t* source, size_t length, size_t* index) {
+  uint16_t unit = source[(*index)++];
+  if (unit < 0xD800 || unit > 0xDFFF)
+    return unit;
+  if (unit <= 0xDBFF && *index < length && source[*index] >= 0xDC00 && source[*index] <= 0xDFFF) {
+    uint16_t low = source[(*index)++];
+    return 0x10000 + ((static_cast<uint32_t>(unit) - 0xD800) << 10) + (low - 0xDC00);
+  }
+  return kReplacementCharacter;
+}
+
+#if WEBF_TRANSCODING_SSE2
+
+inline bool BlockIsASCII(const uint8_t* characters) {
+  return _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(characters))) == 0;
+}
+
+inline bool BlockIsASCII(const uint16_t* characters) {
+  __m128i value = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(characters)),
+                               _mm_loadu_si128(reinterpret_cast<const __m128i*>(characters + 8)));
+  __m128i non_ascii = _mm_and_si128(value, _mm_set1_epi16(static_cast<int16_t>(0xFF80)));
+  return _mm_movemask_epi8(_mm_cmpeq_epi16(non_ascii, _mm_setzero_si128())) == 0xFFFF;
+}
+
+inline void WidenBlock(const uint8_t* source, uint16_t* destination) {
+  __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+  __m128i zero = _mm_setzero_si128();
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(destination), _mm_unpacklo_epi8(value, zero));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + 8), _mm_unpackhi_epi8(value, zero));
+}
+
+// Only for the blocks which passed BlockIsASCII().
+inline void NarrowBlock(const uint16_t* source, char* destination) {
+  __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+  __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + 8));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(destination), _mm_packus_epi16(low, high));
+}
+
+#elif WEBF_TRANSCODING_NEON
+
+inline bool BlockIsASCII(const uint8_t* characters) {
+  return vmaxvq_u8(vld1q_u8(characters)) < 0x80;
+}
+
+inline bool BlockIsASCII(const uint16_t* characters) {
+  return vmaxvq_u16(vorrq_u16(vld1q_u16(characters), vld1q_u16(characters + 8))) < 0x80;
+}
+
+inline void WidenBlock(const uint8_t* source, uint16_t* destination) {
+  uint8x16_t value = vld1q_u8(source);
+  vst1q_u16(destination, vmovl_u8(vget_low_u8(value)));
+  vst1q_u16(destination + 8, vmovl_high_u8(value));
+}
+
+// Only for the blocks which passed BlockIsASCII().
+inline void NarrowBlock(const uint16_t* source, char* destination) {
+  uint8x16_t value = vcombine_u8(vmovn_u16(vld1q_u16(source)), vmovn_u16(vld1q_u16(source + 8)));
+  vst1q_u8(reinterpret_cast<uint8_t*>(destination), value);
+}
+
+#endif
+
+// Every SIMD kernel works on blocks of 16 characters.
+constexpr size_t kBlockSize = 16;
+
+}  // namespace
+
+namespace scalar {
+
+bool CharactersAreAllASCII(const uint8_t* characters, size_t length) {
+  uint8_t result = 0;
+  for (size_t i = 0; i < length; i++) {
+    result |= characters[i];
+  }
+  return result < 0x80;
+}
+
+bool CharactersAreAllASCII(const uint16_t* characters, size_t length) {
+  uint16_t result = 0;
+  for (size_t i = 0; i < length; i++) {
+    result |= characters[i];
+  }
+  return result < 0x80;
+}
+
+bool IsValidUTF8(const char* characters, size_t length) {
+  auto* source = reinterpret_cast<const uint8_t*>(characters);
+  bool valid = true;
+  size_t i = 0;
+  while (i < length && valid) {
+    DecodeUTF8(source, length, &i, &valid);
+  }
+  return valid;
+}
+
+void Latin1ToUTF16(const uint8_t* source, size_t length, uint16_t* destination) {
+  for (size_t i = 0; i < length; i++) {
+    destination[i] = source[i];
+  }
+}
+
+size_t Latin1ToUTF8(const uint8_t* source, size_t length, char* destination) {
+  size_t written = 0;
+  for (size_t i = 0; i < length; i++) {
+    written += EncodeUTF8(source[i], destination + written);
+  }
+  return written;
+}
+
+size_t UTF16ToUTF8(const uint16_t* source, size_t length, char* destination) {
+  size_t written = 0;
+  size_t i = 0;
+  while (i < length) {
+    written += EncodeUTF8(DecodeUTF16(source, length, &i), destination + written);
+  }
+  return written;
+}
+
+size_t UTF8ToUTF16(const char* characters, size_t length, uint16_t* destination) {
+  auto* source = reinterpret_cast<const uint8_t*>(characters);
+  bool valid = true;
+  size_t written = 0;
+  size_t i = 0;
+  while (i < length) {
+    written += EncodeUTF16(DecodeUTF8(source, length, &i, &valid), destination + written);
+  }
+  return written;
+}
+
+}  // namespace scalar
+
+bool CharactersAreAllASCII(const uint8_t* characters, size_t length) {
+  size_t i = 0;
+#if WEBF_TRANSCODING_AVX2
+  __m256i result = _mm256_setzero_si256();
+  for (; i + 32 <= length; i += 32) {
+    result = _mm256_or_si256(result, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(characters + i)));
+  }
+  if (_mm256_movemask_epi8(result) != 0)
+    return false;
+#endif
+#if WEBF_TRANSCODING_SIMD
+  for (; i + kBlockSize <= length; i += kBlockSize) {
+    if (!BlockIsASCII(characters + i))
+      return false;
+  }
+#endif
+  return scalar::CharactersAreAllASCII(characters + i, length - i);
+}
+
+bool CharactersAreAllASCII(const uint16_t* characters, size_t length) {
+  size_t i = 0;
+#if WEBF_TRANSCODING_SIMD
+  for (; i + kBlockSize <= length; i += kBlockSize) {
+    if (!BlockIsASCII(characters + i))
+      return false;
+  }
+#endif
+  return scalar::CharactersAreAllASCII(characters + i, length - i);
+}
+
+bool IsValidUTF8(const char* characters, size_t length) {
+#if WEBF_TRANSCODING_SIMD
+  auto* source = reinterpret_cast<const uint8_t*>(characters);
+  bool valid = true;
+  size_t i = 0;
+  while (i < length && valid) {
+    if (i + kBlockSize <= length && BlockIsASCII(source + i)) {
+      i += kBlockSize;
+      continue;
+    }
+    DecodeUTF8(source, length, &i, &valid);
+  }
+  return valid;
+#else
+  return scalar::IsValidUTF8(characters, length);
+#endif
+}
+
+void Latin1ToUTF16(const uint8_t* source, size_t length, uint16_t* destination) {
+  size_t i = 0;
+#if WEBF_TRANSCODING_AVX2
+  for (; i + 16 <= length; i += 16) {
+    __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), _mm256_cvtepu8_epi16(value));
+  }
+#elif WEBF_TRANSCODING_SIMD
+  for (; i + kBlockSize <= length; i += kBlockSize) {
+    WidenBlock(source + i, destination + i);
+  }
+#endif
+  scalar::Latin1ToUTF16(source + i, length - i, destination + i);
+}
+
+size_t Latin1ToUTF8(const uint8_t* source, size_t length, char* destination) {
+#if WEBF_TRANSCODING_SIMD
+  size_t written = 0;
+  size_t i = 0;
+  while (i < length) {
+    if (i + kBlockSize <= length && BlockIsASCII(source + i)) {
+      memcpy(destination + written, source + i, kBlockSize);
+      written += kBlockSize;
+      i += kBlockSize;
+      continue;
+    }
+    written += EncodeUTF8(source[i++], destination + written);
+  }
+  return written;
+#else
+  return scalar::Latin1ToUTF8(source, length, destination);
+#endif
+}
+
+size_t UTF16ToUTF8(const uint16_t* source, size_t length, char* destination) {
+#if WEBF_TRANSCODING_SIMD
+  size_t written = 0;
+  size_t i = 0;
+  while (i < length) {
+    if (i + kBlockSize <= length && BlockIsASCII(source + i)) {
+      NarrowBlock(source + i, destination + written);
+      written += kBlockSize;
+      i += kBlockSize;
+      continue;
+    }
+    written += EncodeUTF8(DecodeUTF16(source, length, &i), destination + written);
+  }
+  return written;
+#else
+  return scalar::UTF16ToUTF8(source, length, destination);
+#endif
+}
+
+size_t UTF8ToUTF16(const char* characters, size_t length, uint16_t* destination) {
+#if WEBF_TRANSCODING_SIMD
+  auto* source = reinterpret_cast<const uint8_t*>(characters);
+  bool valid = true;
+  size_t written = 0;
+  size_t i = 0;
+  while (i < length) {
+    if (i + kBlockSize <= length && BlockIsASCII(source + i)) {
+      WidenBlock(source + i, destination + written);
+      written += kBlockSize;
+      i += kBlockSize;
+      continue;
+    }
+    written += EncodeUTF16(DecodeUTF8(source, length, &i, &valid), destination + written);
+  }
+  return written;
+#else
+  return scalar::UTF8ToUTF16(characters, length, destination);
+#endif
+}
+
+std::string Latin1ToUTF8String(const uint8_t* source, size_t length) {
+  std::string result;
+  result.resize(length * 2);
+  result.resize(Latin1ToUTF8(source, length, &result[0]));
+  return result;
+}
+
+std::string UTF16ToUTF8String(const uint16_t* source, size_t length) {
+  std::string result;
+  result.resize(length * 3);
+  result.resize(UTF16ToUTF8(source, length, &result[0]));
+  return result;
+}
+
+}  // namespace webf
@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+#ifndef BRIDGE_FOUNDATION_TRANSCODING_H_
+#define BRIDGE_FOUNDATION_TRANSCODING_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace webf {
+
+// Conversions between the string encodings used by QuickJS (Latin-1 and UTF-16), dart (UTF-16) and C++ (UTF-8).
+// The kernels use AVX2 or SSE2 on x86 and NEON on arm64 when the compiler targets them, and the scalar versions
+// otherwise. Invalid input, such as an unpaired surrogate or a malformed UTF-8 sequence, becomes U+FFFD.
+
+bool CharactersAreAllASCII(const uint8_t* characters, size_t length);
+bool CharactersAreAllASCII(const uint16_t* characters, size_t length);
+
+bool IsValidUTF8(const char* characters, size_t length);
+
+// |destination| must have room for |length| UTF-16 code units.
+void Latin1ToUTF16(const uint8_t* source, size_t length, uint16_t* destination);
+
+// The following conversions return the number of units written to |destination|, which must have room for
+// the worst case: 2 bytes per Latin-1 character, 3 bytes per UTF-16 code unit and 1 code unit per UTF-8 byte.
+size_t Latin1ToUTF8(const uint8_t* source, size_t length, char* destination);
+size_t UTF16ToUTF8(const uint16_t* source, size_t length, char* destination);
+size_t UTF8ToUTF16(const char* source, size_t length, uint16_t* destination);
+
+std::string Latin1ToUTF8String(const uint8_t* source, size_t length);
+std::string UTF16ToUTF8String(const uint16_t* source, size_t length);
+
+// The portable implementations, exposed for tests and benchmarks.
+namespace scalar {
+
+bool CharactersAreAllASCII(const uint8_t* characters, size_t length);
+bool CharactersAreAllASCII(const uint16_t* characters, size_t length);
+bool IsValidUTF8(const char* characters, size_t length);
+void Latin1ToUTF16(const uint8_t* source, size_t length, uint16_t* destination);
+size_t Latin1ToUTF8(const uint8_t* source, size_t length, char* destination);
+size_t UTF16ToUTF8(const uint16_t* source, size_t length, char* destination);
+size_t UTF8ToUTF16(const char* source, size_t length, uint16_t* destination);
+
+}  // namespace scalar
+
+}  // namespace webf
+
+#endif  // BRIDGE_FOUNDATION_TRANSCODING_H_
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "transcoding.h"
+#include <vector>
+#include "gtest/gtest.h"
+
+using namespace webf;
+
+namespace {
+
+// Long enough to cover the SIMD blocks and the scalar tail.
+std::u16string RepeatUTF16(const std::u16string& unit, size_t count) {
+  std::u16string result;
+  for (size_t i = 0; i < count; i++) {
+    result += unit;
+  }
+  return result;
+}
+
+std::string ToUTF8(const std::u16string& source) {
+  return UTF16ToUTF8String(reinterpret_cast<const uint16_t*>(source.data()), source.size());
+}
+
+std::u16string ToUTF16(const std::string& source) {
+  std::vector<uint16_t> buffer(source.size());
+  size_t length = UTF8ToUTF16(source.data(), source.size(), buffer.data());
+  return std::u16string(reinterpret_cast<const char16_t*>(buffer.data()), length);
+}
+
+}  // namespace
+
+TEST(Transcoding, CharactersAreAllASCII) {
+  std::string ascii(100, 'a');
+  EXPECT_TRUE(CharactersAreAllASCII(reinterpret_cast<const uint8_t*>(ascii.data()), ascii.size()));
+  for (size_t position : {0, 15, 16, 31, 32, 63, 99}) {
+    std::string latin1 = ascii;
+    latin1[position] = '\xe9';
+    EXPECT_FALSE(CharactersAreAllASCII(reinterpret_cast<const uint8_t*>(latin1.data()), latin1.size()));
+
+    std::u16string utf16(100, u'a');
+    utf16[position] = u'你';
+    EXPECT_FALSE(CharactersAreAllASCII(reinterpret_cast<const uint16_t*>(utf16.data()), utf16.size()));
+    utf16[position] = u'Ā';
+    EXPECT_FALSE(CharactersAreAllASCII(reinterpret_cast<const uint16_t*>(utf16.data()), utf16.size()));
+  }
+}
+
+TEST(Transcoding, Latin1ToUTF16) {
+  std::vector<uint8_t> source;
+  for (int i = 0; i < 256; i++) {
+    source.push_back(static_cast<uint8_t>(i));
+  }
+  std::vector<uint16_t> result(source.size());
+  Latin1ToUTF16(source.data(), source.size(), result.data());
+  for (size_t i = 0; i < source.size(); i++) {
+    EXPECT_EQ(result[i], source[i]);
+  }
+}
+
+TEST(Transcoding, Latin1ToUTF8) {
+  std::string source = "caf\xe9 au lait, tr\xe8s bien. The quick brown fox";
+  EXPECT_EQ(Latin1ToUTF8String(reinterpret_cast<const uint8_t*>(source.data()), source.size()),
+            "caf\xc3\xa9 au lait, tr\xc3\xa8s bien. The quick brown fox");
+}
+
+TEST(Transcoding, RoundTrip) {
+  std::u16string source = RepeatUTF16(u"hello, world! ", 3) + u"你好" + RepeatUTF16(u"x", 17) +
+                          u"\U0001F600" + u"café" + RepeatUTF16(u"0123456789abcdef", 2);
+  std::string utf8 = ToUTF8(source);
+  EXPECT_TRUE(IsValidUTF8(utf8.data(), utf8.size()));
+  EXPECT_EQ(ToUTF16(utf8), source);
+
+  std::vector<char> scalar_utf8(source.size() * 3);
+  size_t length =
+      scalar::UTF16ToUTF8(reinterpret_cast<const uint16_t*>(source.data()), source.size(), scalar_utf8.data());
+  EXPECT_EQ(std::string(scalar_utf8.data(), length), utf8);
+}
+
+TEST(Transcoding, UnpairedSurrogate) {
+  std::u16string source = RepeatUTF16(u"a", 20);
+  source[3] = 0xD800;
+  source[18] = 0xDC00;
+  std::string utf8 = ToUTF8(source);
+  EXPECT_EQ(utf8, "aaa\xef\xbf\xbd" + std::string(14, 'a') + "\xef\xbf\xbd" + "a");
+}
+
+TEST(Transcoding, InvalidUTF8) {
+  // Overlong, surrogate, truncated and stray continuation sequences.
+  for (std::string invalid : {"\xc0\xaf", "\xed\xa0\x80", "\xe4\xbd", "\x80", "\xf4\x90\x80\x80"}) {
+    std::string source = std::string(20, 'a') + invalid;
+    EXPECT_FALSE(IsValidUTF8(source.data(), source.size()));
+    EXPECT_FALSE(scalar::IsValidUTF8(source.data(), source.size()));
+    std::u16string result = ToUTF16(source);
+    EXPECT_EQ(result.substr(0, 20), std::u16string(20, u'a'));
+    EXPECT_EQ(result[20], 0xFFFD);
+  }
+}
@@ -44,9 +44,12 @@ UICommandKind GetKindFromUICommand(UICommand command) {
 }
 
 UICommandBuffer::UICommandBuffer(ExecutingContext* context)
-    : context_(context), buffer_((UICommandItem*)malloc(sizeof(UICommandItem) * MAXIMUM_UI_COMMAND_SIZE)) {}
+    : context_(context), buffer_((UICommandItem*)malloc(sizeof(UICommandItem) * MAXIMUM_UI_COMMAND_SIZE)) {
+  context_->pageMemory()->Allocated(PageMemory::kUICommands, sizeof(UICommandItem) * max_size_);
+}
 
 UICommandBuffer::~UICommandBuffer() {
+  context_->pageMemory()->Freed(PageMemory::kUICommands, sizeof(UICommandItem) * max_size_);
   free(buffer_);
 }
 
@@ -72,6 +75,7 @@ void UICommandBuffer::addCommand(const UICommandItem& item, bool request_ui_upda
 
   if (size_ >= max_size_) {
     buffer_ = (UICommandItem*)realloc(buffer_, sizeof(UICommandItem) * max_size_ * 2);
+    context_->pageMemory()->Allocated(PageMemory::kUICommands, sizeof(UICommandItem) * max_size_);
     max_size_ = max_size_ * 2;
   }
 
@@ -94,6 +98,7 @@ void UICommandBuffer::addCommands(const webf::UICommandItem* items, int64_t item
   int64_t target_size = size_ + item_size;
   if (target_size > max_size_) {
     buffer_ = (UICommandItem*)realloc(buffer_, sizeof(UICommandItem) * target_size * 2);
+    context_->pageMemory()->Allocated(PageMemory::kUICommands, sizeof(UICommandItem) * (target_size * 2 - max_size_));
     max_size_ = target_size * 2;
   }
 
@@ -53,9 +53,15 @@ struct UICommandItem {
   explicit UICommandItem(int32_t type, SharedNativeString* args_01, void* nativePtr, void* nativePtr2)
       : type(type),
         string_01(reinterpret_cast<int64_t>(args_01 != nullptr ? args_01->string() : nullptr)),
-        args_01_length(args_01 != nullptr ? args_01->length() : 0),
+        args_01_length(args_01 != nullptr ? EncodeArgs01Length(args_01) : 0),
         nativePtr(reinterpret_cast<int64_t>(nativePtr)),
         nativePtr2(reinterpret_cast<int64_t>(nativePtr2)){};
+  // The highest bit of args_01_length marks string_01 as a Latin-1 string.
+  static constexpr uint32_t kArgs01Latin1Flag = 1u << 31;
+  static int32_t EncodeArgs01Length(const SharedNativeString* args_01) {
+    return static_cast<int32_t>(args_01->length() | (args_01->Is8Bit() ? kArgs01Latin1Flag : 0));
+  }
+
   int32_t type{0};
   int32_t args_01_length{0};
   int64_t string_01{0};
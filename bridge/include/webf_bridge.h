@@ -22,6 +22,7 @@ typedef struct SharedNativeString SharedNativeString;
 typedef struct NativeValue NativeValue;
 typedef struct NativeScreen NativeScreen;
 typedef struct NativeByteCode NativeByteCode;
+typedef struct NativeByteBuffer NativeByteBuffer;
 
 struct WebFInfo {
   const char* app_name{nullptr};
@@ -30,6 +31,14 @@ struct WebFInfo {
   const char* system_name{nullptr};
 };
 
+// The memory attributed to a page, in bytes.
+struct NativePageMemoryUsage {
+  int64_t js_heap{0};
+  int64_t dom_wrappers{0};
+  int64_t ui_commands{0};
+  int64_t blobs{0};
+};
+
 typedef void (*Task)(void*);
 typedef std::function<void(bool)> DartWork;
 typedef void (*AllocateNewPageCallback)(Dart_Handle dart_handle, void*);
@@ -56,6 +65,17 @@ void allocateNewPage(double thread_identity,
 WEBF_EXPORT_C
 void* allocateNewPageSync(double thread_identity, void* dart_isolate_context);
 
+// Builds the page of |thread_identity| ahead of time, allocateNewPage and allocateNewPageSync claim it later.
+WEBF_EXPORT_C
+void prewarmPage(double thread_identity,
+                 int32_t sync_buffer_size,
+                 void* dart_isolate_context,
+                 Dart_Handle dart_handle,
+                 AllocateNewPageCallback result_callback);
+
+WEBF_EXPORT_C
+void* prewarmPageSync(double thread_identity, void* dart_isolate_context);
+
 WEBF_EXPORT_C
 int64_t newPageIdSync();
 
@@ -87,6 +107,13 @@ void evaluateQuickjsByteCode(void* page,
                              int64_t profile_id,
                              Dart_Handle dart_handle,
                              EvaluateQuickjsByteCodeCallback result_callback);
+// Evaluates the bytecode file at |path|, a bundle is mapped into memory rather than copied.
+WEBF_EXPORT_C
+void evaluateQuickjsByteCodeFile(void* page,
+                                 const char* path,
+                                 int64_t profile_id,
+                                 Dart_Handle dart_handle,
+                                 EvaluateQuickjsByteCodeCallback result_callback);
 
 WEBF_EXPORT_C
 void dumpQuickjsByteCode(void* page,
@@ -119,9 +146,50 @@ void invokeModuleEvent(void* page,
                        Dart_Handle dart_handle,
                        InvokeModuleEventCallback result_callback);
 WEBF_EXPORT_C
+void freeNativeByteBuffer(NativeByteBuffer* buffer);
+WEBF_EXPORT_C
+void setLocalStorageDirectory(void* page,
+                              const char* directory,
+                              const char** legacy_keys,
+                              const char** legacy_values,
+                              int32_t legacy_length);
+// Caches the bytecode of the evaluated scripts in |directory| for all the pages, an empty directory turns it off.
+WEBF_EXPORT_C
+void setBytecodeCacheDirectory(const char* directory, int64_t max_bytes);
+// The host is idle for |idle_time_us|, the JS thread of the page may run a garbage collection in it.
+WEBF_EXPORT_C
+void notifyIdle(void* page, int64_t idle_time_us);
+// |level| is 0 when the pressure is gone, 1 for moderate and 2 for critical memory pressure.
+WEBF_EXPORT_C
+void notifyMemoryPressure(void* page, int32_t level);
+// The JS heap shared by the pages of a JS thread is kept under the sum of their budgets, 0 removes the budget.
+WEBF_EXPORT_C
+void setPageMemoryBudget(void* page, int64_t bytes);
+// Past |soft_limit| the window of the page receives a memorypressure event, past |hard_limit| the scripts of the page
+// are terminated. 0 disables a limit.
+WEBF_EXPORT_C
+void setPageMemoryLimits(void* page, int64_t soft_limit, int64_t hard_limit);
+// The JS heap of the usage is the one measured after the last full garbage collection, reading it asks for a
+// measurement after the next one. The usage is read on the JS thread of the page.
+WEBF_EXPORT_C
+void getPageMemoryUsage(void* page, NativePageMemoryUsage* usage);
+WEBF_EXPORT_C
 void collectNativeProfileData(void* ptr, const char** data, uint32_t* len);
 WEBF_EXPORT_C
 void clearNativeProfileData(void* ptr);
+// Samples the JS call stacks of the thread running |page| every |interval_us| microseconds, until
+// stopJSSamplingProfiler. Pages sharing the thread share the profile.
+WEBF_EXPORT_C
+void startJSSamplingProfiler(void* page, int64_t interval_us);
+WEBF_EXPORT_C
+void stopJSSamplingProfiler(void* page);
+// |format| is 0 for collapsed stacks and 1 for a pprof protobuf. |data| is allocated with dart_malloc.
+WEBF_EXPORT_C
+void collectJSSamplingProfileData(void* page, int32_t format, const char** data, uint32_t* len);
+// Writes the JS heap of the thread running |page| as a Chrome DevTools heap snapshot, the ScriptWrappables are native
+// nodes. Pages sharing the thread share the heap. |data| is allocated with dart_malloc.
+WEBF_EXPORT_C
+void takeHeapSnapshot(void* page, const char** data, uint32_t* len);
 
 WEBF_EXPORT_C
 WebFInfo* getWebFInfo();
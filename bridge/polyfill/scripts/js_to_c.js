@@ -49,7 +49,7 @@ uint8_t bytes[${uint8Array.length}] = {${uint8Array.join(',')}}; }`;
 };
 
 const getPolyfillEvalCall = () => {
-  return 'context->EvaluateByteCode(bytes, byteLength);';
+  return 'context->EvaluateSharedByteCode(bytes, byteLength);';
 }
 
 const getPolyFillSource = (source, outputName) => `/*
@@ -8,7 +8,7 @@ import { webf } from './webf';
 export const asyncStorage = {
   getItem(key: number | string) {
     return new Promise((resolve, reject) => {
-      webf.invokeModule('AsyncStorage', 'getItem', String(key), (e, data) => {
+      webf.invokeModuleAsync('AsyncStorage', 'getItem', String(key), (e, data) => {
         if (e) return reject(e);
         resolve(data == null ? '' : data);
       });
@@ -16,7 +16,7 @@ export const asyncStorage = {
   },
   setItem(key: number | string, value: number | string) {
     return new Promise((resolve, reject) => {
-      webf.invokeModule('AsyncStorage', 'setItem', [String(key), String(value)], (e, data) => {
+      webf.invokeModuleAsync('AsyncStorage', 'setItem', [String(key), String(value)], (e, data) => {
         if (e) return reject(e);
         resolve(data);
       });
@@ -24,7 +24,7 @@ export const asyncStorage = {
   },
   removeItem(key: number | string) {
     return new Promise((resolve, reject) => {
-      webf.invokeModule('AsyncStorage', 'removeItem', String(key), (e, data) => {
+      webf.invokeModuleAsync('AsyncStorage', 'removeItem', String(key), (e, data) => {
         if (e) return reject(e);
         resolve(data);
       });
@@ -32,7 +32,7 @@ export const asyncStorage = {
   },
   clear() {
     return new Promise((resolve, reject) => {
-      webf.invokeModule('AsyncStorage', 'clear', '', (e, data) => {
+      webf.invokeModuleAsync('AsyncStorage', 'clear', '', (e, data) => {
         if (e) return reject(e);
         resolve(data);
       });
@@ -40,7 +40,7 @@ export const asyncStorage = {
   },
   getAllKeys() {
     return new Promise((resolve, reject) => {
-      webf.invokeModule('AsyncStorage', 'getAllKeys', '', (e, data) => {
+      webf.invokeModuleAsync('AsyncStorage', 'getAllKeys', '', (e, data) => {
         if (e) return reject(e);
         resolve(data);
       });
@@ -48,7 +48,7 @@ export const asyncStorage = {
   },
   length(): Promise<number> {
     return new Promise((resolve, reject) => {
-      webf.invokeModule('AsyncStorage', 'length', '', (e, data) => {
+      webf.invokeModuleAsync('AsyncStorage', 'length', '', (e, data) => {
         if (e) return reject(e);
         resolve(data);
       });
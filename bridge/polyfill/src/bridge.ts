@@ -6,6 +6,9 @@
 declare const __webf_invoke_module__: (module: string, method: string, params?: any | null, fn?: (err: Error, data: any) => any) => any;
 export const webfInvokeModule = __webf_invoke_module__;
 
+declare const __webf_invoke_module_async__: (module: string, method: string, params?: any | null, fn?: (err: Error, data: any) => any) => void;
+export const webfInvokeModuleAsync = __webf_invoke_module_async__;
+
 declare const __webf_add_module_listener__: (moduleName: string, fn: (event: Event, extra: any) => any) => void;
 export const addWebfModuleListener = __webf_add_module_listener__;
 
@@ -13,10 +13,7 @@ import { navigator } from './navigator';
 import { XMLHttpRequest } from './xhr';
 import { asyncStorage } from './async-storage';
 import { URLSearchParams } from './url-search-params';
-import { localStorage } from './local-storage';
-import { sessionStorage } from './session-storage';
 import { DOMException } from './dom-exception';
-import { Storage } from './storage';
 import { URL } from './url';
 import { webf } from './webf';
 import { WebSocket } from './websocket'
@@ -36,9 +33,6 @@ defineGlobalProperty('history', history);
 defineGlobalProperty('navigator', navigator);
 defineGlobalProperty('XMLHttpRequest', XMLHttpRequest);
 defineGlobalProperty('asyncStorage', asyncStorage);
-defineGlobalProperty('localStorage', localStorage);
-defineGlobalProperty('sessionStorage', sessionStorage);
-defineGlobalProperty('Storage', Storage);
 defineGlobalProperty('URLSearchParams', URLSearchParams);
 defineGlobalProperty('DOMException', DOMException);
 defineGlobalProperty('URL', URL);
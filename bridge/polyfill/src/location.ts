@@ -11,7 +11,7 @@ class Location {
     return webf.invokeModule('Location', 'href');
   }
   set href(url: string) {
-    webf.invokeModule('Navigation', 'goTo', url);
+    webf.invokeModuleAsync('Navigation', 'goTo', url);
   }
   get origin() {
     return webf.invokeModule('Location', 'origin');
@@ -40,7 +40,7 @@ class Location {
 
   get assign() {
     return (assignURL: string) => {
-      webf.invokeModule('Navigation', 'goTo', assignURL);
+      webf.invokeModuleAsync('Navigation', 'goTo', assignURL);
     };
   }
   get reload() {
@@ -48,7 +48,7 @@ class Location {
   }
   get replace() {
     return (replaceURL: string) => {
-      webf.invokeModule('Navigation', 'goTo', replaceURL);
+      webf.invokeModuleAsync('Navigation', 'goTo', replaceURL);
     };
   }
   get toString() {
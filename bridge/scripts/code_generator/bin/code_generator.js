@@ -13,6 +13,7 @@ const { generatorSource } = require('../dist/idl/generator')
 const { generateUnionTypes, generateUnionTypeFileName } = require('../dist/idl/generateUnionTypes')
 const { generateJSONTemplate } = require('../dist/json/generator');
 const { generateNamesInstaller } = require("../dist/json/generator");
+const { ExternalAtomTable } = require("../dist/json/external_atoms");
 const { union } = require("lodash");
 
 program
@@ -104,6 +105,10 @@ function genCodeFromJSONData() {
     return new JSONBlob(path.join(source, file), dist, filename);
   });
 
+  // The names of make_names become static atoms of QuickJS.
+  let quickjsHeaders = path.join(__dirname, '../../../third_party/quickjs/include/quickjs');
+  let atoms = new ExternalAtomTable(path.join(quickjsHeaders, 'quickjs-atom.h'));
+
   let templates = templateFiles.map(template => {
     let filename = template.split(path.sep).slice(-1)[0].replace('.tpl', '');
     return new JSONTemplate(path.join(path.join(__dirname, '../templates/json_templates'), template), filename);
@@ -139,7 +144,7 @@ function genCodeFromJSONData() {
       let targetTemplateHeaderData = templates.find(t => t.filename === targetTemplate.template + '.h');
       let targetTemplateBodyData = templates.find(t => t.filename === targetTemplate.template + '.cc');
       blob.filename = targetTemplate.filename;
-      let result = generateJSONTemplate(blobs[i], targetTemplateHeaderData, targetTemplateBodyData, depsBlob, targetTemplate.options);
+      let result = generateJSONTemplate(blobs[i], targetTemplateHeaderData, targetTemplateBodyData, depsBlob, targetTemplate.options, atoms);
       let dist = blob.dist;
       let genFilePath = path.join(dist, targetTemplate.filename);
       wirteFileIfChanged(genFilePath + '.h', result.header);
@@ -154,6 +159,8 @@ function genCodeFromJSONData() {
   let genFilePath = path.join(dist, 'names_installer');
   wirteFileIfChanged(genFilePath + '.h', result.header);
   result.source && wirteFileIfChanged(genFilePath + '.cc', result.source);
+
+  wirteFileIfChanged(path.join(quickjsHeaders, 'quickjs-external-atom.h'), atoms.generate());
 }
 
 class DefinedPropertyCollector {
@@ -590,46 +590,7 @@ export function generateCppSource(blob: IDLBlob, options: GenerateOptions) {
         object.methods.forEach(addObjectMethods);
 
         if (object.construct) {
-          options.constructorInstallList.push(`{defined_properties::k${className}.Impl(), nullptr, nullptr, constructor}`)
-        }
-
-        let wrapperTypeRegisterList = [
-          `JS_CLASS_${getWrapperTypeInfoNameOfClassName(className)}`,                        // ClassId
-          `"${className}"`,                                                          // ClassName
-          object.parent != null ? `${object.parent}::GetStaticWrapperTypeInfo()` : 'nullptr', // parentClassWrapper
-          object.construct ? `QJS${className}::ConstructorCallback` : 'nullptr',     // ConstructorCallback
-        ];
-
-        // Generate indexed property callback.
-        if (object.indexedProp) {
-          if (object.indexedProp.indexKeyType == 'number') {
-            wrapperTypeRegisterList.push(`IndexedPropertyGetterCallback`);
-            if (!object.indexedProp.readonly) {
-              wrapperTypeRegisterList.push(`IndexedPropertySetterCallback`);
-            } else {
-              wrapperTypeRegisterList.push('nullptr');
-            }
-            wrapperTypeRegisterList.push('nullptr');
-            wrapperTypeRegisterList.push('nullptr');
-          } else {
-            wrapperTypeRegisterList.push('nullptr');
-            wrapperTypeRegisterList.push('nullptr');
-
-            wrapperTypeRegisterList.push(`StringPropertyGetterCallback`);
-            if (!object.indexedProp.readonly) {
-              wrapperTypeRegisterList.push(`StringPropertySetterCallback`);
-            } else {
-              wrapperTypeRegisterList.push('nullptr');
-            }
-          }
-
-          wrapperTypeRegisterList.push('PropertyCheckerCallback');
-          wrapperTypeRegisterList.push('PropertyEnumerateCallback');
-          if (!object.indexedProp.readonly) {
-            wrapperTypeRegisterList.push('StringPropertyDeleterCallback')
-          } else {
-            wrapperTypeRegisterList.push('nullptr');
-          }
+          options.constructorInstallList.push(`{defined_properties::k${className}.Impl(), GetWrapperTypeInfo()}`)
         }
 
         let mixinParent = object.mixinParent;
@@ -643,6 +604,29 @@ export function generateCppSource(blob: IDLBlob, options: GenerateOptions) {
           });
         }
 
+        let indexedProp = object.indexedProp;
+        let isNumberIndexed = !!indexedProp && indexedProp.indexKeyType == 'number';
+        let isStringIndexed = !!indexedProp && indexedProp.indexKeyType != 'number';
+        let isIndexedWritable = !!indexedProp && !indexedProp.readonly;
+        // Methods and attributes are installed when the prototype is first used in a context.
+        let hasMembers = options.classPropsInstallList.length > 0 || options.classMethodsInstallList.length > 0;
+
+        // One entry per field of WrapperTypeInfo, in declaration order.
+        let wrapperTypeRegisterList = [
+          `JS_CLASS_${getWrapperTypeInfoNameOfClassName(className)}`,                        // ClassId
+          `"${className}"`,                                                          // ClassName
+          object.parent != null ? `${object.parent}::GetStaticWrapperTypeInfo()` : 'nullptr', // parentClassWrapper
+          object.construct ? `QJS${className}::ConstructorCallback` : 'nullptr',     // ConstructorCallback
+          isNumberIndexed ? 'IndexedPropertyGetterCallback' : 'nullptr',             // IndexedPropertyGetter
+          isNumberIndexed && isIndexedWritable ? 'IndexedPropertySetterCallback' : 'nullptr', // IndexedPropertySetter
+          isStringIndexed ? 'StringPropertyGetterCallback' : 'nullptr',              // StringPropertyGetter
+          isStringIndexed && isIndexedWritable ? 'StringPropertySetterCallback' : 'nullptr', // StringPropertySetter
+          indexedProp ? 'PropertyCheckerCallback' : 'nullptr',                       // PropertyChecker
+          indexedProp ? 'PropertyEnumerateCallback' : 'nullptr',                     // PropertyEnumerate
+          isIndexedWritable ? 'StringPropertyDeleterCallback' : 'nullptr',           // StringPropertyDeleter
+          hasMembers ? `QJS${className}::InstallMembers` : 'nullptr',                // InstallMembers
+        ];
+
         options.wrapperTypeInfoInit = `
 const WrapperTypeInfo QJS${className}::wrapper_type_info_ {${wrapperTypeRegisterList.join(', ')}};
 const WrapperTypeInfo& ${className}::wrapper_type_info_ = QJS${className}::wrapper_type_info_;`;
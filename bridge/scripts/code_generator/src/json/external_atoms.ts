@@ -0,0 +1,73 @@
+import fs from "fs";
+
+const ATOM_DEF = /^DEF\((\w+),\s*"((?:[^"\\]|\\.)*)"\)/;
+
+// Collects the names of the generated make_names files into the static atom table of QuickJS, the names get fixed
+// JSAtom constants created once per runtime and never reference counted.
+export class ExternalAtomTable {
+  // string -> identifier of the QuickJS atoms present in every build.
+  private builtinAtoms = new Map<string, string>();
+  // Strings which are atoms only in some builds (CONFIG_BIGNUM...) or are symbols, they can not be defined again.
+  private reservedStrings = new Set<string>();
+  private externalAtoms = new Map<string, string>();
+  private identifiers = new Set<string>();
+
+  constructor(quickjsAtomHeader: string) {
+    let depth = 0;
+    let symbols = false;
+    fs.readFileSync(quickjsAtomHeader, {encoding: 'utf-8'}).split('\n').forEach(line => {
+      line = line.trim();
+      if (line.startsWith('#ifdef DEF')) return;
+      if (line.startsWith('#if')) depth++;
+      if (line.startsWith('#endif')) depth--;
+      if (line.indexOf('symbols */') >= 0) symbols = true;
+      let match = line.match(ATOM_DEF);
+      if (!match) return;
+      let [, identifier, str] = match;
+      this.identifiers.add(identifier);
+      if (depth > 0 || symbols || str.startsWith('<')) {
+        this.reservedStrings.add(str);
+      } else {
+        this.builtinAtoms.set(str, identifier);
+      }
+    });
+  }
+
+  // Returns the JSAtom constant of |str|, or null when |str| has to be interned at runtime.
+  atomOf(str: string): string | null {
+    let identifier = this.builtinAtoms.get(str) || this.externalAtoms.get(str);
+    if (identifier) return 'JS_ATOM_' + identifier;
+
+    // Array indexes are tagged integer atoms and QuickJS initializes the table from latin1 strings.
+    if (this.reservedStrings.has(str) || /^(0|[1-9][0-9]*)$/.test(str) || !/^[\x20-\x7e]*$/.test(str) ||
+        str.indexOf('"') >= 0 || str.indexOf('\\') >= 0) {
+      return null;
+    }
+
+    identifier = 'webf_' + str.replace(/[^A-Za-z0-9_]/g, '_');
+    for (let i = 2; this.identifiers.has(identifier); i++) {
+      identifier = 'webf_' + str.replace(/[^A-Za-z0-9_]/g, '_') + '_' + i;
+    }
+    this.identifiers.add(identifier);
+    this.externalAtoms.set(str, identifier);
+    return 'JS_ATOM_' + identifier;
+  }
+
+  generate(): string {
+    let defs: string[] = [];
+    this.externalAtoms.forEach((identifier, str) => {
+      defs.push(`DEF(${identifier}, "${str}")`);
+    });
+    return `// External static string atoms defined by users.
+// Generated by the code generator from the make_names json5 files with the static_atoms option, do not edit.
+// Checked in for the QuickJS build, regenerate it with "node bin/code_generator -s ../../core -d ../../out" in
+// bridge/scripts/code_generator whenever those names change.
+
+#ifdef DEF
+
+${defs.join('\n')}
+
+#endif /* DEF */
+`;
+  }
+}
@@ -1,5 +1,6 @@
 import {JSONBlob} from './JSONBlob';
 import {JSONTemplate} from './JSONTemplate';
+import {ExternalAtomTable} from './external_atoms';
 import _ from 'lodash';
 
 function generateHeader(blob: JSONBlob, template: JSONTemplate, deps?: JSONBlob[], options: GenerateJSONOptions = {}): string {
@@ -22,7 +23,7 @@ function upperCamelCase(name: string) {
   return _.upperFirst(_.camelCase(name));
 }
 
-function generateBody(blob: JSONBlob, template: JSONTemplate, deps?: JSONBlob[], options: GenerateJSONOptions = {}): string {
+function generateBody(blob: JSONBlob, template: JSONTemplate, deps?: JSONBlob[], options: GenerateJSONOptions = {}, atoms?: ExternalAtomTable): string {
   let compiled = _.template(template.raw);
   return compiled({
     template_path: blob.source,
@@ -31,6 +32,7 @@ function generateBody(blob: JSONBlob, template: JSONTemplate, deps?: JSONBlob[],
     deps,
     options,
     upperCamelCase,
+    atomOf: (str: string) => atoms ? atoms.atomOf(str) : null,
   }).split('\n').filter(str => {
     return str.trim().length > 0;
   }).join('\n');
@@ -38,11 +40,13 @@ function generateBody(blob: JSONBlob, template: JSONTemplate, deps?: JSONBlob[],
 
 type GenerateJSONOptions = {
   add_atom_prefix?: boolean;
+  // The names become static atoms of QuickJS.
+  static_atoms?: boolean;
 };
 
-export function generateJSONTemplate(blob: JSONBlob, headerTemplate: JSONTemplate, bodyTemplate?: JSONTemplate, depsBlob?: JSONBlob[], options: GenerateJSONOptions = {}) {
+export function generateJSONTemplate(blob: JSONBlob, headerTemplate: JSONTemplate, bodyTemplate?: JSONTemplate, depsBlob?: JSONBlob[], options: GenerateJSONOptions = {}, atoms?: ExternalAtomTable) {
   let header = generateHeader(blob, headerTemplate, depsBlob, options);
-  let body = bodyTemplate ? generateBody(blob, bodyTemplate, depsBlob, options) : '';
+  let body = bodyTemplate ? generateBody(blob, bodyTemplate, depsBlob, options, atoms) : '';
 
   return {
     header: header,
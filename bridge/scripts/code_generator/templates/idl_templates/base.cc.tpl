@@ -33,13 +33,18 @@ namespace webf {
 <% if (globalFunctionInstallList.length > 0 || classPropsInstallList.length > 0 || classMethodsInstallList.length > 0 || constructorInstallList.length > 0) { %>
 void QJS<%= className %>::Install(ExecutingContext* context) {
   <% if (globalFunctionInstallList.length > 0) { %> InstallGlobalFunctions(context); <% } %>
-  <% if(classPropsInstallList.length > 0) { %> InstallPrototypeProperties(context); <% } %>
-  <% if(classMethodsInstallList.length > 0) { %> InstallPrototypeMethods(context); <% } %>
   <% if(constructorInstallList.length > 0) { %> InstallConstructor(context); <% } %>
 }
 
 <% } %>
 
+<% if (classPropsInstallList.length > 0 || classMethodsInstallList.length > 0) { %>
+void QJS<%= className %>::InstallMembers(ExecutingContext* context) {
+  <% if(classPropsInstallList.length > 0) { %> InstallPrototypeProperties(context); <% } %>
+  <% if(classMethodsInstallList.length > 0) { %> InstallPrototypeMethods(context); <% } %>
+}
+<% } %>
+
 <% if(globalFunctionInstallList.length > 0) { %>
 void QJS<%= className %>::InstallGlobalFunctions(ExecutingContext* context) {
   std::initializer_list<MemberInstaller::FunctionConfig> functionConfig {
@@ -75,13 +80,10 @@ void QJS<%= className %>::InstallPrototypeMethods(ExecutingContext* context) {
 
 <% if (constructorInstallList.length > 0) { %>
 void QJS<%= className %>::InstallConstructor(ExecutingContext* context) {
-  const WrapperTypeInfo* wrapperTypeInfo = GetWrapperTypeInfo();
-  JSValue constructor = context->contextData()->constructorForType(wrapperTypeInfo);
-
-  std::initializer_list<MemberInstaller::AttributeConfig> attributeConfig {
+  std::initializer_list<MemberInstaller::ConstructorConfig> constructorConfig {
     <%= constructorInstallList.join(',\n') %>
   };
-  MemberInstaller::InstallAttributes(context, context->Global(), attributeConfig);
+  MemberInstaller::InstallConstructors(context, context->Global(), constructorConfig);
 }
 <% } %>
 
@@ -31,24 +31,19 @@ thread_local const AtomicString& k<%= name %> = reinterpret_cast<AtomicString*>(
 <% } %>
 
 void Init(JSContext* ctx) {
+  // Names with a static atom skip the interning, the others (array indexes...) are interned from |str|.
   struct NameEntry {
-    <% if (options.add_atom_prefix) { %>
-      JSAtom atom;
-    <% } else { %>
-      const char* str;
-    <% } %>
-   };
+    JSAtom atom;
+    const char* str;
+  };
 
   static const NameEntry kNames[] = {
       <% _.forEach(data, function(name) { %>
         <% if (options.add_atom_prefix) { %>
-          { JS_ATOM_<%= name %> },
-        <% } else if (Array.isArray(name)) { %>
-          { "<%= name[1] %>" },
-        <% } else if(_.isObject(name)) { %>
-          { "<%= name.name %>" },
+          { JS_ATOM_<%= name %>, nullptr },
         <% } else { %>
-          { "<%= name %>" },
+          <% let str = Array.isArray(name) ? name[1] : _.isObject(name) ? name.name : name; %>
+          { <%= (options.static_atoms && atomOf(str)) || 'JS_ATOM_NULL' %>, "<%= str %>" },
         <% } %>
       <% }); %>
   };
@@ -56,25 +51,28 @@ void Init(JSContext* ctx) {
   <% if (deps && deps.html_attribute_names) { %>
     static const NameEntry kHtmlAttributeNames[] = {
       <% _.forEach(deps.html_attribute_names.data, function(name) { %>
-        { "<%= name %>" },
+        { <%= (options.static_atoms && atomOf(name)) || 'JS_ATOM_NULL' %>, "<%= name %>" },
       <% }); %>
      };
   <% } %>
 
   for(size_t i = 0; i < std::size(kNames); i ++) {
     void* address = reinterpret_cast<AtomicString*>(&names_storage) + i;
-    <% if (options.add_atom_prefix) { %>
+    if (kNames[i].atom != JS_ATOM_NULL) {
       new (address) AtomicString(ctx, kNames[i].atom);
-    <% } else { %>
+    } else {
       new (address) AtomicString(ctx, kNames[i].str);
-    <% } %>
-
+    }
   }
 
   <% if (deps && deps.html_attribute_names) { %>
     for(size_t i = 0; i < std::size(kHtmlAttributeNames); i ++) {
       void* address = reinterpret_cast<AtomicString*>(&html_attribute_names_storage) + i;
-      new (address) AtomicString(ctx, kHtmlAttributeNames[i].str);
+      if (kHtmlAttributeNames[i].atom != JS_ATOM_NULL) {
+        new (address) AtomicString(ctx, kHtmlAttributeNames[i].atom);
+      } else {
+        new (address) AtomicString(ctx, kHtmlAttributeNames[i].str);
+      }
     }
   <% } %>
 };
@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include <benchmark/benchmark.h>
+#include "bindings/qjs/script_value.h"
+#include "webf_test_env.h"
+
+using namespace webf;
+
+static JSValue NewArrayBuffer(JSContext* ctx, size_t length) {
+  std::vector<uint8_t> bytes(length);
+  return JS_NewArrayBufferCopy(ctx, bytes.data(), bytes.size());
+}
+
+// JavaScript -> Dart, the bytes were copied into a dart allocated buffer. This is the only way, the ArrayBuffer of the
+// script is never detached.
+static void CopyArrayBufferToNative(benchmark::State& state) {
+  auto env = TEST_init();
+  auto context = env->page()->executingContext();
+  JSContext* ctx = context->ctx();
+  JSValue array_buffer = NewArrayBuffer(ctx, state.range(0));
+  ScriptValue value = ScriptValue(ctx, array_buffer);
+  JS_FreeValue(ctx, array_buffer);
+
+  for (auto _ : state) {
+    ExceptionState exception_state;
+    NativeValue native_value = value.ToNative(ctx, exception_state);
+    FreeNativeByteBuffer(static_cast<NativeByteBuffer*>(native_value.u.ptr));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+// Dart -> JavaScript, the bytes were copied into a new ArrayBuffer.
+static void CopyNativeBytesToArrayBuffer(benchmark::State& state) {
+  auto env = TEST_init();
+  auto context = env->page()->executingContext();
+  JSContext* ctx = context->ctx();
+  std::vector<uint8_t> bytes(state.range(0));
+
+  for (auto _ : state) {
+    JSValue array_buffer = JS_NewArrayBufferCopy(ctx, bytes.data(), bytes.size());
+    JS_FreeValue(ctx, array_buffer);
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+// Dart -> JavaScript, the ArrayBuffer adopts the dart owned bytes.
+static void WrapNativeBytesToArrayBuffer(benchmark::State& state) {
+  auto env = TEST_init();
+  auto context = env->page()->executingContext();
+  JSContext* ctx = context->ctx();
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto* buffer = new NativeByteBuffer();
+    buffer->data = static_cast<uint8_t*>(dart_malloc(state.range(0)));
+    buffer->offset = 0;
+    buffer->length = state.range(0);
+    buffer->free_func = nullptr;
+    buffer->opaque = nullptr;
+    state.ResumeTiming();
+
+    ScriptValue value = ScriptValue(ctx, Native_NewArrayBuffer(buffer));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(CopyArrayBufferToNative)->RangeMultiplier(4)->Range(1 << 20, 64 << 20);
+BENCHMARK(CopyNativeBytesToArrayBuffer)->RangeMultiplier(4)->Range(1 << 20, 64 << 20);
+BENCHMARK(WrapNativeBytesToArrayBuffer)->RangeMultiplier(4)->Range(1 << 20, 64 << 20);
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <fstream>
+#include "bindings/qjs/bytecode_bundle.h"
+
+using namespace webf;
+
+static constexpr size_t kAppFunctions = 6400;
+
+// An app of about 5 MB of bytecode, the entry calls one function out of ten while it starts.
+static const std::string& AppBundlePath() {
+  static std::string path;
+  if (!path.empty())
+    return path;
+
+  std::string code;
+  for (size_t i = 0; i < kAppFunctions; i++) {
+    std::string id = std::to_string(i);
+    code += "function component_" + id + "(props) {\n"
+            "  const state = { id: " + id + ", title: 'component " + id + "', items: [], visible: true };\n"
+            "  function render(item, index) { return { key: state.id + ':' + index, text: `${state.title} ${item}` }; }\n"
+            "  for (let i = 0; i < props.count; i++) state.items.push(render(props.items[i % props.items.length], i));\n"
+            "  if (props.onUpdate) props.onUpdate(state.items.filter(item => item.text.length > 0).map(item => item.key));\n"
+            "  return { get size() { return state.items.length; }, hide() { state.visible = false; } };\n"
+            "}\n";
+  }
+  code += "const props = { count: 2, items: ['a', 'b'] };\nlet mounted = 0;\n";
+  for (size_t i = 0; i < kAppFunctions; i += 10) {
+    code += "mounted += component_" + std::to_string(i) + "(props).size;\n";
+  }
+
+  JSRuntime* runtime = JS_NewRuntime();
+  JSContext* ctx = JS_NewContext(runtime);
+  std::string bytes;
+  {
+    JSValue function = JS_Eval(ctx, code.c_str(), code.size(), "app.js", JS_EVAL_TYPE_GLOBAL | JS_EVAL_FLAG_COMPILE_ONLY);
+    BytecodeBundleWriter writer(ctx);
+    writer.Add("app.js", BytecodeBundle::kEntry, function);
+    JS_FreeValue(ctx, function);
+    bytes = writer.Finish();
+  }
+  JS_FreeContext(ctx);
+  JS_FreeRuntime(runtime);
+
+  path = (std::filesystem::temp_directory_path() / "webf_bytecode_bundle_benchmark.wbn").string();
+  std::ofstream(path, std::ios::binary).write(bytes.data(), bytes.size());
+  return path;
+}
+
+// Maps the bundle and evaluates its entry in a new runtime, as an app does when it starts.
+static void ColdStartBundle(benchmark::State& state, int flags) {
+  const std::string& path = AppBundlePath();
+  for (auto _ : state) {
+    JSRuntime* runtime = JS_NewRuntime();
+    JSContext* ctx = JS_NewContext(runtime);
+    {
+      auto bundle = BytecodeBundle::Open(path);
+      JSValue function = bundle->Read(ctx, bundle->modules()[0], flags);
+      JSValue result = JS_EvalFunction(ctx, function);
+      benchmark::DoNotOptimize(JS_IsException(result));
+      JS_FreeValue(ctx, result);
+      state.counters["bundle_bytes"] = bundle->modules()[0].length;
+    }
+    state.PauseTiming();
+    BytecodeBundle::Dispose();
+    JS_FreeContext(ctx);
+    JS_FreeRuntime(runtime);
+    state.ResumeTiming();
+  }
+}
+
+static void ColdStartEagerBundle(benchmark::State& state) {
+  ColdStartBundle(state, 0);
+}
+
+static void ColdStartLazyBundle(benchmark::State& state) {
+  ColdStartBundle(state, JS_READ_OBJ_LAZY);
+}
+
+BENCHMARK(ColdStartEagerBundle)->Unit(benchmark::kMillisecond);
+BENCHMARK(ColdStartLazyBundle)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include "bindings/qjs/bytecode_cache.h"
+#include "webf_test_env.h"
+
+using namespace webf;
+
+// Roughly the shape of a bundled app: many small functions which are declared but mostly not called.
+static std::string BundleSource(size_t functions) {
+  std::string code;
+  for (size_t i = 0; i < functions; i++) {
+    std::string name = "module_" + std::to_string(i);
+    code += "function " + name + "(exports, require) { var state = { id: " + std::to_string(i) +
+            ", items: [] }; exports.add = function(item) { state.items.push(item); return state.items.length; }; "
+            "exports.name = '" + name + "'; return exports; }\n";
+  }
+  return code;
+}
+
+static void EvaluateBundle(benchmark::State& state, bool cached) {
+  auto directory = std::filesystem::temp_directory_path() / "webf_bytecode_cache_benchmark";
+  std::filesystem::remove_all(directory);
+  BytecodeCache::Configure(cached ? directory.string() : "");
+
+  std::string code = BundleSource(state.range(0));
+  auto env = TEST_init();
+  auto context = env->page()->executingContext();
+  // Fills the cache.
+  context->EvaluateJavaScript(code.c_str(), code.size(), "https://example.com/bundle.js", 0);
+  if (cached) {
+    BytecodeCache::Current()->Flush();
+  }
+
+  for (auto _ : state) {
+    context->EvaluateJavaScript(code.c_str(), code.size(), "https://example.com/bundle.js", 0);
+  }
+  state.SetBytesProcessed(state.iterations() * code.size());
+  BytecodeCache::Configure("");
+}
+
+static void EvaluateBundleWithoutCache(benchmark::State& state) {
+  EvaluateBundle(state, false);
+}
+
+static void EvaluateBundleFromCache(benchmark::State& state) {
+  EvaluateBundle(state, true);
+}
+
+BENCHMARK(EvaluateBundleWithoutCache)->Arg(100)->Arg(1000)->Arg(5000);
+BENCHMARK(EvaluateBundleFromCache)->Arg(100)->Arg(1000)->Arg(5000);
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include <benchmark/benchmark.h>
+#include "binding_call_methods.h"
+#include "core/dom/events/event.h"
+#include "core/dom/events/event_target.h"
+#include "foundation/native_value_converter.h"
+#include "webf_test_env.h"
+
+using namespace webf;
+
+static EventTarget* GetTarget(ExecutingContext* context, const char* name) {
+  JSValue value = JS_GetPropertyStr(context->ctx(), context->Global(), name);
+  auto* target = toScriptWrappable<EventTarget>(value);
+  JS_FreeValue(context->ctx(), value);
+  return target;
+}
+
+// Simulates _dispatchEventToNative() in webf/lib/src/bridge/binding.dart, a new raw event and event type string are
+// created by dart for every dispatch.
+static void DispatchEventsFromDart(benchmark::State& state, const char* target_name, const char* event_type) {
+  auto env = TEST_init();
+  auto context = env->page()->executingContext();
+  std::string code = R"(
+var withListener = document.createElement('div');
+var withoutListener = document.createElement('div');
+document.body.appendChild(withListener);
+document.body.appendChild(withoutListener);
+withListener.addEventListener('scroll', () => {});
+withListener.addEventListener('resize', () => {});
+)";
+  context->EvaluateJavaScript(code.c_str(), code.size(), "vm://", 0);
+  EventTarget* target = GetTarget(context, target_name);
+  AtomicString type = AtomicString(context->ctx(), event_type);
+
+  NativeEvent native_event;
+  native_event.target = target->bindingObject();
+  native_event.currentTarget = target->bindingObject();
+  native_event.props = nullptr;
+  native_event.props_len = 0;
+  native_event.alloc_size = 0;
+  RawEvent raw_event;
+  raw_event.bytes = reinterpret_cast<uint64_t*>(&native_event);
+  raw_event.length = sizeof(NativeEvent) / sizeof(int64_t);
+  raw_event.is_custom_event = 0;
+
+  for (auto _ : state) {
+    for (int64_t i = 0; i < state.range(0); i++) {
+      NativeValue arguments[] = {NativeValueConverter<NativeTypeString>::ToNativeValue(context->ctx(), type),
+                                 NativeValueConverter<NativeTypePointer<RawEvent>>::ToNativeValue(&raw_event),
+                                 NativeValueConverter<NativeTypeBool>::ToNativeValue(false)};
+      NativeValue result = target->HandleCallFromDartSide(binding_call_methods::kdispatchEvent, 3, arguments, nullptr);
+      if (result.tag == NativeTag::TAG_POINTER) {
+        dart_free(result.u.ptr);
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Dropped by the listener check before the event is created.
+static void DispatchEventToTargetWithoutListeners(benchmark::State& state) {
+  DispatchEventsFromDart(state, "withoutListener", "scroll");
+}
+
+// Scroll events reuse the pooled event object.
+static void DispatchPooledEventToTargetWithListeners(benchmark::State& state) {
+  DispatchEventsFromDart(state, "withListener", "scroll");
+}
+
+// Resize events create a new event object for every dispatch.
+static void DispatchEventToTargetWithListeners(benchmark::State& state) {
+  DispatchEventsFromDart(state, "withListener", "resize");
+}
+
+BENCHMARK(DispatchEventToTargetWithoutListeners)->Arg(100000)->Unit(benchmark::kMillisecond);
+BENCHMARK(DispatchPooledEventToTargetWithListeners)->Arg(100000)->Unit(benchmark::kMillisecond);
+BENCHMARK(DispatchEventToTargetWithListeners)->Arg(100000)->Unit(benchmark::kMillisecond);
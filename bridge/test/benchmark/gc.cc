@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include <benchmark/benchmark.h>
+#include "webf_test_env.h"
+
+using namespace webf;
+
+// The script of integration_tests/memory_leak_specs/single_long_list: 1000 styled elements with their text nodes stay
+// alive during the collections.
+static const char* kSingleLongList = R"(
+const container = document.createElement('div');
+container.style.display = 'sliver';
+container.style.height = '60vh';
+for (let i = 0; i < 1000; i++) {
+  const ele = document.createElement('div');
+  ele.style.background = i % 2 ? '#fff' : '#e6e6e6';
+  ele.style.padding = '35rpx 60rpx';
+  ele.appendChild(document.createTextNode(i));
+  container.appendChild(ele);
+}
+document.body.appendChild(container);
+)";
+
+// The temporary objects of a frame, in cycles so that only the cycle collector frees them.
+static const char* kGarbage = R"(
+for (let i = 0; i < 200; i++) {
+  let a = { i };
+  let b = { a, items: [a, i] };
+  a.b = b;
+  let listener = () => b;
+  b.listener = listener;
+}
+)";
+
+static void AddPauseCounters(benchmark::State& state, const GCScheduler::PauseHistogram& histogram) {
+  for (size_t i = 0; i < GCScheduler::PauseHistogram::kBucketCount; i++) {
+    std::string name = i < GCScheduler::PauseHistogram::kBucketCount - 1
+                           ? "<" + std::to_string(GCScheduler::PauseHistogram::kBucketLimitsUs[i]) + "us"
+                           : ">=" + std::to_string(GCScheduler::PauseHistogram::kBucketLimitsUs[i - 1]) + "us";
+    state.counters[name] = histogram.counts[i];
+  }
+}
+
+static void RunCollections(benchmark::State& state, bool minor) {
+  auto env = TEST_init();
+  auto* context = env->page()->executingContext();
+  env->page()->evaluateScript(kSingleLongList, strlen(kSingleLongList), "vm://", 0);
+  JSRuntime* runtime = context->dartIsolateContext()->runtime();
+  GCScheduler* scheduler = context->dartIsolateContext()->gcScheduler();
+  // The page is built, its elements are old by now.
+  JS_RunGC(runtime);
+  GCScheduler::Stats stats_before = scheduler->stats();
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    env->page()->evaluateScript(kGarbage, strlen(kGarbage), "vm://", 0);
+    state.ResumeTiming();
+    if (minor) {
+      JS_RunMinorGC(runtime);
+    } else {
+      JS_RunGC(runtime);
+    }
+  }
+
+  GCScheduler::PauseHistogram pauses = minor ? scheduler->stats().minor_pauses : scheduler->stats().full_pauses;
+  const GCScheduler::PauseHistogram& pauses_before = minor ? stats_before.minor_pauses : stats_before.full_pauses;
+  for (size_t i = 0; i < GCScheduler::PauseHistogram::kBucketCount; i++) {
+    pauses.counts[i] -= pauses_before.counts[i];
+  }
+  AddPauseCounters(state, pauses);
+}
+
+static void FullCollection(benchmark::State& state) {
+  RunCollections(state, false);
+}
+
+static void MinorCollection(benchmark::State& state) {
+  RunCollections(state, true);
+}
+
+BENCHMARK(FullCollection)->Unit(benchmark::kMicrosecond);
+BENCHMARK(MinorCollection)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include <benchmark/benchmark.h>
+#include "webf_test_env.h"
+
+using namespace webf;
+
+// The properties read below are accessors on the prototypes of the elements: `style` on HTMLElement, `parentNode` on
+// Node and `className` on Element. The polymorphic variant loops over elements of different tags, whose shapes
+// overflow the inline cache ring of each site.
+static const char* kSetup = R"(
+var tags = ['div', 'span', 'p', 'a', 'img', 'ul', 'li', 'section', 'button', 'input'];
+var container = document.createElement('div');
+document.body.appendChild(container);
+function createElements(tagCount) {
+  var elements = [];
+  for (var i = 0; i < 100; i++) {
+    var element = document.createElement(tags[i % tagCount]);
+    element.className = 'item';
+    container.appendChild(element);
+    elements.push(element);
+  }
+  return elements;
+}
+var monomorphic = createElements(1);
+var polymorphic = createElements(tags.length);
+function readStyle(elements) {
+  var n = 0;
+  for (var i = 0; i < elements.length; i++) if (elements[i].style) n++;
+  return n;
+}
+function readParentNode(elements) {
+  var n = 0;
+  for (var i = 0; i < elements.length; i++) if (elements[i].parentNode === container) n++;
+  return n;
+}
+function readWriteClassName(elements) {
+  for (var i = 0; i < elements.length; i++) elements[i].className = elements[i].className;
+}
+)";
+
+static void RunLoop(benchmark::State& state, const char* function, const char* elements) {
+  auto env = TEST_init();
+  auto context = env->page()->executingContext();
+  context->EvaluateJavaScript(kSetup, strlen(kSetup), "vm://", 0);
+  JSContext* ctx = context->ctx();
+  JSValue func = JS_GetPropertyStr(ctx, context->Global(), function);
+  JSValue argument = JS_GetPropertyStr(ctx, context->Global(), elements);
+
+  for (auto _ : state) {
+    JSValue result = JS_Call(ctx, func, JS_UNDEFINED, 1, &argument);
+    JS_FreeValue(ctx, result);
+  }
+  state.SetItemsProcessed(state.iterations() * 100);
+
+  JS_FreeValue(ctx, argument);
+  JS_FreeValue(ctx, func);
+}
+
+static void ReadStyle(benchmark::State& state) {
+  RunLoop(state, "readStyle", "monomorphic");
+}
+
+static void ReadStylePolymorphic(benchmark::State& state) {
+  RunLoop(state, "readStyle", "polymorphic");
+}
+
+static void ReadParentNode(benchmark::State& state) {
+  RunLoop(state, "readParentNode", "monomorphic");
+}
+
+static void ReadParentNodePolymorphic(benchmark::State& state) {
+  RunLoop(state, "readParentNode", "polymorphic");
+}
+
+static void ReadWriteClassName(benchmark::State& state) {
+  RunLoop(state, "readWriteClassName", "monomorphic");
+}
+
+static void ReadWriteClassNamePolymorphic(benchmark::State& state) {
+  RunLoop(state, "readWriteClassName", "polymorphic");
+}
+
+BENCHMARK(ReadStyle)->Unit(benchmark::kMicrosecond);
+BENCHMARK(ReadStylePolymorphic)->Unit(benchmark::kMicrosecond);
+BENCHMARK(ReadParentNode)->Unit(benchmark::kMicrosecond);
+BENCHMARK(ReadParentNodePolymorphic)->Unit(benchmark::kMicrosecond);
+BENCHMARK(ReadWriteClassName)->Unit(benchmark::kMicrosecond);
+BENCHMARK(ReadWriteClassNamePolymorphic)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include <benchmark/benchmark.h>
+#include "include/webf_bridge.h"
+#include "page.h"
+#include "webf_test_env.h"
+
+using namespace webf;
+
+// Reads every global property, which creates all the binding classes as the eager installation did.
+static const char* kTouchAllGlobals = "Object.getOwnPropertyNames(globalThis).forEach(name => globalThis[name]);";
+
+static int64_t MallocSize(DartIsolateContext* dart_isolate_context) {
+  JSMemoryUsage usage;
+  JS_ComputeMemoryUsage(dart_isolate_context->runtime(), &usage);
+  return usage.malloc_size;
+}
+
+// Reports the time to create a context and the memory it holds right after, with |touch_all_globals| standing for
+// the eagerly installed bindings.
+static void CreateContext(benchmark::State& state, bool touch_all_globals) {
+  auto mocked_dart_methods = TEST_getMockDartMethods(nullptr);
+  auto* dart_isolate_context = static_cast<DartIsolateContext*>(
+      initDartIsolateContextSync(0, mocked_dart_methods.data(), mocked_dart_methods.size(), true));
+  double page_id = -4000000;
+  // Keeps the runtime and the shared strings alive between the iterations.
+  void* first_page = allocateNewPageSync(page_id--, dart_isolate_context);
+  int64_t context_bytes = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    int64_t before = MallocSize(dart_isolate_context);
+    state.ResumeTiming();
+
+    void* page = allocateNewPageSync(page_id, dart_isolate_context);
+    if (touch_all_globals) {
+      static_cast<WebFPage*>(page)->evaluateScript(kTouchAllGlobals, strlen(kTouchAllGlobals), "vm://", 0);
+    }
+
+    state.PauseTiming();
+    context_bytes += MallocSize(dart_isolate_context) - before;
+    disposePageSync(page_id--, dart_isolate_context, page);
+    state.ResumeTiming();
+  }
+  state.counters["context_bytes"] = benchmark::Counter(context_bytes, benchmark::Counter::kAvgIterations);
+  disposePageSync(-4000000, dart_isolate_context, first_page);
+  delete dart_isolate_context;
+}
+
+static void CreateContextLazyBindings(benchmark::State& state) {
+  CreateContext(state, false);
+}
+
+static void CreateContextAllBindings(benchmark::State& state) {
+  CreateContext(state, true);
+}
+
+BENCHMARK(CreateContextLazyBindings)->Unit(benchmark::kMicrosecond);
+BENCHMARK(CreateContextAllBindings)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include "webf_test_env.h"
+
+using namespace webf;
+
+static void EvaluateInLoop(benchmark::State& state, const std::string& setup, const std::string& body) {
+  auto env = TEST_init();
+  auto context = env->page()->executingContext();
+  auto directory = std::filesystem::temp_directory_path() / "webf_storage_benchmark";
+  std::filesystem::remove_all(directory);
+  std::filesystem::create_directories(directory);
+  context->SetLocalStorageDirectory(directory.string(), {});
+
+  context->EvaluateJavaScript(setup.c_str(), setup.size(), "vm://", 0);
+  std::string code = "for (let i = 0; i < " + std::to_string(state.range(0)) + "; i++) { " + body + " }";
+  for (auto _ : state) {
+    context->EvaluateJavaScript(code.c_str(), code.size(), "vm://", 0);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void NativeLocalStorageGetItem(benchmark::State& state) {
+  EvaluateInLoop(state, "localStorage.setItem('theme', 'dark');", "localStorage.getItem('theme');");
+}
+
+static void NativeLocalStorageSetItem(benchmark::State& state) {
+  EvaluateInLoop(state, "", "localStorage.setItem('counter', String(i));");
+}
+
+// The former polyfill called into the LocalStorage module of dart for every access. The mocked dart method in the
+// test environment returns immediately, the cost of the thread hop and the dart side lookup is not included.
+static void PolyfillLocalStorageGetItem(benchmark::State& state) {
+  EvaluateInLoop(state, "", "webf.invokeModule('LocalStorage', 'getItem', 'theme');");
+}
+
+static void PolyfillLocalStorageSetItem(benchmark::State& state) {
+  EvaluateInLoop(state, "", "webf.invokeModule('LocalStorage', 'setItem', ['counter', String(i)]);");
+}
+
+BENCHMARK(NativeLocalStorageGetItem)->Arg(100000)->Unit(benchmark::kMillisecond);
+BENCHMARK(PolyfillLocalStorageGetItem)->Arg(100000)->Unit(benchmark::kMillisecond);
+BENCHMARK(NativeLocalStorageSetItem)->Arg(100000)->Unit(benchmark::kMillisecond);
+BENCHMARK(PolyfillLocalStorageSetItem)->Arg(100000)->Unit(benchmark::kMillisecond);
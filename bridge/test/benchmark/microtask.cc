@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include <benchmark/benchmark.h>
+#include "webf_test_env.h"
+
+using namespace webf;
+
+static constexpr int kEnqueueCount = 1000000;
+
+static void CountMicrotask(void* data) {
+  (*static_cast<int64_t*>(data))++;
+}
+
+// The microtask path before the native queue: one JS object and one heap allocated record per callback, delivered
+// through the job queue of QuickJS.
+struct LegacyMicrotaskDeliver {
+  MicrotaskCallback callback;
+  void* data;
+};
+
+static void EnqueueLegacyMicrotask(JSContext* ctx, MicrotaskCallback callback, void* data) {
+  JSValue proxy_data = JS_NewObject(ctx);
+  auto* deliver = new LegacyMicrotaskDeliver();
+  deliver->data = data;
+  deliver->callback = callback;
+  JS_SetOpaque(proxy_data, deliver);
+  JS_EnqueueJob(
+      ctx,
+      [](JSContext* ctx, int argc, JSValueConst* argv) -> JSValue {
+        auto* deliver = static_cast<LegacyMicrotaskDeliver*>(JS_GetOpaque(argv[0], JS_CLASS_OBJECT));
+        deliver->callback(deliver->data);
+        delete deliver;
+        return JS_NULL;
+      },
+      1, &proxy_data);
+  JS_FreeValue(ctx, proxy_data);
+}
+
+static void NativeMicrotasks(benchmark::State& state) {
+  auto env = TEST_init();
+  auto* context = env->page()->executingContext();
+  int64_t delivered = 0;
+  for (auto _ : state) {
+    for (int i = 0; i < kEnqueueCount; i++) {
+      context->EnqueueMicrotask(CountMicrotask, &delivered);
+    }
+    context->DrainMicrotasks();
+  }
+  state.counters["delivered"] = delivered;
+  state.SetItemsProcessed(state.iterations() * kEnqueueCount);
+}
+
+static void LegacyJSJobMicrotasks(benchmark::State& state) {
+  auto env = TEST_init();
+  auto* context = env->page()->executingContext();
+  int64_t delivered = 0;
+  for (auto _ : state) {
+    for (int i = 0; i < kEnqueueCount; i++) {
+      EnqueueLegacyMicrotask(context->ctx(), CountMicrotask, &delivered);
+    }
+    context->DrainMicrotasks();
+  }
+  state.counters["delivered"] = delivered;
+  state.SetItemsProcessed(state.iterations() * kEnqueueCount);
+}
+
+BENCHMARK(NativeMicrotasks)->Unit(benchmark::kMillisecond);
+BENCHMARK(LegacyJSJobMicrotasks)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include <benchmark/benchmark.h>
+#include "bindings/qjs/native_string_utils.h"
+#include "foundation/ui_command_buffer.h"
+#include "webf_test_env.h"
+
+using namespace webf;
+
+static size_t NativeStringBytes(const SharedNativeString* string) {
+  return string->length() * (string->Is8Bit() ? sizeof(uint8_t) : sizeof(uint16_t));
+}
+
+// Builds a large DOM with attributes, classes and inline styles, and reports the bytes of the strings carried by the
+// UI commands, next to the bytes they took when every string was widened to UTF-16.
+static void LargeDomStringBytes(benchmark::State& state) {
+  auto env = TEST_init();
+  auto context = env->page()->executingContext();
+  std::string code = "(() => { let container = document.createElement('div'); for (let i = 0; i < " +
+                     std::to_string(state.range(0)) + R"(; i++) {
+  let child = document.createElement('div');
+  child.setAttribute('id', 'item-' + i);
+  child.className = 'list-item list-item--' + (i % 10);
+  child.style.color = 'rgb(10, 20, 30)';
+  child.style.padding = '4px 8px';
+  child.setAttribute('data-title', 'The quick brown fox jumps over the lazy dog');
+  container.appendChild(child);
+}
+document.body.appendChild(container); })();)";
+
+  size_t native_bytes = 0;
+  size_t utf16_bytes = 0;
+  for (auto _ : state) {
+    context->EvaluateJavaScript(code.c_str(), code.size(), "vm://", 0);
+
+    state.PauseTiming();
+    auto* items = static_cast<UICommandItem*>(context->uiCommandBuffer()->data());
+    int64_t size = context->uiCommandBuffer()->size();
+    for (int64_t i = 0; i < size; i++) {
+      UICommandItem& item = items[i];
+      if (item.string_01 != 0) {
+        bool is_8bit = (item.args_01_length & UICommandItem::kArgs01Latin1Flag) != 0;
+        uint32_t length = item.args_01_length & ~UICommandItem::kArgs01Latin1Flag;
+        native_bytes += length * (is_8bit ? sizeof(uint8_t) : sizeof(uint16_t));
+        utf16_bytes += length * sizeof(uint16_t);
+        free(reinterpret_cast<void*>(item.string_01));
+      }
+      if (item.type == static_cast<int32_t>(UICommand::kSetStyle) ||
+          item.type == static_cast<int32_t>(UICommand::kSetAttribute)) {
+        auto* value = reinterpret_cast<AutoFreeNativeString*>(item.nativePtr2);
+        if (value != nullptr) {
+          native_bytes += NativeStringBytes(value);
+          utf16_bytes += value->length() * sizeof(uint16_t);
+          delete value;
+        }
+      }
+    }
+    context->uiCommandBuffer()->clear();
+    state.ResumeTiming();
+  }
+
+  state.counters["native_bytes"] = benchmark::Counter(native_bytes, benchmark::Counter::kAvgIterations);
+  state.counters["utf16_bytes"] = benchmark::Counter(utf16_bytes, benchmark::Counter::kAvgIterations);
+}
+
+static JSValue NewLatin1String(JSContext* ctx, int64_t length) {
+  std::string source(length, 'a');
+  return JS_NewStringLen(ctx, source.c_str(), source.size());
+}
+
+static void ConvertLatin1NativeString(benchmark::State& state) {
+  auto env = TEST_init();
+  JSContext* ctx = env->page()->executingContext()->ctx();
+  JSValue value = NewLatin1String(ctx, state.range(0));
+  for (auto _ : state) {
+    auto native_string = jsValueToNativeString(ctx, value);
+    benchmark::DoNotOptimize(native_string->characters8());
+    delete static_cast<AutoFreeNativeString*>(native_string.release());
+  }
+  JS_FreeValue(ctx, value);
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+// The former conversion which widened every Latin-1 character to UTF-16.
+static void ConvertWidenedNativeString(benchmark::State& state) {
+  auto env = TEST_init();
+  JSContext* ctx = env->page()->executingContext()->ctx();
+  JSValue value = NewLatin1String(ctx, state.range(0));
+  for (auto _ : state) {
+    uint32_t length;
+    auto* string = new SharedNativeString(JS_ToUnicode(ctx, value, &length), length);
+    benchmark::DoNotOptimize(string->string());
+    delete static_cast<AutoFreeNativeString*>(string);
+  }
+  JS_FreeValue(ctx, value);
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(LargeDomStringBytes)->Arg(1000)->Arg(10000);
+BENCHMARK(ConvertLatin1NativeString)->Arg(16)->Arg(256)->Arg(4096);
+BENCHMARK(ConvertWidenedNativeString)->Arg(16)->Arg(256)->Arg(4096);
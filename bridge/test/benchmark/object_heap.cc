@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include <benchmark/benchmark.h>
+#if ENABLE_MI_MALLOC
+#include "mimalloc.h"
+#endif
+#include "bindings/qjs/cppgc/object_heap.h"
+#include "include/webf_bridge.h"
+#include "page.h"
+#include "webf_test_env.h"
+
+using namespace webf;
+
+// Builds 700 nodes and keeps every tenth subtree alive, so the long lived nodes are scattered over the pages of the
+// collected ones.
+static const char* kChurnNodes = R"(
+globalThis.retained = globalThis.retained || [];
+for (let i = 0; i < 100; i++) {
+  let div = document.createElement('div');
+  for (let j = 0; j < 3; j++) {
+    let span = document.createElement('span');
+    span.appendChild(document.createTextNode('text'));
+    div.appendChild(span);
+  }
+  if (i % 10 === 0) retained.push(div);
+}
+)";
+
+static void ChurnNodes(benchmark::State& state) {
+  auto mocked_dart_methods = TEST_getMockDartMethods(nullptr);
+  auto* dart_isolate_context = static_cast<DartIsolateContext*>(
+      initDartIsolateContextSync(0, mocked_dart_methods.data(), mocked_dart_methods.size(), true));
+  double page_id = -5000000;
+  auto* page = static_cast<WebFPage*>(allocateNewPageSync(page_id, dart_isolate_context));
+  for (auto _ : state) {
+    page->evaluateScript(kChurnNodes, strlen(kChurnNodes), "vm://", 0);
+    JS_RunGC(dart_isolate_context->runtime());
+  }
+  state.SetItemsProcessed(state.iterations() * 700);
+
+  ObjectHeap::Stats stats = ObjectHeap::stats();
+  state.counters["live_objects"] = stats.live_objects;
+  if (stats.committed_bytes > 0) {
+    state.counters["fragmentation"] = 1.0 - static_cast<double>(stats.used_bytes) / stats.committed_bytes;
+  }
+#if ENABLE_MI_MALLOC
+  size_t elapsed, user, system, current_rss, peak_rss, current_commit, peak_commit, page_faults;
+  mi_process_info(&elapsed, &user, &system, &current_rss, &peak_rss, &current_commit, &peak_commit, &page_faults);
+  state.counters["rss"] = benchmark::Counter(current_rss, benchmark::Counter::kDefaults, benchmark::Counter::kIs1024);
+  state.counters["peak_rss"] = benchmark::Counter(peak_rss, benchmark::Counter::kDefaults, benchmark::Counter::kIs1024);
+#endif
+
+  disposePageSync(page_id, dart_isolate_context, page);
+  delete dart_isolate_context;
+}
+
+BENCHMARK(ChurnNodes)->Unit(benchmark::kMicrosecond);
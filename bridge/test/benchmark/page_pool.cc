@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include <benchmark/benchmark.h>
+#include "include/webf_bridge.h"
+#include "page.h"
+#include "webf_test_env.h"
+
+using namespace webf;
+
+static const char* kFirstScript = "document.body.appendChild(document.createElement('div'));";
+
+static void EvaluateFirstScript(void* page) {
+  static_cast<WebFPage*>(page)->evaluateScript(kFirstScript, strlen(kFirstScript), "vm://first.js", 0);
+}
+
+// From allocateNewPageSync to the end of the first script of the page.
+static void AllocateToFirstScript(benchmark::State& state) {
+  auto mocked_dart_methods = TEST_getMockDartMethods(nullptr);
+  auto* dart_isolate_context = static_cast<DartIsolateContext*>(
+      initDartIsolateContextSync(0, mocked_dart_methods.data(), mocked_dart_methods.size(), true));
+  double page_id = -2000;
+  for (auto _ : state) {
+    void* page = allocateNewPageSync(page_id, dart_isolate_context);
+    EvaluateFirstScript(page);
+
+    state.PauseTiming();
+    disposePageSync(page_id--, dart_isolate_context, page);
+    state.ResumeTiming();
+  }
+  delete dart_isolate_context;
+}
+
+// The same with the page built ahead of time, as the idle time of the UI thread does.
+static void AllocatePrewarmedToFirstScript(benchmark::State& state) {
+  auto mocked_dart_methods = TEST_getMockDartMethods(nullptr);
+  auto* dart_isolate_context = static_cast<DartIsolateContext*>(
+      initDartIsolateContextSync(0, mocked_dart_methods.data(), mocked_dart_methods.size(), true));
+  double page_id = -3000000;
+  for (auto _ : state) {
+    state.PauseTiming();
+    prewarmPageSync(page_id, dart_isolate_context);
+    state.ResumeTiming();
+
+    void* page = allocateNewPageSync(page_id, dart_isolate_context);
+    EvaluateFirstScript(page);
+
+    state.PauseTiming();
+    disposePageSync(page_id--, dart_isolate_context, page);
+    state.ResumeTiming();
+  }
+  delete dart_isolate_context;
+}
+
+BENCHMARK(AllocateToFirstScript)->Unit(benchmark::kMicrosecond);
+BENCHMARK(AllocatePrewarmedToFirstScript)->Unit(benchmark::kMicrosecond);
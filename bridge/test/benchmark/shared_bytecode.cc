@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include <benchmark/benchmark.h>
+#include <map>
+#include "webf_test_env.h"
+
+using namespace webf;
+
+// Every page evaluates the polyfill and the plugins while it is created.
+static void CreatePage(benchmark::State& state) {
+  for (auto _ : state) {
+    auto env = TEST_init();
+    benchmark::DoNotOptimize(env->page()->executingContext());
+  }
+}
+
+// Roughly the shape of a plugin bundle: many small functions which are declared but mostly not called.
+static std::vector<uint8_t> PluginByteCode(ExecutingContext* context, size_t functions) {
+  std::string code;
+  for (size_t i = 0; i < functions; i++) {
+    std::string name = "plugin_" + std::to_string(i);
+    code += "function " + name + "(exports) { var state = { id: " + std::to_string(i) +
+            ", items: [] }; exports.add = function(item) { state.items.push(item); return state.items.length; }; "
+            "return exports; }\n";
+  }
+  JSValue function =
+      JS_Eval(context->ctx(), code.c_str(), code.size(), "vm://plugin.js", JS_EVAL_TYPE_GLOBAL | JS_EVAL_FLAG_COMPILE_ONLY);
+  size_t length;
+  uint8_t* bytes = JS_WriteObject(context->ctx(), &length, function, JS_WRITE_OBJ_BYTECODE);
+  std::vector<uint8_t> result(bytes, bytes + length);
+  js_free(context->ctx(), bytes);
+  JS_FreeValue(context->ctx(), function);
+  return result;
+}
+
+static void EvaluatePluginByteCode(benchmark::State& state) {
+  auto env = TEST_init();
+  auto context = env->page()->executingContext();
+  std::vector<uint8_t> bytes = PluginByteCode(context, state.range(0));
+  for (auto _ : state) {
+    context->EvaluateByteCode(bytes.data(), bytes.size());
+  }
+}
+
+static void EvaluateSharedPluginByteCode(benchmark::State& state) {
+  auto env = TEST_init();
+  auto context = env->page()->executingContext();
+  // Kept alive as long as the runtime, as the bytecode of registered plugins.
+  static std::map<int64_t, std::vector<uint8_t>> plugins;
+  std::vector<uint8_t>& plugin = plugins[state.range(0)];
+  if (plugin.empty()) {
+    plugin = PluginByteCode(context, state.range(0));
+  }
+  for (auto _ : state) {
+    context->EvaluateSharedByteCode(plugin.data(), plugin.size());
+  }
+}
+
+BENCHMARK(CreatePage);
+BENCHMARK(EvaluatePluginByteCode)->Arg(100)->Arg(1000)->Arg(2000);
+BENCHMARK(EvaluateSharedPluginByteCode)->Arg(100)->Arg(1000)->Arg(2000);
@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "foundation/transcoding.h"
+
+using namespace webf;
+
+// The length classes: tag names and attribute values, class lists and style text, text contents and scripts.
+#define TRANSCODING_LENGTHS ->Arg(8)->Arg(64)->Arg(1024)->Arg(65536)
+
+static std::string LatinSource(size_t length) {
+  std::string result;
+  result.reserve(length);
+  const char* text = "The quick brown fox jumps over the lazy dog. ";
+  for (size_t i = 0; i < length; i++) {
+    result.push_back(text[i % 45]);
+  }
+  return result;
+}
+
+static std::vector<uint16_t> UTF16Source(size_t length) {
+  std::string latin = LatinSource(length);
+  return std::vector<uint16_t>(latin.begin(), latin.end());
+}
+
+static void Latin1ToUTF16Simd(benchmark::State& state) {
+  std::string source = LatinSource(state.range(0));
+  std::vector<uint16_t> destination(source.size());
+  for (auto _ : state) {
+    Latin1ToUTF16(reinterpret_cast<const uint8_t*>(source.data()), source.size(), destination.data());
+    benchmark::DoNotOptimize(destination.data());
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+static void Latin1ToUTF16Scalar(benchmark::State& state) {
+  std::string source = LatinSource(state.range(0));
+  std::vector<uint16_t> destination(source.size());
+  for (auto _ : state) {
+    scalar::Latin1ToUTF16(reinterpret_cast<const uint8_t*>(source.data()), source.size(), destination.data());
+    benchmark::DoNotOptimize(destination.data());
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+static void UTF16ToUTF8Simd(benchmark::State& state) {
+  std::vector<uint16_t> source = UTF16Source(state.range(0));
+  std::vector<char> destination(source.size() * 3);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(UTF16ToUTF8(source.data(), source.size(), destination.data()));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(uint16_t));
+}
+
+static void UTF16ToUTF8Scalar(benchmark::State& state) {
+  std::vector<uint16_t> source = UTF16Source(state.range(0));
+  std::vector<char> destination(source.size() * 3);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(scalar::UTF16ToUTF8(source.data(), source.size(), destination.data()));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(uint16_t));
+}
+
+static void UTF8ToUTF16Simd(benchmark::State& state) {
+  std::string source = LatinSource(state.range(0));
+  std::vector<uint16_t> destination(source.size());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(UTF8ToUTF16(source.data(), source.size(), destination.data()));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+static void UTF8ToUTF16Scalar(benchmark::State& state) {
+  std::string source = LatinSource(state.range(0));
+  std::vector<uint16_t> destination(source.size());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(scalar::UTF8ToUTF16(source.data(), source.size(), destination.data()));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+static void ValidateUTF8Simd(benchmark::State& state) {
+  std::string source = LatinSource(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(IsValidUTF8(source.data(), source.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+static void ValidateUTF8Scalar(benchmark::State& state) {
+  std::string source = LatinSource(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(scalar::IsValidUTF8(source.data(), source.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(Latin1ToUTF16Simd) TRANSCODING_LENGTHS;
+BENCHMARK(Latin1ToUTF16Scalar) TRANSCODING_LENGTHS;
+BENCHMARK(UTF16ToUTF8Simd) TRANSCODING_LENGTHS;
+BENCHMARK(UTF16ToUTF8Scalar) TRANSCODING_LENGTHS;
+BENCHMARK(UTF8ToUTF16Simd) TRANSCODING_LENGTHS;
+BENCHMARK(UTF8ToUTF16Scalar) TRANSCODING_LENGTHS;
+BENCHMARK(ValidateUTF8Simd) TRANSCODING_LENGTHS;
+BENCHMARK(ValidateUTF8Scalar) TRANSCODING_LENGTHS;
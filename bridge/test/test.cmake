@@ -19,8 +19,18 @@ list(APPEND WEBF_UNIT_TEST_SOURCEURCE
   ./bindings/qjs/atomic_string_test.cc
   ./bindings/qjs/script_value_test.cc
   ./bindings/qjs/qjs_engine_patch_test.cc
+  ./bindings/qjs/structured_serializer_test.cc
+  ./bindings/qjs/bytecode_cache_test.cc
+  ./bindings/qjs/shared_bytecode_test.cc
+  ./bindings/qjs/bytecode_bundle_test.cc
+  ./foundation/transcoding_test.cc
   ./core/dom/events/custom_event_test.cc
   ./core/executing_context_test.cc
+  ./core/dart_isolate_context_test.cc
+  ./core/gc_scheduler_test.cc
+  ./core/page_memory_test.cc
+  ./core/sampling_profiler_test.cc
+  ./core/heap_snapshot_test.cc
   ./core/frame/console_test.cc
   ./core/frame/module_manager_test.cc
   ./core/dom/events/event_target_test.cc
@@ -35,6 +45,7 @@ list(APPEND WEBF_UNIT_TEST_SOURCEURCE
   ./core/html/html_element_test.cc
   ./core/html/custom/widget_element_test.cc
   ./core/timing/performance_test.cc
+  ./core/storage/storage_area_test.cc
 )
 
 ### webf_unit_test executable
@@ -83,6 +94,20 @@ add_executable(webf_benchmark
   ./test/webf_test_env.cc
   ./test/webf_test_env.h
   ./test/benchmark/create_element.cc
+  ./test/benchmark/array_buffer_transfer.cc
+  ./test/benchmark/event_dispatch.cc
+  ./test/benchmark/local_storage.cc
+  ./test/benchmark/native_string.cc
+  ./test/benchmark/transcoding.cc
+  ./test/benchmark/bytecode_cache.cc
+  ./test/benchmark/shared_bytecode.cc
+  ./test/benchmark/page_pool.cc
+  ./test/benchmark/lazy_bindings.cc
+  ./test/benchmark/object_heap.cc
+  ./test/benchmark/inline_cache.cc
+  ./test/benchmark/gc.cc
+  ./test/benchmark/microtask.cc
+  ./test/benchmark/bytecode_bundle.cc
 )
 target_include_directories(webf_benchmark PUBLIC
   ./third_party/googletest/googletest/include
@@ -374,7 +374,7 @@ WebFTestContext::~WebFTestContext() {
 bool WebFTestContext::parseTestHTML(const uint16_t* code, size_t codeLength) {
   if (!context_->IsContextValid())
     return false;
-  std::string utf8Code = toUTF8(std::u16string(reinterpret_cast<const char16_t*>(code), codeLength));
+  std::string utf8Code = UTF16ToUTF8String(code, codeLength);
   return page_->parseHTML(utf8Code.c_str(), utf8Code.length());
 }
 
@@ -179,7 +179,9 @@ void TEST_flushUICommand(double contextId) {
 
 void TEST_CreateBindingObject(double context_id, void* native_binding_object, int32_t type, void* args, int32_t argc) {}
 
-void TEST_GetWidgetElementShape() {}
+int8_t TEST_GetWidgetElementShape(double context_id, void* native_binding_object, NativeValue* value) {
+  return 0;
+}
 
 void TEST_onJsLog(double contextId, int32_t level, const char*) {}
 
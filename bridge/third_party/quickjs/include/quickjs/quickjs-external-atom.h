@@ -0,0 +1,684 @@
+// External static string atoms defined by users.
+// Generated by the code generator from the make_names json5 files with the static_atoms option, do not edit.
+// Checked in for the QuickJS build, regenerate it with "node bin/code_generator -s ../../core -d ../../out" in
+// bridge/scripts/code_generator whenever those names change.
+
+#ifdef DEF
+
+DEF(webf_click, "click")
+DEF(webf_scroll, "scroll")
+DEF(webf_scrollBy, "scrollBy")
+DEF(webf_clientTop, "clientTop")
+DEF(webf_clientLeft, "clientLeft")
+DEF(webf_clientWidth, "clientWidth")
+DEF(webf_clientHeight, "clientHeight")
+DEF(webf_scrollLeft, "scrollLeft")
+DEF(webf_scrollTop, "scrollTop")
+DEF(webf_offsetTop, "offsetTop")
+DEF(webf_offsetLeft, "offsetLeft")
+DEF(webf_offsetWidth, "offsetWidth")
+DEF(webf_offsetHeight, "offsetHeight")
+DEF(webf_scrollWidth, "scrollWidth")
+DEF(webf_scrollHeight, "scrollHeight")
+DEF(webf_getBoundingClientRect, "getBoundingClientRect")
+DEF(webf_getClientRects, "getClientRects")
+DEF(webf__g, "%g")
+DEF(webf__s, "%s")
+DEF(webf_open, "open")
+DEF(webf_devicePixelRatio, "devicePixelRatio")
+DEF(webf_colorScheme, "colorScheme")
+DEF(webf_scrollX, "scrollX")
+DEF(webf_scrollY, "scrollY")
+DEF(webf_innerWidth, "innerWidth")
+DEF(webf_innerHeight, "innerHeight")
+DEF(webf_availWidth, "availWidth")
+DEF(webf_availHeight, "availHeight")
+DEF(webf_width, "width")
+DEF(webf_height, "height")
+DEF(webf_top, "top")
+DEF(webf_bottom, "bottom")
+DEF(webf_left, "left")
+DEF(webf_right, "right")
+DEF(webf_x, "x")
+DEF(webf_y, "y")
+DEF(webf_z, "z")
+DEF(webf_screen, "screen")
+DEF(webf_accessKey, "accessKey")
+DEF(webf_download, "download")
+DEF(webf_ping, "ping")
+DEF(webf_rel, "rel")
+DEF(webf_type, "type")
+DEF(webf_text, "text")
+DEF(webf_href, "href")
+DEF(webf_origin, "origin")
+DEF(webf_protocol, "protocol")
+DEF(webf_username, "username")
+DEF(webf_password, "password")
+DEF(webf_host, "host")
+DEF(webf_hostname, "hostname")
+DEF(webf_port, "port")
+DEF(webf_pathname, "pathname")
+DEF(webf_search, "search")
+DEF(webf_hash, "hash")
+DEF(webf_alt, "alt")
+DEF(webf_src, "src")
+DEF(webf_srcset, "srcset")
+DEF(webf_sizes, "sizes")
+DEF(webf_naturalWidth, "naturalWidth")
+DEF(webf_naturalHeight, "naturalHeight")
+DEF(webf_complete, "complete")
+DEF(webf_currentSrc, "currentSrc")
+DEF(webf_decoding, "decoding")
+DEF(webf_fetchPriority, "fetchPriority")
+DEF(webf_loading, "loading")
+DEF(webf_noModule, "noModule")
+DEF(webf_getContext, "getContext")
+DEF(webf_fillStyle, "fillStyle")
+DEF(webf_direction, "direction")
+DEF(webf_font, "font")
+DEF(webf_strokeStyle, "strokeStyle")
+DEF(webf_lineCap, "lineCap")
+DEF(webf_lineDashOffset, "lineDashOffset")
+DEF(webf_lineJoin, "lineJoin")
+DEF(webf_lineWidth, "lineWidth")
+DEF(webf_miterLimit, "miterLimit")
+DEF(webf_textAlign, "textAlign")
+DEF(webf_textBaseline, "textBaseline")
+DEF(webf_arc, "arc")
+DEF(webf_arcTo, "arcTo")
+DEF(webf_beginPath, "beginPath")
+DEF(webf_bezierCurveTo, "bezierCurveTo")
+DEF(webf_clearRect, "clearRect")
+DEF(webf_closePath, "closePath")
+DEF(webf_clip, "clip")
+DEF(webf_drawImage, "drawImage")
+DEF(webf_ellipse, "ellipse")
+DEF(webf_fill, "fill")
+DEF(webf_fillRect, "fillRect")
+DEF(webf_fillText, "fillText")
+DEF(webf_lineTo, "lineTo")
+DEF(webf_moveTo, "moveTo")
+DEF(webf_rect, "rect")
+DEF(webf_restore, "restore")
+DEF(webf_resetTransform, "resetTransform")
+DEF(webf_rotate, "rotate")
+DEF(webf_quadraticCurveTo, "quadraticCurveTo")
+DEF(webf_stroke, "stroke")
+DEF(webf_strokeRect, "strokeRect")
+DEF(webf_save, "save")
+DEF(webf_scale, "scale")
+DEF(webf_strokeText, "strokeText")
+DEF(webf_setTransform, "setTransform")
+DEF(webf_transform, "transform")
+DEF(webf_translate, "translate")
+DEF(webf_reset, "reset")
+DEF(webf_focus, "focus")
+DEF(webf_blur, "blur")
+DEF(webf_defaultValue, "defaultValue")
+DEF(webf_accept, "accept")
+DEF(webf_autocomplete, "autocomplete")
+DEF(webf_autofocus, "autofocus")
+DEF(webf_checked, "checked")
+DEF(webf_disabled, "disabled")
+DEF(webf_min, "min")
+DEF(webf_max, "max")
+DEF(webf_minLength, "minLength")
+DEF(webf_maxLength, "maxLength")
+DEF(webf_size, "size")
+DEF(webf_multiple, "multiple")
+DEF(webf_step, "step")
+DEF(webf_pattern, "pattern")
+DEF(webf_required, "required")
+DEF(webf_readonly, "readonly")
+DEF(webf_placeholder, "placeholder")
+DEF(webf_inputMode, "inputMode")
+DEF(webf_cols, "cols")
+DEF(webf_rows, "rows")
+DEF(webf_wrap, "wrap")
+DEF(webf_dispatchEvent, "dispatchEvent")
+DEF(webf_getModifierState, "getModifierState")
+DEF(webf_querySelector, "querySelector")
+DEF(webf_querySelectorAll, "querySelectorAll")
+DEF(webf_getElementById, "getElementById")
+DEF(webf_getElementsByClassName, "getElementsByClassName")
+DEF(webf_getElementsByName, "getElementsByName")
+DEF(webf_getElementsByTagName, "getElementsByTagName")
+DEF(webf_id, "id")
+DEF(webf_className, "className")
+DEF(webf_cookie, "cookie")
+DEF(webf_syncPropertiesAndMethods, "syncPropertiesAndMethods")
+DEF(webf____clear_cookies__, "___clear_cookies__")
+DEF(webf_getComputedStyle, "getComputedStyle")
+DEF(webf_getPropertyValue, "getPropertyValue")
+DEF(webf_setProperty, "setProperty")
+DEF(webf_checkCSSProperty, "checkCSSProperty")
+DEF(webf_getFullCSSPropertyList, "getFullCSSPropertyList")
+DEF(webf_removeProperty, "removeProperty")
+DEF(webf_cssText, "cssText")
+DEF(webf_addColorStop, "addColorStop")
+DEF(webf_createLinearGradient, "createLinearGradient")
+DEF(webf_createRadialGradient, "createRadialGradient")
+DEF(webf_createPattern, "createPattern")
+DEF(webf_domain, "domain")
+DEF(webf_compatMode, "compatMode")
+DEF(webf_readyState, "readyState")
+DEF(webf_visibilityState, "visibilityState")
+DEF(webf_hidden, "hidden")
+DEF(webf_matches, "matches")
+DEF(webf_closest, "closest")
+DEF(webf_elementFromPoint, "elementFromPoint")
+DEF(webf_dir, "dir")
+DEF(webf_pageXOffset, "pageXOffset")
+DEF(webf_pageYOffset, "pageYOffset")
+DEF(webf_title, "title")
+DEF(webf_DOMActivate, "DOMActivate")
+DEF(webf_DOMCharacterDataModified, "DOMCharacterDataModified")
+DEF(webf_DOMContentLoaded, "DOMContentLoaded")
+DEF(webf_DOMFocusIn, "DOMFocusIn")
+DEF(webf_DOMFocusOut, "DOMFocusOut")
+DEF(webf_DOMNodeInserted, "DOMNodeInserted")
+DEF(webf_DOMNodeInsertedIntoDocument, "DOMNodeInsertedIntoDocument")
+DEF(webf_DOMNodeRemoved, "DOMNodeRemoved")
+DEF(webf_DOMNodeRemovedFromDocument, "DOMNodeRemovedFromDocument")
+DEF(webf_DOMSubtreeModified, "DOMSubtreeModified")
+DEF(webf_abort, "abort")
+DEF(webf_abortpayment, "abortpayment")
+DEF(webf_activate, "activate")
+DEF(webf_active, "active")
+DEF(webf_addsourcebuffer, "addsourcebuffer")
+DEF(webf_addtrack, "addtrack")
+DEF(webf_animationcancel, "animationcancel")
+DEF(webf_animationend, "animationend")
+DEF(webf_animationiteration, "animationiteration")
+DEF(webf_animationstart, "animationstart")
+DEF(webf_backgroundfetchabort, "backgroundfetchabort")
+DEF(webf_backgroundfetchclick, "backgroundfetchclick")
+DEF(webf_backgroundfetchfail, "backgroundfetchfail")
+DEF(webf_backgroundfetchsuccess, "backgroundfetchsuccess")
+DEF(webf_beforeunload, "beforeunload")
+DEF(webf_beginEvent, "beginEvent")
+DEF(webf_blocked, "blocked")
+DEF(webf_boundary, "boundary")
+DEF(webf_cached, "cached")
+DEF(webf_cancel, "cancel")
+DEF(webf_canplay, "canplay")
+DEF(webf_canplaythrough, "canplaythrough")
+DEF(webf_capturehandlechange, "capturehandlechange")
+DEF(webf_change, "change")
+DEF(webf_checking, "checking")
+DEF(webf_dbclick, "dbclick")
+DEF(webf_longpress, "longpress")
+DEF(webf_close, "close")
+DEF(webf_closing, "closing")
+DEF(webf_gotpointercapture, "gotpointercapture")
+DEF(webf_compositionend, "compositionend")
+DEF(webf_compositionstart, "compositionstart")
+DEF(webf_compositionupdate, "compositionupdate")
+DEF(webf_connect, "connect")
+DEF(webf_contextlost, "contextlost")
+DEF(webf_contextmenu, "contextmenu")
+DEF(webf_contextrestored, "contextrestored")
+DEF(webf_controllerchange, "controllerchange")
+DEF(webf_cookiechange, "cookiechange")
+DEF(webf_copy, "copy")
+DEF(webf_contentdelete, "contentdelete")
+DEF(webf_crossoriginmessage, "crossoriginmessage")
+DEF(webf_currentscreenchange, "currentscreenchange")
+DEF(webf_cuechange, "cuechange")
+DEF(webf_currententrychange, "currententrychange")
+DEF(webf_cut, "cut")
+DEF(webf_datachannel, "datachannel")
+DEF(webf_dblclick, "dblclick")
+DEF(webf_defaultsessionstart, "defaultsessionstart")
+DEF(webf_disconnect, "disconnect")
+DEF(webf_display, "display")
+DEF(webf_drop, "drop")
+DEF(webf_durationchange, "durationchange")
+DEF(webf_emptied, "emptied")
+DEF(webf_encrypted, "encrypted")
+DEF(webf_end, "end")
+DEF(webf_ended, "ended")
+DEF(webf_endEvent, "endEvent")
+DEF(webf_enter, "enter")
+DEF(webf_error, "error")
+DEF(webf_exit, "exit")
+DEF(webf_fetch, "fetch")
+DEF(webf_finish, "finish")
+DEF(webf_focusin, "focusin")
+DEF(webf_focusout, "focusout")
+DEF(webf_freeze, "freeze")
+DEF(webf_fullscreenchange, "fullscreenchange")
+DEF(webf_fullscreenerror, "fullscreenerror")
+DEF(webf_hashchange, "hashchange")
+DEF(webf_hide, "hide")
+DEF(webf_inactive, "inactive")
+DEF(webf_inputreport, "inputreport")
+DEF(webf_inputsourceschange, "inputsourceschange")
+DEF(webf_install, "install")
+DEF(webf_interfacerequest, "interfacerequest")
+DEF(webf_invalid, "invalid")
+DEF(webf_keydown, "keydown")
+DEF(webf_keypress, "keypress")
+DEF(webf_keystatuseschange, "keystatuseschange")
+DEF(webf_keyup, "keyup")
+DEF(webf_languagechange, "languagechange")
+DEF(webf_leavepictureinpicture, "leavepictureinpicture")
+DEF(webf_levelchange, "levelchange")
+DEF(webf_load, "load")
+DEF(webf_loadeddata, "loadeddata")
+DEF(webf_loadedmetadata, "loadedmetadata")
+DEF(webf_loadend, "loadend")
+DEF(webf_loadstart, "loadstart")
+DEF(webf_lostpointercapture, "lostpointercapture")
+DEF(webf_mark, "mark")
+DEF(webf_memorypressure, "memorypressure")
+DEF(webf_messageerror, "messageerror")
+DEF(webf_mousedown, "mousedown")
+DEF(webf_mouseenter, "mouseenter")
+DEF(webf_mouseleave, "mouseleave")
+DEF(webf_mousemove, "mousemove")
+DEF(webf_mouseout, "mouseout")
+DEF(webf_mouseover, "mouseover")
+DEF(webf_mouseup, "mouseup")
+DEF(webf_mousewheel, "mousewheel")
+DEF(webf_mute, "mute")
+DEF(webf_navigate, "navigate")
+DEF(webf_navigateerror, "navigateerror")
+DEF(webf_navigatesuccess, "navigatesuccess")
+DEF(webf_noupdate, "noupdate")
+DEF(webf_orientationchange, "orientationchange")
+DEF(webf_overscroll, "overscroll")
+DEF(webf_pagehide, "pagehide")
+DEF(webf_pageshow, "pageshow")
+DEF(webf_paste, "paste")
+DEF(webf_pause, "pause")
+DEF(webf_play, "play")
+DEF(webf_playing, "playing")
+DEF(webf_pointercancel, "pointercancel")
+DEF(webf_pointerdown, "pointerdown")
+DEF(webf_pointerenter, "pointerenter")
+DEF(webf_pointerleave, "pointerleave")
+DEF(webf_pointerlockchange, "pointerlockchange")
+DEF(webf_pointerlockerror, "pointerlockerror")
+DEF(webf_pointermove, "pointermove")
+DEF(webf_pointerout, "pointerout")
+DEF(webf_pointerover, "pointerover")
+DEF(webf_pointerup, "pointerup")
+DEF(webf_gesturestart, "gesturestart")
+DEF(webf_gesturechange, "gesturechange")
+DEF(webf_gestureend, "gestureend")
+DEF(webf_popstate, "popstate")
+DEF(webf_progress, "progress")
+DEF(webf_processorerror, "processorerror")
+DEF(webf_push, "push")
+DEF(webf_pushsubscriptionchange, "pushsubscriptionchange")
+DEF(webf_ratechange, "ratechange")
+DEF(webf_reading, "reading")
+DEF(webf_readingerror, "readingerror")
+DEF(webf_readystatechange, "readystatechange")
+DEF(webf_reflectionchange, "reflectionchange")
+DEF(webf_rejectionhandled, "rejectionhandled")
+DEF(webf_release, "release")
+DEF(webf_remove, "remove")
+DEF(webf_removestream, "removestream")
+DEF(webf_removetrack, "removetrack")
+DEF(webf_repeatEvent, "repeatEvent")
+DEF(webf_resize, "resize")
+DEF(webf_result, "result")
+DEF(webf_resume, "resume")
+DEF(webf_screenschange, "screenschange")
+DEF(webf_scrollend, "scrollend")
+DEF(webf_seeked, "seeked")
+DEF(webf_seeking, "seeking")
+DEF(webf_select, "select")
+DEF(webf_selectionchange, "selectionchange")
+DEF(webf_selectstart, "selectstart")
+DEF(webf_show, "show")
+DEF(webf_squeeze, "squeeze")
+DEF(webf_squeezeend, "squeezeend")
+DEF(webf_squeezestart, "squeezestart")
+DEF(webf_stalled, "stalled")
+DEF(webf_start, "start")
+DEF(webf_stop, "stop")
+DEF(webf_statechange, "statechange")
+DEF(webf_storage, "storage")
+DEF(webf_submit, "submit")
+DEF(webf_success, "success")
+DEF(webf_suspend, "suspend")
+DEF(webf_sync, "sync")
+DEF(webf_terminate, "terminate")
+DEF(webf_textInput, "textInput")
+DEF(webf_textupdate, "textupdate")
+DEF(webf_textformatupdate, "textformatupdate")
+DEF(webf_toggle, "toggle")
+DEF(webf_tonechange, "tonechange")
+DEF(webf_touchcancel, "touchcancel")
+DEF(webf_touchend, "touchend")
+DEF(webf_touchmove, "touchmove")
+DEF(webf_touchstart, "touchstart")
+DEF(webf_transitioncancel, "transitioncancel")
+DEF(webf_transitionend, "transitionend")
+DEF(webf_transitionrun, "transitionrun")
+DEF(webf_transitionstart, "transitionstart")
+DEF(webf_typechange, "typechange")
+DEF(webf_uncapturederror, "uncapturederror")
+DEF(webf_unhandledrejection, "unhandledrejection")
+DEF(webf_unload, "unload")
+DEF(webf_unmute, "unmute")
+DEF(webf_update, "update")
+DEF(webf_versionchange, "versionchange")
+DEF(webf_visibilitychange, "visibilitychange")
+DEF(webf_waiting, "waiting")
+DEF(webf_waitingforkey, "waitingforkey")
+DEF(webf_webglcontextcreationerror, "webglcontextcreationerror")
+DEF(webf_webglcontextlost, "webglcontextlost")
+DEF(webf_webglcontextrestored, "webglcontextrestored")
+DEF(webf_wheel, "wheel")
+DEF(webf_zoom, "zoom")
+DEF(webf_intersectionchange, "intersectionchange")
+DEF(webf_gcopen, "gcopen")
+DEF(webf_hybridrouterchange, "hybridrouterchange")
+DEF(webf_canvas, "canvas")
+DEF(webf_a, "a")
+DEF(webf_html, "html")
+DEF(webf_body, "body")
+DEF(webf_head, "head")
+DEF(webf_div, "div")
+DEF(webf_link, "link")
+DEF(webf_textarea, "textarea")
+DEF(webf_form, "form")
+DEF(webf_template, "template")
+DEF(webf_img, "img")
+DEF(webf_script, "script")
+DEF(webf_iframe, "iframe")
+DEF(webf_abbr, "abbr")
+DEF(webf_accept_charset, "accept-charset")
+DEF(webf_accesskey, "accesskey")
+DEF(webf_action, "action")
+DEF(webf_align, "align")
+DEF(webf_alink, "alink")
+DEF(webf_allow, "allow")
+DEF(webf_allowfullscreen, "allowfullscreen")
+DEF(webf_allowpaymentrequest, "allowpaymentrequest")
+DEF(webf_anchor, "anchor")
+DEF(webf_anonymous, "anonymous")
+DEF(webf_archive, "archive")
+DEF(webf_attributionsrc, "attributionsrc")
+DEF(webf_autocapitalize, "autocapitalize")
+DEF(webf_autocorrect, "autocorrect")
+DEF(webf_autoplay, "autoplay")
+DEF(webf_autopictureinpicture, "autopictureinpicture")
+DEF(webf_axis, "axis")
+DEF(webf_background, "background")
+DEF(webf_behavior, "behavior")
+DEF(webf_bgcolor, "bgcolor")
+DEF(webf_blocking, "blocking")
+DEF(webf_border, "border")
+DEF(webf_bordercolor, "bordercolor")
+DEF(webf_capture, "capture")
+DEF(webf_cellpadding, "cellpadding")
+DEF(webf_cellspacing, "cellspacing")
+DEF(webf_char, "char")
+DEF(webf_challenge, "challenge")
+DEF(webf_charoff, "charoff")
+DEF(webf_charset, "charset")
+DEF(webf_cite, "cite")
+DEF(webf_classid, "classid")
+DEF(webf_clear, "clear")
+DEF(webf_code, "code")
+DEF(webf_codebase, "codebase")
+DEF(webf_codetype, "codetype")
+DEF(webf_color, "color")
+DEF(webf_colspan, "colspan")
+DEF(webf_compact, "compact")
+DEF(webf_content, "content")
+DEF(webf_contenteditable, "contenteditable")
+DEF(webf_controls, "controls")
+DEF(webf_controlslist, "controlslist")
+DEF(webf_coords, "coords")
+DEF(webf_crossorigin, "crossorigin")
+DEF(webf_csp, "csp")
+DEF(webf_data, "data")
+DEF(webf_datetime, "datetime")
+DEF(webf_declare, "declare")
+DEF(webf_defer, "defer")
+DEF(webf_delegatesfocus, "delegatesfocus")
+DEF(webf_dirname, "dirname")
+DEF(webf_disablepictureinpicture, "disablepictureinpicture")
+DEF(webf_disableremoteplayback, "disableremoteplayback")
+DEF(webf_draggable, "draggable")
+DEF(webf_elementtiming, "elementtiming")
+DEF(webf_enctype, "enctype")
+DEF(webf_enterkeyhint, "enterkeyhint")
+DEF(webf_event, "event")
+DEF(webf_exportparts, "exportparts")
+DEF(webf_face, "face")
+DEF(webf_fetchpriority, "fetchpriority")
+DEF(webf_focusgroup, "focusgroup")
+DEF(webf_formaction, "formaction")
+DEF(webf_formenctype, "formenctype")
+DEF(webf_formmethod, "formmethod")
+DEF(webf_formnovalidate, "formnovalidate")
+DEF(webf_formtarget, "formtarget")
+DEF(webf_frame, "frame")
+DEF(webf_frameborder, "frameborder")
+DEF(webf_headers, "headers")
+DEF(webf_high, "high")
+DEF(webf_hreflang, "hreflang")
+DEF(webf_hreftranslate, "hreftranslate")
+DEF(webf_hspace, "hspace")
+DEF(webf_http_equiv, "http-equiv")
+DEF(webf_imagesizes, "imagesizes")
+DEF(webf_imagesrcset, "imagesrcset")
+DEF(webf_incremental, "incremental")
+DEF(webf_inert, "inert")
+DEF(webf_defaultopen, "defaultopen")
+DEF(webf_inputmode, "inputmode")
+DEF(webf_integrity, "integrity")
+DEF(webf_is, "is")
+DEF(webf_ismap, "ismap")
+DEF(webf_itemprop, "itemprop")
+DEF(webf_keytype, "keytype")
+DEF(webf_kind, "kind")
+DEF(webf_invisible, "invisible")
+DEF(webf_label, "label")
+DEF(webf_lang, "lang")
+DEF(webf_language, "language")
+DEF(webf_latencyhint, "latencyhint")
+DEF(webf_leftmargin, "leftmargin")
+DEF(webf_list, "list")
+DEF(webf_longdesc, "longdesc")
+DEF(webf_loop, "loop")
+DEF(webf_low, "low")
+DEF(webf_lowsrc, "lowsrc")
+DEF(webf_manifest, "manifest")
+DEF(webf_marginheight, "marginheight")
+DEF(webf_marginwidth, "marginwidth")
+DEF(webf_maxlength, "maxlength")
+DEF(webf_mayscript, "mayscript")
+DEF(webf_media, "media")
+DEF(webf_method, "method")
+DEF(webf_minlength, "minlength")
+DEF(webf_mode, "mode")
+DEF(webf_muted, "muted")
+DEF(webf_nohref, "nohref")
+DEF(webf_nomodule, "nomodule")
+DEF(webf_nonce, "nonce")
+DEF(webf_noresize, "noresize")
+DEF(webf_noshade, "noshade")
+DEF(webf_novalidate, "novalidate")
+DEF(webf_nowrap, "nowrap")
+DEF(webf_onabort, "onabort")
+DEF(webf_onafterprint, "onafterprint")
+DEF(webf_onanimationstart, "onanimationstart")
+DEF(webf_onanimationiteration, "onanimationiteration")
+DEF(webf_onanimationend, "onanimationend")
+DEF(webf_onauxclick, "onauxclick")
+DEF(webf_onbeforecopy, "onbeforecopy")
+DEF(webf_onbeforecut, "onbeforecut")
+DEF(webf_onbeforeinput, "onbeforeinput")
+DEF(webf_onbeforepaste, "onbeforepaste")
+DEF(webf_onbeforeprint, "onbeforeprint")
+DEF(webf_onbeforeunload, "onbeforeunload")
+DEF(webf_onblur, "onblur")
+DEF(webf_oncancel, "oncancel")
+DEF(webf_oncanplay, "oncanplay")
+DEF(webf_oncanplaythrough, "oncanplaythrough")
+DEF(webf_onchange, "onchange")
+DEF(webf_onclick, "onclick")
+DEF(webf_onclose, "onclose")
+DEF(webf_oncontentvisibilityautostatechanged, "oncontentvisibilityautostatechanged")
+DEF(webf_oncontextlost, "oncontextlost")
+DEF(webf_oncontextmenu, "oncontextmenu")
+DEF(webf_oncontextrestored, "oncontextrestored")
+DEF(webf_oncopy, "oncopy")
+DEF(webf_oncuechange, "oncuechange")
+DEF(webf_oncut, "oncut")
+DEF(webf_ondblclick, "ondblclick")
+DEF(webf_ondrag, "ondrag")
+DEF(webf_ondragend, "ondragend")
+DEF(webf_ondragenter, "ondragenter")
+DEF(webf_ondragleave, "ondragleave")
+DEF(webf_ondragover, "ondragover")
+DEF(webf_ondragstart, "ondragstart")
+DEF(webf_ondrop, "ondrop")
+DEF(webf_ondurationchange, "ondurationchange")
+DEF(webf_onemptied, "onemptied")
+DEF(webf_onended, "onended")
+DEF(webf_onerror, "onerror")
+DEF(webf_onfocus, "onfocus")
+DEF(webf_onfocusin, "onfocusin")
+DEF(webf_onfocusout, "onfocusout")
+DEF(webf_onformdata, "onformdata")
+DEF(webf_ongotpointercapture, "ongotpointercapture")
+DEF(webf_onhashchange, "onhashchange")
+DEF(webf_oninput, "oninput")
+DEF(webf_oninvalid, "oninvalid")
+DEF(webf_onkeydown, "onkeydown")
+DEF(webf_onkeypress, "onkeypress")
+DEF(webf_onkeyup, "onkeyup")
+DEF(webf_onlanguagechange, "onlanguagechange")
+DEF(webf_onload, "onload")
+DEF(webf_onloadeddata, "onloadeddata")
+DEF(webf_onloadedmetadata, "onloadedmetadata")
+DEF(webf_onloadstart, "onloadstart")
+DEF(webf_onlostpointercapture, "onlostpointercapture")
+DEF(webf_onmessage, "onmessage")
+DEF(webf_onmessageerror, "onmessageerror")
+DEF(webf_onmousedown, "onmousedown")
+DEF(webf_onmouseenter, "onmouseenter")
+DEF(webf_onmouseleave, "onmouseleave")
+DEF(webf_onmousemove, "onmousemove")
+DEF(webf_onmouseout, "onmouseout")
+DEF(webf_onmouseover, "onmouseover")
+DEF(webf_onmouseup, "onmouseup")
+DEF(webf_onmousewheel, "onmousewheel")
+DEF(webf_ononline, "ononline")
+DEF(webf_onoffline, "onoffline")
+DEF(webf_onorientationchange, "onorientationchange")
+DEF(webf_onoverscroll, "onoverscroll")
+DEF(webf_onpagehide, "onpagehide")
+DEF(webf_onpageshow, "onpageshow")
+DEF(webf_onpaste, "onpaste")
+DEF(webf_onpause, "onpause")
+DEF(webf_onplay, "onplay")
+DEF(webf_onplaying, "onplaying")
+DEF(webf_onpointercancel, "onpointercancel")
+DEF(webf_onpointerdown, "onpointerdown")
+DEF(webf_onpointerenter, "onpointerenter")
+DEF(webf_onpointerleave, "onpointerleave")
+DEF(webf_onpointermove, "onpointermove")
+DEF(webf_onpointerout, "onpointerout")
+DEF(webf_onpointerover, "onpointerover")
+DEF(webf_onpointerrawupdate, "onpointerrawupdate")
+DEF(webf_onpointerup, "onpointerup")
+DEF(webf_onpopstate, "onpopstate")
+DEF(webf_onportalactivate, "onportalactivate")
+DEF(webf_onprogress, "onprogress")
+DEF(webf_onratechange, "onratechange")
+DEF(webf_onreset, "onreset")
+DEF(webf_onresize, "onresize")
+DEF(webf_onscroll, "onscroll")
+DEF(webf_onscrollend, "onscrollend")
+DEF(webf_onsearch, "onsearch")
+DEF(webf_onsecuritypolicyviolation, "onsecuritypolicyviolation")
+DEF(webf_onseeked, "onseeked")
+DEF(webf_onseeking, "onseeking")
+DEF(webf_onselect, "onselect")
+DEF(webf_onselectstart, "onselectstart")
+DEF(webf_onselectionchange, "onselectionchange")
+DEF(webf_onshow, "onshow")
+DEF(webf_onslotchange, "onslotchange")
+DEF(webf_onstalled, "onstalled")
+DEF(webf_onstorage, "onstorage")
+DEF(webf_onsuspend, "onsuspend")
+DEF(webf_onsubmit, "onsubmit")
+DEF(webf_ontimeupdate, "ontimeupdate")
+DEF(webf_ontimezonechange, "ontimezonechange")
+DEF(webf_ontoggle, "ontoggle")
+DEF(webf_ontouchstart, "ontouchstart")
+DEF(webf_ontouchmove, "ontouchmove")
+DEF(webf_ontouchend, "ontouchend")
+DEF(webf_ontouchcancel, "ontouchcancel")
+DEF(webf_ontransitionend, "ontransitionend")
+DEF(webf_onunload, "onunload")
+DEF(webf_onvolumechange, "onvolumechange")
+DEF(webf_onwaiting, "onwaiting")
+DEF(webf_onwebkitanimationstart, "onwebkitanimationstart")
+DEF(webf_onwebkitanimationiteration, "onwebkitanimationiteration")
+DEF(webf_onwebkitanimationend, "onwebkitanimationend")
+DEF(webf_onwebkitfullscreenchange, "onwebkitfullscreenchange")
+DEF(webf_onwebkitfullscreenerror, "onwebkitfullscreenerror")
+DEF(webf_onwebkittransitionend, "onwebkittransitionend")
+DEF(webf_onwheel, "onwheel")
+DEF(webf_optimum, "optimum")
+DEF(webf_part, "part")
+DEF(webf_playsinline, "playsinline")
+DEF(webf_policy, "policy")
+DEF(webf_popup, "popup")
+DEF(webf_popuphidetarget, "popuphidetarget")
+DEF(webf_popuphovertarget, "popuphovertarget")
+DEF(webf_popupshowtarget, "popupshowtarget")
+DEF(webf_popuptoggletarget, "popuptoggletarget")
+DEF(webf_poster, "poster")
+DEF(webf_preload, "preload")
+DEF(webf_property, "property")
+DEF(webf_pseudo, "pseudo")
+DEF(webf_referrerpolicy, "referrerpolicy")
+DEF(webf_rev, "rev")
+DEF(webf_reversed, "reversed")
+DEF(webf_role, "role")
+DEF(webf_rowspan, "rowspan")
+DEF(webf_rules, "rules")
+DEF(webf_sandbox, "sandbox")
+DEF(webf_scheme, "scheme")
+DEF(webf_scope, "scope")
+DEF(webf_scrollamount, "scrollamount")
+DEF(webf_scrolldelay, "scrolldelay")
+DEF(webf_scrolling, "scrolling")
+DEF(webf_selected, "selected")
+DEF(webf_shadowroot, "shadowroot")
+DEF(webf_shadowrootdelegatesfocus, "shadowrootdelegatesfocus")
+DEF(webf_shape, "shape")
+DEF(webf_slot, "slot")
+DEF(webf_span, "span")
+DEF(webf_spellcheck, "spellcheck")
+DEF(webf_srcdoc, "srcdoc")
+DEF(webf_srclang, "srclang")
+DEF(webf_standby, "standby")
+DEF(webf_style, "style")
+DEF(webf_summary, "summary")
+DEF(webf_tabindex, "tabindex")
+DEF(webf_topmargin, "topmargin")
+DEF(webf_truespeed, "truespeed")
+DEF(webf_trusttoken, "trusttoken")
+DEF(webf_usemap, "usemap")
+DEF(webf_valign, "valign")
+DEF(webf_valuetype, "valuetype")
+DEF(webf_version, "version")
+DEF(webf_vlink, "vlink")
+DEF(webf_vspace, "vspace")
+DEF(webf_virtualkeyboardpolicy, "virtualkeyboardpolicy")
+DEF(webf_webkitdirectory, "webkitdirectory")
+
+#endif /* DEF */
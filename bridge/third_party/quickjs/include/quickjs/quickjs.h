@@ -354,8 +354,14 @@ JSRuntime *JS_NewRuntime(void);
 void JS_SetRuntimeInfo(JSRuntime *rt, const char *info);
 void JS_SetMemoryLimit(JSRuntime *rt, size_t limit);
 void JS_SetGCThreshold(JSRuntime *rt, size_t gc_threshold);
+size_t JS_GetGCThreshold(JSRuntime *rt);
+size_t JS_GetMallocSize(JSRuntime *rt);
 void JS_TurnOffGC(JSRuntime *rt);
 void JS_TurnOnGC(JSRuntime *rt);
+/* called with done = FALSE before and done = TRUE after every cycle
+   collection which is not skipped by JS_TurnOffGC() */
+typedef void JSGCObserver(JSRuntime *rt, JS_BOOL done, void *opaque);
+void JS_SetGCObserver(JSRuntime *rt, JSGCObserver *observer, void *opaque);
 /* use 0 to disable maximum stack size check */
 void JS_SetMaxStackSize(JSRuntime *rt, size_t stack_size);
 /* should be called when changing thread to update the stack top value
@@ -368,6 +374,13 @@ void JS_SetRuntimeOpaque(JSRuntime *rt, void *opaque);
 typedef void JS_MarkFunc(JSRuntime *rt, JSGCObjectHeader *gp);
 void JS_MarkValue(JSRuntime *rt, JSValueConst val, JS_MarkFunc *mark_func);
 void JS_RunGC(JSRuntime *rt);
+/* Only scans the objects allocated since the last full collection
+   which survived less than two minor collections. The collections
+   triggered by the allocations are minor ones until the old objects
+   double. */
+void JS_RunMinorGC(JSRuntime *rt);
+/* TRUE while the collection seen by the GC observer is a minor one */
+JS_BOOL JS_IsMinorGC(JSRuntime *rt);
 JS_BOOL JS_IsLiveObject(JSRuntime *rt, JSValueConst obj);
 
 JSContext *JS_NewContext(JSRuntime *rt);
@@ -436,7 +449,25 @@ typedef struct JSMemoryUsage {
 } JSMemoryUsage;
 
 void JS_ComputeMemoryUsage(JSRuntime *rt, JSMemoryUsage *s);
+/* Estimates the memory held by the objects and functions of each of |ctxs| into |sizes|.
+   An object belongs to the context whose Object.prototype ends its prototype chain,
+   objects without prototype are not counted. */
+void JS_ComputeContextMemoryUsage(JSRuntime *rt, JSContext *const *ctxs, int64_t *sizes, int count);
 void JS_DumpMemoryUsage(FILE *fp, const JSMemoryUsage *s, JSRuntime *rt);
+/* Returns the size of the native object held by 'obj', 0 if there is none.
+   Only called for the objects of the classes created by JS_NewClass(). */
+typedef size_t JSNativeObjectSize(JSRuntime *rt, JSValueConst obj);
+/* Writes the GC objects of 'rt' and the strings they hold as a Chrome
+   DevTools heap snapshot (.heapsnapshot JSON). The objects for which
+   'native_size' returns a size get a native node, which holds the
+   references marked by their class gc_mark. The GC should run first so
+   that only the reachable objects are written. A GC object keeps its id
+   in the following snapshots of 'rt' until it is freed, the strings use
+   their address. Returns NULL on memory error, the result is freed with
+   js_free_rt(). */
+char *JS_WriteHeapSnapshot(JSRuntime *rt, JSNativeObjectSize *native_size, size_t *psize);
+/* per site hits and misses of the inline caches, counted when built with CONFIG_IC_STATS */
+void JS_DumpInlineCacheStats(JSRuntime *rt, FILE *fp);
 
 /* atom support */
 #define JS_ATOM_NULL 0
@@ -448,6 +479,13 @@ enum {
   __JS_ATOM_NULL = JS_ATOM_NULL,
 #define DEF(name, str) JS_ATOM_ ## name,
 #include "quickjs/quickjs-atom.h"
+#undef DEF
+  /* the atoms known by the bytecode format, the external atoms after them
+     are written by name so the bytecode does not depend on them */
+  JS_ATOM_END_BUILTIN,
+  __JS_ATOM_EXTERNAL_START = JS_ATOM_END_BUILTIN - 1,
+#define DEF(name, str) JS_ATOM_ ## name,
+#include "quickjs/quickjs-external-atom.h"
 #undef DEF
   JS_ATOM_END,
 };
@@ -457,6 +495,7 @@ enum {
 static const char js_atom_init[] =
 #define DEF(name, str) str "\0"
 #include "quickjs/quickjs-atom.h"
+#include "quickjs/quickjs-external-atom.h"
 #undef DEF
    ;
 
@@ -506,6 +545,10 @@ typedef struct JSClassExoticMethods {
   JSValue (*get_property)(JSContext* ctx, JSValueConst obj, JSAtom atom, JSValueConst receiver);
   /* return < 0 if exception or TRUE/FALSE */
   int (*set_property)(JSContext* ctx, JSValueConst obj, JSAtom atom, JSValueConst value, JSValueConst receiver, int flags);
+  /* TRUE if get_own_property only reports the own properties of the
+     prototype: the property accesses look them up on the prototype
+     directly, which lets the inline caches keep them */
+  JS_BOOL own_properties_from_prototype;
 } JSClassExoticMethods;
 
 typedef void JSClassFinalizer(JSRuntime* rt, JSValue val);
@@ -793,6 +836,11 @@ int JS_DefinePropertyValue(JSContext* ctx, JSValueConst this_obj, JSAtom prop, J
 int JS_DefinePropertyValueUint32(JSContext* ctx, JSValueConst this_obj, uint32_t idx, JSValue val, int flags);
 int JS_DefinePropertyValueStr(JSContext* ctx, JSValueConst this_obj, const char* prop, JSValue val, int flags);
 int JS_DefinePropertyGetSet(JSContext* ctx, JSValueConst this_obj, JSAtom prop, JSValue getter, JSValue setter, int flags);
+/* Computes the value of a lazy property the first time it is accessed, returns JS_EXCEPTION on failure. */
+typedef JSValue JSLazyPropertyInit(JSContext* ctx, JSValueConst this_obj, JSAtom prop, void* opaque);
+/* Defines 'prop' as a data property whose value is built by 'init' on first access. 'opaque' must outlive the
+   property. An existing own property is replaced. */
+int JS_DefineLazyProperty(JSContext* ctx, JSValueConst this_obj, JSAtom prop, JSLazyPropertyInit* init, void* opaque, int flags);
 void JS_SetOpaque(JSValue obj, void* opaque);
 void *JS_GetOpaque(JSValueConst obj, JSClassID class_id);
 void *JS_GetOpaque2(JSContext *ctx, JSValueConst obj, JSClassID class_id);
@@ -826,6 +874,20 @@ void JS_SetHostPromiseRejectionTracker(JSRuntime *rt, JSHostPromiseRejectionTrac
 /* return != 0 if the JS code needs to be interrupted */
 typedef int JSInterruptHandler(JSRuntime *rt, void *opaque);
 void JS_SetInterruptHandler(JSRuntime *rt, JSInterruptHandler *cb, void *opaque);
+
+typedef struct JSStackFrameInfo {
+  JSAtom function_name; /* JS_ATOM_NULL if unknown */
+  JSAtom filename; /* JS_ATOM_NULL for the native functions */
+  int line_num; /* -1 if unknown */
+} JSStackFrameInfo;
+/* Fill 'frames' with the running functions, the innermost first, and
+   return their count. Nothing is allocated and the atoms are not
+   duplicated, it is meant to be called from the interrupt handler. */
+int JS_GetStackFrames(JSRuntime *rt, JSStackFrameInfo *frames, int max_frames);
+/* Stops the code of |ctx|: the running code and every later call into it throw an
+   uncatchable "interrupted" error. */
+void JS_TerminateExecution(JSContext *ctx);
+JS_BOOL JS_IsExecutionTerminated(JSContext *ctx);
 /* if can_block is TRUE, Atomics.wait() can be used */
 void JS_SetCanBlock(JSRuntime *rt, JS_BOOL can_block);
 /* set the [IsHTMLDDA] internal slot */
@@ -852,6 +914,9 @@ int JS_EnqueueJob(JSContext *ctx, JSJobFunc *job_func, int argc, JSValueConst *a
 
 JS_BOOL JS_IsJobPending(JSRuntime *rt);
 int JS_ExecutePendingJob(JSRuntime *rt, JSContext **pctx);
+/* Number of jobs enqueued and executed since the creation of the runtime. */
+uint64_t JS_GetEnqueuedJobCount(JSRuntime *rt);
+uint64_t JS_GetExecutedJobCount(JSRuntime *rt);
 
 /* Object Writer/Reader (currently only used to handle precompiled code) */
 #define JS_WRITE_OBJ_BYTECODE  (1 << 0) /* allow function/module */
@@ -860,6 +925,8 @@ int JS_ExecutePendingJob(JSRuntime *rt, JSContext **pctx);
 #define JS_WRITE_OBJ_REFERENCE (1 << 3) /* allow object references to \
              encode arbitrary object     \
              graph */
+/* version of the bytecode format written by JS_WriteObject() */
+int JS_GetBytecodeVersion(void);
 uint8_t* JS_WriteObject(JSContext* ctx, size_t* psize, JSValueConst obj, int flags);
 uint8_t* JS_WriteObject2(JSContext* ctx, size_t* psize, JSValueConst obj, int flags, uint8_t*** psab_tab, size_t* psab_tab_len);
 
@@ -867,7 +934,31 @@ uint8_t* JS_WriteObject2(JSContext* ctx, size_t* psize, JSValueConst obj, int fl
 #define JS_READ_OBJ_ROM_DATA  (1 << 1) /* avoid duplicating 'buf' data */
 #define JS_READ_OBJ_SAB       (1 << 2) /* allow SharedArrayBuffer */
 #define JS_READ_OBJ_REFERENCE (1 << 3) /* allow object references */
+/* JS_ReadBundleObject() only: the function bodies are read on their
+   first call, 'buf' must outlive the functions */
+#define JS_READ_OBJ_LAZY      (1 << 4)
 JSValue JS_ReadObject(JSContext* ctx, const uint8_t* buf, size_t buf_len, int flags);
+/* copy a function bytecode object returned by JS_ReadObject() into the realm of 'ctx', the copy can be evaluated
+  while 'obj' is kept as a template. Returns JS_UNDEFINED if 'obj' holds objects of its realm. */
+JSValue JS_CloneFunctionBytecode(JSContext* ctx, JSValueConst obj);
+
+/* Bundles of bytecode objects: the objects share a single table of atoms and
+   constant strings, written once after all the objects. */
+typedef struct JSBundleWriter JSBundleWriter;
+JSBundleWriter* JS_NewBundleWriter(JSContext* ctx);
+/* the returned buffer is freed with js_free() */
+uint8_t* JS_WriteBundleObject(JSBundleWriter* w, size_t* psize, JSValueConst obj);
+uint8_t* JS_WriteBundleTables(JSBundleWriter* w, size_t* psize);
+void JS_FreeBundleWriter(JSBundleWriter* w);
+
+/* 'tables' must stay alive and unmodified until the reader is freed. The
+   atoms are created when an object read with the reader first uses them, they
+   belong to the runtime of 'ctx'. A function read lazily throws when its body
+   is read after the reader is freed. */
+typedef struct JSBundleReader JSBundleReader;
+JSBundleReader* JS_NewBundleReader(JSContext* ctx, const uint8_t* tables, size_t tables_len);
+JSValue JS_ReadBundleObject(JSContext* ctx, JSBundleReader* r, const uint8_t* buf, size_t buf_len, int flags);
+void JS_FreeBundleReader(JSRuntime* rt, JSBundleReader* r);
 /* instantiate and evaluate a bytecode function. Only used when
   reading a script or module with JS_ReadObject() */
 JSValue JS_EvalFunction(JSContext* ctx, JSValue fun_obj);
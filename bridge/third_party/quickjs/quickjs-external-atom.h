@@ -1,7 +0,0 @@
-// External static string atoms defined by users.
-
-#ifdef DEF
-
-
-
-#endif /* DEF */
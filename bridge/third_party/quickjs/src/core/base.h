@@ -128,6 +128,9 @@ int clock_gettime(int X, struct timeval *tv);
 //#define DUMP_PROMISE
 //#define DUMP_READ_OBJECT
 
+/* count the hits and misses of each inline cache site, see JS_DumpInlineCacheStats() */
+//#define CONFIG_IC_STATS
+
 /* test the GC by forcing it before each object allocation */
 //#define FORCE_GC_AT_MALLOC
 
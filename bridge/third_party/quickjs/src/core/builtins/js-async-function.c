@@ -24,6 +24,7 @@
  */
 
 #include "js-async-function.h"
+#include "../bytecode.h"
 #include "../exception.h"
 #include "../function.h"
 #include "../gc.h"
@@ -46,6 +47,8 @@ __exception int async_func_init(JSContext *ctx, JSAsyncFunctionState *s,
   init_list_head(&sf->var_ref_list);
   p = JS_VALUE_GET_OBJ(func_obj);
   b = p->u.func.function_bytecode;
+  if (js_ensure_function_body(ctx, b))
+    return -1;
   sf->js_mode = b->js_mode;
   sf->cur_pc = b->byte_code_buf;
   arg_buf_len = max_int(b->arg_count, argc);
@@ -138,7 +141,7 @@ void js_async_function_free0(JSRuntime *rt, JSAsyncFunctionData *s)
   js_async_function_terminate(rt, s);
   JS_FreeValueRT(rt, s->resolving_funcs[0]);
   JS_FreeValueRT(rt, s->resolving_funcs[1]);
-  remove_gc_object(&s->header);
+  remove_gc_object(rt, &s->header);
   js_free_rt(rt, s);
 }
 
@@ -24,6 +24,7 @@
  */
 
 #include "js-function.h"
+#include "../bytecode.h"
 #include "../convertion.h"
 #include "../exception.h"
 #include "../function.h"
@@ -449,6 +450,8 @@ JSValue js_function_proto_caller(JSContext* ctx, JSValueConst this_val, int argc
 JSValue js_function_proto_fileName(JSContext* ctx, JSValueConst this_val) {
   JSFunctionBytecode* b = JS_GetFunctionBytecode(this_val);
   if (b && b->has_debug) {
+    if (js_ensure_function_body(ctx, b))
+      return JS_EXCEPTION;
     return JS_AtomToString(ctx, b->debug.filename);
   }
   return JS_UNDEFINED;
@@ -457,6 +460,8 @@ JSValue js_function_proto_fileName(JSContext* ctx, JSValueConst this_val) {
 JSValue js_function_proto_lineNumber(JSContext* ctx, JSValueConst this_val) {
   JSFunctionBytecode* b = JS_GetFunctionBytecode(this_val);
   if (b && b->has_debug) {
+    if (js_ensure_function_body(ctx, b))
+      return JS_EXCEPTION;
     return JS_NewInt32(ctx, b->debug.line_num);
   }
   return JS_UNDEFINED;
@@ -465,6 +470,8 @@ JSValue js_function_proto_lineNumber(JSContext* ctx, JSValueConst this_val) {
 JSValue js_function_proto_columnNumber(JSContext *ctx, JSValueConst this_val) {
   JSFunctionBytecode* b = JS_GetFunctionBytecode(this_val);
   if (b && b->has_debug) {
+    if (js_ensure_function_body(ctx, b))
+      return JS_EXCEPTION;
     return JS_NewInt32(ctx, b->debug.column_num);
   }
   return JS_UNDEFINED;
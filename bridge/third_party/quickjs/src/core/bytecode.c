@@ -38,6 +38,8 @@
 #include "shape.h"
 #include "string.h"
 
+static void js_free_lazy_function_body(JSRuntime* rt, struct JSLazyFunctionBody* body);
+
 void free_function_bytecode(JSRuntime* rt, JSFunctionBytecode* b) {
   int i;
 
@@ -48,7 +50,11 @@ void free_function_bytecode(JSRuntime* rt, JSFunctionBytecode* b) {
                JS_AtomGetStrRT(rt, buf, sizeof(buf), b->func_name));
     }
 #endif
+  if (b->lazy_body)
+    js_free_lazy_function_body(rt, b->lazy_body);
   free_bytecode_atoms(rt, b->byte_code_buf, b->byte_code_len, TRUE);
+  if (b->byte_code_allocated)
+    js_free_rt(rt, b->byte_code_buf);
   if (b->ic != NULL)
     free_ic(b->ic);
 
@@ -70,12 +76,14 @@ void free_function_bytecode(JSRuntime* rt, JSFunctionBytecode* b) {
   JS_FreeAtomRT(rt, b->func_name);
   if (b->has_debug) {
     JS_FreeAtomRT(rt, b->debug.filename);
-    js_free_rt(rt, b->debug.pc2line_buf);
-    js_free_rt(rt, b->debug.pc2column_buf);
-    js_free_rt(rt, b->debug.source);
+    if (!b->debug_inline) {
+      js_free_rt(rt, b->debug.pc2line_buf);
+      js_free_rt(rt, b->debug.pc2column_buf);
+      js_free_rt(rt, b->debug.source);
+    }
   }
 
-  remove_gc_object(&b->header);
+  remove_gc_object(rt, &b->header);
   if (rt->gc_phase == JS_GC_PHASE_REMOVE_CYCLES && b->header.ref_count != 0) {
     list_add_tail(&b->header.link, &rt->gc_zero_ref_count_list);
   } else {
@@ -138,6 +146,7 @@ typedef enum BCTagEnum {
   BC_TAG_DATE,
   BC_TAG_OBJECT_VALUE,
   BC_TAG_OBJECT_REFERENCE,
+  BC_TAG_ATOM_STRING, /* a string of the atom table */
 } BCTagEnum;
 
 #ifdef CONFIG_BIGNUM
@@ -159,6 +168,9 @@ typedef struct BCWriterState {
   BOOL allow_bytecode : 8;
   BOOL allow_sab : 8;
   BOOL allow_reference : 8;
+  /* bundle: the atoms of the table are referenced because the table
+     outlives the written objects, the strings are written as atoms */
+  BOOL bundle : 8;
   uint32_t first_atom;
   uint32_t* atom_to_idx;
   int atom_to_idx_size;
@@ -177,7 +189,7 @@ static const char* const bc_tag_str[] = {
     "invalid",           "null",     "undefined",   "false",           "true",       "int32",
     "float64",           "string",   "object",      "array",           "bigint",     "bigfloat",
     "bigdecimal",        "template", "function",    "module",          "TypedArray", "ArrayBuffer",
-    "SharedArrayBuffer", "Date",     "ObjectValue", "ObjectReference",
+    "SharedArrayBuffer", "Date",     "ObjectValue", "ObjectReference", "AtomString",
 };
 #endif
 
@@ -243,6 +255,8 @@ static int bc_atom_to_idx(BCWriterState* s, uint32_t* pres, JSAtom atom) {
 
   v = s->idx_to_atom_count++;
   s->idx_to_atom[v] = atom + s->first_atom;
+  if (s->bundle)
+    JS_DupAtom(s->ctx, atom + s->first_atom);
   v += s->first_atom;
   s->atom_to_idx[atom] = v;
   *pres = v;
@@ -371,6 +385,27 @@ static void JS_WriteString(BCWriterState* s, JSString* p) {
   }
 }
 
+/* the strings of a bundle share the atom table, so that a string used by
+   several modules or also used as a property name is written once */
+static int bc_put_atom_string(BCWriterState* s, JSString* p) {
+  JSAtom atom;
+  int ret;
+
+  atom = JS_NewAtomStr(s->ctx, JS_VALUE_GET_STRING(JS_DupValue(s->ctx, JS_MKPTR(JS_TAG_STRING, p))));
+  if (atom == JS_ATOM_NULL)
+    return -1;
+  if (__JS_AtomIsTaggedInt(atom)) {
+    /* integer strings are not kept as strings by the atoms */
+    bc_put_u8(s, BC_TAG_STRING);
+    JS_WriteString(s, p);
+    return 0;
+  }
+  bc_put_u8(s, BC_TAG_ATOM_STRING);
+  ret = bc_put_atom(s, atom);
+  JS_FreeAtom(s->ctx, atom);
+  return ret;
+}
+
 #ifdef CONFIG_BIGNUM
 static int JS_WriteBigNum(BCWriterState* s, JSValueConst obj) {
   uint32_t tag, tag1;
@@ -511,8 +546,12 @@ static int JS_WriteObjectRec(BCWriterState* s, JSValueConst obj);
 
 static int JS_WriteFunctionTag(BCWriterState* s, JSValueConst obj) {
   JSFunctionBytecode* b = JS_VALUE_GET_PTR(obj);
-  uint32_t flags;
+  uint32_t flags, body_len;
   int idx, i;
+  size_t body_offset = 0;
+
+  if (js_ensure_function_body(s->ctx, b))
+    goto fail;
 
   bc_put_u8(s, BC_TAG_FUNCTION_BYTECODE);
   flags = idx = 0;
@@ -573,6 +612,12 @@ static int JS_WriteFunctionTag(BCWriterState* s, JSValueConst obj) {
     bc_put_u8(s, flags);
   }
 
+  if (s->bundle) {
+    /* the length of the body, so that a lazy reader can skip it */
+    body_offset = s->dbuf.size;
+    bc_put_u32(s, 0);
+  }
+
   if (JS_WriteFunctionBytecode(s, b->byte_code_buf, b->byte_code_len))
     goto fail;
 
@@ -594,21 +639,23 @@ static int JS_WriteFunctionTag(BCWriterState* s, JSValueConst obj) {
     bc_put_leb128(s, b->debug.pc2column_len);
     dbuf_put(&s->dbuf, b->debug.pc2column_buf, b->debug.pc2column_len);
 
-    /** 
-     * purely for compatibility with WebF/Kraken V1 quickjs compiler (kbc1 file format).
-     * determination of whether a Self PolyIC is available by 
-     * adding a special sequence of characters.
-     */
-    dbuf_putc(&s->dbuf, 255);
-    dbuf_putc(&s->dbuf, 73); // 'I'
-    dbuf_putc(&s->dbuf, 67); // 'C'
-    if (b->ic == NULL) {
-      bc_put_leb128(s, 0);
-    } else {
-      bc_put_leb128(s, b->ic->count);
-      for (i = 0; i < b->ic->count; i++) {
-        bc_put_atom(s, b->ic->cache[i].atom);
-      }
+  }
+
+  /**
+   * purely for compatibility with WebF/Kraken V1 quickjs compiler (kbc1 file format).
+   * determination of whether a Self PolyIC is available by
+   * adding a special sequence of characters.
+   * The IC follows the debug information, stripped functions use it as well.
+   */
+  dbuf_putc(&s->dbuf, 255);
+  dbuf_putc(&s->dbuf, 73); // 'I'
+  dbuf_putc(&s->dbuf, 67); // 'C'
+  if (b->ic == NULL) {
+    bc_put_leb128(s, 0);
+  } else {
+    bc_put_leb128(s, b->ic->count);
+    for (i = 0; i < b->ic->count; i++) {
+      bc_put_atom(s, b->ic->cache[i].atom);
     }
   }
 
@@ -616,6 +663,15 @@ static int JS_WriteFunctionTag(BCWriterState* s, JSValueConst obj) {
     if (JS_WriteObjectRec(s, b->cpool[i]))
       goto fail;
   }
+
+  if (s->bundle) {
+    if (s->dbuf.error)
+      goto fail;
+    body_len = s->dbuf.size - body_offset - 4;
+    if (s->byte_swap)
+      body_len = bswap32(body_len);
+    put_u32(s->dbuf.buf + body_offset, body_len);
+  }
   return 0;
 fail:
   return -1;
@@ -817,8 +873,13 @@ static int JS_WriteObjectRec(BCWriterState* s, JSValueConst obj) {
     } break;
     case JS_TAG_STRING: {
       JSString* p = JS_VALUE_GET_STRING(obj);
-      bc_put_u8(s, BC_TAG_STRING);
-      JS_WriteString(s, p);
+      if (s->bundle) {
+        if (bc_put_atom_string(s, p))
+          goto fail;
+      } else {
+        bc_put_u8(s, BC_TAG_STRING);
+        JS_WriteString(s, p);
+      }
     } break;
     case JS_TAG_FUNCTION_BYTECODE:
       if (!s->allow_bytecode)
@@ -971,7 +1032,7 @@ uint8_t* JS_WriteObject2(JSContext* ctx,
   s->allow_reference = ((flags & JS_WRITE_OBJ_REFERENCE) != 0);
   /* XXX: could use a different version when bytecode is included */
   if (s->allow_bytecode)
-    s->first_atom = JS_ATOM_END;
+    s->first_atom = JS_ATOM_END_BUILTIN;
   else
     s->first_atom = 1;
   js_dbuf_init(ctx, &s->dbuf);
@@ -1003,10 +1064,72 @@ fail:
   return NULL;
 }
 
+int JS_GetBytecodeVersion(void) {
+  return BC_VERSION;
+}
+
 uint8_t* JS_WriteObject(JSContext* ctx, size_t* psize, JSValueConst obj, int flags) {
   return JS_WriteObject2(ctx, psize, obj, flags, NULL, NULL);
 }
 
+struct JSBundleWriter {
+  BCWriterState state;
+};
+
+JSBundleWriter* JS_NewBundleWriter(JSContext* ctx) {
+  JSBundleWriter* w;
+  BCWriterState* s;
+
+  w = js_mallocz(ctx, sizeof(*w));
+  if (!w)
+    return NULL;
+  s = &w->state;
+  s->ctx = ctx;
+  s->allow_bytecode = TRUE;
+  s->bundle = TRUE;
+  s->first_atom = JS_ATOM_END_BUILTIN;
+  return w;
+}
+
+uint8_t* JS_WriteBundleObject(JSBundleWriter* w, size_t* psize, JSValueConst obj) {
+  BCWriterState* s = &w->state;
+
+  js_dbuf_init(s->ctx, &s->dbuf);
+  js_object_list_init(&s->object_list);
+  if (JS_WriteObjectRec(s, obj)) {
+    js_object_list_end(s->ctx, &s->object_list);
+    dbuf_free(&s->dbuf);
+    *psize = 0;
+    return NULL;
+  }
+  js_object_list_end(s->ctx, &s->object_list);
+  *psize = s->dbuf.size;
+  return s->dbuf.buf;
+}
+
+uint8_t* JS_WriteBundleTables(JSBundleWriter* w, size_t* psize) {
+  BCWriterState* s = &w->state;
+
+  js_dbuf_init(s->ctx, &s->dbuf);
+  if (JS_WriteObjectAtoms(s)) {
+    *psize = 0;
+    return NULL;
+  }
+  *psize = s->dbuf.size;
+  return s->dbuf.buf;
+}
+
+void JS_FreeBundleWriter(JSBundleWriter* w) {
+  BCWriterState* s = &w->state;
+  int i;
+
+  for (i = 0; i < s->idx_to_atom_count; i++)
+    JS_FreeAtom(s->ctx, s->idx_to_atom[i]);
+  js_free(s->ctx, s->atom_to_idx);
+  js_free(s->ctx, s->idx_to_atom);
+  js_free(s->ctx, w);
+}
+
 typedef struct BCReaderState {
   JSContext* ctx;
   const uint8_t *buf_start, *ptr, *buf_end;
@@ -1018,6 +1141,10 @@ typedef struct BCReaderState {
   BOOL allow_bytecode : 8;
   BOOL is_rom_data : 8;
   BOOL allow_reference : 8;
+  /* the atom table of the bundle of the object, instead of idx_to_atom */
+  JSBundleReader* bundle;
+  /* the function bodies are skipped and read on the first call */
+  BOOL lazy : 8;
   /* object references */
   JSObject** objects;
   int objects_count;
@@ -1153,6 +1280,71 @@ static int bc_get_buf(BCReaderState* s, uint8_t* buf, uint32_t buf_len) {
   return 0;
 }
 
+struct JSBundleReader {
+  /* also referenced by the function bodies which are not read yet */
+  int ref_count;
+  /* NULL once the reader is freed */
+  const uint8_t* tables;
+  size_t tables_len;
+  uint32_t atom_count;
+  /* offset of each atom string in the tables */
+  uint32_t* atom_offsets;
+  /* created on first use, JS_ATOM_NULL before */
+  JSAtom* atoms;
+};
+
+typedef struct JSLazyFunctionBody {
+  JSBundleReader* bundle;
+  /* the body in the buffer of the bundle, which outlives the reader */
+  const uint8_t* buf;
+  uint32_t len;
+  int byte_code_len;
+  BOOL failed;
+} JSLazyFunctionBody;
+
+static void js_bundle_reader_unref(JSRuntime* rt, JSBundleReader* r) {
+  if (--r->ref_count == 0)
+    js_free_rt(rt, r);
+}
+
+static void js_free_lazy_function_body(JSRuntime* rt, JSLazyFunctionBody* body) {
+  js_bundle_reader_unref(rt, body->bundle);
+  js_free_rt(rt, body);
+}
+
+static JSString* JS_ReadString(BCReaderState* s);
+
+static int bc_bundle_atom(BCReaderState* s, JSAtom* patom, uint32_t idx) {
+  JSBundleReader* r = s->bundle;
+  BCReaderState ts;
+  JSString* p;
+
+  if (idx >= r->atom_count) {
+    JS_ThrowSyntaxError(s->ctx, "invalid atom index (pos=%u)", (unsigned int)(s->ptr - s->buf_start));
+    *patom = JS_ATOM_NULL;
+    return s->error_state = -1;
+  }
+  if (r->atoms[idx] == JS_ATOM_NULL) {
+    memset(&ts, 0, sizeof(ts));
+    ts.ctx = s->ctx;
+    ts.buf_start = r->tables;
+    ts.ptr = r->tables + r->atom_offsets[idx];
+    ts.buf_end = r->tables + r->tables_len;
+    p = JS_ReadString(&ts);
+    if (!p) {
+      *patom = JS_ATOM_NULL;
+      return s->error_state = -1;
+    }
+    r->atoms[idx] = JS_NewAtomStr(s->ctx, p);
+    if (r->atoms[idx] == JS_ATOM_NULL) {
+      *patom = JS_ATOM_NULL;
+      return s->error_state = -1;
+    }
+  }
+  *patom = JS_DupAtom(s->ctx, r->atoms[idx]);
+  return 0;
+}
+
 static int bc_idx_to_atom(BCReaderState* s, JSAtom* patom, uint32_t idx) {
   JSAtom atom;
 
@@ -1160,6 +1352,8 @@ static int bc_idx_to_atom(BCReaderState* s, JSAtom* patom, uint32_t idx) {
     atom = idx;
   } else if (idx < s->first_atom) {
     atom = JS_DupAtom(s->ctx, idx);
+  } else if (s->bundle) {
+    return bc_bundle_atom(s, patom, idx - s->first_atom);
   } else {
     idx -= s->first_atom;
     if (idx >= s->idx_to_atom_count) {
@@ -1226,8 +1420,7 @@ static uint32_t bc_get_flags(uint32_t flags, int* pidx, int n) {
   return val;
 }
 
-static int JS_ReadFunctionBytecode(BCReaderState* s, JSFunctionBytecode* b, int byte_code_offset, uint32_t bc_len) {
-  uint8_t* bc_buf;
+static int JS_ReadFunctionBytecode(BCReaderState* s, JSFunctionBytecode* b, uint8_t* bc_buf, uint32_t bc_len) {
   int pos, len, op;
   JSAtom atom;
   uint32_t idx;
@@ -1239,7 +1432,6 @@ static int JS_ReadFunctionBytecode(BCReaderState* s, JSFunctionBytecode* b, int
     bc_buf = (uint8_t*)s->ptr;
     s->ptr += bc_len;
   } else {
-    bc_buf = (void*)((uint8_t*)b + byte_code_offset);
     if (bc_get_buf(s, bc_buf, bc_len))
       return -1;
   }
@@ -1427,6 +1619,104 @@ static int BC_add_object_ref(BCReaderState* s, JSValueConst obj) {
   return BC_add_object_ref1(s, JS_VALUE_GET_OBJ(obj));
 }
 
+/* reads the bytecode, the debug info, the inline cache and the constant pool */
+static int JS_ReadFunctionBody(BCReaderState* s, JSFunctionBytecode* b, uint8_t* byte_code_buf) {
+  JSContext* ctx = s->ctx;
+  uint32_t ic_len;
+  JSAtom atom;
+  int i;
+
+  bc_read_trace(s, "bytecode {\n");
+  if (JS_ReadFunctionBytecode(s, b, byte_code_buf, b->byte_code_len))
+    return -1;
+  bc_read_trace(s, "}\n");
+  if (b->has_debug) {
+    /* read optional debug information */
+    bc_read_trace(s, "debug {\n");
+    if (bc_get_atom(s, &b->debug.filename)) {
+      return -1;
+    }
+
+    if (bc_get_leb128_int(s, &b->debug.line_num)) {
+      return -1;
+    }
+
+    if (bc_get_leb128_int(s, &b->debug.pc2line_len)) {
+      return -1;
+    }
+
+    if (b->debug.pc2line_len) {
+      b->debug.pc2line_buf = js_mallocz(ctx, b->debug.pc2line_len);
+      if (!b->debug.pc2line_buf)
+        return -1;
+      if (bc_get_buf(s, b->debug.pc2line_buf, b->debug.pc2line_len))
+        return -1;
+    }
+
+    /** special column number check logic for V1(.kbc1 file) bytecode format. */
+    if (s->buf_end - s->ptr > 4 && s->ptr[0] == 255 && s->ptr[1] == 67 && s->ptr[2] == 79 && s->ptr[3] == 76) {
+      s->ptr += 4;
+      if (bc_get_leb128_int(s, &b->debug.column_num)) {
+        return -1;
+      }
+
+      if (bc_get_leb128_int(s, &b->debug.pc2column_len)) {
+        return -1;
+      }
+
+      if (b->debug.pc2column_len) {
+        b->debug.pc2column_buf = js_mallocz(ctx, b->debug.pc2column_len);
+        if (!b->debug.pc2column_buf) {
+          return -1;
+        }
+
+        if (bc_get_buf(s, b->debug.pc2column_buf, b->debug.pc2column_len)) {
+          return -1;
+        }
+      }
+    }
+
+#ifdef DUMP_READ_OBJECT
+    bc_read_trace(s, "filename: ");
+    print_atom(s->ctx, b->debug.filename);
+    printf("\n");
+#endif
+    bc_read_trace(s, "}\n");
+  }
+  /** special Self PolyIC check logic for V1(.kbc1 file) bytecode format. */
+  if (s->buf_end - s->ptr > 3 && s->ptr[0] == 255 && s->ptr[1] == 73 && s->ptr[2] == 67) {
+    s->ptr += 3;
+    if (bc_get_leb128(s, &ic_len))
+      return -1;
+    if (ic_len == 0) {
+      b->ic = NULL;
+    } else {
+      b->ic = init_ic(ctx);
+      if (b->ic == NULL)
+        return -1;
+      for (i = 0; i < ic_len; i++) {
+        if (bc_get_atom(s, &atom))
+          return -1;
+        add_ic_slot1(b->ic, atom);
+        JS_FreeAtom(ctx, atom);
+      }
+      rebuild_ic(b->ic);
+    }
+  }
+  if (b->cpool_count != 0) {
+    bc_read_trace(s, "cpool {\n");
+    for (i = 0; i < b->cpool_count; i++) {
+      JSValue val;
+      val = JS_ReadObjectRec(s);
+      if (JS_IsException(val))
+        return -1;
+      b->cpool[i] = val;
+    }
+    bc_read_trace(s, "}\n");
+  }
+  return 0;
+}
+
 static JSValue JS_ReadFunctionTag(BCReaderState* s) {
   JSContext* ctx = s->ctx;
   JSFunctionBytecode bc, *b;
@@ -1436,8 +1726,8 @@ static JSValue JS_ReadFunctionTag(BCReaderState* s) {
   int idx, i, local_count;
   int function_size, cpool_offset, byte_code_offset;
   int closure_var_offset, vardefs_offset;
-  uint32_t ic_len;
-  JSAtom atom;
+  uint32_t body_len = 0;
+  JSLazyFunctionBody* lazy;
 
   memset(&bc, 0, sizeof(bc));
   bc.header.ref_count = 1;
@@ -1492,7 +1782,7 @@ static JSValue JS_ReadFunctionTag(BCReaderState* s) {
   closure_var_offset = function_size;
   function_size += bc.closure_var_count * sizeof(*bc.closure_var);
   byte_code_offset = function_size;
-  if (!bc.read_only_bytecode) {
+  if (!bc.read_only_bytecode && !s->lazy) {
     function_size += bc.byte_code_len;
   }
 
@@ -1502,6 +1792,10 @@ static JSValue JS_ReadFunctionTag(BCReaderState* s) {
 
   memcpy(b, &bc, offsetof(JSFunctionBytecode, debug));
   b->header.ref_count = 1;
+  if (s->lazy) {
+    /* set with the bytecode when the body is read */
+    b->byte_code_len = 0;
+  }
   if (local_count != 0) {
     b->vardefs = (void*)((uint8_t*)b + vardefs_offset);
   }
@@ -1577,94 +1871,28 @@ static JSValue JS_ReadFunctionTag(BCReaderState* s) {
     }
     bc_read_trace(s, "}\n");
   }
-  {
-    bc_read_trace(s, "bytecode {\n");
-    if (JS_ReadFunctionBytecode(s, b, byte_code_offset, b->byte_code_len))
-      goto fail;
-    bc_read_trace(s, "}\n");
-  }
-  if (b->has_debug) {
-    /* read optional debug information */
-    bc_read_trace(s, "debug {\n");
-    if (bc_get_atom(s, &b->debug.filename)) {
+  if (s->bundle) {
+    if (bc_get_u32(s, &body_len))
       goto fail;
-    }
-
-    if (bc_get_leb128_int(s, &b->debug.line_num)) {
+    if (s->buf_end - s->ptr < body_len) {
+      bc_read_error_end(s);
       goto fail;
     }
-
-    if (bc_get_leb128_int(s, &b->debug.pc2line_len)) {
-      goto fail;
-    }
-
-    if (b->debug.pc2line_len) {
-      b->debug.pc2line_buf = js_mallocz(ctx, b->debug.pc2line_len);
-      if (!b->debug.pc2line_buf)
-        goto fail;
-      if (bc_get_buf(s, b->debug.pc2line_buf, b->debug.pc2line_len))
-        goto fail;
-    }
-
-    /** special column number check logic for V1(.kbc1 file) bytecode format. */
-    if (s->buf_end - s->ptr > 4 && s->ptr[0] == 255 && s->ptr[1] == 67 && s->ptr[2] == 79 && s->ptr[3] == 76) {
-      s->ptr += 4;
-      if (bc_get_leb128_int(s, &b->debug.column_num)) {
-        goto fail;
-      }
-
-      if (bc_get_leb128_int(s, &b->debug.pc2column_len)) {
-        goto fail;
-      }
-
-      if (b->debug.pc2column_len) {
-        b->debug.pc2column_buf = js_mallocz(ctx, b->debug.pc2column_len);
-        if (!b->debug.pc2column_buf) {
-          goto fail;
-        }
-
-        if (bc_get_buf(s, b->debug.pc2column_buf, b->debug.pc2column_len)) {
-          goto fail;
-        }
-      }
-    }
-
-    /** special Self PolyIC check logic for V1(.kbc1 file) bytecode format. */
-    if(s->buf_end - s->ptr > 3 && s->ptr[0] == 255 && s->ptr[1] == 73 && s->ptr[2] == 67) {
-      s->ptr += 3;
-      bc_get_leb128(s, &ic_len);
-      if (ic_len == 0) {
-        b->ic = NULL;
-      } else {
-        b->ic = init_ic(ctx);
-        if (b->ic == NULL)
-          goto fail;
-        for (i = 0; i < ic_len; i++) {
-          bc_get_atom(s, &atom);
-          add_ic_slot1(b->ic, atom);
-          JS_FreeAtom(ctx, atom);
-        }
-        rebuild_ic(b->ic);
-      }
-    }
-
-#ifdef DUMP_READ_OBJECT
-    bc_read_trace(s, "filename: ");
-    print_atom(s->ctx, b->debug.filename);
-    printf("\n");
-#endif
-    bc_read_trace(s, "}\n");
   }
-  if (b->cpool_count != 0) {
-    bc_read_trace(s, "cpool {\n");
-    for (i = 0; i < b->cpool_count; i++) {
-      JSValue val;
-      val = JS_ReadObjectRec(s);
-      if (JS_IsException(val))
-        goto fail;
-      b->cpool[i] = val;
-    }
-    bc_read_trace(s, "}\n");
+  if (s->lazy) {
+    lazy = js_malloc(ctx, sizeof(*lazy));
+    if (!lazy)
+      goto fail;
+    lazy->bundle = s->bundle;
+    lazy->bundle->ref_count++;
+    lazy->buf = s->ptr;
+    lazy->len = body_len;
+    lazy->byte_code_len = bc.byte_code_len;
+    lazy->failed = FALSE;
+    b->lazy_body = lazy;
+    s->ptr += body_len;
+  } else if (JS_ReadFunctionBody(s, b, (uint8_t*)b + byte_code_offset)) {
+    goto fail;
   }
   b->realm = JS_DupContext(ctx);
   return obj;
@@ -2036,6 +2264,13 @@ static JSValue JS_ReadObjectRec(BCReaderState* s) {
         return JS_EXCEPTION;
       obj = JS_MKPTR(JS_TAG_STRING, p);
     } break;
+    case BC_TAG_ATOM_STRING: {
+      JSAtom atom;
+      if (bc_get_atom(s, &atom))
+        return JS_EXCEPTION;
+      obj = JS_AtomToString(ctx, atom);
+      JS_FreeAtom(ctx, atom);
+    } break;
     case BC_TAG_FUNCTION_BYTECODE:
       if (!s->allow_bytecode)
         goto invalid_tag;
@@ -2163,7 +2398,7 @@ JSValue JS_ReadObject(JSContext* ctx, const uint8_t* buf, size_t buf_len, int fl
   s->allow_sab = ((flags & JS_READ_OBJ_SAB) != 0);
   s->allow_reference = ((flags & JS_READ_OBJ_REFERENCE) != 0);
   if (s->allow_bytecode)
-    s->first_atom = JS_ATOM_END;
+    s->first_atom = JS_ATOM_END_BUILTIN;
   else
     s->first_atom = 1;
   if (JS_ReadObjectAtoms(s)) {
@@ -2173,4 +2408,288 @@ JSValue JS_ReadObject(JSContext* ctx, const uint8_t* buf, size_t buf_len, int fl
   }
   bc_reader_free(s);
   return obj;
-}
\ No newline at end of file
+}
+
+JSBundleReader* JS_NewBundleReader(JSContext* ctx, const uint8_t* tables, size_t tables_len) {
+  BCReaderState ss, *s = &ss;
+  JSBundleReader* r;
+  uint8_t v8;
+  uint32_t i, len;
+  size_t size;
+
+  memset(s, 0, sizeof(*s));
+  s->ctx = ctx;
+  s->buf_start = tables;
+  s->buf_end = tables + tables_len;
+  s->ptr = tables;
+  if (bc_get_u8(s, &v8))
+    return NULL;
+  if (v8 != BC_VERSION) {
+    JS_ThrowSyntaxError(ctx, "invalid version (%d expected=%d)", v8, BC_VERSION);
+    return NULL;
+  }
+  r = js_mallocz(ctx, sizeof(*r));
+  if (!r)
+    return NULL;
+  r->ref_count = 1;
+  r->tables = tables;
+  r->tables_len = tables_len;
+  if (bc_get_leb128(s, &r->atom_count))
+    goto fail;
+  if (r->atom_count > tables_len) {
+    bc_read_error_end(s);
+    goto fail;
+  }
+  if (r->atom_count != 0) {
+    r->atom_offsets = js_malloc(ctx, r->atom_count * sizeof(r->atom_offsets[0]));
+    r->atoms = js_mallocz(ctx, r->atom_count * sizeof(r->atoms[0]));
+    if (!r->atom_offsets || !r->atoms)
+      goto fail;
+  }
+  /* the atoms are only created when a module uses them */
+  for (i = 0; i < r->atom_count; i++) {
+    r->atom_offsets[i] = s->ptr - s->buf_start;
+    if (bc_get_leb128(s, &len))
+      goto fail;
+    size = (size_t)(len >> 1) << (len & 1);
+    if (s->buf_end - s->ptr < size) {
+      bc_read_error_end(s);
+      goto fail;
+    }
+    s->ptr += size;
+  }
+  return r;
+fail:
+  JS_FreeBundleReader(ctx->rt, r);
+  return NULL;
+}
+
+JSValue JS_ReadBundleObject(JSContext* ctx, JSBundleReader* r, const uint8_t* buf, size_t buf_len, int flags) {
+  BCReaderState ss, *s = &ss;
+  JSValue obj;
+
+  ctx->binary_object_count += 1;
+  ctx->binary_object_size += buf_len;
+
+  memset(s, 0, sizeof(*s));
+  s->ctx = ctx;
+  s->buf_start = buf;
+  s->buf_end = buf + buf_len;
+  s->ptr = buf;
+  s->allow_bytecode = TRUE;
+  s->first_atom = JS_ATOM_END_BUILTIN;
+  s->bundle = r;
+  s->lazy = ((flags & JS_READ_OBJ_LAZY) != 0);
+  obj = JS_ReadObjectRec(s);
+  bc_reader_free(s);
+  return obj;
+}
+
+void JS_FreeBundleReader(JSRuntime* rt, JSBundleReader* r) {
+  uint32_t i;
+
+  if (r->atoms) {
+    for (i = 0; i < r->atom_count; i++)
+      JS_FreeAtomRT(rt, r->atoms[i]);
+  }
+  js_free_rt(rt, r->atom_offsets);
+  js_free_rt(rt, r->atoms);
+  r->tables = NULL;
+  r->atom_count = 0;
+  r->atom_offsets = NULL;
+  r->atoms = NULL;
+  js_bundle_reader_unref(rt, r);
+}
+
+int js_read_lazy_function_body(JSContext* ctx, JSFunctionBytecode* b) {
+  JSLazyFunctionBody* lazy = b->lazy_body;
+  BCReaderState ss, *s = &ss;
+  uint8_t* byte_code_buf;
+  int ret;
+
+  if (lazy->failed || lazy->bundle->tables == NULL) {
+    JS_ThrowInternalError(ctx, "the body of the function could not be read from its bundle");
+    return -1;
+  }
+  byte_code_buf = js_mallocz(ctx, max_int(lazy->byte_code_len, 1));
+  if (!byte_code_buf)
+    return -1;
+  b->byte_code_buf = byte_code_buf;
+  b->byte_code_len = lazy->byte_code_len;
+  b->byte_code_allocated = 1;
+
+  memset(s, 0, sizeof(*s));
+  /* the nested functions belong to the realm of the function */
+  s->ctx = b->realm;
+  s->buf_start = lazy->buf;
+  s->buf_end = lazy->buf + lazy->len;
+  s->ptr = lazy->buf;
+  s->allow_bytecode = TRUE;
+  s->first_atom = JS_ATOM_END_BUILTIN;
+  s->bundle = lazy->bundle;
+  s->lazy = TRUE;
+  ret = JS_ReadFunctionBody(s, b, byte_code_buf);
+  bc_reader_free(s);
+  if (ret) {
+    /* the function keeps what was read, to be freed with it, but is never run */
+    lazy->failed = TRUE;
+    return -1;
+  }
+  b->lazy_body = NULL;
+  js_free_lazy_function_body(ctx->rt, lazy);
+  return 0;
+}
+
+static void dup_bytecode_atoms(JSRuntime* rt, const uint8_t* bc_buf, int bc_len) {
+  int pos, len, op;
+  const JSOpCode* oi;
+
+  pos = 0;
+  while (pos < bc_len) {
+    op = bc_buf[pos];
+    oi = &short_opcode_info(op);
+    len = oi->size;
+    switch (oi->fmt) {
+      case OP_FMT_atom:
+      case OP_FMT_atom_u8:
+      case OP_FMT_atom_u16:
+      case OP_FMT_atom_label_u8:
+      case OP_FMT_atom_label_u16:
+        JS_DupAtomRT(rt, get_u32(bc_buf + pos + 1));
+        break;
+      default:
+        break;
+    }
+    pos += len;
+  }
+}
+
+static JSValue js_clone_function_bytecode(JSContext* ctx, JSFunctionBytecode* b0) {
+  JSFunctionBytecode* b;
+  JSValue obj, val;
+  int i, local_count, function_size, cpool_offset, vardefs_offset, closure_var_offset, byte_code_offset, debug_offset;
+  uint8_t* debug_buf;
+
+  if (js_ensure_function_body(ctx, b0))
+    return JS_EXCEPTION;
+
+  /* objects of the constant pool (e.g. template objects) belong to the realm of b0 */
+  for (i = 0; i < b0->cpool_count; i++) {
+    if (JS_VALUE_GET_TAG(b0->cpool[i]) == JS_TAG_OBJECT || JS_VALUE_GET_TAG(b0->cpool[i]) == JS_TAG_MODULE)
+      return JS_UNDEFINED;
+  }
+
+  local_count = b0->vardefs ? b0->arg_count + b0->var_count : 0;
+  if (b0->has_debug) {
+    function_size = sizeof(*b);
+  } else {
+    function_size = offsetof(JSFunctionBytecode, debug);
+  }
+  cpool_offset = function_size;
+  function_size += b0->cpool_count * sizeof(*b0->cpool);
+  vardefs_offset = function_size;
+  function_size += local_count * sizeof(*b0->vardefs);
+  closure_var_offset = function_size;
+  function_size += b0->closure_var_count * sizeof(*b0->closure_var);
+  byte_code_offset = function_size;
+  /* the interpreter rewrites the opcodes, each copy owns its bytecode */
+  function_size += b0->byte_code_len;
+  debug_offset = function_size;
+  if (b0->has_debug) {
+    /* the debug buffers are never modified, they are copied to the same allocation */
+    function_size += b0->debug.pc2line_len + b0->debug.pc2column_len;
+    if (b0->debug.source)
+      function_size += b0->debug.source_len + 1;
+  }
+
+  b = js_malloc(ctx, function_size);
+  if (!b)
+    return JS_EXCEPTION;
+
+  memcpy(b, b0, b0->has_debug ? sizeof(*b) : offsetof(JSFunctionBytecode, debug));
+  b->header.ref_count = 1;
+  b->read_only_bytecode = 0;
+  b->byte_code_allocated = 0;
+  b->ic = NULL;
+  b->realm = JS_DupContext(ctx);
+  JS_DupAtom(ctx, b->func_name);
+
+  b->byte_code_buf = (uint8_t*)b + byte_code_offset;
+  memcpy(b->byte_code_buf, b0->byte_code_buf, b0->byte_code_len);
+  dup_bytecode_atoms(ctx->rt, b->byte_code_buf, b->byte_code_len);
+
+  b->vardefs = NULL;
+  if (local_count != 0) {
+    b->vardefs = (void*)((uint8_t*)b + vardefs_offset);
+    memcpy(b->vardefs, b0->vardefs, local_count * sizeof(*b->vardefs));
+    for (i = 0; i < local_count; i++)
+      JS_DupAtom(ctx, b->vardefs[i].var_name);
+  }
+  b->closure_var = NULL;
+  if (b->closure_var_count != 0) {
+    b->closure_var = (void*)((uint8_t*)b + closure_var_offset);
+    memcpy(b->closure_var, b0->closure_var, b->closure_var_count * sizeof(*b->closure_var));
+    for (i = 0; i < b->closure_var_count; i++)
+      JS_DupAtom(ctx, b->closure_var[i].var_name);
+  }
+  b->cpool = NULL;
+  if (b->cpool_count != 0) {
+    b->cpool = (void*)((uint8_t*)b + cpool_offset);
+    for (i = 0; i < b->cpool_count; i++)
+      b->cpool[i] = JS_UNDEFINED;
+  }
+  if (b->has_debug) {
+    b->debug_inline = 1;
+    JS_DupAtom(ctx, b->debug.filename);
+    debug_buf = (uint8_t*)b + debug_offset;
+    b->debug.pc2line_buf = NULL;
+    if (b0->debug.pc2line_len) {
+      b->debug.pc2line_buf = debug_buf;
+      memcpy(debug_buf, b0->debug.pc2line_buf, b0->debug.pc2line_len);
+      debug_buf += b0->debug.pc2line_len;
+    }
+    b->debug.pc2column_buf = NULL;
+    if (b0->debug.pc2column_len) {
+      b->debug.pc2column_buf = debug_buf;
+      memcpy(debug_buf, b0->debug.pc2column_buf, b0->debug.pc2column_len);
+      debug_buf += b0->debug.pc2column_len;
+    }
+    b->debug.source = NULL;
+    if (b0->debug.source) {
+      b->debug.source = (char*)debug_buf;
+      memcpy(debug_buf, b0->debug.source, b0->debug.source_len);
+      debug_buf[b0->debug.source_len] = '\0';
+    }
+  }
+
+  add_gc_object(ctx->rt, &b->header, JS_GC_OBJ_TYPE_FUNCTION_BYTECODE);
+  obj = JS_MKPTR(JS_TAG_FUNCTION_BYTECODE, b);
+
+  if (b0->ic != NULL) {
+    b->ic = clone_ic(ctx, b0->ic);
+    if (b->ic == NULL) {
+      JS_FreeValue(ctx, obj);
+      return JS_ThrowOutOfMemory(ctx);
+    }
+  }
+
+  for (i = 0; i < b->cpool_count; i++) {
+    if (JS_VALUE_GET_TAG(b0->cpool[i]) == JS_TAG_FUNCTION_BYTECODE) {
+      val = js_clone_function_bytecode(ctx, JS_VALUE_GET_PTR(b0->cpool[i]));
+      if (JS_IsException(val) || JS_IsUndefined(val)) {
+        JS_FreeValue(ctx, obj);
+        return val;
+      }
+      b->cpool[i] = val;
+    } else {
+      b->cpool[i] = JS_DupValue(ctx, b0->cpool[i]);
+    }
+  }
+  return obj;
+}
+
+JSValue JS_CloneFunctionBytecode(JSContext* ctx, JSValueConst obj) {
+  if (JS_VALUE_GET_TAG(obj) != JS_TAG_FUNCTION_BYTECODE)
+    return JS_UNDEFINED;
+  return js_clone_function_bytecode(ctx, JS_VALUE_GET_PTR(obj));
+}
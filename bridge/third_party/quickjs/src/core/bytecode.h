@@ -34,5 +34,15 @@ void free_function_bytecode(JSRuntime *rt, JSFunctionBytecode *b);
 void free_bytecode_atoms(JSRuntime *rt,
                          const uint8_t *bc_buf, int bc_len,
                                 BOOL use_short_opcodes);;
+int js_read_lazy_function_body(JSContext *ctx, JSFunctionBytecode *b);
+
+/* must be called before the bytecode or the constant pool of a function
+   read lazily from a bundle are used */
+static inline int js_ensure_function_body(JSContext *ctx, JSFunctionBytecode *b)
+{
+    if (likely(b->lazy_body == NULL))
+        return 0;
+    return js_read_lazy_function_body(ctx, b);
+}
 
 #endif
\ No newline at end of file
@@ -32,6 +32,7 @@
 #include "builtins/js-object.h"
 #include "builtins/js-operator.h"
 #include "builtins/js-regexp.h"
+#include "bytecode.h"
 #include "convertion.h"
 #include "exception.h"
 #include "gc.h"
@@ -289,6 +290,8 @@ JSValue JS_CallInternal(JSContext* caller_ctx,
     return call_func(caller_ctx, func_obj, this_obj, argc, (JSValueConst*)argv, flags);
   }
   b = p->u.func.function_bytecode;
+  if (js_ensure_function_body(caller_ctx, b))
+    return JS_EXCEPTION;
 
   if (unlikely(argc < b->arg_count || (flags & JS_CALL_FLAG_COPY_ARGV))) {
     arg_allocated_size = b->arg_count;
@@ -1232,16 +1235,16 @@ restart:
       BREAK;
 
       CASE(OP_goto) : pc += (int32_t)get_u32(pc);
-      if (unlikely(js_poll_interrupts(ctx)))
+      if (unlikely(js_poll_interrupts_at(ctx, sf, pc)))
         goto exception;
       BREAK;
 #if SHORT_OPCODES
       CASE(OP_goto16) : pc += (int16_t)get_u16(pc);
-      if (unlikely(js_poll_interrupts(ctx)))
+      if (unlikely(js_poll_interrupts_at(ctx, sf, pc)))
         goto exception;
       BREAK;
       CASE(OP_goto8) : pc += (int8_t)pc[0];
-      if (unlikely(js_poll_interrupts(ctx)))
+      if (unlikely(js_poll_interrupts_at(ctx, sf, pc)))
         goto exception;
       BREAK;
 #endif
@@ -1260,7 +1263,7 @@ restart:
         if (res) {
           pc += (int32_t)get_u32(pc - 4) - 4;
         }
-        if (unlikely(js_poll_interrupts(ctx)))
+        if (unlikely(js_poll_interrupts_at(ctx, sf, pc)))
           goto exception;
       }
       BREAK;
@@ -1279,7 +1282,7 @@ restart:
         if (!res) {
           pc += (int32_t)get_u32(pc - 4) - 4;
         }
-        if (unlikely(js_poll_interrupts(ctx)))
+        if (unlikely(js_poll_interrupts_at(ctx, sf, pc)))
           goto exception;
       }
       BREAK;
@@ -1299,7 +1302,7 @@ restart:
         if (res) {
           pc += (int8_t)pc[-1] - 1;
         }
-        if (unlikely(js_poll_interrupts(ctx)))
+        if (unlikely(js_poll_interrupts_at(ctx, sf, pc)))
           goto exception;
       }
       BREAK;
@@ -1318,7 +1321,7 @@ restart:
         if (!res) {
           pc += (int8_t)pc[-1] - 1;
         }
-        if (unlikely(js_poll_interrupts(ctx)))
+        if (unlikely(js_poll_interrupts_at(ctx, sf, pc)))
           goto exception;
       }
       BREAK;
@@ -28,6 +28,7 @@
 #include "builtins/js-map.h"
 #include "builtins/js-proxy.h"
 #include "bytecode.h"
+#include "ic.h"
 #include "malloc.h"
 #include "module.h"
 #include "object.h"
@@ -351,7 +352,9 @@ void js_object_list_end(JSContext* ctx, JSObjectList* s) {
 /* indicate that the object may be part of a function prototype cycle */
 void set_cycle_flag(JSContext* ctx, JSValueConst obj) {}
 
-void remove_gc_object(JSGCObjectHeader* h) {
+void remove_gc_object(JSRuntime* rt, JSGCObjectHeader* h) {
+  if (unlikely(rt->heap_snapshot_ids))
+    js_forget_heap_snapshot_id(rt, h);
   list_del(&h->link);
 }
 
@@ -361,7 +364,7 @@ void free_var_ref(JSRuntime* rt, JSVarRef* var_ref) {
     if (--var_ref->header.ref_count == 0) {
       if (var_ref->is_detached) {
         JS_FreeValueRT(rt, var_ref->value);
-        remove_gc_object(&var_ref->header);
+        remove_gc_object(rt, &var_ref->header);
       } else {
         list_del(&var_ref->header.link); /* still on the stack */
       }
@@ -408,7 +411,7 @@ void free_object(JSRuntime* rt, JSObject* p) {
   p->u.func.var_refs = NULL;
   p->u.func.home_object = NULL;
 
-  remove_gc_object(&p->header);
+  remove_gc_object(rt, &p->header);
   if (rt->gc_phase == JS_GC_PHASE_REMOVE_CYCLES && p->header.ref_count != 0) {
     list_add_tail(&p->header.link, &rt->gc_zero_ref_count_list);
   } else {
@@ -482,6 +485,11 @@ void __JS_FreeValueRT(JSRuntime* rt, JSValue v) {
         if (rt->gc_phase == JS_GC_PHASE_NONE) {
           free_zero_refcount(rt);
         }
+      } else if (p->mark == 0) {
+        /* only referenced by the cycles: an object left out of a
+           minor collection, free it with them */
+        list_del(&p->link);
+        list_add_tail(&p->link, &rt->tmp_obj_list);
       }
     } break;
     case JS_TAG_MODULE:
@@ -518,8 +526,19 @@ void __JS_FreeValue(JSContext* ctx, JSValue v) {
 
 void add_gc_object(JSRuntime* rt, JSGCObjectHeader* h, JSGCObjectTypeEnum type) {
   h->mark = 0;
+  h->old = 0;
+  h->age = 0;
   h->gc_obj_type = type;
-  list_add_tail(&h->link, &rt->gc_obj_list);
+  list_add_tail(&h->link, &rt->gc_young_obj_list);
+}
+
+struct list_head* gc_obj_list_of(JSRuntime* rt, JSGCObjectHeader* h) {
+  return h->old ? &rt->gc_obj_list : &rt->gc_young_obj_list;
+}
+
+/* the list scanned by the running collection */
+static struct list_head* gc_scanned_list(JSRuntime* rt) {
+  return rt->gc_minor ? &rt->gc_young_obj_list : &rt->gc_obj_list;
 }
 
 void JS_MarkValue(JSRuntime* rt, JSValueConst val, JS_MarkFunc* mark_func) {
@@ -634,7 +653,7 @@ void mark_children(JSRuntime* rt, JSGCObjectHeader* gp, JS_MarkFunc* mark_func)
     case JS_GC_OBJ_TYPE_FUNCTION_BYTECODE:
       /* the template objects can be part of a cycle */
       {
-        int i, j;
+        int i, j, k;
         InlineCacheRingItem *buffer;
         JSFunctionBytecode* b = (JSFunctionBytecode*)gp;
         for (i = 0; i < b->cpool_count; i++) {
@@ -648,8 +667,8 @@ void mark_children(JSRuntime* rt, JSGCObjectHeader* gp, JS_MarkFunc* mark_func)
             for (j = 0; j < IC_CACHE_ITEM_CAPACITY; j++) {
               if (buffer[j].shape)
                 mark_func(rt, &buffer[j].shape->header);
-              if (buffer[j].proto)
-                mark_func(rt, &buffer[j].proto->header);
+              for (k = 0; k < buffer[j].proto_depth; k++)
+                mark_func(rt, &buffer[j].proto_shapes[k]->header);
             }
           }
         }
@@ -683,7 +702,13 @@ void mark_children(JSRuntime* rt, JSGCObjectHeader* gp, JS_MarkFunc* mark_func)
   }
 }
 
+/* The minor collections leave the old objects out, as if the young
+   objects they reference were referenced from outside the heap. The
+   young cycles referenced by old objects stay until a full
+   collection. */
 void gc_decref_child(JSRuntime* rt, JSGCObjectHeader* p) {
+  if (rt->gc_minor && p->old)
+    return;
   assert(p->ref_count > 0);
   p->ref_count--;
   if (p->ref_count == 0 && p->mark == 1) {
@@ -701,7 +726,7 @@ void gc_decref(JSRuntime* rt) {
   /* decrement the refcount of all the children of all the GC
      objects and move the GC objects with zero refcount to
      tmp_obj_list */
-  list_for_each_safe(el, el1, &rt->gc_obj_list) {
+  list_for_each_safe(el, el1, gc_scanned_list(rt)) {
     p = list_entry(el, JSGCObjectHeader, link);
     assert(p->mark == 0);
     mark_children(rt, p, gc_decref_child);
@@ -714,31 +739,39 @@ void gc_decref(JSRuntime* rt) {
 }
 
 void gc_scan_incref_child(JSRuntime* rt, JSGCObjectHeader* p) {
+  if (rt->gc_minor && p->old)
+    return;
   p->ref_count++;
   if (p->ref_count == 1) {
     /* ref_count was 0: remove from tmp_obj_list and add at the
-       end of gc_obj_list */
+       end of the scanned list */
     list_del(&p->link);
-    list_add_tail(&p->link, &rt->gc_obj_list);
+    list_add_tail(&p->link, gc_scanned_list(rt));
     p->mark = 0; /* reset the mark for the next GC call */
   }
 }
 
 void gc_scan_incref_child2(JSRuntime* rt, JSGCObjectHeader* p) {
+  if (rt->gc_minor && p->old)
+    return;
   p->ref_count++;
 }
 
 void gc_scan(JSRuntime* rt) {
   struct list_head* el;
   JSGCObjectHeader* p;
+  uint32_t live_count = 0;
 
   /* keep the objects with a refcount > 0 and their children. */
-  list_for_each(el, &rt->gc_obj_list) {
+  list_for_each(el, gc_scanned_list(rt)) {
     p = list_entry(el, JSGCObjectHeader, link);
     assert(p->ref_count > 0);
     p->mark = 0; /* reset the mark for the next GC call */
     mark_children(rt, p, gc_scan_incref_child);
+    live_count++;
   }
+  if (!rt->gc_minor)
+    rt->gc_old_count = live_count;
 
   /* restore the refcount of the objects to be deleted. */
   list_for_each(el, &rt->tmp_obj_list) {
@@ -794,10 +827,35 @@ void gc_free_cycles(JSRuntime* rt) {
   init_list_head(&rt->gc_zero_ref_count_list);
 }
 
-void JS_RunGC(JSRuntime* rt) {
+/* move the young objects to gc_obj_list */
+static void gc_promote(JSRuntime* rt, JSGCObjectHeader* p) {
+  p->old = 1;
+  list_del(&p->link);
+  list_add_tail(&p->link, &rt->gc_obj_list);
+  rt->gc_promoted_count++;
+}
+
+static void gc_run(JSRuntime* rt, BOOL minor) {
+  struct list_head *el, *el1;
+  JSGCObjectHeader* p;
+
   /* Turn off the GC running for some special reasons. */
   if (rt->gc_off) return;
 
+  /* a full collection promotes all the young objects first, they are
+     all scanned in gc_obj_list */
+  if (!minor) {
+    list_for_each_safe(el, el1, &rt->gc_young_obj_list) {
+      gc_promote(rt, list_entry(el, JSGCObjectHeader, link));
+    }
+  }
+  rt->gc_minor = minor;
+
+  if (rt->gc_observer)
+    rt->gc_observer(rt, FALSE, rt->gc_observer_opaque);
+
+  free_ic_megamorphic_cache(rt);
+
   /* decrement the reference of the children of each object. mark =
      1 after this pass. */
   gc_decref(rt);
@@ -807,6 +865,41 @@ void JS_RunGC(JSRuntime* rt) {
 
   /* free the GC objects in a cycle */
   gc_free_cycles(rt);
+
+  if (minor) {
+    list_for_each_safe(el, el1, &rt->gc_young_obj_list) {
+      p = list_entry(el, JSGCObjectHeader, link);
+      if (++p->age >= JS_GC_PROMOTION_AGE)
+        gc_promote(rt, p);
+    }
+  } else {
+    rt->gc_promoted_count = 0;
+  }
+
+  if (rt->gc_observer)
+    rt->gc_observer(rt, TRUE, rt->gc_observer_opaque);
+  rt->gc_minor = FALSE;
+}
+
+void JS_RunGC(JSRuntime* rt) {
+  gc_run(rt, FALSE);
+}
+
+void JS_RunMinorGC(JSRuntime* rt) {
+  gc_run(rt, TRUE);
+}
+
+void js_run_triggered_gc(JSRuntime* rt) {
+  gc_run(rt, rt->gc_promoted_count < max_uint32(rt->gc_old_count, JS_GC_MIN_FULL_PROMOTIONS));
+}
+
+BOOL JS_IsMinorGC(JSRuntime* rt) {
+  return rt->gc_minor;
+}
+
+void JS_SetGCObserver(JSRuntime *rt, JSGCObserver *observer, void *opaque) {
+    rt->gc_observer = observer;
+    rt->gc_observer_opaque = opaque;
 }
 
 void JS_TurnOffGC(JSRuntime *rt) {
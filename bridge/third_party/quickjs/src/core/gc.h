@@ -91,8 +91,22 @@ void gc_free_cycles(JSRuntime* rt);
     void free_var_ref(JSRuntime* rt, JSVarRef* var_ref);
 void free_object(JSRuntime* rt, JSObject* p);
 void add_gc_object(JSRuntime* rt, JSGCObjectHeader* h, JSGCObjectTypeEnum type);
+/* gc_obj_list or gc_young_obj_list, the list holding 'h' */
+struct list_head* gc_obj_list_of(JSRuntime* rt, JSGCObjectHeader* h);
+/* iterates over the old then the young GC objects, 'gen' is an int */
+#define list_for_each_gc_obj(el, rt, gen) \
+  for (gen = 0; gen < 2; gen++)            \
+    list_for_each(el, gen ? &(rt)->gc_young_obj_list : &(rt)->gc_obj_list)
+/* the collection triggered by the allocations: a minor one, or a full
+   one once the old objects doubled since the last full collection */
+void js_run_triggered_gc(JSRuntime* rt);
 void set_cycle_flag(JSContext* ctx, JSValueConst obj);
-void remove_gc_object(JSGCObjectHeader* h);
+void remove_gc_object(JSRuntime* rt, JSGCObjectHeader* h);
+/* removes the heap snapshot id of 'h', if any, which is freed */
+void js_forget_heap_snapshot_id(JSRuntime* rt, JSGCObjectHeader* h);
+/* keeps the heap snapshot id of a GC object whose memory moved */
+void js_move_heap_snapshot_id(JSRuntime* rt, JSGCObjectHeader* old_h, JSGCObjectHeader* new_h);
+void js_free_heap_snapshot_ids(JSRuntime* rt);
 void js_regexp_finalizer(JSRuntime* rt, JSValue val);
 void js_array_buffer_finalizer(JSRuntime* rt, JSValue val);
 void js_typed_array_finalizer(JSRuntime* rt, JSValue val);
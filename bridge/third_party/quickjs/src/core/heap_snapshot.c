@@ -0,0 +1,946 @@
+/*
+ * QuickJS Javascript Engine
+ *
+ * Copyright (c) 2017-2021 Fabrice Bellard
+ * Copyright (c) 2017-2021 Charlie Gordon
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <inttypes.h>
+#include "gc.h"
+#include "object.h"
+#include "runtime.h"
+#include "shape.h"
+#include "string.h"
+
+/* The node and edge types of the DevTools heap snapshot format, in the
+   order of meta.node_types and meta.edge_types. */
+typedef enum {
+  HS_NODE_HIDDEN,
+  HS_NODE_ARRAY,
+  HS_NODE_STRING,
+  HS_NODE_OBJECT,
+  HS_NODE_CODE,
+  HS_NODE_CLOSURE,
+  HS_NODE_REGEXP,
+  HS_NODE_NUMBER,
+  HS_NODE_NATIVE,
+  HS_NODE_SYNTHETIC,
+  HS_NODE_CONCATENATED_STRING,
+  HS_NODE_SLICED_STRING,
+  HS_NODE_SYMBOL,
+  HS_NODE_BIGINT,
+  HS_NODE_OBJECT_SHAPE,
+} JSHeapSnapshotNodeType;
+
+typedef enum {
+  HS_EDGE_CONTEXT,
+  HS_EDGE_ELEMENT,
+  HS_EDGE_PROPERTY,
+  HS_EDGE_INTERNAL,
+  HS_EDGE_HIDDEN,
+  HS_EDGE_SHORTCUT,
+  HS_EDGE_WEAK,
+} JSHeapSnapshotEdgeType;
+
+/* the fields of a node, see meta.node_fields */
+#define HS_NODE_FIELD_COUNT 7
+/* the strings longer than this are cut in the node names */
+#define HS_MAX_STRING_NAME 100
+
+/* the synthetic nodes */
+#define HS_ROOT_NODE 0
+#define HS_EXTERNAL_NODE 1
+
+/* The ids of the synthetic nodes are 1 and 3, the ids of the GC objects
+   are 1 modulo 4 and the id of a native node is the id of its wrapper + 2.
+   The strings, which are not GC objects, use their address, which is
+   even. */
+#define HS_ROOT_ID 1
+#define HS_EXTERNAL_ID 3
+#define HS_FIRST_OBJECT_ID 5
+#define HS_ID_STEP 4
+#define HS_NATIVE_ID_OFFSET 2
+
+typedef struct {
+  uint8_t type;
+  uint32_t name; /* index in the strings */
+  uint64_t id;
+  size_t self_size;
+  uint32_t edge_count;
+  JSGCObjectHeader *gp; /* NULL for the strings, the native and the synthetic nodes */
+} JSHeapSnapshotNode;
+
+typedef struct {
+  uint8_t type;
+  uint32_t name_or_index; /* index in the strings, or element index */
+  uint32_t to; /* node index */
+} JSHeapSnapshotEdge;
+
+typedef struct {
+  const void *key; /* NULL if free */
+  uint32_t node;
+} JSHeapSnapshotEntry;
+
+typedef struct {
+  const JSGCObjectHeader *key; /* NULL if free */
+  uint64_t id;
+} JSHeapSnapshotIdEntry;
+
+/* The ids of the GC objects are kept between the snapshots of a runtime,
+   so that an object has the same id in all of them. The entry of an object
+   is removed when it is freed, an object allocated at the same address
+   gets a new id. */
+typedef struct JSHeapSnapshotIds {
+  JSHeapSnapshotIdEntry *entries;
+  uint32_t size; /* power of two */
+  uint32_t count;
+  uint64_t next_id;
+} JSHeapSnapshotIds;
+
+typedef struct JSHeapSnapshot {
+  JSRuntime *rt;
+  JSNativeObjectSize *native_size;
+  BOOL failed;
+
+  JSHeapSnapshotNode *nodes;
+  uint32_t node_count;
+  uint32_t node_size;
+  JSHeapSnapshotEdge *edges;
+  uint32_t edge_count;
+  uint32_t edge_size;
+  /* node index of the GC objects, the strings and the native objects by
+     address */
+  JSHeapSnapshotEntry *node_hash;
+  uint32_t node_hash_size; /* power of two */
+
+  /* the escaped JSON text of the strings, separated by a NUL */
+  DynBuf string_buf;
+  uint32_t *string_offsets;
+  uint32_t string_count;
+  uint32_t string_size;
+  uint32_t *string_hash; /* string index + 1, 0 if free */
+  uint32_t string_hash_size; /* power of two */
+  DynBuf name_buf;
+
+  /* number of references from the other GC objects, indexed by node */
+  uint32_t *incoming;
+  BOOL counting;
+  /* the edges recorded by hs_mark_func() */
+  uint32_t mark_from;
+  uint8_t mark_edge_type;
+  uint32_t mark_edge_name;
+  uint32_t mark_edge_index;
+} JSHeapSnapshot;
+
+static void *hs_realloc(JSHeapSnapshot *s, void *ptr, size_t size) {
+  void *new_ptr = js_realloc_rt(s->rt, ptr, size);
+  if (!new_ptr)
+    s->failed = TRUE;
+  return new_ptr;
+}
+
+static uint32_t hs_hash_pointer(const void *key, uint32_t hash_size) {
+  uint64_t h = (uintptr_t)key;
+  h = (h >> 3) * 0x9E3779B97F4A7C15ULL;
+  return (uint32_t)(h >> 32) & (hash_size - 1);
+}
+
+static int hs_find_node(JSHeapSnapshot *s, const void *key) {
+  uint32_t h;
+  if (s->node_hash_size == 0)
+    return -1;
+  h = hs_hash_pointer(key, s->node_hash_size);
+  while (s->node_hash[h].key) {
+    if (s->node_hash[h].key == key)
+      return s->node_hash[h].node;
+    h = (h + 1) & (s->node_hash_size - 1);
+  }
+  return -1;
+}
+
+static void hs_insert_node(JSHeapSnapshot *s, const void *key, uint32_t node) {
+  uint32_t h = hs_hash_pointer(key, s->node_hash_size);
+  while (s->node_hash[h].key)
+    h = (h + 1) & (s->node_hash_size - 1);
+  s->node_hash[h].key = key;
+  s->node_hash[h].node = node;
+}
+
+/* the hash table is kept at most half full */
+static int hs_reserve_node_hash(JSHeapSnapshot *s, uint32_t count) {
+  JSHeapSnapshotEntry *old_hash = s->node_hash;
+  uint32_t old_size = s->node_hash_size, new_size, i;
+
+  if (count * 2 <= old_size)
+    return 0;
+  new_size = old_size ? old_size : 1024;
+  while (new_size < count * 2)
+    new_size *= 2;
+  s->node_hash = js_mallocz_rt(s->rt, sizeof(s->node_hash[0]) * new_size);
+  if (!s->node_hash) {
+    s->node_hash = old_hash;
+    s->failed = TRUE;
+    return -1;
+  }
+  s->node_hash_size = new_size;
+  for (i = 0; i < old_size; i++) {
+    if (old_hash[i].key)
+      hs_insert_node(s, old_hash[i].key, old_hash[i].node);
+  }
+  js_free_rt(s->rt, old_hash);
+  return 0;
+}
+
+/* the table of the ids is kept at most half full */
+static int hs_reserve_ids(JSHeapSnapshot *s, uint32_t count) {
+  JSRuntime *rt = s->rt;
+  JSHeapSnapshotIds *ids = rt->heap_snapshot_ids;
+  JSHeapSnapshotIdEntry *old_entries, *entries;
+  uint32_t old_size, new_size, i, h;
+
+  if (!ids) {
+    ids = js_mallocz_rt(rt, sizeof(*ids));
+    if (!ids) {
+      s->failed = TRUE;
+      return -1;
+    }
+    ids->next_id = HS_FIRST_OBJECT_ID;
+    rt->heap_snapshot_ids = ids;
+  }
+  if (count * 2 <= ids->size)
+    return 0;
+  old_entries = ids->entries;
+  old_size = ids->size;
+  new_size = old_size ? old_size : 1024;
+  while (new_size < count * 2)
+    new_size *= 2;
+  entries = js_mallocz_rt(rt, sizeof(entries[0]) * new_size);
+  if (!entries) {
+    s->failed = TRUE;
+    return -1;
+  }
+  for (i = 0; i < old_size; i++) {
+    if (!old_entries[i].key)
+      continue;
+    h = hs_hash_pointer(old_entries[i].key, new_size);
+    while (entries[h].key)
+      h = (h + 1) & (new_size - 1);
+    entries[h] = old_entries[i];
+  }
+  js_free_rt(rt, old_entries);
+  ids->entries = entries;
+  ids->size = new_size;
+  return 0;
+}
+
+/* Returns the id of 'gp', 0 on memory error. */
+static uint64_t hs_object_id(JSHeapSnapshot *s, JSGCObjectHeader *gp) {
+  JSHeapSnapshotIds *ids;
+  uint32_t h;
+
+  if (hs_reserve_ids(s, (s->rt->heap_snapshot_ids ? s->rt->heap_snapshot_ids->count : 0) + 1))
+    return 0;
+  ids = s->rt->heap_snapshot_ids;
+  h = hs_hash_pointer(gp, ids->size);
+  while (ids->entries[h].key) {
+    if (ids->entries[h].key == gp)
+      return ids->entries[h].id;
+    h = (h + 1) & (ids->size - 1);
+  }
+  ids->entries[h].key = gp;
+  ids->entries[h].id = ids->next_id;
+  ids->next_id += HS_ID_STEP;
+  ids->count++;
+  return ids->entries[h].id;
+}
+
+/* Returns the id that 'gp' had, 0 if it had none. */
+static uint64_t hs_remove_id(JSHeapSnapshotIds *ids, JSGCObjectHeader *gp) {
+  uint32_t mask = ids->size - 1, hole, i, h;
+  uint64_t id;
+
+  hole = hs_hash_pointer(gp, ids->size);
+  while (ids->entries[hole].key != gp) {
+    if (!ids->entries[hole].key)
+      return 0;
+    hole = (hole + 1) & mask;
+  }
+  id = ids->entries[hole].id;
+  /* the following entries of the cluster move back to the hole unless
+     they would come before their hash */
+  for (i = (hole + 1) & mask; ids->entries[i].key; i = (i + 1) & mask) {
+    h = hs_hash_pointer(ids->entries[i].key, ids->size);
+    if (hole < i ? (h > hole && h <= i) : (h > hole || h <= i))
+      continue;
+    ids->entries[hole] = ids->entries[i];
+    hole = i;
+  }
+  ids->entries[hole].key = NULL;
+  ids->count--;
+  return id;
+}
+
+void js_forget_heap_snapshot_id(JSRuntime *rt, JSGCObjectHeader *gp) {
+  hs_remove_id(rt->heap_snapshot_ids, gp);
+}
+
+void js_move_heap_snapshot_id(JSRuntime *rt, JSGCObjectHeader *old_gp, JSGCObjectHeader *new_gp) {
+  JSHeapSnapshotIds *ids = rt->heap_snapshot_ids;
+  uint64_t id;
+  uint32_t h;
+
+  id = hs_remove_id(ids, old_gp);
+  if (!id)
+    return;
+  /* a slot was just freed, so there is room for the new address */
+  h = hs_hash_pointer(new_gp, ids->size);
+  while (ids->entries[h].key && ids->entries[h].key != new_gp)
+    h = (h + 1) & (ids->size - 1);
+  if (!ids->entries[h].key)
+    ids->count++;
+  ids->entries[h].key = new_gp;
+  ids->entries[h].id = id;
+}
+
+void js_free_heap_snapshot_ids(JSRuntime *rt) {
+  if (!rt->heap_snapshot_ids)
+    return;
+  js_free_rt(rt, rt->heap_snapshot_ids->entries);
+  js_free_rt(rt, rt->heap_snapshot_ids);
+  rt->heap_snapshot_ids = NULL;
+}
+
+static uint32_t hs_hash_string(const char *str, size_t len, uint32_t hash_size) {
+  uint32_t h = 2166136261u;
+  size_t i;
+  for (i = 0; i < len; i++)
+    h = (h ^ (uint8_t)str[i]) * 16777619u;
+  return h & (hash_size - 1);
+}
+
+/* Returns the index of the escaped JSON text 'str' in the strings. */
+static uint32_t hs_intern(JSHeapSnapshot *s, const char *str, size_t len) {
+  uint32_t h, i, index, *new_hash;
+  const char *entry;
+
+  if (!str)
+    str = "";
+  if ((s->string_count + 1) * 2 > s->string_hash_size) {
+    uint32_t new_size = s->string_hash_size ? s->string_hash_size * 2 : 1024;
+    new_hash = js_mallocz_rt(s->rt, sizeof(new_hash[0]) * new_size);
+    if (!new_hash) {
+      s->failed = TRUE;
+      return 0;
+    }
+    for (i = 0; i < s->string_count; i++) {
+      entry = (const char *)s->string_buf.buf + s->string_offsets[i];
+      h = hs_hash_string(entry, strlen(entry), new_size);
+      while (new_hash[h])
+        h = (h + 1) & (new_size - 1);
+      new_hash[h] = i + 1;
+    }
+    js_free_rt(s->rt, s->string_hash);
+    s->string_hash = new_hash;
+    s->string_hash_size = new_size;
+  }
+
+  h = hs_hash_string(str, len, s->string_hash_size);
+  while (s->string_hash[h]) {
+    index = s->string_hash[h] - 1;
+    entry = (const char *)s->string_buf.buf + s->string_offsets[index];
+    if (strncmp(entry, str, len) == 0 && entry[len] == '\0')
+      return index;
+    h = (h + 1) & (s->string_hash_size - 1);
+  }
+
+  if (s->string_count >= s->string_size) {
+    uint32_t new_size = s->string_size ? s->string_size * 2 : 1024;
+    uint32_t *new_offsets = hs_realloc(s, s->string_offsets, sizeof(new_offsets[0]) * new_size);
+    if (!new_offsets)
+      return 0;
+    s->string_offsets = new_offsets;
+    s->string_size = new_size;
+  }
+  index = s->string_count;
+  s->string_offsets[index] = s->string_buf.size;
+  if (dbuf_put(&s->string_buf, (const uint8_t *)str, len) || dbuf_putc(&s->string_buf, '\0')) {
+    s->failed = TRUE;
+    return 0;
+  }
+  s->string_count++;
+  s->string_hash[h] = index + 1;
+  return index;
+}
+
+static void hs_escape_char(DynBuf *b, uint32_t c) {
+  if (c == '"' || c == '\\') {
+    dbuf_putc(b, '\\');
+    dbuf_putc(b, c);
+  } else if (c >= 0x20 && c < 0x7f) {
+    dbuf_putc(b, c);
+  } else {
+    dbuf_printf(b, "\\u%04x", c);
+  }
+}
+
+static void hs_escape_cstring(DynBuf *b, const char *str) {
+  while (*str)
+    hs_escape_char(b, (uint8_t)*str++);
+}
+
+/* The code units are escaped one by one so that the text stays valid
+   JSON with lone surrogates. */
+static void hs_escape_string(DynBuf *b, JSString *p, uint32_t max_len) {
+  uint32_t i, len = p->len;
+  if (len > max_len)
+    len = max_len;
+  for (i = 0; i < len; i++)
+    hs_escape_char(b, p->is_wide_char ? p->u.str16[i] : p->u.str8[i]);
+  if (len < p->len)
+    dbuf_putstr(b, "...");
+}
+
+static uint32_t hs_intern_name(JSHeapSnapshot *s) {
+  uint32_t index;
+  if (s->name_buf.error) {
+    s->failed = TRUE;
+    return 0;
+  }
+  index = hs_intern(s, (const char *)s->name_buf.buf, s->name_buf.size);
+  s->name_buf.size = 0;
+  return index;
+}
+
+static uint32_t hs_cstring(JSHeapSnapshot *s, const char *str) {
+  hs_escape_cstring(&s->name_buf, str);
+  return hs_intern_name(s);
+}
+
+static uint32_t hs_atom(JSHeapSnapshot *s, const char *prefix, JSAtom atom) {
+  JSString *p;
+  if (prefix)
+    hs_escape_cstring(&s->name_buf, prefix);
+  if (__JS_AtomIsTaggedInt(atom)) {
+    dbuf_printf(&s->name_buf, "%u", __JS_AtomToUInt32(atom));
+  } else if (atom != JS_ATOM_NULL) {
+    p = s->rt->atom_array[atom];
+    if (p->atom_type == JS_ATOM_TYPE_SYMBOL) {
+      dbuf_putstr(&s->name_buf, "<symbol ");
+      hs_escape_string(&s->name_buf, p, HS_MAX_STRING_NAME);
+      dbuf_putc(&s->name_buf, '>');
+    } else {
+      hs_escape_string(&s->name_buf, p, HS_MAX_STRING_NAME);
+    }
+  }
+  return hs_intern_name(s);
+}
+
+static int hs_add_node(JSHeapSnapshot *s, const void *key, JSHeapSnapshotNodeType type, uint32_t name,
+                       uint64_t id, size_t self_size, JSGCObjectHeader *gp) {
+  JSHeapSnapshotNode *node;
+  if (s->node_count >= s->node_size) {
+    uint32_t new_size = s->node_size ? s->node_size * 2 : 1024;
+    JSHeapSnapshotNode *new_nodes = hs_realloc(s, s->nodes, sizeof(new_nodes[0]) * new_size);
+    if (!new_nodes)
+      return -1;
+    s->nodes = new_nodes;
+    s->node_size = new_size;
+  }
+  if (key) {
+    if (hs_reserve_node_hash(s, s->node_count + 1))
+      return -1;
+    hs_insert_node(s, key, s->node_count);
+  }
+  node = &s->nodes[s->node_count];
+  node->type = type;
+  node->name = name;
+  node->id = id;
+  node->self_size = self_size;
+  node->edge_count = 0;
+  node->gp = gp;
+  return s->node_count++;
+}
+
+/* The edges are grouped by node, 'from' is the last node with edges. */
+static void hs_add_edge(JSHeapSnapshot *s, uint32_t from, JSHeapSnapshotEdgeType type, uint32_t name_or_index,
+                        uint32_t to) {
+  JSHeapSnapshotEdge *edge;
+  if (s->edge_count >= s->edge_size) {
+    uint32_t new_size = s->edge_size ? s->edge_size * 2 : 4096;
+    JSHeapSnapshotEdge *new_edges = hs_realloc(s, s->edges, sizeof(new_edges[0]) * new_size);
+    if (!new_edges)
+      return;
+    s->edges = new_edges;
+    s->edge_size = new_size;
+  }
+  edge = &s->edges[s->edge_count++];
+  edge->type = type;
+  edge->name_or_index = name_or_index;
+  edge->to = to;
+  s->nodes[from].edge_count++;
+}
+
+/* The strings are not GC objects, they get a node when they are first
+   referenced. */
+static int hs_string_node(JSHeapSnapshot *s, JSString *p) {
+  int node = hs_find_node(s, p);
+  if (node >= 0)
+    return node;
+  hs_escape_string(&s->name_buf, p, HS_MAX_STRING_NAME);
+  return hs_add_node(s, p, HS_NODE_STRING, hs_intern_name(s), (uintptr_t)p,
+                     sizeof(JSString) + (p->len << p->is_wide_char) + 1 - p->is_wide_char, NULL);
+}
+
+static void hs_add_value_edge(JSHeapSnapshot *s, uint32_t from, JSHeapSnapshotEdgeType type, uint32_t name_or_index,
+                              JSValueConst val) {
+  int to;
+  switch (JS_VALUE_GET_TAG(val)) {
+    case JS_TAG_OBJECT:
+    case JS_TAG_FUNCTION_BYTECODE:
+      to = hs_find_node(s, JS_VALUE_GET_PTR(val));
+      break;
+    case JS_TAG_STRING:
+      to = hs_string_node(s, JS_VALUE_GET_STRING(val));
+      break;
+    default:
+      return;
+  }
+  if (to >= 0)
+    hs_add_edge(s, from, type, name_or_index, to);
+}
+
+static void hs_mark_func(JSRuntime *rt, JSGCObjectHeader *gp) {
+  JSHeapSnapshot *s = rt->heap_snapshot;
+  int to = hs_find_node(s, gp);
+  if (to < 0)
+    return;
+  if (s->counting) {
+    s->incoming[to]++;
+  } else if (s->mark_edge_type == HS_EDGE_ELEMENT || s->mark_edge_type == HS_EDGE_HIDDEN) {
+    hs_add_edge(s, s->mark_from, s->mark_edge_type, s->mark_edge_index++, to);
+  } else {
+    hs_add_edge(s, s->mark_from, s->mark_edge_type, s->mark_edge_name, to);
+  }
+}
+
+/* The next references marked by hs_mark_func() are edges of 'from'. */
+static void hs_begin_marking(JSHeapSnapshot *s, uint32_t from, JSHeapSnapshotEdgeType type, uint32_t name) {
+  s->mark_from = from;
+  s->mark_edge_type = type;
+  s->mark_edge_name = name;
+  s->mark_edge_index = 0;
+}
+
+static JSShapeProperty *hs_own_value(JSObject *p, JSAtom atom, int tag, JSProperty **ppr) {
+  JSShapeProperty *prs = find_own_property(ppr, p, atom);
+  if (!prs || (prs->flags & JS_PROP_TMASK) || JS_VALUE_GET_TAG((*ppr)->u.value) != tag)
+    return NULL;
+  return prs;
+}
+
+static uint32_t hs_object_name(JSHeapSnapshot *s, JSObject *p) {
+  JSProperty *pr;
+  JSObject *proto = p->shape->proto;
+
+  if (js_class_has_bytecode(p->class_id) && p->u.func.function_bytecode) {
+    JSAtom name = p->u.func.function_bytecode->func_name;
+    if (name == JS_ATOM_NULL || name == JS_ATOM_empty_string)
+      return hs_cstring(s, "(anonymous)");
+    return hs_atom(s, NULL, name);
+  }
+  switch (p->class_id) {
+    case JS_CLASS_OBJECT:
+      /* the name of the constructor of the prototype, as DevTools does */
+      if (proto && hs_own_value(proto, JS_ATOM_constructor, JS_TAG_OBJECT, &pr) &&
+          hs_own_value(JS_VALUE_GET_OBJ(pr->u.value), JS_ATOM_name, JS_TAG_STRING, &pr) &&
+          JS_VALUE_GET_STRING(pr->u.value)->len > 0) {
+        hs_escape_string(&s->name_buf, JS_VALUE_GET_STRING(pr->u.value), HS_MAX_STRING_NAME);
+        return hs_intern_name(s);
+      }
+      return hs_cstring(s, "Object");
+    case JS_CLASS_C_FUNCTION:
+    case JS_CLASS_C_FUNCTION_DATA:
+    case JS_CLASS_BOUND_FUNCTION:
+      if (hs_own_value(p, JS_ATOM_name, JS_TAG_STRING, &pr) && JS_VALUE_GET_STRING(pr->u.value)->len > 0) {
+        hs_escape_string(&s->name_buf, JS_VALUE_GET_STRING(pr->u.value), HS_MAX_STRING_NAME);
+        return hs_intern_name(s);
+      }
+      return hs_cstring(s, "(anonymous)");
+    default:
+      return hs_atom(s, NULL, s->rt->class_array[p->class_id].class_name);
+  }
+}
+
+static JSHeapSnapshotNodeType hs_object_type(JSObject *p) {
+  switch (p->class_id) {
+    case JS_CLASS_BYTECODE_FUNCTION:
+    case JS_CLASS_GENERATOR_FUNCTION:
+    case JS_CLASS_ASYNC_FUNCTION:
+    case JS_CLASS_ASYNC_GENERATOR_FUNCTION:
+    case JS_CLASS_C_FUNCTION:
+    case JS_CLASS_C_FUNCTION_DATA:
+    case JS_CLASS_BOUND_FUNCTION:
+      return HS_NODE_CLOSURE;
+    case JS_CLASS_REGEXP:
+      return HS_NODE_REGEXP;
+    default:
+      return HS_NODE_OBJECT;
+  }
+}
+
+static size_t hs_object_size(JSObject *p) {
+  size_t size = sizeof(JSObject);
+  if (p->prop)
+    size += p->shape->prop_size * sizeof(*p->prop);
+  switch (p->class_id) {
+    case JS_CLASS_ARRAY:
+    case JS_CLASS_ARGUMENTS:
+      if (p->fast_array)
+        size += p->u.array.count * sizeof(*p->u.array.u.values);
+      break;
+    case JS_CLASS_BYTECODE_FUNCTION:
+    case JS_CLASS_GENERATOR_FUNCTION:
+    case JS_CLASS_ASYNC_FUNCTION:
+    case JS_CLASS_ASYNC_GENERATOR_FUNCTION:
+      if (p->u.func.var_refs && p->u.func.function_bytecode)
+        size += p->u.func.function_bytecode->closure_var_count * sizeof(*p->u.func.var_refs);
+      break;
+    case JS_CLASS_ARRAY_BUFFER:
+      if (p->u.array_buffer)
+        size += p->u.array_buffer->byte_length;
+      break;
+  }
+  return size;
+}
+
+/* as JS_ComputeMemoryUsage() counts them */
+static size_t hs_bytecode_size(JSFunctionBytecode *b) {
+  size_t size = offsetof(JSFunctionBytecode, debug);
+  if (b->vardefs)
+    size += (b->arg_count + b->var_count) * sizeof(*b->vardefs);
+  size += b->cpool_count * sizeof(*b->cpool);
+  size += b->closure_var_count * sizeof(*b->closure_var);
+  if (!b->read_only_bytecode && b->byte_code_buf)
+    size += b->byte_code_len;
+  if (b->has_debug) {
+    size += sizeof(*b) - offsetof(JSFunctionBytecode, debug);
+    if (b->debug.source)
+      size += b->debug.source_len + 1;
+    size += b->debug.pc2line_len + b->debug.pc2column_len;
+  }
+  return size;
+}
+
+static void hs_add_gc_node(JSHeapSnapshot *s, JSGCObjectHeader *gp) {
+  JSRuntime *rt = s->rt;
+  uint64_t id = hs_object_id(s, gp);
+  int node;
+
+  if (!id)
+    return;
+
+  switch (gp->gc_obj_type) {
+    case JS_GC_OBJ_TYPE_JS_OBJECT: {
+      JSObject *p = (JSObject *)gp;
+      size_t native_size;
+      node = hs_add_node(s, gp, hs_object_type(p), hs_object_name(s, p), id, hs_object_size(p), gp);
+      /* the native node follows its wrapper */
+      if (node >= 0 && p->class_id >= JS_CLASS_INIT_COUNT && p->u.opaque && s->native_size) {
+        native_size = s->native_size(rt, JS_MKPTR(JS_TAG_OBJECT, p));
+        if (native_size > 0) {
+          hs_add_node(s, p->u.opaque, HS_NODE_NATIVE, s->nodes[node].name, id + HS_NATIVE_ID_OFFSET,
+                      native_size, NULL);
+        }
+      }
+    } break;
+    case JS_GC_OBJ_TYPE_FUNCTION_BYTECODE: {
+      JSFunctionBytecode *b = (JSFunctionBytecode *)gp;
+      uint32_t name;
+      if (b->func_name == JS_ATOM_NULL || b->func_name == JS_ATOM_empty_string)
+        name = hs_cstring(s, "(anonymous)");
+      else
+        name = hs_atom(s, NULL, b->func_name);
+      hs_add_node(s, gp, HS_NODE_CODE, name, id, hs_bytecode_size(b), gp);
+    } break;
+    case JS_GC_OBJ_TYPE_SHAPE: {
+      JSShape *sh = (JSShape *)gp;
+      hs_add_node(s, gp, HS_NODE_OBJECT_SHAPE, hs_cstring(s, "(object shape)"), id,
+                  get_shape_size(sh->prop_hash_mask + 1, sh->prop_size), gp);
+    } break;
+    case JS_GC_OBJ_TYPE_VAR_REF:
+      hs_add_node(s, gp, HS_NODE_HIDDEN, hs_cstring(s, "(closure variable)"), id, sizeof(JSVarRef), gp);
+      break;
+    case JS_GC_OBJ_TYPE_ASYNC_FUNCTION:
+      hs_add_node(s, gp, HS_NODE_HIDDEN, hs_cstring(s, "(async function)"), id, sizeof(JSAsyncFunctionData), gp);
+      break;
+    case JS_GC_OBJ_TYPE_JS_CONTEXT:
+      hs_add_node(s, gp, HS_NODE_HIDDEN, hs_cstring(s, "(realm)"), id,
+                  sizeof(JSContext) + sizeof(JSValue) * rt->class_count, gp);
+      break;
+    default:
+      hs_add_node(s, gp, HS_NODE_HIDDEN, hs_cstring(s, "(gc object)"), id, 0, gp);
+      break;
+  }
+}
+
+static void hs_add_node_edge(JSHeapSnapshot *s, uint32_t from, JSHeapSnapshotEdgeType type, uint32_t name,
+                             const void *ptr) {
+  int to = hs_find_node(s, ptr);
+  if (to >= 0)
+    hs_add_edge(s, from, type, name, to);
+}
+
+static void hs_add_object_edges(JSHeapSnapshot *s, uint32_t node, JSObject *p) {
+  JSRuntime *rt = s->rt;
+  JSShape *sh = p->shape;
+  JSShapeProperty *prs;
+  JSProperty *pr;
+  JSClassGCMark *gc_mark;
+  int i;
+
+  hs_add_node_edge(s, node, HS_EDGE_INTERNAL, hs_cstring(s, "map"), sh);
+  for (i = 0, prs = get_shape_prop(sh); i < sh->prop_count; i++, prs++) {
+    pr = &p->prop[i];
+    if (prs->atom == JS_ATOM_NULL)
+      continue;
+    switch (prs->flags & JS_PROP_TMASK) {
+      case 0:
+        if (__JS_AtomIsTaggedInt(prs->atom))
+          hs_add_value_edge(s, node, HS_EDGE_ELEMENT, __JS_AtomToUInt32(prs->atom), pr->u.value);
+        else
+          hs_add_value_edge(s, node, HS_EDGE_PROPERTY, hs_atom(s, NULL, prs->atom), pr->u.value);
+        break;
+      case JS_PROP_GETSET:
+        if (pr->u.getset.getter)
+          hs_add_node_edge(s, node, HS_EDGE_INTERNAL, hs_atom(s, "get ", prs->atom), pr->u.getset.getter);
+        if (pr->u.getset.setter)
+          hs_add_node_edge(s, node, HS_EDGE_INTERNAL, hs_atom(s, "set ", prs->atom), pr->u.getset.setter);
+        break;
+      case JS_PROP_VARREF:
+        if (pr->u.var_ref->is_detached)
+          hs_add_node_edge(s, node, HS_EDGE_PROPERTY, hs_atom(s, NULL, prs->atom), pr->u.var_ref);
+        break;
+    }
+  }
+
+  switch (p->class_id) {
+    case JS_CLASS_OBJECT:
+      break;
+    case JS_CLASS_ARRAY:
+    case JS_CLASS_ARGUMENTS:
+      for (i = 0; i < p->u.array.count; i++)
+        hs_add_value_edge(s, node, HS_EDGE_ELEMENT, i, p->u.array.u.values[i]);
+      break;
+    case JS_CLASS_BYTECODE_FUNCTION:
+    case JS_CLASS_GENERATOR_FUNCTION:
+    case JS_CLASS_ASYNC_FUNCTION:
+    case JS_CLASS_ASYNC_GENERATOR_FUNCTION: {
+      JSFunctionBytecode *b = p->u.func.function_bytecode;
+      if (p->u.func.home_object)
+        hs_add_node_edge(s, node, HS_EDGE_INTERNAL, hs_cstring(s, "home_object"), p->u.func.home_object);
+      if (!b)
+        break;
+      if (p->u.func.var_refs) {
+        for (i = 0; i < b->closure_var_count; i++) {
+          JSVarRef *var_ref = p->u.func.var_refs[i];
+          if (var_ref && var_ref->is_detached)
+            hs_add_node_edge(s, node, HS_EDGE_CONTEXT, hs_atom(s, NULL, b->closure_var[i].var_name), var_ref);
+        }
+      }
+      hs_add_node_edge(s, node, HS_EDGE_INTERNAL, hs_cstring(s, "code"), b);
+    } break;
+    default:
+      gc_mark = rt->class_array[p->class_id].gc_mark;
+      if (!gc_mark)
+        break;
+      if (node + 1 < s->node_count && s->nodes[node + 1].type == HS_NODE_NATIVE && !s->nodes[node + 1].gp &&
+          s->nodes[node + 1].id == s->nodes[node].id + HS_NATIVE_ID_OFFSET) {
+        /* the references held by the native object, such as the Member<>
+           of the ScriptWrappables, are its edges */
+        hs_add_edge(s, node, HS_EDGE_INTERNAL, hs_cstring(s, "native"), node + 1);
+        hs_begin_marking(s, node + 1, HS_EDGE_INTERNAL, hs_cstring(s, "member"));
+      } else {
+        hs_begin_marking(s, node, HS_EDGE_INTERNAL, hs_cstring(s, "internal"));
+      }
+      gc_mark(rt, JS_MKPTR(JS_TAG_OBJECT, p), hs_mark_func);
+      break;
+  }
+}
+
+static void hs_add_gc_edges(JSHeapSnapshot *s, uint32_t node, JSGCObjectHeader *gp) {
+  switch (gp->gc_obj_type) {
+    case JS_GC_OBJ_TYPE_JS_OBJECT:
+      hs_add_object_edges(s, node, (JSObject *)gp);
+      break;
+    case JS_GC_OBJ_TYPE_SHAPE: {
+      JSShape *sh = (JSShape *)gp;
+      if (sh->proto)
+        hs_add_node_edge(s, node, HS_EDGE_PROPERTY, hs_cstring(s, "__proto__"), sh->proto);
+    } break;
+    case JS_GC_OBJ_TYPE_VAR_REF:
+      hs_add_value_edge(s, node, HS_EDGE_INTERNAL, hs_cstring(s, "value"), *((JSVarRef *)gp)->pvalue);
+      break;
+    case JS_GC_OBJ_TYPE_JS_CONTEXT: {
+      JSContext *ctx = (JSContext *)gp;
+      hs_add_value_edge(s, node, HS_EDGE_INTERNAL, hs_cstring(s, "global"), ctx->global_obj);
+      hs_begin_marking(s, node, HS_EDGE_HIDDEN, 0);
+      mark_children(s->rt, gp, hs_mark_func);
+    } break;
+    default:
+      hs_begin_marking(s, node, HS_EDGE_HIDDEN, 0);
+      mark_children(s->rt, gp, hs_mark_func);
+      break;
+  }
+}
+
+static void hs_write_strings(DynBuf *b, const char *const *strings, int count) {
+  int i;
+  for (i = 0; i < count; i++)
+    dbuf_printf(b, "%s\"%s\"", i ? "," : "", strings[i]);
+}
+
+static void hs_write(JSHeapSnapshot *s, DynBuf *b) {
+  static const char *const node_fields[HS_NODE_FIELD_COUNT] = {
+    "type", "name", "id", "self_size", "edge_count", "trace_node_id", "detachedness",
+  };
+  static const char *const node_types[] = {
+    "hidden", "array", "string", "object", "code", "closure", "regexp", "number",
+    "native", "synthetic", "concatenated string", "sliced string", "symbol", "bigint", "object shape",
+  };
+  static const char *const edge_fields[] = { "type", "name_or_index", "to_node" };
+  static const char *const edge_types[] = {
+    "context", "element", "property", "internal", "hidden", "shortcut", "weak",
+  };
+  static const char *const node_field_types[] = { "string", "number", "number", "number", "number", "number" };
+  uint32_t i;
+
+  dbuf_putstr(b, "{\"snapshot\":{\"meta\":{\"node_fields\":[");
+  hs_write_strings(b, node_fields, countof(node_fields));
+  dbuf_putstr(b, "],\"node_types\":[[");
+  hs_write_strings(b, node_types, countof(node_types));
+  dbuf_putstr(b, "],");
+  hs_write_strings(b, node_field_types, countof(node_field_types));
+  dbuf_putstr(b, "],\"edge_fields\":[");
+  hs_write_strings(b, edge_fields, countof(edge_fields));
+  dbuf_putstr(b, "],\"edge_types\":[[");
+  hs_write_strings(b, edge_types, countof(edge_types));
+  dbuf_putstr(b, "],\"string_or_number\",\"node\"],\"trace_function_info_fields\":[],\"trace_node_fields\":[],"
+              "\"sample_fields\":[],\"location_fields\":[]},");
+  dbuf_printf(b, "\"node_count\":%u,\"edge_count\":%u,\"trace_function_count\":0},\n\"nodes\":[", s->node_count,
+              s->edge_count);
+  for (i = 0; i < s->node_count; i++) {
+    JSHeapSnapshotNode *node = &s->nodes[i];
+    dbuf_printf(b, "%s%u,%u,%" PRIu64 ",%zu,%u,0,0\n", i ? "," : "", node->type, node->name, node->id,
+                node->self_size, node->edge_count);
+  }
+  dbuf_putstr(b, "],\n\"edges\":[");
+  for (i = 0; i < s->edge_count; i++) {
+    JSHeapSnapshotEdge *edge = &s->edges[i];
+    dbuf_printf(b, "%s%u,%u,%u\n", i ? "," : "", edge->type, edge->name_or_index, edge->to * HS_NODE_FIELD_COUNT);
+  }
+  dbuf_putstr(b, "],\n\"trace_function_infos\":[],\"trace_tree\":[],\"samples\":[],\"locations\":[],\n\"strings\":[");
+  for (i = 0; i < s->string_count; i++)
+    dbuf_printf(b, "%s\"%s\"\n", i ? "," : "", (const char *)s->string_buf.buf + s->string_offsets[i]);
+  dbuf_putstr(b, "]}\n");
+}
+
+char *JS_WriteHeapSnapshot(JSRuntime *rt, JSNativeObjectSize *native_size, size_t *psize) {
+  JSHeapSnapshot snapshot = { 0 }, *s = &snapshot;
+  struct list_head *el;
+  uint32_t i, gc_node_count, index;
+  int gen;
+  DynBuf b;
+
+  s->rt = rt;
+  s->native_size = native_size;
+  dbuf_init2(&s->string_buf, rt, (DynBufReallocFunc *)js_realloc_rt);
+  dbuf_init2(&s->name_buf, rt, (DynBufReallocFunc *)js_realloc_rt);
+  dbuf_init2(&b, rt, (DynBufReallocFunc *)js_realloc_rt);
+  rt->heap_snapshot = s;
+
+  /* DevTools expects the root first */
+  hs_add_node(s, NULL, HS_NODE_SYNTHETIC, hs_cstring(s, ""), HS_ROOT_ID, 0, NULL);
+  hs_add_node(s, NULL, HS_NODE_SYNTHETIC, hs_cstring(s, "(external references)"), HS_EXTERNAL_ID, 0, NULL);
+  list_for_each_gc_obj(el, rt, gen) {
+    hs_add_gc_node(s, list_entry(el, JSGCObjectHeader, link));
+  }
+  gc_node_count = s->node_count;
+  if (s->failed)
+    goto done;
+
+  /* The references which do not come from the other GC objects are held
+     by the host or the stack, as gc_decref() finds them. The realms are
+     roots, the other objects are held by "(external references)". */
+  s->incoming = js_mallocz_rt(rt, sizeof(s->incoming[0]) * gc_node_count);
+  if (!s->incoming) {
+    s->failed = TRUE;
+    goto done;
+  }
+  s->counting = TRUE;
+  for (i = 0; i < gc_node_count; i++) {
+    if (s->nodes[i].gp)
+      mark_children(rt, s->nodes[i].gp, hs_mark_func);
+  }
+  s->counting = FALSE;
+
+  index = 0;
+  for (i = 0; i < gc_node_count; i++) {
+    JSGCObjectHeader *gp = s->nodes[i].gp;
+    if (gp && gp->gc_obj_type == JS_GC_OBJ_TYPE_JS_CONTEXT && gp->ref_count > s->incoming[i])
+      hs_add_edge(s, HS_ROOT_NODE, HS_EDGE_ELEMENT, index++, i);
+  }
+  hs_add_edge(s, HS_ROOT_NODE, HS_EDGE_ELEMENT, index, HS_EXTERNAL_NODE);
+  index = 0;
+  for (i = 0; i < gc_node_count; i++) {
+    JSGCObjectHeader *gp = s->nodes[i].gp;
+    if (gp && gp->gc_obj_type != JS_GC_OBJ_TYPE_JS_CONTEXT && gp->ref_count > s->incoming[i])
+      hs_add_edge(s, HS_EXTERNAL_NODE, HS_EDGE_ELEMENT, index++, i);
+  }
+
+  /* the string nodes are added after the GC objects, without edges */
+  for (i = 0; i < gc_node_count && !s->failed; i++) {
+    if (s->nodes[i].gp)
+      hs_add_gc_edges(s, i, s->nodes[i].gp);
+  }
+  if (s->failed)
+    goto done;
+
+  hs_write(s, &b);
+
+done:
+  rt->heap_snapshot = NULL;
+  js_free_rt(rt, s->incoming);
+  js_free_rt(rt, s->nodes);
+  js_free_rt(rt, s->edges);
+  js_free_rt(rt, s->node_hash);
+  js_free_rt(rt, s->string_offsets);
+  js_free_rt(rt, s->string_hash);
+  dbuf_free(&s->string_buf);
+  dbuf_free(&s->name_buf);
+  if (s->failed || dbuf_error(&b)) {
+    dbuf_free(&b);
+    return NULL;
+  }
+  if (psize)
+    *psize = b.size;
+  dbuf_putc(&b, '\0');
+  return (char *)b.buf;
+}
@@ -24,11 +24,130 @@
  */
 
 #include "ic.h"
+#include "gc.h"
+#include "string.h"
 
 static force_inline uint32_t get_index_hash(JSAtom atom, int hash_bits) {
   return (atom * 0x9e370001) >> (32 - hash_bits);
 }
 
+static void free_ic_item(JSRuntime *rt, InlineCacheRingItem *ci) {
+  uint32_t i;
+  for (i = 0; i < ci->proto_depth; i++)
+    js_free_shape(rt, ci->proto_shapes[i]);
+  js_free_rt(rt, ci->proto_shapes);
+  js_free_shape_null(rt, ci->shape);
+  ci->shape = NULL;
+  ci->proto_shapes = NULL;
+  ci->proto_depth = 0;
+  ci->prop_offset = 0;
+  ci->prop_flags = 0;
+}
+
+static BOOL is_ic_transparent(JSRuntime *rt, JSObject *p) {
+  const JSClassExoticMethods *em;
+  if (!p->is_exotic || p->fast_array)
+    return TRUE;
+  em = rt->class_array[p->class_id].exotic;
+  return !em || (!em->get_property && !em->set_property &&
+                 (!em->get_own_property || em->own_properties_from_prototype));
+}
+
+/* return the number of prototypes from 'object' to 'holder' or -1 if
+   the lookup cannot be cached: the shapes must be hashed to be copied
+   on write and the objects before the holder must not intercept it */
+static int get_ic_proto_depth(JSRuntime *rt, JSObject *object, JSObject *holder) {
+  int depth;
+  JSObject *p;
+  if (!object->shape->is_hashed)
+    return -1;
+  if (!holder)
+    return 0;
+  depth = 0;
+  for (p = object; p != holder; p = p->shape->proto) {
+    if (!p || !is_ic_transparent(rt, p) || depth == IC_PROTO_CHAIN_MAX)
+      return -1;
+    if (p != object && !p->shape->is_hashed)
+      return -1;
+    depth++;
+  }
+  if (!holder->shape->is_hashed)
+    return -1;
+  return depth;
+}
+
+static int init_ic_item(JSRuntime *rt, InlineCacheRingItem *ci, JSObject *object,
+                        uint32_t prop_offset, JSObject *holder, int prop_flags, int depth) {
+  int i;
+  JSObject *p;
+  JSShape **proto_shapes;
+  proto_shapes = NULL;
+  if (depth > 0) {
+    proto_shapes = js_malloc_rt(rt, sizeof(proto_shapes[0]) * depth);
+    if (unlikely(!proto_shapes))
+      return -1;
+    p = object->shape->proto;
+    for (i = 0; i < depth; i++) {
+      proto_shapes[i] = js_dup_shape(p->shape);
+      p = p->shape->proto;
+    }
+  }
+  free_ic_item(rt, ci);
+  ci->shape = js_dup_shape(object->shape);
+  ci->proto_shapes = proto_shapes;
+  ci->proto_depth = depth;
+  ci->prop_offset = prop_offset;
+  ci->prop_flags = prop_flags;
+  return 0;
+}
+
+static force_inline uint32_t get_ic_megamorphic_hash(JSShape *shape, JSAtom atom) {
+  return (((uint32_t)((uintptr_t)shape >> 4) ^ atom) * 0x9e370001) >> (32 - IC_MEGAMORPHIC_CACHE_BITS);
+}
+
+InlineCacheRingItem *find_ic_megamorphic_item(JSRuntime *rt, JSShape *shape, JSAtom atom) {
+  InlineCacheMegamorphicEntry *e;
+  if (unlikely(!rt->ic_megamorphic_cache))
+    return NULL;
+  e = rt->ic_megamorphic_cache + get_ic_megamorphic_hash(shape, atom);
+  if (e->item.shape == shape && e->atom == atom)
+    return &e->item;
+  return NULL;
+}
+
+static void add_ic_megamorphic_item(JSRuntime *rt, JSAtom atom, JSObject *object,
+                                    uint32_t prop_offset, JSObject *holder, int prop_flags, int depth) {
+  InlineCacheMegamorphicEntry *e;
+  if (unlikely(!rt->ic_megamorphic_cache)) {
+    rt->ic_megamorphic_cache = js_mallocz_rt(rt, sizeof(InlineCacheMegamorphicEntry) << IC_MEGAMORPHIC_CACHE_BITS);
+    if (unlikely(!rt->ic_megamorphic_cache))
+      return;
+  }
+  e = rt->ic_megamorphic_cache + get_ic_megamorphic_hash(object->shape, atom);
+  if (init_ic_item(rt, &e->item, object, prop_offset, holder, prop_flags, depth))
+    return;
+  JS_FreeAtomRT(rt, e->atom);
+  e->atom = JS_DupAtomRT(rt, atom);
+}
+
+/* the entries keep their prototypes alive: the cache is emptied
+   before the collections so that it does not retain any cycle */
+void free_ic_megamorphic_cache(JSRuntime *rt) {
+  uint32_t i;
+  InlineCacheMegamorphicEntry *e;
+  if (!rt->ic_megamorphic_cache)
+    return;
+  for (i = 0; i < (1 << IC_MEGAMORPHIC_CACHE_BITS); i++) {
+    e = rt->ic_megamorphic_cache + i;
+    if (e->item.shape) {
+      free_ic_item(rt, &e->item);
+      JS_FreeAtomRT(rt, e->atom);
+    }
+  }
+  js_free_rt(rt, rt->ic_megamorphic_cache);
+  rt->ic_megamorphic_cache = NULL;
+}
+
 InlineCache *init_ic(JSContext *ctx) {
   InlineCache *ic;
   ic = js_malloc(ctx, sizeof(InlineCache));
@@ -43,6 +162,7 @@ InlineCache *init_ic(JSContext *ctx) {
     goto fail;
   memset(ic->hash, 0, sizeof(ic->hash[0]) * ic->capacity);
   ic->cache = NULL;
+  ic->slots = NULL;
   ic->updated = FALSE;
   ic->updated_offset = 0;
   return ic;
@@ -73,6 +193,56 @@ fail:
   return -1;
 }
 
+/* copy the slots of 'ic0' without the cached shapes, each slot keeps its index */
+InlineCache *clone_ic(JSContext *ctx, InlineCache *ic0) {
+  uint32_t i, n;
+  InlineCache *ic;
+  InlineCacheHashSlot *ch0, *ch, **pch;
+  ic = js_malloc(ctx, sizeof(InlineCache));
+  if (unlikely(!ic))
+    return NULL;
+  ic->count = 0;
+  ic->hash_bits = ic0->hash_bits;
+  ic->capacity = ic0->capacity;
+  ic->ctx = ctx;
+  ic->cache = NULL;
+  ic->slots = NULL;
+  ic->updated = FALSE;
+  ic->updated_offset = 0;
+  ic->hash = js_mallocz(ctx, sizeof(ic->hash[0]) * ic->capacity);
+  if (unlikely(!ic->hash)) {
+    js_free(ctx, ic);
+    return NULL;
+  }
+  if (ic0->count > 0) {
+    ic->cache = js_mallocz(ctx, sizeof(InlineCacheRingSlot) * ic0->count);
+    if (unlikely(!ic->cache))
+      goto fail;
+    ic->count = ic0->count;
+    for (i = 0; i < ic->count; i++)
+      ic->cache[i].atom = JS_DupAtom(ctx, ic0->cache[i].atom);
+    ic->slots = js_malloc(ctx, sizeof(InlineCacheHashSlot) * ic0->count);
+    if (unlikely(!ic->slots))
+      goto fail;
+  }
+  n = 0;
+  for (i = 0; i < ic->capacity; i++) {
+    pch = &ic->hash[i];
+    for (ch0 = ic0->hash[i]; ch0 != NULL; ch0 = ch0->next) {
+      ch = &ic->slots[n++];
+      ch->atom = JS_DupAtom(ctx, ch0->atom);
+      ch->index = ch0->index;
+      ch->next = NULL;
+      *pch = ch;
+      pch = &ch->next;
+    }
+  }
+  return ic;
+fail:
+  free_ic(ic);
+  return NULL;
+}
+
 int resize_ic_hash(InlineCache *ic) {
   uint32_t new_capacity, i, h;
   InlineCacheHashSlot *ch, *ch_next;
@@ -102,33 +272,24 @@ fail:
 int free_ic(InlineCache *ic) {
   uint32_t i, j;
   JSRuntime *rt;
-  JSShape *sh;
   InlineCacheHashSlot *ch, *ch_next;
   InlineCacheRingItem *buffer;
-  ICWatchpoint *o;
   rt = ic->ctx->rt;
   for (i = 0; i < ic->count; i++) {
     buffer = ic->cache[i].buffer;
     JS_FreeAtom(ic->ctx, ic->cache[i].atom);
-    for (j = 0; j < IC_CACHE_ITEM_CAPACITY; j++) {
-      sh = buffer[j].shape;
-      o = buffer[j].watchpoint_ref;
-      if (o) {
-        if (o->free_callback)
-          o->free_callback(rt, o->ref, o->atom);
-        list_del(&o->link);
-        js_free_rt(rt, o);
-      }
-      js_free_shape_null(rt, sh);
-    }
+    for (j = 0; j < IC_CACHE_ITEM_CAPACITY; j++)
+      free_ic_item(rt, buffer + j);
   }
   for (i = 0; i < ic->capacity; i++) {
     for (ch = ic->hash[i]; ch != NULL; ch = ch_next) {
       ch_next = ch->next;
       JS_FreeAtom(ic->ctx, ch->atom);
-      js_free(ic->ctx, ch);
+      if (ic->slots == NULL)
+        js_free(ic->ctx, ch);
     }
   }
+  js_free(ic->ctx, ic->slots);
   if (ic->count > 0)
     js_free(ic->ctx, ic->cache);
   js_free(ic->ctx, ic->hash);
@@ -138,24 +299,20 @@ int free_ic(InlineCache *ic) {
 
 #if _MSC_VER
 uint32_t add_ic_slot(InlineCache *ic, JSAtom atom, JSObject *object,
-                     uint32_t prop_offset, JSObject* prototype)
+                     uint32_t prop_offset, JSObject *holder, int prop_flags)
 #else
 force_inline uint32_t add_ic_slot(InlineCache *ic, JSAtom atom, JSObject *object,
-                                  uint32_t prop_offset, JSObject* prototype)
+                                  uint32_t prop_offset, JSObject *holder, int prop_flags)
 #endif
 {
-  int32_t i;
+  int32_t i, depth;
   uint32_t h;
   InlineCacheHashSlot *ch;
   InlineCacheRingSlot *cr;
   InlineCacheRingItem *ci;
   JSRuntime* rt;
-  JSShape *sh;
-  JSObject *proto;
   cr = NULL;
   rt = ic->ctx->rt;
-  sh = NULL;
-  proto = NULL;
   h = get_index_hash(atom, ic->hash_bits);
   for (ch = ic->hash[h]; ch != NULL; ch = ch->next)
     if (ch->atom == atom) {
@@ -164,38 +321,40 @@ force_inline uint32_t add_ic_slot(InlineCache *ic, JSAtom atom, JSObject *object
     }
 
   assert(cr != NULL);
+  depth = get_ic_proto_depth(rt, object, holder);
   i = cr->index;
   for (;;) {
     ci = cr->buffer + i;
-    if (object->shape == ci->shape && prototype == ci->proto) {
-      ci->prop_offset = prop_offset;
+    if (object->shape == ci->shape) {
+      /* the prototype chain changed */
+      if (depth < 0)
+        free_ic_item(rt, ci);
+      else
+        init_ic_item(rt, ci, object, prop_offset, holder, prop_flags, depth);
       goto end;
     }
 
     i = (i + 1) % IC_CACHE_ITEM_CAPACITY;
     if (unlikely(i == cr->index)) {
-      cr->index = (cr->index + 1) % IC_CACHE_ITEM_CAPACITY;
       break;
     }
   }
 
-  ci = cr->buffer + cr->index;
-  sh = ci->shape;
-  if (ci->watchpoint_ref)
-    // must be called before js_free_shape_null
-    js_shape_delete_watchpoints(rt, sh, ci);
-  ci->prop_offset = prop_offset;
-  ci->shape = js_dup_shape(object->shape);
-  js_free_shape_null(rt, sh);
-  if (prototype) {
-    // the atom and prototype SHOULE BE freed by watchpoint_remove/clear_callback
-    JS_DupValue(ic->ctx, JS_MKPTR(JS_TAG_OBJECT, prototype));
-    ci->proto = prototype;
-    ci->watchpoint_ref = js_shape_create_watchpoint(rt, ci->shape, (intptr_t)ci,
-                          JS_DupAtom(ic->ctx, atom),
-                          ic_watchpoint_delete_handler,
-                          ic_watchpoint_free_handler);
+  if (depth < 0)
+    goto end;
+  if (cr->megamorphic) {
+    add_ic_megamorphic_item(rt, atom, object, prop_offset, holder, prop_flags, depth);
+    goto end;
+  }
+  i = (cr->index + 1) % IC_CACHE_ITEM_CAPACITY;
+  if (cr->buffer[i].shape && ++cr->evictions >= IC_MEGAMORPHIC_EVICTIONS) {
+    /* keep the ring, its shapes are still the most likely */
+    cr->megamorphic = TRUE;
+    add_ic_megamorphic_item(rt, atom, object, prop_offset, holder, prop_flags, depth);
+    goto end;
   }
+  if (init_ic_item(rt, cr->buffer + i, object, prop_offset, holder, prop_flags, depth) == 0)
+    cr->index = i;
 end:
   return ch->index;
 }
@@ -226,87 +385,34 @@ end:
   return 0;
 }
 
-int ic_watchpoint_delete_handler(JSRuntime* rt, intptr_t ref, JSAtom atom, void* target) {
-  InlineCacheRingItem *ci;
-  ci = (InlineCacheRingItem *)ref;
-  if(ref != (intptr_t)target)
-    return 1;
-  assert(ci->proto != NULL);
-  // the shape and prop_offset WILL BE handled by add_ic_slot
-  // !!! MUST NOT CALL js_free_shape0 TO DOUBLE FREE HERE !!!
-  JS_FreeValueRT(rt, JS_MKPTR(JS_TAG_OBJECT, ci->proto));
-  JS_FreeAtomRT(rt, atom);
-  ci->watchpoint_ref = NULL;
-  ci->proto = NULL;
-  ci->prop_offset = 0;
-  ci->shape = NULL;
-  return 0;
-}
-
-int ic_watchpoint_free_handler(JSRuntime* rt, intptr_t ref, JSAtom atom) {
-  InlineCacheRingItem *ci;
-  ci = (InlineCacheRingItem *)ref;
-  assert(ci->watchpoint_ref != NULL);
-  assert(ci->proto != NULL);
-  // the watchpoint_clear_callback ONLY CAN BE called by js_free_shape0
-  // !!! MUST NOT CALL js_free_shape0 TO DOUBLE FREE HERE !!!
-  JS_FreeValueRT(rt, JS_MKPTR(JS_TAG_OBJECT, ci->proto));
-  JS_FreeAtomRT(rt, atom);
-  ci->watchpoint_ref = NULL;
-  ci->proto = NULL;
-  ci->prop_offset = 0;
-  ci->shape = NULL;
-  return 0;
-}
-
-int ic_delete_shape_proto_watchpoints(JSRuntime *rt, JSShape *shape, JSAtom atom) {
-  struct list_head *el, *el1;
-  JSObject *p;
-  JSAtom *prop;
-  InlineCacheRingItem *ci;
-  JSShape *sh;
-  p = shape->proto;
-  while(likely(p)) {
-    if (p->shape->watchpoint)
-      list_for_each_safe(el, el1, p->shape->watchpoint) {
-        ICWatchpoint *o = list_entry(el, ICWatchpoint, link);
-        if (o->atom == atom) {
-          ci = (InlineCacheRingItem *)o->ref;
-          sh = ci->shape;
-          o->delete_callback = NULL;
-          o->free_callback = NULL;
-          ic_watchpoint_free_handler(rt, o->ref, o->atom);
-          js_free_shape_null(rt, shape);
-          list_del(el);
-          js_free_rt(rt, o);
-        }
-      }
-    p = p->shape->proto;
+void JS_DumpInlineCacheStats(JSRuntime *rt, FILE *fp) {
+#ifdef CONFIG_IC_STATS
+  struct list_head *el;
+  int gen;
+  JSGCObjectHeader *gp;
+  JSFunctionBytecode *b;
+  InlineCacheRingSlot *cr;
+  uint32_t i;
+  char buf1[ATOM_GET_STR_BUF_SIZE], buf2[ATOM_GET_STR_BUF_SIZE];
+  fprintf(fp, "%-40s %-24s %10s %10s\n", "function", "property", "hits", "misses");
+  list_for_each_gc_obj(el, rt, gen) {
+    gp = list_entry(el, JSGCObjectHeader, link);
+    if (gp->gc_obj_type != JS_GC_OBJ_TYPE_FUNCTION_BYTECODE)
+      continue;
+    b = (JSFunctionBytecode *)gp;
+    if (!b->ic)
+      continue;
+    for (i = 0; i < b->ic->count; i++) {
+      cr = b->ic->cache + i;
+      if (cr->hits == 0 && cr->misses == 0)
+        continue;
+      fprintf(fp, "%-40s %-24s %10u %10u%s\n",
+              JS_AtomGetStrRT(rt, buf1, sizeof(buf1), b->func_name),
+              JS_AtomGetStrRT(rt, buf2, sizeof(buf2), cr->atom),
+              cr->hits, cr->misses, cr->megamorphic ? " megamorphic" : "");
+    }
   }
-  return 0;
+#else
+  fprintf(fp, "inline cache statistics are disabled, define CONFIG_IC_STATS to collect them\n");
+#endif
 }
-
-int ic_free_shape_proto_watchpoints(JSRuntime *rt, JSShape *shape) {
-  struct list_head *el, *el1;
-  JSObject *p;
-  JSAtom *prop;
-  InlineCacheRingItem *ci;
-  JSShape *sh;
-  p = shape->proto;
-  while(likely(p)) {
-    if (p->shape->watchpoint)
-      list_for_each_safe(el, el1, p->shape->watchpoint) {
-        ICWatchpoint *o = list_entry(el, ICWatchpoint, link);
-        ci = (InlineCacheRingItem *)o->ref;
-        sh = ci->shape;
-        o->delete_callback = NULL;
-        o->free_callback = NULL;
-        ic_watchpoint_free_handler(rt, o->ref, o->atom);
-        js_free_shape_null(rt, shape);
-        list_del(el);
-        js_free_rt(rt, o);
-      }
-    p = p->shape->proto;
-  }
-  return 0;
-}
\ No newline at end of file
@@ -32,25 +32,47 @@
 
 InlineCache *init_ic(JSContext *ctx);
 int rebuild_ic(InlineCache *ic);
+InlineCache *clone_ic(JSContext *ctx, InlineCache *ic0);
 int resize_ic_hash(InlineCache *ic);
 int free_ic(InlineCache *ic);
 uint32_t add_ic_slot(InlineCache *ic, JSAtom atom, JSObject *object,
-                     uint32_t prop_offset, JSObject* prototype);
+                     uint32_t prop_offset, JSObject *holder, int prop_flags);
 uint32_t add_ic_slot1(InlineCache *ic, JSAtom atom);
-force_inline int32_t get_ic_prop_offset(InlineCache *ic, uint32_t cache_offset,
-                                        JSShape *shape, JSObject **prototype) {
+InlineCacheRingItem *find_ic_megamorphic_item(JSRuntime *rt, JSShape *shape, JSAtom atom);
+void free_ic_megamorphic_cache(JSRuntime *rt);
+
+/* return the holder of the property if the prototype chain is unchanged */
+force_inline JSObject *get_ic_item_holder(JSObject *object, InlineCacheRingItem *ci) {
+  uint32_t i;
+  JSObject *p;
+  if (likely(ci->proto_depth == 0))
+    return object;
+  p = ci->shape->proto;
+  for (i = 0;; i++) {
+    if (unlikely(p->shape != ci->proto_shapes[i]))
+      return NULL;
+    if (i + 1 == ci->proto_depth)
+      return p;
+    p = ci->proto_shapes[i]->proto;
+  }
+}
+
+/* find the cached property of 'object', return NULL on cache miss */
+force_inline InlineCacheRingItem *get_ic_item(InlineCache *ic, uint32_t cache_offset,
+                                              JSObject *object, JSObject **holder) {
   uint32_t i;
   InlineCacheRingSlot *cr;
-  InlineCacheRingItem *buffer;
+  InlineCacheRingItem *ci;
+  JSShape *shape;
   assert(cache_offset < ic->capacity);
   cr = ic->cache + cache_offset;
+  shape = object->shape;
   i = cr->index;
   for (;;) {
-    buffer = cr->buffer + i;
-    if (likely(buffer->shape == shape)) {
+    ci = cr->buffer + i;
+    if (likely(ci->shape == shape)) {
       cr->index = i;
-      *prototype = buffer->proto;
-      return buffer->prop_offset;
+      goto found;
     }
 
     i = (i + 1) % IC_CACHE_ITEM_CAPACITY;
@@ -58,9 +80,25 @@ force_inline int32_t get_ic_prop_offset(InlineCache *ic, uint32_t cache_offset,
       break;
     }
   }
-
-  *prototype = NULL;
-  return -1;
+  if (cr->megamorphic) {
+    ci = find_ic_megamorphic_item(ic->ctx->rt, shape, cr->atom);
+    if (ci)
+      goto found;
+  }
+  goto miss;
+found:
+  *holder = get_ic_item_holder(object, ci);
+  if (likely(*holder != NULL)) {
+#ifdef CONFIG_IC_STATS
+    cr->hits++;
+#endif
+    return ci;
+  }
+miss:
+#ifdef CONFIG_IC_STATS
+  cr->misses++;
+#endif
+  return NULL;
 }
 
 force_inline JSAtom get_ic_atom(InlineCache *ic, uint32_t cache_offset) {
@@ -68,8 +106,4 @@ force_inline JSAtom get_ic_atom(InlineCache *ic, uint32_t cache_offset) {
   return ic->cache[cache_offset].atom;
 }
 
-int ic_watchpoint_delete_handler(JSRuntime* rt, intptr_t ref, JSAtom atom, void* target);
-int ic_watchpoint_free_handler(JSRuntime* rt, intptr_t ref, JSAtom atom);
-int ic_delete_shape_proto_watchpoints(JSRuntime *rt, JSShape *shape, JSAtom atom);
-int ic_free_shape_proto_watchpoints(JSRuntime *rt, JSShape *shape);
 #endif
\ No newline at end of file
@@ -25,6 +25,7 @@
 
 #include "quickjs/cutils.h"
 #include "malloc.h"
+#include "gc.h"
 #include "exception.h"
 
 void js_trigger_gc(JSRuntime* rt, size_t size) {
@@ -38,7 +39,7 @@ void js_trigger_gc(JSRuntime* rt, size_t size) {
 #ifdef DUMP_GC
     printf("GC: size=%" PRIu64 "\n", (uint64_t)rt->malloc_state.malloc_size);
 #endif
-    JS_RunGC(rt);
+    js_run_triggered_gc(rt);
     rt->malloc_gc_threshold = rt->malloc_state.malloc_size + (rt->malloc_state.malloc_size >> 1);
   }
 }
@@ -186,6 +187,72 @@ no_inline int js_realloc_array(JSContext* ctx, void** parray, int elem_size, int
   return 0;
 }
 
+#if ENABLE_MI_MALLOC
+#if defined(_MSC_VER)
+#define JS_THREAD_LOCAL __declspec(thread)
+#else
+#define JS_THREAD_LOCAL __thread
+#endif
+
+/* Every runtime allocates from its own mimalloc heap, so the memory of a
+   runtime is not interleaved with the other runtimes and is given back at
+   once when the runtime is freed. A mimalloc heap can only allocate in the
+   thread which created it, the other threads use their default heap and
+   mi_free() works from any thread. */
+typedef struct JSMallocHeap {
+  mi_heap_t* heap;
+  const void* owner;
+} JSMallocHeap;
+
+/* its address identifies the current thread */
+static JS_THREAD_LOCAL char js_thread_token;
+
+void* js_def_heap_new(void) {
+  JSMallocHeap* h = mi_malloc(sizeof(JSMallocHeap));
+  if (!h)
+    return NULL;
+  h->heap = mi_heap_new();
+  if (!h->heap) {
+    mi_free(h);
+    return NULL;
+  }
+  h->owner = &js_thread_token;
+  return h;
+}
+
+void js_def_heap_delete(void* opaque) {
+  JSMallocHeap* h = opaque;
+  if (!h)
+    return;
+  /* the blocks still allocated, like the detached ones, move to the
+     default heap. A heap of another thread is left to mimalloc, which
+     reclaims it when that thread exits. */
+  if (h->owner == &js_thread_token)
+    mi_heap_delete(h->heap);
+  mi_free(h);
+}
+
+static inline void* js_def_heap_malloc(JSMallocState* s, size_t size) {
+  JSMallocHeap* h = s->opaque;
+  if (h && h->owner == &js_thread_token)
+    return mi_heap_malloc(h->heap, size);
+  return mi_malloc(size);
+}
+
+static inline void* js_def_heap_realloc(JSMallocState* s, void* ptr, size_t size) {
+  JSMallocHeap* h = s->opaque;
+  if (h && h->owner == &js_thread_token)
+    return mi_heap_realloc(h->heap, ptr, size);
+  return mi_realloc(ptr, size);
+}
+#else
+void* js_def_heap_new(void) {
+  return NULL;
+}
+
+void js_def_heap_delete(void* opaque) {}
+#endif
+
 void* js_def_malloc(JSMallocState* s, size_t size) {
   void* ptr;
 
@@ -196,7 +263,7 @@ void* js_def_malloc(JSMallocState* s, size_t size) {
     return NULL;
 
 #if ENABLE_MI_MALLOC
-  ptr = mi_malloc(size);
+  ptr = js_def_heap_malloc(s, size);
 #else
   ptr = malloc(size);
 #endif
@@ -245,7 +312,7 @@ void* js_def_realloc(JSMallocState* s, void* ptr, size_t size) {
     return NULL;
 
 #if ENABLE_MI_MALLOC
-  ptr = mi_realloc(ptr, size);
+  ptr = js_def_heap_realloc(s, ptr, size);
 #else
   ptr = realloc(ptr, size);
 #endif
@@ -260,4 +327,15 @@ void* js_def_realloc(JSMallocState* s, void* ptr, size_t size) {
 void JS_SetGCThreshold(JSRuntime *rt, size_t gc_threshold)
 {
   rt->malloc_gc_threshold = gc_threshold;
+}
+
+size_t JS_GetGCThreshold(JSRuntime *rt)
+{
+  return rt->malloc_gc_threshold;
+}
+
+/* the bytes allocated by the runtime, the size compared to the GC threshold */
+size_t JS_GetMallocSize(JSRuntime *rt)
+{
+  return rt->malloc_state.malloc_size;
 }
\ No newline at end of file
@@ -52,6 +52,10 @@ static inline void js_dbuf_init(JSContext* ctx, DynBuf* s) {
 void* js_def_malloc(JSMallocState* s, size_t size);
 void js_def_free(JSMallocState* s, void* ptr);
 void* js_def_realloc(JSMallocState* s, void* ptr, size_t size);
+/* the heap of a runtime allocating with js_def_malloc(), NULL without
+   mimalloc */
+void* js_def_heap_new(void);
+void js_def_heap_delete(void* opaque);
 size_t js_malloc_usable_size_unknown(const void* ptr);
 
 
@@ -119,6 +119,7 @@ static void compute_value_size(JSValueConst val, JSMemoryUsage_helper *hp)
 void JS_ComputeMemoryUsage(JSRuntime *rt, JSMemoryUsage *s)
 {
   struct list_head *el, *el1;
+  int gen;
   int i;
   JSMemoryUsage_helper mem = { 0 }, *hp = &mem;
 
@@ -178,7 +179,7 @@ void JS_ComputeMemoryUsage(JSRuntime *rt, JSMemoryUsage *s)
     }
   }
 
-  list_for_each(el, &rt->gc_obj_list) {
+  list_for_each_gc_obj(el, rt, gen) {
     JSGCObjectHeader *gp = list_entry(el, JSGCObjectHeader, link);
     JSObject *p;
     JSShape *sh;
@@ -410,6 +411,152 @@ void JS_ComputeMemoryUsage(JSRuntime *rt, JSMemoryUsage *s)
                          s->js_func_pc2column_size;
 }
 
+/* Estimates the memory of |p| as JS_ComputeMemoryUsage() counts it, the strings go to |hp|. */
+static double compute_object_size(JSObject *p, JSMemoryUsage_helper *hp)
+{
+  JSShape *sh = p->shape;
+  JSShapeProperty *prs;
+  double size = sizeof(JSObject);
+  int i;
+
+  if (p->prop) {
+    size += sh->prop_size * sizeof(*p->prop);
+    prs = get_shape_prop(sh);
+    for(i = 0; i < sh->prop_count; i++) {
+      if (prs->atom != JS_ATOM_NULL && !(prs->flags & JS_PROP_TMASK)) {
+        compute_value_size(p->prop[i].u.value, hp);
+      }
+      prs++;
+    }
+  }
+  if (!sh->is_hashed) {
+    size += get_shape_size(sh->prop_hash_mask + 1, sh->prop_size);
+  }
+
+  switch(p->class_id) {
+    case JS_CLASS_ARRAY:
+    case JS_CLASS_ARGUMENTS:
+      if (p->fast_array && p->u.array.u.values) {
+        size += p->u.array.count * sizeof(*p->u.array.u.values);
+        for (i = 0; i < p->u.array.count; i++) {
+          compute_value_size(p->u.array.u.values[i], hp);
+        }
+      }
+      break;
+    case JS_CLASS_NUMBER:
+    case JS_CLASS_STRING:
+    case JS_CLASS_BOOLEAN:
+    case JS_CLASS_SYMBOL:
+    case JS_CLASS_DATE:
+      compute_value_size(p->u.object_data, hp);
+      break;
+    case JS_CLASS_BYTECODE_FUNCTION:
+    {
+      JSFunctionBytecode *b = p->u.func.function_bytecode;
+      JSVarRef **var_refs = p->u.func.var_refs;
+      if (var_refs) {
+        size += b->closure_var_count * sizeof(*var_refs);
+        for (i = 0; i < b->closure_var_count; i++) {
+          if (var_refs[i]) {
+            size += sizeof(*var_refs[i]) / (double)var_refs[i]->header.ref_count;
+            if (var_refs[i]->pvalue == &var_refs[i]->value) {
+              compute_value_size(var_refs[i]->value, hp);
+            }
+          }
+        }
+      }
+    }
+    break;
+    case JS_CLASS_BOUND_FUNCTION:
+    {
+      JSBoundFunction *bf = p->u.bound_function;
+      for (i = 0; i < bf->argc; i++) {
+        compute_value_size(bf->argv[i], hp);
+      }
+      size += sizeof(*bf) + bf->argc * sizeof(*bf->argv);
+    }
+    break;
+    case JS_CLASS_REGEXP:
+      compute_jsstring_size(p->u.regexp.pattern, hp);
+      compute_jsstring_size(p->u.regexp.bytecode, hp);
+      break;
+    case JS_CLASS_ARRAY_BUFFER:
+    case JS_CLASS_SHARED_ARRAY_BUFFER:
+    {
+      JSArrayBuffer *abuf = p->u.array_buffer;
+      if (abuf) {
+        size += sizeof(*abuf);
+        if (abuf->data) {
+          size += abuf->byte_length;
+        }
+      }
+    }
+    break;
+    default:
+      break;
+  }
+  return size;
+}
+
+/* Returns the index in |ctxs| of the context owning |p|, or -1. */
+static int find_object_realm(JSObject *p, JSContext *const *ctxs, int count)
+{
+  int i;
+  while (p->shape->proto) {
+    p = p->shape->proto;
+  }
+  for (i = 0; i < count; i++) {
+    if (JS_VALUE_GET_TAG(ctxs[i]->class_proto[JS_CLASS_OBJECT]) == JS_TAG_OBJECT &&
+        JS_VALUE_GET_OBJ(ctxs[i]->class_proto[JS_CLASS_OBJECT]) == p) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+void JS_ComputeContextMemoryUsage(JSRuntime *rt, JSContext *const *ctxs, int64_t *sizes, int count)
+{
+  struct list_head *el;
+  int gen;
+  JSMemoryUsage_helper mem;
+  double size;
+  int i;
+
+  for (i = 0; i < count; i++) {
+    sizes[i] = 0;
+  }
+  list_for_each_gc_obj(el, rt, gen) {
+    JSGCObjectHeader *gp = list_entry(el, JSGCObjectHeader, link);
+    memset(&mem, 0, sizeof(mem));
+    i = -1;
+    size = 0;
+    if (gp->gc_obj_type == JS_GC_OBJ_TYPE_JS_OBJECT) {
+      JSObject *p = (JSObject *)gp;
+      i = find_object_realm(p, ctxs, count);
+      if (i >= 0) {
+        size = compute_object_size(p, &mem);
+      }
+    } else if (gp->gc_obj_type == JS_GC_OBJ_TYPE_FUNCTION_BYTECODE) {
+      JSFunctionBytecode *b = (JSFunctionBytecode *)gp;
+      for (i = count - 1; i >= 0 && ctxs[i] != b->realm; i--)
+        continue;
+      if (i >= 0) {
+        compute_bytecode_size(b, &mem);
+        size = mem.js_func_code_size + mem.js_func_pc2line_size + mem.js_func_pc2column_size;
+      }
+    } else if (gp->gc_obj_type == JS_GC_OBJ_TYPE_JS_CONTEXT) {
+      for (i = count - 1; i >= 0 && &ctxs[i]->header != gp; i--)
+        continue;
+      if (i >= 0) {
+        size = sizeof(JSContext) + sizeof(ctxs[i]->class_proto[0]) * rt->class_count;
+      }
+    }
+    if (i >= 0) {
+      sizes[i] += (int64_t)(size + mem.str_size + mem.js_func_size);
+    }
+  }
+}
+
 void JS_DumpMemoryUsage(FILE *fp, const JSMemoryUsage *s, JSRuntime *rt)
 {
   fprintf(fp, "QuickJS memory usage -- "
@@ -451,7 +598,8 @@ void JS_DumpMemoryUsage(FILE *fp, const JSMemoryUsage *s, JSRuntime *rt)
       int obj_classes[JS_CLASS_INIT_COUNT + 1] = { 0 };
       int class_id;
       struct list_head *el;
-      list_for_each(el, &rt->gc_obj_list) {
+      int gen;
+      list_for_each_gc_obj(el, rt, gen) {
         JSGCObjectHeader *gp = list_entry(el, JSGCObjectHeader, link);
         JSObject *p;
         if (gp->gc_obj_type == JS_GC_OBJ_TYPE_JS_OBJECT) {
@@ -273,7 +273,6 @@ redo:
       pr->flags = 0;
       pr->atom = JS_ATOM_NULL;
       pr1->u.value = JS_UNDEFINED;
-      ic_delete_shape_proto_watchpoints(ctx->rt, sh, atom);
       /* compact the properties if too many deleted properties */
       if (sh->deleted_prop_count >= 8 && sh->deleted_prop_count >= ((unsigned)sh->prop_count / 2))
         compact_properties(ctx, p);
@@ -354,12 +353,53 @@ void free_property(JSRuntime* rt, JSProperty* pr, int prop_flags) {
 /* return the value associated to the autoinit property or an exception */
 typedef JSValue JSAutoInitFunc(JSContext *ctx, JSObject *p, JSAtom atom, void *opaque);
 
+typedef struct JSLazyProperty {
+  JSLazyPropertyInit *init;
+  void *opaque;
+} JSLazyProperty;
+
 static JSAutoInitFunc *js_autoinit_func_table[] = {
     js_instantiate_prototype, /* JS_AUTOINIT_ID_PROTOTYPE */
     js_module_ns_autoinit, /* JS_AUTOINIT_ID_MODULE_NS */
     JS_InstantiateFunctionListItem2, /* JS_AUTOINIT_ID_PROP */
+    NULL, /* JS_AUTOINIT_ID_LAZY, see js_resolve_lazy_property() */
 };
 
+/* Unlike the other autoinit functions, the initializer of a lazy property may run arbitrary code, including defining
+   properties on 'p'. It is called before the property is touched and 'pr' is looked up again afterwards. */
+static int js_resolve_lazy_property(JSContext *ctx, JSObject *p, JSAtom prop, JSProperty *pr)
+{
+  JSLazyProperty *lazy = pr->u.init.opaque;
+  JSContext *realm = js_autoinit_get_realm(pr);
+  JSValue obj = JS_DupValue(ctx, JS_MKPTR(JS_TAG_OBJECT, p));
+  JSShapeProperty *prs;
+  JSValue val;
+
+  val = lazy->init(realm, obj, prop, lazy->opaque);
+  if (JS_IsException(val)) {
+    JS_FreeValue(ctx, obj);
+    return -1;
+  }
+
+  prs = find_own_property(&pr, p, prop);
+  if (prs && (prs->flags & JS_PROP_TMASK) == JS_PROP_AUTOINIT && js_autoinit_get_id(pr) == JS_AUTOINIT_ID_LAZY &&
+      pr->u.init.opaque == lazy) {
+    if (js_shape_prepare_update(ctx, p, &prs)) {
+      JS_FreeValue(ctx, val);
+      JS_FreeValue(ctx, obj);
+      return -1;
+    }
+    js_autoinit_free(ctx->rt, pr);
+    prs->flags &= ~JS_PROP_TMASK;
+    pr->u.value = val;
+  } else {
+    /* The initializer already resolved or redefined the property. */
+    JS_FreeValue(ctx, val);
+  }
+  JS_FreeValue(ctx, obj);
+  return 0;
+}
+
 /* warning: 'prs' is reallocated after it */
 static int JS_AutoInitProperty(JSContext *ctx, JSObject *p, JSAtom prop,
                                JSProperty *pr, JSShapeProperty *prs)
@@ -368,6 +408,9 @@ static int JS_AutoInitProperty(JSContext *ctx, JSObject *p, JSAtom prop,
   JSContext *realm;
   JSAutoInitFunc *func;
 
+  if (js_autoinit_get_id(pr) == JS_AUTOINIT_ID_LAZY)
+    return js_resolve_lazy_property(ctx, p, prop, pr);
+
   if (js_shape_prepare_update(ctx, p, &prs))
     return -1;
 
@@ -439,6 +482,10 @@ JSValue JS_GetPropertyInternal(JSContext *ctx, JSValueConst obj,
       /* found */
       if (unlikely(prs->flags & JS_PROP_TMASK)) {
         if ((prs->flags & JS_PROP_TMASK) == JS_PROP_GETSET) {
+          if (ic) {
+            ic->updated = TRUE;
+            ic->updated_offset = add_ic_slot(ic, prop, p1, offset, proto_depth > 0 ? p : NULL, prs->flags);
+          }
           if (unlikely(!pr->u.getset.getter)) {
             return JS_UNDEFINED;
           } else {
@@ -460,9 +507,9 @@ JSValue JS_GetPropertyInternal(JSContext *ctx, JSValueConst obj,
         }
       } else {
         // basic poly ic is only used for fast path
-        if (ic && p1->shape->is_hashed && p->shape->is_hashed) {
+        if (ic) {
           ic->updated = TRUE;
-          ic->updated_offset = add_ic_slot(ic, prop, p1, offset, proto_depth > 0 ? p : NULL);
+          ic->updated_offset = add_ic_slot(ic, prop, p1, offset, proto_depth > 0 ? p : NULL, prs->flags);
         }
         return JS_DupValue(ctx, pr->u.value);
       }
@@ -502,7 +549,7 @@ JSValue JS_GetPropertyInternal(JSContext *ctx, JSValueConst obj,
             JS_FreeValue(ctx, obj1);
             return retval;
           }
-          if (em->get_own_property) {
+          if (em->get_own_property && !em->own_properties_from_prototype) {
             JSPropertyDescriptor desc;
             int ret;
             JSValue obj1;
@@ -551,16 +598,22 @@ force_inline JSValue JS_GetPropertyInternalWithIC(JSContext *ctx, JSValueConst o
 #endif
 {
   uint32_t tag;
-  JSObject *p, *proto;
+  JSObject *p, *holder;
+  JSProperty *pr;
+  InlineCacheRingItem *ci;
   tag = JS_VALUE_GET_TAG(obj);
   if (unlikely(tag != JS_TAG_OBJECT))
     goto slow_path;
   p = JS_VALUE_GET_OBJ(obj);
-  offset = get_ic_prop_offset(ic, offset, p->shape, &proto);
-  if (likely(offset >= 0)) {
-    if (proto)
-      p = proto;
-    return JS_DupValue(ctx, p->prop[offset].u.value);
+  ci = get_ic_item(ic, offset, p, &holder);
+  if (likely(ci != NULL)) {
+    pr = &holder->prop[ci->prop_offset];
+    if (likely(!(ci->prop_flags & JS_PROP_TMASK)))
+      return JS_DupValue(ctx, pr->u.value);
+    if (unlikely(!pr->u.getset.getter))
+      return JS_UNDEFINED;
+    /* Note: the field could be removed in the getter */
+    return JS_CallFree(ctx, JS_DupValue(ctx, JS_MKPTR(JS_TAG_OBJECT, pr->u.getset.getter)), this_obj, 0, NULL);
   }
 slow_path:
   return JS_GetPropertyInternal(ctx, obj, prop, this_obj, ic, throw_ref_error);
@@ -1602,6 +1655,32 @@ redo_prop_update:
   return JS_CreateProperty(ctx, p, prop, val, getter, setter, flags);
 }
 
+int JS_DefineLazyProperty(JSContext* ctx, JSValueConst this_obj, JSAtom prop, JSLazyPropertyInit* init, void* opaque, int flags) {
+  JSObject* p;
+  JSProperty* pr;
+  JSLazyProperty* lazy;
+
+  if (JS_VALUE_GET_TAG(this_obj) != JS_TAG_OBJECT)
+    return FALSE;
+
+  p = JS_VALUE_GET_OBJ(this_obj);
+  if (find_own_property(&pr, p, prop)) {
+    if (delete_property(ctx, p, prop) != TRUE)
+      return -1;
+  }
+
+  lazy = js_malloc(ctx, sizeof(*lazy));
+  if (!lazy)
+    return -1;
+  lazy->init = init;
+  lazy->opaque = opaque;
+  if (JS_DefineAutoInitProperty(ctx, this_obj, prop, JS_AUTOINIT_ID_LAZY, lazy, flags) < 0) {
+    js_free(ctx, lazy);
+    return -1;
+  }
+  return TRUE;
+}
+
 int JS_DefineAutoInitProperty(JSContext* ctx, JSValueConst this_obj, JSAtom prop, JSAutoInitIDEnum id, void* opaque, int flags) {
   JSObject* p;
   JSProperty* pr;
@@ -1810,9 +1889,9 @@ retry:
   if (prs) {
     if (likely((prs->flags & (JS_PROP_TMASK | JS_PROP_WRITABLE | JS_PROP_LENGTH)) == JS_PROP_WRITABLE)) {
       /* fast case */
-      if (ic && p->shape->is_hashed) {
+      if (ic) {
         ic->updated = TRUE;
-        ic->updated_offset = add_ic_slot(ic, prop, p, offset, NULL);
+        ic->updated_offset = add_ic_slot(ic, prop, p, offset, NULL, prs->flags);
       }
       set_value(ctx, &pr->u.value, val);
       return TRUE;
@@ -1883,7 +1962,7 @@ retry:
             JS_FreeValue(ctx, val);
             return ret;
           }
-          if (em->get_own_property) {
+          if (em->get_own_property && !em->own_properties_from_prototype) {
             /* get_own_property can free the prototype */
             obj1 = JS_DupValue(ctx, JS_MKPTR(JS_TAG_OBJECT, p1));
             ret = em->get_own_property(ctx, &desc, obj1, prop);
@@ -1926,9 +2005,13 @@ retry:
       break;
 
   retry2:
-    prs = find_own_property(&pr, p1, prop);
+    prs = find_own_property_ic(&pr, p1, prop, &offset);
     if (prs) {
       if ((prs->flags & JS_PROP_TMASK) == JS_PROP_GETSET) {
+        if (ic && p) {
+          ic->updated = TRUE;
+          ic->updated_offset = add_ic_slot(ic, prop, p, offset, p1, prs->flags);
+        }
         return call_setter(ctx, pr->u.getset.setter, this_obj, val, flags);
       } else if ((prs->flags & JS_PROP_TMASK) == JS_PROP_AUTOINIT) {
         /* Instantiate property and retry (potentially useless) */
@@ -1976,7 +2059,6 @@ retry:
     }
   }
 
-  ic_delete_shape_proto_watchpoints(ctx->rt, p->shape, prop);
   pr = add_property(ctx, p, prop, JS_PROP_C_W_E);
   if (unlikely(!pr)) {
     JS_FreeValue(ctx, val);
@@ -1984,9 +2066,9 @@ retry:
   }
   pr->u.value = val;
   /* fast case */
-  if (ic && p->shape->is_hashed) {
+  if (ic) {
     ic->updated = TRUE;
-    ic->updated_offset = add_ic_slot(ic, prop, p, p->shape->prop_count - 1, NULL);
+    ic->updated_offset = add_ic_slot(ic, prop, p, p->shape->prop_count - 1, NULL, JS_PROP_C_W_E);
   }
   return TRUE;
 }
@@ -1997,17 +2079,21 @@ int JS_SetPropertyInternalWithIC(JSContext* ctx, JSValueConst this_obj, JSAtom p
 force_inline int JS_SetPropertyInternalWithIC(JSContext* ctx, JSValueConst this_obj, JSAtom prop, JSValue val, int flags, InlineCache *ic, int32_t offset) {
 #endif
   uint32_t tag;
-  JSObject *p, *proto;
+  JSObject *p, *holder;
+  InlineCacheRingItem *ci;
   tag = JS_VALUE_GET_TAG(this_obj);
   if (unlikely(tag != JS_TAG_OBJECT))
     goto slow_path;
   p = JS_VALUE_GET_OBJ(this_obj);
-  offset = get_ic_prop_offset(ic, offset, p->shape, &proto);
-  if (likely(offset >= 0)) {
-    if (proto)
-      goto slow_path;
-    set_value(ctx, &p->prop[offset].u.value, val);
-    return TRUE;
+  ci = get_ic_item(ic, offset, p, &holder);
+  if (likely(ci != NULL)) {
+    if ((ci->prop_flags & JS_PROP_TMASK) == JS_PROP_GETSET)
+      return call_setter(ctx, holder->prop[ci->prop_offset].u.getset.setter, this_obj, val, flags);
+    /* the data properties of the prototypes are shadowed by the assignment */
+    if (holder == p && (ci->prop_flags & (JS_PROP_TMASK | JS_PROP_WRITABLE | JS_PROP_LENGTH)) == JS_PROP_WRITABLE) {
+      set_value(ctx, &p->prop[ci->prop_offset].u.value, val);
+      return TRUE;
+    }
   }
 slow_path:
   return JS_SetPropertyInternal(ctx, this_obj, prop, val, flags, ic);
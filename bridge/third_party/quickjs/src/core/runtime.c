@@ -352,7 +352,6 @@ int JS_SetPrototypeInternal(JSContext* ctx, JSValueConst obj, JSValueConst proto
   if (js_shape_prepare_update(ctx, p, NULL))
     return -1;
   sh = p->shape;
-  ic_free_shape_proto_watchpoints(ctx->rt, p->shape);
   if (sh->proto)
     JS_FreeValue(ctx, JS_MKPTR(JS_TAG_OBJECT, sh->proto));
   sh->proto = proto;
@@ -1073,6 +1072,8 @@ JSAutoInitIDEnum js_autoinit_get_id(JSProperty* pr) {
 }
 
 void js_autoinit_free(JSRuntime* rt, JSProperty* pr) {
+  if (js_autoinit_get_id(pr) == JS_AUTOINIT_ID_LAZY)
+    js_free_rt(rt, pr->u.init.opaque);
   JS_FreeContext(js_autoinit_get_realm(pr));
 }
 
@@ -1236,6 +1237,48 @@ done:
   }
 }
 
+/* only reads the frames, it can run in the interrupt handler */
+int JS_GetStackFrames(JSRuntime* rt, JSStackFrameInfo* frames, int max_frames) {
+  JSStackFrame* sf;
+  JSStackFrameInfo* frame;
+  JSObject* p;
+  JSFunctionBytecode* b;
+  JSProperty* pr;
+  JSShapeProperty* prs;
+  JSString* name;
+  int count = 0;
+
+  for (sf = rt->current_stack_frame; sf != NULL && count < max_frames; sf = sf->prev_frame) {
+    frame = &frames[count++];
+    frame->function_name = JS_ATOM_NULL;
+    frame->filename = JS_ATOM_NULL;
+    frame->line_num = -1;
+    if (JS_VALUE_GET_TAG(sf->cur_func) != JS_TAG_OBJECT)
+      continue;
+    p = JS_VALUE_GET_OBJ(sf->cur_func);
+    if (js_class_has_bytecode(p->class_id)) {
+      b = p->u.func.function_bytecode;
+      frame->function_name = b->func_name;
+      if (b->has_debug) {
+        frame->filename = b->debug.filename;
+        if (sf->cur_pc)
+          frame->line_num = find_line_num(NULL, b, sf->cur_pc - b->byte_code_buf - 1);
+        if (frame->line_num == -1)
+          frame->line_num = b->debug.line_num;
+      }
+    } else {
+      /* the names of the native functions are atoms */
+      prs = find_own_property(&pr, p, JS_ATOM_name);
+      if (prs && (prs->flags & JS_PROP_TMASK) == JS_PROP_NORMAL && JS_VALUE_GET_TAG(pr->u.value) == JS_TAG_STRING) {
+        name = JS_VALUE_GET_STRING(pr->u.value);
+        if (name->atom_type == JS_ATOM_TYPE_STRING)
+          frame->function_name = js_get_atom_index(rt, name);
+      }
+    }
+  }
+  return count;
+}
+
 /* Note: it is important that no exception is returned by this function */
 BOOL is_backtrace_needed(JSContext* ctx, JSValueConst obj) {
   JSObject* p;
@@ -1251,6 +1294,13 @@ BOOL is_backtrace_needed(JSContext* ctx, JSValueConst obj) {
 
 no_inline __exception int __js_poll_interrupts(JSContext* ctx) {
   JSRuntime* rt = ctx->rt;
+  if (unlikely(ctx->terminated)) {
+    /* keep polling, the code left on the stack unwinds at its next poll */
+    ctx->interrupt_counter = 0;
+    JS_ThrowInternalError(ctx, "interrupted");
+    JS_SetUncatchableError(ctx, ctx->rt->current_exception, TRUE);
+    return -1;
+  }
   ctx->interrupt_counter = JS_INTERRUPT_COUNTER_INIT;
   if (rt->interrupt_handler) {
     if (rt->interrupt_handler(rt, rt->interrupt_opaque)) {
@@ -1643,6 +1693,15 @@ void JS_SetInterruptHandler(JSRuntime* rt, JSInterruptHandler* cb, void* opaque)
   rt->interrupt_opaque = opaque;
 }
 
+void JS_TerminateExecution(JSContext* ctx) {
+  ctx->terminated = TRUE;
+  ctx->interrupt_counter = 0;
+}
+
+BOOL JS_IsExecutionTerminated(JSContext* ctx) {
+  return ctx->terminated;
+}
+
 void JS_SetCanBlock(JSRuntime* rt, BOOL can_block) {
   rt->can_block = can_block;
 }
@@ -1667,6 +1726,7 @@ int JS_EnqueueJob(JSContext* ctx, JSJobFunc* job_func, int argc, JSValueConst* a
     e->argv[i] = JS_DupValue(ctx, argv[i]);
   }
   list_add_tail(&e->link, &rt->job_list);
+  rt->job_enqueued_count++;
   return 0;
 }
 
@@ -1690,6 +1750,7 @@ int JS_ExecutePendingJob(JSRuntime* rt, JSContext** pctx) {
   /* get the first pending job and execute it */
   e = list_entry(rt->job_list.next, JSJobEntry, link);
   list_del(&e->link);
+  rt->job_executed_count++;
   ctx = e->ctx;
   res = e->job_func(e->ctx, e->argc, (JSValueConst*)e->argv);
   for (i = 0; i < e->argc; i++)
@@ -1704,6 +1765,14 @@ int JS_ExecutePendingJob(JSRuntime* rt, JSContext** pctx) {
   return ret;
 }
 
+uint64_t JS_GetEnqueuedJobCount(JSRuntime* rt) {
+  return rt->job_enqueued_count;
+}
+
+uint64_t JS_GetExecutedJobCount(JSRuntime* rt) {
+  return rt->job_executed_count;
+}
+
 void JS_SetClassProto(JSContext* ctx, JSClassID class_id, JSValue obj) {
   JSRuntime* rt = ctx->rt;
   assert(class_id < rt->class_count);
@@ -2594,6 +2663,7 @@ void JS_FreeRuntime(JSRuntime* rt) {
   }
   init_list_head(&rt->job_list);
 
+  free_ic_megamorphic_cache(rt);
   JS_RunGC(rt);
 
 #ifdef DUMP_LEAKS
@@ -2636,6 +2706,8 @@ void JS_FreeRuntime(JSRuntime* rt) {
   }
 #endif
   assert(list_empty(&rt->gc_obj_list));
+  assert(list_empty(&rt->gc_young_obj_list));
+  js_free_heap_snapshot_ids(rt);
 
   /* free the classes */
   for (i = 0; i < rt->class_count; i++) {
@@ -2763,7 +2835,10 @@ void JS_FreeRuntime(JSRuntime* rt) {
 
   {
     JSMallocState ms = rt->malloc_state;
+    BOOL own_heap = rt->mf.js_malloc == js_def_malloc;
     rt->mf.js_free(&ms, rt);
+    if (own_heap)
+      js_def_heap_delete(ms.opaque);
   }
 }
 
@@ -2856,10 +2931,11 @@ void JS_FreeContext(JSContext* ctx) {
 #ifdef DUMP_OBJECTS
   {
     struct list_head* el;
+    int gen;
     JSGCObjectHeader* p;
     printf("JSObjects: {\n");
     JS_DumpObjectHeader(ctx->rt);
-    list_for_each(el, &rt->gc_obj_list) {
+    list_for_each_gc_obj(el, rt, gen) {
       p = list_entry(el, JSGCObjectHeader, link);
       JS_DumpGCObject(rt, p);
     }
@@ -2901,7 +2977,7 @@ void JS_FreeContext(JSContext* ctx) {
   js_free_shape_null(ctx->rt, ctx->array_shape);
 
   list_del(&ctx->link);
-  remove_gc_object(&ctx->header);
+  remove_gc_object(ctx->rt, &ctx->header);
   js_free_rt(ctx->rt, ctx);
 }
 
@@ -2997,8 +3073,11 @@ JSRuntime* JS_NewRuntime2(const JSMallocFunctions* mf, void* opaque) {
   ms.malloc_limit = -1;
 
   rt = mf->js_malloc(&ms, sizeof(JSRuntime));
-  if (!rt)
+  if (!rt) {
+    if (mf->js_malloc == js_def_malloc)
+      js_def_heap_delete(opaque);
     return NULL;
+  }
   memset(rt, 0, sizeof(*rt));
   rt->mf = *mf;
   if (!rt->mf.js_malloc_usable_size) {
@@ -3018,6 +3097,7 @@ JSRuntime* JS_NewRuntime2(const JSMallocFunctions* mf, void* opaque) {
 
   init_list_head(&rt->context_list);
   init_list_head(&rt->gc_obj_list);
+  init_list_head(&rt->gc_young_obj_list);
   init_list_head(&rt->gc_zero_ref_count_list);
   rt->gc_phase = JS_GC_PHASE_NONE;
 
@@ -3084,7 +3164,8 @@ static const JSMallocFunctions def_malloc_funcs = {
 };
 
 JSRuntime* JS_NewRuntime(void) {
-  return JS_NewRuntime2(&def_malloc_funcs, NULL);
+  /* the runtime owns the heap, JS_FreeRuntime() deletes it */
+  return JS_NewRuntime2(&def_malloc_funcs, js_def_heap_new());
 }
 
 /* the indirection is needed to make 'eval' optional */
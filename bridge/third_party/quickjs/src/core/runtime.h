@@ -221,6 +221,17 @@ static inline __exception int js_poll_interrupts(JSContext* ctx) {
   }
 }
 
+/* same as js_poll_interrupts(), the position of the running function is
+   saved first so that the interrupt handler sees the current line */
+static inline __exception int js_poll_interrupts_at(JSContext* ctx, JSStackFrame* sf, const uint8_t* pc) {
+  if (unlikely(--ctx->interrupt_counter <= 0)) {
+    sf->cur_pc = (uint8_t*)pc;
+    return __js_poll_interrupts(ctx);
+  } else {
+    return 0;
+  }
+}
+
 int check_function(JSContext* ctx, JSValueConst obj);
 JSValue JS_EvalObject(JSContext* ctx, JSValueConst this_obj, JSValueConst val, int flags, int scope_idx);
 int check_exception_free(JSContext* ctx, JSValue obj);
@@ -134,7 +134,6 @@ no_inline JSShape* js_new_shape2(JSContext* ctx, JSObject* proto, int hash_size,
   sh->hash = shape_initial_hash(proto);
   sh->is_hashed = TRUE;
   sh->has_small_array_index = FALSE;
-  sh->watchpoint = NULL;
   js_shape_hash_link(ctx->rt, sh);
   return sh;
 }
@@ -163,7 +162,6 @@ JSShape* js_clone_shape(JSContext* ctx, JSShape* sh1) {
   sh->header.ref_count = 1;
   add_gc_object(ctx->rt, &sh->header, JS_GC_OBJ_TYPE_SHAPE);
   sh->is_hashed = FALSE;
-  sh->watchpoint = NULL;
   if (sh->proto) {
     JS_DupValue(ctx, JS_MKPTR(JS_TAG_OBJECT, sh->proto));
   }
@@ -187,13 +185,12 @@ void js_free_shape0(JSRuntime* rt, JSShape* sh) {
     js_shape_hash_unlink(rt, sh);
   if (sh->proto != NULL)
     JS_FreeValueRT(rt, JS_MKPTR(JS_TAG_OBJECT, sh->proto));
-  js_shape_free_watchpoints(rt, sh);
   pr = get_shape_prop(sh);
   for (i = 0; i < sh->prop_count; i++) {
     JS_FreeAtomRT(rt, pr->atom);
     pr++;
   }
-  remove_gc_object(&sh->header);
+  remove_gc_object(rt, &sh->header);
   js_free_rt(rt, get_alloc_from_shape(sh));
 }
 
@@ -241,7 +238,9 @@ no_inline int resize_properties(JSContext* ctx, JSShape** psh, JSObject* p, uint
     list_del(&old_sh->header.link);
     /* copy all the fields and the properties */
     memcpy(sh, old_sh, sizeof(JSShape) + sizeof(sh->prop[0]) * old_sh->prop_count);
-    list_add_tail(&sh->header.link, &ctx->rt->gc_obj_list);
+    list_add_tail(&sh->header.link, gc_obj_list_of(ctx->rt, &sh->header));
+    if (unlikely(ctx->rt->heap_snapshot_ids))
+      js_move_heap_snapshot_id(ctx->rt, &old_sh->header, &sh->header);
     new_hash_mask = new_hash_size - 1;
     sh->prop_hash_mask = new_hash_mask;
     memset(prop_hash_end(sh) - new_hash_size, 0, sizeof(prop_hash_end(sh)[0]) * new_hash_size);
@@ -255,15 +254,18 @@ no_inline int resize_properties(JSContext* ctx, JSShape** psh, JSObject* p, uint
     js_free(ctx, get_alloc_from_shape(old_sh));
   } else {
     /* only resize the properties */
+    JSGCObjectHeader* old_header = &sh->header;
     list_del(&sh->header.link);
     sh_alloc = js_realloc(ctx, get_alloc_from_shape(sh), get_shape_size(new_hash_size, new_size));
     if (unlikely(!sh_alloc)) {
       /* insert again in the GC list */
-      list_add_tail(&sh->header.link, &ctx->rt->gc_obj_list);
+      list_add_tail(&sh->header.link, gc_obj_list_of(ctx->rt, &sh->header));
       return -1;
     }
     sh = get_shape_from_alloc(sh_alloc, new_hash_size);
-    list_add_tail(&sh->header.link, &ctx->rt->gc_obj_list);
+    list_add_tail(&sh->header.link, gc_obj_list_of(ctx->rt, &sh->header));
+    if (unlikely(ctx->rt->heap_snapshot_ids) && old_header != &sh->header)
+      js_move_heap_snapshot_id(ctx->rt, old_header, &sh->header);
   }
   *psh = sh;
   sh->prop_size = new_size;
@@ -298,7 +300,9 @@ int compact_properties(JSContext* ctx, JSObject* p) {
   sh = get_shape_from_alloc(sh_alloc, new_hash_size);
   list_del(&old_sh->header.link);
   memcpy(sh, old_sh, sizeof(JSShape));
-  list_add_tail(&sh->header.link, &ctx->rt->gc_obj_list);
+  list_add_tail(&sh->header.link, gc_obj_list_of(ctx->rt, &sh->header));
+  if (unlikely(ctx->rt->heap_snapshot_ids))
+    js_move_heap_snapshot_id(ctx->rt, &old_sh->header, &sh->header);
 
   memset(prop_hash_end(sh) - new_hash_size, 0, sizeof(prop_hash_end(sh)[0]) * new_hash_size);
 
@@ -437,6 +441,7 @@ __maybe_unused void JS_DumpShapes(JSRuntime* rt) {
   int i;
   JSShape* sh;
   struct list_head* el;
+  int gen;
   JSObject* p;
   JSGCObjectHeader* gp;
 
@@ -449,7 +454,7 @@ __maybe_unused void JS_DumpShapes(JSRuntime* rt) {
     }
   }
   /* dump non-hashed shapes */
-  list_for_each(el, &rt->gc_obj_list) {
+  list_for_each_gc_obj(el, rt, gen) {
     gp = list_entry(el, JSGCObjectHeader, link);
     if (gp->gc_obj_type == JS_GC_OBJ_TYPE_JS_OBJECT) {
       p = (JSObject*)gp;
@@ -586,59 +591,4 @@ int js_shape_prepare_update(JSContext* ctx, JSObject* p, JSShapeProperty** pprs)
     }
   }
   return 0;
-}
-
-int js_shape_delete_watchpoints(JSRuntime *rt, JSShape *shape, void* target) {
-  struct list_head *el, *el1;
-  if (unlikely(!shape || !shape->watchpoint))
-    goto end;
-  list_for_each_safe(el, el1, shape->watchpoint) {
-    ICWatchpoint *o = list_entry(el, ICWatchpoint, link);
-    if (o->delete_callback)
-      if (!o->delete_callback(rt, o->ref, o->atom, target)) {
-        list_del(el);
-        js_free_rt(rt, o);
-        break;
-      }
-  }
-end:
-  return 0;
-}
-
-int js_shape_free_watchpoints(JSRuntime* rt, JSShape *shape) {
-  struct list_head *el, *el1;
-  if (unlikely(!shape || !shape->watchpoint))
-    goto end;
-  list_for_each_safe(el, el1, shape->watchpoint) {
-    ICWatchpoint *o = list_entry(el, ICWatchpoint, link);
-    if (o->free_callback) {
-      o->free_callback(rt, o->ref, o->atom);
-    }
-    list_del(el);
-    js_free_rt(rt, o);
-  }
-  list_empty(shape->watchpoint);
-  js_free_rt(rt, shape->watchpoint);
-end:
-  return 0;
-}
-
-ICWatchpoint* js_shape_create_watchpoint(JSRuntime *rt, JSShape *shape, intptr_t ptr, JSAtom atom,
-                             watchpoint_delete_callback *remove_callback,
-                             watchpoint_free_callback *clear_callback) {
-  ICWatchpoint *o;
-  o = (ICWatchpoint *)js_malloc_rt(rt, sizeof(ICWatchpoint));
-  if(unlikely(!o))
-    return NULL;
-  o->ref = ptr;
-  o->atom = atom;
-  o->delete_callback = remove_callback;
-  o->free_callback = clear_callback;
-  if (!shape->watchpoint) {
-    shape->watchpoint = (struct list_head *)js_malloc_rt(rt, sizeof(struct list_head));
-    init_list_head(shape->watchpoint);
-  }
-  init_list_head(&o->link);
-  list_add_tail(&o->link, shape->watchpoint);
-  return o;
 }
\ No newline at end of file
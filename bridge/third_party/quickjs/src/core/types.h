@@ -186,7 +186,8 @@ struct JSRuntime {
 
     struct list_head context_list; /* list of JSContext.link */
     /* list of JSGCObjectHeader.link. List of allocated GC objects (used
-       by the garbage collector) */
+       by the garbage collector), the young ones are in
+       gc_young_obj_list */
     struct list_head gc_obj_list;
     /* list of JSGCObjectHeader.link. Used during JS_FreeValueRT() */
     struct list_head gc_zero_ref_count_list;
@@ -238,6 +239,26 @@ struct JSRuntime {
 #endif
     void *user_opaque;
     JSRuntimeState state;
+    JSGCObserver *gc_observer;
+    void *gc_observer_opaque;
+    /* shared by the megamorphic inline cache sites, allocated on first use */
+    struct InlineCacheMegamorphicEntry *ic_megamorphic_cache;
+    /* list of JSGCObjectHeader.link. The GC objects allocated since the
+       last full collection which survived less than JS_GC_PROMOTION_AGE
+       minor collections. Only them are scanned by the minor collections. */
+    struct list_head gc_young_obj_list;
+    BOOL gc_minor : 8; /* TRUE during a minor collection */
+    uint32_t gc_old_count; /* objects left by the last full collection */
+    uint32_t gc_promoted_count; /* promoted since the last full collection */
+    /* jobs added to and taken from job_list since the creation of the
+       runtime */
+    uint64_t job_enqueued_count;
+    uint64_t job_executed_count;
+    /* set while JS_WriteHeapSnapshot() walks the GC objects */
+    struct JSHeapSnapshot *heap_snapshot;
+    /* the ids of the GC objects written in a heap snapshot, NULL before
+       the first one. Their entry is removed when they are freed. */
+    struct JSHeapSnapshotIds *heap_snapshot_ids;
 };
 
 struct JSClass {
@@ -284,7 +305,9 @@ typedef enum {
 struct JSGCObjectHeader {
     int ref_count; /* must come first, 32-bit */
     JSGCObjectTypeEnum gc_obj_type : 4;
-    uint8_t mark : 4; /* used by the GC */
+    uint8_t mark : 1; /* used by the GC */
+    uint8_t old : 1; /* in gc_obj_list instead of gc_young_obj_list */
+    uint8_t age : 2; /* minor collections survived while young */
     uint8_t dummy1; /* not used by the GC */
     uint16_t dummy2; /* not used by the GC */
     struct list_head link;
@@ -336,6 +359,7 @@ typedef enum {
     JS_AUTOINIT_ID_PROTOTYPE,
     JS_AUTOINIT_ID_MODULE_NS,
     JS_AUTOINIT_ID_PROP,
+    JS_AUTOINIT_ID_LAZY,
 } JSAutoInitIDEnum;
 
 typedef enum JSStrictEqModeEnum {
@@ -347,7 +371,11 @@ typedef enum JSStrictEqModeEnum {
 /* must be large enough to have a negligible runtime cost and small
    enough to call the interrupt callback often. */
 #define JS_INTERRUPT_COUNTER_INIT 10000
-
+/* minor collections survived by a young GC object before it is promoted */
+#define JS_GC_PROMOTION_AGE 2
+/* promotions after which a collection triggered by the allocations is a
+   full one, at least as many as the old objects */
+#define JS_GC_MIN_FULL_PROMOTIONS 8192
 struct JSContext {
     JSGCObjectHeader header; /* must come first */
     JSRuntime *rt;
@@ -395,6 +423,8 @@ struct JSContext {
                              const char *input, size_t input_len,
                              const char *filename, int flags, int scope_idx);
     void *user_opaque;
+    /* set by JS_TerminateExecution(), every poll of the interrupts throws */
+    BOOL terminated;
 };
 
 typedef union JSFloat64Union {
@@ -525,30 +555,43 @@ typedef enum JSFunctionKindEnum {
     JS_FUNC_ASYNC_GENERATOR = (JS_FUNC_GENERATOR | JS_FUNC_ASYNC),
 } JSFunctionKindEnum;
 
-typedef int watchpoint_delete_callback(JSRuntime* rt, intptr_t ref, JSAtom atom, void* target);
-typedef int watchpoint_free_callback(JSRuntime* rt, intptr_t ref, JSAtom atom);
-
-typedef struct ICWatchpoint {
-    intptr_t ref;
-    JSAtom atom;
-    watchpoint_delete_callback *delete_callback;
-    watchpoint_free_callback *free_callback;
-    struct list_head link;
-} ICWatchpoint;
-
+/* deepest prototype chain whose properties are cached */
+#define IC_PROTO_CHAIN_MAX 8
+/* a site evicting more entries than this becomes megamorphic */
+#define IC_MEGAMORPHIC_EVICTIONS 8
+#define IC_MEGAMORPHIC_CACHE_BITS 10
+
+/* A cached property of the objects of 'shape'. When it is found on a
+   prototype, 'proto_shapes' are the shapes of the prototype chain up
+   to the holder of the property. The cache holds a reference to these
+   shapes, which makes them copy on write: any change of the chain
+   gives one of its objects a new shape and invalidates the entry. */
 typedef struct InlineCacheRingItem {
-    JSObject* proto;
     JSShape *shape;
+    JSShape **proto_shapes;
     uint32_t prop_offset;
-    ICWatchpoint *watchpoint_ref;
+    uint8_t proto_depth;
+    uint8_t prop_flags; /* JS_PROP_xxx of the property */
 } InlineCacheRingItem;
 
 typedef struct InlineCacheRingSlot {
     JSAtom atom;
     InlineCacheRingItem buffer[IC_CACHE_ITEM_CAPACITY];
     uint8_t index;
+    /* the shapes overflowed the ring, the runtime wide cache is used */
+    uint8_t megamorphic;
+    uint16_t evictions;
+#ifdef CONFIG_IC_STATS
+    uint32_t hits;
+    uint32_t misses;
+#endif
 } InlineCacheRingSlot;
 
+typedef struct InlineCacheMegamorphicEntry {
+    JSAtom atom;
+    InlineCacheRingItem item;
+} InlineCacheMegamorphicEntry;
+
 typedef struct InlineCacheHashSlot {
     JSAtom atom;
     uint32_t index;
@@ -562,6 +605,7 @@ typedef struct InlineCache {
     JSContext* ctx;
     InlineCacheHashSlot **hash;
     InlineCacheRingSlot *cache;
+    InlineCacheHashSlot *slots; /* hash slots allocated at once by clone_ic(), or NULL */
     uint32_t updated_offset;
     BOOL updated;
 } InlineCache;
@@ -582,7 +626,9 @@ typedef struct JSFunctionBytecode {
     uint8_t has_debug : 1;
     uint8_t backtrace_barrier : 1; /* stop backtrace on this function */
     uint8_t read_only_bytecode : 1;
-    /* XXX: 4 bits available */
+    uint8_t debug_inline : 1; /* the debug buffers are allocated with the function */
+    uint8_t byte_code_allocated : 1; /* byte_code_buf is allocated separately */
+    /* XXX: 2 bits available */
     uint8_t *byte_code_buf; /* (self pointer) */
     int byte_code_len;
     JSAtom func_name;
@@ -597,6 +643,9 @@ typedef struct JSFunctionBytecode {
     int cpool_count;
     int closure_var_count;
     InlineCache *ic;
+    /* the bytecode, debug info, inline cache and constant pool are read
+       from a bundle on the first call when not NULL */
+    struct JSLazyFunctionBody *lazy_body;
     struct {
         /* debug info, move to separate structure to save memory? */
         JSAtom filename;
@@ -848,7 +897,6 @@ struct JSShape {
     int deleted_prop_count;
     JSShape *shape_hash_next; /* in JSRuntime.shape_hash[h] list */
     JSObject *proto;
-    struct list_head *watchpoint;
     JSShapeProperty prop[0]; /* prop_size elements */
 };
 
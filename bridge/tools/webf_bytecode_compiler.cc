@@ -0,0 +1,256 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+// Compiles scripts or ES modules into one bytecode bundle, see bindings/qjs/bytecode_bundle.h.
+//
+// The sources are compiled in parallel, one JSRuntime per worker thread. The compiled functions are then read back in
+// a single runtime and written to the bundle, so that the atoms and the constant strings of all the inputs are written
+// once.
+
+#include <quickjs/quickjs.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include "bindings/qjs/bytecode_bundle.h"
+
+using namespace webf;
+
+namespace {
+
+struct Options {
+  std::string output;
+  std::string root;
+  std::vector<std::string> inputs;
+  std::vector<std::string> entries;
+  bool module{false};
+  bool strip{false};
+  unsigned jobs{0};
+};
+
+struct CompiledInput {
+  std::string name;
+  std::string bytecode;
+  std::string error;
+};
+
+void PrintUsage() {
+  fprintf(stderr,
+          "Usage: webf_bytecode_compiler [options] -o <bundle> <input.js>...\n"
+          "  -o <file>      the bundle to write\n"
+          "  -m, --module   compile the inputs as ES modules, imports are resolved from the bundle\n"
+          "  -e <name>      an entry module, evaluated with the bundle, can be repeated (default: the first input)\n"
+          "  -r <dir>       the directory the names of the inputs are relative to (default: the current directory)\n"
+          "  -s, --strip    strip the file names and the line and column tables\n"
+          "  -j <count>     the number of worker runtimes (default: the number of cores)\n");
+}
+
+bool ParseOptions(int argc, char** argv, Options* options) {
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool has_value = i + 1 < argc;
+    if (arg == "-o" && has_value) {
+      options->output = argv[++i];
+    } else if (arg == "-r" && has_value) {
+      options->root = argv[++i];
+    } else if (arg == "-e" && has_value) {
+      options->entries.emplace_back(argv[++i]);
+    } else if (arg == "-j" && has_value) {
+      options->jobs = static_cast<unsigned>(std::max(atoi(argv[++i]), 1));
+    } else if (arg == "-m" || arg == "--module") {
+      options->module = true;
+    } else if (arg == "-s" || arg == "--strip") {
+      options->strip = true;
+    } else if (!arg.empty() && arg[0] == '-') {
+      return false;
+    } else {
+      options->inputs.push_back(arg);
+    }
+  }
+  return !options->output.empty() && !options->inputs.empty();
+}
+
+// The name of a module is its path relative to the root, which is also how QuickJS resolves relative imports.
+std::string NameOf(const std::string& path, const std::string& root) {
+  std::string name = path;
+  std::replace(name.begin(), name.end(), '\\', '/');
+  std::string prefix = root;
+  std::replace(prefix.begin(), prefix.end(), '\\', '/');
+  if (!prefix.empty() && prefix.back() != '/')
+    prefix += '/';
+  if (!prefix.empty() && name.compare(0, prefix.size(), prefix) == 0)
+    name = name.substr(prefix.size());
+  while (name.compare(0, 2, "./") == 0)
+    name = name.substr(2);
+  return name;
+}
+
+std::string ExceptionMessage(JSContext* ctx) {
+  JSValue exception = JS_GetException(ctx);
+  const char* chars = JS_ToCString(ctx, exception);
+  std::string message = chars != nullptr ? chars : "unknown error";
+  JS_FreeCString(ctx, chars);
+  JS_FreeValue(ctx, exception);
+  return message;
+}
+
+// Compiling a module resolves its imports. The imported modules are compiled by their own worker, the workers only
+// check that they are part of the bundle.
+JSModuleDef* LoadPlaceholderModule(JSContext* ctx, const char* module_name, void* opaque) {
+  auto* names = static_cast<const std::unordered_set<std::string>*>(opaque);
+  if (names->count(module_name) == 0) {
+    JS_ThrowReferenceError(ctx, "could not find module '%s' in the inputs", module_name);
+    return nullptr;
+  }
+  return JS_NewCModule(ctx, module_name, [](JSContext* ctx, JSModuleDef* m) { return 0; });
+}
+
+void Compile(const Options& options, CompiledInput* input, const std::string& path, JSContext* ctx) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    input->error = "can't read the file";
+    return;
+  }
+  std::stringstream source;
+  source << file.rdbuf();
+  std::string code = source.str();
+
+  int flags = (options.module ? JS_EVAL_TYPE_MODULE : JS_EVAL_TYPE_GLOBAL) | JS_EVAL_FLAG_COMPILE_ONLY;
+  if (options.strip)
+    flags |= JS_EVAL_FLAG_STRIP;
+  JSValue function = JS_Eval(ctx, code.c_str(), code.size(), input->name.c_str(), flags);
+  if (JS_IsException(function)) {
+    input->error = ExceptionMessage(ctx);
+    return;
+  }
+  size_t length;
+  uint8_t* bytes = JS_WriteObject(ctx, &length, function, JS_WRITE_OBJ_BYTECODE);
+  JS_FreeValue(ctx, function);
+  if (bytes == nullptr) {
+    input->error = ExceptionMessage(ctx);
+    return;
+  }
+  input->bytecode.assign(reinterpret_cast<char*>(bytes), length);
+  js_free(ctx, bytes);
+}
+
+void CompileInParallel(const Options& options, std::vector<CompiledInput>* inputs) {
+  std::unordered_set<std::string> names;
+  for (auto& input : *inputs) {
+    names.insert(input.name);
+  }
+  std::atomic<size_t> next_input{0};
+  unsigned jobs = options.jobs != 0 ? options.jobs : std::max(std::thread::hardware_concurrency(), 1u);
+  jobs = std::min<unsigned>(jobs, inputs->size());
+
+  std::vector<std::thread> workers;
+  for (unsigned i = 0; i < jobs; i++) {
+    workers.emplace_back([&]() {
+      JSRuntime* runtime = JS_NewRuntime();
+      JSContext* ctx = JS_NewContext(runtime);
+      JS_SetModuleLoaderFunc(runtime, nullptr, LoadPlaceholderModule, &names);
+      for (size_t index = next_input++; index < inputs->size(); index = next_input++) {
+        Compile(options, &(*inputs)[index], options.inputs[index], ctx);
+      }
+      JS_FreeContext(ctx);
+      JS_FreeRuntime(runtime);
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
+
+bool WriteBundle(const Options& options, const std::vector<CompiledInput>& inputs) {
+  JSRuntime* runtime = JS_NewRuntime();
+  JSContext* ctx = JS_NewContext(runtime);
+  bool success = true;
+  std::string bundle;
+  {
+    BytecodeBundleWriter writer(ctx);
+    for (size_t i = 0; i < inputs.size() && success; i++) {
+      uint32_t flags = 0;
+      if (options.module) {
+        flags |= BytecodeBundle::kModule;
+        bool entry = options.entries.empty() ? i == 0
+                                             : std::find(options.entries.begin(), options.entries.end(),
+                                                         inputs[i].name) != options.entries.end();
+        if (entry)
+          flags |= BytecodeBundle::kEntry;
+      } else {
+        // Scripts are evaluated in the order of the inputs.
+        flags |= BytecodeBundle::kEntry;
+      }
+
+      auto* bytes = reinterpret_cast<const uint8_t*>(inputs[i].bytecode.data());
+      JSValue object = JS_ReadObject(ctx, bytes, inputs[i].bytecode.size(), JS_READ_OBJ_BYTECODE);
+      success = !JS_IsException(object) && writer.Add(inputs[i].name, flags, object);
+      JS_FreeValue(ctx, object);
+      if (!success)
+        fprintf(stderr, "%s: %s\n", inputs[i].name.c_str(), ExceptionMessage(ctx).c_str());
+    }
+    if (success) {
+      bundle = writer.Finish();
+      success = !bundle.empty();
+      if (!success)
+        fprintf(stderr, "%s: %s\n", options.output.c_str(), ExceptionMessage(ctx).c_str());
+    }
+  }
+  JS_FreeContext(ctx);
+  JS_FreeRuntime(runtime);
+  if (!success)
+    return false;
+
+  std::ofstream file(options.output, std::ios::binary | std::ios::trunc);
+  file.write(bundle.data(), static_cast<std::streamsize>(bundle.size()));
+  if (!file) {
+    fprintf(stderr, "%s: can't write the file\n", options.output.c_str());
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!ParseOptions(argc, argv, &options)) {
+    PrintUsage();
+    return 1;
+  }
+
+  std::vector<CompiledInput> inputs(options.inputs.size());
+  for (size_t i = 0; i < inputs.size(); i++) {
+    inputs[i].name = NameOf(options.inputs[i], options.root);
+  }
+
+  // An entry which is not one of the inputs would leave the bundle without it, silently.
+  for (auto& entry : options.entries) {
+    entry = NameOf(entry, options.root);
+    if (std::none_of(inputs.begin(), inputs.end(), [&](const CompiledInput& input) { return input.name == entry; })) {
+      fprintf(stderr, "%s: the entry is not one of the inputs\n", entry.c_str());
+      return 1;
+    }
+  }
+
+  CompileInParallel(options, &inputs);
+
+  bool success = true;
+  for (auto& input : inputs) {
+    if (!input.error.empty()) {
+      fprintf(stderr, "%s: %s\n", input.name.c_str(), input.error.c_str());
+      success = false;
+    }
+  }
+  if (!success || !WriteBundle(options, inputs))
+    return 1;
+  return 0;
+}
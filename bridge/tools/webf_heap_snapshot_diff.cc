@@ -0,0 +1,643 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+// Compares two heap snapshots, written by core/heap_snapshot.h or by Chrome DevTools, and prints the classes of objects
+// which grow between them: their count, their self size, the size they retain, and the objects which are new in the
+// second snapshot. Taking the first snapshot after the page warmed up and the second after repeating the action
+// suspected to leak shows what the action leaves behind.
+//
+// The retained sizes are computed from the dominator tree of the snapshot, as DevTools does. The retained size of a
+// class does not count twice the objects retained by other objects of the same class.
+//
+// The new objects are the ones whose id is not in the first snapshot. core/heap_snapshot.h keeps the ids of the objects
+// but identifies the strings by their address, so a new string allocated where a freed one was is not counted as new.
+
+#include <algorithm>
+#include <cctype>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+struct Options {
+  std::string before;
+  std::string after;
+  size_t limit{30};
+  enum class Sort { kSelfSize, kRetainedSize, kCount } sort{Sort::kSelfSize};
+  bool all{false};
+};
+
+void PrintUsage() {
+  fprintf(stderr,
+          "Usage: webf_heap_snapshot_diff [options] <before.heapsnapshot> <after.heapsnapshot>\n"
+          "  -n <count>       the number of classes to print (default: 30)\n"
+          "  -s <column>      sort by the growth of: self (default), retained or count\n"
+          "  -a, --all        print the classes which shrink too\n");
+}
+
+bool ParseOptions(int argc, char** argv, Options* options) {
+  std::vector<std::string> inputs;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool has_value = i + 1 < argc;
+    if (arg == "-n" && has_value) {
+      options->limit = strtoul(argv[++i], nullptr, 10);
+    } else if (arg == "-s" && has_value) {
+      std::string column = argv[++i];
+      if (column == "self") {
+        options->sort = Options::Sort::kSelfSize;
+      } else if (column == "retained") {
+        options->sort = Options::Sort::kRetainedSize;
+      } else if (column == "count") {
+        options->sort = Options::Sort::kCount;
+      } else {
+        return false;
+      }
+    } else if (arg == "-a" || arg == "--all") {
+      options->all = true;
+    } else if (arg == "-h" || arg == "--help" || arg[0] == '-') {
+      return false;
+    } else {
+      inputs.push_back(arg);
+    }
+  }
+  if (inputs.size() != 2)
+    return false;
+  options->before = inputs[0];
+  options->after = inputs[1];
+  return true;
+}
+
+// Reads the parts of the snapshot JSON which are used here. The "snapshot" object is small and read as a tree, the
+// arrays of numbers and strings are read directly.
+class JsonReader {
+ public:
+  struct Value {
+    enum class Type { kNull, kBool, kNumber, kString, kArray, kObject } type{Type::kNull};
+    double number{0};
+    std::string string;
+    std::vector<Value> array;
+    std::vector<std::pair<std::string, Value>> object;
+
+    const Value* Get(const std::string& key) const {
+      for (auto& member : object) {
+        if (member.first == key)
+          return &member.second;
+      }
+      return nullptr;
+    }
+  };
+
+  explicit JsonReader(const std::string& json) : json_(json) {}
+
+  bool failed() const { return failed_; }
+
+  // Calls |on_member| with each key of the object, which must read or skip the value.
+  template <typename Callback>
+  void ReadObject(Callback&& on_member) {
+    if (!Consume('{'))
+      return;
+    if (Peek() == '}') {
+      pos_++;
+      return;
+    }
+    do {
+      std::string key = ReadString();
+      if (!Consume(':'))
+        return;
+      on_member(key);
+    } while (!failed_ && Peek() == ',' && ++pos_);
+    Consume('}');
+  }
+
+  Value ReadValue() {
+    Value value;
+    char c = Peek();
+    if (c == '{') {
+      value.type = Value::Type::kObject;
+      ReadObject([&](const std::string& key) { value.object.emplace_back(key, ReadValue()); });
+    } else if (c == '[') {
+      value.type = Value::Type::kArray;
+      ReadArray([&]() { value.array.push_back(ReadValue()); });
+    } else if (c == '"') {
+      value.type = Value::Type::kString;
+      value.string = ReadString();
+    } else if (c == 't' || c == 'f' || c == 'n') {
+      size_t length = c == 'f' ? 5 : 4;
+      value.type = c == 'n' ? Value::Type::kNull : Value::Type::kBool;
+      value.number = c == 't';
+      pos_ += length;
+    } else {
+      value.type = Value::Type::kNumber;
+      value.number = ReadNumber();
+    }
+    return value;
+  }
+
+  void ReadNumbers(std::vector<uint64_t>* numbers) {
+    ReadArray([&]() { numbers->push_back(static_cast<uint64_t>(ReadNumber())); });
+  }
+
+  void ReadStrings(std::vector<std::string>* strings) {
+    ReadArray([&]() { strings->push_back(ReadString()); });
+  }
+
+ private:
+  template <typename Callback>
+  void ReadArray(Callback&& on_element) {
+    if (!Consume('['))
+      return;
+    if (Peek() == ']') {
+      pos_++;
+      return;
+    }
+    do {
+      on_element();
+    } while (!failed_ && Peek() == ',' && ++pos_);
+    Consume(']');
+  }
+
+  char Peek() {
+    while (pos_ < json_.size() && isspace(static_cast<unsigned char>(json_[pos_])))
+      pos_++;
+    if (pos_ >= json_.size()) {
+      failed_ = true;
+      return '\0';
+    }
+    return json_[pos_];
+  }
+
+  bool Consume(char c) {
+    if (Peek() != c) {
+      failed_ = true;
+      return false;
+    }
+    pos_++;
+    return true;
+  }
+
+  double ReadNumber() {
+    Peek();
+    const char* start = json_.c_str() + pos_;
+    char* end;
+    double number = strtod(start, &end);
+    if (end == start)
+      failed_ = true;
+    pos_ += end - start;
+    return number;
+  }
+
+  // The characters escaped as \uXXXX are written in UTF-8.
+  std::string ReadString() {
+    std::string result;
+    if (!Consume('"'))
+      return result;
+    while (pos_ < json_.size() && json_[pos_] != '"') {
+      char c = json_[pos_++];
+      if (c != '\\') {
+        result += c;
+        continue;
+      }
+      if (pos_ >= json_.size())
+        break;
+      c = json_[pos_++];
+      switch (c) {
+        case 'n':
+          result += '\n';
+          break;
+        case 't':
+          result += '\t';
+          break;
+        case 'r':
+          result += '\r';
+          break;
+        case 'b':
+          result += '\b';
+          break;
+        case 'f':
+          result += '\f';
+          break;
+        case 'u': {
+          uint32_t code = strtoul(json_.substr(pos_, 4).c_str(), nullptr, 16);
+          pos_ += 4;
+          if (code < 0x80) {
+            result += static_cast<char>(code);
+          } else if (code < 0x800) {
+            result += static_cast<char>(0xc0 | (code >> 6));
+            result += static_cast<char>(0x80 | (code & 0x3f));
+          } else {
+            result += static_cast<char>(0xe0 | (code >> 12));
+            result += static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+            result += static_cast<char>(0x80 | (code & 0x3f));
+          }
+        } break;
+        default:
+          result += c;
+          break;
+      }
+    }
+    Consume('"');
+    return result;
+  }
+
+  const std::string& json_;
+  size_t pos_{0};
+  bool failed_{false};
+};
+
+struct Snapshot {
+  std::vector<std::string> node_types;
+  std::vector<std::string> edge_types;
+  size_t node_field_count{0};
+  size_t edge_field_count{0};
+  // The offsets of the fields in a node or an edge.
+  size_t type_field{0}, name_field{0}, id_field{0}, self_size_field{0}, edge_count_field{0};
+  size_t edge_type_field{0}, to_node_field{0};
+
+  std::vector<uint64_t> nodes;
+  std::vector<uint64_t> edges;
+  std::vector<std::string> strings;
+
+  // Computed after reading.
+  std::vector<uint32_t> first_edge;
+  std::vector<uint32_t> dominator;
+  std::vector<uint64_t> retained_size;
+  std::vector<uint32_t> class_of_node;
+  std::vector<std::string> class_names;
+
+  size_t node_count() const { return nodes.size() / node_field_count; }
+  uint64_t node_field(size_t node, size_t field) const { return nodes[node * node_field_count + field]; }
+  const std::string& node_type(size_t node) const {
+    uint64_t type = node_field(node, type_field);
+    static const std::string kUnknown = "unknown";
+    return type < node_types.size() ? node_types[type] : kUnknown;
+  }
+};
+
+bool FieldIndex(const JsonReader::Value* fields, const char* name, size_t* index) {
+  if (fields == nullptr)
+    return false;
+  for (size_t i = 0; i < fields->array.size(); i++) {
+    if (fields->array[i].string == name) {
+      *index = i;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ReadSnapshot(const std::string& path, Snapshot* snapshot) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    fprintf(stderr, "Cannot read %s\n", path.c_str());
+    return false;
+  }
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  std::string json = buffer.str();
+
+  JsonReader reader(json);
+  JsonReader::Value meta_holder;
+  reader.ReadObject([&](const std::string& key) {
+    if (key == "snapshot") {
+      meta_holder = reader.ReadValue();
+    } else if (key == "nodes") {
+      reader.ReadNumbers(&snapshot->nodes);
+    } else if (key == "edges") {
+      reader.ReadNumbers(&snapshot->edges);
+    } else if (key == "strings") {
+      reader.ReadStrings(&snapshot->strings);
+    } else {
+      reader.ReadValue();
+    }
+  });
+
+  const JsonReader::Value* meta = meta_holder.Get("meta");
+  if (reader.failed() || meta == nullptr) {
+    fprintf(stderr, "%s is not a heap snapshot\n", path.c_str());
+    return false;
+  }
+  const JsonReader::Value* node_fields = meta->Get("node_fields");
+  const JsonReader::Value* edge_fields = meta->Get("edge_fields");
+  const JsonReader::Value* node_types = meta->Get("node_types");
+  const JsonReader::Value* edge_types = meta->Get("edge_types");
+  if (!FieldIndex(node_fields, "type", &snapshot->type_field) ||
+      !FieldIndex(node_fields, "name", &snapshot->name_field) || !FieldIndex(node_fields, "id", &snapshot->id_field) ||
+      !FieldIndex(node_fields, "self_size", &snapshot->self_size_field) ||
+      !FieldIndex(node_fields, "edge_count", &snapshot->edge_count_field) ||
+      !FieldIndex(edge_fields, "type", &snapshot->edge_type_field) ||
+      !FieldIndex(edge_fields, "to_node", &snapshot->to_node_field) || node_types == nullptr ||
+      node_types->array.empty() || edge_types == nullptr || edge_types->array.empty()) {
+    fprintf(stderr, "%s has an unknown meta\n", path.c_str());
+    return false;
+  }
+  for (auto& type : node_types->array[0].array)
+    snapshot->node_types.push_back(type.string);
+  for (auto& type : edge_types->array[0].array)
+    snapshot->edge_types.push_back(type.string);
+  snapshot->node_field_count = node_fields->array.size();
+  snapshot->edge_field_count = edge_fields->array.size();
+
+  size_t node_count = snapshot->node_count();
+  snapshot->first_edge.resize(node_count + 1);
+  for (size_t i = 0; i < node_count; i++) {
+    snapshot->first_edge[i + 1] =
+        snapshot->first_edge[i] + snapshot->node_field(i, snapshot->edge_count_field);
+  }
+  if (node_count == 0 || snapshot->first_edge[node_count] * snapshot->edge_field_count != snapshot->edges.size()) {
+    fprintf(stderr, "%s has inconsistent edges\n", path.c_str());
+    return false;
+  }
+  return true;
+}
+
+// The immediate dominators of the nodes reachable from the root, the node 0, by the algorithm of Cooper, Harvey and
+// Kennedy, "A Simple, Fast Dominance Algorithm". The weak and the shortcut edges do not retain.
+void ComputeDominators(Snapshot* snapshot) {
+  const uint32_t kUnreachable = UINT32_MAX;
+  size_t node_count = snapshot->node_count();
+  std::vector<bool> retaining(snapshot->edge_types.size(), true);
+  for (size_t i = 0; i < snapshot->edge_types.size(); i++)
+    retaining[i] = snapshot->edge_types[i] != "weak" && snapshot->edge_types[i] != "shortcut";
+
+  auto for_each_child = [&](uint32_t node, auto&& callback) {
+    for (uint32_t edge = snapshot->first_edge[node]; edge < snapshot->first_edge[node + 1]; edge++) {
+      const uint64_t* fields = &snapshot->edges[edge * snapshot->edge_field_count];
+      uint64_t type = fields[snapshot->edge_type_field];
+      if (type < retaining.size() && !retaining[type])
+        continue;
+      callback(static_cast<uint32_t>(fields[snapshot->to_node_field] / snapshot->node_field_count));
+    }
+  };
+
+  // The post order of a depth first walk from the root.
+  std::vector<uint32_t> post_order;
+  std::vector<uint32_t> order(node_count, kUnreachable);
+  {
+    std::vector<std::pair<uint32_t, uint32_t>> stack;  // node, next edge
+    std::vector<bool> visited(node_count);
+    visited[0] = true;
+    stack.emplace_back(0, snapshot->first_edge[0]);
+    while (!stack.empty()) {
+      auto& top = stack.back();
+      if (top.second == snapshot->first_edge[top.first + 1]) {
+        order[top.first] = post_order.size();
+        post_order.push_back(top.first);
+        stack.pop_back();
+        continue;
+      }
+      const uint64_t* fields = &snapshot->edges[top.second++ * snapshot->edge_field_count];
+      uint64_t type = fields[snapshot->edge_type_field];
+      uint32_t child = fields[snapshot->to_node_field] / snapshot->node_field_count;
+      if ((type < retaining.size() && !retaining[type]) || visited[child])
+        continue;
+      visited[child] = true;
+      stack.emplace_back(child, snapshot->first_edge[child]);
+    }
+  }
+
+  // The retainers of each node, in a compressed array.
+  std::vector<uint32_t> first_retainer(node_count + 1);
+  for (uint32_t node : post_order)
+    for_each_child(node, [&](uint32_t child) { first_retainer[child + 1]++; });
+  for (size_t i = 0; i < node_count; i++)
+    first_retainer[i + 1] += first_retainer[i];
+  std::vector<uint32_t> retainers(first_retainer[node_count]);
+  {
+    std::vector<uint32_t> next(first_retainer.begin(), first_retainer.end() - 1);
+    for (uint32_t node : post_order)
+      for_each_child(node, [&](uint32_t child) { retainers[next[child]++] = node; });
+  }
+
+  std::vector<uint32_t>& dominator = snapshot->dominator;
+  dominator.assign(node_count, kUnreachable);
+  dominator[0] = 0;
+  auto intersect = [&](uint32_t a, uint32_t b) {
+    while (a != b) {
+      while (order[a] < order[b])
+        a = dominator[a];
+      while (order[b] < order[a])
+        b = dominator[b];
+    }
+    return a;
+  };
+  for (bool changed = true; changed;) {
+    changed = false;
+    // Reverse post order, without the root.
+    for (size_t i = post_order.size() - 1; i-- > 0;) {
+      uint32_t node = post_order[i];
+      uint32_t new_dominator = kUnreachable;
+      for (uint32_t r = first_retainer[node]; r < first_retainer[node + 1]; r++) {
+        uint32_t retainer = retainers[r];
+        if (dominator[retainer] == kUnreachable)
+          continue;
+        new_dominator = new_dominator == kUnreachable ? retainer : intersect(retainer, new_dominator);
+      }
+      if (dominator[node] != new_dominator) {
+        dominator[node] = new_dominator;
+        changed = true;
+      }
+    }
+  }
+
+  // The dominators come after the nodes they dominate in the post order.
+  snapshot->retained_size.assign(node_count, 0);
+  for (size_t i = 0; i < node_count; i++)
+    snapshot->retained_size[i] = snapshot->node_field(i, snapshot->self_size_field);
+  for (uint32_t node : post_order) {
+    if (node != 0)
+      snapshot->retained_size[dominator[node]] += snapshot->retained_size[node];
+  }
+}
+
+// The name the nodes are grouped by, as in the Summary view of DevTools.
+std::string ClassName(const Snapshot& snapshot, size_t node) {
+  const std::string& type = snapshot.node_type(node);
+  uint64_t name = snapshot.node_field(node, snapshot.name_field);
+  const std::string& node_name = name < snapshot.strings.size() ? snapshot.strings[name] : "";
+  if (type == "object" || type == "array" || type == "regexp")
+    return node_name;
+  if (type == "native")
+    return node_name + " (native)";
+  if (type == "closure")
+    return node_name + "()";
+  if (type == "string" || type == "concatenated string" || type == "sliced string")
+    return "(string)";
+  if (type == "code")
+    return "(compiled code)";
+  // Such as "(realm)" or "(closure variable)".
+  if (!node_name.empty() && node_name[0] == '(')
+    return node_name;
+  return "(" + type + ")";
+}
+
+struct ClassStats {
+  int64_t count{0};
+  int64_t self_size{0};
+  int64_t retained_size{0};
+  int64_t new_count{0};
+  int64_t deleted_count{0};
+};
+
+// Adds the nodes of |snapshot| to |stats| with |sign|. The retained size of a class only counts the nodes which are
+// not dominated by another node of the class.
+void AddStats(Snapshot* snapshot, int sign, std::unordered_map<std::string, ClassStats>* stats) {
+  size_t node_count = snapshot->node_count();
+  std::unordered_map<std::string, uint32_t> class_ids;
+  snapshot->class_of_node.resize(node_count);
+  for (size_t i = 0; i < node_count; i++) {
+    auto inserted = class_ids.emplace(ClassName(*snapshot, i), class_ids.size());
+    if (inserted.second)
+      snapshot->class_names.push_back(inserted.first->first);
+    snapshot->class_of_node[i] = inserted.first->second;
+  }
+
+  std::vector<uint32_t> first_child(node_count + 1);
+  for (size_t i = 1; i < node_count; i++) {
+    if (snapshot->dominator[i] != UINT32_MAX)
+      first_child[snapshot->dominator[i] + 1]++;
+  }
+  for (size_t i = 0; i < node_count; i++)
+    first_child[i + 1] += first_child[i];
+  std::vector<uint32_t> children(first_child[node_count]);
+  {
+    std::vector<uint32_t> next(first_child.begin(), first_child.end() - 1);
+    for (size_t i = 1; i < node_count; i++) {
+      if (snapshot->dominator[i] != UINT32_MAX)
+        children[next[snapshot->dominator[i]]++] = i;
+    }
+  }
+
+  std::vector<int64_t> retained_by_class(snapshot->class_names.size());
+  std::vector<uint32_t> active(snapshot->class_names.size());
+  std::vector<std::pair<uint32_t, uint32_t>> stack;  // node, next child
+  stack.emplace_back(0, first_child[0]);
+  active[snapshot->class_of_node[0]]++;
+  while (!stack.empty()) {
+    auto& top = stack.back();
+    if (top.second == first_child[top.first + 1]) {
+      active[snapshot->class_of_node[top.first]]--;
+      stack.pop_back();
+      continue;
+    }
+    uint32_t child = children[top.second++];
+    uint32_t class_id = snapshot->class_of_node[child];
+    if (active[class_id]++ == 0)
+      retained_by_class[class_id] += snapshot->retained_size[child];
+    stack.emplace_back(child, first_child[child]);
+  }
+
+  for (size_t i = 0; i < node_count; i++) {
+    if (snapshot->dominator[i] == UINT32_MAX)
+      continue;
+    ClassStats& entry = (*stats)[snapshot->class_names[snapshot->class_of_node[i]]];
+    entry.count += sign;
+    entry.self_size += sign * static_cast<int64_t>(snapshot->node_field(i, snapshot->self_size_field));
+  }
+  for (size_t i = 0; i < retained_by_class.size(); i++)
+    (*stats)[snapshot->class_names[i]].retained_size += sign * retained_by_class[i];
+}
+
+// The reachable nodes of |snapshot| whose id is not one of the reachable nodes of |other| with the same class.
+void CountNewNodes(const Snapshot& snapshot,
+                   const Snapshot& other,
+                   int64_t ClassStats::*field,
+                   std::unordered_map<std::string, ClassStats>* stats) {
+  std::unordered_map<uint64_t, uint32_t> other_ids;
+  for (size_t i = 0; i < other.node_count(); i++) {
+    if (other.dominator[i] != UINT32_MAX)
+      other_ids.emplace(other.node_field(i, other.id_field), other.class_of_node[i]);
+  }
+  for (size_t i = 0; i < snapshot.node_count(); i++) {
+    if (snapshot.dominator[i] == UINT32_MAX)
+      continue;
+    const std::string& class_name = snapshot.class_names[snapshot.class_of_node[i]];
+    auto it = other_ids.find(snapshot.node_field(i, snapshot.id_field));
+    if (it == other_ids.end() || other.class_names[it->second] != class_name)
+      (*stats)[class_name].*field += 1;
+  }
+}
+
+void PrintTotals(const char* label, const Snapshot& snapshot) {
+  int64_t count = 0, size = 0;
+  for (size_t i = 0; i < snapshot.node_count(); i++) {
+    if (snapshot.dominator[i] == UINT32_MAX)
+      continue;
+    count++;
+    size += snapshot.node_field(i, snapshot.self_size_field);
+  }
+  printf("%-8s %10" PRId64 " objects %14" PRId64 " bytes\n", label, count, size);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!ParseOptions(argc, argv, &options)) {
+    PrintUsage();
+    return 1;
+  }
+
+  Snapshot before, after;
+  if (!ReadSnapshot(options.before, &before) || !ReadSnapshot(options.after, &after))
+    return 1;
+  ComputeDominators(&before);
+  ComputeDominators(&after);
+
+  std::unordered_map<std::string, ClassStats> stats;
+  AddStats(&before, -1, &stats);
+  AddStats(&after, 1, &stats);
+  CountNewNodes(after, before, &ClassStats::new_count, &stats);
+  CountNewNodes(before, after, &ClassStats::deleted_count, &stats);
+
+  auto key = [&](const ClassStats& entry) {
+    switch (options.sort) {
+      case Options::Sort::kRetainedSize:
+        return entry.retained_size;
+      case Options::Sort::kCount:
+        return entry.count;
+      default:
+        return entry.self_size;
+    }
+  };
+  std::vector<std::pair<std::string, ClassStats>> rows;
+  for (auto& entry : stats) {
+    const ClassStats& s = entry.second;
+    bool changed = s.count != 0 || s.self_size != 0 || s.retained_size != 0 || s.new_count != 0;
+    if (changed && (options.all || key(s) > 0 || (key(s) == 0 && s.new_count > 0)))
+      rows.emplace_back(entry.first, s);
+  }
+  std::sort(rows.begin(), rows.end(), [&](const auto& a, const auto& b) {
+    if (key(a.second) != key(b.second))
+      return key(a.second) > key(b.second);
+    return a.first < b.first;
+  });
+  if (rows.size() > options.limit)
+    rows.resize(options.limit);
+
+  PrintTotals("Before", before);
+  PrintTotals("After", after);
+  printf("\n%-40s %10s %10s %10s %14s %14s\n", "Class", "# Delta", "# New", "# Deleted", "Self delta",
+         "Retained delta");
+  bool has_strings = false;
+  for (auto& row : rows) {
+    std::string name = row.first.size() > 40 ? row.first.substr(0, 37) + "..." : row.first;
+    const ClassStats& s = row.second;
+    printf("%-40s %+10" PRId64 " %10" PRId64 " %10" PRId64 " %+14" PRId64 " %+14" PRId64 "\n", name.c_str(), s.count,
+           s.new_count, s.deleted_count, s.self_size, s.retained_size);
+    has_strings |= row.first == "(string)";
+  }
+  if (has_strings) {
+    printf(
+        "\nThe WebF snapshots identify the strings by their address: a string allocated where a freed one was is not "
+        "counted in # New and # Deleted of (string).\n");
+  }
+  return 0;
+}
@@ -3,8 +3,10 @@
  */
 
 #include "include/webf_bridge.h"
+#include "bindings/qjs/bytecode_cache.h"
 #include "core/api/api.h"
 #include "core/dart_isolate_context.h"
+#include "core/heap_snapshot.h"
 #include "core/html/parser/html_parser.h"
 #include "core/page.h"
 #include "foundation/native_type.h"
@@ -94,6 +96,39 @@ void allocateNewPage(double thread_identity,
 #endif
 }
 
+void prewarmPage(double thread_identity,
+                 int32_t sync_buffer_size,
+                 void* ptr,
+                 Dart_Handle dart_handle,
+                 AllocateNewPageCallback result_callback) {
+#if ENABLE_LOG
+  WEBF_LOG(INFO) << "[Dispatcher]: prewarmPage Call BEGIN";
+#endif
+  auto* dart_isolate_context = (webf::DartIsolateContext*)ptr;
+  assert(dart_isolate_context != nullptr);
+  Dart_PersistentHandle persistent_handle = Dart_NewPersistentHandle_DL(dart_handle);
+
+  dart_isolate_context->PrewarmPage(thread_identity, sync_buffer_size, persistent_handle, result_callback);
+#if ENABLE_LOG
+  WEBF_LOG(INFO) << "[Dispatcher]: prewarmPage Call END";
+#endif
+}
+
+void* prewarmPageSync(double thread_identity, void* ptr) {
+#if ENABLE_LOG
+  WEBF_LOG(INFO) << "[Dispatcher]: prewarmPageSync Call BEGIN";
+#endif
+  auto* dart_isolate_context = (webf::DartIsolateContext*)ptr;
+  assert(dart_isolate_context != nullptr);
+
+  void* result = dart_isolate_context->PrewarmPageSync(thread_identity);
+#if ENABLE_LOG
+  WEBF_LOG(INFO) << "[Dispatcher]: prewarmPageSync Call END";
+#endif
+
+  return result;
+}
+
 void disposePage(double thread_identity,
                  void* ptr,
                  void* page_,
@@ -182,6 +217,21 @@ void evaluateQuickjsByteCode(void* page_,
                                                      profile_id, persistent_handle, result_callback);
 }
 
+void evaluateQuickjsByteCodeFile(void* page_,
+                                 const char* path,
+                                 int64_t profile_id,
+                                 Dart_Handle dart_handle,
+                                 EvaluateQuickjsByteCodeCallback result_callback) {
+#if ENABLE_LOG
+  WEBF_LOG(VERBOSE) << "[Dart] evaluateQuickjsByteCodeFileWrapper call" << std::endl;
+#endif
+  auto page = reinterpret_cast<webf::WebFPage*>(page_);
+  Dart_PersistentHandle persistent_handle = Dart_NewPersistentHandle_DL(dart_handle);
+  page->dartIsolateContext()->dispatcher()->PostToJs(page->isDedicated(), page->contextId(),
+                                                     webf::evaluateQuickjsByteCodeFileInternal, page_, path,
+                                                     profile_id, persistent_handle, result_callback);
+}
+
 void parseHTML(void* page_,
                char* code,
                int32_t length,
@@ -200,10 +250,12 @@ void parseHTML(void* page_,
 
 void registerPluginByteCode(uint8_t* bytes, int32_t length, const char* pluginName) {
   webf::ExecutingContext::plugin_byte_code[pluginName] = webf::NativeByteCode{bytes, length};
+  webf::ExecutingContext::plugin_generation++;
 }
 
 void registerPluginCode(const char* code, int32_t length, const char* pluginName) {
   webf::ExecutingContext::plugin_string_code[pluginName] = std::string(code, length);
+  webf::ExecutingContext::plugin_generation++;
 }
 
 static WebFInfo* webfInfo{nullptr};
@@ -245,6 +297,95 @@ void invokeModuleEvent(void* page_,
                                                eventType, event, extra, persistent_handle, result_callback);
 }
 
+void freeNativeByteBuffer(NativeByteBuffer* buffer) {
+  webf::FreeNativeByteBuffer(reinterpret_cast<webf::NativeByteBuffer*>(buffer));
+}
+
+void setLocalStorageDirectory(void* page_,
+                              const char* directory,
+                              const char** legacy_keys,
+                              const char** legacy_values,
+                              int32_t legacy_length) {
+  auto page = reinterpret_cast<webf::WebFPage*>(page_);
+  // The strings are owned by dart, copy them before leaving the dart thread.
+  std::vector<std::pair<std::string, std::string>> legacy_entries;
+  legacy_entries.reserve(legacy_length);
+  for (int32_t i = 0; i < legacy_length; i++) {
+    legacy_entries.emplace_back(legacy_keys[i], legacy_values[i]);
+  }
+  page->dartIsolateContext()->dispatcher()->PostToJs(
+      page->isDedicated(), page->contextId(),
+      [](webf::WebFPage* page, const std::string& directory,
+         const std::vector<std::pair<std::string, std::string>>& legacy_entries) {
+        page->executingContext()->SetLocalStorageDirectory(directory, legacy_entries);
+      },
+      page, std::string(directory), std::move(legacy_entries));
+}
+
+void setBytecodeCacheDirectory(const char* directory, int64_t max_bytes) {
+  webf::BytecodeCache::Configure(directory, max_bytes > 0 ? static_cast<size_t>(max_bytes)
+                                                          : webf::BytecodeCache::kDefaultMaxBytes);
+}
+
+void notifyIdle(void* page_, int64_t idle_time_us) {
+  auto page = reinterpret_cast<webf::WebFPage*>(page_);
+  page->dartIsolateContext()->dispatcher()->PostToJs(
+      page->isDedicated(), page->contextId(),
+      [](webf::WebFPage* page, int64_t idle_time_us) {
+        page->dartIsolateContext()->gcScheduler()->NotifyIdle(idle_time_us);
+      },
+      page, idle_time_us);
+}
+
+void notifyMemoryPressure(void* page_, int32_t level) {
+  auto page = reinterpret_cast<webf::WebFPage*>(page_);
+  page->dartIsolateContext()->dispatcher()->PostToJs(
+      page->isDedicated(), page->contextId(),
+      [](webf::WebFPage* page, int32_t level) {
+        page->dartIsolateContext()->gcScheduler()->NotifyMemoryPressure(static_cast<webf::MemoryPressureLevel>(level));
+      },
+      page, level);
+}
+
+void setPageMemoryBudget(void* page_, int64_t bytes) {
+  auto page = reinterpret_cast<webf::WebFPage*>(page_);
+  page->dartIsolateContext()->dispatcher()->PostToJs(
+      page->isDedicated(), page->contextId(),
+      [](webf::WebFPage* page, int64_t bytes) {
+        page->dartIsolateContext()->gcScheduler()->SetPageMemoryBudget(page->contextId(), bytes);
+      },
+      page, bytes);
+}
+
+void setPageMemoryLimits(void* page_, int64_t soft_limit, int64_t hard_limit) {
+  auto page = reinterpret_cast<webf::WebFPage*>(page_);
+  page->dartIsolateContext()->dispatcher()->PostToJs(
+      page->isDedicated(), page->contextId(),
+      [](webf::WebFPage* page, int64_t soft_limit, int64_t hard_limit) {
+        page->executingContext()->pageMemory()->SetLimits(soft_limit, hard_limit);
+      },
+      page, soft_limit, hard_limit);
+}
+
+void getPageMemoryUsage(void* page_, NativePageMemoryUsage* usage) {
+  auto page = reinterpret_cast<webf::WebFPage*>(page_);
+  // The figures are updated by the JS thread of the page, read them there.
+  webf::PageMemory::Usage page_usage = page->dartIsolateContext()->dispatcher()->PostToJsSync(
+      page->isDedicated(), page->contextId(),
+      [](bool cancel, webf::WebFPage* page) -> webf::PageMemory::Usage {
+        if (cancel)
+          return {};
+        webf::PageMemory* page_memory = page->executingContext()->pageMemory();
+        page_memory->RequestMeasurement();
+        return page_memory->usage();
+      },
+      page);
+  usage->js_heap = page_usage.js_heap;
+  usage->dom_wrappers = page_usage.dom_wrappers;
+  usage->ui_commands = page_usage.ui_commands;
+  usage->blobs = page_usage.blobs;
+}
+
 void collectNativeProfileData(void* ptr, const char** data, uint32_t* len) {
   auto* dart_isolate_context = static_cast<webf::DartIsolateContext*>(ptr);
   std::string result = dart_isolate_context->profiler()->ToJSON();
@@ -259,6 +400,57 @@ void clearNativeProfileData(void* ptr) {
   dart_isolate_context->profiler()->clear();
 }
 
+void startJSSamplingProfiler(void* page_, int64_t interval_us) {
+  auto page = reinterpret_cast<webf::WebFPage*>(page_);
+  page->dartIsolateContext()->dispatcher()->PostToJs(
+      page->isDedicated(), page->contextId(),
+      [](webf::WebFPage* page, int64_t interval_us) {
+        page->dartIsolateContext()->samplingProfiler()->Start(interval_us);
+      },
+      page, interval_us);
+}
+
+void stopJSSamplingProfiler(void* page_) {
+  auto page = reinterpret_cast<webf::WebFPage*>(page_);
+  page->dartIsolateContext()->dispatcher()->PostToJs(
+      page->isDedicated(), page->contextId(),
+      [](webf::WebFPage* page) { page->dartIsolateContext()->samplingProfiler()->Stop(); }, page);
+}
+
+void collectJSSamplingProfileData(void* page_, int32_t format, const char** data, uint32_t* len) {
+  auto page = reinterpret_cast<webf::WebFPage*>(page_);
+  std::string result = page->dartIsolateContext()->dispatcher()->PostToJsSync(
+      page->isDedicated(), page->contextId(),
+      [](bool cancel, webf::WebFPage* page, int32_t format) -> std::string {
+        if (cancel)
+          return "";
+        return page->dartIsolateContext()->samplingProfiler()->Export(
+            page->executingContext()->ctx(), static_cast<webf::SamplingProfiler::Format>(format));
+      },
+      page, format);
+
+  // The pprof format is binary, the terminating zero is only for the collapsed stacks.
+  *data = static_cast<const char*>(webf::dart_malloc(sizeof(char) * result.size() + 1));
+  memcpy((void*)*data, result.c_str(), sizeof(char) * result.size() + 1);
+  *len = result.size();
+}
+
+void takeHeapSnapshot(void* page_, const char** data, uint32_t* len) {
+  auto page = reinterpret_cast<webf::WebFPage*>(page_);
+  std::string result = page->dartIsolateContext()->dispatcher()->PostToJsSync(
+      page->isDedicated(), page->contextId(),
+      [](bool cancel, webf::WebFPage* page) -> std::string {
+        if (cancel)
+          return "";
+        return webf::HeapSnapshot::Take(page->dartIsolateContext()->runtime());
+      },
+      page);
+
+  *data = static_cast<const char*>(webf::dart_malloc(sizeof(char) * result.size() + 1));
+  memcpy((void*)*data, result.c_str(), sizeof(char) * result.size() + 1);
+  *len = result.size();
+}
+
 void dispatchUITask(void* page_, void* context, void* callback) {
   auto page = reinterpret_cast<webf::WebFPage*>(page_);
   reinterpret_cast<void (*)(void*)>(callback)(context);
@@ -36,6 +36,17 @@ PageController pageController = PageController();
 
 List<double> mems = [];
 
+// When set, a heap snapshot of the first and of the last visit of each spec is written into this directory, as
+// <spec>.first.heapsnapshot and <spec>.last.heapsnapshot. Compare them with bridge/tools/webf_heap_snapshot_diff.
+final String? heapSnapshotDir = Platform.environment['WEBF_HEAP_SNAPSHOT_DIR'];
+
+void writeHeapSnapshot(String name, String label) {
+  double contextId = pageController.getWebF(name).view.contextId;
+  File file = File(path.join(heapSnapshotDir!, '$name.$label.heapsnapshot'));
+  file.writeAsBytesSync(takeHeapSnapshot(contextId));
+  print('heap snapshot: ${file.path}');
+}
+
 // Test for UriParser.
 class IntegrationTestUriParser extends UriParser {
   @override
@@ -195,13 +206,19 @@ class HomePageElement extends StatelessElement {
   void mount(Element? parent, Object? newSlot) async {
     super.mount(parent, newSlot);
 
+    const int visits = 5;
     await runWithMultiple(() async {
+      int visit = 0;
       await runWithMultiple(() async {
         await sleep(Duration(seconds: 1));
         Navigator.pushNamed(this, '/' + current.name);
         await sleep(Duration(seconds: 1));
+        if (heapSnapshotDir != null && (visit == 0 || visit == visits - 1)) {
+          writeHeapSnapshot(current.name, visit == 0 ? 'first' : 'last');
+        }
+        visit++;
         Navigator.pop(this);
-      }, 5);
+      }, visits);
 
       if (currentIndex < codes.length - 1) {
         current = codes[currentIndex + 1];
@@ -11,6 +11,7 @@ interface MethodChannel {
 
 interface WebF {
     invokeModule: (module: string, method: string, params?: any | null, fn?: (err: Error, data: any) => any) => any;
+    invokeModuleAsync: (module: string, method: string, params?: any | null, fn?: (err: Error, data: any) => any) => void;
     addWebfModuleListener: (moduleName: string, fn: (event: Event, extra: any) => any) => void;
     methodChannel: MethodChannel;
 }
@@ -235,6 +235,58 @@ describe('TouchEvent', () => {
     });
   });
 
+  it('touchmove samples in the same frame should be dispatched once', async (done) => {
+    const div = document.createElement('div');
+    div.style.width = '100px';
+    div.style.height = '100px';
+    div.style.backgroundColor = 'red';
+    document.body.appendChild(div);
+
+    let dispatchCount = 0;
+    let sampleCount = 0;
+    div.addEventListener('touchmove', (e: TouchEvent) => {
+      dispatchCount++;
+      // @ts-ignore
+      sampleCount += e.getCoalescedEvents().length;
+    }, { passive: true });
+
+    await simulatePointDown(10, 10);
+    // The packets are sent without waiting for a frame between them.
+    await Promise.all([
+      simulatePointer([[10, 12, PointerChange.move]], 0),
+      simulatePointer([[10, 14, PointerChange.move]], 0),
+      simulatePointer([[10, 16, PointerChange.move]], 0),
+    ]);
+    await simulatePointUp(10, 16);
+
+    expect(sampleCount).toBe(3);
+    expect(dispatchCount).toBeLessThan(sampleCount);
+    done();
+  });
+
+  it('stopPropagation of passive touchmove listeners should stop the bubbling', async (done) => {
+    const div = document.createElement('div');
+    div.style.width = '100px';
+    div.style.height = '100px';
+    div.style.backgroundColor = 'red';
+    document.body.appendChild(div);
+
+    let bodyCalled = false;
+    div.addEventListener('touchmove', (e) => {
+      e.stopPropagation();
+    }, { passive: true });
+    document.body.addEventListener('touchmove', () => {
+      bodyCalled = true;
+    }, { passive: true });
+
+    await simulatePointDown(10, 10);
+    await simulatePointMove(10, 12);
+    await simulatePointUp(10, 12);
+
+    expect(bodyCalled).toBe(false);
+    done();
+  });
+
   it('should works when initialize TouchEvent from JS', () => {
     const container = createElement('div', {}, []);
     document.body.appendChild(container);
@@ -10,6 +10,8 @@ export 'src/bridge/to_native.dart';
 export 'src/bridge/from_native.dart';
 export 'src/bridge/native_types.dart';
 export 'src/bridge/native_value.dart';
+export 'src/bridge/structured_value.dart';
 export 'src/bridge/native_gumbo.dart';
 export 'src/bridge/ui_command.dart';
 export 'src/bridge/multiple_thread.dart';
+export 'src/bridge/page_pool.dart';
@@ -49,13 +49,16 @@ Future<void> _dispatchCaptureEventToNative(Event event) async {
 
 void _handleDispatchResult(Object contextHandle, Pointer<NativeValue> returnValue) {
   _DispatchEventResultContext context = contextHandle as _DispatchEventResultContext;
-  Pointer<EventDispatchResult> dispatchResult = fromNativeValue(context.controller.view, returnValue).cast<EventDispatchResult>();
+  // The native side returns null when there are no listeners for this event at the current target.
+  Pointer<EventDispatchResult>? dispatchResult = fromNativeValue(context.controller.view, returnValue)?.cast<EventDispatchResult>();
   Event event = context.event;
-  event.cancelable = dispatchResult.ref.canceled;
-  event.propagationStopped = dispatchResult.ref.propagationStopped;
-  event.sharedJSProps = Pointer.fromAddress(context.rawEvent.ref.bytes.elementAt(8).value);
-  event.propLen = context.rawEvent.ref.bytes.elementAt(9).value;
-  event.allocateLen = context.rawEvent.ref.bytes.elementAt(10).value;
+  if (dispatchResult != null) {
+    event.cancelable = dispatchResult.ref.canceled;
+    event.propagationStopped = dispatchResult.ref.propagationStopped;
+    event.sharedJSProps = Pointer.fromAddress(context.rawEvent.ref.bytes.elementAt(8).value);
+    event.propLen = context.rawEvent.ref.bytes.elementAt(9).value;
+    event.allocateLen = context.rawEvent.ref.bytes.elementAt(10).value;
+  }
 
   if (enableWebFCommandLog && context.stopwatch != null) {
     print('dispatch event to native side: target: ${event.target} arguments: ${context.dispatchEventArguments} time: ${context.stopwatch!.elapsedMicroseconds}us');
@@ -63,9 +66,18 @@ void _handleDispatchResult(Object contextHandle, Pointer<NativeValue> returnValu
 
   // Free the allocated arguments.
   malloc.free(context.rawEvent);
+  if (context.coalescedRawEvents.isNotEmpty) {
+    for (Pointer<RawEvent> coalescedRawEvent in context.coalescedRawEvents) {
+      malloc.free(coalescedRawEvent.ref.bytes);
+      malloc.free(coalescedRawEvent);
+    }
+    malloc.free(Pointer.fromAddress(context.allocatedNativeArguments.elementAt(3).ref.u));
+  }
   malloc.free(context.method);
   malloc.free(context.allocatedNativeArguments);
-  malloc.free(dispatchResult);
+  if (dispatchResult != null) {
+    malloc.free(dispatchResult);
+  }
   malloc.free(returnValue);
 
   if (enableWebFProfileTracking) {
@@ -82,6 +94,7 @@ class _DispatchEventResultContext {
   Pointer<NativeValue> method;
   Pointer<NativeValue> allocatedNativeArguments;
   Pointer<RawEvent> rawEvent;
+  List<Pointer<RawEvent>> coalescedRawEvents;
   List<dynamic> dispatchEventArguments;
   WebFController controller;
   EvaluateOpItem? profileOp;
@@ -91,6 +104,7 @@ class _DispatchEventResultContext {
     this.method,
     this.allocatedNativeArguments,
     this.rawEvent,
+    this.coalescedRawEvents,
     this.controller,
     this.dispatchEventArguments,
     this.stopwatch,
@@ -105,6 +119,18 @@ Future<void> _dispatchEventToNative(Event event, bool isCapture) async {
 
   if (controller.view.disposed) return;
 
+  // The listeners may be removed by JavaScript before the removeEvent command arrives.
+  EventTarget? currentTarget = event.currentTarget;
+  if (currentTarget != null && !BindingBridge.hasNativeListener(currentTarget, event.type, isCapture: isCapture)) return;
+
+  // The passive listeners of the previous target may have stopped the propagation.
+  Future<void>? pendingPassiveDispatch = event.pendingPassiveDispatch;
+  if (pendingPassiveDispatch != null) {
+    event.pendingPassiveDispatch = null;
+    await pendingPassiveDispatch;
+    if (event.propagationStopped) return;
+  }
+
   if (contextId != null &&
       pointer != null &&
       pointer.ref.invokeBindingMethodFromDart != nullptr &&
@@ -125,6 +151,13 @@ Future<void> _dispatchEventToNative(Event event, bool isCapture) async {
     Pointer<RawEvent> rawEvent = event.toRaw().cast<RawEvent>();
     List<dynamic> dispatchEventArguments = [event.type, rawEvent, isCapture];
 
+    // Move samples coalesced in the same frame are sent along with the event they were merged into.
+    List<Pointer<RawEvent>> coalescedRawEvents = const [];
+    if (event is TouchEvent && event.coalescedEvents.isNotEmpty) {
+      coalescedRawEvents = event.coalescedEvents.map((e) => e.toRaw().cast<RawEvent>()).toList();
+      dispatchEventArguments.add(coalescedRawEvents);
+    }
+
     Stopwatch? stopwatch;
     if (enableWebFCommandLog) {
       stopwatch = Stopwatch()..start();
@@ -140,6 +173,7 @@ Future<void> _dispatchEventToNative(Event event, bool isCapture) async {
       method,
       allocatedNativeArguments,
       rawEvent,
+      coalescedRawEvents,
       controller,
       dispatchEventArguments,
       stopwatch,
@@ -152,10 +186,37 @@ Future<void> _dispatchEventToNative(Event event, bool isCapture) async {
       f(pointer, currentProfileOp?.hashCode ?? 0, method, dispatchEventArguments.length, allocatedNativeArguments, context, resultCallback);
     });
 
+    // Passive listeners can't cancel the event, so the dart side (e.g. scroll physics of touchmove) doesn't need
+    // to wait for JavaScript before moving on to the next target.
+    if (currentTarget != null && BindingBridge.hasOnlyPassiveNativeListeners(currentTarget, event.type)) {
+      event.pendingPassiveDispatch = completer.future;
+      return;
+    }
+
     return completer.future;
   }
 }
 
+// Event types tracked by the listener bitmaps in NativeBindingObject, the order matches ListenedEventType in
+// bridge/core/dom/events/event_target.h.
+const List<String> kListenedEventTypes = [
+  EVENT_SCROLL,
+  EVENT_RESIZE,
+  EVENT_TOUCH_START,
+  EVENT_TOUCH_MOVE,
+  EVENT_TOUCH_END,
+  EVENT_TOUCH_CANCEL,
+  'pointerdown',
+  'pointermove',
+  'pointerup',
+  'pointercancel',
+  EVENT_CLICK,
+];
+
+final Map<String, int> _listenedEventTypeBits = {
+  for (int i = 0; i < kListenedEventTypes.length; i++) kListenedEventTypes[i]: 1 << i
+};
+
 enum CreateBindingObjectType {
   createDOMMatrix
 }
@@ -235,6 +296,24 @@ abstract class BindingBridge {
 
   }
 
+  /// Whether JavaScript listens to [type] at [target], read from the bitmaps shared by the bridge without waiting
+  /// for the addEvent and removeEvent commands. Returns true for the types which are not tracked.
+  static bool hasNativeListener(EventTarget target, String type, {bool isCapture = false}) {
+    Pointer<NativeBindingObject>? pointer = target.pointer;
+    int? bit = _listenedEventTypeBits[type];
+    if (pointer == null || bit == null) return true;
+    int bits = isCapture ? pointer.ref.captureEventListeners : pointer.ref.eventListeners;
+    return bits & bit != 0;
+  }
+
+  /// Whether all the JavaScript listeners of [type] at [target] are passive, so they can't cancel the event.
+  static bool hasOnlyPassiveNativeListeners(EventTarget target, String type) {
+    Pointer<NativeBindingObject>? pointer = target.pointer;
+    int? bit = _listenedEventTypeBits[type];
+    if (pointer == null || bit == null) return false;
+    return pointer.ref.passiveEventListeners & bit != 0;
+  }
+
   static bool hasListener(EventTarget target, String type, {bool isCapture = false}) {
     Map<String, List<EventHandler>> eventHandlers = isCapture ? target.getCaptureEventHandlers() : target.getEventHandlers();
     List<EventHandler>? handlers = eventHandlers[type];
@@ -12,6 +12,7 @@ import 'binding.dart';
 import 'from_native.dart';
 import 'to_native.dart';
 import 'multiple_thread.dart';
+import 'page_pool.dart';
 
 typedef NativeOnDartContextFinalized = Void Function(Pointer<Void> data);
 typedef DartOnDartContextFinalized = void Function(Pointer<Void> data);
@@ -42,7 +43,7 @@ FutureOr<double> initBridge(WebFViewController view, WebFThread runningThread) a
 
   dartContext ??= DartContext();
 
-  double newContextId = runningThread.identity();
+  double newContextId = PagePool.claim(runningThread) ?? runningThread.identity();
   await allocateNewPage(runningThread is FlutterUIThread, newContextId, runningThread.syncBufferSize());
 
   return newContextId;
@@ -42,6 +42,9 @@ class DedicatedThread extends WebFThread {
   DedicatedThread({ int syncBufferSize = 4 }): _syncBufferSize = syncBufferSize;
   DedicatedThread._(this._identity, { int syncBufferSize = 4 }): _syncBufferSize = syncBufferSize;
 
+  /// Whether the thread belongs to a [DedicatedThreadGroup].
+  bool get isGrouped => _identity != null;
+
   @override
   int syncBufferSize() {
     return _syncBufferSize;
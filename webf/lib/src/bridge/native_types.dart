@@ -20,12 +20,30 @@ class NativeWebFInfo extends Struct {
   external Pointer<Utf8> system_name;
 }
 
+class NativePageMemoryUsage extends Struct {
+  @Int64()
+  external int jsHeap;
+
+  @Int64()
+  external int domWrappers;
+
+  @Int64()
+  external int uiCommands;
+
+  @Int64()
+  external int blobs;
+}
+
 // An native struct can be directly convert to javaScript String without any conversion cost.
 class NativeString extends Struct {
+  // Points to Latin-1 bytes when is8Bit is not 0.
   external Pointer<Uint16> string;
 
   @Uint32()
   external int length;
+
+  @Uint32()
+  external int is8Bit;
 }
 
 // For memory compatibility between NativeEvent and other struct which inherit NativeEvent(exp: NativeTouchEvent, NativeGestureEvent),
@@ -124,11 +142,25 @@ class NativeBindingObject extends Struct {
   // Shared method called by JS side.
   external Pointer<NativeFunction<InvokeBindingsMethodsFromNative>> invokeBindingMethodFromNative;
   external Pointer<Void> extra;
+  // Bitmaps of the event types listened by JavaScript, written by the bridge. See NativeEventListenerBits in
+  // bridge/core/binding_object.h.
+  @Uint32()
+  external int eventListeners;
+  @Uint32()
+  external int captureEventListeners;
+  @Uint32()
+  external int passiveEventListeners;
+  @Uint32()
+  external int onceEventListeners;
 }
 
 Pointer<NativeBindingObject> allocateNewBindingObject() {
   Pointer<NativeBindingObject> pointer = malloc.allocate(sizeOf<NativeBindingObject>());
   pointer.ref.disposed = false;
+  pointer.ref.eventListeners = 0;
+  pointer.ref.captureEventListeners = 0;
+  pointer.ref.passiveEventListeners = 0;
+  pointer.ref.onceEventListeners = 0;
   return pointer;
 }
 
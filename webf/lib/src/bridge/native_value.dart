@@ -33,7 +33,66 @@ enum JSValueType {
   TAG_POINTER,
   TAG_FUNCTION,
   TAG_ASYNC_FUNCTION,
-  TAG_UINT8_BYTES
+  TAG_UINT8_BYTES,
+  TAG_ARRAY_BUFFER,
+  TAG_STRUCTURED
+}
+
+// The bytes of an ArrayBuffer passed between dart and JavaScript. The bytes from JavaScript are a copy, the script keeps
+// its ArrayBuffer. The bytes sent to JavaScript are adopted without copying.
+// A null freeFunc means the bytes were allocated by malloc.
+class NativeByteBuffer extends Struct {
+  external Pointer<Uint8> data;
+
+  @Int64()
+  external int offset;
+
+  @Int64()
+  external int length;
+
+  external Pointer<Void> freeFunc;
+
+  external Pointer<Void> opaque;
+}
+
+final _freeNativeByteBuffer = WebFDynamicLibrary.ref
+    .lookup<NativeFunction<Void Function(Pointer<Void>)>>('freeNativeByteBuffer');
+
+/// Owns a [NativeByteBuffer] and exposes it as [bytes] without copying.
+///
+/// Bytes received from JavaScript, copied on the JavaScript thread, are released when [bytes] is garbage collected. Pass a [NativeByteData] to
+/// JavaScript to hand the ownership back, after that the [bytes] view must not be used anymore.
+class NativeByteData implements Finalizable {
+  static final _finalizer = NativeFinalizer(_freeNativeByteBuffer);
+  // Keep the owner alive as long as the bytes view is reachable.
+  static final Expando<NativeByteData> _owners = Expando();
+
+  NativeByteData._(this._buffer)
+      : bytes = _buffer.ref.data.elementAt(_buffer.ref.offset).asTypedList(_buffer.ref.length) {
+    _owners[bytes] = this;
+    _finalizer.attach(this, _buffer.cast(), detach: this, externalSize: _buffer.ref.length);
+  }
+
+  factory NativeByteData.allocate(int length) {
+    Pointer<NativeByteBuffer> buffer = malloc.allocate(sizeOf<NativeByteBuffer>());
+    buffer.ref.data = malloc.allocate(length > 0 ? length : 1);
+    buffer.ref.offset = 0;
+    buffer.ref.length = length;
+    buffer.ref.freeFunc = nullptr;
+    buffer.ref.opaque = nullptr;
+    return NativeByteData._(buffer);
+  }
+
+  final Pointer<NativeByteBuffer> _buffer;
+  final Uint8List bytes;
+  bool _transferred = false;
+
+  Pointer<NativeByteBuffer> _transfer() {
+    assert(!_transferred, 'NativeByteData can only be transferred once.');
+    _transferred = true;
+    _finalizer.detach(this);
+    return _buffer;
+  }
 }
 
 enum JSPointerType {
@@ -87,6 +146,13 @@ dynamic fromNativeValue(WebFViewController view, Pointer<NativeValue> nativeValu
     case JSValueType.TAG_UINT8_BYTES:
       Pointer<Uint8> buffer = Pointer.fromAddress(nativeValue.ref.u);
       return buffer.asTypedList(nativeValue.ref.uint32);
+    case JSValueType.TAG_ARRAY_BUFFER:
+      return NativeByteData._(Pointer.fromAddress(nativeValue.ref.u)).bytes;
+    case JSValueType.TAG_STRUCTURED:
+      Pointer<Uint8> buffer = Pointer.fromAddress(nativeValue.ref.u);
+      dynamic value = decodeStructuredValue(buffer.asTypedList(nativeValue.ref.uint32), view.getBindingObject);
+      malloc.free(buffer);
+      return value;
   }
 }
 
@@ -110,6 +176,9 @@ void toNativeValue(Pointer<NativeValue> target, value, [BindingObject? ownerBind
     target.ref.tag = JSValueType.TAG_POINTER.index;
     target.ref.uint32 = JSPointerType.Others.index;
     target.ref.u = value.address;
+  } else if (value is NativeByteData) {
+    target.ref.tag = JSValueType.TAG_ARRAY_BUFFER.index;
+    target.ref.u = value._transfer().address;
   } else if (value is Uint8List) {
     Pointer<Uint8> buffer = malloc.allocate(sizeOf<Uint8>() * value.length);
     final bytes = buffer.asTypedList(value.length);
@@ -130,6 +199,13 @@ void toNativeValue(Pointer<NativeValue> target, value, [BindingObject? ownerBind
     for(int i = 0; i < value.length; i ++) {
       toNativeValue(lists.elementAt(i), value[i], ownerBindingObject);
     }
+  } else if (value is Map) {
+    Uint8List bytes = encodeStructuredValue(value);
+    Pointer<Uint8> buffer = malloc.allocate(sizeOf<Uint8>() * bytes.length);
+    buffer.asTypedList(bytes.length).setAll(0, bytes);
+    target.ref.tag = JSValueType.TAG_STRUCTURED.index;
+    target.ref.uint32 = bytes.length;
+    target.ref.u = buffer.address;
   } else if (value is Object) {
     String str = jsonEncode(value);
     target.ref.tag = JSValueType.TAG_JSON.index;
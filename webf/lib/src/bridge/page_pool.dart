@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+import 'dart:async';
+import 'dart:collection';
+
+import 'package:flutter/scheduler.dart';
+
+import 'bridge.dart';
+import 'multiple_thread.dart';
+import 'to_native.dart';
+
+/// Keeps pages which already ran the polyfill and the plugins, so a new WebF page starts without waiting for them.
+///
+/// The pages are built during idle time, in their own JS thread for [DedicatedThread], and every page is handed out
+/// only once, the claimed page has a clean global. Pages of a [DedicatedThreadGroup] are not pooled.
+class PagePool {
+  /// The ready pages kept for every kind of thread, 0 turns the pool off.
+  static int size = 0;
+
+  // [sync buffer size, or -1 for the Flutter UI thread] -> ids of the ready pages.
+  static final Map<int, Queue<double>> _readyPages = {};
+  static final Map<int, int> _pendingPages = {};
+
+  static int? _keyOf(WebFThread thread) {
+    if (thread is FlutterUIThread) return -1;
+    if (thread is DedicatedThread && !thread.isGrouped) return thread.syncBufferSize();
+    return null;
+  }
+
+  /// Returns the id of a ready page for [thread], or null when there is none.
+  static double? claim(WebFThread thread) {
+    int? key = _keyOf(thread);
+    if (key == null || size <= 0) return null;
+
+    _scheduleRefill(key);
+    Queue<double>? ready = _readyPages[key];
+    if (ready == null || ready.isEmpty) return null;
+    return ready.removeFirst();
+  }
+
+  /// Fills the pool for [thread] during the next idle periods.
+  static void prewarm(WebFThread thread) {
+    int? key = _keyOf(thread);
+    if (key == null) return;
+    _scheduleRefill(key);
+  }
+
+  static void _scheduleRefill(int key) {
+    int count = (_readyPages[key]?.length ?? 0) + (_pendingPages[key] ?? 0);
+    for (int i = count; i < size; i++) {
+      _pendingPages[key] = (_pendingPages[key] ?? 0) + 1;
+      SchedulerBinding.instance.scheduleTask(() => _buildPage(key), Priority.idle);
+    }
+  }
+
+  static Future<void> _buildPage(int key) async {
+    dartContext ??= DartContext();
+
+    bool sync = key < 0;
+    double contextId = sync ? (-newPageId()).toDouble() : newPageId().toDouble();
+    // Only pages which finished building are handed out, a claimed id must never race with its prewarm.
+    await prewarmPage(sync, contextId, sync ? 0 : key);
+    _pendingPages[key] = _pendingPages[key]! - 1;
+    _readyPages.putIfAbsent(key, () => Queue()).add(contextId);
+  }
+}
@@ -0,0 +1,441 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+import 'dart:ffi';
+import 'dart:typed_data';
+
+import 'package:webf/foundation.dart';
+
+/// The binary format used by TAG_STRUCTURED native values to pass maps, lists and typed data between dart and C++
+/// without going through JSON. Keep it in sync with bridge/bindings/qjs/structured_serializer.h, both sides are
+/// verified by the corpus in bridge/test/fixtures/structured_value_corpus.json.
+///
+/// All multi-byte numbers are little-endian, varint is an unsigned LEB128.
+///
+///     buffer     := 0xFF version:uint8 value
+///     value      := undefined(0x00) | null(0x01) | false(0x02) | true(0x03)
+///                 | int(0x04) zigzag:varint
+///                 | double(0x05) float64
+///                 | oneByteString(0x06) length:varint latin1-chars
+///                 | twoByteString(0x07) length:varint utf16-code-units
+///                 | array(0x08) length:varint value{length}
+///                 | object(0x09) (string value)* end(0x0F)
+///                 | map(0x0A) (value value)* end(0x0F)
+///                 | arrayBuffer(0x0B) byteLength:varint bytes
+///                 | typedArray(0x0C) kind:uint8 byteLength:varint bytes
+///                 | reference(0x0D) index:varint
+///                 | bindingObject(0x0E) address:uint64
+///
+/// Arrays, objects, maps, array buffers and typed arrays are numbered by the order they first appear in the stream,
+/// a reference points to one of them. Typed array kinds are Int8, Uint8, Uint8Clamped, Int16, Uint16, Int32, Uint32,
+/// Float32, Float64 and DataView, numbered from 0.
+///
+/// Integral numbers within the JavaScript safe integer range are always written as int.
+const int structuredFormatVersion = 1;
+
+const int _tagUndefined = 0x00;
+const int _tagNull = 0x01;
+const int _tagFalse = 0x02;
+const int _tagTrue = 0x03;
+const int _tagInt = 0x04;
+const int _tagDouble = 0x05;
+const int _tagOneByteString = 0x06;
+const int _tagTwoByteString = 0x07;
+const int _tagArray = 0x08;
+const int _tagObject = 0x09;
+const int _tagMap = 0x0A;
+const int _tagArrayBuffer = 0x0B;
+const int _tagTypedArray = 0x0C;
+const int _tagReference = 0x0D;
+const int _tagBindingObject = 0x0E;
+const int _tagEnd = 0x0F;
+const int _tagVersion = 0xFF;
+
+const int _kindInt8 = 0;
+const int _kindUint8 = 1;
+const int _kindUint8Clamped = 2;
+const int _kindInt16 = 3;
+const int _kindUint16 = 4;
+const int _kindInt32 = 5;
+const int _kindUint32 = 6;
+const int _kindFloat32 = 7;
+const int _kindFloat64 = 8;
+const int _kindDataView = 9;
+
+const int _maxSafeInteger = 9007199254740991;
+
+typedef StructuredBindingObjectResolver = dynamic Function(Pointer pointer);
+
+/// Encode [value] into the structured format.
+Uint8List encodeStructuredValue(dynamic value) {
+  _StructuredWriter writer = _StructuredWriter();
+  writer.writeByte(_tagVersion);
+  writer.writeByte(structuredFormatVersion);
+  writer.writeValue(value);
+  return writer.takeBytes();
+}
+
+/// Decode the structured format. Binding objects are looked up by [resolveBindingObject], they are null without it.
+dynamic decodeStructuredValue(Uint8List bytes, [StructuredBindingObjectResolver? resolveBindingObject]) {
+  _StructuredReader reader = _StructuredReader(bytes, resolveBindingObject);
+  if (reader.readByte() != _tagVersion || reader.readByte() > structuredFormatVersion) {
+    throw FormatException('Unsupported structured value version.');
+  }
+  dynamic value = reader.readValue();
+  if (reader.offset != bytes.length) {
+    throw FormatException('Unexpected trailing bytes in structured value.', bytes, reader.offset);
+  }
+  return value;
+}
+
+class _StructuredWriter {
+  Uint8List _buffer = Uint8List(64);
+  late ByteData _data = ByteData.view(_buffer.buffer);
+  int _length = 0;
+  final Map<Object, int> _references = Map.identity();
+
+  Uint8List takeBytes() => Uint8List.sublistView(_buffer, 0, _length);
+
+  void _reserve(int length) {
+    if (_length + length <= _buffer.length) return;
+    int capacity = _buffer.length * 2;
+    while (capacity < _length + length) {
+      capacity *= 2;
+    }
+    Uint8List buffer = Uint8List(capacity);
+    buffer.setRange(0, _length, _buffer);
+    _buffer = buffer;
+    _data = ByteData.view(buffer.buffer);
+  }
+
+  void writeByte(int byte) {
+    _reserve(1);
+    _buffer[_length++] = byte;
+  }
+
+  void writeVarint(int value) {
+    _reserve(10);
+    do {
+      int byte = value & 0x7F;
+      value = value >>> 7;
+      _buffer[_length++] = value != 0 ? (byte | 0x80) : byte;
+    } while (value != 0);
+  }
+
+  void writeBytes(Uint8List bytes) {
+    _reserve(bytes.length);
+    _buffer.setRange(_length, _length + bytes.length, bytes);
+    _length += bytes.length;
+  }
+
+  void writeInt(int value) {
+    writeByte(_tagInt);
+    writeVarint((value << 1) ^ (value >> 63));
+  }
+
+  void writeDouble(double value) {
+    if (value.isFinite && value.abs() <= _maxSafeInteger && value == value.truncateToDouble() &&
+        !(value == 0 && value.isNegative)) {
+      writeInt(value.toInt());
+      return;
+    }
+    writeByte(_tagDouble);
+    _reserve(8);
+    _data.setFloat64(_length, value, Endian.little);
+    _length += 8;
+  }
+
+  void writeString(String value) {
+    int length = value.length;
+    bool isOneByte = true;
+    for (int i = 0; i < length; i++) {
+      if (value.codeUnitAt(i) > 0xFF) {
+        isOneByte = false;
+        break;
+      }
+    }
+
+    if (isOneByte) {
+      writeByte(_tagOneByteString);
+      writeVarint(length);
+      _reserve(length);
+      for (int i = 0; i < length; i++) {
+        _buffer[_length++] = value.codeUnitAt(i);
+      }
+    } else {
+      writeByte(_tagTwoByteString);
+      writeVarint(length);
+      _reserve(length * 2);
+      for (int i = 0; i < length; i++) {
+        _data.setUint16(_length, value.codeUnitAt(i), Endian.little);
+        _length += 2;
+      }
+    }
+  }
+
+  // Returns true when the object was seen before and a reference has been written.
+  bool _writeReferenceOrRegister(Object value) {
+    int? index = _references[value];
+    if (index != null) {
+      writeByte(_tagReference);
+      writeVarint(index);
+      return true;
+    }
+    _references[value] = _references.length;
+    return false;
+  }
+
+  void writeValue(dynamic value) {
+    if (value == null) {
+      writeByte(_tagNull);
+    } else if (value is bool) {
+      writeByte(value ? _tagTrue : _tagFalse);
+    } else if (value is int) {
+      writeInt(value);
+    } else if (value is double) {
+      writeDouble(value);
+    } else if (value is String) {
+      writeString(value);
+    } else if (value is BindingObject) {
+      writeByte(_tagBindingObject);
+      _reserve(8);
+      _data.setUint64(_length, value.pointer?.address ?? 0, Endian.little);
+      _length += 8;
+    } else if (value is TypedData) {
+      _writeTypedData(value);
+    } else if (value is ByteBuffer) {
+      if (_writeReferenceOrRegister(value)) return;
+      Uint8List bytes = value.asUint8List();
+      writeByte(_tagArrayBuffer);
+      writeVarint(bytes.length);
+      writeBytes(bytes);
+    } else if (value is List) {
+      if (_writeReferenceOrRegister(value)) return;
+      writeByte(_tagArray);
+      writeVarint(value.length);
+      for (int i = 0; i < value.length; i++) {
+        writeValue(value[i]);
+      }
+    } else if (value is Map) {
+      if (_writeReferenceOrRegister(value)) return;
+      bool isObject = value.keys.every((key) => key is String);
+      writeByte(isObject ? _tagObject : _tagMap);
+      value.forEach((key, value) {
+        writeValue(key);
+        writeValue(value);
+      });
+      writeByte(_tagEnd);
+    } else {
+      // Same as jsonEncode, fallback to the toJson() method of the object.
+      writeValue(value.toJson());
+    }
+  }
+
+  void _writeTypedData(TypedData value) {
+    if (_writeReferenceOrRegister(value)) return;
+
+    int kind;
+    if (value is Int8List) {
+      kind = _kindInt8;
+    } else if (value is Uint8ClampedList) {
+      kind = _kindUint8Clamped;
+    } else if (value is Uint8List) {
+      kind = _kindUint8;
+    } else if (value is Int16List) {
+      kind = _kindInt16;
+    } else if (value is Uint16List) {
+      kind = _kindUint16;
+    } else if (value is Int32List) {
+      kind = _kindInt32;
+    } else if (value is Uint32List) {
+      kind = _kindUint32;
+    } else if (value is Float32List) {
+      kind = _kindFloat32;
+    } else if (value is Float64List) {
+      kind = _kindFloat64;
+    } else if (value is ByteData) {
+      kind = _kindDataView;
+    } else {
+      // JavaScript has no counterpart for the other lists, send the raw bytes.
+      Uint8List bytes = value.buffer.asUint8List(value.offsetInBytes, value.lengthInBytes);
+      writeByte(_tagArrayBuffer);
+      writeVarint(bytes.length);
+      writeBytes(bytes);
+      return;
+    }
+
+    writeByte(_tagTypedArray);
+    writeByte(kind);
+    writeVarint(value.lengthInBytes);
+    writeBytes(value.buffer.asUint8List(value.offsetInBytes, value.lengthInBytes));
+  }
+}
+
+class _StructuredReader {
+  _StructuredReader(this._bytes, this._resolveBindingObject)
+      : _data = ByteData.view(_bytes.buffer, _bytes.offsetInBytes, _bytes.lengthInBytes);
+
+  final Uint8List _bytes;
+  final ByteData _data;
+  final StructuredBindingObjectResolver? _resolveBindingObject;
+  final List<dynamic> _references = [];
+  int offset = 0;
+
+  Never _malformed() {
+    throw FormatException('Malformed structured value.', _bytes, offset);
+  }
+
+  void _ensure(int length) {
+    if (length < 0 || offset + length > _bytes.length) _malformed();
+  }
+
+  int readByte() {
+    _ensure(1);
+    return _bytes[offset++];
+  }
+
+  int readVarint() {
+    int result = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      int byte = readByte();
+      result |= (byte & 0x7F) << shift;
+      if (byte & 0x80 == 0) return result;
+    }
+    _malformed();
+  }
+
+  Uint8List _readBytes(int length) {
+    _ensure(length);
+    Uint8List bytes = _bytes.sublist(offset, offset + length);
+    offset += length;
+    return bytes;
+  }
+
+  dynamic readValue() {
+    int tag = readByte();
+    switch (tag) {
+      case _tagUndefined:
+      case _tagNull:
+        return null;
+      case _tagFalse:
+        return false;
+      case _tagTrue:
+        return true;
+      case _tagInt: {
+        int zigzag = readVarint();
+        return (zigzag >>> 1) ^ -(zigzag & 1);
+      }
+      case _tagDouble: {
+        _ensure(8);
+        double value = _data.getFloat64(offset, Endian.little);
+        offset += 8;
+        return value;
+      }
+      case _tagOneByteString: {
+        int length = readVarint();
+        _ensure(length);
+        String value = String.fromCharCodes(_bytes, offset, offset + length);
+        offset += length;
+        return value;
+      }
+      case _tagTwoByteString: {
+        int length = readVarint();
+        _ensure(length * 2);
+        Uint16List codeUnits = Uint16List(length);
+        for (int i = 0; i < length; i++) {
+          codeUnits[i] = _data.getUint16(offset + i * 2, Endian.little);
+        }
+        offset += length * 2;
+        return String.fromCharCodes(codeUnits);
+      }
+      case _tagArray: {
+        int length = readVarint();
+        _ensure(length);
+        List<dynamic> list = List.filled(length, null, growable: true);
+        _references.add(list);
+        for (int i = 0; i < length; i++) {
+          list[i] = readValue();
+        }
+        return list;
+      }
+      case _tagObject: {
+        Map<String, dynamic> object = {};
+        _references.add(object);
+        while (!_readEnd()) {
+          dynamic key = readValue();
+          if (key is! String) _malformed();
+          object[key] = readValue();
+        }
+        return object;
+      }
+      case _tagMap: {
+        Map<dynamic, dynamic> map = {};
+        _references.add(map);
+        while (!_readEnd()) {
+          dynamic key = readValue();
+          map[key] = readValue();
+        }
+        return map;
+      }
+      case _tagArrayBuffer: {
+        ByteBuffer buffer = _readBytes(readVarint()).buffer;
+        _references.add(buffer);
+        return buffer;
+      }
+      case _tagTypedArray: {
+        int kind = readByte();
+        TypedData typedData = _viewTypedData(kind, _readBytes(readVarint()));
+        _references.add(typedData);
+        return typedData;
+      }
+      case _tagReference: {
+        int index = readVarint();
+        if (index >= _references.length) _malformed();
+        return _references[index];
+      }
+      case _tagBindingObject: {
+        _ensure(8);
+        int address = _data.getUint64(offset, Endian.little);
+        offset += 8;
+        return _resolveBindingObject?.call(Pointer.fromAddress(address));
+      }
+      default:
+        _malformed();
+    }
+  }
+
+  bool _readEnd() {
+    _ensure(1);
+    if (_bytes[offset] != _tagEnd) return false;
+    offset++;
+    return true;
+  }
+
+  TypedData _viewTypedData(int kind, Uint8List bytes) {
+    ByteBuffer buffer = bytes.buffer;
+    switch (kind) {
+      case _kindInt8:
+        return buffer.asInt8List();
+      case _kindUint8:
+        return bytes;
+      case _kindUint8Clamped:
+        return buffer.asUint8ClampedList();
+      case _kindInt16:
+        return buffer.asInt16List();
+      case _kindUint16:
+        return buffer.asUint16List();
+      case _kindInt32:
+        return buffer.asInt32List();
+      case _kindUint32:
+        return buffer.asUint32List();
+      case _kindFloat32:
+        return buffer.asFloat32List();
+      case _kindFloat64:
+        return buffer.asFloat64List();
+      case _kindDataView:
+        return buffer.asByteData();
+      default:
+        _malformed();
+    }
+  }
+}
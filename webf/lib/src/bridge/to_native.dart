@@ -300,49 +300,27 @@ Future<bool> evaluateScripts(double contextId, Uint8List codeBytes, {String? url
     _anonymousScriptEvaluationId++;
   }
 
-  QuickJSByteCodeCacheObject cacheObject = await QuickJSByteCodeCache.getCacheObject(codeBytes, cacheKey: cacheKey);
-  if (QuickJSByteCodeCacheObject.cacheMode == ByteCodeCacheMode.DEFAULT &&
-      cacheObject.valid &&
-      cacheObject.bytes != null) {
-    bool result = await evaluateQuickjsByteCode(contextId, cacheObject.bytes!, profileOp: profileOp);
-    // If the bytecode evaluate failed, remove the cached file and fallback to raw javascript mode.
-    if (!result) {
-      await cacheObject.remove();
-    }
+  // The bytecode of large scripts is cached by the native side, keyed by the content of the script.
+  await QuickJSByteCodeCache.syncNativeCache();
 
-    return result;
-  } else {
-    Pointer<Utf8> _url = url.toNativeUtf8();
-    Pointer<Uint8> codePtr = uint8ListToPointer(codeBytes);
-    Completer<bool> completer = Completer();
-
-    _EvaluateScriptsContext context = _EvaluateScriptsContext(completer, codeBytes, codePtr, _url, cacheKey);
-    Pointer<NativeFunction<NativeEvaluateJavaScriptCallback>> resultCallback =
-        Pointer.fromFunction(handleEvaluateScriptsResult);
-
-    try {
-      assert(_allocatedPages.containsKey(contextId));
-      if (QuickJSByteCodeCache.isCodeNeedCache(codeBytes)) {
-        // Export the bytecode from scripts
-        Pointer<Pointer<Uint8>> bytecodes = malloc.allocate(sizeOf<Pointer<Uint8>>());
-        Pointer<Uint64> bytecodeLen = malloc.allocate(sizeOf<Uint64>());
-
-        context.bytecodes = bytecodes;
-        context.bytecodeLen = bytecodeLen;
-
-        _evaluateScripts(_allocatedPages[contextId]!, codePtr, codeBytes.length, bytecodes, bytecodeLen, _url, line,
-            profileOp?.hashCode ?? 0, context, resultCallback);
-      } else {
-        _evaluateScripts(_allocatedPages[contextId]!, codePtr, codeBytes.length, nullptr, nullptr, _url, line,
-            profileOp?.hashCode ?? 0, context, resultCallback);
-      }
-      return completer.future;
-    } catch (e, stack) {
-      print('$e\n$stack');
-    }
+  Pointer<Utf8> _url = url.toNativeUtf8();
+  Pointer<Uint8> codePtr = uint8ListToPointer(codeBytes);
+  Completer<bool> completer = Completer();
 
+  _EvaluateScriptsContext context = _EvaluateScriptsContext(completer, codeBytes, codePtr, _url, cacheKey);
+  Pointer<NativeFunction<NativeEvaluateJavaScriptCallback>> resultCallback =
+      Pointer.fromFunction(handleEvaluateScriptsResult);
+
+  try {
+    assert(_allocatedPages.containsKey(contextId));
+    _evaluateScripts(_allocatedPages[contextId]!, codePtr, codeBytes.length, nullptr, nullptr, _url, line,
+        profileOp?.hashCode ?? 0, context, resultCallback);
     return completer.future;
+  } catch (e, stack) {
+    print('$e\n$stack');
   }
+
+  return completer.future;
 }
 
 typedef NativeEvaluateQuickjsByteCode = Void Function(Pointer<Void>, Pointer<Uint8> bytes, Int32 byteLen, Int64 profileId, Handle object,
@@ -388,6 +366,46 @@ Future<bool> evaluateQuickjsByteCode(double contextId, Uint8List bytes, { Evalua
   return completer.future;
 }
 
+typedef NativeEvaluateQuickjsByteCodeFile = Void Function(Pointer<Void>, Pointer<Utf8> path, Int64 profileId, Handle object,
+    Pointer<NativeFunction<NativeEvaluateQuickjsByteCodeCallback>> callback);
+typedef DartEvaluateQuickjsByteCodeFile = void Function(Pointer<Void>, Pointer<Utf8> path, int profileId, Object object,
+    Pointer<NativeFunction<NativeEvaluateQuickjsByteCodeCallback>> callback);
+
+final DartEvaluateQuickjsByteCodeFile _evaluateQuickjsByteCodeFile = WebFDynamicLibrary.ref
+    .lookup<NativeFunction<NativeEvaluateQuickjsByteCodeFile>>('evaluateQuickjsByteCodeFile')
+    .asFunction();
+
+class _EvaluateQuickjsByteCodeFileContext {
+  Completer<bool> completer;
+  Pointer<Utf8> path;
+
+  _EvaluateQuickjsByteCodeFileContext(this.completer, this.path);
+}
+
+void handleEvaluateQuickjsByteCodeFileResult(Object handle, int result) {
+  _EvaluateQuickjsByteCodeFileContext context = handle as _EvaluateQuickjsByteCodeFileContext;
+  malloc.free(context.path);
+  context.completer.complete(result == 1);
+}
+
+// Bundles are mapped from the file at [path] instead of being copied to the native heap.
+Future<bool> evaluateQuickjsByteCodeFile(double contextId, String path, { EvaluateOpItem? profileOp }) async {
+  if (WebFController.getControllerOfJSContextId(contextId) == null) {
+    return false;
+  }
+  Completer<bool> completer = Completer();
+  assert(_allocatedPages.containsKey(contextId));
+
+  _EvaluateQuickjsByteCodeFileContext context = _EvaluateQuickjsByteCodeFileContext(completer, path.toNativeUtf8());
+
+  Pointer<NativeFunction<NativeEvaluateQuickjsByteCodeCallback>> nativeCallback =
+      Pointer.fromFunction(handleEvaluateQuickjsByteCodeFileResult);
+
+  _evaluateQuickjsByteCodeFile(_allocatedPages[contextId]!, context.path, profileOp?.hashCode ?? 0, context, nativeCallback);
+
+  return completer.future;
+}
+
 void _handleParseHTMLContextResult(Object handle) {
   _ParseHTMLContext context = handle as _ParseHTMLContext;
   context.completer.complete();
@@ -418,6 +436,142 @@ Future<void> parseHTML(double contextId, Uint8List codeBytes, { EvaluateOpItem?
   return completer.future;
 }
 
+// Register setBytecodeCacheDirectory
+typedef NativeSetBytecodeCacheDirectory = Void Function(Pointer<Utf8> directory, Int64 maxBytes);
+typedef DartSetBytecodeCacheDirectory = void Function(Pointer<Utf8> directory, int maxBytes);
+
+final DartSetBytecodeCacheDirectory _setBytecodeCacheDirectory = WebFDynamicLibrary.ref
+    .lookup<NativeFunction<NativeSetBytecodeCacheDirectory>>('setBytecodeCacheDirectory')
+    .asFunction();
+
+// Shared by all the pages, an empty [directory] turns the cache off. [maxBytes] of 0 uses the native default.
+void setBytecodeCacheDirectory(String directory, {int maxBytes = 0}) {
+  Pointer<Utf8> nativeDirectory = directory.toNativeUtf8();
+  _setBytecodeCacheDirectory(nativeDirectory, maxBytes);
+  malloc.free(nativeDirectory);
+}
+
+// Register setLocalStorageDirectory
+typedef NativeSetLocalStorageDirectory = Void Function(Pointer<Void> page, Pointer<Utf8> directory,
+    Pointer<Pointer<Utf8>> legacyKeys, Pointer<Pointer<Utf8>> legacyValues, Int32 legacyLength);
+typedef DartSetLocalStorageDirectory = void Function(Pointer<Void> page, Pointer<Utf8> directory,
+    Pointer<Pointer<Utf8>> legacyKeys, Pointer<Pointer<Utf8>> legacyValues, int legacyLength);
+
+final DartSetLocalStorageDirectory _setLocalStorageDirectory = WebFDynamicLibrary.ref
+    .lookup<NativeFunction<NativeSetLocalStorageDirectory>>('setLocalStorageDirectory')
+    .asFunction();
+
+// localStorage is implemented at the native side, which keeps the data of the page in [directory].
+// [legacyEntries] are merged into the native storage, the keys which already exist there are kept.
+void setLocalStorageDirectory(double contextId, String directory, [Map<String, String> legacyEntries = const {}]) {
+  if (!_allocatedPages.containsKey(contextId)) return;
+  Pointer<Utf8> nativeDirectory = directory.toNativeUtf8();
+  int length = legacyEntries.length;
+  Pointer<Pointer<Utf8>> nativeKeys = malloc.allocate(sizeOf<Pointer<Utf8>>() * length);
+  Pointer<Pointer<Utf8>> nativeValues = malloc.allocate(sizeOf<Pointer<Utf8>>() * length);
+  int index = 0;
+  legacyEntries.forEach((key, value) {
+    nativeKeys[index] = key.toNativeUtf8();
+    nativeValues[index] = value.toNativeUtf8();
+    index++;
+  });
+  _setLocalStorageDirectory(_allocatedPages[contextId]!, nativeDirectory, nativeKeys, nativeValues, length);
+  for (int i = 0; i < length; i++) {
+    malloc.free(nativeKeys[i]);
+    malloc.free(nativeValues[i]);
+  }
+  malloc.free(nativeKeys);
+  malloc.free(nativeValues);
+  malloc.free(nativeDirectory);
+}
+
+// Register notifyIdle
+typedef NativeNotifyIdle = Void Function(Pointer<Void> page, Int64 idleTimeUs);
+typedef DartNotifyIdle = void Function(Pointer<Void> page, int idleTimeUs);
+
+final DartNotifyIdle _notifyIdle =
+    WebFDynamicLibrary.ref.lookup<NativeFunction<NativeNotifyIdle>>('notifyIdle').asFunction();
+
+// The JS thread of the page may run a garbage collection in the next [idleTime].
+void notifyIdle(double contextId, Duration idleTime) {
+  if (!_allocatedPages.containsKey(contextId)) return;
+  _notifyIdle(_allocatedPages[contextId]!, idleTime.inMicroseconds);
+}
+
+enum MemoryPressureLevel { none, moderate, critical }
+
+// Register notifyMemoryPressure
+typedef NativeNotifyMemoryPressure = Void Function(Pointer<Void> page, Int32 level);
+typedef DartNotifyMemoryPressure = void Function(Pointer<Void> page, int level);
+
+final DartNotifyMemoryPressure _notifyMemoryPressure = WebFDynamicLibrary.ref
+    .lookup<NativeFunction<NativeNotifyMemoryPressure>>('notifyMemoryPressure')
+    .asFunction();
+
+void notifyMemoryPressure(double contextId, MemoryPressureLevel level) {
+  if (!_allocatedPages.containsKey(contextId)) return;
+  _notifyMemoryPressure(_allocatedPages[contextId]!, level.index);
+}
+
+// Register setPageMemoryBudget
+typedef NativeSetPageMemoryBudget = Void Function(Pointer<Void> page, Int64 bytes);
+typedef DartSetPageMemoryBudget = void Function(Pointer<Void> page, int bytes);
+
+final DartSetPageMemoryBudget _setPageMemoryBudget = WebFDynamicLibrary.ref
+    .lookup<NativeFunction<NativeSetPageMemoryBudget>>('setPageMemoryBudget')
+    .asFunction();
+
+// The JS heap of the page should stay under [bytes], 0 removes the budget.
+void setPageMemoryBudget(double contextId, int bytes) {
+  if (!_allocatedPages.containsKey(contextId)) return;
+  _setPageMemoryBudget(_allocatedPages[contextId]!, bytes);
+}
+
+// Register setPageMemoryLimits
+typedef NativeSetPageMemoryLimits = Void Function(Pointer<Void> page, Int64 softLimit, Int64 hardLimit);
+typedef DartSetPageMemoryLimits = void Function(Pointer<Void> page, int softLimit, int hardLimit);
+
+final DartSetPageMemoryLimits _setPageMemoryLimits = WebFDynamicLibrary.ref
+    .lookup<NativeFunction<NativeSetPageMemoryLimits>>('setPageMemoryLimits')
+    .asFunction();
+
+// Past [softLimit] bytes the window of the page receives a memorypressure event, past [hardLimit] bytes the scripts
+// of the page are terminated. 0 disables a limit.
+void setPageMemoryLimits(double contextId, int softLimit, int hardLimit) {
+  if (!_allocatedPages.containsKey(contextId)) return;
+  _setPageMemoryLimits(_allocatedPages[contextId]!, softLimit, hardLimit);
+}
+
+// Register getPageMemoryUsage
+typedef NativeGetPageMemoryUsage = Void Function(Pointer<Void> page, Pointer<NativePageMemoryUsage> usage);
+typedef DartGetPageMemoryUsage = void Function(Pointer<Void> page, Pointer<NativePageMemoryUsage> usage);
+
+final DartGetPageMemoryUsage _getPageMemoryUsage = WebFDynamicLibrary.ref
+    .lookup<NativeFunction<NativeGetPageMemoryUsage>>('getPageMemoryUsage')
+    .asFunction();
+
+class PageMemoryUsage {
+  final int jsHeap;
+  final int domWrappers;
+  final int uiCommands;
+  final int blobs;
+
+  PageMemoryUsage(this.jsHeap, this.domWrappers, this.uiCommands, this.blobs);
+
+  int get total => jsHeap + domWrappers + uiCommands + blobs;
+}
+
+// The JS heap is the one measured after the last full garbage collection of the page.
+PageMemoryUsage? getPageMemoryUsage(double contextId) {
+  if (!_allocatedPages.containsKey(contextId)) return null;
+  Pointer<NativePageMemoryUsage> usage = malloc.allocate(sizeOf<NativePageMemoryUsage>());
+  _getPageMemoryUsage(_allocatedPages[contextId]!, usage);
+  PageMemoryUsage result =
+      PageMemoryUsage(usage.ref.jsHeap, usage.ref.domWrappers, usage.ref.uiCommands, usage.ref.blobs);
+  malloc.free(usage);
+  return result;
+}
+
 class GumboOutput {
   final Pointer<NativeGumboOutput> ptr;
   final Pointer<Utf8> source;
@@ -614,6 +768,30 @@ Future<void> allocateNewPage(bool sync, double newContextId, int syncBufferSize)
   }
 }
 
+final DartAllocateNewPageSync _prewarmPageSync =
+    WebFDynamicLibrary.ref.lookup<NativeFunction<NativeAllocateNewPageSync>>('prewarmPageSync').asFunction();
+
+final DartAllocateNewPage _prewarmPage =
+    WebFDynamicLibrary.ref.lookup<NativeFunction<NativeAllocateNewPage>>('prewarmPage').asFunction();
+
+void _handlePrewarmPageResult(Object handle, Pointer<Void> page) {
+  _AllocateNewPageContext context = handle as _AllocateNewPageContext;
+  context.completer.complete();
+}
+
+/// Builds the page of [newContextId] ahead of time, the next [allocateNewPage] with the same id claims it.
+Future<void> prewarmPage(bool sync, double newContextId, int syncBufferSize) async {
+  if (!sync) {
+    Completer<void> completer = Completer();
+    _AllocateNewPageContext context = _AllocateNewPageContext(completer, newContextId);
+    Pointer<NativeFunction<HandleAllocateNewPageResult>> f = Pointer.fromFunction(_handlePrewarmPageResult);
+    _prewarmPage(newContextId, syncBufferSize, dartContext!.pointer, context, f);
+    return completer.future;
+  } else {
+    _prewarmPageSync(newContextId, dartContext!.pointer);
+  }
+}
+
 typedef NativeInitDartDynamicLinking = Void Function(Pointer<Void> data);
 typedef DartInitDartDynamicLinking = void Function(Pointer<Void> data);
 
@@ -666,6 +844,84 @@ void clearNativeProfileData() {
   _clearNativeProfileData(dartContext!.pointer);
 }
 
+typedef NativeStartJSSamplingProfiler = Void Function(Pointer<Void> page, Int64 intervalUs);
+typedef DartStartJSSamplingProfiler = void Function(Pointer<Void> page, int intervalUs);
+
+final DartStartJSSamplingProfiler _startJSSamplingProfiler = WebFDynamicLibrary.ref
+    .lookup<NativeFunction<NativeStartJSSamplingProfiler>>('startJSSamplingProfiler')
+    .asFunction();
+
+// Samples the JS call stacks of the thread running the page every [intervalUs] microseconds. Pages sharing the JS
+// thread share the profile.
+void startJSSamplingProfiler(double contextId, {int intervalUs = 1000}) {
+  if (!_allocatedPages.containsKey(contextId)) return;
+  _startJSSamplingProfiler(_allocatedPages[contextId]!, intervalUs);
+}
+
+typedef NativeStopJSSamplingProfiler = Void Function(Pointer<Void> page);
+typedef DartStopJSSamplingProfiler = void Function(Pointer<Void> page);
+
+final DartStopJSSamplingProfiler _stopJSSamplingProfiler = WebFDynamicLibrary.ref
+    .lookup<NativeFunction<NativeStopJSSamplingProfiler>>('stopJSSamplingProfiler')
+    .asFunction();
+
+void stopJSSamplingProfiler(double contextId) {
+  if (!_allocatedPages.containsKey(contextId)) return;
+  _stopJSSamplingProfiler(_allocatedPages[contextId]!);
+}
+
+enum JSSamplingProfileFormat {
+  // `outer;inner count` lines, as read by flamegraph.pl and speedscope.
+  collapsedStacks,
+  // A protobuf profile, as read by `go tool pprof`.
+  pprof,
+}
+
+typedef NativeCollectJSSamplingProfileData = Void Function(
+    Pointer<Void> page, Int32 format, Pointer<Pointer<Uint8>> data, Pointer<Uint32> len);
+typedef DartCollectJSSamplingProfileData = void Function(
+    Pointer<Void> page, int format, Pointer<Pointer<Uint8>> data, Pointer<Uint32> len);
+
+final DartCollectJSSamplingProfileData _collectJSSamplingProfileData = WebFDynamicLibrary.ref
+    .lookup<NativeFunction<NativeCollectJSSamplingProfileData>>('collectJSSamplingProfileData')
+    .asFunction();
+
+Uint8List collectJSSamplingProfileData(double contextId, JSSamplingProfileFormat format) {
+  if (!_allocatedPages.containsKey(contextId)) return Uint8List(0);
+  Pointer<Pointer<Uint8>> data = malloc.allocate(sizeOf<Pointer>());
+  Pointer<Uint32> len = malloc.allocate(sizeOf<Uint32>());
+
+  _collectJSSamplingProfileData(_allocatedPages[contextId]!, format.index, data, len);
+  Uint8List result = Uint8List.fromList(data.value.asTypedList(len.value));
+
+  malloc.free(data.value);
+  malloc.free(data);
+  malloc.free(len);
+  return result;
+}
+
+typedef NativeTakeHeapSnapshot = Void Function(Pointer<Void> page, Pointer<Pointer<Uint8>> data, Pointer<Uint32> len);
+typedef DartTakeHeapSnapshot = void Function(Pointer<Void> page, Pointer<Pointer<Uint8>> data, Pointer<Uint32> len);
+
+final DartTakeHeapSnapshot _takeHeapSnapshot =
+    WebFDynamicLibrary.ref.lookup<NativeFunction<NativeTakeHeapSnapshot>>('takeHeapSnapshot').asFunction();
+
+// Returns the JS heap of the thread running the page as a Chrome DevTools .heapsnapshot JSON. Two snapshots are
+// compared by bridge/tools/webf_heap_snapshot_diff.
+Uint8List takeHeapSnapshot(double contextId) {
+  if (!_allocatedPages.containsKey(contextId)) return Uint8List(0);
+  Pointer<Pointer<Uint8>> data = malloc.allocate(sizeOf<Pointer>());
+  Pointer<Uint32> len = malloc.allocate(sizeOf<Uint32>());
+
+  _takeHeapSnapshot(_allocatedPages[contextId]!, data, len);
+  Uint8List result = Uint8List.fromList(data.value.asTypedList(len.value));
+
+  malloc.free(data.value);
+  malloc.free(data);
+  malloc.free(len);
+  return result;
+}
+
 enum UICommandType {
   startRecordingCommand,
   createElement,
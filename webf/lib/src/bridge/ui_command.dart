@@ -28,7 +28,7 @@ class UICommand {
 
 // struct UICommandItem {
 //   int32_t type;             // offset: 0 ~ 0.5
-//   int32_t args_01_length;   // offset: 0.5 ~ 1
+//   int32_t args_01_length;   // offset: 0.5 ~ 1, the highest bit marks string_01 as Latin-1.
 //   const uint16_t *string_01;// offset: 1
 //   void* nativePtr;          // offset: 2
 //   void* nativePtr2;         // offset: 3
@@ -41,6 +41,8 @@ const int native2PtrMemOffset = 3;
 
 const int commandBufferPrefix = 1;
 
+const int args01Latin1Flag = 0x80000000;
+
 bool enableWebFCommandLog = !kReleaseMode && Platform.environment['ENABLE_WEBF_JS_LOG'] == 'true';
 
 // We found there are performance bottleneck of reading native memory with Dart FFI API.
@@ -57,16 +59,23 @@ List<UICommand> nativeUICommandToDart(List<int> rawMemory, int commandLength, do
     // +-------------+-----------------+
     // |      type     | args_01_length  |
     // +-------------+-----------------+
-    int args01Length = (typeArgs01Combine >> 32).toSigned(32);
-    int type = (typeArgs01Combine ^ (args01Length << 32)).toSigned(32);
+    int args01LengthAndFlag = (typeArgs01Combine >> 32) & 0xFFFFFFFF;
+    int args01Length = args01LengthAndFlag & ~args01Latin1Flag;
+    int type = (typeArgs01Combine & 0xFFFFFFFF).toSigned(32);
 
     command.type = UICommandType.values[type];
 
     int args01StringMemory = rawMemory[i + args01StringMemOffset];
     if (args01StringMemory != 0) {
-      Pointer<Uint16> args_01 = Pointer.fromAddress(args01StringMemory);
-      command.args = uint16ToString(args_01, args01Length);
-      malloc.free(args_01);
+      if ((args01LengthAndFlag & args01Latin1Flag) != 0) {
+        Pointer<Uint8> args_01 = Pointer.fromAddress(args01StringMemory);
+        command.args = latin1ToString(args_01, args01Length);
+        malloc.free(args_01);
+      } else {
+        Pointer<Uint16> args_01 = Pointer.fromAddress(args01StringMemory);
+        command.args = uint16ToString(args_01, args01Length);
+        malloc.free(args_01);
+      }
     } else {
       command.args = '';
     }
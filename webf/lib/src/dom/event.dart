@@ -181,6 +181,9 @@ class Event {
   bool defaultPrevented = false;
   bool _immediateBubble = true;
   bool propagationStopped = false;
+  // The JavaScript dispatch of the previous target which was not awaited because all its listeners are passive,
+  // passive listeners can still stop the propagation.
+  Future<void>? pendingPassiveDispatch;
 
   Pointer<Void> sharedJSProps = nullptr;
   int propLen = 0;
@@ -693,6 +696,9 @@ class TouchEvent extends UIEvent {
   bool ctrlKey = false;
   bool shiftKey = false;
 
+  // The earlier move samples merged into this event, exposed to JavaScript by getCoalescedEvents().
+  List<TouchEvent> coalescedEvents = const [];
+
   @override
   Pointer toRaw([int extraLength = 0, bool isCustomEvent = false]) {
     List<int> methods = [
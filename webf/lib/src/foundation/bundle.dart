@@ -364,12 +364,12 @@ class AssetsBundle extends WebFBundle {
 class FileBundle extends WebFBundle {
   FileBundle(String url, { ContentType? contentType }) : super(url, contentType: contentType);
 
+  String get path => _uri!.path;
+
   @override
   Future<void> obtainData([double contextId = 0]) async {
     if (data != null) return;
 
-    Uri uri = _uri!;
-    final String path = uri.path;
     File file = File(path);
 
     if (await file.exists()) {
@@ -174,6 +174,36 @@ class QuickJSByteCodeCache {
     await cacheObject.write();
   }
 
+  static String? _nativeCacheDirectory;
+  static bool _legacyCacheRemoved = false;
+
+  // The bytecode cached by dart in `ByteCodeCaches` is never read since the native cache took over, it is deleted
+  // once per launch without waiting for it.
+  static void _removeLegacyCache(String appTemporaryPath) {
+    if (_legacyCacheRemoved) return;
+    _legacyCacheRemoved = true;
+    Directory legacyDirectory = Directory(path.join(appTemporaryPath, 'ByteCodeCaches'));
+    legacyDirectory.exists().then((bool isThere) async {
+      if (isThere) await legacyDirectory.delete(recursive: true);
+    }).catchError((error) {
+      print('Failed to delete the legacy bytecode cache: $error');
+    });
+  }
+
+  /// Points the native bytecode cache to the cache directory, or turns it off, following [QuickJSByteCodeCacheObject.cacheMode].
+  static Future<void> syncNativeCache() async {
+    final String appTemporaryPath = await getWebFTemporaryPath();
+    _removeLegacyCache(appTemporaryPath);
+
+    String? directory;
+    if (QuickJSByteCodeCacheObject.cacheMode == ByteCodeCacheMode.DEFAULT) {
+      directory = path.join(appTemporaryPath, 'NativeByteCodeCaches');
+    }
+    if (directory == _nativeCacheDirectory) return;
+    _nativeCacheDirectory = directory;
+    setBytecodeCacheDirectory(directory ?? '');
+  }
+
   static bool isCodeNeedCache(Uint8List codeBytes) {
     return QuickJSByteCodeCacheObject.cacheMode == ByteCodeCacheMode.DEFAULT &&
         codeBytes.length > 1024 * 10; // >= 50 KB
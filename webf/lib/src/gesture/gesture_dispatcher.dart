@@ -8,6 +8,7 @@ import 'dart:ffi';
 
 import 'package:flutter/gestures.dart';
 import 'package:flutter/material.dart';
+import 'package:flutter/scheduler.dart';
 import 'package:webf/dom.dart';
 import 'package:webf/gesture.dart';
 import 'package:webf/html.dart';
@@ -103,6 +104,20 @@ class GestureDispatcher {
 
   final Map<int, EventTarget> _pointTargets = {};
 
+  // The latest touchmove of each target waiting for the next frame, the earlier samples are carried as
+  // coalesced events.
+  final Map<EventTarget, TouchEvent> _pendingTouchMoves = {};
+  bool _touchMoveFlushScheduled = false;
+
+  int _touchMoveSampleCount = 0;
+  int _touchMoveDispatchCount = 0;
+
+  /// Number of touchmove samples received from the platform.
+  int get touchMoveSampleCount => _touchMoveSampleCount;
+
+  /// Number of touchmove events dispatched to the targets, each one is a task on the JS thread.
+  int get touchMoveDispatchCount => _touchMoveDispatchCount;
+
   void _bindEventTargetWithTouchPoint(TouchPoint touchPoint, EventTarget eventTarget) {
     if (eventTarget is PseudoElement) {
       eventTarget = eventTarget.parent;
@@ -402,9 +417,48 @@ class GestureDispatcher {
         e.touches.append(touch);
       }
 
-      if (e.touches.length > 0) {
-        _pointTargets[currentTouchPoint.id]?.dispatchEvent(e);
+      EventTarget? target = _pointTargets[currentTouchPoint.id];
+      if (e.touches.length > 0 && target != null) {
+        if (eventType == EVENT_TOUCH_MOVE) {
+          _coalesceTouchMove(target, e);
+        } else {
+          // Keep the order of events, the pending moves happened before this one.
+          _flushTouchMoves();
+          target.dispatchEvent(e);
+        }
       }
     }
   }
+
+  // The platform reports a move for every pointer sample, which can be several times per frame during a fling.
+  // Merge the moves of the same target and dispatch the latest one once per frame.
+  void _coalesceTouchMove(EventTarget target, TouchEvent event) {
+    _touchMoveSampleCount++;
+    TouchEvent? pending = _pendingTouchMoves[target];
+    if (pending != null) {
+      event.coalescedEvents = [...pending.coalescedEvents, pending];
+      pending.coalescedEvents = const [];
+    }
+    _pendingTouchMoves[target] = event;
+
+    if (!_touchMoveFlushScheduled) {
+      _touchMoveFlushScheduled = true;
+      SchedulerBinding.instance.scheduleFrameCallback((_) => _flushTouchMoves());
+      // Frame callbacks don't request a frame by themselves, nothing else may be dirty while the finger moves.
+      SchedulerBinding.instance.scheduleFrame();
+    }
+  }
+
+  void _flushTouchMoves() {
+    _touchMoveFlushScheduled = false;
+    if (_pendingTouchMoves.isEmpty) return;
+
+    List<MapEntry<EventTarget, TouchEvent>> pendingTouchMoves = _pendingTouchMoves.entries.toList();
+    _pendingTouchMoves.clear();
+    for (MapEntry<EventTarget, TouchEvent> entry in pendingTouchMoves) {
+      if (entry.key.pointer?.ref.disposed == true) continue;
+      _touchMoveDispatchCount++;
+      entry.key.dispatchEvent(entry.value);
+    }
+  }
 }
@@ -48,7 +48,9 @@ class ScriptRunner {
         throw FlutterError('Script code are not valid to evaluate.');
       }
     } else if (bundle.isBytecode) {
-      bool result = await evaluateQuickjsByteCode(contextId, bundle.data!, profileOp: profileOp);
+      bool result = bundle is FileBundle
+          ? await evaluateQuickjsByteCodeFile(contextId, bundle.path, profileOp: profileOp)
+          : await evaluateQuickjsByteCode(contextId, bundle.data!, profileOp: profileOp);
       if (!result) {
         throw FlutterError('Bytecode are not valid to execute.');
       }
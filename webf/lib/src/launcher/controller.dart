@@ -399,6 +399,7 @@ class WebFViewController implements WidgetsBindingObserver {
     await waitingSyncTaskComplete(contextId);
     _disposed = true;
     debugDOMTreeChanged = null;
+    _memoryPressureTimer?.cancel();
 
     _teardownObserver();
     _unregisterPlatformBrightnessChange();
@@ -813,8 +814,53 @@ class WebFViewController implements WidgetsBindingObserver {
   @override
   void didChangeTextScaleFactor() {}
 
+  // Flutter reports memory pressure without a level. A report within this window of the previous one escalates to
+  // critical, the pressure goes back to none once the window passed without reports.
+  static const Duration _memoryPressureWindow = Duration(seconds: 30);
+  MemoryPressureLevel _memoryPressure = MemoryPressureLevel.none;
+  Timer? _memoryPressureTimer;
+
   @override
-  void didHaveMemoryPressure() {}
+  void didHaveMemoryPressure() {
+    if (_disposed) return;
+    // The collection of the first report was not enough when another one comes, stop delaying collections.
+    _memoryPressure =
+        _memoryPressure == MemoryPressureLevel.none ? MemoryPressureLevel.moderate : MemoryPressureLevel.critical;
+    notifyMemoryPressure(_contextId, _memoryPressure);
+
+    _memoryPressureTimer?.cancel();
+    _memoryPressureTimer = Timer(_memoryPressureWindow, () {
+      _memoryPressureTimer = null;
+      _memoryPressure = MemoryPressureLevel.none;
+      if (_disposed) return;
+      notifyMemoryPressure(_contextId, MemoryPressureLevel.none);
+    });
+  }
+
+  // The idle time given to the JS thread for its garbage collection, about one frame.
+  static const Duration _idleGCTime = Duration(milliseconds: 16);
+  bool _idleGCScheduled = false;
+
+  // Lets the JS thread make up the garbage collections it put off while running frame callbacks.
+  void scheduleIdleGC() {
+    if (_idleGCScheduled || _disposed) return;
+    _idleGCScheduled = true;
+    SchedulerBinding.instance.scheduleTask(() {
+      _idleGCScheduled = false;
+      if (_disposed) return;
+      notifyIdle(_contextId, _idleGCTime);
+    }, Priority.idle);
+  }
+
+  // The memory attributed to the page, its JS heap is the one measured after the last full garbage collection.
+  PageMemoryUsage? get memoryUsage => _disposed ? null : getPageMemoryUsage(_contextId);
+
+  // Past [soft] bytes the window receives a memorypressure event, past [hard] bytes the scripts of the page are
+  // terminated. 0 disables a limit.
+  void setMemoryLimits({int soft = 0, int hard = 0}) {
+    if (_disposed) return;
+    setPageMemoryLimits(_contextId, soft, hard);
+  }
 
   @override
   Future<bool> didPopRoute() async {
@@ -1612,7 +1658,11 @@ class WebFController {
         // Prefer sync decode in loading entrypoint.
         await evaluateScripts(contextId, data, url: url, profileOp: evaluateOpItem);
       } else if (entrypoint.isBytecode) {
-        await evaluateQuickjsByteCode(contextId, data, profileOp: evaluateOpItem);
+        if (entrypoint is FileBundle) {
+          await evaluateQuickjsByteCodeFile(contextId, entrypoint.path, profileOp: evaluateOpItem);
+        } else {
+          await evaluateQuickjsByteCode(contextId, data, profileOp: evaluateOpItem);
+        }
       } else if (entrypoint.isHTML) {
         assert(isValidUTF8String(data), 'The HTML codes should be in UTF-8 encoding format');
         await parseHTML(contextId, data, profileOp: evaluateOpItem);
@@ -3,12 +3,17 @@
  */
 
 import 'dart:async';
+import 'dart:io';
 import 'package:archive/archive.dart';
 import 'package:path/path.dart' as path;
 import 'package:hive/hive.dart';
+import 'package:webf/bridge.dart' as bridge;
 import 'package:webf/foundation.dart';
 import 'package:webf/module.dart';
 
+// Matches StorageArea::kLogFileName of bridge/core/storage/storage_area.h.
+const String _nativeLogFileName = 'local_storage.log';
+
 class LocalStorageModule extends BaseModule {
   @override
   String get name => 'LocalStorage';
@@ -30,6 +35,21 @@ class LocalStorageModule extends BaseModule {
       // Try again to avoid resources are temporarily unavailable.
       await Hive.openBox(key, path: storagePath);
     }
+
+    // window.localStorage is implemented at the native side, it only needs a directory of this origin.
+    final nativeStoragePath = path.join(storagePath, key);
+    await Directory(nativeStoragePath).create(recursive: true);
+
+    // The items saved in the box are moved to the native storage the first time it is used, the log file is
+    // created by then.
+    Map<String, String> legacyEntries = {};
+    if (!await File(path.join(nativeStoragePath, _nativeLogFileName)).exists()) {
+      Box box = Hive.box(key);
+      for (dynamic boxKey in box.keys) {
+        legacyEntries[boxKey.toString()] = box.get(boxKey).toString();
+      }
+    }
+    bridge.setLocalStorageDirectory(moduleManager!.contextId, nativeStoragePath, legacyEntries);
   }
 
   LocalStorageModule(ModuleManager? moduleManager) : super(moduleManager);
@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+import 'dart:convert';
+import 'dart:io';
+import 'dart:typed_data';
+
+import 'package:test/test.dart';
+import 'package:webf/bridge.dart';
+
+Uint8List _fromHex(String hex) {
+  Uint8List bytes = Uint8List(hex.length ~/ 2);
+  for (int i = 0; i < bytes.length; i++) {
+    bytes[i] = int.parse(hex.substring(i * 2, i * 2 + 2), radix: 16);
+  }
+  return bytes;
+}
+
+String _toHex(Uint8List bytes) {
+  return bytes.map((byte) => byte.toRadixString(16).padLeft(2, '0')).join();
+}
+
+void main() {
+  group('StructuredValue', () {
+    // Shared with the C++ implementation in bridge/bindings/qjs/structured_serializer_test.cc.
+    List corpus = jsonDecode(File('../bridge/test/fixtures/structured_value_corpus.json').readAsStringSync());
+
+    for (Map entry in corpus) {
+      test('conformance ${entry['name']}', () {
+        Uint8List bytes = _fromHex(entry['bytes']);
+        dynamic value = decodeStructuredValue(bytes);
+        if (entry.containsKey('value')) {
+          expect(value, entry['value']);
+        }
+        expect(_toHex(encodeStructuredValue(value)), entry['bytes']);
+      });
+    }
+
+    test('cyclic map', () {
+      Map<String, dynamic> object = {'name': 'webf'};
+      object['self'] = object;
+      Map<String, dynamic> decoded = decodeStructuredValue(encodeStructuredValue(object));
+      expect(decoded['name'], 'webf');
+      expect(identical(decoded['self'], decoded), true);
+    });
+
+    test('typed data', () {
+      Float32List list = Float32List.fromList([0.5, 1.5]);
+      Float32List decoded = decodeStructuredValue(encodeStructuredValue({'list': list}))['list'];
+      expect(decoded, list);
+    });
+
+    test('malformed data', () {
+      for (String hex in ['', 'ff02', 'ff0108', 'ff010803', 'ff010d00', 'ff0109', 'ff010101']) {
+        expect(() => decodeStructuredValue(_fromHex(hex)), throwsFormatException);
+      }
+    });
+  });
+}
@@ -16,6 +16,7 @@ import 'src/css/style_rule_parser.dart' as style_rule_parser;
 import 'src/css/style_sheet_parser.dart' as style_sheet_parser;
 import 'src/css/style_inline_parser.dart' as style_inline_parser;
 import 'src/css/values.dart' as css_values;
+import 'src/bridge/structured_value.dart' as structured_value;
 import 'src/foundation/bundle.dart' as bundle;
 import 'src/foundation/convert.dart' as convert;
 import 'src/foundation/environment.dart' as environment;
@@ -64,6 +65,10 @@ void main() {
     fetch.main();
   });
 
+  group('bridge', () {
+    structured_value.main();
+  });
+
   group('css', () {
     style_rule_parser.main();
     style_sheet_parser.main();